@@ -169,6 +169,12 @@ public:
    virtual bool ProcessFinalize() /* noexcept */ = 0;
    virtual size_t ProcessBlock(float **inBlock, float **outBlock, size_t blockLen) = 0;
 
+   // Whether the host may create independent processors through the Realtime
+   // methods and run them on concurrent worker threads when applying the
+   // effect offline.  Clients that return true must not require a master
+   // instance or any UI while doing so.
+   virtual bool SupportsConcurrentProcessing() { return false; }
+
    virtual bool RealtimeInitialize() = 0;
    virtual bool RealtimeAddProcessor(unsigned numChannels, float sampleRate) = 0;
    virtual bool RealtimeFinalize() = 0;
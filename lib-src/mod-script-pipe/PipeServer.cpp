@@ -5,7 +5,8 @@
 #include <stdio.h>
 #include <tchar.h>
 
-const int nBuff = 1024;
+// Big enough for a batch frame of many commands in one message.
+const int nBuff = 65536;
 
 extern "C" int DoSrv( char * pIn );
 extern "C" int DoSrvMore( char * pOut, int nMax );
@@ -116,7 +117,8 @@ void PipeServer()
 
 const char fifotmpl[] = "/tmp/audacity_script_pipe.%s.%d";
 
-const int nBuff = 1024;
+// Big enough for a batch frame of many commands in one message.
+const int nBuff = 65536;
 
 extern "C" int DoSrv( char * pIn );
 extern "C" int DoSrvMore( char * pOut, int nMax );
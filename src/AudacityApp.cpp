@@ -26,6 +26,8 @@ It handles initialization and termination by subclassing wxApp.
 #include <vld.h>
 #endif
 
+#include <thread>
+
 #include <wx/setup.h> // for wxUSE_* macros
 #include <wx/wxcrtvararg.h>
 #include <wx/defs.h>
@@ -707,6 +709,10 @@ GnomeShutdown GnomeShutdownInstance;
 // the timer routine gets around to picking them up.
 static wxArrayString ofqueue;
 
+// Set by the --readonly command line switch; makes this a reviewer
+// instance, opening every project for review only.
+static bool bReadOnlyOpen = false;
+
 //
 // DDE support for opening multiple files with one instance
 // of Audacity.
@@ -914,7 +920,8 @@ bool AudacityApp::MRUOpen(const FilePath &fullPathStr) {
          // This project is clean; it's never been touched.  Therefore
          // all relevant member variables are in their initial state,
          // and it's okay to open a NEW project inside this window.
-         ( void ) ProjectManager::OpenProject( proj, fullPathStr );
+         ( void ) ProjectManager::OpenProject( proj, fullPathStr,
+            true, bReadOnlyOpen );
       }
       else {
          // File doesn't exist - remove file from history
@@ -1374,6 +1381,26 @@ bool AudacityApp::OnInit()
    this->AssociateFileTypes();
 #endif
 
+   // Scanning the audio hosts and devices is the slowest independent stage
+   // of startup, so warm it on a worker while the main thread loads the
+   // theme, the plugin registry and the modules.  Pa_Initialize is
+   // reference counted:  the later call inside AudioIO's constructor only
+   // bumps the count and finds the device list already built.  The worker
+   // is joined before that call, because PortAudio may not be initialized
+   // from two threads at once, and collectPortAudioPrewarm balances this
+   // extra reference afterwards.
+   // The remaining stages stay on the main thread:  they read and write
+   // gPrefs or create widgets, neither of which is thread-safe in
+   // wxWidgets.
+   PaError paPrewarmError = paNoError;
+   std::thread paPrewarmThread{ [&paPrewarmError]{
+      paPrewarmError = Pa_Initialize();
+   } };
+   auto collectPortAudioPrewarm = [&]{
+      if (paPrewarmThread.joinable())
+         paPrewarmThread.join();
+   };
+
    theTheme.EnsureInitialised();
 
    // AColor depends on theTheme.
@@ -1382,6 +1409,9 @@ bool AudacityApp::OnInit()
    // Init DirManager, which initializes the temp directory
    // If this fails, we must exit the program.
    if (!InitTempDir()) {
+      collectPortAudioPrewarm();
+      if (paPrewarmError == paNoError)
+         Pa_Terminate();
       FinishPreferences();
       return false;
    }
@@ -1443,6 +1473,11 @@ bool AudacityApp::OnInit()
       exit(1);
    }
 
+   if (parser->Found(wxT("r")))
+   {
+      bReadOnlyOpen = true;
+   }
+
    // BG: Create a temporary window to set as the top window
    wxImage logoimage((const char **)AudacityLogoWithName_xpm);
    logoimage.Rescale(logoimage.GetWidth() / 2, logoimage.GetHeight() / 2);
@@ -1493,7 +1528,13 @@ bool AudacityApp::OnInit()
       // More initialization
 
       InitDitherers();
+
+      collectPortAudioPrewarm();
       AudioIO::Init();
+      if (paPrewarmError == paNoError)
+         // Drop the reference the prewarm took; AudioIO holds its own now,
+         // so PortAudio stays initialized
+         Pa_Terminate();
 
 #ifdef __WXMAC__
 
@@ -2009,6 +2050,10 @@ std::unique_ptr<wxCmdLineParser> AudacityApp::ParseCommandLine()
    parser->AddSwitch(wxT("h"), wxT("help"), _("this help message"),
                      wxCMD_LINE_OPTION_HELP);
 
+   /*i18n-hint: This opens projects for review only, never writing into
+    *           their directories */
+   parser->AddSwitch(wxT("r"), wxT("readonly"), _("open projects read-only, for review"));
+
    /*i18n-hint: This runs a set of automatic tests on Audacity itself */
    parser->AddSwitch(wxT("t"), wxT("test"), _("run self diagnostics"));
 
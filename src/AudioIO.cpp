@@ -374,12 +374,14 @@ Time (in seconds, = total_sample_count / sample_rate)
   any state changes between mT0 and mT1.
 
   \par NoteTrack PlayLooped Implementation
-  The mIterator object (an Alg_iterator) returns NULL when there are
-  no more events scheduled before mT1. At mT1, we want to output
-  all notes off messages, but the FillMidiBuffers() loop will exit
-  if mNextEvent is NULL, so we create a "fake" mNextEvent for this
-  special "event" of sending all notes off. After that, we destroy
-  the iterator and use PrepareMidiIterator() to set up a NEW one.
+  PrepareMidiIterator() drains an Alg_iterator into mMidiEventBuffer, a
+  flat time-sorted array of the events scheduled before mT1, which
+  GetNextEvent() then walks with a cursor.  When the events run out, at
+  mT1, we want to output all notes off messages, but the
+  FillMidiBuffers() loop will exit if mNextEvent is NULL, so we create
+  a "fake" mNextEvent for this special "event" of sending all notes
+  off. After that, we use PrepareMidiIterator() to rebuild the buffer
+  for the next pass.
   At each iteration, time must advance by (mT1 - mT0), so the
   accumulated complete loop time (in "unwarped," track time) is computed
   by MidiLoopOffset().
@@ -427,6 +429,11 @@ time warp info and AudioIOListener and whether the playback is looped.
 #include <math.h>
 #include <stdlib.h>
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
 
 #ifdef __WXMSW__
 #include <malloc.h>
@@ -446,11 +453,13 @@ time warp info and AudioIOListener and whether the playback is looped.
 #include <wx/log.h>
 #include <wx/textctrl.h>
 #include <wx/timer.h>
+#include <wx/tokenzr.h>
 #include <wx/intl.h>
 #include <wx/debug.h>
 
 #include "MissingAliasFileDialog.h"
 #include "Mix.h"
+#include "PerfCounters.h"
 #include "Resample.h"
 #include "RingBuffer.h"
 #include "prefs/GUISettings.h"
@@ -460,6 +469,8 @@ time warp info and AudioIOListener and whether the playback is looped.
 #include "AutoRecovery.h"
 
 #include "effects/RealtimeEffectManager.h"
+#include "effects/TrackFreeze.h"
+#include "TrackProxy.h"
 #include "prefs/QualityPrefs.h"
 #include "prefs/RecordingPrefs.h"
 #include "widgets/MeterPanelBase.h"
@@ -489,6 +500,12 @@ time warp info and AudioIOListener and whether the playback is looped.
    #define UPPER_BOUND 1.0
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AUDIO_IO_USE_SSE2
+#include <emmintrin.h>
+#endif
+
 using std::max;
 using std::min;
 
@@ -881,6 +898,101 @@ class MidiThread final : public AudioThread {
 };
 #endif
 
+//////////////////////////////////////////////////////////////////////
+//
+//     class PlaybackPrefetchPool
+//
+//////////////////////////////////////////////////////////////////////
+
+// A small pool of worker threads used by AudioIO::FillBuffers() so that
+// per-track Mixer::Process() and RingBuffer::Put() work can proceed
+// concurrently when there are many playback tracks.  Each dispatched
+// task touches a disjoint range of tracks, so the single-producer
+// guarantee of each RingBuffer is preserved.
+class PlaybackPrefetchPool {
+ public:
+   using Task = std::function<void()>;
+
+   explicit PlaybackPrefetchPool(unsigned nThreads)
+   {
+      for (unsigned ii = 0; ii < nThreads; ++ii)
+         mWorkers.emplace_back([this]{ WorkerLoop(); });
+   }
+
+   ~PlaybackPrefetchPool()
+   {
+      {
+         std::lock_guard<std::mutex> guard{ mMutex };
+         mStop = true;
+      }
+      mCondition.notify_all();
+      for (auto &worker : mWorkers)
+         worker.join();
+   }
+
+   size_t Size() const { return mWorkers.size(); }
+
+   // Queue one task for a worker.  Establish the completion barrier
+   // with Wait() before touching any data the tasks write.
+   void Dispatch(Task task)
+   {
+      {
+         std::lock_guard<std::mutex> guard{ mMutex };
+         mTasks.push_back(std::move(task));
+         ++mPending;
+      }
+      mCondition.notify_one();
+   }
+
+   // Block until every task dispatched so far has run to completion.
+   void Wait()
+   {
+      std::unique_lock<std::mutex> lock{ mMutex };
+      mDone.wait(lock, [this]{ return mPending == 0; });
+   }
+
+ private:
+   void WorkerLoop()
+   {
+      for (;;) {
+         Task task;
+         {
+            std::unique_lock<std::mutex> lock{ mMutex };
+            mCondition.wait(lock,
+               [this]{ return mStop || !mTasks.empty(); });
+            if (mStop && mTasks.empty())
+               return;
+            task = std::move(mTasks.front());
+            mTasks.pop_front();
+         }
+         task();
+         {
+            std::lock_guard<std::mutex> guard{ mMutex };
+            if (--mPending == 0)
+               mDone.notify_all();
+         }
+      }
+   }
+
+   std::vector<std::thread> mWorkers;
+   std::deque<Task> mTasks;
+   std::mutex mMutex;
+   std::condition_variable mCondition, mDone;
+   unsigned mPending{ 0 };
+   bool mStop{ false };
+};
+
+namespace {
+   // Created on first use from the audio thread and kept for the life
+   // of the process, like the AudioIO singleton itself.
+   PlaybackPrefetchPool &GetPlaybackPrefetchPool()
+   {
+      static PlaybackPrefetchPool pool{
+         std::max(1u, std::thread::hardware_concurrency()) };
+      return pool;
+   }
+}
+
 
 //////////////////////////////////////////////////////////////////////
 //
@@ -961,6 +1073,7 @@ AudioIO::AudioIO()
    mMidiStreamActive = false;
    mSendMidiState = false;
    mIterator = NULL;
+   mMidiEventCursor = 0;
 
    mNumFrames = 0;
    mNumPauseFrames = 0;
@@ -1311,6 +1424,18 @@ bool AudioIO::StartPortAudioStream(const AudioIOStartStreamOptions &options,
          AudacityToPortAudioSampleFormat(mCaptureFormat);
 
       captureParameters.hostApiSpecificStreamInfo = NULL;
+
+      // Aggregate multi-device capture:  when the requested channels
+      // outnumber this device's inputs and auxiliary recording devices
+      // are configured, record only the first inputs here and assign
+      // the rest to input-only streams on the auxiliary devices, opened
+      // below once this stream is open.  mNumCaptureChannels remains
+      // the interleave stride of this stream's input buffer.
+      if (!gPrefs->Read(wxT("/AudioIO/AuxRecordingDevices"), wxT("")).empty()
+          && captureDeviceInfo->maxInputChannels > 0
+          && (unsigned int)captureDeviceInfo->maxInputChannels
+             < mNumCaptureChannels)
+         mNumCaptureChannels = captureDeviceInfo->maxInputChannels;
       captureParameters.channelCount = mNumCaptureChannels;
 
       if (mSoftwarePlaythrough)
@@ -1398,9 +1523,102 @@ bool AudioIO::StartPortAudioStream(const AudioIOStartStreamOptions &options,
    }
 #endif
 
+   if (mLastPaError == paNoError && useCapture &&
+       numCaptureChannels > mNumCaptureChannels) {
+      if (!OpenAuxCaptureStreams(numCaptureChannels, latencyDuration)) {
+         // Some requested channels found no device; fail the start, as
+         // a single too-wide open of the main device would have
+         CloseAuxCaptureStreams();
+         Pa_CloseStream( mPortStreamV19 );
+         mPortStreamV19 = NULL;
+         mLastPaError = paInvalidChannelCount;
+      }
+   }
+
    return (mLastPaError == paNoError);
 }
 
+// Assign the capture channels beyond the main device's inputs to the
+// auxiliary recording devices named in /AudioIO/AuxRecordingDevices
+// ('|'-separated), in order, opening an input-only stream per device.
+// Their callbacks feed the later capture ring buffers, and FillBuffers
+// trims their resampling factors against the main stream's clock, so
+// several free-running interfaces record as one aggregate device.
+bool AudioIO::OpenAuxCaptureStreams(
+   unsigned int totalCaptureChannels, double latencyDuration)
+{
+   const wxString auxDevices =
+      gPrefs->Read(wxT("/AudioIO/AuxRecordingDevices"), wxT(""));
+   unsigned int assigned = mNumCaptureChannels;
+
+   wxStringTokenizer tokenizer(auxDevices, wxT("|"));
+   while (assigned < totalCaptureChannels && tokenizer.HasMoreTokens()) {
+      const wxString name =
+         tokenizer.GetNextToken().Strip(wxString::both);
+      if (name.empty())
+         continue;
+
+      const int deviceNum = getRecordDevIndex(name);
+      const PaDeviceInfo *info = Pa_GetDeviceInfo(deviceNum);
+      if (!info || info->maxInputChannels <= 0) {
+         wxLogDebug(wxT("Auxiliary recording device %s is unusable"), name);
+         continue;
+      }
+
+      auto aux = std::make_unique<AuxCaptureStream>();
+      aux->owner = this;
+      aux->firstBuffer = assigned;
+      aux->numChannels = std::min<unsigned int>(
+         info->maxInputChannels, totalCaptureChannels - assigned);
+
+      PaStreamParameters parameters{};
+      parameters.device = deviceNum;
+      // Always float; the ring buffers convert on Put as needed
+      parameters.sampleFormat = paFloat32;
+      parameters.hostApiSpecificStreamInfo = NULL;
+      parameters.channelCount = aux->numChannels;
+      parameters.suggestedLatency = latencyDuration / 1000.0;
+
+      // Prefer the main stream's rate; else take the device default and
+      // let the drift servo's resampling absorb the difference
+      aux->rate = mRate;
+      PaError err = Pa_OpenStream( &aux->stream,
+         &parameters, NULL, aux->rate, paFramesPerBufferUnspecified,
+         paNoFlag, auxAudioCallback, aux.get() );
+      if (err != paNoError && info->defaultSampleRate > 0) {
+         aux->rate = info->defaultSampleRate;
+         err = Pa_OpenStream( &aux->stream,
+            &parameters, NULL, aux->rate, paFramesPerBufferUnspecified,
+            paNoFlag, auxAudioCallback, aux.get() );
+      }
+      if (err != paNoError) {
+         wxLogDebug(wxT("Failed to open auxiliary recording device %s: %d"),
+            name, err);
+         continue;
+      }
+
+      assigned += aux->numChannels;
+      mAuxCaptureStreams.push_back(std::move(aux));
+   }
+
+   return assigned >= totalCaptureChannels;
+}
+
+void AudioIO::StartAuxCaptureStreams()
+{
+   for (auto &pAux : mAuxCaptureStreams)
+      Pa_StartStream( pAux->stream );
+}
+
+void AudioIO::CloseAuxCaptureStreams()
+{
+   for (auto &pAux : mAuxCaptureStreams) {
+      Pa_AbortStream( pAux->stream );
+      Pa_CloseStream( pAux->stream );
+   }
+   mAuxCaptureStreams.clear();
+}
+
 wxString AudioIO::LastPaErrorString()
 {
    return wxString::Format(wxT("%d %s."), (int) mLastPaError, Pa_GetErrorText(mLastPaError));
@@ -1445,6 +1663,8 @@ void AudioIO::StartMonitoring( const AudioIOStartStreamOptions &options )
    // TODO: ? Factor out and reuse error reporting code from end of 
    // AudioIO::StartStream?
    mLastPaError = Pa_StartStream( mPortStreamV19 );
+   if (mLastPaError == paNoError)
+      StartAuxCaptureStreams();
 
    // Update UI display only now, after all possibilities for error are past.
    auto pListener = GetListener();
@@ -1462,6 +1682,11 @@ int AudioIO::StartStream(const TransportTracks &tracks,
    mLostCaptureIntervals.clear();
    mDetectDropouts =
       gPrefs->Read( WarningDialogKey(wxT("DropoutDetected")), true ) != 0;
+   mCallbackTelemetry.Reset();
+   mXrunsReported = 0;
+   mXrunsSeenByUI = 0;
+   mXrunAlertThreshold = 0;
+   gPrefs->Read(wxT("/AudioIO/XrunAlertThreshold"), &mXrunAlertThreshold, 0L);
    auto cleanup = finally ( [this] { ClearRecordingException(); } );
 
    if( IsBusy() )
@@ -1554,11 +1779,10 @@ int AudioIO::StartStream(const TransportTracks &tracks,
       }
    });
 
-   mPlaybackBuffers.reset();
    mPlaybackMixers.reset();
-   mCaptureBuffers.reset();
    mResample.reset();
-   mTimeQueue.mData.reset();
+   // The ring buffers and the time queue survive from the last stop;
+   // AllocateBuffers below reuses them when their sizes still match
 
 #ifdef EXPERIMENTAL_MIDI_OUT
    streamStartTime = 0;
@@ -1663,6 +1887,25 @@ int AudioIO::StartStream(const TransportTracks &tracks,
    AILASetStartTime();
 #endif
 
+   // When loop-playing without a time track, pre-render the start of the
+   // loop region for each track; FillBuffers can then cross the wrap by
+   // copying from memory while the restarted mixers re-seek at leisure
+   mLoopPrimeBuffers.clear();
+   if (mPlaybackSchedule.Looping() && !mPlaybackSchedule.mEnvelope &&
+       mPlaybackSchedule.mCutPreviewGapLen == 0 &&
+       mPlaybackTracks.size() > 0)
+   {
+      mLoopPrimeBuffers.resize(mPlaybackTracks.size());
+      for (unsigned int ii = 0; ii < mPlaybackTracks.size(); ii++)
+      {
+         auto &mixer = *mPlaybackMixers[ii];
+         const auto processed = mixer.Process(mPlaybackSamplesToCopy);
+         const float *rendered = (const float *)mixer.GetBuffer();
+         mLoopPrimeBuffers[ii].assign(rendered, rendered + processed);
+         mixer.Restart();
+      }
+   }
+
    if (options.pStartTime)
    {
       // Calculate the NEW time position
@@ -1762,6 +2005,8 @@ int AudioIO::StartStream(const TransportTracks &tracks,
          AudacityMessageBox(LAT1CTOWX(Pa_GetErrorText(err)));
          return 0;
       }
+
+      StartAuxCaptureStreams();
    }
 
    // Update UI display only now, after all possibilities for error are past.
@@ -1793,6 +2038,24 @@ int AudioIO::StartStream(const TransportTracks &tracks,
    return mStreamToken;
 }
 
+// Take a ring buffer of the wanted format and size out of the pool that
+// the last transport stop left behind, emptied; allocate a NEW one only
+// when none matches.
+static std::unique_ptr<RingBuffer> TakePooledRingBuffer(
+   std::vector<std::unique_ptr<RingBuffer>> &pool,
+   sampleFormat format, size_t size)
+{
+   for (auto &buffer : pool) {
+      if (buffer && buffer->GetFormat() == format &&
+          buffer->GetSize() == size) {
+         auto result = std::move(buffer);
+         result->Reset();
+         return result;
+      }
+   }
+   return std::make_unique<RingBuffer>(format, size);
+}
+
 bool AudioIO::AllocateBuffers(
    const AudioIOStartStreamOptions &options,
    const TransportTracks &tracks, double t0, double t1, double sampleRate,
@@ -1855,8 +2118,20 @@ bool AudioIO::AllocateBuffers(
             auto playbackBufferSize =
                (size_t)lrint(mRate * mPlaybackRingBufferSecs);
 
+            // Gather buffers kept alive by the last stop; any whose size
+            // and format still match are reused below instead of
+            // reallocated, so that pressing play does not wait on large
+            // allocations
+            std::vector<std::unique_ptr<RingBuffer>> pooled;
+            for (size_t i = 0; i < mPlaybackBufferPoolSize; i++)
+               if (mPlaybackBuffers[i])
+                  pooled.push_back(std::move(mPlaybackBuffers[i]));
+            mPlaybackBufferPoolSize = 0;
+
             mPlaybackBuffers.reinit(mPlaybackTracks.size());
+            mPlaybackBufferPoolSize = mPlaybackTracks.size();
             mPlaybackMixers.reinit(mPlaybackTracks.size());
+            mPlaybackTrackFrozen.assign(mPlaybackTracks.size(), false);
 
             const Mixer::WarpOptions &warpOptions =
 #ifdef EXPERIMENTAL_SCRUBBING_SUPPORT
@@ -1885,17 +2160,38 @@ bool AudioIO::AllocateBuffers(
                mPlaybackTracks[i]->SetOldChannelGain(0, 0.0);
                mPlaybackTracks[i]->SetOldChannelGain(1, 0.0);
 
-               mPlaybackBuffers[i] =
-                  std::make_unique<RingBuffer>(floatSample, playbackBufferSize);
+               mPlaybackBuffers[i] = TakePooledRingBuffer(
+                  pooled, floatSample, playbackBufferSize);
                const auto timeQueueSize =
                   (playbackBufferSize + TimeQueueGrainSize - 1)
                      / TimeQueueGrainSize;
-               mTimeQueue.mData.reinit( timeQueueSize );
-               mTimeQueue.mSize = timeQueueSize;
+               if (!mTimeQueue.mData || mTimeQueue.mSize != timeQueueSize) {
+                  mTimeQueue.mData.reinit( timeQueueSize );
+                  mTimeQueue.mSize = timeQueueSize;
+               }
 
                // use track time for the end time, not real time!
                WaveTrackConstArray mixTracks;
-               mixTracks.push_back(mPlaybackTracks[i]);
+               if (auto frozen =
+                   TrackFreeze::Get().Frozen(mPlaybackTracks[i].get())) {
+                  // Play the pre-rendered audio instead; the callback
+                  // skips the realtime effect chain for this track but
+                  // keeps applying gain and pan from the source track
+                  mPlaybackTrackFrozen[i] = true;
+                  mixTracks.push_back(frozen);
+               }
+               else if (TrackProxy::IsEnabled()) {
+                  // While editing, a half-rate 16-bit stand-in is good
+                  // enough for monitoring; export paths build their own
+                  // mixers from the full-quality originals
+                  if (auto proxy =
+                      TrackProxy::Get().Proxy(mPlaybackTracks[i].get()))
+                     mixTracks.push_back(proxy);
+                  else
+                     mixTracks.push_back(mPlaybackTracks[i]);
+               }
+               else
+                  mixTracks.push_back(mPlaybackTracks[i]);
 
                double endTime;
                if (make_iterator_range(tracks.prerollTracks)
@@ -1938,17 +2234,59 @@ bool AudioIO::AllocateBuffers(
                return false;
             }
 
+            std::vector<std::unique_ptr<RingBuffer>> pooled;
+            for (size_t i = 0; i < mCaptureBufferPoolSize; i++)
+               if (mCaptureBuffers[i])
+                  pooled.push_back(std::move(mCaptureBuffers[i]));
+            mCaptureBufferPoolSize = 0;
+
             mCaptureBuffers.reinit(mCaptureTracks.size());
+            mCaptureBufferPoolSize = mCaptureTracks.size();
             mResample.reinit(mCaptureTracks.size());
             mFactor = sampleRate / mRate;
 
             for( unsigned int i = 0; i < mCaptureTracks.size(); i++ )
             {
-               mCaptureBuffers[i] = std::make_unique<RingBuffer>(
+               mCaptureBuffers[i] = TakePooledRingBuffer( pooled,
                   mCaptureTracks[i]->GetSampleFormat(), captureBufferSize );
+
+               // Aggregate capture:  a channel recorded from an
+               // auxiliary device resamples by that device's own
+               // factor, and the drift servo needs a little slack in
+               // the ratio; the main device's channels keep constant
+               // rate resampling
+               double minFactor = mFactor, maxFactor = mFactor;
+               for (auto &pAux : mAuxCaptureStreams)
+                  if (i >= pAux->firstBuffer &&
+                      i < pAux->firstBuffer + pAux->numChannels) {
+                     const double auxFactor =
+                        mFactor * mRate / pAux->rate;
+                     minFactor = auxFactor * 0.999;
+                     maxFactor = auxFactor * 1.001;
+                  }
                mResample[i] =
-                  std::make_unique<Resample>(true, mFactor, mFactor);
-                  // constant rate resampling
+                  std::make_unique<Resample>(true, minFactor, maxFactor);
+            }
+
+            // For sound activated recording, keep a history of the
+            // input while paused below the activation level, so the
+            // attack of the triggering sound is recorded too
+            mSoundActivatedPreRoll.reset();
+            mSoundActivatedPreRollCapacity = 0;
+            mSoundActivatedPreRollPos = 0;
+            mSoundActivatedPreRollCount = 0;
+            if (mPauseRec) {
+               double preRollSecs = 0.0;
+               gPrefs->Read(wxT("/AudioIO/SilencePreRoll"), &preRollSecs, 0.0);
+               // Same sanity bound as the capture ring buffer
+               preRollSecs = std::min(preRollSecs, 30.0);
+               if (preRollSecs > 0) {
+                  mSoundActivatedPreRollCapacity =
+                     (size_t)(mRate * preRollSecs + 0.5);
+                  mSoundActivatedPreRoll.reinit(
+                     mSoundActivatedPreRollCapacity * mNumCaptureChannels *
+                        SAMPLE_SIZE(mCaptureFormat));
+               }
             }
          }
       }
@@ -1987,13 +2325,19 @@ void AudioIO::StartStreamCleanup(bool bOnlyBuffers)
    }
 
    mPlaybackBuffers.reset();
+   mPlaybackBufferPoolSize = 0;
    mPlaybackMixers.reset();
    mCaptureBuffers.reset();
+   mCaptureBufferPoolSize = 0;
+   mSoundActivatedPreRoll.reset();
+   mSoundActivatedPreRollCapacity = 0;
    mResample.reset();
    mTimeQueue.mData.reset();
+   mTimeQueue.mSize = 0;
 
    if(!bOnlyBuffers)
    {
+      CloseAuxCaptureStreams();
       Pa_AbortStream( mPortStreamV19 );
       Pa_CloseStream( mPortStreamV19 );
       mPortStreamV19 = NULL;
@@ -2035,6 +2379,37 @@ void AudioIO::PrepareMidiIterator(bool send, double offset)
          // casting away const, but allegro just uses the pointer as an opaque "cookie"
          (void*)t, t->GetOffset() + offset);
    }
+
+   // Drain the iterator into a flat time-sorted buffer right away.  Each
+   // call to the iterator pops a heap and grows pending note-off lists,
+   // which on the MIDI thread is audible as scheduling jitter in dense
+   // sequences; after this, FillMidiBuffers only advances a cursor.
+   // A note-off is merged in for every note, not only for notes that
+   // turn out audible; OutputEvent sends the surplus ones too, which is
+   // harmless, and mute and solo are still honored per event at output
+   // time.
+   mMidiEventBuffer.clear();
+   const double endTime = mPlaybackSchedule.mT1 + offset;
+   while (true) {
+      bool isNoteOn;
+      NoteTrack *track = NULL;
+      double nextOffset;
+      Alg_event_ptr event = mIterator->next(&isNoteOn,
+         (void **) &track, &nextOffset, endTime);
+      if (!event)
+         break;
+      double time = (isNoteOn ? event->time : event->get_end_time())
+         + nextOffset;
+      if (time > endTime) // terminate playback at mT1
+         break;
+      if (isNoteOn && event->is_note())
+         mIterator->request_note_off();
+      mMidiEventBuffer.push_back({ event, track, time, isNoteOn });
+   }
+   mIterator->end();
+   mIterator.reset();
+   mMidiEventCursor = 0;
+
    GetNextEvent(); // prime the pump for FillMidiBuffers
 
    // Start MIDI from current cursor position
@@ -2214,6 +2589,8 @@ void AudioIO::StopStream()
    }
   #endif
 
+   CloseAuxCaptureStreams();
+
    if (mPortStreamV19) {
       Pa_AbortStream( mPortStreamV19 );
       Pa_CloseStream( mPortStreamV19 );
@@ -2252,7 +2629,6 @@ void AudioIO::StopStream()
       }
       Pm_Close(mMidiStream);
       mMidiStream = NULL;
-      mIterator->end();
 
       // set in_use flags to false
       int nTracks = mMidiPlaybackTracks.size();
@@ -2262,7 +2638,9 @@ void AudioIO::StopStream()
          seq->set_in_use(false);
       }
 
-      mIterator.reset(); // just in case someone tries to reference it
+      // drop the pointers into the sequences
+      mMidiEventBuffer.clear();
+      mMidiEventCursor = 0;
    }
 #endif
 
@@ -2292,9 +2670,10 @@ void AudioIO::StopStream()
 
       if (mPlaybackTracks.size() > 0)
       {
-         mPlaybackBuffers.reset();
          mPlaybackMixers.reset();
-         mTimeQueue.mData.reset();
+         // Keep mPlaybackBuffers and the time queue; the next StartStream
+         // reuses them if their sizes still match, so starting the
+         // transport again is nearly allocation free
       }
 
       //
@@ -2302,7 +2681,7 @@ void AudioIO::StopStream()
       //
       if (mCaptureTracks.size() > 0)
       {
-         mCaptureBuffers.reset();
+         // mCaptureBuffers persist for reuse, like mPlaybackBuffers above
          mResample.reset();
 
          //
@@ -2629,6 +3008,8 @@ size_t AudioIO::GetCommonlyAvailCapture()
 // (which communicates with the audio device).
 void AudioIO::FillBuffers()
 {
+   PerfCounters::Scope scope{ PerfCounters::FillBuffers };
+
    unsigned int i;
 
    auto delayedHandler = [this] ( AudacityException * pException ) {
@@ -2740,26 +3121,46 @@ void AudioIO::FillBuffers()
                (mPlaybackSchedule.Interactive() ? mScrubSpeed : 1.0),
                frames);
 
-            for (i = 0; i < mPlaybackTracks.size(); i++)
-            {
-               // The mixer here isn't actually mixing: it's just doing
-               // resampling, format conversion, and possibly time track
-               // warping
-               samplePtr warpedSamples;
-
-               if (frames > 0)
-               {
-                  size_t processed = 0;
-                  if ( toProcess )
-                     processed = mPlaybackMixers[i]->Process( toProcess );
-                  //wxASSERT(processed <= toProcess);
-                  warpedSamples = mPlaybackMixers[i]->GetBuffer();
-                  const auto put = mPlaybackBuffers[i]->Put(
-                     warpedSamples, floatSample, processed, frames - processed);
-                  // wxASSERT(put == frames);
-                  // but we can't assert in this thread
-                  wxUnusedVar(put);
-               }               
+            // The mixers here aren't actually mixing: each is just doing
+            // resampling, format conversion, and possibly time track
+            // warping for one playback track, feeding that track's ring
+            // buffer.  For a handful of tracks that is done serially as
+            // before; for big sessions the tracks are sliced among the
+            // prefetch pool's workers, so disk decode and conversion
+            // scale across cores, with a completion barrier before the
+            // schedule is advanced.
+            if (frames > 0) {
+               const auto nTracks = mPlaybackTracks.size();
+               auto fillRange = [&]( size_t begin, size_t end ){
+                  for (size_t jj = begin; jj < end; ++jj) {
+                     size_t processed = 0;
+                     if ( toProcess )
+                        processed = mPlaybackMixers[jj]->Process( toProcess );
+                     //wxASSERT(processed <= toProcess);
+                     samplePtr warpedSamples = mPlaybackMixers[jj]->GetBuffer();
+                     const auto put = mPlaybackBuffers[jj]->Put(
+                        warpedSamples, floatSample, processed,
+                        frames - processed);
+                     // wxASSERT(put == frames);
+                     // but we can't assert in this thread
+                     wxUnusedVar(put);
+                  }
+               };
+
+               auto &pool = GetPlaybackPrefetchPool();
+               // Parallelism pays off only when there are enough tracks
+               // to amortize the dispatch overhead.
+               if (pool.Size() > 1 && nTracks >= 2 * pool.Size()) {
+                  const size_t slice =
+                     (nTracks + pool.Size() - 1) / pool.Size();
+                  for (size_t begin = 0; begin < nTracks; begin += slice)
+                     pool.Dispatch([=]{
+                        fillRange(begin, std::min(begin + slice, nTracks));
+                     });
+                  pool.Wait();
+               }
+               else
+                  fillRange(0, nTracks);
             }
 
             available -= frames;
@@ -2821,6 +3222,37 @@ void AudioIO::FillBuffers()
                      mPlaybackMixers[i]->Restart();
                   mPlaybackSchedule.RealTimeRestart();
                   realTimeRemaining = mPlaybackSchedule.RealTimeRemaining();
+
+                  // Splice the pre-rendered start of the loop straight
+                  // into the ring buffers, deferring the re-seek cost of
+                  // the restarted mixers past the seam
+                  if (!mLoopPrimeBuffers.empty() && available > 0)
+                  {
+                     size_t primeFrames = available;
+                     for (auto &prime : mLoopPrimeBuffers)
+                        primeFrames = std::min(primeFrames, prime.size());
+                     primeFrames = limitSampleBufferSize(primeFrames,
+                        sampleCount(floor(realTimeRemaining * mRate)));
+                     if (primeFrames > 0)
+                     {
+                        mTimeQueue.Producer(mPlaybackSchedule, mRate, 1.0,
+                           primeFrames);
+                        for (i = 0; i < mPlaybackTracks.size(); i++)
+                        {
+                           mPlaybackBuffers[i]->Put(
+                              (samplePtr)mLoopPrimeBuffers[i].data(),
+                              floatSample, primeFrames, 0);
+                           mPlaybackMixers[i]->Reposition(
+                              mPlaybackSchedule.mT0 + primeFrames / mRate);
+                        }
+                        mPlaybackSchedule.RealTimeAdvance(
+                           primeFrames / mRate);
+                        realTimeRemaining =
+                           mPlaybackSchedule.RealTimeRemaining();
+                        available -= primeFrames;
+                        done = !progress || (available == 0);
+                     }
+                  }
                }
             }
                break;
@@ -2853,6 +3285,25 @@ void AudioIO::FillBuffers()
             AutoSaveFile blockFileLog;
             auto numChannels = mCaptureTracks.size();
 
+            // Drift servo for aggregate capture:  trim each auxiliary
+            // stream's resampling factor by the imbalance between its
+            // ring occupancy and the main stream's, so free-running
+            // device clocks cannot drift the recorded tracks apart.  A
+            // fast device accumulates a surplus and must yield fewer
+            // output samples per input.
+            for (auto &pAux : mAuxCaptureStreams) {
+               auto &aux = *pAux;
+               if (aux.firstBuffer == 0 || aux.firstBuffer >= numChannels)
+                  continue;
+               const auto master =
+                  (long long) mCaptureBuffers[0]->AvailForGet();
+               const auto slave =
+                  (long long) mCaptureBuffers[aux.firstBuffer]->AvailForGet();
+               const double driftSecs = (slave - master) / mRate;
+               aux.driftFactor = std::max( 0.999,
+                  std::min( 1.001, 1.0 - driftSecs * 0.01 ) );
+            }
+
             for( i = 0; i < numChannels; i++ )
             {
                sampleFormat trackFormat = mCaptureTracks[i]->GetSampleFormat();
@@ -2910,7 +3361,16 @@ void AudioIO::FillBuffers()
                SampleBuffer temp;
                size_t size;
                sampleFormat format;
-               if( mFactor == 1.0 )
+
+               // Aggregate capture:  an auxiliary device's channels
+               // resample by that device's drift-servoed factor
+               double factor = mFactor;
+               for (auto &pAux : mAuxCaptureStreams)
+                  if (i >= pAux->firstBuffer &&
+                      i < pAux->firstBuffer + pAux->numChannels)
+                     factor *= (mRate / pAux->rate) * pAux->driftFactor;
+
+               if( factor == 1.0 )
                {
                   // Take captured samples directly
                   size = toGet;
@@ -2930,7 +3390,7 @@ void AudioIO::FillBuffers()
                }
                else
                {
-                  size = lrint(toGet * mFactor);
+                  size = lrint(toGet * factor);
                   format = floatSample;
                   SampleBuffer temp1(toGet, floatSample);
                   temp.Allocate(size, format);
@@ -2947,7 +3407,7 @@ void AudioIO::FillBuffers()
                      if (double(toGet) > remainingSamples)
                         toGet = floor(remainingSamples);
                      const auto results =
-                     mResample[i]->Process(mFactor, (float *)temp1.ptr(), toGet,
+                     mResample[i]->Process(factor, (float *)temp1.ptr(), toGet,
                                            !IsStreamActive(), (float *)temp.ptr(), size);
                      size = results.second;
                   }
@@ -3086,9 +3546,10 @@ void AudioIO::OutputEvent()
    // when the user presses the mute button. We have no easy way
    // to know what notes are sounding on any given muted track, so
    // we'll just wait for the note-off events to happen.
-   // Also note that note-offs are only sent when we call
-   // mIterator->request_note_off(), so notes that are not played
-   // will note generate random note-offs. There is the interesting
+   // Also note that a note-off was merged into the event buffer for
+   // every note, so notes whose note-on was suppressed get a note-off
+   // anyway; a note-off for a note that is not sounding is ignored by
+   // synthesizers. There is the interesting
    // case that if the playback is paused, all-notes-off WILL be sent
    // and if playback resumes, the pending note-off events WILL also
    // be sent (but if that is a problem, there would also be a problem
@@ -3108,8 +3569,7 @@ void AudioIO::OutputEvent()
             data2 += offset; // offset comes from per-track slider
             // clip velocity to insure a legal note-on value
             data2 = (data2 < 1 ? 1 : (data2 > 127 ? 127 : data2));
-            // since we are going to play this note, we need to get a note_off
-            mIterator->request_note_off();
+            // the matching note_off is already in the event buffer
 
 #ifdef AUDIO_IO_GB_MIDI_WORKAROUND
             mPendingNotesOff.push_back(std::make_pair(channel, data1));
@@ -3191,29 +3651,25 @@ void AudioIO::OutputEvent()
 void AudioIO::GetNextEvent()
 {
    mNextEventTrack = NULL; // clear it just to be safe
-   // now get the next event and the track from which it came
-   double nextOffset;
-   if (!mIterator) {
-        mNextEvent = NULL;
-        return;
+   // now take the next event from the linearized buffer
+   if (mMidiEventCursor < mMidiEventBuffer.size()) {
+      const MidiPlaybackEvent &ev = mMidiEventBuffer[mMidiEventCursor++];
+      mNextEvent = ev.event;
+      mNextEventTrack = ev.track;
+      mNextEventTime = ev.time;
+      mNextIsNoteOn = ev.isNoteOn;
    }
-   auto midiLoopOffset = MidiLoopOffset();
-   mNextEvent = mIterator->next(&mNextIsNoteOn,
-      (void **) &mNextEventTrack,
-      &nextOffset, mPlaybackSchedule.mT1 + midiLoopOffset);
-
-   mNextEventTime  = mPlaybackSchedule.mT1 + midiLoopOffset + 1;
-   if (mNextEvent) {
-      mNextEventTime = (mNextIsNoteOn ? mNextEvent->time :
-                              mNextEvent->get_end_time()) + nextOffset;;
-   } 
-   if (mNextEventTime > (mPlaybackSchedule.mT1 + midiLoopOffset)){ // terminate playback at mT1
+   else if (mMidiEventCursor == mMidiEventBuffer.size()) {
+      // the buffer holds no events past mT1; terminate playback there
+      // with the fake event, delivered once
+      ++mMidiEventCursor;
       mNextEvent = &gAllNotesOff;
-      mNextEventTime = mPlaybackSchedule.mT1 + midiLoopOffset - ALG_EPS;
+      mNextEventTime =
+         mPlaybackSchedule.mT1 + MidiLoopOffset() - ALG_EPS;
       mNextIsNoteOn = true; // do not look at duration
-      mIterator->end();
-      mIterator.reset(); // debugging aid
    }
+   else
+      mNextEvent = NULL;
 }
 
 
@@ -3581,15 +4037,150 @@ static void DoSoftwarePlaythrough(const void *inputBuffer,
          outputBuffer[2*i + 1] = outputBuffer[2*i];
 }
 
+void AudioIoCallback::CallbackTelemetry::Reset()
+{
+   for (auto &bin : durationBins)
+      bin.store(0, std::memory_order_relaxed);
+   callbacks.store(0, std::memory_order_relaxed);
+   xruns.store(0, std::memory_order_relaxed);
+   playbackFillMin.store(-1, std::memory_order_relaxed);
+   captureFillMax.store(-1, std::memory_order_relaxed);
+   playbackFillRecent.store(-1, std::memory_order_relaxed);
+}
+
+void AudioIoCallback::CallbackTelemetry::RecordDuration(long long micros)
+{
+   unsigned bin = 0;
+   while (micros > 1 && bin < nDurationBins - 1) {
+      micros >>= 1;
+      bin++;
+   }
+   durationBins[bin].fetch_add(1, std::memory_order_relaxed);
+   callbacks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioIoCallback::CallbackTelemetry::RecordPlaybackFill(long long samples)
+{
+   auto prev = playbackFillMin.load(std::memory_order_relaxed);
+   while ((prev < 0 || prev > samples) &&
+          !playbackFillMin.compare_exchange_weak(
+             prev, samples, std::memory_order_relaxed))
+      ;
+   prev = playbackFillRecent.load(std::memory_order_relaxed);
+   while ((prev < 0 || prev > samples) &&
+          !playbackFillRecent.compare_exchange_weak(
+             prev, samples, std::memory_order_relaxed))
+      ;
+}
+
+void AudioIoCallback::CallbackTelemetry::RecordCaptureFill(long long samples)
+{
+   auto prev = captureFillMax.load(std::memory_order_relaxed);
+   while (prev < samples &&
+          !captureFillMax.compare_exchange_weak(
+             prev, samples, std::memory_order_relaxed))
+      ;
+}
+
+wxString AudioIoCallback::GetTelemetryReport()
+{
+   auto &telemetry = mCallbackTelemetry;
+   wxString report;
+
+   report += wxString::Format(wxT("audio callbacks: %lld, xruns: %lld\n"),
+      telemetry.callbacks.load(std::memory_order_relaxed),
+      telemetry.xruns.load(std::memory_order_relaxed));
+
+   const auto playbackFillMin =
+      telemetry.playbackFillMin.load(std::memory_order_relaxed);
+   const auto captureFillMax =
+      telemetry.captureFillMax.load(std::memory_order_relaxed);
+   if (playbackFillMin >= 0)
+      report += wxString::Format(
+         wxT("playback buffer low watermark: %lld samples\n"),
+         playbackFillMin);
+   if (captureFillMax >= 0)
+      report += wxString::Format(
+         wxT("capture buffer high watermark: %lld samples\n"),
+         captureFillMax);
+
+   report += wxT("callback duration histogram:\n");
+   for (unsigned bin = 0;
+        bin < CallbackTelemetry::nDurationBins; bin++) {
+      const auto count =
+         telemetry.durationBins[bin].load(std::memory_order_relaxed);
+      if (count)
+         report += wxString::Format(wxT("  < %d us: %lld\n"),
+            1 << (bin + 1), count);
+   }
+   return report;
+}
+
+wxString AudioIoCallback::GetTelemetryAlert()
+{
+   if (mXrunAlertThreshold <= 0)
+      return {};
+   const auto xruns =
+      mCallbackTelemetry.xruns.load(std::memory_order_relaxed);
+   if (xruns < mXrunAlertThreshold || xruns == mXrunsReported)
+      return {};
+   mXrunsReported = xruns;
+   return wxString::Format(
+      _("Audio dropouts detected: %lld buffer under- or overruns"),
+      xruns);
+}
+
+int AudioIoCallback::GetCallbackPressure()
+{
+   auto &telemetry = mCallbackTelemetry;
+
+   const auto xruns = telemetry.xruns.load(std::memory_order_relaxed);
+   const bool sawXrun = xruns > mXrunsSeenByUI;
+   mXrunsSeenByUI = xruns;
+   if (sawXrun)
+      return 2;
+
+   // Consume the rolling low watermark
+   const auto fill =
+      telemetry.playbackFillRecent.exchange(-1, std::memory_order_relaxed);
+   // Running below one replenishment batch means FillBuffers is not
+   // keeping ahead of the callback
+   if (fill >= 0 && fill < (long long)mPlaybackSamplesToCopy)
+      return 1;
+
+   return 0;
+}
+
 int audacityAudioCallback(const void *inputBuffer, void *outputBuffer,
                           unsigned long framesPerBuffer,
                           const PaStreamCallbackTimeInfo *timeInfo,
                           const PaStreamCallbackFlags statusFlags, void *userData )
 {
+   PerfCounters::Scope scope{ PerfCounters::AudioCallback };
    auto gAudioIO = AudioIO::Get();
-   return gAudioIO->AudioCallback(
+   auto &telemetry = gAudioIO->mCallbackTelemetry;
+
+   if (statusFlags & (paInputOverflow | paOutputUnderflow))
+      telemetry.xruns.fetch_add(1, std::memory_order_relaxed);
+
+   const auto start = std::chrono::steady_clock::now();
+   const int result = gAudioIO->AudioCallback(
       inputBuffer, outputBuffer, framesPerBuffer,
       timeInfo, statusFlags, userData);
+   telemetry.RecordDuration(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+         std::chrono::steady_clock::now() - start).count());
+
+   // Watermarks of the ring buffers, read on this thread, which is
+   // the consumer of playback data and the producer of capture data
+   for (unsigned i = 0; i < gAudioIO->mPlaybackTracks.size(); i++)
+      telemetry.RecordPlaybackFill(
+         gAudioIO->mPlaybackBuffers[i]->AvailForGet());
+   for (unsigned i = 0; i < gAudioIO->mCaptureTracks.size(); i++)
+      telemetry.RecordCaptureFill(
+         gAudioIO->mCaptureBuffers[i]->AvailForGet());
+
+   return result;
 }
 
 
@@ -3702,6 +4293,112 @@ void AudioIoCallback::CheckSoundActivatedRecordingLevel( const void *inputBuffer
    }
 }
 
+// Keep the most recent input while sound activated recording waits,
+// paused, below the activation level, and put that history into the
+// capture ring buffers ahead of the live data when recording resumes.
+// Without it, recording starts only after the trigger and the attack of
+// the triggering sound is clipped off.
+// Must run before FillInputBuffers and before the paused quick return
+// of the callback.
+void AudioIoCallback::CollectSoundActivatedPreRoll(
+   const void *inputBuffer,
+   unsigned long framesPerBuffer,
+   float *tempFloats
+)
+{
+   const auto numCaptureChannels = mNumCaptureChannels;
+   const auto capacity = mSoundActivatedPreRollCapacity;
+
+   // Quick returns if next to nothing to do.
+   if (mStreamToken <= 0)
+      return;
+   if( capacity == 0 )
+      return;
+   if( numCaptureChannels <= 0 )
+      return;
+   if( !mPauseRec )
+      return;
+
+   const size_t sampleSize = SAMPLE_SIZE(mCaptureFormat);
+   char *ring = mSoundActivatedPreRoll.get();
+
+   if (!IsPaused()) {
+      // Triggered:  prepend the history, oldest frames first, before
+      // FillInputBuffers adds the block that crossed the threshold
+      if (mSoundActivatedPreRollCount > 0) {
+         size_t frames = mSoundActivatedPreRollCount;
+         for (unsigned t = 0; t < numCaptureChannels; t++)
+            frames = std::min( frames, mCaptureBuffers[t]->AvailForPut() );
+         const size_t start =
+            (mSoundActivatedPreRollPos + capacity - frames) % capacity;
+         for (unsigned t = 0; t < numCaptureChannels; t++) {
+            char *channelRing = ring + t * capacity * sampleSize;
+            const auto firstRun = std::min( frames, capacity - start );
+            // The history may wrap around the pre-roll ring; append
+            // both pieces and publish them to the reader together
+            mCaptureBuffers[t]->Append(
+               channelRing + start * sampleSize, mCaptureFormat, firstRun);
+            if (frames > firstRun)
+               mCaptureBuffers[t]->Append(
+                  channelRing, mCaptureFormat, frames - firstRun);
+            mCaptureBuffers[t]->Publish();
+         }
+         mSoundActivatedPreRollPos = 0;
+         mSoundActivatedPreRollCount = 0;
+      }
+      return;
+   }
+
+   if( !inputBuffer )
+      return;
+
+   // Below the activation level:  deinterleave this block (tempFloats
+   // has room for every capture channel) and append it to the per
+   // channel history rings, overwriting the oldest frames
+   size_t len = framesPerBuffer;
+   switch(mCaptureFormat) {
+      case floatSample: {
+         float *inputFloats = (float *)inputBuffer;
+         DeinterleaveCaptureFloats(inputFloats, tempFloats,
+            len, numCaptureChannels);
+      } break;
+      case int24Sample:
+         // As in FillInputBuffers, PortAudio gives us floats instead
+         wxASSERT(false);
+         return;
+      case int16Sample: {
+         short *inputShorts = (short *)inputBuffer;
+         short *tempShorts = (short *)tempFloats;
+         DeinterleaveCaptureShorts(inputShorts, tempShorts,
+            len, numCaptureChannels);
+      } break;
+   } // switch
+
+   const char *deinterleaved = (const char *)tempFloats;
+   size_t skip = 0;
+   if (len >= capacity) {
+      // A block larger than the whole history:  keep only its newest
+      // capacity frames
+      skip = len - capacity;
+      len = capacity;
+      mSoundActivatedPreRollPos = 0;
+   }
+   const size_t pos = mSoundActivatedPreRollPos;
+   for (unsigned t = 0; t < numCaptureChannels; t++) {
+      const char *src = deinterleaved +
+         (t * framesPerBuffer + skip) * sampleSize;
+      char *channelRing = ring + t * capacity * sampleSize;
+      const auto firstRun = std::min( len, capacity - pos );
+      memcpy(channelRing + pos * sampleSize, src, firstRun * sampleSize);
+      if (len > firstRun)
+         memcpy(channelRing, src + firstRun * sampleSize,
+            (len - firstRun) * sampleSize);
+   }
+   mSoundActivatedPreRollPos = (pos + len) % capacity;
+   mSoundActivatedPreRollCount =
+      std::min( capacity, mSoundActivatedPreRollCount + len );
+}
+
 
 // A function to apply the requested gain, fading up or down from the
 // most recently applied gain.
@@ -3803,6 +4500,7 @@ bool AudioIoCallback::FillOutputBuffers(
    em.RealtimeProcessStart();
 
    bool selected = false;
+   bool frozen = false;
    int group = 0;
    int chanCnt = 0;
 
@@ -3844,6 +4542,9 @@ bool AudioIoCallback::FillOutputBuffers(
       if ( firstChannel )
       {
          selected = vt->GetSelected();
+         // Frozen tracks already carry the chain's output in their ring
+         // buffers; don't process them again
+         frozen = t < mPlaybackTrackFrozen.size() && mPlaybackTrackFrozen[t];
          // IF mono THEN clear 'the other' channel.
          if ( lastChannel && (numPlaybackChannels>1)) {
             // TODO: more-than-two-channels
@@ -3897,7 +4598,7 @@ bool AudioIoCallback::FillOutputBuffers(
       // Last channel of a track seen now
       len = mMaxFramesOutput;
 
-      if( !dropQuickly && selected )
+      if( !dropQuickly && selected && !frozen )
          len = em.RealtimeProcess(group, chanCnt, tempBufs, len);
       group++;
 
@@ -3963,6 +4664,94 @@ void AudioIoCallback::UpdateTimePosition(unsigned long framesPerBuffer)
       mPlaybackSchedule.TrackTimeUpdate( framesPerBuffer / mRate );
 }
 
+// Deinterleave captured samples in one pass over the input, writing each
+// channel's samples contiguously at out + t * len.  This runs inside the
+// realtime callback, so the common channel counts get SSE2 shuffle
+// kernels where the target has them; the scalar loop remains as the
+// general case and the tail.
+static void DeinterleaveCaptureFloats(const float *in, float *out,
+   size_t len, unsigned numChannels)
+{
+   size_t i = 0;
+#ifdef AUDIO_IO_USE_SSE2
+   if (numChannels == 2) {
+      float *dst0 = out, *dst1 = out + len;
+      for (; i + 4 <= len; i += 4) {
+         const __m128 a = _mm_loadu_ps(in + 2 * i);      // L0 R0 L1 R1
+         const __m128 b = _mm_loadu_ps(in + 2 * i + 4);  // L2 R2 L3 R3
+         _mm_storeu_ps(dst0 + i,
+            _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+         _mm_storeu_ps(dst1 + i,
+            _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+      }
+   }
+   else if (numChannels == 4) {
+      for (; i + 4 <= len; i += 4) {
+         __m128 row0 = _mm_loadu_ps(in + 4 * i);
+         __m128 row1 = _mm_loadu_ps(in + 4 * i + 4);
+         __m128 row2 = _mm_loadu_ps(in + 4 * i + 8);
+         __m128 row3 = _mm_loadu_ps(in + 4 * i + 12);
+         _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+         _mm_storeu_ps(out + i, row0);
+         _mm_storeu_ps(out + len + i, row1);
+         _mm_storeu_ps(out + 2 * len + i, row2);
+         _mm_storeu_ps(out + 3 * len + i, row3);
+      }
+   }
+   else if (numChannels == 8) {
+      for (; i + 4 <= len; i += 4) {
+         // Four frames make two 4x4 transposes, one per half of the
+         // channels
+         const float *frames = in + 8 * i;
+         for (unsigned half = 0; half < 2; half++) {
+            __m128 row0 = _mm_loadu_ps(frames + 4 * half);
+            __m128 row1 = _mm_loadu_ps(frames + 4 * half + 8);
+            __m128 row2 = _mm_loadu_ps(frames + 4 * half + 16);
+            __m128 row3 = _mm_loadu_ps(frames + 4 * half + 24);
+            _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+            float *dst = out + 4 * half * len + i;
+            _mm_storeu_ps(dst, row0);
+            _mm_storeu_ps(dst + len, row1);
+            _mm_storeu_ps(dst + 2 * len, row2);
+            _mm_storeu_ps(dst + 3 * len, row3);
+         }
+      }
+   }
+#endif
+   for (; i < len; i++)
+      for (unsigned t = 0; t < numChannels; t++)
+         out[t * len + i] = in[numChannels * i + t];
+}
+
+static void DeinterleaveCaptureShorts(const short *in, short *out,
+   size_t len, unsigned numChannels)
+{
+   size_t i = 0;
+#ifdef AUDIO_IO_USE_SSE2
+   if (numChannels == 2) {
+      short *dst0 = out, *dst1 = out + len;
+      for (; i + 8 <= len; i += 8) {
+         const __m128i a =
+            _mm_loadu_si128((const __m128i *)(in + 2 * i));
+         const __m128i b =
+            _mm_loadu_si128((const __m128i *)(in + 2 * i + 8));
+         // Sign-extend alternate 16-bit lanes to 32 bits, then pack the
+         // eight left and eight right samples back to 16 bits
+         const __m128i even = _mm_packs_epi32(
+            _mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+            _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+         const __m128i odd = _mm_packs_epi32(
+            _mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16));
+         _mm_storeu_si128((__m128i *)(dst0 + i), even);
+         _mm_storeu_si128((__m128i *)(dst1 + i), odd);
+      }
+   }
+#endif
+   for (; i < len; i++)
+      for (unsigned t = 0; t < numChannels; t++)
+         out[t * len + i] = in[numChannels * i + t];
+}
+
 // return true, IFF we have fully handled the callback.
 //
 // Copy from PortAudio to our input buffers.
@@ -4036,54 +4825,98 @@ void AudioIoCallback::FillInputBuffers(
    if (len <= 0) 
       return;
 
-   // We have an ASSERT in the AudioIO constructor to alert us to 
+   // We have an ASSERT in the AudioIO constructor to alert us to
    // possible issues with the (short*) cast.  We'd have a problem if
    // sizeof(short) > sizeof(float) since our buffers are sized for floats.
-   for(unsigned t = 0; t < numCaptureChannels; t++) {
 
-      // dmazzoni:
-      // Un-interleave.  Ugly special-case code required because the
-      // capture channels could be in three different sample formats;
-      // it'd be nice to be able to call CopySamples, but it can't
-      // handle multiplying by the gain and then clipping.  Bummer.
-
-      switch(mCaptureFormat) {
-         case floatSample: {
-            float *inputFloats = (float *)inputBuffer;
-            for(unsigned i = 0; i < len; i++)
-               tempFloats[i] =
-                  inputFloats[numCaptureChannels*i+t];
-         } break;
-         case int24Sample:
-            // We should never get here. Audacity's int24Sample format
-            // is different from PortAudio's sample format and so we
-            // make PortAudio return float samples when recording in
-            // 24-bit samples.
-            wxASSERT(false);
-            break;
-         case int16Sample: {
-            short *inputShorts = (short *)inputBuffer;
-            short *tempShorts = (short *)tempFloats;
-            for( unsigned i = 0; i < len; i++) {
-               float tmp = inputShorts[numCaptureChannels*i+t];
-               tmp = wxClip( -32768, tmp, 32767 );
-               tempShorts[i] = (short)(tmp);
-            }
-         } break;
-      } // switch
+   // Un-interleave all channels in a single pass over the input.
+   // tempFloats is sized for framesPerBuffer frames of every capture
+   // channel (see audacityAudioCallback), so channel t lands
+   // contiguously at offset t * len and goes from there to its ring
+   // buffer.
+   switch(mCaptureFormat) {
+      case floatSample: {
+         float *inputFloats = (float *)inputBuffer;
+         DeinterleaveCaptureFloats(inputFloats, tempFloats,
+            len, numCaptureChannels);
+      } break;
+      case int24Sample:
+         // We should never get here. Audacity's int24Sample format
+         // is different from PortAudio's sample format and so we
+         // make PortAudio return float samples when recording in
+         // 24-bit samples.
+         wxASSERT(false);
+         break;
+      case int16Sample: {
+         short *inputShorts = (short *)inputBuffer;
+         short *tempShorts = (short *)tempFloats;
+         DeinterleaveCaptureShorts(inputShorts, tempShorts,
+            len, numCaptureChannels);
+      } break;
+   } // switch
 
+   for(unsigned t = 0; t < numCaptureChannels; t++) {
       // JKC: mCaptureFormat must be for samples with sizeof(float) or
-      // fewer bytes (because tempFloats is sized for floats).  All 
+      // fewer bytes (because tempFloats is sized for floats).  All
       // formats are 2 or 4 bytes, so we are OK.
+      const auto ptr = mCaptureFormat == int16Sample
+         ? (samplePtr)((short *)tempFloats + t * len)
+         : (samplePtr)(tempFloats + t * len);
       const auto put =
-         mCaptureBuffers[t]->Put(
-            (samplePtr)tempFloats, mCaptureFormat, len);
+         mCaptureBuffers[t]->Put(ptr, mCaptureFormat, len);
       // wxASSERT(put == len);
       // but we can't assert in this thread
       wxUnusedVar(put);
    }
 }
 
+// Aggregate multi-device capture:  deinterleave one auxiliary device's
+// block into that device's share of the capture ring buffers.  The
+// buffer-filling thread resamples these channels by a drift-servoed
+// factor when draining, holding them to the main stream's clock.
+int AudioIoCallback::AuxAudioCallback(AuxCaptureStream &aux,
+   const void *inputBuffer, unsigned long framesPerBuffer)
+{
+   // Quick returns if next to nothing to do.
+   if (mStreamToken <= 0)
+      return paContinue;
+   if( !inputBuffer )
+      return paContinue;
+   if( IsPaused() )
+      return paContinue;
+
+   const auto numChannels = aux.numChannels;
+   float *deinterleaved = (float *)alloca(
+      framesPerBuffer * numChannels * sizeof(float));
+
+   size_t len = framesPerBuffer;
+   for (unsigned t = 0; t < numChannels; t++)
+      len = std::min( len,
+         mCaptureBuffers[aux.firstBuffer + t]->AvailForPut() );
+   if (len == 0)
+      return paContinue;
+
+   DeinterleaveCaptureFloats((const float *)inputBuffer, deinterleaved,
+      framesPerBuffer, numChannels);
+
+   for (unsigned t = 0; t < numChannels; t++)
+      mCaptureBuffers[aux.firstBuffer + t]->Put(
+         (samplePtr)(deinterleaved + t * framesPerBuffer),
+         floatSample, len);
+
+   return paContinue;
+}
+
+int auxAudioCallback(const void *inputBuffer, void *WXUNUSED(outputBuffer),
+   unsigned long framesPerBuffer,
+   const PaStreamCallbackTimeInfo *WXUNUSED(timeInfo),
+   PaStreamCallbackFlags WXUNUSED(statusFlags), void *userData)
+{
+   auto aux = static_cast<AudioIoCallback::AuxCaptureStream *>(userData);
+   return aux->owner->AuxAudioCallback(
+      *aux, inputBuffer, framesPerBuffer);
+}
+
 
 #if 0
 // Record the reported latency from PortAudio.
@@ -4368,7 +5201,15 @@ int AudioIoCallback::AudioCallback(const void *inputBuffer, void *outputBuffer,
    // recording.
    CheckSoundActivatedRecordingLevel(
       inputBuffer);
-  
+
+   // Retain or flush the recent input history for sound activated
+   // recording; while paused below the activation level the quick
+   // return just after this would otherwise discard the input.
+   CollectSoundActivatedPreRoll(
+      inputBuffer,
+      framesPerBuffer,
+      tempFloats);
+
    // Even when paused, we do playthrough.
    // Initialise output buffer to zero or to playthrough data.
    // Initialise output meter values.
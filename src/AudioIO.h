@@ -19,6 +19,7 @@
 
 #include "Experimental.h"
 
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <wx/atomic.h> // member variable
@@ -125,6 +126,14 @@ int audacityAudioCallback(
    const PaStreamCallbackTimeInfo *timeInfo,
    PaStreamCallbackFlags statusFlags, void *userData );
 
+/* Callback of one auxiliary capture stream in aggregate multi-device
+ * recording; userData points at the stream's AuxCaptureStream record. */
+int auxAudioCallback(
+   const void *inputBuffer, void *outputBuffer,
+   unsigned long framesPerBuffer,
+   const PaStreamCallbackTimeInfo *timeInfo,
+   PaStreamCallbackFlags statusFlags, void *userData );
+
 // Communicate data from one writer to one reader.
 // This is not a queue: it is not necessary for each write to be read.
 // Rather loss of a message is allowed:  writer may overwrite.
@@ -267,6 +276,11 @@ public:
       const PaStreamCallbackTimeInfo *timeInfo,
       unsigned long framesPerBuffer);
    void CheckSoundActivatedRecordingLevel(const void *inputBuffer);
+   void CollectSoundActivatedPreRoll(
+      const void *inputBuffer,
+      unsigned long framesPerBuffer,
+      float *tempFloats
+      );
    void AddToOutputChannel( unsigned int chan,
       float * outputMeterFloats,
       float * outputFloats,
@@ -375,6 +389,22 @@ public:
 
    Alg_seq_ptr      mSeq;
    std::unique_ptr<Alg_iterator> mIterator;
+
+   /// One event of the play region, linearized from the Allegro iterator
+   struct MidiPlaybackEvent {
+      Alg_event_ptr event;
+      NoteTrack    *track;
+      /// Real time of output; a note's time+duration for note-offs
+      double        time;
+      bool          isNoteOn;
+   };
+   /// All events of the play region in time order with note-offs merged
+   /// in, drained from the iterator by PrepareMidiIterator.  The MIDI
+   /// thread afterwards only advances mMidiEventCursor, so dense
+   /// sequences play without per-event heap traffic
+   std::vector<MidiPlaybackEvent> mMidiEventBuffer;
+   size_t           mMidiEventCursor;
+
    /// The next event to play (or null)
    Alg_event_ptr    mNextEvent;
 
@@ -421,8 +451,41 @@ public:
    ArrayOf<std::unique_ptr<Resample>> mResample;
    ArrayOf<std::unique_ptr<RingBuffer>> mCaptureBuffers;
    WaveTrackArray      mCaptureTracks;
+
+public:
+   // One auxiliary input-only stream of aggregate multi-device capture
+   // (see AudioIO::OpenAuxCaptureStreams).  Its channels occupy the
+   // capture ring buffers beyond those the main stream feeds.
+   struct AuxCaptureStream {
+      AudioIoCallback *owner{ nullptr };
+      PaStream        *stream{ nullptr };
+      unsigned         numChannels{ 0 };
+      unsigned         firstBuffer{ 0 }; // index into mCaptureBuffers
+      double           rate{ 0.0 };      // the stream's actual rate
+      double           driftFactor{ 1.0 }; // trimmed in FillBuffers
+   };
+   int AuxAudioCallback(AuxCaptureStream &aux,
+      const void *inputBuffer, unsigned long framesPerBuffer);
+protected:
+   std::vector<std::unique_ptr<AuxCaptureStream>> mAuxCaptureStreams;
+
    ArrayOf<std::unique_ptr<RingBuffer>> mPlaybackBuffers;
    WaveTrackArray      mPlaybackTracks;
+   // Parallel to mPlaybackTracks; true where the playback mixer reads a
+   // pre-rendered shadow track (see TrackFreeze) and the audio callback
+   // must not apply the realtime effect chain again
+   std::vector<bool>   mPlaybackTrackFrozen;
+   // When loop-playing, the pre-rendered start of the loop region, one
+   // buffer per playback track; FillBuffers splices it into the ring
+   // buffers at the wrap so the seam costs a copy instead of waiting on
+   // a synchronous re-seek of every mixer
+   std::vector<std::vector<float>> mLoopPrimeBuffers;
+
+   // How many ring buffers the two arrays above still hold between a
+   // transport stop and the next start; buffers whose size and format
+   // match what the next start needs are reused, not reallocated
+   size_t              mCaptureBufferPoolSize{ 0 };
+   size_t              mPlaybackBufferPoolSize{ 0 };
 
    ArrayOf<std::unique_ptr<Mixer>> mPlaybackMixers;
    static int          mNextStreamToken;
@@ -444,6 +507,16 @@ public:
    /// True if Sound Activated Recording is enabled
    bool                mPauseRec;
    float               mSilenceLevel;
+   // Pre-roll history for sound activated recording:  while the stream
+   // waits, paused, below the activation level, the callback keeps the
+   // most recent input here (one ring per channel, in mCaptureFormat),
+   // and puts it into the capture ring buffers ahead of the live data
+   // when recording resumes, so the attack of the triggering sound is
+   // kept.  Touched only by the callback thread once the stream runs.
+   ArrayOf<char>       mSoundActivatedPreRoll;
+   size_t              mSoundActivatedPreRollCapacity{ 0 }; // frames per channel
+   size_t              mSoundActivatedPreRollPos{ 0 };
+   size_t              mSoundActivatedPreRollCount{ 0 };
    unsigned int        mNumCaptureChannels;
    unsigned int        mNumPlaybackChannels;
    sampleFormat        mCaptureFormat;
@@ -512,6 +585,45 @@ public:
    const std::vector< std::pair<double, double> > &LostCaptureIntervals()
    { return mLostCaptureIntervals; }
 
+   // Telemetry gathered on the PortAudio callback thread.  Writes use
+   // relaxed atomics, so collection costs a few increments per callback;
+   // readers on other threads get a slightly stale but usable view.
+   struct CallbackTelemetry {
+      // Bin n counts callbacks that ran for [2^n, 2^(n+1)) microseconds
+      enum : unsigned { nDurationBins = 16 };
+      std::atomic<long long> durationBins[nDurationBins] = {};
+      std::atomic<long long> callbacks{ 0 };
+      std::atomic<long long> xruns{ 0 };
+      // Fewest samples ready in any playback ring buffer and most
+      // samples pending in any capture ring buffer since stream start;
+      // -1 means never measured
+      std::atomic<long long> playbackFillMin{ -1 };
+      std::atomic<long long> captureFillMax{ -1 };
+      // Like playbackFillMin, but consumed (reset to -1) by each call
+      // of GetCallbackPressure, so the UI sees a rolling watermark
+      std::atomic<long long> playbackFillRecent{ -1 };
+
+      void Reset();
+      void RecordDuration(long long micros);
+      void RecordPlaybackFill(long long samples);
+      void RecordCaptureFill(long long samples);
+   };
+   CallbackTelemetry mCallbackTelemetry;
+
+   /// Human-readable telemetry summary for the diagnostics window
+   wxString GetTelemetryReport();
+
+   /// Returns a nonempty alert message when the xrun count has grown
+   /// past the threshold configured in /AudioIO/XrunAlertThreshold
+   /// since the last call; meant to be polled from the main thread
+   wxString GetTelemetryAlert();
+
+   /// How much pressure the audio thread is under, for the UI to adapt
+   /// its refresh work to: 0 is healthy, 1 means some playback ring
+   /// buffer ran low since the last call, 2 means xruns occurred since
+   /// the last call.  Meant to be polled from the main thread.
+   int GetCallbackPressure();
+
    // Used only for testing purposes in alpha builds
    bool mSimulateRecordingErrors{ false };
 
@@ -520,6 +632,13 @@ public:
    bool mDetectUpstreamDropouts{ true };
 
 protected:
+   // Alert threshold read from preferences at stream start; 0 disables
+   long mXrunAlertThreshold{ 0 };
+   // Count already reported through GetTelemetryAlert()
+   long long mXrunsReported{ 0 };
+   // Count already seen by GetCallbackPressure()
+   long long mXrunsSeenByUI{ 0 };
+
    RecordingSchedule mRecordingSchedule{};
 
    // Another circular buffer
@@ -736,6 +855,17 @@ private:
                              unsigned int numPlaybackChannels,
                              unsigned int numCaptureChannels,
                              sampleFormat captureFormat);
+
+   /** \brief Open auxiliary input-only streams for aggregate capture.
+    *
+    * Assigns the capture channels beyond the main device's inputs to the
+    * recording devices listed in /AudioIO/AuxRecordingDevices, in order.
+    * Returns true iff every requested channel found a device. */
+   bool OpenAuxCaptureStreams(unsigned int totalCaptureChannels,
+                              double latencyDuration);
+   void StartAuxCaptureStreams();
+   void CloseAuxCaptureStreams();
+
    void FillBuffers();
 
 #ifdef EXPERIMENTAL_MIDI_OUT
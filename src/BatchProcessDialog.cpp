@@ -37,6 +37,11 @@
 #include <wx/button.h>
 #include <wx/imaglist.h>
 #include <wx/settings.h>
+#include <wx/ffile.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #include "ShuttleGui.h"
 #include "Menus.h"
@@ -455,8 +460,47 @@ void ApplyMacroDialog::OnApplyToFiles(wxCommandEvent & WXUNUSED(event))
    // and hiding this one temporarily has some advantages.
    Hide();
 
+   // Nobody can see the project while the files are processed, but import,
+   // effects and undo all ask it to redraw itself after every step, and
+   // painting the waveforms is what populates the wave and spectrum caches.
+   // Suspend painting of the project window for the duration of the loop;
+   // the deferred repaints collapse into one when it thaws.  (Opening the
+   // project without constructing its panels at all would be a much bigger
+   // change, since commands and effects reach for the window through their
+   // context.)
+   auto &window = ProjectWindow::Get( *project );
+   window.Freeze();
+   auto cleanup = finally( [&]{ window.Thaw(); } );
+
+   // The files themselves are independent, but commands and effects may
+   // only run on the main thread, so the files cannot be processed in
+   // parallel.  What can be overlapped is the disk traffic:  a helper
+   // thread reads each file once, staying one file ahead of the processing
+   // loop, so that import finds its file already in the system's cache
+   // instead of stalling on a cold read.
+   std::atomic<int> processing{ 0 };
+   std::atomic<bool> stopPrefetch{ false };
+   std::thread prefetcher{ [&]{
+      std::vector<char> buffer( 1 << 20 );
+      for (int f = 0; f < (int)files.size() && !stopPrefetch.load(); ++f) {
+         while (f > processing.load() + 1 && !stopPrefetch.load())
+            ::wxMilliSleep(50);
+         wxFFile file( files[f], wxT("rb") );
+         if (!file.IsOpened())
+            continue;
+         while (!file.Eof() && !stopPrefetch.load())
+            if (file.Read( buffer.data(), buffer.size() ) == 0)
+               break;
+      }
+   } };
+   auto cleanup2 = finally( [&]{
+      stopPrefetch.store( true );
+      prefetcher.join();
+   } );
+
    mMacroCommands.ReadMacro(name);
    for (i = 0; i < (int)files.size(); i++) {
+      processing.store( i );
       wxWindowDisabler wd(&activityWin);
       if (i > 0) {
          //Clear the arrow in previous item.
@@ -18,7 +18,14 @@ of the BlockFile system.
 #include "Audacity.h"
 #include "Benchmark.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
 #include <wx/app.h>
+#include <wx/datetime.h>
+#include <wx/ffile.h>
 #include <wx/log.h>
 #include <wx/textctrl.h>
 #include <wx/button.h>
@@ -35,6 +42,10 @@ of the BlockFile system.
 #include <wx/intl.h>
 
 #include "DirManager.h"
+#include "Envelope.h"
+#include "Mix.h"
+#include "RealFFTf.h"
+#include "SampleFormat.h"
 #include "ShuttleGui.h"
 #include "Project.h"
 #include "WaveClip.h"
@@ -42,6 +53,7 @@ of the BlockFile system.
 #include "Sequence.h"
 #include "Prefs.h"
 #include "ViewInfo.h"
+#include "blockfile/SimpleBlockFile.h"
 
 #include "FileNames.h"
 #include "widgets/AudacityMessageBox.h"
@@ -58,7 +70,9 @@ public:
 private:
    // WDR: handler declarations
    void OnRun( wxCommandEvent &event );
+   void OnRunSuites( wxCommandEvent &event );
    void OnSave( wxCommandEvent &event );
+   void OnSaveJSON( wxCommandEvent &event );
    void OnClear( wxCommandEvent &event );
    void OnClose( wxCommandEvent &event );
 
@@ -66,6 +80,30 @@ private:
    void HoldPrint(bool hold);
    void FlushPrint();
 
+   // One timed measurement from the micro-benchmark suites
+   struct SuiteResult {
+      wxString suite;
+      wxString params;
+      long iterations;
+      long totalMs;
+      double rate;
+      wxString rateUnits;
+   };
+
+   void AddResult(const wxChar *suite, const wxString &params,
+                  long iterations, long totalMs,
+                  double rate, const wxChar *rateUnits);
+   wxString ResultsToJSON() const;
+
+   void BenchCopySamples();
+   void BenchRealFFT();
+   void BenchEnvelopeGetValues();
+   void BenchBlockFileSummary();
+   void BenchMixerProcess();
+   void BenchWaveDisplay();
+
+   std::vector<SuiteResult> mResults;
+
    bool      mHoldPrint;
    wxString  mToPrint;
 
@@ -112,7 +150,9 @@ _("This will close all project windows (without saving)\nand open the Audacity B
 
 enum {
    RunID = 1000,
+   RunSuitesID,
    BSaveID,
+   SaveJSONID,
    ClearID,
    StaticTextID,
    BlockSizeID,
@@ -123,7 +163,9 @@ enum {
 
 BEGIN_EVENT_TABLE(BenchmarkDialog, wxDialogWrapper)
    EVT_BUTTON( RunID,   BenchmarkDialog::OnRun )
+   EVT_BUTTON( RunSuitesID, BenchmarkDialog::OnRunSuites )
    EVT_BUTTON( BSaveID,  BenchmarkDialog::OnSave )
+   EVT_BUTTON( SaveJSONID, BenchmarkDialog::OnSaveJSON )
    EVT_BUTTON( ClearID, BenchmarkDialog::OnClear )
    EVT_BUTTON( wxID_CANCEL, BenchmarkDialog::OnClose )
 END_EVENT_TABLE()
@@ -226,7 +268,9 @@ void BenchmarkDialog::MakeBenchmarkDialog()
          S.StartHorizontalLay(wxALIGN_LEFT, false);
          {
             S.Id(RunID).AddButton(_("Run"))->SetDefault();
+            S.Id(RunSuitesID).AddButton(_("Run Suites"));
             S.Id(BSaveID).AddButton(_("Save"));
+            S.Id(SaveJSONID).AddButton(_("Save JSON"));
             /* i18n-hint verb; to empty or erase */
             S.Id(ClearID).AddButton(_("Clear"));
          }
@@ -274,6 +318,86 @@ void BenchmarkDialog::OnSave( wxCommandEvent & WXUNUSED(event))
    mText->SaveFile(fName);
 }
 
+namespace {
+
+// Minimal JSON string escaping; the emitted names are plain ASCII, but
+// quotes and backslashes must not be allowed to corrupt the output.
+wxString JSONEscape(const wxString &str)
+{
+   wxString result;
+   for (auto ch : str) {
+      if (ch == wxT('"') || ch == wxT('\\'))
+         result += wxT('\\');
+      result += ch;
+   }
+   return result;
+}
+
+}
+
+wxString BenchmarkDialog::ResultsToJSON() const
+{
+   wxString s = wxT("{\n");
+   s += wxString::Format(wxT("  \"version\": \"%s\",\n"),
+      AUDACITY_VERSION_STRING);
+   s += wxString::Format(wxT("  \"date\": \"%s\",\n"),
+      wxDateTime::Now().FormatISOCombined());
+   s += wxT("  \"results\": [\n");
+   for (size_t i = 0; i < mResults.size(); i++) {
+      const auto &r = mResults[i];
+      s += wxString::Format(
+         wxT("    { \"suite\": \"%s\", \"params\": \"%s\", ")
+         wxT("\"iterations\": %ld, \"total_ms\": %ld, ")
+         wxT("\"rate\": %.4f, \"rate_units\": \"%s\" }%s\n"),
+         JSONEscape(r.suite), JSONEscape(r.params),
+         r.iterations, r.totalMs, r.rate, JSONEscape(r.rateUnits),
+         (i + 1 < mResults.size()) ? wxT(",") : wxT(""));
+   }
+   s += wxT("  ]\n}\n");
+   return s;
+}
+
+void BenchmarkDialog::OnSaveJSON( wxCommandEvent & WXUNUSED(event))
+{
+   if (mResults.empty()) {
+      AudacityMessageBox(_("No suite results to save.  Use Run Suites first."));
+      return;
+   }
+
+/* i18n-hint: Benchmark means a software speed test;
+   leave untranslated file extension .json */
+   wxString fName = _("benchmark.json");
+
+   fName = FileNames::SelectFile(FileNames::Operation::Export,
+                        _("Export Benchmark Data as:"),
+                        wxEmptyString,
+                        fName,
+                        wxT("json"),
+                        wxT("*.json"),
+                        wxFD_SAVE | wxRESIZE_BORDER,
+                        this);
+
+   if (fName.empty())
+      return;
+
+   wxFFile file{ fName, wxT("w") };
+   if (!file.IsOpened() || !file.Write(ResultsToJSON()))
+      AudacityMessageBox(_("Could not write the benchmark results."));
+}
+
+void BenchmarkDialog::AddResult(const wxChar *suite, const wxString &params,
+                                long iterations, long totalMs,
+                                double rate, const wxChar *rateUnits)
+{
+   mResults.push_back(
+      { suite, params, iterations, totalMs, rate, rateUnits } );
+   // Printf forwards a va_list, so pass a plain pointer for the string
+   Printf(wxT("%s [%s]: %ld iterations in %ld ms (%.2f %s)\n"),
+          suite, params.wx_str(), iterations, totalMs, rate, rateUnits);
+   FlushPrint();
+   wxTheApp->Yield();
+}
+
 void BenchmarkDialog::OnClear(wxCommandEvent & WXUNUSED(event))
 {
    mText->Clear();
@@ -560,3 +684,294 @@ void BenchmarkDialog::OnRun( wxCommandEvent & WXUNUSED(event))
    Printf(_("Benchmark completed successfully.\n"));
    HoldPrint(false);
 }
+
+//
+// Micro-benchmark suites.  Each one exercises a single hot path with a
+// deterministic workload and records a rate that can be compared between
+// releases; Save JSON exports all results in machine-readable form.
+//
+
+void BenchmarkDialog::BenchCopySamples()
+{
+   constexpr size_t len = 1 << 16;
+   constexpr long iterations = 1000;
+   const double samples = double(len) * iterations;
+
+   Floats floats{ len };
+   Floats floats2{ len };
+   ArrayOf<short> shorts{ len };
+   for (size_t i = 0; i < len; i++)
+      floats[i] = 0.8f * sin(i * 0.01);
+
+   wxStopWatch timer;
+   long elapsed;
+
+   timer.Start();
+   for (long it = 0; it < iterations; it++)
+      CopySamples((samplePtr)floats.get(), floatSample,
+                  (samplePtr)shorts.get(), int16Sample, len);
+   elapsed = timer.Time();
+   AddResult(wxT("CopySamples"), wxT("float to int16, dithered"),
+             iterations, elapsed,
+             samples / std::max(1L, elapsed) / 1000.0, wxT("MSamples/s"));
+
+   timer.Start();
+   for (long it = 0; it < iterations; it++)
+      CopySamplesNoDither((samplePtr)floats.get(), floatSample,
+                          (samplePtr)shorts.get(), int16Sample, len);
+   elapsed = timer.Time();
+   AddResult(wxT("CopySamples"), wxT("float to int16, no dither"),
+             iterations, elapsed,
+             samples / std::max(1L, elapsed) / 1000.0, wxT("MSamples/s"));
+
+   timer.Start();
+   for (long it = 0; it < iterations; it++)
+      CopySamples((samplePtr)shorts.get(), int16Sample,
+                  (samplePtr)floats2.get(), floatSample, len);
+   elapsed = timer.Time();
+   AddResult(wxT("CopySamples"), wxT("int16 to float"),
+             iterations, elapsed,
+             samples / std::max(1L, elapsed) / 1000.0, wxT("MSamples/s"));
+
+   timer.Start();
+   for (long it = 0; it < iterations; it++)
+      CopySamples((samplePtr)floats.get(), floatSample,
+                  (samplePtr)floats2.get(), floatSample, len);
+   elapsed = timer.Time();
+   AddResult(wxT("CopySamples"), wxT("float to float"),
+             iterations, elapsed,
+             samples / std::max(1L, elapsed) / 1000.0, wxT("MSamples/s"));
+}
+
+void BenchmarkDialog::BenchRealFFT()
+{
+   for (size_t bits = 8; bits <= 16; bits += 2) {
+      const size_t size = size_t(1) << bits;
+      auto hFFT = GetFFT(size);
+      Floats pristine{ size };
+      Floats work{ size };
+      for (size_t i = 0; i < size; i++)
+         pristine[i] = sin(i * 0.3) + 0.1 * sin(i * 7.1);
+
+      // Scale the repetition count so each size runs a comparable
+      // number of samples through the transform
+      const long iterations = long((size_t(1) << 22) / size);
+      wxStopWatch timer;
+      timer.Start();
+      for (long it = 0; it < iterations; it++) {
+         // The transform works in place, so restore the input each time
+         memcpy(work.get(), pristine.get(), size * sizeof(float));
+         RealFFTf(work.get(), hFFT.get());
+      }
+      const long elapsed = timer.Time();
+      AddResult(wxT("RealFFTf"),
+                wxString::Format(wxT("size %d"), (int)size),
+                iterations, elapsed,
+                iterations * 1000.0 / std::max(1L, elapsed), wxT("FFTs/s"));
+   }
+}
+
+void BenchmarkDialog::BenchEnvelopeGetValues()
+{
+   constexpr double trackLen = 100.0;
+   constexpr int numPoints = 1000;
+   constexpr int bufferLen = 1000;
+   constexpr long iterations = 2000;
+
+   Envelope env{ false, 0.0, 2.0, 1.0 };
+   env.SetTrackLen(trackLen);
+   for (int i = 0; i < numPoints; i++)
+      env.InsertOrReplace(trackLen * i / numPoints,
+                          0.5 + 0.5 * sin(i * 0.05));
+
+   Doubles buffer{ size_t(bufferLen) };
+
+   wxStopWatch timer;
+   timer.Start();
+   for (long it = 0; it < iterations; it++) {
+      // Sweep the query window across the envelope so successive calls
+      // do not keep hitting the same control points
+      const double t0 = (it % 100) * (trackLen / 200.0);
+      env.GetValues(buffer.get(), bufferLen,
+                    t0, trackLen / (200.0 * bufferLen));
+   }
+   const long elapsed = timer.Time();
+   AddResult(wxT("Envelope::GetValues"),
+             wxString::Format(wxT("%d points, %d values per call"),
+                              numPoints, bufferLen),
+             iterations, elapsed,
+             double(iterations) * bufferLen
+                / std::max(1L, elapsed) / 1000.0,
+             wxT("MValues/s"));
+}
+
+void BenchmarkDialog::BenchBlockFileSummary()
+{
+   const size_t len =
+      Sequence::GetMaxDiskBlockSize() / SAMPLE_SIZE(floatSample);
+   constexpr long iterations = 32;
+
+   Floats data{ len };
+   for (size_t i = 0; i < len; i++)
+      data[i] = sin(i * 0.01);
+
+   auto dd = DirManager::Create();
+   std::vector<BlockFilePtr> blocks;
+   blocks.reserve(iterations);
+
+   wxStopWatch timer;
+   timer.Start();
+   for (long it = 0; it < iterations; it++)
+      blocks.push_back( dd->NewBlockFile( [&]( wxFileNameWrapper filePath ) {
+         return make_blockfile<SimpleBlockFile>( std::move(filePath),
+            (samplePtr)data.get(), len, floatSample );
+      } ) );
+   const long elapsed = timer.Time();
+
+   const double mb =
+      double(len) * SAMPLE_SIZE(floatSample) * iterations / 1048576.0;
+   AddResult(wxT("BlockFile summary"),
+             wxString::Format(wxT("%d samples per block"), (int)len),
+             iterations, elapsed,
+             mb * 1000.0 / std::max(1L, elapsed), wxT("MB/s"));
+
+   // Deleting the blocks removes their files; keep that out of the timing
+   blocks.clear();
+   dd.reset();
+}
+
+void BenchmarkDialog::BenchMixerProcess()
+{
+   constexpr double rate = 44100.0;
+   constexpr double duration = 10.0;
+   constexpr int numTracks = 4;
+
+   ZoomInfo zoomInfo(0.0, ZoomInfo::GetDefaultZoom());
+   auto dd = DirManager::Create();
+   TrackFactory factory{ dd, &zoomInfo };
+
+   WaveTrackConstArray tracks;
+   for (int nt = 0; nt < numTracks; nt++) {
+      const auto t = factory.NewWaveTrack(floatSample, rate);
+      constexpr size_t chunk = 65536;
+      Floats buffer{ chunk };
+      auto remaining = size_t(rate * duration);
+      size_t pos = 0;
+      while (remaining > 0) {
+         const auto count = std::min(chunk, remaining);
+         for (size_t i = 0; i < count; i++)
+            buffer[i] = sin((pos + i) * (0.002 * (nt + 1)));
+         t->Append((samplePtr)buffer.get(), floatSample, count);
+         pos += count;
+         remaining -= count;
+      }
+      t->Flush();
+      tracks.push_back(t);
+   }
+
+   constexpr size_t bufferSize = 4096;
+   Mixer mixer(tracks, false,
+               Mixer::WarpOptions{ nullptr },
+               0.0, duration,
+               2, bufferSize, true,
+               rate, floatSample);
+
+   wxStopWatch timer;
+   timer.Start();
+   long iterations = 0;
+   while (mixer.Process(bufferSize) > 0)
+      iterations++;
+   const long elapsed = timer.Time();
+
+   AddResult(wxT("Mixer::Process"),
+             wxString::Format(wxT("%d tracks, %.0f s at %.0f Hz"),
+                              numTracks, duration, rate),
+             iterations, elapsed,
+             duration * 1000.0 / std::max(1L, elapsed), wxT("x realtime"));
+}
+
+void BenchmarkDialog::BenchWaveDisplay()
+{
+   constexpr double rate = 44100.0;
+   constexpr double duration = 30.0;
+
+   ZoomInfo zoomInfo(0.0, ZoomInfo::GetDefaultZoom());
+   auto dd = DirManager::Create();
+   const auto t =
+      TrackFactory{ dd, &zoomInfo }.NewWaveTrack(floatSample, rate);
+
+   constexpr size_t chunk = 65536;
+   Floats buffer{ chunk };
+   auto remaining = size_t(rate * duration);
+   size_t pos = 0;
+   while (remaining > 0) {
+      const auto count = std::min(chunk, remaining);
+      for (size_t i = 0; i < count; i++)
+         buffer[i] = sin((pos + i) * 0.002);
+      t->Append((samplePtr)buffer.get(), floatSample, count);
+      pos += count;
+      remaining -= count;
+   }
+   t->Flush();
+
+   const auto clip = t->GetClipByIndex(0);
+
+   constexpr int width = 1000;
+   constexpr long iterations = 50;
+
+   // From many samples per pixel down to around one, which exercises
+   // both the summary-reading and the direct-reading cases
+   for (double pixelsPerSecond : { 50.0, 1000.0, 20000.0 }) {
+      wxStopWatch timer;
+      timer.Start();
+      for (long it = 0; it < iterations; it++) {
+         // Drop the cache so every iteration recomputes the display
+         clip->ClearWaveCache();
+         WaveDisplay display{ width };
+         display.Allocate();
+         bool isLoadingOD = false;
+         clip->GetWaveDisplay(display, 0.0, pixelsPerSecond, isLoadingOD);
+      }
+      const long elapsed = timer.Time();
+      AddResult(wxT("WaveClip::GetWaveDisplay"),
+                wxString::Format(wxT("%d pixels at %.0f pixels/s"),
+                                 width, pixelsPerSecond),
+                iterations, elapsed,
+                iterations * 1000.0 / std::max(1L, elapsed),
+                wxT("displays/s"));
+   }
+}
+
+void BenchmarkDialog::OnRunSuites( wxCommandEvent & WXUNUSED(event))
+{
+   TransferDataFromWindow();
+
+   if (!Validate())
+      return;
+
+   long randSeed;
+   mRandSeedStr.ToLong(&randSeed);
+
+   wxBusyCursor busy;
+
+   HoldPrint(true);
+   const auto cleanup = finally( [&] {
+      HoldPrint(false);
+   } );
+
+   mResults.clear();
+   srand(randSeed);
+
+   Printf(_("Running micro-benchmark suites...\n"));
+   wxTheApp->Yield();
+   FlushPrint();
+
+   BenchCopySamples();
+   BenchRealFFT();
+   BenchEnvelopeGetValues();
+   BenchBlockFileSummary();
+   BenchMixerProcess();
+   BenchWaveDisplay();
+
+   Printf(_("Suites completed.  Use Save JSON to export the results.\n"));
+}
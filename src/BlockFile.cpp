@@ -42,8 +42,19 @@ out.
 #include "Audacity.h"
 #include "BlockFile.h"
 
+#include <algorithm>
+#include <atomic>
 #include <float.h>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <wx/utils.h>
 #include <wx/filefn.h>
@@ -54,6 +65,19 @@ out.
 #include "FileException.h"
 #include "FileFormats.h"
 
+#include "Prefs.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SUMMARY_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__F16C__)
+#define SUMMARY_USE_F16C
+#include <immintrin.h>
+#endif
+
 // msmeyer: Define this to add debug output via wxPrintf()
 //#define DEBUG_BLOCKFILE
 
@@ -68,10 +92,92 @@ out.
 static const int headerTagLen = 20;
 static char headerTag[headerTagLen + 1] = "AudacityBlockFile112";
 
+// Tag of the optional summary encoding that stores the min/max/RMS
+// frames as 16-bit floats, halving summary file size and read bandwidth
+static char halfHeaderTag[headerTagLen + 1] = "AudacityBlockFileH16";
+
+// The arena behind make_blockfile.  Not per-project: block files can
+// migrate between projects, since paste shares the pointers between the
+// source and destination DirManager, so slots must outlive any one
+// project and are only tied to the process.
+namespace {
+
+// Slot sizes are quantized to this many bytes; requests larger than the
+// biggest bucket fall back to the plain heap
+constexpr size_t arenaGranularity = 64;
+constexpr size_t arenaBuckets = 16;
+constexpr size_t arenaChunkBytes = 64 * 1024;
+
+struct FreeSlot {
+   FreeSlot *next;
+};
+
+struct Arena {
+   std::mutex mutex;
+   std::vector<std::unique_ptr<char[]>> chunks;
+   FreeSlot *freeLists[arenaBuckets] = {};
+   size_t chunkUsed = arenaChunkBytes;
+};
+
+Arena &GetArena()
+{
+   // Never destroyed, so that block files destroyed late in shutdown
+   // still have somewhere to return their slots
+   static auto &arena = *new Arena;
+   return arena;
+}
+
+}
+
+void *BlockFileArenaAllocate(size_t bytes)
+{
+   const size_t bucket = (bytes + arenaGranularity - 1) / arenaGranularity;
+   if (bucket == 0 || bucket > arenaBuckets)
+      return ::operator new(bytes);
+
+   auto &arena = GetArena();
+   std::lock_guard<std::mutex> guard{ arena.mutex };
+
+   auto &head = arena.freeLists[bucket - 1];
+   if (head) {
+      const auto result = head;
+      head = head->next;
+      return result;
+   }
+
+   const size_t slotBytes = bucket * arenaGranularity;
+   if (arena.chunkUsed + slotBytes > arenaChunkBytes) {
+      arena.chunks.push_back(std::make_unique<char[]>(arenaChunkBytes));
+      arena.chunkUsed = 0;
+   }
+   const auto result = arena.chunks.back().get() + arena.chunkUsed;
+   arena.chunkUsed += slotBytes;
+   return result;
+}
+
+void BlockFileArenaFree(void *p, size_t bytes)
+{
+   const size_t bucket = (bytes + arenaGranularity - 1) / arenaGranularity;
+   if (bucket == 0 || bucket > arenaBuckets) {
+      ::operator delete(p);
+      return;
+   }
+
+   auto &arena = GetArena();
+   std::lock_guard<std::mutex> guard{ arena.mutex };
+
+   auto &head = arena.freeLists[bucket - 1];
+   const auto slot = static_cast<FreeSlot*>(p);
+   slot->next = head;
+   head = slot;
+}
+
 SummaryInfo::SummaryInfo(size_t samples)
 {
    format = floatSample;
 
+   halfPrecision = false;
+
    fields = 3; /* min, max, rms */
 
    bytesPerFrame = sizeof(float) * fields;
@@ -84,6 +190,14 @@ SummaryInfo::SummaryInfo(size_t samples)
    totalSummaryBytes = offset256 + (frames256 * bytesPerFrame);
 }
 
+void SummaryInfo::SetHalfPrecision()
+{
+   halfPrecision = true;
+   bytesPerFrame = 2 * fields;
+   offset256 = offset64K + (frames64K * bytesPerFrame);
+   totalSummaryBytes = offset256 + (frames256 * bytesPerFrame);
+}
+
 ArrayOf<char> BlockFile::fullSummary;
 
 /// Initializes the base BlockFile data.  The block is initially
@@ -102,21 +216,218 @@ BlockFile::BlockFile(wxFileNameWrapper &&fileName, size_t samples):
    mLen(samples),
    mSummaryInfo(samples)
 {
+   // Serial numbers are never reused, unlike the arena slots the block
+   // files themselves live in; atomic, as importers construct block
+   // files on worker threads
+   static std::atomic<unsigned long long> nextSerialNumber{ 1 };
+   mSerialNumber = nextSerialNumber.fetch_add(1, std::memory_order_relaxed);
    mSilentLog=FALSE;
 }
 
 // static
 unsigned long BlockFile::gBlockFileDestructionCount { 0 };
 
+namespace {
+
+// A global byte-budgeted LRU of decoded summary arrays.  Summaries are
+// tiny next to the sample data, but painting a zoomed-out view reads one
+// per block; after the first pass they are served from here with no file
+// I/O.  Guarded by a mutex because on-demand computing tasks may read
+// summaries off the main thread.
+class SummaryMemoryCache {
+public:
+   static SummaryMemoryCache &Get()
+   {
+      static SummaryMemoryCache cache;
+      return cache;
+   }
+
+   bool Lookup(const BlockFile *key, ArrayOf<char> &data, size_t bytes)
+   {
+      std::lock_guard<std::mutex> guard{ mMutex };
+      auto iter = mEntries.find(key);
+      if (iter == mEntries.end() || iter->second.bytes != bytes)
+         return false;
+      auto &entry = iter->second;
+      mUse.splice(mUse.begin(), mUse, entry.use);
+      data.reinit(bytes);
+      memcpy(data.get(), entry.data.get(), bytes);
+      return true;
+   }
+
+   void Store(const BlockFile *key, const char *data, size_t bytes)
+   {
+      if (bytes > sBudget)
+         return;
+      std::lock_guard<std::mutex> guard{ mMutex };
+      auto &entry = mEntries[key];
+      if (entry.data) {
+         mTotal -= entry.bytes;
+         mUse.erase(entry.use);
+      }
+      entry.data.reinit(bytes);
+      memcpy(entry.data.get(), data, bytes);
+      entry.bytes = bytes;
+      entry.use = mUse.insert(mUse.begin(), key);
+      mTotal += bytes;
+      while (mTotal > sBudget) {
+         const BlockFile *oldest = mUse.back();
+         mTotal -= mEntries[oldest].bytes;
+         mEntries.erase(oldest);
+         mUse.pop_back();
+      }
+   }
+
+   void Forget(const BlockFile *key)
+   {
+      std::lock_guard<std::mutex> guard{ mMutex };
+      auto iter = mEntries.find(key);
+      if (iter == mEntries.end())
+         return;
+      mTotal -= iter->second.bytes;
+      mUse.erase(iter->second.use);
+      mEntries.erase(iter);
+   }
+
+private:
+   struct Entry {
+      ArrayOf<char> data;
+      size_t bytes{ 0 };
+      std::list<const BlockFile *>::iterator use;
+   };
+
+   static const size_t sBudget = 32 * 1024 * 1024;
+
+   std::mutex mMutex;
+   std::unordered_map<const BlockFile *, Entry> mEntries;
+   // Most recently used at the front
+   std::list<const BlockFile *> mUse;
+   size_t mTotal{ 0 };
+};
+
+// Unlinks of dereferenced block files are handed to a worker thread.
+// Dropping the last references to thousands of blocks at once -- as when
+// redo states are discarded or a big selection is deleted -- then costs
+// only queue pushes, and the filesystem calls proceed in the background.
+// Undo retention needs no extra care here:  a block reaches this queue
+// only from ~BlockFile, after the last undo state referencing it is gone.
+class DeferredFileDeleter {
+public:
+   static DeferredFileDeleter &Get()
+   {
+      // Never destroyed before the process exits; see Finish
+      static DeferredFileDeleter deleter;
+      return deleter;
+   }
+
+   void Enqueue(const wxString &name, wxString path)
+   {
+      {
+         std::lock_guard<std::mutex> guard{ mMutex };
+         if (!mThread.joinable())
+            mThread = std::thread{ [this]{ DrainLoop(); } };
+         mPendingNames.insert(name);
+         mQueue.push_back(std::move(path));
+      }
+      mWake.notify_one();
+   }
+
+   // Whether some block file by this name still awaits deletion; the
+   // name must not be assigned to a NEW block file meanwhile, or the
+   // pending deletion could claim the file the NEW block writes
+   bool IsPending(const wxString &name)
+   {
+      std::lock_guard<std::mutex> guard{ mMutex };
+      return mPendingNames.count(name) > 0;
+   }
+
+   // Wait until every unlink queued so far has completed, as before
+   // sweeping a directory that must come up empty
+   void Flush()
+   {
+      std::unique_lock<std::mutex> lock{ mMutex };
+      mIdle.wait(lock, [this]{ return mQueue.empty() && !mBusy; });
+   }
+
+   ~DeferredFileDeleter()
+   {
+      {
+         std::lock_guard<std::mutex> guard{ mMutex };
+         mDone = true;
+      }
+      mWake.notify_one();
+      if (mThread.joinable())
+         mThread.join();
+   }
+
+private:
+   void DrainLoop()
+   {
+      std::unique_lock<std::mutex> lock{ mMutex };
+      for (;;) {
+         mWake.wait(lock, [this]{ return mDone || !mQueue.empty(); });
+         if (mQueue.empty())
+            break;
+         auto path = std::move(mQueue.front());
+         mQueue.pop_front();
+         mBusy = true;
+         lock.unlock();
+         // PRL: what should be done if this fails?
+         wxRemoveFile(path);
+         lock.lock();
+         mBusy = false;
+         ForgetName(path);
+         if (mQueue.empty())
+            mIdle.notify_all();
+      }
+   }
+
+   // Erase one instance of the base name; caller holds the mutex
+   void ForgetName(const wxString &path)
+   {
+      auto iter = mPendingNames.find(wxFileName{ path }.GetName());
+      if (iter != mPendingNames.end())
+         mPendingNames.erase(iter);
+   }
+
+   std::mutex mMutex;
+   std::condition_variable mWake, mIdle;
+   std::deque<wxString> mQueue;
+   // Base names (no extension) of the queued files, counted with
+   // multiplicity since projects have separate directories
+   std::unordered_multiset<wxString> mPendingNames;
+   std::thread mThread;
+   bool mBusy{ false };
+   bool mDone{ false };
+};
+
+}
+
 BlockFile::~BlockFile()
 {
+   SummaryMemoryCache::Get().Forget(this);
+
    if (!IsLocked() && mFileName.HasName())
-      // PRL: what should be done if this fails?
-      wxRemoveFile(mFileName.GetFullPath());
+      // The worker thread does the actual unlink, so that discarding
+      // many blocks at once does not stall the caller
+      DeferredFileDeleter::Get().Enqueue(
+         mFileName.GetName(), mFileName.GetFullPath());
 
    ++gBlockFileDestructionCount;
 }
 
+// static
+void BlockFile::FlushDeferredDeletes()
+{
+   DeferredFileDeleter::Get().Flush();
+}
+
+// static
+bool BlockFile::IsDeletionPending(const wxString &name)
+{
+   return DeferredFileDeleter::Get().IsPending(name);
+}
+
 /// Returns the file name of the disk file associated with this
 /// BlockFile.  Not all BlockFiles store their sample data here,
 /// but most BlockFiles have at least their summary data here.
@@ -172,6 +483,119 @@ bool BlockFile::IsLocked()
    return mLockCount > 0;
 }
 
+namespace {
+
+// IEEE 754 binary16 conversions for the half-precision summary format.
+// Where the compiler targets F16C the loops below use the hardware
+// instructions; these scalar routines serve the remainder and other
+// builds.  Narrowing rounds to nearest; the < 0.1% relative error is
+// far below what waveform drawing can resolve.
+
+inline unsigned short FloatToHalfOne(float value)
+{
+   unsigned bits;
+   memcpy(&bits, &value, sizeof(bits));
+   const unsigned sign = (bits >> 16) & 0x8000u;
+   bits &= 0x7fffffffu;
+
+   if (bits > 0x7f800000u)
+      // NaN; keep a nonzero mantissa
+      return (unsigned short)(sign | 0x7e00u);
+
+   if (bits < 0x38800000u) {
+      // Subnormal in half precision, or underflow to zero
+      const unsigned shift = 126u - (bits >> 23);
+      if (shift > 24u)
+         return (unsigned short)sign;
+      const unsigned mantissa = (bits & 0x7fffffu) | 0x800000u;
+      // Round to nearest; a carry out of the mantissa lands correctly
+      // in the exponent field
+      return (unsigned short)
+         (sign + ((mantissa + (1u << (shift - 1))) >> shift));
+   }
+
+   // Normal range; round the 13 discarded mantissa bits to nearest even
+   bits += 0xfffu + ((bits >> 13) & 1u);
+   if (bits >= 0x47800000u)
+      // Magnitude too large for half precision; saturate to infinity
+      return (unsigned short)(sign | 0x7c00u);
+   return (unsigned short)(sign | ((bits - 0x38000000u) >> 13));
+}
+
+inline float HalfToFloatOne(unsigned short half)
+{
+   const unsigned sign = (unsigned)(half & 0x8000u) << 16;
+   unsigned exponent = (half >> 10) & 0x1fu;
+   unsigned mantissa = half & 0x3ffu;
+   unsigned bits;
+
+   if (exponent == 0x1fu)
+      // Infinity or NaN
+      bits = sign | 0x7f800000u | (mantissa << 13);
+   else if (exponent == 0) {
+      if (mantissa == 0)
+         bits = sign;
+      else {
+         // Normalize the subnormal
+         exponent = 113u;
+         while (!(mantissa & 0x400u)) {
+            mantissa <<= 1;
+            exponent--;
+         }
+         bits = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+      }
+   }
+   else
+      bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+
+   float result;
+   memcpy(&result, &bits, sizeof(result));
+   return result;
+}
+
+void FloatToHalf(const float *src, unsigned short *dst, size_t len)
+{
+   size_t i = 0;
+#ifdef SUMMARY_USE_F16C
+   for (; i + 4 <= len; i += 4)
+      _mm_storel_epi64((__m128i*)(dst + i),
+         _mm_cvtps_ph(_mm_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+   for (; i < len; i++)
+      dst[i] = FloatToHalfOne(src[i]);
+}
+
+void HalfToFloat(const unsigned short *src, float *dst, size_t len)
+{
+   size_t i = 0;
+#ifdef SUMMARY_USE_F16C
+   for (; i + 4 <= len; i += 4)
+      _mm_storeu_ps(dst + i,
+         _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)(src + i))));
+#endif
+   for (; i < len; i++)
+      dst[i] = HalfToFloatOne(src[i]);
+}
+
+// The write-time side of the negotiation: whether NEW summaries are
+// stored in half precision.  Old summaries keep the format recorded in
+// their header tags, so a project may freely mix the two.
+bool GetHalfSummaryPref()
+{
+   bool half = false;
+   gPrefs->Read(wxT("/FileFormats/HalfSummaries"), &half);
+   return half;
+}
+
+}
+
+void BlockFile::AdoptSummaryTag(const char *tag)
+{
+   if (!mSummaryInfo.halfPrecision &&
+       memcmp(tag, halfHeaderTag, headerTagLen) == 0)
+      mSummaryInfo.SetHalfPrecision();
+}
+
 /// Get a buffer containing a summary block describing this sample
 /// data.  This must be called by derived classes when they
 /// are constructed, to allow them to construct their summary data,
@@ -192,22 +616,94 @@ void *BlockFile::CalcSummary(samplePtr buffer, size_t len,
    // Caller has nothing to deallocate
    cleanup.reset();
 
-   fullSummary.reinit(mSummaryInfo.totalSummaryBytes);
-
-   memcpy(fullSummary.get(), headerTag, headerTagLen);
+   // Joining the negotiation: should this NEW summary be written in
+   // half precision?
+   if (!mSummaryInfo.halfPrecision && GetHalfSummaryPref())
+      mSummaryInfo.SetHalfPrecision();
 
-   float *summary64K = (float *)(fullSummary.get() + mSummaryInfo.offset64K);
-   float *summary256 = (float *)(fullSummary.get() + mSummaryInfo.offset256);
+   fullSummary.reinit(mSummaryInfo.totalSummaryBytes);
 
    Floats fbuffer{ len };
    CopySamples(buffer, format,
                (samplePtr)fbuffer.get(), floatSample, len);
 
-   CalcSummaryFromBuffer(fbuffer.get(), len, summary256, summary64K);
+   if (mSummaryInfo.halfPrecision) {
+      // Compute in full precision, then narrow for storage.  The 64K
+      // frames precede the 256 frames, contiguously in both layouts,
+      // so one conversion pass covers both.
+      memcpy(fullSummary.get(), halfHeaderTag, headerTagLen);
+
+      const size_t values64K = mSummaryInfo.frames64K * mSummaryInfo.fields;
+      const size_t values256 = mSummaryInfo.frames256 * mSummaryInfo.fields;
+      Floats scratch{ values64K + values256 };
+
+      CalcSummaryFromBuffer(fbuffer.get(), len,
+                            scratch.get() + values64K, scratch.get());
+
+      FloatToHalf(scratch.get(),
+         (unsigned short *)(fullSummary.get() + mSummaryInfo.offset64K),
+         values64K + values256);
+   }
+   else {
+      memcpy(fullSummary.get(), headerTag, headerTagLen);
+
+      float *summary64K =
+         (float *)(fullSummary.get() + mSummaryInfo.offset64K);
+      float *summary256 =
+         (float *)(fullSummary.get() + mSummaryInfo.offset256);
+
+      CalcSummaryFromBuffer(fbuffer.get(), len, summary256, summary64K);
+   }
 
    return fullSummary.get();
 }
 
+namespace {
+
+// min, max, and sum of squares over one summary frame.  This runs for
+// every 256 samples of everything recorded or pasted, so it is worth a
+// vector kernel; the scalar loop handles the tail and non-SSE builds.
+inline void MinMaxSumSq(const float *buffer, size_t len,
+                        float &min, float &max, float &sumsq)
+{
+   min = buffer[0];
+   max = buffer[0];
+   sumsq = buffer[0] * buffer[0];
+   size_t j = 1;
+#ifdef SUMMARY_USE_SSE2
+   if (len >= 8) {
+      __m128 vmin = _mm_loadu_ps(buffer);
+      __m128 vmax = vmin;
+      __m128 vsum = _mm_mul_ps(vmin, vmin);
+      for (j = 4; j + 4 <= len; j += 4) {
+         const __m128 v = _mm_loadu_ps(buffer + j);
+         vmin = _mm_min_ps(vmin, v);
+         vmax = _mm_max_ps(vmax, v);
+         vsum = _mm_add_ps(vsum, _mm_mul_ps(v, v));
+      }
+      float lanes[4];
+      _mm_storeu_ps(lanes, vmin);
+      min = std::min(std::min(lanes[0], lanes[1]),
+                     std::min(lanes[2], lanes[3]));
+      _mm_storeu_ps(lanes, vmax);
+      max = std::max(std::max(lanes[0], lanes[1]),
+                     std::max(lanes[2], lanes[3]));
+      _mm_storeu_ps(lanes, vsum);
+      sumsq = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+   }
+#endif
+   for (; j < len; j++) {
+      const float f1 = buffer[j];
+      sumsq += f1 * f1;
+      if (f1 < min)
+         min = f1;
+      else if (f1 > max)
+         max = f1;
+   }
+}
+
+}
+
 void BlockFile::CalcSummaryFromBuffer(const float *fbuffer, size_t len,
                                       float *summary256, float *summary64K)
 {
@@ -223,22 +719,12 @@ void BlockFile::CalcSummaryFromBuffer(const float *fbuffer, size_t len,
    int summaries = 256;
 
    for (decltype(sumLen) i = 0; i < sumLen; i++) {
-      min = fbuffer[i * 256];
-      max = fbuffer[i * 256];
-      sumsq = ((float)min) * ((float)min);
       decltype(len) jcount = 256;
       if (jcount > len - i * 256) {
          jcount = len - i * 256;
          fraction = 1.0 - (jcount / 256.0);
       }
-      for (decltype(jcount) j = 1; j < jcount; j++) {
-         float f1 = fbuffer[i * 256 + j];
-         sumsq += ((float)f1) * ((float)f1);
-         if (f1 < min)
-            min = f1;
-         else if (f1 > max)
-            max = f1;
-      }
+      MinMaxSumSq(fbuffer + i * 256, jcount, min, max, sumsq);
 
       totalSquares += sumsq;
       float rms = (float)sqrt(sumsq / jcount);
@@ -338,8 +824,11 @@ static void ComputeMinMax256(float *summary256,
 /// on a different platform
 void BlockFile::FixSummary(void *data)
 {
+   // The detection heuristic below examines 32-bit floats only; a
+   // half-precision summary is left alone
    if (mSummaryInfo.format != floatSample ||
-       mSummaryInfo.fields != 3)
+       mSummaryInfo.fields != 3 ||
+       mSummaryInfo.halfPrecision)
       return;
 
    float *summary64K = (float *)((char *)data + mSummaryInfo.offset64K);
@@ -377,27 +866,70 @@ void BlockFile::FixSummary(void *data)
 auto BlockFile::GetMinMaxRMS(size_t start, size_t len, bool mayThrow)
    const -> MinMaxRMS
 {
-   // TODO: actually use summaries
-   SampleBuffer blockData(len, floatSample);
-
-   this->ReadData(blockData.ptr(), floatSample, start, len, mayThrow);
-
+   // Use the 256-sample summary frames for the whole frames inside the
+   // region, and read raw samples only at the two partial edges.
+   // Reconstructing a frame's sum of squares from its stored RMS matches
+   // the precision of the whole-block shortcuts in Sequence, which do
+   // the same with the block-level RMS.
    float min = FLT_MAX;
    float max = -FLT_MAX;
-   float sumsq = 0;
+   double sumsq = 0;
+   size_t count = 0;
 
-   for( decltype(len) i = 0; i < len; i++ )
-   {
-      float sample = ((float*)blockData.ptr())[i];
+   // Scan raw samples in [from, to), folding into the results above
+   auto fold = [&](size_t from, size_t to) {
+      const auto n = to - from;
+      if (n == 0)
+         return;
+      SampleBuffer blockData(n, floatSample);
+      this->ReadData(blockData.ptr(), floatSample, from, n, mayThrow);
+      const float *samples = (const float *)blockData.ptr();
+      for (decltype(n) i = 0; i < n; i++) {
+         const float sample = samples[i];
+         if (sample > max)
+            max = sample;
+         if (sample < min)
+            min = sample;
+         sumsq += sample * sample;
+      }
+      count += n;
+   };
+
+   const size_t frameSize = 256;
+   const auto end = start + len;
+   const size_t wholeBegin =
+      std::min(((start + frameSize - 1) / frameSize) * frameSize, end);
+   const size_t wholeEnd = std::max(wholeBegin, (end / frameSize) * frameSize);
+
+   bool summarized = false;
+   if (wholeEnd > wholeBegin && IsSummaryAvailable()) {
+      const size_t frame0 = wholeBegin / frameSize;
+      const size_t frames = (wholeEnd - wholeBegin) / frameSize;
+      Floats triples{ frames * 3 };
+      // Read256 is non-const only because the summary read may go to
+      // disk; it does not change the immutable summary contents
+      summarized = const_cast<BlockFile*>(this)->
+         Read256(triples.get(), frame0, frames);
+      if (summarized) {
+         for (size_t i = 0; i < frames; i++) {
+            min = std::min(min, triples[3 * i]);
+            max = std::max(max, triples[3 * i + 1]);
+            const double rms = triples[3 * i + 2];
+            sumsq += rms * rms * frameSize;
+         }
+         count += wholeEnd - wholeBegin;
+      }
+   }
 
-      if( sample > max )
-         max = sample;
-      if( sample < min )
-         min = sample;
-      sumsq += (sample*sample);
+   if (summarized) {
+      fold(start, wholeBegin);
+      fold(wholeEnd, end);
    }
+   else
+      // No summary (or a failed summary read); fall back to raw samples
+      fold(start, end);
 
-   return { min, max, (float)sqrt(sumsq/len) };
+   return { min, max, (float)sqrt(sumsq/count) };
 }
 
 /// Retrieves the minimum, maximum, and maximum RMS of this entire
@@ -409,6 +941,22 @@ auto BlockFile::GetMinMaxRMS(bool)
    return { mMin, mMax, mRMS };
 }
 
+bool BlockFile::ReadSummaryCached(ArrayOf<char> &data)
+{
+   const auto bytes = mSummaryInfo.totalSummaryBytes;
+   auto &cache = SummaryMemoryCache::Get();
+
+   if (cache.Lookup(this, data, bytes))
+      return true;
+
+   auto result = this->ReadSummary(data);
+   // Don't cache a failed read, which filled the buffer with zeroes; the
+   // real summary may become available later, as with on-demand blocks
+   if (result)
+      cache.Store(this, data.get(), bytes);
+   return result;
+}
+
 /// Retrieves a portion of the 256-byte summary buffer from this BlockFile.  This
 /// data provides information about the minimum value, the maximum
 /// value, and the maximum RMS value for every group of 256 samples in the
@@ -427,15 +975,20 @@ bool BlockFile::Read256(float *buffer,
 
    ArrayOf< char > summary;
    // In case of failure, summary is filled with zeroes
-   auto result = this->ReadSummary(summary);
+   auto result = this->ReadSummaryCached(summary);
 
    start = std::min( start, mSummaryInfo.frames256 );
    len = std::min( len, mSummaryInfo.frames256 - start );
 
-   CopySamples(summary.get() + mSummaryInfo.offset256 +
-               (start * mSummaryInfo.bytesPerFrame),
-               mSummaryInfo.format,
-               (samplePtr)buffer, floatSample, len * mSummaryInfo.fields);
+   const auto summaryPtr = summary.get() + mSummaryInfo.offset256 +
+               (start * mSummaryInfo.bytesPerFrame);
+   if (mSummaryInfo.halfPrecision)
+      HalfToFloat((const unsigned short *)summaryPtr,
+                  buffer, len * mSummaryInfo.fields);
+   else
+      CopySamples(summaryPtr,
+                  mSummaryInfo.format,
+                  (samplePtr)buffer, floatSample, len * mSummaryInfo.fields);
 
    if (mSummaryInfo.fields == 2) {
       // No RMS info; make guess
@@ -466,15 +1019,20 @@ bool BlockFile::Read64K(float *buffer,
 
    ArrayOf< char > summary;
    // In case of failure, summary is filled with zeroes
-   auto result = this->ReadSummary(summary);
+   auto result = this->ReadSummaryCached(summary);
 
    start = std::min( start, mSummaryInfo.frames64K );
    len = std::min( len, mSummaryInfo.frames64K - start );
 
-   CopySamples(summary.get() + mSummaryInfo.offset64K +
-               (start * mSummaryInfo.bytesPerFrame),
-               mSummaryInfo.format,
-               (samplePtr)buffer, floatSample, len * mSummaryInfo.fields);
+   const auto summaryPtr = summary.get() + mSummaryInfo.offset64K +
+               (start * mSummaryInfo.bytesPerFrame);
+   if (mSummaryInfo.halfPrecision)
+      HalfToFloat((const unsigned short *)summaryPtr,
+                  buffer, len * mSummaryInfo.fields);
+   else
+      CopySamples(summaryPtr,
+                  mSummaryInfo.format,
+                  (samplePtr)buffer, floatSample, len * mSummaryInfo.fields);
 
    if (mSummaryInfo.fields == 2) {
       // No RMS info; make guess
@@ -752,7 +1310,6 @@ void AliasBlockFile::SetExternalFileName( wxFileNameWrapper &&newName )
 ///              be at least mSummaryInfo.totalSummaryBytes long.
 bool AliasBlockFile::ReadSummary(ArrayOf<char> &data)
 {
-   data.reinit( mSummaryInfo.totalSummaryBytes );
    wxFFile summaryFile(mFileName.GetFullPath(), wxT("rb"));
 
    {
@@ -763,6 +1320,7 @@ bool AliasBlockFile::ReadSummary(ArrayOf<char> &data)
       if (!summaryFile.IsOpened()){
 
          // NEW model; we need to return valid data
+         data.reinit( mSummaryInfo.totalSummaryBytes );
          memset(data.get(), 0, mSummaryInfo.totalSummaryBytes);
 
          // we silence the logging for this operation in this object
@@ -776,8 +1334,22 @@ bool AliasBlockFile::ReadSummary(ArrayOf<char> &data)
       else mSilentLog = FALSE; // worked properly, any future error is NEW
    }
 
-   auto read = summaryFile.Read(data.get(), mSummaryInfo.totalSummaryBytes);
-   if (read != mSummaryInfo.totalSummaryBytes) {
+   // The header tag determines the summary format, and with it how many
+   // bytes the rest of the file holds
+   char tag[headerTagLen];
+   if (summaryFile.Read(tag, headerTagLen) != (size_t)headerTagLen) {
+      data.reinit( mSummaryInfo.totalSummaryBytes );
+      memset(data.get(), 0, mSummaryInfo.totalSummaryBytes);
+      return false;
+   }
+   AdoptSummaryTag(tag);
+
+   data.reinit( mSummaryInfo.totalSummaryBytes );
+   memcpy(data.get(), tag, headerTagLen);
+
+   const auto remaining = mSummaryInfo.totalSummaryBytes - headerTagLen;
+   auto read = summaryFile.Read(data.get() + headerTagLen, remaining);
+   if (read != remaining) {
       memset(data.get(), 0, mSummaryInfo.totalSummaryBytes);
       return false;
    }
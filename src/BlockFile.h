@@ -26,8 +26,13 @@ class SummaryInfo {
  public:
    SummaryInfo(size_t samples);
 
+   /// Switch to the 16-bit float summary encoding, recomputing the
+   /// frame size and offsets accordingly
+   void SetHalfPrecision();
+
    int            fields; /* Usually 3 for Min, Max, RMS */
    sampleFormat   format;
+   bool           halfPrecision; /* frames hold 16-bit floats on disk */
    int            bytesPerFrame;
    size_t         frames64K;
    int            offset64K;
@@ -42,10 +47,42 @@ class BlockFile;
 class AliasBlockFile;
 using BlockFilePtr = std::shared_ptr<BlockFile>;
 
+// Backing store for make_blockfile.  Slots are carved out of large
+// chunks and recycled through per-size free lists, so the millions of
+// small allocations of a big project stay dense in memory and each
+// deallocation is a cheap list push instead of a heap round trip.
+PROFILE_DLL_API void *BlockFileArenaAllocate(size_t bytes);
+PROFILE_DLL_API void BlockFileArenaFree(void *p, size_t bytes);
+
+template< typename T >
+struct BlockFileArenaAllocator {
+   using value_type = T;
+
+   BlockFileArenaAllocator() = default;
+   template< typename U >
+   BlockFileArenaAllocator(const BlockFileArenaAllocator<U> &) {}
+
+   T *allocate(size_t n)
+   { return static_cast<T*>( BlockFileArenaAllocate( n * sizeof(T) ) ); }
+   void deallocate(T *p, size_t n)
+   { BlockFileArenaFree( p, n * sizeof(T) ); }
+
+   template< typename U >
+   bool operator == (const BlockFileArenaAllocator<U> &) const
+   { return true; }
+   template< typename U >
+   bool operator != (const BlockFileArenaAllocator<U> &) const
+   { return false; }
+};
+
 template< typename Result, typename... Args >
 inline std::shared_ptr< Result > make_blockfile (Args && ... args)
 {
-   return std::make_shared< Result > ( std::forward< Args > ( args )... );
+   // allocate_shared puts the object and the reference counts in one
+   // arena slot
+   return std::allocate_shared< Result > (
+      BlockFileArenaAllocator< Result >{},
+      std::forward< Args > ( args )... );
 }
 
 class PROFILE_DLL_API BlockFile /* not final, abstract */ {
@@ -67,6 +104,14 @@ class PROFILE_DLL_API BlockFile /* not final, abstract */ {
 
    static unsigned long gBlockFileDestructionCount;
 
+   // Destruction queues the disk file for deletion on a worker thread.
+   // Wait here for pending deletions to complete, as before sweeping a
+   // directory that must come up empty.
+   static void FlushDeferredDeletes();
+   // Whether some block file by this base name still awaits deletion;
+   // such a name must not be assigned to a NEW block file.
+   static bool IsDeletionPending(const wxString &name);
+
    // Reading
 
    /// Retrieves audio data from this BlockFile
@@ -123,6 +168,11 @@ class PROFILE_DLL_API BlockFile /* not final, abstract */ {
    size_t GetLength() const { return mLen; }
    void SetLength(size_t newLen) { mLen = newLen; }
 
+   /// A serial number unique among all block files of the session,
+   /// never reused; identity hashes mix it rather than the address,
+   /// which the arena recycles promptly
+   unsigned long long GetSerialNumber() const { return mSerialNumber; }
+
    /// Locks this BlockFile, to prevent it from being moved
    virtual void Lock();
    /// Unlock this BlockFile, allowing it to be moved
@@ -144,6 +194,8 @@ class PROFILE_DLL_API BlockFile /* not final, abstract */ {
 
    /// Returns TRUE if this block references another disk file
    virtual bool IsAlias() const { return false; }
+   /// By default, assume the data are audible; SilentBlockFile overrides
+   virtual bool IsSilent() const { return false; }
 
    /// Returns TRUE if this block's complete summary has been computed and is ready (for OD)
    virtual bool IsSummaryAvailable() const {return true;}
@@ -224,10 +276,24 @@ class PROFILE_DLL_API BlockFile /* not final, abstract */ {
    /// Read the summary section of the file.  Derived classes implement.
    virtual bool ReadSummary(ArrayOf<char> &data) = 0;
 
+   /// As ReadSummary, but consults and populates a global byte-budgeted
+   /// cache of decoded summaries, so that repeated painting does not
+   /// repeat small disk reads
+   bool ReadSummaryCached(ArrayOf<char> &data);
+
    /// Byte-swap the summary data, in case it was saved by a system
    /// on a different platform
    virtual void FixSummary(void *data);
 
+   /// Length of the tag that heads summary data on disk
+   enum : int { summaryTagLen = 20 };
+
+   /// Inspect a summary header tag just read from disk, and adopt the
+   /// summary format it records.  Tag must be summaryTagLen bytes long.
+   /// Readers must call this before sizing the rest of the read, since
+   /// half-precision summaries occupy half the bytes.
+   void AdoptSummaryTag(const char *tag);
+
    static size_t CommonReadData(
       bool mayThrow,
       const wxFileName &fileName, bool &mSilentLog,
@@ -237,6 +303,8 @@ class PROFILE_DLL_API BlockFile /* not final, abstract */ {
 
  private:
    int mLockCount;
+   // Assigned once in the constructor from a global counter
+   unsigned long long mSerialNumber;
 
    static ArrayOf<char> fullSummary;
 
@@ -30,6 +30,7 @@
 #include "Audacity.h"
 #include "CellularPanel.h"
 
+#include <wx/dc.h>
 #include <wx/eventfilter.h>
 #include <wx/setup.h> // for wxUSE_* macros
 #include "KeyboardCapture.h"
@@ -38,6 +39,7 @@
 #include "HitTestResult.h"
 #include "RefreshCode.h"
 #include "TrackPanelCell.h"
+#include "TrackPanelDrawingContext.h"
 
 // A singleton class that intercepts escape key presses when some cellular
 // panel is dragging
@@ -1119,6 +1121,17 @@ std::shared_ptr<TrackPanelCell> CellularPanel::LastCell() const
 void CellularPanel::Draw( TrackPanelDrawingContext &context, unsigned nPasses )
 {
    const auto panelRect = GetClientRect();
+
+   // If the DC is clipped, as for a partial repaint of a backing bitmap,
+   // then cells wholly outside the clipping box may be skipped
+   wxRect visibleRect{ panelRect };
+   {
+      wxRect clip;
+      context.dc.GetClippingBox( clip );
+      if ( !clip.IsEmpty() )
+         visibleRect.Intersect( clip );
+   }
+
    auto lastCell = LastCell();
    for ( unsigned iPass = 0; iPass < nPasses; ++iPass ) {
 
@@ -1126,7 +1139,7 @@ void CellularPanel::Draw( TrackPanelDrawingContext &context, unsigned nPasses )
 
          // Draw the node
          const auto newRect = node.DrawingArea( rect, panelRect, iPass );
-         if ( newRect.Intersects( panelRect ) )
+         if ( newRect.Intersects( visibleRect ) )
             node.Draw( context, newRect, iPass );
 
          // Draw the current handle if it is associated with the node
@@ -1135,7 +1148,7 @@ void CellularPanel::Draw( TrackPanelDrawingContext &context, unsigned nPasses )
             if ( target ) {
                const auto targetRect =
                   target->DrawingArea( rect, panelRect, iPass );
-               if ( targetRect.Intersects( panelRect ) )
+               if ( targetRect.Intersects( visibleRect ) )
                   target->Draw( context, targetRect, iPass );
             }
          }
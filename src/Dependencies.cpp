@@ -112,6 +112,13 @@ void FindDependencies(AudacityProject *project,
    const auto &settings = ProjectSettings::Get( *project );
    sampleFormat format = settings.GetDefaultFormat();
 
+   auto &dirManager = DirManager::Get( *project );
+   if (!dirManager.HasAliasBlockFiles())
+      // DirManager's incrementally maintained index knows of no live
+      // aliased block files, so the project is self-contained and the
+      // sequences need not be walked at all
+      return;
+
    BlockPtrArray blocks;
    GetAllSeqBlocks(project, &blocks);
 
@@ -151,7 +158,8 @@ void FindDependencies(AudacityProject *project,
             outAliasedFiles.back() =
                AliasedFile {
                   wxFileNameWrapper { fileName },
-                  wxLongLong(blockBytes), fileName.FileExists()
+                  wxLongLong(blockBytes),
+                  dirManager.AliasedFileExists(fileName)
                };
             aliasedFileHash[fileNameStr] = &outAliasedFiles.back();
          }
@@ -36,6 +36,7 @@
 #include "Project.h"
 
 #include "AudioIOBase.h"
+#include "Prefs.h"
 
 #include "DeviceChange.h" // for HAVE_DEVICE_CHANGE
 
@@ -248,6 +249,91 @@ static void AddSources(int deviceIndex, int rate, std::vector<DeviceSourceMap> *
 }
 
 
+//--------------- Scan result caching --------------------------
+
+// The results of the last full scan live in gPrefs.  A full scan is slow
+// mostly because AddSources opens a dummy stream on every input device to
+// enumerate its mixer sources; the cheap part, asking portaudio for the host
+// and device names, doubles as a fingerprint that tells us whether the
+// cached maps still describe this machine.
+
+#define DEVICE_SCAN_CACHE_GROUP wxT("/DeviceScanCache")
+
+static wxString DeviceListFingerprint()
+{
+   int nDevices = Pa_GetDeviceCount();
+   wxString fingerprint = wxString::Format(wxT("%d;"), nDevices);
+
+   for (int i = 0; i < nDevices; i++) {
+      const PaDeviceInfo *info = Pa_GetDeviceInfo(i);
+      if (!info)
+         return wxEmptyString;
+      fingerprint += wxString::Format(wxT("%s|%s|%d|%d;"),
+         wxString(wxSafeConvertMB2WX(Pa_GetHostApiInfo(info->hostApi)->name)),
+         wxString(wxSafeConvertMB2WX(info->name)),
+         info->maxInputChannels, info->maxOutputChannels);
+   }
+
+   return fingerprint;
+}
+
+static void WriteCachedMaps(const wxString &group,
+                            const std::vector<DeviceSourceMap> &maps)
+{
+   gPrefs->DeleteGroup(group);
+   gPrefs->Write(group + wxT("/Count"), (long) maps.size());
+   for (size_t i = 0; i < maps.size(); i++) {
+      const wxString prefix = group + wxString::Format(wxT("/%d/"), (int) i);
+      const DeviceSourceMap &map = maps[i];
+      gPrefs->Write(prefix + wxT("DeviceIndex"), (long) map.deviceIndex);
+      gPrefs->Write(prefix + wxT("SourceIndex"), (long) map.sourceIndex);
+      gPrefs->Write(prefix + wxT("HostIndex"), (long) map.hostIndex);
+      gPrefs->Write(prefix + wxT("TotalSources"), (long) map.totalSources);
+      gPrefs->Write(prefix + wxT("NumChannels"), (long) map.numChannels);
+      gPrefs->Write(prefix + wxT("SourceString"), map.sourceString);
+      gPrefs->Write(prefix + wxT("DeviceString"), map.deviceString);
+      gPrefs->Write(prefix + wxT("HostString"), map.hostString);
+   }
+}
+
+static bool ReadCachedMaps(const wxString &group,
+                           std::vector<DeviceSourceMap> *maps)
+{
+   long count;
+   if (!gPrefs->Read(group + wxT("/Count"), &count) || count < 0)
+      return false;
+
+   for (long i = 0; i < count; i++) {
+      const wxString prefix = group + wxString::Format(wxT("/%d/"), (int) i);
+      DeviceSourceMap map;
+      long value;
+
+      if (!gPrefs->Read(prefix + wxT("DeviceIndex"), &value))
+         return false;
+      map.deviceIndex = value;
+      if (!gPrefs->Read(prefix + wxT("SourceIndex"), &value))
+         return false;
+      map.sourceIndex = value;
+      if (!gPrefs->Read(prefix + wxT("HostIndex"), &value))
+         return false;
+      map.hostIndex = value;
+      if (!gPrefs->Read(prefix + wxT("TotalSources"), &value))
+         return false;
+      map.totalSources = value;
+      if (!gPrefs->Read(prefix + wxT("NumChannels"), &value))
+         return false;
+      map.numChannels = value;
+      map.sourceString = gPrefs->Read(prefix + wxT("SourceString"), wxT(""));
+      map.deviceString = gPrefs->Read(prefix + wxT("DeviceString"), wxT(""));
+      map.hostString   = gPrefs->Read(prefix + wxT("HostString"), wxT(""));
+
+      maps->push_back(map);
+   }
+
+   return true;
+}
+
+
 /// Gets a NEW list of devices by terminating and restarting portaudio
 /// Assumes that DeviceManager is only used on the main thread.
 void DeviceManager::Rescan()
@@ -299,6 +385,18 @@ void DeviceManager::Rescan()
       }
    }
 
+   // Remember this scan so that the next startup can skip it when the
+   // device list is unchanged.
+   const wxString fingerprint = DeviceListFingerprint();
+   if (!fingerprint.empty()) {
+      gPrefs->Write(DEVICE_SCAN_CACHE_GROUP wxT("/Fingerprint"), fingerprint);
+      WriteCachedMaps(DEVICE_SCAN_CACHE_GROUP wxT("/Input"),
+                      mInputDeviceSourceMaps);
+      WriteCachedMaps(DEVICE_SCAN_CACHE_GROUP wxT("/Output"),
+                      mOutputDeviceSourceMaps);
+      gPrefs->Flush();
+   }
+
    // If this was not an initial scan update each device toolbar.
    if ( m_inited ) {
       wxCommandEvent e{ EVT_RESCANNED_DEVICES };
@@ -336,7 +434,29 @@ DeviceManager::~DeviceManager()
 
 void DeviceManager::Init()
 {
-    Rescan();
+   // Try to satisfy the first enumeration from the cache written by the
+   // last full scan; when the current portaudio device list still matches
+   // the fingerprint recorded with it, the sources cannot have changed, so
+   // no streams need to be opened.  Rescan() remains the authority and is
+   // still reachable from the device toolbar if the cache guesses wrong.
+   const wxString fingerprint = DeviceListFingerprint();
+   wxString cached;
+   if (!fingerprint.empty() &&
+       gPrefs->Read(DEVICE_SCAN_CACHE_GROUP wxT("/Fingerprint"), &cached) &&
+       cached == fingerprint &&
+       ReadCachedMaps(DEVICE_SCAN_CACHE_GROUP wxT("/Input"),
+                      &mInputDeviceSourceMaps) &&
+       ReadCachedMaps(DEVICE_SCAN_CACHE_GROUP wxT("/Output"),
+                      &mOutputDeviceSourceMaps)) {
+      m_inited = true;
+      mRescanTime = std::chrono::steady_clock::now();
+   }
+   else {
+      // a partial read may have left entries behind
+      mInputDeviceSourceMaps.clear();
+      mOutputDeviceSourceMaps.clear();
+      Rescan();
+   }
 
 #if defined(EXPERIMENTAL_DEVICE_CHANGE_HANDLER)
 #if defined(HAVE_DEVICE_CHANGE)
@@ -66,6 +66,16 @@
 
 #include <time.h> // to use time() for srand()
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
 #include <wx/wxcrtvararg.h>
 #include <wx/defs.h>
 #include <wx/dir.h>
@@ -209,11 +219,82 @@ int DirManager::RecursivelyEnumerateWithProgress(const FilePath &dirPath,
    if (message)
       progress.create( _("Progress"), message );
 
-   int count = RecursivelyEnumerate(
-                  dirPath, filePathArray, dirspec,filespec,
-                  bFiles, bDirs,
-                  progress_count, 0,
-                  progress.get());
+   // The two-deep eXX/dYY layout of _data shards the block files evenly
+   // over the top-level subdirectories, so enumerate those concurrently.
+   // Each top-level subdirectory gets its own output array, spliced below
+   // in directory order, which reproduces the depth-first order of the
+   // serial walk.  Workers never touch the dialog; they only advance the
+   // shared counter that this thread polls.
+
+   int count = 0;
+
+   // Top-level files, as in RecursivelyEnumerate
+   if (bFiles && dirspec.empty()) {
+      wxDir dir(dirPath);
+      if (dir.IsOpened()) {
+         wxString name;
+         bool cont = dir.GetFirst(&name, filespec,
+            wxDIR_FILES | wxDIR_HIDDEN | wxDIR_NO_FOLLOW);
+         while (cont) {
+            filePathArray.push_back(dirPath + wxFILE_SEP_PATH + name);
+            count++;
+            cont = dir.GetNext(&name);
+         }
+      }
+   }
+
+   FilePaths subdirPaths;
+   {
+      wxDir dir(dirPath);
+      if (dir.IsOpened()) {
+         wxString name;
+         bool cont = dir.GetFirst(&name, dirspec, wxDIR_DIRS | wxDIR_NO_FOLLOW);
+         while (cont) {
+            subdirPaths.push_back(dirPath + wxFILE_SEP_PATH + name);
+            cont = dir.GetNext(&name);
+         }
+      }
+   }
+
+   const unsigned nWorkers = (unsigned) std::min<size_t>(
+      std::max(1u, std::thread::hardware_concurrency()),
+      std::max<size_t>(1, subdirPaths.size()));
+   std::vector<FilePaths> subdirResults(subdirPaths.size());
+   std::atomic<int> filesSoFar{ count };
+   std::vector<std::future<int>> workers;
+   workers.reserve(nWorkers);
+   for (unsigned w = 0; w < nWorkers; w++)
+      workers.push_back(std::async(std::launch::async,
+         [&subdirPaths, &subdirResults, &filesSoFar,
+          &filespec, bFiles, bDirs, nWorkers, w]{
+            int subCount = 0;
+            for (size_t i = w; i < subdirPaths.size(); i += nWorkers) {
+               const int n = RecursivelyEnumerate(
+                  subdirPaths[i], subdirResults[i], wxEmptyString, filespec,
+                  bFiles, bDirs, 0, 0, nullptr);
+               filesSoFar += n;
+               subCount += n;
+            }
+            return subCount;
+         }));
+
+   // Poll for completion, keeping the dialog alive from this thread only
+   for (auto &worker : workers) {
+      while (progress &&
+             worker.wait_for(std::chrono::milliseconds(50)) !=
+                std::future_status::ready)
+         progress->Update(filesSoFar.load(), progress_count);
+      count += worker.get();
+   }
+
+   for (const auto &results : subdirResults)
+      for (const auto &path : results)
+         filePathArray.push_back(path);
+
+   if (bDirs) {
+      filePathArray.push_back(dirPath);
+      count++;
+   }
 
    return count;
 }
@@ -388,11 +469,125 @@ void DirManager::Destroy( AudacityProject &project )
    project.AttachedObjects::Assign( key, nullptr );
 }
 
+//
+// BlockFileRegistry
+//
+
+size_t BlockFileRegistry::IndexOf( const wxString &key )
+{
+   return std::hash< wxString >{}( key ) % nShards;
+}
+
+void BlockFileRegistry::Insert( const wxString &key, const BlockFilePtr &ptr )
+{
+   auto &shard = mShards[ IndexOf( key ) ];
+   std::lock_guard< std::mutex > lock{ shard.mutex };
+   shard.hash[ key ] = ptr;
+}
+
+void BlockFileRegistry::InsertBatch(
+   const std::vector< std::pair< wxString, BlockFilePtr > > &batch )
+{
+   std::vector< size_t > shardOf;
+   shardOf.reserve( batch.size() );
+   for ( const auto &pair : batch )
+      shardOf.push_back( IndexOf( pair.first ) );
+
+   for ( size_t s = 0; s < nShards; s++ ) {
+      auto &shard = mShards[ s ];
+      std::lock_guard< std::mutex > lock{ shard.mutex };
+      for ( size_t i = 0; i < batch.size(); i++ )
+         if ( shardOf[ i ] == s )
+            shard.hash[ batch[ i ].first ] = batch[ i ].second;
+   }
+}
+
+BlockFilePtr BlockFileRegistry::FindOrInsert(
+   const wxString &key, const BlockFilePtr &candidate )
+{
+   auto &shard = mShards[ IndexOf( key ) ];
+   std::lock_guard< std::mutex > lock{ shard.mutex };
+   auto &wEntry = shard.hash[ key ];
+   if ( auto retrieved = wEntry.lock() )
+      return retrieved;
+   wEntry = candidate;
+   return candidate;
+}
+
+BlockFilePtr BlockFileRegistry::Lookup( const wxString &key ) const
+{
+   const auto &shard = mShards[ IndexOf( key ) ];
+   std::lock_guard< std::mutex > lock{ shard.mutex };
+   auto it = shard.hash.find( key );
+   if ( it == shard.hash.end() )
+      return {};
+   return it->second.lock();
+}
+
+bool BlockFileRegistry::ContainsKey( const wxString &key ) const
+{
+   const auto &shard = mShards[ IndexOf( key ) ];
+   std::lock_guard< std::mutex > lock{ shard.mutex };
+   return shard.hash.count( key ) > 0;
+}
+
+size_t BlockFileRegistry::Size() const
+{
+   size_t total = 0;
+   for ( const auto &shard : mShards ) {
+      std::lock_guard< std::mutex > lock{ shard.mutex };
+      total += shard.hash.size();
+   }
+   return total;
+}
+
+auto BlockFileRegistry::GetEntries() const -> Entries
+{
+   Entries results;
+   for ( const auto &shard : mShards ) {
+      std::lock_guard< std::mutex > lock{ shard.mutex };
+      for ( const auto &pair : shard.hash )
+         results.push_back( pair );
+   }
+   return results;
+}
+
+auto BlockFileRegistry::GetLiveEntries() const -> LiveEntries
+{
+   LiveEntries results;
+   for ( const auto &shard : mShards ) {
+      std::lock_guard< std::mutex > lock{ shard.mutex };
+      for ( const auto &pair : shard.hash )
+         if ( auto ptr = pair.second.lock() )
+            results.push_back( { pair.first, ptr } );
+   }
+   return results;
+}
+
+std::vector< wxString > BlockFileRegistry::PurgeDead()
+{
+   std::vector< wxString > removed;
+   for ( auto &shard : mShards ) {
+      std::lock_guard< std::mutex > lock{ shard.mutex };
+      auto it = shard.hash.begin(), end = shard.hash.end();
+      while ( it != end ) {
+         if ( it->second.expired() ) {
+            removed.push_back( it->first );
+            shard.hash.erase( it++ );
+         }
+         else
+            ++it;
+      }
+   }
+   return removed;
+}
+
 DirManager::DirManager()
 {
    wxLogDebug(wxT("DirManager: Created new instance."));
 
    mLastBlockFileDestructionCount = BlockFile::gBlockFileDestructionCount;
+   mLastAliasIndexDestructionCount = BlockFile::gBlockFileDestructionCount;
 
    // Seed the random number generator.
    // this need not be strictly uniform or random, but it should give
@@ -478,6 +673,11 @@ void DirManager::CleanDir(
    if (dontDeleteTempFiles)
       return; // do nothing
 
+   // Complete any block file deletions still pending on the worker
+   // thread, else the sweep could find their files and directories
+   // still occupied
+   BlockFile::FlushDeferredDeletes();
+
    FilePaths filePathArray, dirPathArray;
 
    int countFiles =
@@ -674,9 +874,13 @@ DirManager::ProjectSetter::Impl::Impl(
       will not be deleted in Commit().
    */
 
+   // A copy of the entries, whose order is stable until the registry is
+   // modified; Commit() below relies on enumerating the same sequence
+   const auto entries = dirManager.mBlockFiles.GetEntries();
+
    moving = moving && ! std::any_of(
-      dirManager.mBlockFileHash.begin(), dirManager.mBlockFileHash.end(),
-      []( const BlockHash::value_type &pair ){
+      entries.begin(), entries.end(),
+      []( const BlockFileRegistry::Entries::value_type &pair ){
          auto b = pair.second.lock();
          return b && b->IsLocked();
       }
@@ -690,17 +894,22 @@ DirManager::ProjectSetter::Impl::Impl(
       ProgressDialog progress(_("Progress"),
          _("Saving project data files"));
 
-      int total = dirManager.mBlockFileHash.size();
+      int total = entries.size();
 
+      // First pass:  assign the new names, hard-link what can be linked,
+      // and collect the plain whole-file copies for the bulk pass below.
+      // (Copying one block file at a time on this thread made Save As of
+      // big projects take ages.)
       bool link = moving;
-      for (const auto &pair : dirManager.mBlockFileHash) {
+      std::vector<std::pair<FilePath, FilePath>> copies;
+      for (const auto &pair : entries) {
          if( progress.Update(newPaths.size(), total) != ProgressResult::Success )
             return;
 
          FilePath newPath;
          if (auto b = pair.second.lock()) {
             auto result =
-               dirManager.LinkOrCopyToNewProjectDirectory( &*b, link );
+               dirManager.LinkOrCopyToNewProjectDirectory( &*b, link, &copies );
             if (!result.first)
                return;
             newPath = result.second;
@@ -708,6 +917,50 @@ DirManager::ProjectSetter::Impl::Impl(
          }
          newPaths.push_back( newPath );
       }
+
+      // Second pass:  do the copies on worker threads.  CopyFile clones
+      // the storage where the filesystem can, so this is often pure
+      // metadata work; elsewhere the threads keep the device saturated.
+      if (!copies.empty()) {
+         const unsigned nThreads = std::min<size_t>(
+            std::max(1u, std::thread::hardware_concurrency()), copies.size());
+         std::atomic<size_t> next{ 0 };
+         std::atomic<size_t> done{ 0 };
+         std::atomic<bool> failed{ false };
+         std::atomic<bool> cancelled{ false };
+
+         std::vector<std::thread> workers;
+         for (unsigned t = 0; t < nThreads; t++)
+            workers.emplace_back( [&]{
+               for (;;) {
+                  const size_t i = next++;
+                  if (i >= copies.size() ||
+                      failed.load() || cancelled.load())
+                     break;
+                  if (!FileNames::CopyFile(
+                        copies[i].first, copies[i].second ))
+                     failed.store(true);
+                  ++done;
+               }
+            } );
+
+         // This thread just minds the progress dialog
+         while (done.load() < copies.size() && !failed.load()) {
+            if (progress.Update(
+                  (int) done.load(), (int) copies.size() ) !=
+                ProgressResult::Success) {
+               cancelled.store(true);
+               break;
+            }
+            ::wxMilliSleep(50);
+         }
+
+         for (auto &worker : workers)
+            worker.join();
+
+         if (failed.load() || cancelled.load())
+            return;
+      }
    }
 
    ok = true;
@@ -722,7 +975,7 @@ void DirManager::ProjectSetter::Impl::Commit()
    committed = true;
 
    auto size = newPaths.size();
-   wxASSERT( size == dirManager.mBlockFileHash.size() );
+   wxASSERT( size == dirManager.mBlockFiles.Size() );
 
    // Commit changes to filenames in the BlockFile objects, and removal
    // of files at old paths, ONLY NOW!  This must be nothrow.
@@ -744,7 +997,9 @@ void DirManager::ProjectSetter::Impl::Commit()
    // same procedure in all cases.
 
    size_t ii = 0;
-   for (const auto &pair : dirManager.mBlockFileHash)
+   // Nothing modified the registry since the entries were copied above,
+   // so this enumerates the same sequence
+   for (const auto &pair : dirManager.mBlockFiles.GetEntries())
    {
       BlockFilePtr b = pair.second.lock();
 
@@ -850,7 +1105,11 @@ void DirManager::SetLocalTempDir(const wxString &path)
    mytemp = path;
 }
 
-wxFileNameWrapper DirManager::MakeBlockFilePath(const wxString &value) {
+wxFileNameWrapper DirManager::BlockFilePathFor(const wxString &value) const
+{
+   // Read-only counterpart of MakeBlockFilePath: computes where a block
+   // file of the given name belongs without creating missing
+   // subdirectories, so it is safe to call concurrently
 
    wxFileNameWrapper dir;
    dir.AssignDir(GetDataFilesDir());
@@ -860,9 +1119,6 @@ wxFileNameWrapper DirManager::MakeBlockFilePath(const wxString &value) {
       int location=value.Find(wxT('b'));
       wxString subdir=value.Mid(0,location);
       dir.AppendDir(subdir);
-
-      if(!dir.DirExists())
-         dir.Mkdir();
    }
 
    if(value.GetChar(0)==wxT('e')){
@@ -873,11 +1129,17 @@ wxFileNameWrapper DirManager::MakeBlockFilePath(const wxString &value) {
 
       dir.AppendDir(topdir);
       dir.AppendDir(middir);
+   }
+   return dir;
+}
 
-      if(!dir.DirExists() && !dir.Mkdir(0777,wxPATH_MKDIR_FULL))
-      { // need braces to avoid compiler warning about ambiguous else, see the macro
-         wxLogSysError(_("mkdir in DirManager::MakeBlockFilePath failed."));
-      }
+wxFileNameWrapper DirManager::MakeBlockFilePath(const wxString &value) {
+
+   wxFileNameWrapper dir{ BlockFilePathFor(value) };
+
+   if(!dir.DirExists() && !dir.Mkdir(0777,wxPATH_MKDIR_FULL))
+   { // need braces to avoid compiler warning about ambiguous else, see the macro
+      wxLogSysError(_("mkdir in DirManager::MakeBlockFilePath failed."));
    }
    return dir;
 }
@@ -1000,18 +1262,8 @@ auto DirManager::GetBalanceInfo() -> BalanceInfo &
 
    auto count = BlockFile::gBlockFileDestructionCount;
    if ( mLastBlockFileDestructionCount != count ) {
-      auto it = mBlockFileHash.begin(), end = mBlockFileHash.end();
-      while (it != end)
-      {
-         BlockFilePtr ptr { it->second.lock() };
-         if (!ptr) {
-            auto name = it->first;
-            mBlockFileHash.erase( it++ );
-            BalanceInfoDel( name );
-         }
-         else
-            ++it;
-      }
+      for ( const auto &name : mBlockFiles.PurgeDead() )
+         BalanceInfoDel( name );
    }
 
    mLastBlockFileDestructionCount = count;
@@ -1185,8 +1437,10 @@ wxFileNameWrapper DirManager::MakeBlockFileName()
 
       baseFileName.Printf(wxT("e%02x%02x%03x"),topnum,midnum,filenum);
 
-      if (!ContainsBlockFile(baseFileName)) {
-         // not in the hash, good.
+      if (!ContainsBlockFile(baseFileName) &&
+          !BlockFile::IsDeletionPending(baseFileName)) {
+         // not in the hash, and no deferred deletion could later claim
+         // the name; good.
          if (!this->AssignFile(ret, baseFileName, true))
          {
             // this indicates an on-disk collision, likely due to an
@@ -1207,12 +1461,102 @@ wxFileNameWrapper DirManager::MakeBlockFileName()
    return ret;
 }
 
+// Bounded queue feeding one I/O thread that writes out block files
+// staged in memory, so that Sequence::Append on the recording path only
+// stages samples and never waits on the filesystem.  Bounding the queue
+// gives natural backpressure if the disk cannot keep up.
+class BlockWriteQueue {
+ public:
+   BlockWriteQueue()
+   {
+      mThread = std::thread([this]{ Run(); });
+   }
+
+   ~BlockWriteQueue()
+   {
+      {
+         std::lock_guard<std::mutex> guard{ mMutex };
+         mDone = true;
+      }
+      mWork.notify_all();
+      // The thread drains whatever is still queued before exiting
+      mThread.join();
+   }
+
+   void Enqueue(const BlockFilePtr &blockFile)
+   {
+      std::unique_lock<std::mutex> lock{ mMutex };
+      mSpace.wait(lock,
+         [this]{ return mQueue.size() < MaxQueued || mDone; });
+      mQueue.push_back(blockFile);
+      mWork.notify_one();
+   }
+
+   void Finish()
+   {
+      std::unique_lock<std::mutex> lock{ mMutex };
+      mIdle.wait(lock, [this]{ return mQueue.empty() && !mBusy; });
+   }
+
+ private:
+   void Run()
+   {
+      for (;;) {
+         BlockFilePtr blockFile;
+         {
+            std::unique_lock<std::mutex> lock{ mMutex };
+            mWork.wait(lock,
+               [this]{ return mDone || !mQueue.empty(); });
+            if (mQueue.empty()) {
+               // mDone and nothing left to write
+               return;
+            }
+            blockFile = mQueue.front();
+            mQueue.pop_front();
+            mBusy = true;
+         }
+         mSpace.notify_one();
+         if (blockFile->GetNeedWriteCacheToDisk())
+            blockFile->WriteCacheToDisk();
+         {
+            std::lock_guard<std::mutex> guard{ mMutex };
+            mBusy = false;
+            if (mQueue.empty())
+               mIdle.notify_all();
+         }
+      }
+   }
+
+   enum : size_t { MaxQueued = 16 };
+
+   std::deque<BlockFilePtr> mQueue;
+   std::mutex mMutex;
+   std::condition_variable mWork, mSpace, mIdle;
+   bool mBusy{ false };
+   bool mDone{ false };
+   std::thread mThread;
+};
+
+void DirManager::EnqueueBlockWrite( const BlockFilePtr &blockFile )
+{
+   if (!mBlockWriteQueue)
+      mBlockWriteQueue = std::make_unique<BlockWriteQueue>();
+   mBlockWriteQueue->Enqueue( blockFile );
+}
+
+void DirManager::FinishBlockWrites()
+{
+   if (mBlockWriteQueue)
+      mBlockWriteQueue->Finish();
+}
+
 BlockFilePtr DirManager::NewBlockFile( const BlockFileFactory &factory )
 {
    wxFileNameWrapper filePath{ MakeBlockFileName() };
    const wxString fileName{ filePath.GetName() };
    auto newBlockFile = factory( std::move(filePath) );
-   mBlockFileHash[fileName] = newBlockFile;
+   mBlockFiles.Insert(fileName, newBlockFile);
+   RegisterAliasBlockFile(fileName, newBlockFile);
    auto &aliasName = newBlockFile->GetExternalFileName();
    if ( aliasName.IsOk() )
       //OD TODO: check to see if we need to remove this when done decoding.
@@ -1221,24 +1565,85 @@ BlockFilePtr DirManager::NewBlockFile( const BlockFileFactory &factory )
    return newBlockFile;
 }
 
+namespace {
+   // FNV-1a over the raw sample bytes, seeded with the length and
+   // format; the same digest family the sequences use for their
+   // identity hashes
+   wxUint64 ContentKey(
+      samplePtr sampleData, size_t sampleLen, sampleFormat format)
+   {
+      wxUint64 hash = wxULL(14695981039346336037);
+      auto mix = [&hash](const unsigned char *bytes, size_t count) {
+         for (size_t i = 0; i < count; i++) {
+            hash ^= bytes[i];
+            hash *= wxULL(1099511628211);
+         }
+      };
+      const wxUint64 meta = ((wxUint64)format << 32) ^ (wxUint64)sampleLen;
+      mix((const unsigned char *)&meta, sizeof(meta));
+      mix((const unsigned char *)sampleData, sampleLen * SAMPLE_SIZE(format));
+      return hash;
+   }
+}
+
+BlockFilePtr DirManager::NewBlockFile( const BlockFileFactory &factory,
+   samplePtr sampleData, size_t sampleLen, sampleFormat format )
+{
+   const auto key = ContentKey(sampleData, sampleLen, format);
+
+   // Collect the live candidates under the lock, but verify outside it,
+   // because verification reads a candidate's samples back from disk
+   std::vector<BlockFilePtr> candidates;
+   {
+      std::lock_guard<std::mutex> guard{ mContentMutex };
+      auto range = mContentHashIndex.equal_range(key);
+      for (auto it = range.first; it != range.second;) {
+         if (auto candidate = it->second.lock()) {
+            candidates.push_back(candidate);
+            ++it;
+         }
+         else
+            it = mContentHashIndex.erase(it);
+      }
+   }
+
+   for (const auto &candidate : candidates) {
+      if (candidate->GetLength() != sampleLen)
+         continue;
+      SampleBuffer scratch{ sampleLen, format };
+      if (candidate->ReadData(scratch.ptr(), format, 0, sampleLen, false)
+            != sampleLen)
+         continue;
+      if (memcmp(scratch.ptr(), sampleData,
+            sampleLen * SAMPLE_SIZE(format)) == 0)
+         // The project already owns a block with exactly these samples;
+         // reference it instead of writing another copy of it
+         return candidate;
+   }
+
+   // Two threads importing the same block concurrently may each miss
+   // and write its own copy; that costs one duplicate, not correctness
+   auto result = NewBlockFile( factory );
+   {
+      std::lock_guard<std::mutex> guard{ mContentMutex };
+      mContentHashIndex.insert({ key, result });
+   }
+   return result;
+}
+
 bool DirManager::ContainsBlockFile(const BlockFile *b) const
 {
    if (!b)
       return false;
    auto result = b->GetFileName();
-   BlockHash::const_iterator it = mBlockFileHash.find(result.name.GetName());
-   if (it == mBlockFileHash.end())
-      return false;
-   BlockFilePtr ptr = it->second.lock();
+   BlockFilePtr ptr = mBlockFiles.Lookup(result.name.GetName());
    return ptr && (b == &*ptr);
 }
 
 bool DirManager::ContainsBlockFile(const wxString &filepath) const
 {
    // check what the hash returns in case the blockfile is from a different project
-   BlockHash::const_iterator it = mBlockFileHash.find(filepath);
-   return it != mBlockFileHash.end() &&
-      BlockFilePtr{ it->second.lock() };
+   return (bool) mBlockFiles.Lookup(filepath);
 }
 
 // Adds one to the reference count of the block file,
@@ -1255,15 +1660,35 @@ BlockFilePtr DirManager::CopyBlockFile(const BlockFilePtr &b)
 
    if (!b->IsLocked()) {
       //mchinen:July 13 2009 - not sure about this, but it needs to be added to the hash to be able to save if not locked.
-      //note that this shouldn't hurt mBlockFileHash's that already contain the filename, since it should just overwrite.
+      //note that this shouldn't hurt registries that already contain the filename, since it should just overwrite.
       //but it's something to watch out for.
       //
       // LLL: Except for silent block files which have uninitialized filename.
-      if (fn.IsOk())
-         mBlockFileHash[fn.GetName()] = b;
+      if (fn.IsOk()) {
+         mBlockFiles.Insert(fn.GetName(), b);
+         RegisterAliasBlockFile(fn.GetName(), b);
+      }
       return b;
    }
 
+   // Block files are immutable once written, so if this project has already
+   // made a physical copy of this locked source block, share that copy
+   // rather than duplicate the file yet again.  This makes repeated pastes
+   // of the same clipboard contents into a project metadata-only after the
+   // first one.
+   {
+      auto iter = mCopiedBlockFiles.find( b.get() );
+      if (iter != mCopiedBlockFiles.end()) {
+         const auto source = iter->second.first.lock();
+         const auto copy = iter->second.second.lock();
+         if (source == b && copy)
+            return copy;
+         // The address was recycled for a different block, or the copy is
+         // gone; forget the entry and copy afresh.
+         mCopiedBlockFiles.erase( iter );
+      }
+   }
+
    // Copy the blockfile
    BlockFilePtr b2;
    if (!fn.IsOk())
@@ -1296,13 +1721,16 @@ BlockFilePtr DirManager::CopyBlockFile(const BlockFilePtr &b)
 
       b2 = b->Copy(std::move(newFile));
 
-      mBlockFileHash[newName] = b2;
+      mBlockFiles.Insert(newName, b2);
+      RegisterAliasBlockFile(newName, b2);
       aliasList.push_back(newPath);
    }
 
    if (!b2)
       THROW_INCONSISTENCY_EXCEPTION;
 
+   mCopiedBlockFiles[ b.get() ] = { b, b2 };
+
    return b2;
 }
 
@@ -1370,19 +1798,18 @@ bool DirManager::HandleXMLTag(const wxChar *tag, const wxChar **attrs)
    //
 
    wxString name = target->GetFileName().name.GetName();
-   auto &wRetrieved = mBlockFileHash[name];
-   BlockFilePtr retrieved = wRetrieved.lock();
-   if (retrieved) {
+   BlockFilePtr registered = mBlockFiles.FindOrInsert(name, target);
+   if (registered != target) {
       // Lock it in order to DELETE it safely, i.e. without having
       // it DELETE the file, too...
       target->Lock();
 
-      target = retrieved;
+      target = registered;
       return true;
    }
 
    // This is a NEW object
-   wRetrieved = target;
+   RegisterAliasBlockFile(name, target);
    // MakeBlockFileName wasn't used so we must add the directory
    // balancing information
    BalanceInfoAdd(name);
@@ -1391,7 +1818,8 @@ bool DirManager::HandleXMLTag(const wxChar *tag, const wxChar **attrs)
 }
 
 std::pair<bool, FilePath> DirManager::LinkOrCopyToNewProjectDirectory(
-   BlockFile *f, bool &link )
+   BlockFile *f, bool &link,
+   std::vector<std::pair<FilePath, FilePath>> *pDeferredCopies )
 {
    FilePath newPath;
    auto result = f->GetFileName();
@@ -1422,9 +1850,16 @@ std::pair<bool, FilePath> DirManager::LinkOrCopyToNewProjectDirectory(
          bool success = false;
          if (link)
             success = FileNames::HardLinkFile( oldPath, newPath );
-         if (!success)
-             link = false,
-             success = FileNames::CopyFile( oldPath, newPath );
+         if (!success) {
+            link = false;
+            if (pDeferredCopies) {
+               // The caller copies these in bulk later
+               pDeferredCopies->push_back( { oldPath, newPath } );
+               success = true;
+            }
+            else
+               success = FileNames::CopyFile( oldPath, newPath );
+         }
          if (!success)
             return { false, {} };
       }
@@ -1522,20 +1957,16 @@ bool DirManager::EnsureSafeFilename(const wxFileName &fName)
 
    bool needToRename = false;
    wxBusyCursor busy;
-   BlockHash::iterator iter = mBlockFileHash.begin();
    std::vector< BlockFile::ReadLock > readLocks;
-   while (iter != mBlockFileHash.end())
+   for (const auto &pair : mBlockFiles.GetLiveEntries())
    {
-      BlockFilePtr b = iter->second.lock();
-      if (b) {
-         if (fName.IsOk() && b->GetExternalFileName() == fName) {
-            needToRename = true;
+      const auto &b = pair.second;
+      if (fName.IsOk() && b->GetExternalFileName() == fName) {
+         needToRename = true;
 
-            //ODBlocks access the aliased file on another thread, so we need to pause them before this continues.
-            readLocks.push_back( b->LockForRead() );
-         }
+         //ODBlocks access the aliased file on another thread, so we need to pause them before this continues.
+         readLocks.push_back( b->LockForRead() );
       }
-      ++iter;
    }
 
    if (needToRename) {
@@ -1559,19 +1990,15 @@ bool DirManager::EnsureSafeFilename(const wxFileName &fName)
       else
       {
          //point the aliases to the NEW filename.
-         BlockHash::iterator iter2 = mBlockFileHash.begin();
-         while (iter2 != mBlockFileHash.end())
+         for (const auto &pair : mBlockFiles.GetLiveEntries())
          {
-            BlockFilePtr b = iter2->second.lock();
-            if (b) {
-               if (fName.IsOk() && b->GetExternalFileName() == fName) {
-                  b->SetExternalFileName(wxFileNameWrapper{ renamedFileName });
-                  wxPrintf(_("Changed block %s to new alias name\n"),
-                           b->GetFileName().name.GetFullName());
+            const auto &b = pair.second;
+            if (fName.IsOk() && b->GetExternalFileName() == fName) {
+               b->SetExternalFileName(wxFileNameWrapper{ renamedFileName });
+               wxPrintf(_("Changed block %s to new alias name\n"),
+                        b->GetFileName().name.GetFullName());
 
-               }
             }
-            ++iter2;
          }
 
       }
@@ -1586,38 +2013,136 @@ bool DirManager::EnsureSafeFilename(const wxFileName &fName)
    return true;
 }
 
+void DirManager::RegisterAliasBlockFile(
+   const wxString &key, const BlockFilePtr &b)
+{
+   if (b && b->IsAlias()) {
+      // Registration may come from importer worker threads
+      std::lock_guard< std::mutex > lock{ mAliasMutex };
+      mAliasBlockFileHash[key] = b;
+   }
+}
+
+// Caller must hold mAliasMutex
+void DirManager::PurgeDeadAliasBlockFiles()
+{
+   // As in GetBalanceInfo(), consult the global destruction count, so
+   // that the index is walked only when block files actually went away
+   // since the last query
+   auto count = BlockFile::gBlockFileDestructionCount;
+   if ( mLastAliasIndexDestructionCount != count ) {
+      auto it = mAliasBlockFileHash.begin(), end = mAliasBlockFileHash.end();
+      while (it != end)
+      {
+         if (it->second.expired())
+            mAliasBlockFileHash.erase( it++ );
+         else
+            ++it;
+      }
+      mLastAliasIndexDestructionCount = count;
+   }
+}
+
+bool DirManager::HasAliasBlockFiles()
+{
+   std::lock_guard< std::mutex > lock{ mAliasMutex };
+   PurgeDeadAliasBlockFiles();
+   return !mAliasBlockFileHash.empty();
+}
+
+bool DirManager::AliasedFileExists(const wxFileName &fileName)
+{
+   const wxString path{ fileName.GetFullPath() };
+   {
+      std::lock_guard< std::mutex > lock{ mAliasMutex };
+      auto it = mAliasExistsCache.find(path);
+      if (it != mAliasExistsCache.end() && it->second)
+         return true;
+   }
+   const bool exists = fileName.FileExists();
+   std::lock_guard< std::mutex > lock{ mAliasMutex };
+   mAliasExistsCache[path] = exists;
+   return exists;
+}
+
+// Helper for the FindMissing... and FindOrphan... methods below: runs
+// the given check over [0, count) on a pool of one worker per core.
+// Each worker appends the indices that failed the check to its own
+// array; the concatenation, in worker-then-index order, is returned.
+// The check must be thread-safe and must not touch the GUI.
+static std::vector<size_t> ParallelFileCheck(
+   size_t count, const std::function< bool(size_t) > &check )
+{
+   const unsigned nWorkers = (unsigned) std::min<size_t>(
+      std::max(1u, std::thread::hardware_concurrency()),
+      std::max<size_t>(1, count));
+   std::vector< std::vector<size_t> > found( nWorkers );
+   std::vector< std::future<void> > workers;
+   workers.reserve( nWorkers );
+   for (unsigned w = 0; w < nWorkers; w++)
+      workers.push_back( std::async( std::launch::async,
+         [&found, &check, count, nWorkers, w]{
+            auto &out = found[w];
+            for (size_t i = w; i < count; i += nWorkers)
+               if (check(i))
+                  out.push_back(i);
+         }));
+   for (auto &worker : workers)
+      worker.get();
+
+   std::vector<size_t> results;
+   for (const auto &perWorker : found)
+      for (auto index : perWorker)
+         results.push_back(index);
+   return results;
+}
+
+// Snapshot of the live block files, so workers need not touch the
+// weak pointers in the registry
+using BlockSnapshot = BlockFileRegistry::LiveEntries;
+
+static BlockSnapshot SnapshotBlockFiles(
+   const BlockFileRegistry &registry, bool wantAlias )
+{
+   BlockSnapshot snapshot;
+   for (auto &pair : registry.GetLiveEntries())
+      if (pair.second->IsAlias() == wantAlias)
+         snapshot.push_back( std::move(pair) );
+   return snapshot;
+}
+
 void DirManager::FindMissingAliasFiles(
       BlockHash& missingAliasFilesAUFHash,     // output: (.auf) AliasBlockFiles whose aliased files are missing
       BlockHash& missingAliasFilesPathHash)    // output: full paths of missing aliased files
 {
-   BlockHash::iterator iter = mBlockFileHash.begin();
-   while (iter != mBlockFileHash.end())
-   {
-      wxString key = iter->first;   // file name and extension
-      BlockFilePtr b = iter->second.lock();
-      if (b) {
-         if (b->IsAlias())
-         {
-            const wxFileName &aliasedFileName =
-            static_cast< AliasBlockFile* > ( &*b )->GetAliasedFileName();
-            wxString aliasedFileFullPath = aliasedFileName.GetFullPath();
-            // wxEmptyString can happen if user already chose to "replace... with silence".
-            if ((!aliasedFileFullPath.empty()) &&
-                !aliasedFileName.FileExists())
-            {
-               missingAliasFilesAUFHash[key] = b;
-               if (missingAliasFilesPathHash.find(aliasedFileFullPath) ==
-                   missingAliasFilesPathHash.end()) // Add it only once.
-                  // Not actually using the block here, just the path,
-                  // so set the block to NULL to create the entry.
-                  missingAliasFilesPathHash[aliasedFileFullPath] = {};
-            }
-         }
-      }
-      ++iter;
+   // The existence checks dominate on large projects, so spread them
+   // over the worker pool; logging and the hash fills stay sequential
+   auto snapshot = SnapshotBlockFiles( mBlockFiles, true );
+
+   auto missing = ParallelFileCheck( snapshot.size(),
+      [&snapshot]( size_t i ){
+         const wxFileName &aliasedFileName =
+            static_cast< AliasBlockFile* > ( &*snapshot[i].second )
+               ->GetAliasedFileName();
+         // wxEmptyString can happen if user already chose to "replace... with silence".
+         return !aliasedFileName.GetFullPath().empty() &&
+            !aliasedFileName.FileExists();
+      });
+
+   for (auto index : missing) {
+      const auto &pair = snapshot[index];
+      missingAliasFilesAUFHash[pair.first] = pair.second;
+      wxString aliasedFileFullPath =
+         static_cast< AliasBlockFile* > ( &*pair.second )
+            ->GetAliasedFileName().GetFullPath();
+      if (missingAliasFilesPathHash.find(aliasedFileFullPath) ==
+          missingAliasFilesPathHash.end()) // Add it only once.
+         // Not actually using the block here, just the path,
+         // so set the block to NULL to create the entry.
+         missingAliasFilesPathHash[aliasedFileFullPath] = {};
    }
 
-   iter = missingAliasFilesPathHash.begin();
+   auto iter = missingAliasFilesPathHash.begin();
    while (iter != missingAliasFilesPathHash.end())
    {
       wxLogWarning(_("Missing aliased audio file: '%s'"), iter->first);
@@ -1628,57 +2153,60 @@ void DirManager::FindMissingAliasFiles(
 void DirManager::FindMissingAUFs(
       BlockHash& missingAUFHash)                // output: missing (.auf) AliasBlockFiles
 {
-   BlockHash::iterator iter = mBlockFileHash.begin();
-   while (iter != mBlockFileHash.end())
-   {
-      const wxString &key = iter->first;
-      BlockFilePtr b = iter->second.lock();
-      if (b) {
-         if (b->IsAlias() && b->IsSummaryAvailable())
-         {
-            /* don't look in hash; that might find files the user moved
-             that the Blockfile abstraction can't find itself */
-            wxFileNameWrapper fileName{ MakeBlockFilePath(key) };
-            fileName.SetName(key);
-            fileName.SetExt(wxT("auf"));
-            if (!fileName.FileExists())
-            {
-               missingAUFHash[key] = b;
-               wxLogWarning(_("Missing alias (.auf) block file: '%s'"),
-                            fileName.GetFullPath());
-            }
-         }
-      }
-      ++iter;
+   BlockSnapshot snapshot;
+   for (auto &pair : mBlockFiles.GetLiveEntries()) {
+      const auto &b = pair.second;
+      // Query IsSummaryAvailable here rather than on the workers; for
+      // on-demand blocks it consults state owned by the decoding task
+      if (b->IsAlias() && b->IsSummaryAvailable())
+         snapshot.push_back( std::move(pair) );
+   }
+
+   auto missing = ParallelFileCheck( snapshot.size(),
+      [this, &snapshot]( size_t i ){
+         /* don't look in hash; that might find files the user moved
+          that the Blockfile abstraction can't find itself */
+         wxFileNameWrapper fileName{ BlockFilePathFor(snapshot[i].first) };
+         fileName.SetName(snapshot[i].first);
+         fileName.SetExt(wxT("auf"));
+         return !fileName.FileExists();
+      });
+
+   for (auto index : missing) {
+      const auto &pair = snapshot[index];
+      missingAUFHash[pair.first] = pair.second;
+      wxFileNameWrapper fileName{ BlockFilePathFor(pair.first) };
+      fileName.SetName(pair.first);
+      fileName.SetExt(wxT("auf"));
+      wxLogWarning(_("Missing alias (.auf) block file: '%s'"),
+                   fileName.GetFullPath());
    }
 }
 
 void DirManager::FindMissingAUs(
       BlockHash& missingAUHash)                 // missing data (.au) blockfiles
 {
-   BlockHash::iterator iter = mBlockFileHash.begin();
-   while (iter != mBlockFileHash.end())
-   {
-      const wxString &key = iter->first;
-      BlockFilePtr b = iter->second.lock();
-      // TODO key can be empty in doing a ProjectFSK
-      // In which case MakeFilePath will fail.  Bail out?
-      if (b) {
-         if (!b->IsAlias())
-         {
-            wxFileNameWrapper fileName{ MakeBlockFilePath(key) };
-            fileName.SetName(key);
-            fileName.SetExt(wxT("au"));
-            const auto path = fileName.GetFullPath();
-            if (!fileName.FileExists() ||
-                wxFile{ path }.Length() == 0)
-            {
-               missingAUHash[key] = b;
-               wxLogWarning(_("Missing data block file: '%s'"), path);
-            }
-         }
-      }
-      ++iter;
+   // TODO key can be empty in doing a ProjectFSK
+   // In which case MakeFilePath will fail.  Bail out?
+   auto snapshot = SnapshotBlockFiles( mBlockFiles, false );
+
+   auto missing = ParallelFileCheck( snapshot.size(),
+      [this, &snapshot]( size_t i ){
+         wxFileNameWrapper fileName{ BlockFilePathFor(snapshot[i].first) };
+         fileName.SetName(snapshot[i].first);
+         fileName.SetExt(wxT("au"));
+         const auto path = fileName.GetFullPath();
+         return !fileName.FileExists() ||
+            wxFile{ path }.Length() == 0;
+      });
+
+   for (auto index : missing) {
+      const auto &pair = snapshot[index];
+      missingAUHash[pair.first] = pair.second;
+      wxFileNameWrapper fileName{ BlockFilePathFor(pair.first) };
+      fileName.SetName(pair.first);
+      fileName.SetExt(wxT("au"));
+      wxLogWarning(_("Missing data block file: '%s'"), fileName.GetFullPath());
    }
 }
 
@@ -1694,28 +2222,32 @@ void DirManager::FindOrphanBlockFiles(
          otherDirManagers.push_back( sPtr );
    }
 
-   for (size_t i = 0; i < filePathArray.size(); i++)
-   {
-      const wxFileName &fullname = filePathArray[i];
-      wxString basename = fullname.GetName();
-      const wxString ext{fullname.GetExt()};
-      if ((mBlockFileHash.find(basename) == mBlockFileHash.end()) && // is orphan
-            // Consider only Audacity data files.
-            // Specifically, ignore <branding> JPG and <import> OGG ("Save Compressed Copy").
-            (ext.IsSameAs(wxT("au"), false) ||
-               ext.IsSameAs(wxT("auf"), false)))
-      {
-         // Ignore it if it exists in the clipboard (from a previously closed project)
-         if ( std::any_of( otherDirManagers.begin(), otherDirManagers.end(),
-            [&]( const std::shared_ptr< DirManager > &ptr ){
-               return ptr->ContainsBlockFile( basename );
-            }
-         ) )
-            continue;
+   // The workers only read the hashes of this and the other DirManagers
+   auto orphans = ParallelFileCheck( filePathArray.size(),
+      [this, &filePathArray, &otherDirManagers]( size_t i ){
+         const wxFileName &fullname = filePathArray[i];
+         wxString basename = fullname.GetName();
+         const wxString ext{fullname.GetExt()};
+         if (!mBlockFiles.ContainsKey(basename) && // is orphan
+               // Consider only Audacity data files.
+               // Specifically, ignore <branding> JPG and <import> OGG ("Save Compressed Copy").
+               (ext.IsSameAs(wxT("au"), false) ||
+                  ext.IsSameAs(wxT("auf"), false)))
+         {
+            // Ignore it if it exists in the clipboard (from a previously closed project)
+            return !std::any_of(
+               otherDirManagers.begin(), otherDirManagers.end(),
+               [&]( const std::shared_ptr< DirManager > &ptr ){
+                  return ptr->ContainsBlockFile( basename );
+               } );
+         }
+         return false;
+      });
+
+   for (auto index : orphans)
+      orphanFilePathArray.push_back(
+         wxFileName{ filePathArray[index] }.GetFullPath());
 
-         orphanFilePathArray.push_back(fullname.GetFullPath());
-      }
-   }
    for ( const auto &orphan : orphanFilePathArray )
       wxLogWarning(_("Orphan block file: '%s'"), orphan);
 }
@@ -1731,7 +2263,7 @@ void DirManager::RemoveOrphanBlockfiles()
       wxEmptyString,          // All dirs
       wxEmptyString,          // All files
       true, false,
-      mBlockFileHash.size(),  // rough guess of how many BlockFiles will be found/processed, for progress
+      mBlockFiles.Size(),  // rough guess of how many BlockFiles will be found/processed, for progress
       _("Inspecting project file data"));
 
    FilePaths orphanFilePathArray;
@@ -1760,19 +2292,12 @@ void DirManager::FillBlockfilesCache()
    }
    lowMem <<= 20;
 
-   BlockHash::iterator iter;
-   int numNeed = 0;
+   const auto liveEntries = mBlockFiles.GetLiveEntries();
 
-   iter = mBlockFileHash.begin();
-   while (iter != mBlockFileHash.end())
-   {
-      BlockFilePtr b = iter->second.lock();
-      if (b) {
-         if (b->GetNeedFillCache())
-            numNeed++;
-      }
-      ++iter;
-   }
+   int numNeed = 0;
+   for (const auto &pair : liveEntries)
+      if (pair.second->GetNeedFillCache())
+         numNeed++;
 
    if (numNeed == 0)
       return;
@@ -1780,40 +2305,33 @@ void DirManager::FillBlockfilesCache()
    ProgressDialog progress(_("Caching audio"),
                            _("Caching audio into memory"));
 
-   iter = mBlockFileHash.begin();
    int current = 0;
-   while (iter != mBlockFileHash.end())
+   for (const auto &pair : liveEntries)
    {
-      BlockFilePtr b = iter->second.lock();
-      if (b) {
-         if (b->GetNeedFillCache() && (GetFreeMemory() > lowMem)) {
-            b->FillCache();
-         }
-
-         if (!progress.Update(current, numNeed))
-            break; // user cancelled progress dialog, stop caching
-         current++;
+      const auto &b = pair.second;
+      if (b->GetNeedFillCache() && (GetFreeMemory() > lowMem)) {
+         b->FillCache();
       }
-      ++iter;
+
+      if (!progress.Update(current, numNeed))
+         break; // user cancelled progress dialog, stop caching
+      current++;
    }
 #endif // DEPRECATED_AUDIO_CACHE
 }
 
 void DirManager::WriteCacheToDisk()
 {
-   BlockHash::iterator iter;
-   int numNeed = 0;
+   // Let the write-behind thread finish first; most blocks will then
+   // need no further writing below
+   FinishBlockWrites();
 
-   iter = mBlockFileHash.begin();
-   while (iter != mBlockFileHash.end())
-   {
-      BlockFilePtr b = iter->second.lock();
-      if (b) {
-         if (b->GetNeedWriteCacheToDisk())
-            numNeed++;
-      }
-      ++iter;
-   }
+   const auto liveEntries = mBlockFiles.GetLiveEntries();
+
+   int numNeed = 0;
+   for (const auto &pair : liveEntries)
+      if (pair.second->GetNeedWriteCacheToDisk())
+         numNeed++;
 
    if (numNeed == 0)
       return;
@@ -1821,20 +2339,16 @@ void DirManager::WriteCacheToDisk()
    ProgressDialog progress(_("Saving recorded audio"),
                            _("Saving recorded audio to disk"));
 
-   iter = mBlockFileHash.begin();
    int current = 0;
-   while (iter != mBlockFileHash.end())
+   for (const auto &pair : liveEntries)
    {
-      BlockFilePtr b = iter->second.lock();
-      if (b) {
-         if (b->GetNeedWriteCacheToDisk())
-         {
-            b->WriteCacheToDisk();
-            progress.Update(current, numNeed);
-         }
-         current++;
+      const auto &b = pair.second;
+      if (b->GetNeedWriteCacheToDisk())
+      {
+         b->WriteCacheToDisk();
+         progress.Update(current, numNeed);
       }
-      ++iter;
+      current++;
    }
 }
 
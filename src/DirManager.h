@@ -16,10 +16,14 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "ClientData.h"
 
+class wxFileName;
 class wxFileNameWrapper;
 class AudacityProject;
 class BlockArray;
@@ -33,6 +37,63 @@ using BlockFilePtr = std::shared_ptr<BlockFile>;
 
 using BlockHash = std::unordered_map< wxString, std::weak_ptr<BlockFile> >;
 
+// The repository of the block files of one project, sharded by a hash
+// of the key with a mutex per shard, so that registration and lookup
+// from worker threads (parallel importers, the write-behind thread) do
+// not serialize on a single lock.  Entries hold weak pointers, as
+// mBlockFileHash always did; dead entries persist until purged.
+class BlockFileRegistry
+{
+public:
+   enum : size_t { nShards = 16 };
+
+   void Insert( const wxString &key, const BlockFilePtr &ptr );
+
+   // Registers many block files, taking each shard lock only once.
+   // Meant for importers that create thousands of blocks in a burst.
+   void InsertBatch(
+      const std::vector< std::pair< wxString, BlockFilePtr > > &batch );
+
+   // If a live block file is already registered under the key, returns
+   // it, else registers the candidate and returns that.  Atomic, so two
+   // loaders of the same block cannot both insert.
+   BlockFilePtr FindOrInsert(
+      const wxString &key, const BlockFilePtr &candidate );
+
+   // Returns the named block file if it is registered and still alive
+   BlockFilePtr Lookup( const wxString &key ) const;
+
+   // True if the key is registered, even if the block file has died
+   bool ContainsKey( const wxString &key ) const;
+
+   // Number of entries, dead ones included
+   size_t Size() const;
+
+   using Entries =
+      std::vector< std::pair< wxString, std::weak_ptr<BlockFile> > >;
+   using LiveEntries = std::vector< std::pair< wxString, BlockFilePtr > >;
+
+   // Copies of the entries, in an order that is stable until the
+   // registry is next modified
+   Entries GetEntries() const;
+   // Only the entries whose block files are still alive
+   LiveEntries GetLiveEntries() const;
+
+   // Erases entries whose block files have been destroyed, returning
+   // their keys
+   std::vector< wxString > PurgeDead();
+
+private:
+   struct Shard
+   {
+      mutable std::mutex mutex;
+      BlockHash hash;
+   };
+   static size_t IndexOf( const wxString &key );
+
+   Shard mShards[ nShards ];
+};
+
 wxMemorySize GetFreeMemory();
 
 enum {
@@ -104,7 +165,7 @@ class PROFILE_DLL_API DirManager final
    DirManager &operator=( const DirManager & ) PROHIBITED;
    virtual ~DirManager();
 
-   size_t NumBlockFiles() const { return mBlockFileHash.size(); }
+   size_t NumBlockFiles() const { return mBlockFiles.Size(); }
 
    static void SetTempDir(const wxString &_temp) { globaltemp = _temp; }
 
@@ -142,6 +203,15 @@ class PROFILE_DLL_API DirManager final
    using BlockFileFactory = std::function< BlockFilePtr( wxFileNameWrapper ) >;
    BlockFilePtr NewBlockFile( const BlockFileFactory &factory );
 
+   // As above, but content-addressed:  if the project already owns a
+   // block file holding exactly the given samples, returns it, and the
+   // factory is never invoked; else the factory's NEW block file is
+   // remembered under a digest of the samples for later calls to find.
+   // Importing the same source file twice thus references the blocks the
+   // first import wrote instead of duplicating them all on disk.
+   BlockFilePtr NewBlockFile( const BlockFileFactory &factory,
+      samplePtr sampleData, size_t sampleLen, sampleFormat format );
+
    /// Returns true if the blockfile pointed to by b is contained by the DirManager
    bool ContainsBlockFile(const BlockFile *b) const;
    /// Check for existing using filename using complete filename
@@ -162,8 +232,12 @@ class PROFILE_DLL_API DirManager final
    void SaveBlockFile(BlockFile * f, wxTextFile * out);
 #endif
 
+   // When pDeferredCopies is non-null, plain whole-file copies are not done
+   // at once but appended to it as (source, destination) pairs, so the
+   // caller can run them in bulk on worker threads afterward
    std::pair<bool, FilePath>
-      LinkOrCopyToNewProjectDirectory(BlockFile *f, bool &link);
+      LinkOrCopyToNewProjectDirectory(BlockFile *f, bool &link,
+         std::vector<std::pair<FilePath, FilePath>> *pDeferredCopies = nullptr);
 
    bool EnsureSafeFilename(const wxFileName &fName);
 
@@ -196,6 +270,18 @@ class PROFILE_DLL_API DirManager final
       const wxString &msg,
       int flags = 0);
 
+   // Dependency checking support.  An index of the live aliased block
+   // files is maintained incrementally as block files are created and
+   // destroyed, so the common no-dependencies case is answered without
+   // walking every sequence.
+   bool HasAliasBlockFiles();
+
+   // Existence check for an aliased file.  Positive answers are cached,
+   // since a file that vanishes will fail loudly when read anyway;
+   // missing files are re-checked every time, so that restoring one to
+   // its original location is noticed by the next scan.
+   bool AliasedFileExists(const wxFileName &fileName);
+
    void FindMissingAliasFiles(
          BlockHash& missingAliasFilesAUFHash,     // output: (.auf) AliasBlockFiles whose aliased files are missing
          BlockHash& missingAliasFilesPathHash);   // output: full paths of missing aliased files
@@ -229,6 +315,15 @@ class PROFILE_DLL_API DirManager final
    // Write all write-cached block files to disc, if any
    void WriteCacheToDisk();
 
+   // Write-behind of freshly recorded block files:  a block staged in
+   // memory with deferred write is handed to a dedicated I/O thread, so
+   // filesystem latency stays off the capture path.  The queue is
+   // bounded; enqueueing may block briefly when the disk falls behind.
+   void EnqueueBlockWrite( const BlockFilePtr &blockFile );
+
+   // Wait until the write-behind queue has drained
+   void FinishBlockWrites();
+
    // (Try to) fill cache of blockfiles, if caching is enabled (otherwise do
    // nothing)
    // A no-fail operation that does not throw
@@ -238,8 +333,42 @@ class PROFILE_DLL_API DirManager final
 
    wxFileNameWrapper MakeBlockFileName();
    wxFileNameWrapper MakeBlockFilePath(const wxString &value);
-
-   BlockHash mBlockFileHash; // repository for blockfiles
+   // As MakeBlockFilePath, but never creates directories; thread-safe
+   wxFileNameWrapper BlockFilePathFor(const wxString &value) const;
+
+   // Adds the block file to the alias index if it is aliased
+   void RegisterAliasBlockFile(const wxString &key, const BlockFilePtr &b);
+   // Drops index entries for block files that have been destroyed
+   void PurgeDeadAliasBlockFiles();
+
+   BlockFileRegistry mBlockFiles; // repository for blockfiles
+
+   // Guards the alias index and existence cache below, which may see
+   // registrations from importer worker threads
+   std::mutex mAliasMutex;
+   // Subset of the registry: the live aliased block files
+   BlockHash mAliasBlockFileHash;
+   // Cached existence answers for aliased files, keyed by full path
+   std::unordered_map<wxString, bool> mAliasExistsCache;
+
+   // Guards the content-addressed index below, which importer worker
+   // threads consult and extend concurrently
+   std::mutex mContentMutex;
+   // Digest of raw sample bytes -> block files the project wrote with
+   // those samples.  A multimap, since distinct contents may share a
+   // digest; candidates are verified by reading them back.  Entries hold
+   // weak pointers and are dropped lazily when found dead.
+   std::unordered_multimap< wxUint64, std::weak_ptr<BlockFile> >
+      mContentHashIndex;
+
+   // Remembers, per foreign locked block file, the local copy this project
+   // already made of it, so that pasting the same clipboard contents again
+   // shares the first copy instead of duplicating the file once more.  The
+   // key is paired with a weak pointer to the same source block so a stale
+   // entry for a recycled address can be detected and dropped.
+   std::unordered_map< BlockFile *,
+      std::pair< std::weak_ptr<BlockFile>, std::weak_ptr<BlockFile> > >
+         mCopiedBlockFiles;
 
    // Hashes for management of the sub-directory tree of _data
    struct BalanceInfo
@@ -271,7 +400,11 @@ class PROFILE_DLL_API DirManager final
 
    size_t mMaxSamples; // max samples per block
 
+   // Lazily created I/O thread behind EnqueueBlockWrite
+   std::unique_ptr<class BlockWriteQueue> mBlockWriteQueue;
+
    unsigned long mLastBlockFileDestructionCount { 0 };
+   unsigned long mLastAliasIndexDestructionCount { 0 };
 
    static wxString globaltemp;
    wxString mytemp;
@@ -54,6 +54,15 @@ and get deterministic behaviour.
 
 #include <wx/defs.h>
 
+// The conversion loops below vectorize well by hand; SSE2 may be assumed
+// on all x86_64 targets.  (Runtime CPU dispatch as in RealFFTf48x.cpp is
+// still experimental and MSVC-only, so is not used here.)
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DITHER_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
 //////////////////////////////////////////////////////////////////////////
 
 // Constants for the noise shaping buffer
@@ -207,6 +216,59 @@ const float Dither::SHAPED_BS[] = { 2.033f, -2.165f, 1.959f, -1.590f, 0.6149f };
     } while (0)
 
 
+#ifdef DITHER_USE_SSE2
+// Vectorized equivalents of the DITHER_LOOP expansions for
+// DitherType::none, which keeps no feedback state between samples.
+// (Triangle and shaped dithering are recursive, so each sample depends
+// on the previous ones; those stay scalar.)
+
+static void NoDitherFloatToInt16(short *d, const float *s, unsigned int len)
+{
+    unsigned int i = 0;
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    const __m128 scale = _mm_set1_ps(CONVERT_DIV16);
+    for (; i + 8 <= len; i += 8, s += 8, d += 8)
+    {
+        __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(s), minusOne), one);
+        __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(s + 4), minusOne), one);
+        __m128i ia = _mm_cvtps_epi32(_mm_mul_ps(a, scale));
+        __m128i ib = _mm_cvtps_epi32(_mm_mul_ps(b, scale));
+        // Saturation in the pack performs the clamp to the int16 range
+        _mm_storeu_si128((__m128i*)d, _mm_packs_epi32(ia, ib));
+    }
+    for (; i < len; i++, s++, d++)
+    {
+        int x;
+        STORE_INT16(d, PROMOTE_TO_INT16(FROM_FLOAT(s)));
+    }
+}
+
+static void NoDitherFloatToInt24(int *d, const float *s, unsigned int len)
+{
+    unsigned int i = 0;
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    const __m128 scale = _mm_set1_ps(CONVERT_DIV24);
+    const __m128i max = _mm_set1_epi32(8388607);
+    for (; i + 4 <= len; i += 4, s += 4, d += 4)
+    {
+        __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(s), minusOne), one);
+        __m128i ia = _mm_cvtps_epi32(_mm_mul_ps(a, scale));
+        // After the clip only +1.0 converts above the int24 maximum, and
+        // SSE2 has no packed 32-bit min, so clamp with compare and blend
+        __m128i gt = _mm_cmpgt_epi32(ia, max);
+        ia = _mm_or_si128(_mm_and_si128(gt, max), _mm_andnot_si128(gt, ia));
+        _mm_storeu_si128((__m128i*)d, ia);
+    }
+    for (; i < len; i++, s++, d++)
+    {
+        int x;
+        STORE_INT24(d, PROMOTE_TO_INT24(FROM_FLOAT(s)));
+    }
+}
+#endif // DITHER_USE_SSE2
+
 Dither::Dither()
 {
     // On startup, initialize dither by resetting values
@@ -304,13 +366,42 @@ void Dither::Apply(enum DitherType ditherType,
         if (sourceFormat == int16Sample)
         {
             short* s = (short*)source;
-            for (i = 0; i < len; i++, d += destStride, s += sourceStride)
+            i = 0;
+#ifdef DITHER_USE_SSE2
+            if (destStride == 1 && sourceStride == 1)
+            {
+                const __m128 scale = _mm_set1_ps(1.0f / CONVERT_DIV16);
+                for (; i + 8 <= len; i += 8, s += 8, d += 8)
+                {
+                    // Duplicating each value into a 32-bit lane and
+                    // shifting arithmetically sign-extends it
+                    __m128i v = _mm_loadu_si128((const __m128i*)s);
+                    __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+                    __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+                    _mm_storeu_ps(d, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+                    _mm_storeu_ps(d + 4,
+                        _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+                }
+            }
+#endif
+            for (; i < len; i++, d += destStride, s += sourceStride)
                 *d = FROM_INT16(s);
         } else
         if (sourceFormat == int24Sample)
         {
             int* s = (int*)source;
-            for (i = 0; i < len; i++, d += destStride, s += sourceStride)
+            i = 0;
+#ifdef DITHER_USE_SSE2
+            if (destStride == 1 && sourceStride == 1)
+            {
+                const __m128 scale = _mm_set1_ps(1.0f / CONVERT_DIV24);
+                for (; i + 4 <= len; i += 4, s += 4, d += 4)
+                    _mm_storeu_ps(d, _mm_mul_ps(
+                        _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)s)),
+                        scale));
+            }
+#endif
+            for (; i < len; i++, d += destStride, s += sourceStride)
                 *d = FROM_INT24(s);
         } else {
             wxASSERT(false); // source format unknown
@@ -321,10 +412,37 @@ void Dither::Apply(enum DitherType ditherType,
         // Special case when promoting 16 bit to 24 bit
         int* d = (int*)dest;
         short* s = (short*)source;
-        for (i = 0; i < len; i++, d += destStride, s += sourceStride)
+        i = 0;
+#ifdef DITHER_USE_SSE2
+        if (destStride == 1 && sourceStride == 1)
+        {
+            for (; i + 4 <= len; i += 4, s += 4, d += 4)
+            {
+                __m128i v = _mm_loadl_epi64((const __m128i*)s);
+                __m128i w = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+                _mm_storeu_si128((__m128i*)d, _mm_slli_epi32(w, 8));
+            }
+        }
+#endif
+        for (; i < len; i++, d += destStride, s += sourceStride)
             *d = ((int)*s) << 8;
     } else
     {
+#ifdef DITHER_USE_SSE2
+        // DitherType::none adds no noise at all, so those conversions can
+        // go several samples at a time
+        if (ditherType == DitherType::none &&
+            destStride == 1 && sourceStride == 1 &&
+            sourceFormat == floatSample)
+        {
+            if (destFormat == int16Sample)
+                return NoDitherFloatToInt16(
+                    (short*)dest, (const float*)source, len);
+            if (destFormat == int24Sample)
+                return NoDitherFloatToInt24(
+                    (int*)dest, (const float*)source, len);
+        }
+#endif
         // We must do dithering
         switch (ditherType)
         {
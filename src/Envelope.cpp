@@ -310,14 +310,9 @@ bool Envelope::HandleXMLTag(const wxChar *tag, const wxChar **attrs)
    int numPoints = 0;
    long nValue = -1;
 
-   while (*attrs) {
-      const wxChar *attr = *attrs++;
-      const wxChar *value = *attrs++;
-      if (!value)
-         break;
-      const wxString strValue = value;
-      if( !wxStrcmp(attr, wxT("numpoints")) &&
-            XMLValueChecker::IsGoodInt(strValue) && strValue.ToLong(&nValue))
+   XMLAttributeCursor cursor{ attrs };
+   while (cursor.Next()) {
+      if( cursor.Is(wxT("numpoints")) && cursor.ToLong(nValue))
          numPoints = nValue;
    }
    if (numPoints < 0)
@@ -1035,6 +1030,32 @@ void Envelope::GetValuesRelative
          }
 
          buffer[b] = v;
+
+         // Run out the rest of this segment with the recurrence alone.
+         // While the next sample stays inside the segment, none of the
+         // before/after-envelope cases above can apply, so skip their
+         // tests; this leaves one comparison and one add or multiply
+         // per sample in the common case.
+         if (mDB) {
+            while (b + 1 < bufferLen) {
+               const auto tpl = t + tstep + increment;
+               if ( leftLimit ? tpl > tnext : tpl >= tnext )
+                  break;
+               ++b;
+               t += tstep;
+               buffer[b] = buffer[b - 1] * vstep;
+            }
+         }
+         else {
+            while (b + 1 < bufferLen) {
+               const auto tpl = t + tstep + increment;
+               if ( leftLimit ? tpl > tnext : tpl >= tnext )
+                  break;
+               ++b;
+               t += tstep;
+               buffer[b] = buffer[b - 1] + vstep;
+            }
+         }
       } else {
          if (mDB){
             buffer[b] = buffer[b - 1] * vstep;
@@ -1229,6 +1250,53 @@ double Envelope::Integral( double t0, double t1 ) const
    }
 }
 
+// Rebuild the memo table if the control points changed since it was last
+// built.  The caller must hold mIntegralCacheMutex.
+const std::vector<double> &Envelope::InverseIntegralTable() const
+{
+   const auto count = mEnv.size();
+   bool valid = mIntegralCacheDB == mDB &&
+      mIntegralCachePoints.size() == count;
+   for (size_t i = 0; valid && i < count; i++)
+      valid = mIntegralCachePoints[i].GetT() == mEnv[i].GetT() &&
+         mIntegralCachePoints[i].GetVal() == mEnv[i].GetVal();
+
+   if (!valid) {
+      mIntegralCachePoints = mEnv;
+      mIntegralCacheDB = mDB;
+      mInverseAreas.resize(count);
+      double total = 0.0;
+      if (count > 0)
+         mInverseAreas[0] = 0.0;
+      for (size_t i = 1; i < count; i++) {
+         total += IntegrateInverseInterpolated(
+            mEnv[i - 1].GetVal(), mEnv[i].GetVal(),
+            mEnv[i].GetT() - mEnv[i - 1].GetT(), mDB);
+         mInverseAreas[i] = total;
+      }
+   }
+
+   return mInverseAreas;
+}
+
+// Cumulative integral of the inverse from the first control point to
+// relative time t, which must not precede that point.  The caller must
+// hold mIntegralCacheMutex.
+double Envelope::AreaOfInverseTo(
+   const std::vector<double> &areas, double t ) const
+{
+   const auto count = mEnv.size();
+   if(t >= mEnv[count - 1].GetT()) // t at or following the last point
+      return areas[count - 1] +
+         (t - mEnv[count - 1].GetT()) / mEnv[count - 1].GetVal();
+
+   int lo, hi;
+   BinarySearchForTime(lo, hi, t);
+   double midVal = InterpolatePoints(mEnv[lo].GetVal(), mEnv[hi].GetVal(), (t - mEnv[lo].GetT()) / (mEnv[hi].GetT() - mEnv[lo].GetT()), mDB);
+   return areas[lo] + IntegrateInverseInterpolated(
+      mEnv[lo].GetVal(), midVal, t - mEnv[lo].GetT(), mDB);
+}
+
 double Envelope::IntegralOfInverse( double t0, double t1 ) const
 {
    if(t0 == t1)
@@ -1245,51 +1313,25 @@ double Envelope::IntegralOfInverse( double t0, double t1 ) const
    t0 -= mOffset;
    t1 -= mOffset;
 
-   double total = 0.0, lastT, lastVal;
-   unsigned int i; // this is the next point to check
+   double total = 0.0;
    if(t0 < mEnv[0].GetT()) // t0 preceding the first point
    {
       if(t1 <= mEnv[0].GetT())
          return (t1 - t0) / mEnv[0].GetVal();
-      i = 1;
-      lastT = mEnv[0].GetT();
-      lastVal = mEnv[0].GetVal();
-      total += (lastT - t0) / lastVal;
+      total += (mEnv[0].GetT() - t0) / mEnv[0].GetVal();
+      t0 = mEnv[0].GetT();
    }
    else if(t0 >= mEnv[count - 1].GetT()) // t0 at or following the last point
    {
       return (t1 - t0) / mEnv[count - 1].GetVal();
    }
-   else // t0 enclosed by points
-   {
-      // Skip any points that come before t0 using binary search
-      int lo, hi;
-      BinarySearchForTime(lo, hi, t0);
-      lastVal = InterpolatePoints(mEnv[lo].GetVal(), mEnv[hi].GetVal(), (t0 - mEnv[lo].GetT()) / (mEnv[hi].GetT() - mEnv[lo].GetT()), mDB);
-      lastT = t0;
-      i = hi; // the point immediately after t0.
-   }
 
-   // loop through the rest of the envelope points until we get to t1
-   while (1)
-   {
-      if(i >= count) // the requested range extends beyond the last point
-      {
-         return total + (t1 - lastT) / lastVal;
-      }
-      else if(mEnv[i].GetT() >= t1) // this point follows the end of the range
-      {
-         double thisVal = InterpolatePoints(mEnv[i - 1].GetVal(), mEnv[i].GetVal(), (t1 - mEnv[i - 1].GetT()) / (mEnv[i].GetT() - mEnv[i - 1].GetT()), mDB);
-         return total + IntegrateInverseInterpolated(lastVal, thisVal, t1 - lastT, mDB);
-      }
-      else // this point precedes the end of the range
-      {
-         total += IntegrateInverseInterpolated(lastVal, mEnv[i].GetVal(), mEnv[i].GetT() - lastT, mDB);
-         lastT = mEnv[i].GetT();
-         lastVal = mEnv[i].GetVal();
-         i++;
-      }
-   }
+   // Both ends now lie at or after the first point.  Instead of walking
+   // every point between them, difference two prefix sums from the memo
+   // table.
+   std::lock_guard<std::mutex> guard{ mIntegralCacheMutex };
+   const std::vector<double> &areas = InverseIntegralTable();
+   return total + AreaOfInverseTo(areas, t1) - AreaOfInverseTo(areas, t0);
 }
 
 double Envelope::SolveIntegralOfInverse( double t0, double area ) const
@@ -1305,93 +1347,33 @@ double Envelope::SolveIntegralOfInverse( double t0, double area ) const
    t0 -= mOffset;
    return mOffset + [&] {
       // Now we can safely assume t0 is relative time!
-      double lastT, lastVal;
-      int i; // this is the next point to check
+      std::lock_guard<std::mutex> guard{ mIntegralCacheMutex };
+      const std::vector<double> &areas = InverseIntegralTable();
+
+      // Work in cumulative area coordinates from the memo table: find
+      // where t0 falls on that scale, move by area, and map back to time.
+      // Times left of the first point or right of the last extend the
+      // scale linearly at the boundary value.
+      double target;
       if(t0 < mEnv[0].GetT()) // t0 preceding the first point
-      {
-         if (area < 0) {
-            return t0 + area * mEnv[0].GetVal();
-         }
-         else {
-            i = 1;
-            lastT = mEnv[0].GetT();
-            lastVal = mEnv[0].GetVal();
-            double added = (lastT - t0) / lastVal;
-            if(added >= area)
-               return t0 + area * mEnv[0].GetVal();
-            area -= added;
-         }
-      }
-      else if(t0 >= mEnv[count - 1].GetT()) // t0 at or following the last point
-      {
-         if (area < 0) {
-            i = (int)count - 2;
-            lastT = mEnv[count - 1].GetT();
-            lastVal = mEnv[count - 1].GetVal();
-            double added = (lastT - t0) / lastVal; // negative
-            if(added <= area)
-               return t0 + area * mEnv[count - 1].GetVal();
-            area -= added;
-         }
-         else {
-            return t0 + area * mEnv[count - 1].GetVal();
-         }
-      }
-      else // t0 enclosed by points
-      {
-         // Skip any points that come before t0 using binary search
-         int lo, hi;
-         BinarySearchForTime(lo, hi, t0);
-         lastVal = InterpolatePoints(mEnv[lo].GetVal(), mEnv[hi].GetVal(), (t0 - mEnv[lo].GetT()) / (mEnv[hi].GetT() - mEnv[lo].GetT()), mDB);
-         lastT = t0;
-         if (area < 0)
-            i = lo;
-         else
-            i = hi; // the point immediately after t0.
-      }
-
-      if (area < 0) {
-         // loop BACKWARDS through the rest of the envelope points until we get to t1
-         // (which is less than t0)
-         while (1)
-         {
-            if(i < 0) // the requested range extends beyond the leftmost point
-            {
-               return lastT + area * lastVal;
-            }
-            else
-            {
-               double added =
-                  -IntegrateInverseInterpolated(mEnv[i].GetVal(), lastVal, lastT - mEnv[i].GetT(), mDB);
-               if(added <= area)
-                  return lastT - SolveIntegrateInverseInterpolated(lastVal, mEnv[i].GetVal(), lastT - mEnv[i].GetT(), -area, mDB);
-               area -= added;
-               lastT = mEnv[i].GetT();
-               lastVal = mEnv[i].GetVal();
-               --i;
-            }
-         }
-      }
-      else {
-         // loop through the rest of the envelope points until we get to t1
-         while (1)
-         {
-            if(i >= (int)count) // the requested range extends beyond the last point
-            {
-               return lastT + area * lastVal;
-            }
-            else
-            {
-               double added = IntegrateInverseInterpolated(lastVal, mEnv[i].GetVal(), mEnv[i].GetT() - lastT, mDB);
-               if(added >= area)
-                  return lastT + SolveIntegrateInverseInterpolated(lastVal, mEnv[i].GetVal(), mEnv[i].GetT() - lastT, area, mDB);
-               area -= added;
-               lastT = mEnv[i].GetT();
-               lastVal = mEnv[i].GetVal();
-               i++;
-            }
-         }
-      }
+         target = (t0 - mEnv[0].GetT()) / mEnv[0].GetVal() + area;
+      else
+         target = AreaOfInverseTo(areas, t0) + area;
+
+      if(target <= 0.0) // the answer precedes the first point
+         return mEnv[0].GetT() + target * mEnv[0].GetVal();
+      if(target >= areas[count - 1]) // the answer follows the last point
+         return mEnv[count - 1].GetT() +
+            (target - areas[count - 1]) * mEnv[count - 1].GetVal();
+
+      // Binary search for the segment containing the target area; the
+      // areas of zero-length segments repeat and are skipped over.
+      const auto it = std::upper_bound(areas.begin(), areas.end(), target);
+      const size_t i = (it - areas.begin()) - 1; // areas[i] <= target < areas[i + 1]
+      return mEnv[i].GetT() + SolveIntegrateInverseInterpolated(
+         mEnv[i].GetVal(), mEnv[i + 1].GetVal(),
+         mEnv[i + 1].GetT() - mEnv[i].GetT(),
+         target - areas[i], mDB);
    }();
 }
 
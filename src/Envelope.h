@@ -13,6 +13,7 @@
 
 #include <stdlib.h>
 #include <algorithm>
+#include <mutex>
 #include <vector>
 
 #include "xml/XMLTagHandler.h"
@@ -41,13 +42,15 @@ public:
    bool HandleXMLTag(const wxChar *tag, const wxChar **attrs) override
    {
       if (!wxStrcmp(tag, wxT("controlpoint"))) {
-         while (*attrs) {
-            const wxChar *attr = *attrs++;
-            const wxChar *value = *attrs++;
-            if (!wxStrcmp(attr, wxT("t")))
-               SetT(Internat::CompatibleToDouble(value));
-            else if (!wxStrcmp(attr, wxT("val")))
-               SetVal( nullptr, Internat::CompatibleToDouble(value) );
+         XMLAttributeCursor cursor{ attrs };
+         while (cursor.Next()) {
+            // As with Internat::CompatibleToDouble, an unparseable
+            // value reads as zero
+            double dblValue;
+            if (cursor.Is(wxT("t")))
+               SetT(cursor.ToDouble(dblValue) ? dblValue : 0.0);
+            else if (cursor.Is(wxT("val")))
+               SetVal( nullptr, cursor.ToDouble(dblValue) ? dblValue : 0.0 );
          }
          return true;
       }
@@ -102,6 +105,11 @@ public:
    bool GetExponential() const { return mDB; }
    void SetExponential(bool db) { mDB = db; }
 
+   // True when the envelope was never edited and evaluates to unity gain
+   // everywhere, so consumers may skip evaluation and multiplication
+   bool IsTrivial() const
+      { return mEnv.empty() && mDefaultValue == 1.0; }
+
    void Flatten(double value);
 
    double GetMinValue() const { return mMinValue; }
@@ -268,6 +276,20 @@ private:
    int mDragPoint { -1 };
 
    mutable int mSearchGuess { -2 };
+
+   // Memo for IntegralOfInverse and SolveIntegralOfInverse, which the
+   // mixer, ruler drawing and scrubbing all call repeatedly with the same
+   // control points when a TimeTrack warps playback: mInverseAreas[i] is
+   // the integral of the inverse from the first point to point i.  The
+   // table keeps a copy of its inputs and compares, so a stale table is
+   // detected without every mutator having to invalidate it.  The mutex
+   // serializes the audio and main threads over the rebuild.
+   const std::vector<double> &InverseIntegralTable() const;
+   double AreaOfInverseTo( const std::vector<double> &areas, double t ) const;
+   mutable EnvArray mIntegralCachePoints;
+   mutable std::vector<double> mInverseAreas;
+   mutable bool mIntegralCacheDB { false };
+   mutable std::mutex mIntegralCacheMutex;
 };
 
 inline void EnvPoint::SetVal( Envelope *pEnvelope, double val )
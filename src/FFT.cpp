@@ -54,12 +54,18 @@
 
 #include "RealFFTf.h"
 
+// The elementwise kernels below have SSE2 forms; SSE2 may be assumed on
+// all x86_64 targets.  (Runtime CPU dispatch as in RealFFTf48x.cpp is
+// still experimental and MSVC-only, so is not used here.)
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FFT_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
 static ArraysOf<int> gFFTBitTable;
 static const size_t MaxFastBits = 16;
 
-/* Declare Static functions */
-static void InitFFT();
-
 static bool IsPowerOfTwo(size_t x)
 {
    if (x < 2)
@@ -99,6 +105,9 @@ int ReverseBits(size_t index, size_t NumBits)
 
 void InitFFT()
 {
+   if (gFFTBitTable)
+      return;
+
    gFFTBitTable.reinit(MaxFastBits);
 
    size_t len = 2;
@@ -117,6 +126,45 @@ void DeinitFFT()
    gFFTBitTable.reset();
 }
 
+void ApplyWindowTo(float *out, const float *window, const float *in, size_t len)
+{
+   size_t i = 0;
+#ifdef FFT_USE_SSE2
+   for (; i + 4 <= len; i += 4)
+      _mm_storeu_ps(out + i,
+         _mm_mul_ps(_mm_loadu_ps(window + i), _mm_loadu_ps(in + i)));
+#endif
+   for (; i < len; i++)
+      out[i] = window[i] * in[i];
+}
+
+void SquaredMagnitudes(float *out, const float *re, const float *im, size_t len)
+{
+   size_t i = 0;
+#ifdef FFT_USE_SSE2
+   for (; i + 4 <= len; i += 4) {
+      const __m128 r = _mm_loadu_ps(re + i);
+      const __m128 j = _mm_loadu_ps(im + i);
+      _mm_storeu_ps(out + i,
+         _mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(j, j)));
+   }
+#endif
+   for (; i < len; i++)
+      out[i] = (re[i] * re[i]) + (im[i] * im[i]);
+}
+
+void AccumulateSamples(float *acc, const float *in, size_t len)
+{
+   size_t i = 0;
+#ifdef FFT_USE_SSE2
+   for (; i + 4 <= len; i += 4)
+      _mm_storeu_ps(acc + i,
+         _mm_add_ps(_mm_loadu_ps(acc + i), _mm_loadu_ps(in + i)));
+#endif
+   for (; i < len; i++)
+      acc[i] += in[i];
+}
+
 static inline size_t FastReverseBits(size_t i, size_t NumBits)
 {
    if (NumBits <= MaxFastBits)
@@ -134,6 +134,21 @@ void NewWindowFunc(int whichFunction, size_t NumSamples, bool extraSample, float
  */
 void DerivativeOfWindowFunc(int whichFunction, size_t NumSamples, bool extraSample, float *data);
 
+/*
+ * Elementwise kernels for the hop loops of spectral analysis
+ * (Spectrum.cpp and SpectrumAnalyst), vectorized where the compiler
+ * targets SSE2.  Output may not overlap the inputs.
+ */
+
+/* out[i] = window[i] * in[i] */
+void ApplyWindowTo(float *out, const float *window, const float *in, size_t len);
+
+/* out[i] = re[i]^2 + im[i]^2 */
+void SquaredMagnitudes(float *out, const float *re, const float *im, size_t len);
+
+/* acc[i] += in[i] */
+void AccumulateSamples(float *acc, const float *in, size_t len);
+
 /*
  * Returns the name of the windowing function (for UI display)
  */
@@ -146,6 +161,11 @@ const wxChar *WindowFuncName(int whichFunction);
 
 int NumWindowFuncs();
 
+// Ensure the shared lookup tables exist.  The FFT routines build them
+// lazily on first use; a thread about to use the routines concurrently
+// with others should call this first to avoid racing that initialization.
+void InitFFT();
+
 void DeinitFFT();
 
 #endif
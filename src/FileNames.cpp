@@ -47,8 +47,57 @@ used throughout Audacity into this one place.
 #include <windows.h>
 #endif
 
+#if defined(__WXMAC__)
+#include <AvailabilityMacros.h>
+#if defined(MAC_OS_X_VERSION_10_12) && \
+    MAC_OS_X_VERSION_MAX_ALLOWED >= MAC_OS_X_VERSION_10_12
+#include <sys/clonefile.h>
+#define HAVE_CLONEFILE
+#endif
+#endif
+
+#if defined(__linux__)
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#ifdef __has_include
+#if __has_include(<linux/fs.h>)
+#include <linux/fs.h> // for FICLONE
+#endif
+#endif
+#endif
+
 static wxString gDataDir;
 
+#if defined(__linux__)
+// Try to duplicate the already-opened source into the freshly created
+// destination without moving the bytes through user space:  first a
+// reflink, which shares the storage and completes in one metadata
+// operation on btrfs/XFS, then copy_file_range, which stays in the kernel
+// and becomes a server-side copy on network filesystems.  Returns false,
+// leaving the destination empty, when the filesystem supports neither.
+static bool TryKernelCopy(int srcFd, int dstFd, wxFileOffset length)
+{
+#ifdef FICLONE
+   if (ioctl(dstFd, FICLONE, srcFd) == 0)
+      return true;
+#endif
+#ifdef __NR_copy_file_range
+   wxFileOffset copied = 0;
+   while (copied < length) {
+      const auto result = syscall(__NR_copy_file_range,
+         srcFd, nullptr, dstFd, nullptr, (size_t)(length - copied), 0u);
+      if (result <= 0)
+         break;
+      copied += result;
+   }
+   if (copied == length)
+      return true;
+#endif
+   return false;
+}
+#endif
+
 bool FileNames::CopyFile(
    const FilePath& file1, const FilePath& file2, bool overwrite)
 {
@@ -66,6 +115,30 @@ bool FileNames::CopyFile(
    // 0597e7f977c87d107e24bf3e95ebfa3d60efc249 of wxWidgets repo
 
    bool existed = wxFileExists(file2);
+   if (existed && !overwrite)
+      return false;
+
+#if defined(HAVE_CLONEFILE)
+   // On APFS this shares the file's storage and completes in one metadata
+   // operation, no matter the size
+   if (!existed && ::clonefile(OSFILENAME(file1), OSFILENAME(file2), 0) == 0)
+      return true;
+#elif defined(__linux__)
+   {
+      wxFile src{ file1 };
+      if (src.IsOpened()) {
+         const auto length = src.Length();
+         wxFile dst;
+         if (dst.Create(file2, true) && TryKernelCopy(src.fd(), dst.fd(), length))
+            return true;
+         // Leave no partial or truncated destination for the fallback
+         dst.Close();
+         if (!existed && wxFileExists(file2))
+            wxRemoveFile(file2);
+      }
+   }
+#endif
+
    bool result = wxCopyFile(file1, file2, overwrite) &&
       wxFile{ file1 }.Length() == wxFile{ file2 }.Length();
    if (!result && !existed)
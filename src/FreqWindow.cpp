@@ -541,6 +541,7 @@ FreqWindow::FreqWindow(wxWindow * parent, wxWindowID id,
 
 FreqWindow::~FreqWindow()
 {
+   StopAnalysis();
 }
 
 void FreqWindow::OnGetURL(wxCommandEvent & WXUNUSED(event))
@@ -565,8 +566,8 @@ bool FreqWindow::Show(bool show)
       if(dBRange < 90.)
          dBRange = 90.;
       GetAudio();
-      // Don't send an event.  We need the recalc right away.
-      // so that mAnalyst is valid when we paint.
+      // Don't send an event.  We want the recalculation underway
+      // right away.
       //SendRecalcEvent();
       Recalc();
    }
@@ -578,6 +579,9 @@ bool FreqWindow::Show(bool show)
 
 void FreqWindow::GetAudio()
 {
+   // The worker reads mData; it must be gone before the buffer is
+   StopAnalysis();
+
    mData.reset();
    mDataLen = 0;
 
@@ -610,12 +614,19 @@ void FreqWindow::GetAudio()
             return;
          }
          auto start = track->TimeToLongSamples(selectedRegion.t0());
-         Floats buffer2{ mDataLen };
-         // Again, stop exceptions
-         track->Get((samplePtr)buffer2.get(), floatSample, start, mDataLen,
-                    fillZero, false);
-         for (size_t i = 0; i < mDataLen; i++)
-            mData[i] += buffer2[i];
+         // Sum in modest pieces rather than duplicating the whole
+         // selection in a second buffer
+         const size_t blockLen = 65536;
+         Floats buffer2{ blockLen };
+         for (size_t pos = 0; pos < mDataLen;) {
+            const auto len = std::min(blockLen, mDataLen - pos);
+            // Again, stop exceptions
+            track->Get((samplePtr)buffer2.get(), floatSample, start + pos,
+                       len, fillZero, false);
+            for (size_t i = 0; i < len; i++)
+               mData[pos + i] += buffer2[i];
+            pos += len;
+         }
       }
       selcount++;
    }
@@ -1005,6 +1016,8 @@ void FreqWindow::SendRecalcEvent()
 
 void FreqWindow::Recalc()
 {
+   StopAnalysis();
+
    if (!mData || mDataLen < mWindowSize) {
       DrawPlot();
       return;
@@ -1014,24 +1027,58 @@ void FreqWindow::Recalc()
       SpectrumAnalyst::Algorithm(mAlgChoice->GetSelection());
    int windowFunc = mFuncChoice->GetSelection();
 
-   wxWindow *hadFocus = FindFocus();
-   // In wxMac, the skipped window MUST be a top level window.  I'd originally made it
-   // just the mProgress window with the idea of preventing user interaction with the
-   // controls while the plot was being recalculated.  This doesn't appear to be necessary
-   // so just use the the top level window instead.
-   {
-      Maybe<wxWindowDisabler> blocker;
-      if (IsShown())
-         blocker.create(this);
-      wxYieldIfNeeded();
-
-      mAnalyst->Calculate(alg, windowFunc, mWindowSize, mRate,
-         mData.get(), mDataLen,
-         &mYMin, &mYMax, mProgress);
-   }
-   if (hadFocus) {
-      hadFocus->SetFocus();
-   }
+   // Analyze on a worker thread, periodically handing copies of the
+   // running average back to this thread, so that a long selection
+   // refines the plot progressively instead of freezing the app.
+   const float *data = mData.get();
+   const size_t dataLen = mDataLen;
+   const size_t windowSize = mWindowSize;
+   const double rate = mRate;
+   const unsigned gen = ++mAnalysisGen;
+
+   // The FFT routines initialize shared tables lazily; make sure that
+   // happens before another thread uses them
+   InitFFT();
+
+   mProgress->SetRange(dataLen);
+   mAbortAnalysis.store(false);
+   mAnalysisThread = std::thread( [=] {
+      SpectrumAnalyst analyst;
+      if (!analyst.Start(alg, windowFunc, windowSize, rate))
+         return;
+      // Batches big enough that copying partial results for display
+      // costs little next to the transforms themselves
+      const size_t batch = std::max<size_t>(windowSize, 1048576);
+      size_t pos = 0;
+      while (pos < dataLen && !mAbortAnalysis.load()) {
+         const auto len = std::min(batch, dataLen - pos);
+         analyst.Process(data + pos, len);
+         pos += len;
+         auto partial = std::make_shared<SpectrumAnalyst>(analyst);
+         const auto soFar = pos;
+         CallAfter( [=] {
+            // Results of a superseded analysis may still be queued; drop them
+            if (gen != mAnalysisGen)
+               return;
+            float yMin, yMax;
+            if (partial->Finish(&yMin, &yMax)) {
+               *mAnalyst = std::move(*partial);
+               FinishRecalc(alg, yMin, yMax);
+            }
+            if (soFar >= dataLen)
+               mProgress->Reset();
+            else
+               mProgress->SetValue(soFar);
+         } );
+      }
+   } );
+}
+
+void FreqWindow::FinishRecalc(
+   SpectrumAnalyst::Algorithm alg, float yMin, float yMax)
+{
+   mYMin = yMin;
+   mYMax = yMax;
 
    if (alg == SpectrumAnalyst::Spectrum) {
       if(mYMin < -dBRange)
@@ -1048,6 +1095,13 @@ void FreqWindow::Recalc()
    DrawPlot();
 }
 
+void FreqWindow::StopAnalysis()
+{
+   mAbortAnalysis.store(true);
+   if (mAnalysisThread.joinable())
+      mAnalysisThread.join();
+}
+
 void FreqWindow::OnExport(wxCommandEvent & WXUNUSED(event))
 {
    wxString fName = _("spectrum.txt");
@@ -1207,11 +1261,45 @@ bool SpectrumAnalyst::Calculate(Algorithm alg, int windowFunc,
                                 const float *data, size_t dataLen,
                                 float *pYMin, float *pYMax,
                                 FreqGauge *progress)
+{
+   if (!Start(alg, windowFunc, windowSize, rate))
+      return false;
+
+   if (progress) {
+      progress->SetRange(dataLen);
+   }
+
+   // Feed the data through in pieces, just to drive the progress gauge
+   const size_t chunk = std::max<size_t>(windowSize, 65536);
+   size_t pos = 0;
+   while (pos < dataLen) {
+      const auto len = std::min(chunk, dataLen - pos);
+      Process(data + pos, len);
+      pos += len;
+      if (progress) {
+         progress->SetValue(pos);
+      }
+   }
+
+   if (progress) {
+      // Reset for next time
+      progress->Reset();
+   }
+
+   return Finish(pYMin, pYMax);
+}
+
+bool SpectrumAnalyst::Start(Algorithm alg, int windowFunc,
+                            size_t windowSize, double rate)
 {
    // Wipe old data
    mProcessed.resize(0);
    mRate = 0.0;
    mWindowSize = 0;
+   mWindow.resize(0);
+   mPending.resize(0);
+   mWss = 1.0;
+   mWindows = 0;
 
    // Validate inputs
    int f = NumWindowFuncs();
@@ -1223,56 +1311,60 @@ bool SpectrumAnalyst::Calculate(Algorithm alg, int windowFunc,
       return false;
    }
 
-   if (dataLen < windowSize) {
-      return false;
-   }
-
    // Now repopulate
    mRate = rate;
    mWindowSize = windowSize;
    mAlg = alg;
 
-   auto half = mWindowSize / 2;
    mProcessed.resize(mWindowSize);
-
-   Floats in{ mWindowSize };
-   Floats out{ mWindowSize };
-   Floats out2{ mWindowSize };
-   Floats win{ mWindowSize };
+   mWindow.resize(mWindowSize);
 
    for (size_t i = 0; i < mWindowSize; i++) {
       mProcessed[i] = 0.0f;
-      win[i] = 1.0f;
+      mWindow[i] = 1.0f;
    }
 
-   WindowFunc(windowFunc, mWindowSize, win.get());
+   WindowFunc(windowFunc, mWindowSize, mWindow.data());
 
    // Scale window such that an amplitude of 1.0 in the time domain
    // shows an amplitude of 0dB in the frequency domain
    double wss = 0;
    for (size_t i = 0; i<mWindowSize; i++)
-      wss += win[i];
+      wss += mWindow[i];
    if(wss > 0)
       wss = 4.0 / (wss*wss);
    else
       wss = 1.0;
+   mWss = wss;
 
-   if (progress) {
-      progress->SetRange(dataLen);
-   }
+   return true;
+}
+
+void SpectrumAnalyst::Process(const float *data, size_t dataLen)
+{
+   if (mWindowSize == 0)
+      return;
+
+   mPending.insert(mPending.end(), data, data + dataLen);
+   if (mPending.size() < mWindowSize)
+      return;
+
+   const Algorithm alg = mAlg;
+   auto half = mWindowSize / 2;
+
+   Floats in{ mWindowSize };
+   Floats out{ mWindowSize };
+   Floats out2{ mWindowSize };
 
    size_t start = 0;
-   int windows = 0;
-   while (start + mWindowSize <= dataLen) {
-      for (size_t i = 0; i < mWindowSize; i++)
-         in[i] = win[i] * data[start + i];
+   while (start + mWindowSize <= mPending.size()) {
+      ApplyWindowTo(in.get(), mWindow.data(), &mPending[start], mWindowSize);
 
       switch (alg) {
          case Spectrum:
             PowerSpectrum(mWindowSize, in.get(), out.get());
 
-            for (size_t i = 0; i < half; i++)
-               mProcessed[i] += out[i];
+            AccumulateSamples(&mProcessed[0], out.get(), half);
             break;
 
          case Autocorrelation:
@@ -1282,8 +1374,7 @@ bool SpectrumAnalyst::Calculate(Algorithm alg, int windowFunc,
             // Take FFT
             RealFFT(mWindowSize, in.get(), out.get(), out2.get());
             // Compute power
-            for (size_t i = 0; i < mWindowSize; i++)
-               in[i] = (out[i] * out[i]) + (out2[i] * out2[i]);
+            SquaredMagnitudes(in.get(), out.get(), out2.get(), mWindowSize);
 
             if (alg == Autocorrelation) {
                for (size_t i = 0; i < mWindowSize; i++)
@@ -1301,8 +1392,7 @@ bool SpectrumAnalyst::Calculate(Algorithm alg, int windowFunc,
             RealFFT(mWindowSize, in.get(), out.get(), out2.get());
 
             // Take real part of result
-            for (size_t i = 0; i < half; i++)
-               mProcessed[i] += out[i];
+            AccumulateSamples(&mProcessed[0], out.get(), half);
             break;
 
          case Cepstrum:
@@ -1325,8 +1415,7 @@ bool SpectrumAnalyst::Calculate(Algorithm alg, int windowFunc,
                InverseRealFFT(mWindowSize, in.get(), NULL, out.get());
 
                // Take real part of result
-               for (size_t i = 0; i < half; i++)
-                  mProcessed[i] += out[i];
+               AccumulateSamples(&mProcessed[0], out.get(), half);
             }
 
             break;
@@ -1336,20 +1425,32 @@ bool SpectrumAnalyst::Calculate(Algorithm alg, int windowFunc,
             break;
       }                         //switch
 
-      // Update the progress bar
-      if (progress) {
-         progress->SetValue(start);
-      }
-
       start += half;
-      windows++;
+      mWindows++;
    }
 
-   if (progress) {
-      // Reset for next time
-      progress->Reset();
+   // Keep unconsumed samples for the next call
+   mPending.erase(mPending.begin(), mPending.begin() + start);
+}
+
+bool SpectrumAnalyst::Finish(float *pYMin, float *pYMax)
+{
+   mPending.resize(0);
+
+   if (mWindows == 0) {
+      // Not even one whole window of samples was supplied
+      mProcessed.resize(0);
+      mRate = 0.0;
+      mWindowSize = 0;
+      return false;
    }
 
+   const Algorithm alg = mAlg;
+   auto half = mWindowSize / 2;
+   const int windows = mWindows;
+
+   Floats out{ mWindowSize };
+
    float mYMin = 1000000, mYMax = -1000000;
    double scale;
    switch (alg) {
@@ -1357,7 +1458,7 @@ bool SpectrumAnalyst::Calculate(Algorithm alg, int windowFunc,
       // Convert to decibels
       mYMin = 1000000.;
       mYMax = -1000000.;
-      scale = wss / (double)windows;
+      scale = mWss / (double)windows;
       for (size_t i = 0; i < half; i++)
       {
          mProcessed[i] = 10 * log10(mProcessed[i] * scale);
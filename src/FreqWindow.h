@@ -11,6 +11,8 @@
 #ifndef __AUDACITY_FREQ_WINDOW__
 #define __AUDACITY_FREQ_WINDOW__
 
+#include <atomic>
+#include <thread>
 #include <vector>
 #include <wx/font.h> // member variable
 #include <wx/statusbr.h> // to inherit
@@ -57,6 +59,15 @@ public:
       float *pYMin = NULL, float *pYMax = NULL, // outputs
       FreqGauge *progress = NULL);
 
+   // Incremental variant of Calculate: call Start once, then Process
+   // over consecutive pieces of the data, then Finish.  A copy of the
+   // object may be taken between Process calls and Finished separately,
+   // giving a partial result while the original goes on accumulating.
+   bool Start(Algorithm alg,
+      int windowFunc, size_t windowSize, double rate);
+   void Process(const float *data, size_t dataLen);
+   bool Finish(float *pYMin = NULL, float *pYMax = NULL);
+
    const float *GetProcessed() const;
    int GetProcessedSize() const;
 
@@ -72,6 +83,11 @@ private:
    double mRate;
    size_t mWindowSize;
    std::vector<float> mProcessed;
+
+   std::vector<float> mWindow;  // windowing function, computed by Start
+   std::vector<float> mPending; // samples not yet consumed by a whole window
+   double mWss { 1.0 };         // window scaling for the power spectrum
+   int mWindows { 0 };          // count of windows accumulated so far
 };
 
 class FreqGauge final : public wxStatusBar
@@ -145,6 +161,8 @@ private:
 
    void SendRecalcEvent();
    void Recalc();
+   void FinishRecalc(SpectrumAnalyst::Algorithm alg, float yMin, float yMax);
+   void StopAnalysis();
    void DrawPlot();
    void DrawBackground(wxMemoryDC & dc);
 
@@ -206,6 +224,12 @@ private:
 
    std::unique_ptr<SpectrumAnalyst> mAnalyst;
 
+   // Background analysis; partial results arrive on the main thread via
+   // CallAfter, and the generation count lets superseded ones be ignored
+   std::thread mAnalysisThread;
+   std::atomic<bool> mAbortAnalysis{ false };
+   unsigned mAnalysisGen{ 0 };
+
    DECLARE_EVENT_TABLE()
 
    friend class FreqPlot;
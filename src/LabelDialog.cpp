@@ -20,6 +20,7 @@
 #include <wx/defs.h>
 #include <wx/choice.h>
 #include <wx/dc.h>
+#include <wx/dcclient.h>
 #include <wx/dialog.h>
 #include <wx/filedlg.h>
 #include <wx/grid.h>
@@ -70,6 +71,141 @@ class RowData
    SelectedRegion selectedRegion;
 };
 
+// A virtual grid table over the dialog's row store.  The grid asks for
+// cell values only as rows scroll into view, so opening the dialog no
+// longer materializes a grid row per label up front.
+class LabelDialogTable final : public wxGridTableBase
+{
+ public:
+   explicit LabelDialogTable(LabelDialog *dialog)
+      : mDialog(dialog)
+   {}
+
+   int GetNumberRows() override
+   {
+      return mDialog->mData.size();
+   }
+
+   int GetNumberCols() override
+   {
+      return Col_Max;
+   }
+
+   bool IsEmptyCell(int WXUNUSED(row), int WXUNUSED(col)) override
+   {
+      return false;
+   }
+
+   wxString GetValue(int row, int col) override
+   {
+      if (row < 0 || row >= (int) mDialog->mData.size())
+         return wxEmptyString;
+
+      RowData &rd = mDialog->mData[row];
+
+      switch (col)
+      {
+         case Col_Track:
+            // A just-edited track cell keeps the chosen string until the
+            // dialog's change handler resolves it, because "New..." only
+            // becomes a real track after the user supplies a name
+            if (row == mPendingRow)
+               return mPendingTrackName;
+            return mDialog->TrackName(rd.index);
+
+         case Col_Label:
+            return rd.title;
+
+         case Col_Stime:
+            return wxString::Format(wxT("%g"), rd.selectedRegion.t0());
+
+         case Col_Etime:
+            return wxString::Format(wxT("%g"), rd.selectedRegion.t1());
+
+         case Col_Lfreq:
+            return wxString::Format(wxT("%g"), rd.selectedRegion.f0());
+
+         case Col_Hfreq:
+            return wxString::Format(wxT("%g"), rd.selectedRegion.f1());
+      }
+
+      return wxEmptyString;
+   }
+
+   void SetValue(int row, int col, const wxString &value) override
+   {
+      if (row < 0 || row >= (int) mDialog->mData.size())
+         return;
+
+      RowData &rd = mDialog->mData[row];
+      double d;
+
+      switch (col)
+      {
+         case Col_Track:
+            mPendingRow = row;
+            mPendingTrackName = value;
+         break;
+
+         case Col_Label:
+            rd.title = value;
+         break;
+
+         case Col_Stime:
+            if (value.ToDouble(&d))
+               rd.selectedRegion.setT0(d, false);
+         break;
+
+         case Col_Etime:
+            if (value.ToDouble(&d))
+               rd.selectedRegion.setT1(d, false);
+         break;
+
+         case Col_Lfreq:
+            if (value.ToDouble(&d))
+               rd.selectedRegion.setF0(d, false);
+         break;
+
+         case Col_Hfreq:
+            if (value.ToDouble(&d))
+               rd.selectedRegion.setF1(d, false);
+         break;
+      }
+   }
+
+   wxString GetColLabelValue(int col) override
+   {
+      switch (col)
+      {
+         /* i18n-hint: (noun).  A track contains waves, audio etc.*/
+         case Col_Track: return _("Track");
+         /* i18n-hint: (noun)*/
+         case Col_Label: return _("Label");
+         /* i18n-hint: (noun) of a label*/
+         case Col_Stime: return _("Start Time");
+         /* i18n-hint: (noun) of a label*/
+         case Col_Etime: return _("End Time");
+         /* i18n-hint: (noun) of a label*/
+         case Col_Lfreq: return _("Low Frequency");
+         /* i18n-hint: (noun) of a label*/
+         case Col_Hfreq: return _("High Frequency");
+      }
+
+      return wxEmptyString;
+   }
+
+   void ClearPendingTrackCell()
+   {
+      mPendingRow = -1;
+      mPendingTrackName.clear();
+   }
+
+ private:
+   LabelDialog *mDialog;
+   int mPendingRow{ -1 };
+   wxString mPendingTrackName;
+};
+
 enum {
    ID_INSERTA = 11000,
    ID_INSERTB,
@@ -128,23 +264,12 @@ LabelDialog::~LabelDialog()
 
 void LabelDialog::PopulateLabels()
 {
-   // Build the initial (empty) grid
-   mGrid->CreateGrid(0, Col_Max);
+   // Attach the virtual table; the grid takes ownership and pulls cell
+   // values and column labels from it on demand
+   mTable = safenew LabelDialogTable(this);
+   mGrid->SetTable(mTable, true);
    mGrid->SetDefaultCellAlignment(wxALIGN_LEFT, wxALIGN_CENTER);
 
-   /* i18n-hint: (noun).  A track contains waves, audio etc.*/
-   mGrid->SetColLabelValue(0,_("Track"));
-   /* i18n-hint: (noun)*/
-   mGrid->SetColLabelValue(1,_("Label"));
-   /* i18n-hint: (noun) of a label*/
-   mGrid->SetColLabelValue(2,_("Start Time"));
-   /* i18n-hint: (noun) of a label*/
-   mGrid->SetColLabelValue(3,_("End Time"));
-   /* i18n-hint: (noun) of a label*/
-   mGrid->SetColLabelValue(4,_("Low Frequency"));
-   /* i18n-hint: (noun) of a label*/
-   mGrid->SetColLabelValue(5,_("High Frequency"));
-
    // Create and remember editors.  No need to DELETE these as the wxGrid will
    // do it for us.  (The DecRef() that is needed after GetDefaultEditorForType
    // becomes the duty of the wxGridCellAttr objects after we set them in the grid.)
@@ -200,10 +325,30 @@ void LabelDialog::PopulateLabels()
    //
    // This should not be in TransferDataToWindow() since a user might
    // resize the column and we'd resize it back to the minimum.
-   mGrid->AutoSizeColumn(Col_Label, false );
-   mGrid->SetColSize(Col_Label, wxMax(150, mGrid->GetColSize(Col_Label)));
-   mGrid->SetColMinimalWidth(Col_Label, mGrid->GetColSize(Col_Label));
+   //
+   // Rather than have the grid measure every row, measure only the title
+   // with the most characters; with a proportional font that is a close
+   // enough stand-in for the widest one.
+   {
+      size_t longest = 0;
+      const wxString *title = nullptr;
+      for (const RowData &rd : mData) {
+         if (rd.title.length() > longest) {
+            longest = rd.title.length();
+            title = &rd.title;
+         }
+      }
+
+      int width = 0;
+      if (title) {
+         wxClientDC dc(mGrid->GetGridWindow());
+         dc.SetFont(mGrid->GetDefaultCellFont());
+         width = dc.GetTextExtent(*title).x + 10;
+      }
 
+      mGrid->SetColSize(Col_Label, wxMax(150, width));
+      mGrid->SetColMinimalWidth(Col_Label, mGrid->GetColSize(Col_Label));
+   }
 }
 
 
@@ -303,45 +448,53 @@ bool LabelDialog::TransferDataToWindow()
    // Disable redrawing until we're done
    mGrid->BeginBatch();
 
-   // Delete all rows
-   if (mGrid->GetNumberRows()) {
-      mGrid->DeleteRows(0, mGrid->GetNumberRows());
-   }
-
-   // Add the exact number that we'll need
-   mGrid->InsertRows(0, cnt);
-
-   // Populate the rows
-   for (i = 0; i < cnt; i++) {
-      RowData &rd = mData[i];
+   // The row contents live in mData and reach the grid through the
+   // virtual table, so only the row count needs synchronizing, and any
+   // pending track cell edit is superseded by the store
+   mTable->ClearPendingTrackCell();
+   mGrid->RefreshRowCount();
 
-      // Set the cell contents
-      mGrid->SetCellValue(i, Col_Track, TrackName(rd.index));
-      mGrid->SetCellValue(i, Col_Label, rd.title);
-      mGrid->SetCellValue(i, Col_Stime,
-         wxString::Format(wxT("%g"), rd.selectedRegion.t0()));
-      mGrid->SetCellValue(i, Col_Etime,
-         wxString::Format(wxT("%g"), rd.selectedRegion.t1()));
-      mGrid->SetCellValue(i, Col_Lfreq,
-         wxString::Format(wxT("%g"), rd.selectedRegion.f0()));
-      mGrid->SetCellValue(i, Col_Hfreq,
-         wxString::Format(wxT("%g"), rd.selectedRegion.f1()));
+   // Every row is a single line in the same font, so size one row and
+   // apply its height to all instead of measuring each one
+   if (cnt > 0) {
+      mGrid->AutoSizeRow(0, false);
+      mGrid->SetDefaultRowSize(mGrid->GetRowSize(0), true);
    }
 
-   // Autosize all the rows
-   mGrid->AutoSizeRows(true);
-
    // Resize the track name column.  Use a wxChoice to determine the maximum
    // width needed.
    wxChoice tc(this, wxID_ANY, wxDefaultPosition, wxDefaultSize, mTrackNames);
    mGrid->SetColSize(Col_Track, tc.GetSize().x);
    mGrid->SetColMinimalWidth(Col_Track, tc.GetSize().x);
 
-   // Autosize the time columns and set their minimal widths
-   mGrid->AutoSizeColumn(Col_Stime);
-   mGrid->AutoSizeColumn(Col_Etime);
-   mGrid->AutoSizeColumn(Col_Lfreq);
-   mGrid->AutoSizeColumn(Col_Hfreq);
+   // Size the time and frequency columns to their longest strings,
+   // found in one pass over the store, instead of having the grid
+   // measure every cell
+   {
+      wxString widest[Col_Max];
+      for (i = 0; i < cnt; i++) {
+         RowData &rd = mData[i];
+         const wxString vals[Col_Max] = {
+            {}, {},
+            wxString::Format(wxT("%g"), rd.selectedRegion.t0()),
+            wxString::Format(wxT("%g"), rd.selectedRegion.t1()),
+            wxString::Format(wxT("%g"), rd.selectedRegion.f0()),
+            wxString::Format(wxT("%g"), rd.selectedRegion.f1())
+         };
+         for (int col = Col_Stime; col < Col_Max; col++)
+            if (vals[col].length() > widest[col].length())
+               widest[col] = vals[col];
+      }
+
+      wxClientDC dc(mGrid->GetGridWindow());
+      dc.SetFont(mGrid->GetDefaultCellFont());
+      for (int col = Col_Stime; col < Col_Max; col++) {
+         int width = dc.GetTextExtent(widest[col]).x + 10;
+         width = wxMax(width,
+            dc.GetTextExtent(mTable->GetColLabelValue(col)).x + 10);
+         mGrid->SetColSize(col, width);
+      }
+   }
 
    // We're done, so allow the grid to redraw
    mGrid->EndBatch();
@@ -25,6 +25,7 @@ class NumericEditor;
 class TrackFactory;
 class TrackList;
 class RowData;
+class LabelDialogTable;
 class EmptyLabelRenderer;
 class LabelTrack;
 class ViewInfo;
@@ -93,7 +94,12 @@ class LabelDialog final : public wxDialogWrapper
 
  private:
 
+   // The virtual grid table reads and writes mData directly
+   friend class LabelDialogTable;
+
    Grid *mGrid;
+   // Owned by mGrid
+   LabelDialogTable *mTable{};
    ChoiceEditor *mChoiceEditor;
    NumericEditor *mTimeEditor;
    NumericEditor *mFrequencyEditor;
@@ -91,6 +91,7 @@ void LabelTrack::SetLabel( size_t iLabel, const LabelStruct &newLabel )
       mLabels.resize( iLabel + 1 );
    }
    mLabels[ iLabel ] = newLabel;
+   mTimeIndexValid = false;
 }
 
 LabelTrack::~LabelTrack()
@@ -101,10 +102,12 @@ void LabelTrack::SetOffset(double dOffset)
 {
    for (auto &labelStruct: mLabels)
       labelStruct.selectedRegion.move(dOffset);
+   mTimeIndexValid = false;
 }
 
 void LabelTrack::Clear(double b, double e)
 {
+   mTimeIndexValid = false;
    // May DELETE labels, so use subscripts to iterate
    for (size_t i = 0; i < mLabels.size(); ++i) {
       auto &labelStruct = mLabels[i];
@@ -154,6 +157,7 @@ bool LabelTrack::SplitDelete(double b, double e)
 
 void LabelTrack::ShiftLabelsOnInsert(double length, double pt)
 {
+   mTimeIndexValid = false;
    for (auto &labelStruct: mLabels) {
       LabelStruct::TimeRelations relation =
                         labelStruct.RegionRelation(pt, pt, this);
@@ -182,6 +186,7 @@ void LabelTrack::ChangeLabelsOnReverse(double b, double e)
 
 void LabelTrack::ScaleLabels(double b, double e, double change)
 {
+   mTimeIndexValid = false;
    for (auto &labelStruct: mLabels) {
       labelStruct.selectedRegion.setTimes(
          AdjustTimeStampOnScale(labelStruct.getT0(), b, e, change),
@@ -497,26 +502,103 @@ void LabelTrack::Export(wxTextFile & f) const
 /// Import labels, handling files with or without end-times.
 void LabelTrack::Import(wxTextFile & in)
 {
-   int lines = in.GetLineCount();
+   // Concatenate into one buffer and use the streaming parser
+   wxString text;
+   const int lines = in.GetLineCount();
+   for (int index = 0; index < lines; ++index) {
+      text += in.GetLine(index);
+      text += wxT('\n');
+   }
+   Import(text);
+}
 
+/// Import labels from the whole text of a label file.  The text is
+/// parsed in one streaming pass with a single bulk append and one
+/// deferred sort at the end, so that importing very large label files
+/// stays bound by reading the file, not by per-label bookkeeping.
+void LabelTrack::Import(const wxString &text)
+{
    mLabels.clear();
-   mLabels.reserve(lines);
+   mTimeIndexValid = false;
+   mLabels.reserve(text.Freq(wxT('\n')) + 1);
 
    //Currently, we expect a tag file to have two values and a label
    //on each line. If the second token is not a number, we treat
    //it as a single-value label.
    bool error = false;
-   for (int index = 0; index < lines;) {
-      try {
-         // Let LabelStruct::Import advance index
-         LabelStruct l { LabelStruct::Import(in, index) };
-         mLabels.push_back(l);
+
+   // A label to which a following continuation line may apply, and
+   // whether it already received one
+   bool haveLabel = false;
+   bool haveFrequencies = false;
+
+   wxStringTokenizer lines { text, wxT("\r\n") };
+   while (lines.HasMoreTokens()) {
+      const wxString line = lines.GetNextToken();
+
+      if (line.StartsWith(wxT("\\"))) {
+         // Continuation line beginning with '\', holding the newer
+         // selection fields; see LabelStruct::Export.  Only the first
+         // one after a label is parsed, further ones are ignored.
+         if (!haveLabel || haveFrequencies)
+            continue;
+         haveFrequencies = true;
+
+         wxStringTokenizer toker { line, wxT("\t") };
+         toker.GetNextToken(); // the continuation mark itself
+
+         double f0, f1;
+         if (!Internat::CompatibleToDouble(toker.GetNextToken(), &f0) ||
+             !Internat::CompatibleToDouble(toker.GetNextToken(), &f1)) {
+            // As when parsing line by line, a bad continuation
+            // invalidates its label
+            mLabels.pop_back();
+            error = true;
+            continue;
+         }
+
+         mLabels.back().selectedRegion.setFrequencies(f0, f1);
+         continue;
+      }
+
+      haveLabel = false;
+      haveFrequencies = false;
+
+      // Assume tab is an impossible character within the exported text
+      // of the label, so can be only a delimiter.  But other white space
+      // may be part of the label text.
+      wxStringTokenizer toker { line, wxT("\t") };
+
+      double t0;
+      if (!Internat::CompatibleToDouble(toker.GetNextToken(), &t0)) {
+         error = true;
+         continue;
       }
-      catch(const LabelStruct::BadFormatException&) { error = true; }
+
+      auto token = toker.GetNextToken();
+      double t1;
+      if (!Internat::CompatibleToDouble(token, &t1))
+         //s1 is not a number.
+         t1 = t0;  //This is a one-sided label; t1 == t0.
+      else
+         token = toker.GetNextToken();
+
+      SelectedRegion sr;
+      sr.setTimes(t0, t1);
+      mLabels.push_back(LabelStruct { sr, token });
+      haveLabel = true;
    }
+
    if (error)
       ::AudacityMessageBox( _("One or more saved labels could not be read.") );
-   SortLabels();
+
+   // One deferred sort instead of incremental ordering.  No
+   // EVT_LABELTRACK_PERMUTED events are sent: the whole content was
+   // just replaced, so any indices listeners stored are stale anyway.
+   const auto byT0 = [](const LabelStruct &a, const LabelStruct &b)
+      { return a.getT0() < b.getT0(); };
+   if (!std::is_sorted(mLabels.begin(), mLabels.end(), byT0))
+      std::stable_sort(mLabels.begin(), mLabels.end(), byT0);
 }
 
 bool LabelTrack::HandleXMLTag(const wxChar *tag, const wxChar **attrs)
@@ -558,6 +640,7 @@ bool LabelTrack::HandleXMLTag(const wxChar *tag, const wxChar **attrs)
 
       LabelStruct l { selectedRegion, title };
       mLabels.push_back(l);
+      mTimeIndexValid = false;
 
       return true;
    }
@@ -744,6 +827,7 @@ Track::Holder LabelTrack::Copy(double t0, double t1, bool) const
 
 bool LabelTrack::PasteOver(double t, const Track * src)
 {
+   mTimeIndexValid = false;
    auto result = src->TypeSwitch< bool >( [&](const LabelTrack *sl) {
       int len = mLabels.size();
       int pos = 0;
@@ -798,6 +882,7 @@ bool LabelTrack::Repeat(double t0, double t1, int n)
 
    // Insert space for the repetitions
    ShiftLabelsOnInsert(tLen * n, t1);
+   mTimeIndexValid = false;
 
    // mLabels may resize as we iterate, so use subscripting
    for (unsigned int i = 0; i < mLabels.size(); ++i)
@@ -888,6 +973,7 @@ void LabelTrack::Silence(double t0, double t1)
 
 void LabelTrack::InsertSilence(double t, double len)
 {
+   mTimeIndexValid = false;
    for (auto &labelStruct: mLabels) {
       double t0 = labelStruct.getT0();
       double t1 = labelStruct.getT1();
@@ -922,6 +1008,7 @@ int LabelTrack::AddLabel(const SelectedRegion &selectedRegion,
       pos++;
 
    mLabels.insert(mLabels.begin() + pos, l);
+   mTimeIndexValid = false;
 
    LabelTrackEvent evt{
       EVT_LABELTRACK_ADDITION, SharedPointer<LabelTrack>(), title, -1, pos
@@ -937,6 +1024,7 @@ void LabelTrack::DeleteLabel(int index)
    auto iter = mLabels.begin() + index;
    const auto title = iter->title;
    mLabels.erase(iter);
+   mTimeIndexValid = false;
 
    LabelTrackEvent evt{
       EVT_LABELTRACK_DELETION, SharedPointer<LabelTrack>(), title, index, -1
@@ -950,6 +1038,9 @@ void LabelTrack::DeleteLabel(int index)
 /// sort (with a linear search) is a reasonable choice.
 void LabelTrack::SortLabels()
 {
+   // Callers typically changed label times before sorting
+   mTimeIndexValid = false;
+
    const auto begin = mLabels.begin();
    const auto nn = (int)mLabels.size();
    int i = 1;
@@ -1053,3 +1144,36 @@ int LabelTrack::FindNextLabel(const SelectedRegion& currentRegion)
    miLastLabel = i;
    return i;
 }
+
+void LabelTrack::BuildTimeIndex() const
+{
+   const auto nn = mLabels.size();
+   mMaxEndTimes.resize(nn);
+   double maxT1 = -DBL_MAX;
+   for (size_t ii = 0; ii < nn; ++ii) {
+      maxT1 = std::max(maxT1, mLabels[ii].getT1());
+      mMaxEndTimes[ii] = maxT1;
+   }
+   mTimeIndexValid = true;
+}
+
+std::pair<int, int> LabelTrack::FindIntersectingLabels(
+   double t0, double t1) const
+{
+   if (!mTimeIndexValid)
+      BuildTimeIndex();
+
+   // Labels are sorted by starting time, so the first label starting
+   // after t1 ends the range
+   const auto end = std::upper_bound(mLabels.begin(), mLabels.end(), t1,
+      [](double t, const LabelStruct &label){ return t < label.getT0(); })
+      - mLabels.begin();
+
+   // The running maxima of end times are nondecreasing, so the first
+   // label from which some end time reaches back to t0 begins it
+   const auto begin = std::lower_bound(
+      mMaxEndTimes.begin(), mMaxEndTimes.begin() + end, t0)
+      - mMaxEndTimes.begin();
+
+   return { (int) begin, (int) end };
+}
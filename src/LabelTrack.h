@@ -128,6 +128,9 @@ public:
    void InsertSilence(double t, double len) override;
 
    void Import(wxTextFile & f);
+   // Parse the whole text of a label file in one streaming pass;
+   // preferred for large files
+   void Import(const wxString &text);
    void Export(wxTextFile & f) const;
 
    int GetNumLabels() const;
@@ -160,14 +163,29 @@ public:
    int FindNextLabel(const SelectedRegion& currentSelection);
    int FindPrevLabel(const SelectedRegion& currentSelection);
 
+   // Returns indices [begin, end) of the labels whose time extent may
+   // intersect [t0, t1].  Logarithmic in the number of labels, so
+   // suitable for hit-testing and visible-range queries on label-dense
+   // tracks.
+   std::pair<int, int> FindIntersectingLabels(double t0, double t1) const;
+
  public:
    void SortLabels();
 
  private:
    TrackKind GetKind() const override { return TrackKind::Label; }
 
+   void BuildTimeIndex() const;
+
    LabelArray mLabels;
 
+   // Index for FindIntersectingLabels: running maxima of label end
+   // times, in the same order as mLabels.  The maxima are nondecreasing,
+   // which makes the start of an intersecting range binary-searchable.
+   // Rebuilt lazily; every mutation of the labels clears the flag.
+   mutable std::vector<double> mMaxEndTimes;
+   mutable bool mTimeIndexValid { false };
+
    // Set in copied label tracks
    double mClipLen;
 
@@ -531,6 +531,9 @@ void MenuManager::ModifyToolbarMenus(AudacityProject &project)
    gPrefs->Read(wxT("/AudioIO/SWPlaythrough"),&active, false);
    commandManager.Check(wxT("SWPlaythrough"), active);
 
+   gPrefs->Read(wxT("/AudioIO/ProxyPlayback"),&active, false);
+   commandManager.Check(wxT("ProxyPlayback"), active);
+
    gPrefs->Read(wxT("/GUI/SyncLockTracks"), &active, false);
    settings.SetSyncLock(active);
 
@@ -25,6 +25,7 @@
 #include "Mix.h"
 
 #include <math.h>
+#include <future>
 
 #include <wx/textctrl.h>
 #include <wx/progdlg.h>
@@ -38,6 +39,12 @@
 #include "TimeTrack.h"
 #include "float_cast.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIX_USE_SSE2
+#include <emmintrin.h>
+#endif
+
 #include "widgets/ProgressDialog.h"
 
 //TODO-MB: wouldn't it make more sense to DELETE the time track after 'mix and render'?
@@ -111,6 +118,33 @@ void MixAndRender(TrackList *tracks, TrackFactory *trackFactory,
       oneinput = true;
    // only one input track (either 1 mono or one linked stereo pair)
 
+   /* identity fast path: when the sole input is already what the mix
+    * would render -- unit gain, centered, unwarped, and at the requested
+    * rate and format -- duplicate it instead of rendering.  Duplication
+    * shares the immutable block files, so rendering for track tidying
+    * is then nearly instant. */
+   if (oneinput &&
+       !*tracks->Any<TimeTrack>().begin() &&
+       (startTime == endTime ||
+        (startTime <= mixStartTime && endTime >= mixEndTime))) {
+      bool identity = true;
+      for (auto wt : trackRange)
+         identity = identity &&
+            wt->GetGain() == 1.0f &&
+            wt->GetPan() == 0.0f &&
+            wt->GetRate() == rate &&
+            wt->GetSampleFormat() == format &&
+            wt->HasTrivialEnvelope();
+      if (identity) {
+         auto channels = TrackList::Channels(first);
+         uLeft = trackFactory->DuplicateWaveTrack(**channels.begin());
+         if (channels.size() > 1)
+            uRight = trackFactory->DuplicateWaveTrack(
+               **channels.begin().advance(1));
+         return;
+      }
+   }
+
    auto mixLeft = trackFactory->NewWaveTrack(format, rate);
    if (oneinput)
       mixLeft->SetName(first->GetName()); /* set name of output track to be the same as the sole input track */
@@ -241,7 +275,6 @@ Mixer::Mixer(const WaveTrackConstArray &inputTracks,
    , mSampleQueue{ mNumInputTracks, mQueueMaxLen }
 
    , mNumChannels{ numOutChannels }
-   , mGains{ mNumChannels }
 
    , mMayThrow{ mayThrow }
 {
@@ -253,6 +286,9 @@ Mixer::Mixer(const WaveTrackConstArray &inputTracks,
    mSamplePos.reinit(mNumInputTracks);
    for(size_t i=0; i<mNumInputTracks; i++) {
       mInputTrack[i].SetTrack(inputTracks[i]);
+      // Mixing sweeps the tracks forward, so overlap the reading of each
+      // next block with the processing of the current one
+      mInputTrack[i].StartReadahead();
       mSamplePos[i] = inputTracks[i]->TimeToLongSamples(startTime);
    }
    mEnvelope = warpOptions.envelope;
@@ -281,12 +317,11 @@ Mixer::Mixer(const WaveTrackConstArray &inputTracks,
    }
 
    mBuffer.reinit(mNumBuffers);
-   mTemp.reinit(mNumBuffers);
-   for (unsigned int c = 0; c < mNumBuffers; c++) {
+   for (unsigned int c = 0; c < mNumBuffers; c++)
       mBuffer[c].Allocate(mInterleavedBufferSize, mFormat);
-      mTemp[c].Allocate(mInterleavedBufferSize, floatSample);
-   }
-   mFloatBuffer = Floats{ mInterleavedBufferSize };
+
+   mScratch.resize(1);
+   AllocScratch(mScratch[0]);
 
    // But cut the queue into blocks of this finer size
    // for variable rate resampling.  Each block is resampled at some
@@ -326,15 +361,71 @@ Mixer::Mixer(const WaveTrackConstArray &inputTracks,
    }
 
    MakeResamplers();
+}
 
-   const auto envLen = std::max(mQueueMaxLen, mInterleavedBufferSize);
-   mEnvValues.reinit(envLen);
+Mixer::Mixer(unsigned numOutChannels, size_t outBufferSize, bool outInterleaved,
+             double outRate, sampleFormat outFormat,
+             double startTime, double stopTime)
+   : mNumInputTracks{ 0 }
+   , mQueueMaxLen{ 0 }
+   , mSampleQueue{ 0, 0 }
+   , mNumChannels{ numOutChannels }
+   , mMayThrow{ false }
+{
+   mHighQuality = false;
+   mbVariableRates = false;
+   mEnvelope = nullptr;
+   mApplyTrackGains = false;
+   mT0 = startTime;
+   mT1 = stopTime;
+   mTime = startTime;
+   mBufferSize = outBufferSize;
+   mInterleaved = outInterleaved;
+   mRate = outRate;
+   mSpeed = 1.0;
+   mFormat = outFormat;
+   mMixerSpec = NULL;
+   mMaxOut = 0;
+   mProcessLen = 0;
+
+   if (mInterleaved) {
+      mNumBuffers = 1;
+      mInterleavedBufferSize = mBufferSize * mNumChannels;
+   }
+   else {
+      mNumBuffers = mNumChannels;
+      mInterleavedBufferSize = mBufferSize;
+   }
+
+   mBuffer.reinit(mNumBuffers);
+   for (unsigned int c = 0; c < mNumBuffers; c++)
+      mBuffer[c].Allocate(mInterleavedBufferSize, mFormat);
 }
 
 Mixer::~Mixer()
 {
 }
 
+void Mixer::AllocScratch(Scratch &scratch)
+{
+   scratch.temp.reinit(mNumBuffers);
+   for (unsigned int c = 0; c < mNumBuffers; c++)
+      scratch.temp[c].Allocate(mInterleavedBufferSize, floatSample);
+   scratch.floatBuffer = Floats{ mInterleavedBufferSize };
+   scratch.gains = Floats{ mNumChannels };
+   const auto envLen = std::max(mQueueMaxLen, mInterleavedBufferSize);
+   scratch.envValues.reinit(envLen);
+}
+
+void Mixer::SetNumWorkers(unsigned numWorkers)
+{
+   mNumWorkers = std::max(1u, numWorkers);
+   while (mScratch.size() < mNumWorkers) {
+      mScratch.emplace_back();
+      AllocScratch(mScratch.back());
+   }
+}
+
 void Mixer::MakeResamplers()
 {
    for (size_t i = 0; i < mNumInputTracks; i++)
@@ -348,9 +439,87 @@ void Mixer::ApplyTrackGains(bool apply)
 
 void Mixer::Clear()
 {
-   for (unsigned int c = 0; c < mNumBuffers; c++) {
-      memset(mTemp[c].ptr(), 0, mInterleavedBufferSize * SAMPLE_SIZE(floatSample));
+   for (auto &scratch : mScratch)
+      for (unsigned int c = 0; c < mNumBuffers; c++) {
+         memset(scratch.temp[c].ptr(), 0,
+            mInterleavedBufferSize * SAMPLE_SIZE(floatSample));
+      }
+}
+
+namespace {
+
+// Multiply-accumulate one channel's samples into a contiguous mix
+// buffer.  This inner loop dominates profiles of big exports, so use
+// SSE2 when the target has it; the scalar loop remains as the tail and
+// the fallback.
+inline void MixGainMAC(float *dest, const float *src, float gain, int len)
+{
+   int j = 0;
+#ifdef MIX_USE_SSE2
+   if (gain == 1.0f) {
+      // Fused fast path for constant unity gain, the common case when
+      // no envelope or fader is applied
+      for (; j + 4 <= len; j += 4)
+         _mm_storeu_ps(dest + j,
+            _mm_add_ps(_mm_loadu_ps(dest + j), _mm_loadu_ps(src + j)));
+   }
+   else {
+      const __m128 vgain = _mm_set1_ps(gain);
+      for (; j + 4 <= len; j += 4)
+         _mm_storeu_ps(dest + j,
+            _mm_add_ps(_mm_loadu_ps(dest + j),
+               _mm_mul_ps(_mm_loadu_ps(src + j), vgain)));
+   }
+#endif
+   for (; j < len; j++)
+      dest[j] += src[j] * gain;
+}
+
+// Scale a float buffer in place by envelope values.  Detects constant
+// regions (very often the whole buffer, when the envelope is flat) and
+// handles them with a broadcast multiply, or no work at all at unity.
+void ApplyEnvelopeValues(float *buffer, const double *env, size_t len)
+{
+   if (len == 0)
+      return;
+
+   size_t constantRun = 1;
+   const double first = env[0];
+   while (constantRun < len && env[constantRun] == first)
+      ++constantRun;
+
+   if (constantRun == len) {
+      // Constant-gain region
+      if (first == 1.0)
+         return;
+      const float gain = float(first);
+      size_t j = 0;
+#ifdef MIX_USE_SSE2
+      const __m128 vgain = _mm_set1_ps(gain);
+      for (; j + 4 <= len; j += 4)
+         _mm_storeu_ps(buffer + j,
+            _mm_mul_ps(_mm_loadu_ps(buffer + j), vgain));
+#endif
+      for (; j < len; j++)
+         buffer[j] *= gain;
+      return;
    }
+
+   // Varying region: convert envelope doubles and multiply
+   size_t j = 0;
+#ifdef MIX_USE_SSE2
+   for (; j + 4 <= len; j += 4) {
+      const __m128 venv = _mm_movelh_ps(
+         _mm_cvtpd_ps(_mm_loadu_pd(env + j)),
+         _mm_cvtpd_ps(_mm_loadu_pd(env + j + 2)));
+      _mm_storeu_ps(buffer + j,
+         _mm_mul_ps(_mm_loadu_ps(buffer + j), venv));
+   }
+#endif
+   for (; j < len; j++)
+      buffer[j] *= env[j];
+}
+
 }
 
 void MixBuffers(unsigned numChannels, int *channelFlags, float *gains,
@@ -375,10 +544,14 @@ void MixBuffers(unsigned numChannels, int *channelFlags, float *gains,
       float gain = gains[c];
       float *dest = (float *)destPtr;
       float *temp = (float *)src;
-      for (int j = 0; j < len; j++) {
-         *dest += temp[j] * gain;   // the actual mixing process
-         dest += skip;
-      }
+      if (skip == 1)
+         // Contiguous destination: vectorized multiply-accumulate
+         MixGainMAC(dest, temp, gain, len);
+      else
+         for (int j = 0; j < len; j++) {
+            *dest += temp[j] * gain;   // the actual mixing process
+            dest += skip;
+         }
    }
 }
 
@@ -405,7 +578,7 @@ double ComputeWarpFactor(const Envelope &env, double t0, double t1)
 size_t Mixer::MixVariableRates(int *channelFlags, WaveTrackCache &cache,
                                     sampleCount *pos, float *queue,
                                     int *queueStart, int *queueLen,
-                                    Resample * pResample)
+                                    Resample * pResample, Scratch &scratch)
 {
    const WaveTrack *const track = cache.GetTrack().get();
    const double trackRate = track->GetRate();
@@ -451,6 +624,9 @@ size_t Mixer::MixVariableRates(int *channelFlags, WaveTrackCache &cache,
 
          // Nothing to do if past end of play interval
          if (getLen > 0) {
+            // An untouched envelope is unity gain everywhere; skip
+            // evaluating and multiplying it
+            const bool trivialEnvelope = track->HasTrivialEnvelope();
             if (backwards) {
                auto results = cache.Get(floatSample, *pos - (getLen - 1), getLen, mMayThrow);
                if (results)
@@ -458,9 +634,10 @@ size_t Mixer::MixVariableRates(int *channelFlags, WaveTrackCache &cache,
                else
                   memset(&queue[*queueLen], 0, sizeof(float) * getLen);
 
-               track->GetEnvelopeValues(mEnvValues.get(),
-                                        getLen,
-                                        (*pos - (getLen- 1)).as_double() / trackRate);
+               if (!trivialEnvelope)
+                  track->GetEnvelopeValues(scratch.envValues.get(),
+                                           getLen,
+                                           (*pos - (getLen- 1)).as_double() / trackRate);
                *pos -= getLen;
             }
             else {
@@ -470,16 +647,17 @@ size_t Mixer::MixVariableRates(int *channelFlags, WaveTrackCache &cache,
                else
                   memset(&queue[*queueLen], 0, sizeof(float) * getLen);
 
-               track->GetEnvelopeValues(mEnvValues.get(),
-                                        getLen,
-                                        (*pos).as_double() / trackRate);
+               if (!trivialEnvelope)
+                  track->GetEnvelopeValues(scratch.envValues.get(),
+                                           getLen,
+                                           (*pos).as_double() / trackRate);
 
                *pos += getLen;
             }
 
-            for (decltype(getLen) i = 0; i < getLen; i++) {
-               queue[(*queueLen) + i] *= mEnvValues[i];
-            }
+            if (!trivialEnvelope)
+               ApplyEnvelopeValues(
+                  &queue[*queueLen], scratch.envValues.get(), getLen);
 
             if (backwards)
                ReverseSamples((samplePtr)&queue[0], floatSample,
@@ -489,7 +667,11 @@ size_t Mixer::MixVariableRates(int *channelFlags, WaveTrackCache &cache,
          }
       }
 
-      auto thisProcessLen = mProcessLen;
+      // The queue is cut into mProcessLen pieces only so that each piece
+      // can be resampled at its own constant warp factor.  Without a time
+      // track the factor never changes, so pass the resampler the whole
+      // queued span (typically a full block file's worth) in one call.
+      auto thisProcessLen = mEnvelope ? mProcessLen : size_t( *queueLen );
       bool last = (*queueLen < (int)mProcessLen);
       if (last) {
          thisProcessLen = *queueLen;
@@ -515,7 +697,7 @@ size_t Mixer::MixVariableRates(int *channelFlags, WaveTrackCache &cache,
                                       &queue[*queueStart],
                                       thisProcessLen,
                                       last,
-                                      &mFloatBuffer[out],
+                                      &scratch.floatBuffer[out],
                                       mMaxOut - out);
 
       const auto input_used = results.first;
@@ -531,18 +713,18 @@ size_t Mixer::MixVariableRates(int *channelFlags, WaveTrackCache &cache,
 
    for (size_t c = 0; c < mNumChannels; c++) {
       if (mApplyTrackGains) {
-         mGains[c] = track->GetChannelGain(c);
+         scratch.gains[c] = track->GetChannelGain(c);
       }
       else {
-         mGains[c] = 1.0;
+         scratch.gains[c] = 1.0;
       }
    }
 
    MixBuffers(mNumChannels,
               channelFlags,
-              mGains.get(),
-              (samplePtr)mFloatBuffer.get(),
-              mTemp.get(),
+              scratch.gains.get(),
+              (samplePtr)scratch.floatBuffer.get(),
+              scratch.temp.get(),
               out,
               mInterleaved);
 
@@ -550,7 +732,7 @@ size_t Mixer::MixVariableRates(int *channelFlags, WaveTrackCache &cache,
 }
 
 size_t Mixer::MixSameRate(int *channelFlags, WaveTrackCache &cache,
-                               sampleCount *pos)
+                               sampleCount *pos, Scratch &scratch)
 {
    const WaveTrack *const track = cache.GetTrack().get();
    const double t = ( *pos ).as_double() / track->GetRate();
@@ -573,44 +755,111 @@ size_t Mixer::MixSameRate(int *channelFlags, WaveTrackCache &cache,
       sampleCount{ (backwards ? t - tEnd : tEnd - t) * track->GetRate() + 0.5 }
    );
 
+   // An untouched envelope is unity gain everywhere; skip evaluating and
+   // multiplying it
+   const bool trivialEnvelope = track->HasTrivialEnvelope();
+
+   // A window of silence -- silent blocks, or gaps between clips --
+   // contributes nothing to the mix; the accumulators were cleared in
+   // Process(), so just consume the window.  Only whole windows may be
+   // skipped, because each track's contribution is laid down at the
+   // start of the accumulator for every window.
+   const auto firstSample = backwards ? *pos - (slen - 1) : *pos;
+   if (track->GetSilentSpan(firstSample, slen) == slen) {
+      if (backwards)
+         *pos -= slen;
+      else
+         *pos += slen;
+      return slen;
+   }
+
    if (backwards) {
       auto results = cache.Get(floatSample, *pos - (slen - 1), slen, mMayThrow);
       if (results)
-         memcpy(mFloatBuffer.get(), results, sizeof(float) * slen);
+         memcpy(scratch.floatBuffer.get(), results, sizeof(float) * slen);
       else
-         memset(mFloatBuffer.get(), 0, sizeof(float) * slen);
-      track->GetEnvelopeValues(mEnvValues.get(), slen, t - (slen - 1) / mRate);
-      for(decltype(slen) i = 0; i < slen; i++)
-         mFloatBuffer[i] *= mEnvValues[i]; // Track gain control will go here?
-      ReverseSamples((samplePtr)mFloatBuffer.get(), floatSample, 0, slen);
+         memset(scratch.floatBuffer.get(), 0, sizeof(float) * slen);
+      if (!trivialEnvelope) {
+         track->GetEnvelopeValues(
+            scratch.envValues.get(), slen, t - (slen - 1) / mRate);
+         // Track gain control will go here?
+         ApplyEnvelopeValues(
+            scratch.floatBuffer.get(), scratch.envValues.get(), slen);
+      }
+      ReverseSamples((samplePtr)scratch.floatBuffer.get(), floatSample, 0, slen);
 
       *pos -= slen;
    }
    else {
       auto results = cache.Get(floatSample, *pos, slen, mMayThrow);
       if (results)
-         memcpy(mFloatBuffer.get(), results, sizeof(float) * slen);
+         memcpy(scratch.floatBuffer.get(), results, sizeof(float) * slen);
       else
-         memset(mFloatBuffer.get(), 0, sizeof(float) * slen);
-      track->GetEnvelopeValues(mEnvValues.get(), slen, t);
-      for(decltype(slen) i = 0; i < slen; i++)
-         mFloatBuffer[i] *= mEnvValues[i]; // Track gain control will go here?
+         memset(scratch.floatBuffer.get(), 0, sizeof(float) * slen);
+      if (!trivialEnvelope) {
+         track->GetEnvelopeValues(scratch.envValues.get(), slen, t);
+         // Track gain control will go here?
+         ApplyEnvelopeValues(
+            scratch.floatBuffer.get(), scratch.envValues.get(), slen);
+      }
 
       *pos += slen;
    }
 
    for(size_t c=0; c<mNumChannels; c++)
       if (mApplyTrackGains)
-         mGains[c] = track->GetChannelGain(c);
+         scratch.gains[c] = track->GetChannelGain(c);
       else
-         mGains[c] = 1.0;
+         scratch.gains[c] = 1.0;
 
-   MixBuffers(mNumChannels, channelFlags, mGains.get(),
-              (samplePtr)mFloatBuffer.get(), mTemp.get(), slen, mInterleaved);
+   MixBuffers(mNumChannels, channelFlags, scratch.gains.get(),
+              (samplePtr)scratch.floatBuffer.get(), scratch.temp.get(),
+              slen, mInterleaved);
 
    return slen;
 }
 
+size_t Mixer::MixTrack(size_t trackIndex, Scratch &scratch)
+{
+   const WaveTrack *const track = mInputTrack[trackIndex].GetTrack().get();
+   ArrayOf<int> channelFlags{ mNumChannels };
+
+   for(size_t j=0; j<mNumChannels; j++)
+      channelFlags[j] = 0;
+
+   if( mMixerSpec ) {
+      //ignore left and right when downmixing is not required
+      for(size_t j = 0; j < mNumChannels; j++ )
+         channelFlags[ j ] = mMixerSpec->mMap[ trackIndex ][ j ] ? 1 : 0;
+   }
+   else {
+      switch(track->GetChannel()) {
+      case Track::MonoChannel:
+      default:
+         for(size_t j=0; j<mNumChannels; j++)
+            channelFlags[j] = 1;
+         break;
+      case Track::LeftChannel:
+         channelFlags[0] = 1;
+         break;
+      case Track::RightChannel:
+         if (mNumChannels >= 2)
+            channelFlags[1] = 1;
+         else
+            channelFlags[0] = 1;
+         break;
+      }
+   }
+   if (mbVariableRates || track->GetRate() != mRate)
+      return MixVariableRates(channelFlags.get(), mInputTrack[trackIndex],
+         &mSamplePos[trackIndex], mSampleQueue[trackIndex].get(),
+         &mQueueStart[trackIndex], &mQueueLen[trackIndex],
+         mResample[trackIndex].get(), scratch);
+   else
+      return MixSameRate(channelFlags.get(), mInputTrack[trackIndex],
+         &mSamplePos[trackIndex], scratch);
+}
+
 size_t Mixer::Process(size_t maxToProcess)
 {
    // MB: this is wrong! mT represented warped time, and mTime is too inaccurate to use
@@ -619,48 +868,53 @@ size_t Mixer::Process(size_t maxToProcess)
    //   return 0;
 
    decltype(Process(0)) maxOut = 0;
-   ArrayOf<int> channelFlags{ mNumChannels };
 
    mMaxOut = maxToProcess;
 
    Clear();
-   for(size_t i=0; i<mNumInputTracks; i++) {
-      const WaveTrack *const track = mInputTrack[i].GetTrack().get();
-      for(size_t j=0; j<mNumChannels; j++)
-         channelFlags[j] = 0;
 
-      if( mMixerSpec ) {
-         //ignore left and right when downmixing is not required
-         for(size_t j = 0; j < mNumChannels; j++ )
-            channelFlags[ j ] = mMixerSpec->mMap[ i ][ j ] ? 1 : 0;
+   const size_t nWorkers =
+      std::min<size_t>(mNumWorkers, mNumInputTracks);
+   if (nWorkers > 1) {
+      // Slice the tracks among workers; each accumulates into its own
+      // scratch buffers, which are summed afterward.  Each track's
+      // queue, resampler, and position are touched by one worker only.
+      const size_t slice = (mNumInputTracks + nWorkers - 1) / nWorkers;
+      std::vector<std::future<size_t>> futures;
+      for (size_t w = 1; w < nWorkers; w++) {
+         const size_t begin = w * slice;
+         const size_t end = std::min(begin + slice, mNumInputTracks);
+         futures.push_back(std::async(std::launch::async,
+            [this, begin, end, w]{
+               size_t out = 0;
+               for (size_t i = begin; i < end; i++)
+                  out = std::max(out, MixTrack(i, mScratch[w]));
+               return out;
+            }));
       }
-      else {
-         switch(track->GetChannel()) {
-         case Track::MonoChannel:
-         default:
-            for(size_t j=0; j<mNumChannels; j++)
-               channelFlags[j] = 1;
-            break;
-         case Track::LeftChannel:
-            channelFlags[0] = 1;
-            break;
-         case Track::RightChannel:
-            if (mNumChannels >= 2)
-               channelFlags[1] = 1;
-            else
-               channelFlags[0] = 1;
-            break;
+      // This thread takes the first slice itself
+      for (size_t i = 0; i < std::min(slice, mNumInputTracks); i++)
+         maxOut = std::max(maxOut, MixTrack(i, mScratch[0]));
+      for (auto &future : futures)
+         maxOut = std::max(maxOut, future.get());
+
+      // Reduce the other workers' accumulators into the first
+      const size_t reduceLen =
+         mInterleaved ? maxOut * mNumChannels : maxOut;
+      for (size_t w = 1; w < nWorkers; w++)
+         for (unsigned int c = 0; c < mNumBuffers; c++) {
+            const float *src = (const float *)mScratch[w].temp[c].ptr();
+            float *dest = (float *)mScratch[0].temp[c].ptr();
+            for (size_t j = 0; j < reduceLen; j++)
+               dest[j] += src[j];
          }
-      }
-      if (mbVariableRates || track->GetRate() != mRate)
-         maxOut = std::max(maxOut,
-            MixVariableRates(channelFlags.get(), mInputTrack[i],
-               &mSamplePos[i], mSampleQueue[i].get(),
-               &mQueueStart[i], &mQueueLen[i], mResample[i].get()));
-      else
-         maxOut = std::max(maxOut,
-            MixSameRate(channelFlags.get(), mInputTrack[i], &mSamplePos[i]));
+   }
+   else
+      for (size_t i = 0; i < mNumInputTracks; i++)
+         maxOut = std::max(maxOut, MixTrack(i, mScratch[0]));
 
+   for(size_t i=0; i<mNumInputTracks; i++) {
+      const WaveTrack *const track = mInputTrack[i].GetTrack().get();
       double t = mSamplePos[i].as_double() / (double)track->GetRate();
       if (mT0 > mT1)
          // backwards (as possibly in scrubbing)
@@ -669,9 +923,11 @@ size_t Mixer::Process(size_t maxToProcess)
          // forwards (the usual)
          mTime = std::min(std::max(t, mTime), mT1);
    }
+
+   auto &temp = mScratch[0].temp;
    if(mInterleaved) {
       for(size_t c=0; c<mNumChannels; c++) {
-         CopySamples(mTemp[0].ptr() + (c * SAMPLE_SIZE(floatSample)),
+         CopySamples(temp[0].ptr() + (c * SAMPLE_SIZE(floatSample)),
             floatSample,
             mBuffer[0].ptr() + (c * SAMPLE_SIZE(mFormat)),
             mFormat,
@@ -683,7 +939,7 @@ size_t Mixer::Process(size_t maxToProcess)
    }
    else {
       for(size_t c=0; c<mNumBuffers; c++) {
-         CopySamples(mTemp[c].ptr(),
+         CopySamples(temp[c].ptr(),
             floatSample,
             mBuffer[c].ptr(),
             mFormat,
@@ -108,12 +108,28 @@ class AUDACITY_DLL_API Mixer {
 
    virtual ~ Mixer();
 
+ protected:
+   /// For subclasses (such as the export mixdown cache) that replace the
+   /// processing entirely:  allocates the output buffers but sets up no
+   /// input tracks.  Such a subclass must override Process() and must not
+   /// call Restart() or Reposition().
+   Mixer(unsigned numOutChannels, size_t outBufferSize, bool outInterleaved,
+         double outRate, sampleFormat outFormat,
+         double startTime, double stopTime);
+
+ public:
+
    //
    // Setup
    //
 
    void ApplyTrackGains(bool apply = true); // True by default
 
+   /// Mix input tracks concurrently on up to numWorkers threads in each
+   /// Process() call.  Useful for offline rendering of many-track
+   /// projects; the default of one keeps the old serial behavior.
+   void SetNumWorkers(unsigned numWorkers);
+
    //
    // Processing
    //
@@ -122,7 +138,7 @@ class AUDACITY_DLL_API Mixer {
    /// a buffer which can be retrieved by calling GetBuffer().
    /// Returns number of output samples, or 0, if there are no
    /// more samples that must be processed.
-   size_t Process(size_t maxSamples);
+   virtual size_t Process(size_t maxSamples);
 
    /// Restart processing at beginning of buffer next time
    /// Process() is called.
@@ -137,24 +153,36 @@ class AUDACITY_DLL_API Mixer {
 
    /// Current time in seconds (unwarped, i.e. always between startTime and stopTime)
    /// This value is not accurate, it's useful for progress bars and indicators, but nothing else.
-   double MixGetCurrentTime();
+   virtual double MixGetCurrentTime();
 
    /// Retrieve the main buffer or the interleaved buffer
-   samplePtr GetBuffer();
+   virtual samplePtr GetBuffer();
 
    /// Retrieve one of the non-interleaved buffers
-   samplePtr GetBuffer(int channel);
+   virtual samplePtr GetBuffer(int channel);
 
  private:
 
+   // Scratch areas used by the mixing inner loops.  Each concurrent
+   // worker in Process() owns one set, including its own accumulation
+   // buffers, which are summed into the first worker's afterward.
+   struct Scratch {
+      Floats           floatBuffer;
+      Doubles          envValues;
+      Floats           gains;
+      ArrayOf<SampleBuffer> temp;
+   };
+
+   void AllocScratch(Scratch &scratch);
    void Clear();
+   size_t MixTrack(size_t trackIndex, Scratch &scratch);
    size_t MixSameRate(int *channelFlags, WaveTrackCache &cache,
-                           sampleCount *pos);
+                           sampleCount *pos, Scratch &scratch);
 
    size_t MixVariableRates(int *channelFlags, WaveTrackCache &cache,
                                 sampleCount *pos, float *queue,
                                 int *queueStart, int *queueLen,
-                                Resample * pResample);
+                                Resample * pResample, Scratch &scratch);
 
    void MakeResamplers();
 
@@ -167,7 +195,6 @@ class AUDACITY_DLL_API Mixer {
    const BoundedEnvelope *mEnvelope;
    ArrayOf<sampleCount> mSamplePos;
    bool             mApplyTrackGains;
-   Doubles          mEnvValues;
    double           mT0; // Start time
    double           mT1; // Stop time (none if mT0==mT1)
    double           mTime;  // Current time (renamed from mT to mTime for consistency with AudioIO - mT represented warped time there)
@@ -182,14 +209,14 @@ class AUDACITY_DLL_API Mixer {
    // Output
    size_t              mMaxOut;
    unsigned         mNumChannels;
-   Floats           mGains;
    unsigned         mNumBuffers;
    size_t              mBufferSize;
    size_t              mInterleavedBufferSize;
    sampleFormat     mFormat;
    bool             mInterleaved;
-   ArrayOf<SampleBuffer> mBuffer, mTemp;
-   Floats           mFloatBuffer;
+   ArrayOf<SampleBuffer> mBuffer;
+   std::vector<Scratch> mScratch;
+   unsigned         mNumWorkers{ 1 };
    double           mRate;
    double           mSpeed;
    bool             mHighQuality;
@@ -14,6 +14,7 @@
 
 #include "Experimental.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <math.h>
 
@@ -525,137 +526,53 @@ void MixerTrackCluster::UpdateMeter(const double t0, const double t1)
       return;
    }
 
-   // Vaughan, 2010-11-27:
-   // This commented out code is flawed. Mistaken understanding of "frame" vs "window".
-   // Caused me to override MeterPanel::UpdateDisplay().
-   // But I think it's got a good idea, of calling WaveTracks' GetMinMax and GetRMS
-   // instead of passing in all the data and asking the meter to derive peak and rms.
-   // May be worth revisiting as I think it should perform better, because it uses the min/max/rms
-   // stored in blockfiles, rather than calculating them, but for now, changing it to use the
-   // original MeterPanel::UpdateDisplay(). New code is below the previous (now commented out).
-   //
-   //const size_t kFramesPerBuffer = 4;
-   //float min; // dummy, since it's not shown in meters
-   //Floats maxLeft{kFramesPerBuffer};
-   //Floats rmsLeft{kFramesPerBuffer};
-   //Floats maxRight{kFramesPerBuffer};
-   //Floats rmsRight{kFramesPerBuffer};
-   //
-   //#ifdef EXPERIMENTAL_MIDI_OUT
-   //   bool bSuccess = (GetWave() != nullptr);
-   //#else
-   //   bool bSuccess = true;
-   //#endif
-
-   //const double dFrameInterval = (t1 - t0) / (double)kFramesPerBuffer;
-   //double dFrameT0 = t0;
-   //double dFrameT1 = t0 + dFrameInterval;
-   //int i = 0;
-   //while (bSuccess && (i < kFramesPerBuffer))
-   //{
-   //   bSuccess &=
-   //      mTrack->GetMinMax(&min, &(maxLeft[i]), dFrameT0, dFrameT1) &&
-   //      mTrack->GetRMS(&(rmsLeft[i]), dFrameT0, dFrameT1);
-   //   if (bSuccess && mRightTrack)
-   //      bSuccess &=
-   //         mRightTrack->GetMinMax(&min, &(maxRight[i]), dFrameT0, dFrameT1) &&
-   //         mRightTrack->GetRMS(&(rmsRight[i]), dFrameT0, dFrameT1);
-   //   else
-   //   {
-   //      // Mono: Start with raw values same as left.
-   //      // To be modified by bWantPostFadeValues and channel pan/gain.
-   //      maxRight[i] = maxLeft[i];
-   //      rmsRight[i] = rmsLeft[i];
-   //   }
-   //   dFrameT0 += dFrameInterval;
-   //   dFrameT1 += dFrameInterval;
-   //   i++;
-   //}
-   //
-   //const bool bWantPostFadeValues = true; //v Turn this into a checkbox on MixerBoard? For now, always true.
-   //if (bSuccess && bWantPostFadeValues)
-   //if (bSuccess)
-   //{
-   //   for (i = 0; i < kFramesPerBuffer; i++)
-   //   {
-   //      float gain = mTrack->GetChannelGain(0);
-   //      maxLeft[i] *= gain;
-   //      rmsLeft[i] *= gain;
-   //      if (mRightTrack)
-   //         gain = mRightTrack->GetChannelGain(1);
-   //      maxRight[i] *= gain;
-   //      rmsRight[i] *= gain;
-   //   }
-   //   if ( mMeter ) mMeter->UpdateDisplay(
-   //      2, // If mono, show left track values in both meters, as in MeterToolBar, rather than nChannels.
-   //      kFramesPerBuffer,
-   //      maxLeft, rmsLeft,
-   //      maxRight, rmsRight,
-   //      mTrack->TimeToLongSamples(t1 - t0));
-   //}
-   //
-
+   // Derive per-channel peak and RMS from the min/max/rms stored in the
+   // block files, rather than rereading and interleaving every sample
+   // played since the last timer tick; with many strips visible those
+   // sample reads and temporaries dominated the cost of this update.
    const auto pTrack = GetWave();
-   auto startSample = (sampleCount)((pTrack->GetRate() * t0) + 0.5);
-   auto scnFrames = (sampleCount)((pTrack->GetRate() * (t1 - t0)) + 0.5);
 
    // Expect that the difference of t1 and t0 is the part of a track played
    // in about 1/20 second (ticks of TrackPanel timer), so this won't overflow
-   auto nFrames = scnFrames.as_size_t();
-
-   Floats tempFloatsArray{ nFrames };
-   decltype(tempFloatsArray) meterFloatsArray;
-   // Don't throw on read error in this drawing update routine
-   bool bSuccess = pTrack->Get((samplePtr)tempFloatsArray.get(),
-      floatSample, startSample, nFrames, fillZero, false);
-   if (bSuccess)
-   {
-      // We always pass a stereo sample array to the meter, as it shows 2 channels.
+   auto nFrames =
+      ((sampleCount)((pTrack->GetRate() * (t1 - t0)) + 0.5)).as_size_t();
+
+   // Don't throw on read errors in this drawing update routine
+   float peak[2], rms[2];
+   const auto left = pTrack->GetMinMax(t0, t1, false);
+   peak[0] = std::max(fabsf(left.first), fabsf(left.second));
+   rms[0] = pTrack->GetRMS(t0, t1, false);
+   if (GetRight()) {
+      const auto right = GetRight()->GetMinMax(t0, t1, false);
+      peak[1] = std::max(fabsf(right.first), fabsf(right.second));
+      rms[1] = GetRight()->GetRMS(t0, t1, false);
+   }
+   else {
+      // We always pass two channels to the meter, as it shows 2 channels.
       // Mono shows same in both meters.
-      // Since we're not mixing, need to duplicate same signal for "right" channel in mono case.
-      meterFloatsArray = Floats{ 2 * nFrames };
-
-      // Interleave for stereo. Left/mono first.
-      for (unsigned int index = 0; index < nFrames; index++)
-         meterFloatsArray[2 * index] = tempFloatsArray[index];
-
-      if (GetRight())
-         // Again, don't throw
-         bSuccess = GetRight()->Get((samplePtr)tempFloatsArray.get(),
-            floatSample, startSample, nFrames, fillZero, false);
-
-      if (bSuccess)
-         // Interleave right channel, or duplicate same signal for "right" channel in mono case.
-         for (unsigned int index = 0; index < nFrames; index++)
-            meterFloatsArray[(2 * index) + 1] = tempFloatsArray[index];
+      peak[1] = peak[0];
+      rms[1] = rms[0];
    }
 
-   //const bool bWantPostFadeValues = true; //v Turn this into a checkbox on MixerBoard? For now, always true.
-   //if (bSuccess && bWantPostFadeValues)
-   if (bSuccess)
-   {
-      //vvv Need to apply envelope, too? See Mixer::MixSameRate.
-      float gain = pTrack->GetChannelGain(0);
-      for (unsigned int index = 0; index < nFrames; index++)
-         meterFloatsArray[2 * index] *= gain;
-      if (GetRight())
-         gain = GetRight()->GetChannelGain(1);
-      else
-         gain = pTrack->GetChannelGain(1);
-      for (unsigned int index = 0; index < nFrames; index++)
-         meterFloatsArray[(2 * index) + 1] *= gain;
-      // Clip to [-1.0, 1.0] range.
-      for (unsigned int index = 0; index < 2 * nFrames; index++)
-         if (meterFloatsArray[index] < -1.0)
-            meterFloatsArray[index] = -1.0;
-         else if (meterFloatsArray[index] > 1.0)
-            meterFloatsArray[index] = 1.0;
-
-      if (mMeter)
-         mMeter->UpdateDisplay(2, nFrames, meterFloatsArray.get());
-   }
+   //vvv Need to apply envelope, too? See Mixer::MixSameRate.
+   float gain = pTrack->GetChannelGain(0);
+   peak[0] *= gain;
+   rms[0] *= gain;
+   if (GetRight())
+      gain = GetRight()->GetChannelGain(1);
    else
-      this->ResetMeter(false);
+      gain = pTrack->GetChannelGain(1);
+   peak[1] *= gain;
+   rms[1] *= gain;
+
+   // Clip to [0.0, 1.0] range
+   for (unsigned int index = 0; index < 2; index++) {
+      peak[index] = std::min(1.0f, peak[index]);
+      rms[index] = std::min(1.0f, rms[index]);
+   }
+
+   if (mMeter)
+      mMeter->UpdateDisplay(2, nFrames, peak, rms);
 }
 
 // private
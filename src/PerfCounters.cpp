@@ -0,0 +1,139 @@
+/**********************************************************************
+
+  Audacity: A Digital Audio Editor
+
+  PerfCounters.cpp
+
+*******************************************************************//**
+
+\class PerfCounters
+\brief Always-on aggregation of time spent in a fixed set of hot paths.
+
+Each thread that records into a counter owns a block of atomic slots,
+found through a thread-local pointer, so the recording side never takes
+a lock.  The blocks are registered in a global list and deliberately
+kept alive after their thread exits, so that a report taken at the end
+of a session still covers short-lived worker threads.
+
+*//********************************************************************/
+
+#include "Audacity.h"
+#include "PerfCounters.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+const wxChar *const sNames[PerfCounters::nCounters] = {
+   wxT("audioCallback"),
+   wxT("fillBuffers"),
+   wxT("trackPanelPaint"),
+   wxT("effectProcess"),
+   wxT("blockFileIO"),
+};
+
+struct Slot {
+   std::atomic<long long> count{ 0 };
+   std::atomic<long long> totalMicros{ 0 };
+   std::atomic<long long> maxMicros{ 0 };
+};
+
+struct ThreadSlots {
+   Slot slots[PerfCounters::nCounters];
+};
+
+std::mutex &RegistryMutex()
+{
+   static std::mutex mutex;
+   return mutex;
+}
+
+std::vector<std::unique_ptr<ThreadSlots>> &Registry()
+{
+   static std::vector<std::unique_ptr<ThreadSlots>> registry;
+   return registry;
+}
+
+ThreadSlots &LocalSlots()
+{
+   // Registration takes the lock once per thread lifetime; recording
+   // afterward goes straight to the cached pointer
+   static thread_local ThreadSlots *pSlots = [] {
+      auto slots = std::make_unique<ThreadSlots>();
+      const auto result = slots.get();
+      std::lock_guard<std::mutex> guard{ RegistryMutex() };
+      Registry().push_back(std::move(slots));
+      return result;
+   }();
+   return *pSlots;
+}
+
+}
+
+void PerfCounters::Record(Counter counter, long long micros)
+{
+   auto &slot = LocalSlots().slots[counter];
+   slot.count.fetch_add(1, std::memory_order_relaxed);
+   slot.totalMicros.fetch_add(micros, std::memory_order_relaxed);
+   auto prev = slot.maxMicros.load(std::memory_order_relaxed);
+   while (prev < micros &&
+          !slot.maxMicros.compare_exchange_weak(
+             prev, micros, std::memory_order_relaxed))
+      ;
+}
+
+auto PerfCounters::GetSnapshots() -> std::vector<Snapshot>
+{
+   std::vector<Snapshot> results;
+   results.reserve(nCounters);
+
+   std::lock_guard<std::mutex> guard{ RegistryMutex() };
+   for (int counter = 0; counter < nCounters; counter++) {
+      Snapshot snapshot{ sNames[counter], 0, 0, 0 };
+      for (const auto &pSlots : Registry()) {
+         auto &slot = pSlots->slots[counter];
+         snapshot.count += slot.count.load(std::memory_order_relaxed);
+         snapshot.totalMicros +=
+            slot.totalMicros.load(std::memory_order_relaxed);
+         snapshot.maxMicros = std::max(snapshot.maxMicros,
+            slot.maxMicros.load(std::memory_order_relaxed));
+      }
+      results.push_back(snapshot);
+   }
+   return results;
+}
+
+void PerfCounters::Reset()
+{
+   // Intervals recorded while the reset is in progress may be lost;
+   // that is acceptable for a diagnostic tool
+   std::lock_guard<std::mutex> guard{ RegistryMutex() };
+   for (const auto &pSlots : Registry())
+      for (auto &slot : pSlots->slots) {
+         slot.count.store(0, std::memory_order_relaxed);
+         slot.totalMicros.store(0, std::memory_order_relaxed);
+         slot.maxMicros.store(0, std::memory_order_relaxed);
+      }
+}
+
+wxString PerfCounters::Report()
+{
+   wxString report;
+   report += wxT("counter            calls       total ms     mean us      max us\n");
+   for (const auto &snapshot : GetSnapshots()) {
+      const double mean = snapshot.count
+         ? double(snapshot.totalMicros) / snapshot.count
+         : 0.0;
+      report += wxString::Format(
+         wxT("%-16s %9lld %12.1f %11.1f %11lld\n"),
+         snapshot.name,
+         snapshot.count,
+         snapshot.totalMicros / 1000.0,
+         mean,
+         snapshot.maxMicros);
+   }
+   return report;
+}
@@ -0,0 +1,84 @@
+/**********************************************************************
+
+  Audacity: A Digital Audio Editor
+
+  PerfCounters.h
+
+  Provides always-on scoped timers for a fixed set of hot paths.
+  Unlike the countdown macros in Diags.h, these keep aggregating for
+  the whole session, so totals and worst cases can be inspected from
+  the Help menu or dumped through the scripting interface long after
+  a dropout happened.
+
+**********************************************************************/
+
+#ifndef __AUDACITY_PERF_COUNTERS__
+#define __AUDACITY_PERF_COUNTERS__
+
+#include "Audacity.h"
+
+#include <chrono>
+#include <vector>
+
+#include <wx/string.h>
+
+class PerfCounters
+{
+public:
+   enum Counter : int {
+      AudioCallback,
+      FillBuffers,
+      TrackPanelPaint,
+      EffectProcess,
+      BlockFileIO,
+
+      nCounters
+   };
+
+   // Aggregated numbers for one counter, summed over all threads
+   struct Snapshot {
+      const wxChar *name;
+      long long count;
+      long long totalMicros;
+      long long maxMicros;
+   };
+
+   // Aggregation only; the cost on the recording thread is two relaxed
+   // atomic additions and a compare-exchange on thread-local storage
+   static void Record(Counter counter, long long micros);
+
+   static std::vector<Snapshot> GetSnapshots();
+   static void Reset();
+
+   // Human-readable table of all counters, for the diagnostics window
+   static wxString Report();
+
+   // Times the enclosing scope and records the elapsed interval.
+   // Cheap enough for the audio callback; does not allocate or lock
+   // after the first use on each thread.
+   class Scope
+   {
+   public:
+      explicit Scope(Counter counter)
+         : mCounter{ counter }
+         , mStart{ std::chrono::steady_clock::now() }
+      {}
+
+      Scope(const Scope&) = delete;
+      Scope &operator= (const Scope&) = delete;
+
+      ~Scope()
+      {
+         const auto elapsed =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - mStart).count();
+         Record(mCounter, elapsed);
+      }
+
+   private:
+      const Counter mCounter;
+      const std::chrono::steady_clock::time_point mStart;
+   };
+};
+
+#endif
@@ -1071,6 +1071,7 @@ PluginDescriptor::PluginDescriptor()
    mPluginType = PluginTypeNone;
    mEnabled = false;
    mValid = false;
+   mValidatedModTime = 0;
    mInstance = NULL;
 
    mEffectType = EffectTypeNone;
@@ -1175,6 +1176,11 @@ bool PluginDescriptor::IsValid() const
    return mValid;
 }
 
+wxLongLong_t PluginDescriptor::GetValidatedModTime() const
+{
+   return mValidatedModTime;
+}
+
 void PluginDescriptor::SetPluginType(PluginType type)
 {
    mPluginType = type;
@@ -1220,6 +1226,11 @@ void PluginDescriptor::SetValid(bool valid)
    mValid = valid;
 }
 
+void PluginDescriptor::SetValidatedModTime(wxLongLong_t time)
+{
+   mValidatedModTime = time;
+}
+
 // Effects
 
 wxString PluginDescriptor::GetEffectFamily() const
@@ -2107,6 +2118,13 @@ void PluginManager::LoadGroup(wxFileConfig *pRegistry, PluginType type)
       pRegistry->Read(KEY_VALID, &boolVal, false);
       plug.SetValid(boolVal);
 
+      // When was it last validated...default to never if not found,
+      // as in registries written by older versions
+      pRegistry->Read(KEY_LASTUPDATED, &strVal, wxEmptyString);
+      wxLongLong_t modTime = 0;
+      if (strVal.ToLongLong(&modTime))
+         plug.SetValidatedModTime(modTime);
+
       switch (type)
       {
          case PluginTypeModule:
@@ -2287,6 +2305,8 @@ void PluginManager::SaveGroup(wxFileConfig *pRegistry, PluginType type)
       pRegistry->Write(KEY_PROVIDERID, plug.GetProviderID());
       pRegistry->Write(KEY_ENABLED, plug.IsEnabled());
       pRegistry->Write(KEY_VALID, plug.IsValid());
+      pRegistry->Write(KEY_LASTUPDATED,
+         wxString::Format(wxT("%lld"), plug.GetValidatedModTime()));
 
       switch (type)
       {
@@ -2342,6 +2362,24 @@ void PluginManager::SaveGroup(wxFileConfig *pRegistry, PluginType type)
    return;
 }
 
+// Modification time of the file behind a plugin path, or 0 if there is
+// no such file.  A path may carry a suffix after a semicolon (as for VST
+// shell plugins) that is not part of the file name, and some plugins
+// (such as bundles on Mac) are directories.
+static wxLongLong_t PluginModificationTime(const PluginPath &path)
+{
+   const wxString fileName = path.BeforeFirst(wxT(';'));
+   if (fileName.empty())
+      return 0;
+   wxFileName fn = wxFileName::DirExists(fileName)
+      ? wxFileName::DirName(fileName)
+      : wxFileName::FileName(fileName);
+   wxDateTime time;
+   if (!fn.GetTimes(NULL, &time, NULL))
+      return 0;
+   return time.GetValue().GetValue();
+}
+
 // If bFast is true, do not do a full check.  Just check the ones
 // that are quick to check.  Currently (Feb 2017) just Nyquist
 // and built-ins.
@@ -2422,7 +2460,19 @@ void PluginManager::CheckForUpdates(bool bFast)
       }
       else if (plugType != PluginTypeNone && plugType != PluginTypeStub)
       {
-         plug.SetValid(mm.IsPluginValid(plug.GetProviderID(), plugPath, bFast));
+         // Revalidating a plugin can mean loading its library, which
+         // dominates the cost of this scan on hosts with many effects
+         // installed.  Trust the outcome of the last full validation as
+         // long as the file behind the plugin is unchanged on disk.
+         const wxLongLong_t modTime = PluginModificationTime(plugPath);
+         const bool unchanged =
+            modTime != 0 && modTime == plug.GetValidatedModTime();
+         if (!unchanged)
+         {
+            plug.SetValid(mm.IsPluginValid(plug.GetProviderID(), plugPath, bFast));
+            if (!bFast)
+               plug.SetValidatedModTime(plug.IsValid() ? modTime : 0);
+         }
          if (!plug.IsValid())
          {
             plug.SetEnabled(false);
@@ -70,6 +70,11 @@ public:
    bool IsEnabled() const;
    bool IsValid() const;
 
+   // Modification time of the file behind the plugin when it was last
+   // fully validated, or 0 if it never has been; lets startup skip the
+   // expensive revalidation of plugins whose files are unchanged on disk
+   wxLongLong_t GetValidatedModTime() const;
+
    // These should be passed an untranslated value
    void SetID(const PluginID & ID);
    void SetProviderID(const PluginID & providerID);
@@ -83,6 +88,7 @@ public:
 
    void SetEnabled(bool enable);
    void SetValid(bool valid);
+   void SetValidatedModTime(wxLongLong_t time);
 
    // Effect plugins only
 
@@ -139,6 +145,7 @@ private:
    wxString mProviderID;
    bool mEnabled;
    bool mValid;
+   wxLongLong_t mValidatedModTime;
 
    // Effects
 
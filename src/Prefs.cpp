@@ -204,6 +204,64 @@ bool AudacityPrefs::GetEditClipsCanMove()
    return editClipsCanMove;
 }
 
+bool AudacityPrefs::Flush(bool bCurrentOnly)
+{
+   // Writes have already updated the in-memory data, so readers see them at
+   // once.  Rewriting the whole file is the slow part -- very noticeable when
+   // the settings file lives on a network share -- so coalesce the flushes
+   // made while a dialog commits its changes and do one rewrite at idle time.
+   if (wxTheApp && !bCurrentOnly) {
+      if (!mFlushPending) {
+         mFlushPending = true;
+         wxTheApp->CallAfter([this]{
+            // InitPreferences runs once, so this test suffices to know the
+            // object still lives
+            if (gPrefs == this && mFlushPending)
+               ForceFlush();
+         });
+      }
+      return true;
+   }
+   mFlushPending = false;
+   return wxFileConfig::Flush(bCurrentOnly);
+}
+
+bool AudacityPrefs::ForceFlush()
+{
+   mFlushPending = false;
+   return wxFileConfig::Flush();
+}
+
+bool AudacityPrefs::DoWriteString(const wxString& key, const wxString& value)
+{
+   mVersion++;
+   return wxFileConfig::DoWriteString(key, value);
+}
+
+bool AudacityPrefs::DoWriteLong(const wxString& key, long value)
+{
+   mVersion++;
+   return wxFileConfig::DoWriteLong(key, value);
+}
+
+bool AudacityPrefs::DeleteEntry(const wxString& key, bool bDeleteGroupIfEmpty)
+{
+   mVersion++;
+   return wxFileConfig::DeleteEntry(key, bDeleteGroupIfEmpty);
+}
+
+bool AudacityPrefs::DeleteGroup(const wxString& key)
+{
+   mVersion++;
+   return wxFileConfig::DeleteGroup(key);
+}
+
+bool AudacityPrefs::DeleteAll()
+{
+   mVersion++;
+   return wxFileConfig::DeleteAll();
+}
+
 void InitPreferences( const wxFileName &configFileName )
 {
    wxString appName = wxTheApp->GetAppName();
@@ -219,7 +277,8 @@ void InitPreferences( const wxFileName &configFileName )
 
 bool CheckWritablePreferences()
 {
-   return gPrefs->Write("/TEST", true) && gPrefs->Flush();
+   // A real write must happen here; deferring it would hide the failure
+   return gPrefs->Write("/TEST", true) && gPrefs->ForceFlush();
 }
 
 wxString UnwritablePreferencesErrorMessage( const wxFileName &configFileName )
@@ -233,6 +292,7 @@ wxString UnwritablePreferencesErrorMessage( const wxFileName &configFileName )
 void FinishPreferences()
 {
    if (gPrefs) {
+      gPrefs->ForceFlush();
       wxConfigBase::Set(NULL);
       ugPrefs.reset();
       gPrefs = NULL;
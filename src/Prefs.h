@@ -65,6 +65,23 @@ public:
                const wxMBConv& conv = wxConvAuto());
    bool GetEditClipsCanMove();
 
+   // Counter of writes and deletions, used by CachedPref to decide when a
+   // materialized value may be stale
+   size_t GetVersion() const { return mVersion; }
+
+   // Writes stay in memory until the event loop is idle; many successive
+   // Flush calls, as when a dialog commits several pages of settings, cost
+   // one rewrite of the file instead of one each
+   bool Flush(bool bCurrentOnly = false) override;
+
+   // Rewrite the file now, not at idle time; needed before shutdown and
+   // when the caller must learn whether the file is writable
+   bool ForceFlush();
+
+   bool DeleteEntry(const wxString& key, bool bDeleteGroupIfEmpty = true) override;
+   bool DeleteGroup(const wxString& key) override;
+   bool DeleteAll() override;
+
    // Set and Get values of the version major/minor/micro keys in audacity.cfg when Audacity first opens
    void SetVersionKeysInit( int major, int minor, int micro)
    {
@@ -84,6 +101,55 @@ public:
    int mVersionMajorKeyInit{};
    int mVersionMinorKeyInit{};
    int mVersionMicroKeyInit{};
+
+protected:
+   bool DoWriteString(const wxString& key, const wxString& value) override;
+   bool DoWriteLong(const wxString& key, long value) override;
+
+private:
+   size_t mVersion { 0 };
+   bool mFlushPending { false };
+};
+
+/// Typed cache of one preference value.  Read() performs the string-keyed
+/// lookup only when something has been written to gPrefs since the last
+/// call, so repeated reads in paint and transport code cost a counter
+/// comparison.  Objects of this class are usually function-local statics
+/// or members of long-lived objects.
+template< typename T >
+class CachedPref
+{
+public:
+   CachedPref( const wxString &key, const T &defaultValue )
+      : mKey{ key }
+      , mDefault{ defaultValue }
+      , mValue{ defaultValue }
+   {}
+
+   const wxString &Key() const { return mKey; }
+
+   const T &Read() const
+   {
+      auto version = gPrefs->GetVersion();
+      if ( !mValid || version != mVersion ) {
+         gPrefs->Read( mKey, &mValue, mDefault );
+         mVersion = version;
+         mValid = true;
+      }
+      return mValue;
+   }
+
+   bool Write( const T &value ) // you flush gPrefs afterward
+   {
+      return gPrefs->Write( mKey, value );
+   }
+
+private:
+   const wxString mKey;
+   const T mDefault;
+   mutable T mValue;
+   mutable size_t mVersion { 0 };
+   mutable bool mValid { false };
 };
 
 /// Packages a table of user-visible choices each with an internal code string,
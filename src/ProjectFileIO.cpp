@@ -11,6 +11,7 @@ Paul Licameli split from AudacityProject.cpp
 #include "ProjectFileIO.h"
 
 #include <wx/frame.h>
+#include <wx/statusbr.h>
 
 #include "AutoRecovery.h"
 #include "DirManager.h"
@@ -18,7 +19,10 @@ Paul Licameli split from AudacityProject.cpp
 #include "Project.h"
 #include "ProjectFileIORegistry.h"
 #include "ProjectSettings.h"
+#include "ProjectStatus.h"
+#include "ProjectWindow.h"
 #include "Tags.h"
+#include "TrackPanel.h"
 #include "ViewInfo.h"
 #include "WaveTrack.h"
 #include "widgets/AudacityMessageBox.h"
@@ -92,7 +96,12 @@ ProjectFileIO::ProjectFileIO( AudacityProject &project )
    UpdatePrefs();
 }
 
-ProjectFileIO::~ProjectFileIO() = default;
+ProjectFileIO::~ProjectFileIO()
+{
+   // Let any background autosave write finish before the project goes away
+   if (mAutoSavePending.valid())
+      mAutoSavePending.wait();
+}
 
 void ProjectFileIO::UpdatePrefs()
 {
@@ -130,6 +139,13 @@ void ProjectFileIO::SetProjectTitle( int number)
       name += _("(Recovered)");
    }
 
+   if ( IsReadOnly() )
+   {
+      name += wxT(" ");
+      /* i18n-hint: The project is open for viewing, not for changing.*/
+      name += _("(Read-Only)");
+   }
+
    window.SetTitle( name );
    window.SetName(name);       // to make the nvda screen reader read the correct title
 }
@@ -389,6 +405,10 @@ bool ProjectFileIO::HandleXMLTag(const wxChar *tag, const wxChar **attrs)
    if (requiredTags < 3)
       return false;
 
+   // Children of this tag will now be parsed; any tracks present already
+   // (normally none) need no repaint
+   mTracksShownDuringLoad = TrackList::Get( project ).size();
+
    // All other tests passed, so we succeed
    return true;
 }
@@ -396,6 +416,13 @@ bool ProjectFileIO::HandleXMLTag(const wxChar *tag, const wxChar **attrs)
 XMLTagHandler *ProjectFileIO::HandleXMLChild(const wxChar *tag)
 {
    auto &project = mProject;
+
+   // The parser asks for the next child only after the previous child's
+   // whole subtree has been handled, so every track now in the list is
+   // completely loaded.  Paint the NEW ones before parsing continues, so
+   // that the top of a long project can be reviewed while the rest loads.
+   ShowTracksLoadedSoFar();
+
    auto fn = ProjectFileIORegistry::Lookup( tag );
    if (fn)
       return fn( project );
@@ -403,6 +430,40 @@ XMLTagHandler *ProjectFileIO::HandleXMLChild(const wxChar *tag)
    return nullptr;
 }
 
+void ProjectFileIO::ShowTracksLoadedSoFar()
+{
+   auto &project = mProject;
+   auto &tracks = TrackList::Get( project );
+   const auto count = tracks.size();
+   if (count == mTracksShownDuringLoad)
+      return;
+   mTracksShownDuringLoad = count;
+
+   auto pWindow = ProjectWindow::Find( &project );
+   if (!pWindow || !pWindow->IsShown())
+      return;
+
+   // Size the scrollbars for the tracks loaded so far and force the
+   // repaint to happen now.  No events are dispatched, so the parse
+   // cannot be re-entered while the window updates.
+   pWindow->HandleResize();
+   auto &trackPanel = TrackPanel::Get( project );
+   trackPanel.Refresh( false );
+   trackPanel.Update();
+
+   // Write the status bar directly, as ProjectManager::OnTimer does:
+   // ProjectStatus coalesces bursts with a timer, which cannot fire
+   // until the parse finishes.  Do not change the recorded message.
+   auto pStatusBar = pWindow->GetStatusBar();
+   if (pStatusBar) {
+      /* i18n-hint: %d is a number of audio tracks */
+      auto msg = wxString::Format(
+         _("Loading project: %d tracks so far"), (int)count );
+      pStatusBar->SetStatusText( msg, mainStatusBarField );
+      pStatusBar->Update();
+   }
+}
+
 void ProjectFileIO::WriteXMLHeader(XMLWriter &xmlFile) const
 {
    xmlFile.Write(wxT("<?xml "));
@@ -563,10 +624,26 @@ private:
 
 void ProjectFileIO::AutoSave()
 {
+   if (mbReadOnly)
+      // A project open for review must leave no trace in the auto-save
+      // folder; other instances may be reviewing the same project
+      return;
+
    auto &project = mProject;
    auto &window = GetProjectFrame( project );
    //    SonifyBeginAutoSave(); // part of RBD's r10680 stuff now backed out
 
+   // If the previous autosave is still being written out in the background,
+   // wait for it, and report a failure now that we are on the main thread
+   if (mAutoSavePending.valid() && !mAutoSavePending.get())
+   {
+      AudacityMessageBox(
+         wxString::Format( _("Could not create autosave file: %s"),
+            mAutoSaveFileName ),
+         _("Error"), wxICON_STOP, &window);
+      mAutoSaveFileName = wxT("");
+   }
+
    // To minimize the possibility of race conditions, we first write to a
    // file with the extension ".tmp", then rename the file to .autosave
    wxString projName;
@@ -582,38 +659,38 @@ void ProjectFileIO::AutoSave()
 
    // PRL:  I found a try-catch and rewrote it,
    // but this guard is unnecessary because AutoSaveFile does not throw
+   auto buffer = std::make_shared< AutoSaveFile >();
    bool success = GuardedCall< bool >( [&]
    {
       VarSetter<bool> setter(&mAutoSaving, true, false);
 
-      AutoSaveFile buffer;
-      WriteXMLHeader( buffer );
-      WriteXML( buffer, nullptr );
-
-      wxFFile saveFile;
-      saveFile.Open(fn + wxT(".tmp"), wxT("wb"));
-      return buffer.Write(saveFile);
+      WriteXMLHeader( *buffer );
+      WriteXML( *buffer, nullptr );
+      return true;
    } );
 
    if (!success)
       return;
 
-   // Now that we have a NEW auto-save file, DELETE the old one
+   // Now that we will have a NEW auto-save file, DELETE the old one
    DeleteCurrentAutoSaveFile();
 
    if (!mAutoSaveFileName.empty())
       return; // could not remove auto-save file
 
-   if (!wxRenameFile(fn + wxT(".tmp"), fn + wxT(".autosave")))
+   // Serialization above gave us a consistent snapshot; the disk traffic,
+   // which can be slow for big projects, happens on a background thread so
+   // the project window stays responsive.  The next autosave (or explicit
+   // deletion) collects any failure.
+   mAutoSaveFileName = fn + wxT(".autosave");
+   mAutoSavePending = std::async( std::launch::async, [fn, buffer]
    {
-      AudacityMessageBox(
-         wxString::Format( _("Could not create autosave file: %s"),
-            fn + wxT(".autosave") ),
-         _("Error"), wxICON_STOP, &window);
-      return;
-   }
-
-   mAutoSaveFileName += fn + wxT(".autosave");
+      wxFFile saveFile;
+      saveFile.Open(fn + wxT(".tmp"), wxT("wb"));
+      if (!buffer->Write(saveFile))
+         return false;
+      return wxRenameFile(fn + wxT(".tmp"), fn + wxT(".autosave"));
+   } );
    // no-op cruft that's not #ifdefed for NoteTrack
    // See above for further comments.
    //   SonifyEndAutoSave();
@@ -623,6 +700,12 @@ void ProjectFileIO::DeleteCurrentAutoSaveFile()
 {
    auto &project = mProject;
    auto &window = GetProjectFrame( project );
+
+   // The file may still be being written out; wait for that first.  If the
+   // write failed there is simply no file to remove.
+   if (mAutoSavePending.valid())
+      mAutoSavePending.get();
+
    if (!mAutoSaveFileName.empty())
    {
       if (wxFileExists(mAutoSaveFileName))
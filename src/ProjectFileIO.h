@@ -15,6 +15,8 @@ Paul Licameli split from AudacityProject.h
 #include "Prefs.h" // to inherit
 #include "xml/XMLTagHandler.h" // to inherit
 
+#include <future>
+
 class AudacityProject;
 
 ///\brief Object associated with a project that manages reading and writing
@@ -51,6 +53,8 @@ public:
 
    bool IsRecovered() const { return mIsRecovered; }
    void SetIsRecovered( bool value ) { mIsRecovered = value; }
+   bool IsReadOnly() const { return mbReadOnly; }
+   void SetReadOnly( bool value ) { mbReadOnly = value; }
    bool IsLoadedFromAup() const { return mbLoadedFromAup; }
    void SetLoadedFromAup( bool value ) { mbLoadedFromAup = value; }
  
@@ -67,6 +71,10 @@ private:
    // XMLTagHandler callback methods
    bool HandleXMLTag(const wxChar *tag, const wxChar **attrs) override;
 
+   // Put tracks whose subtrees have finished parsing on screen, with a
+   // status message, while the rest of a long project still loads
+   void ShowTracksLoadedSoFar();
+
    void UpdatePrefs() override;
 
    // non-static data members
@@ -75,6 +83,10 @@ private:
    // Last auto-save file name and path (empty if none)
    FilePath mAutoSaveFileName;
 
+   // Background write of the last autosave buffer, if still running;
+   // yields false if that write failed
+   std::future<bool> mAutoSavePending;
+
    // Are we currently auto-saving or not?
    bool mAutoSaving{ false };
 
@@ -82,6 +94,13 @@ private:
    bool mIsRecovered{ false };
 
    bool mbLoadedFromAup{ false };
+
+   // Opened for review only; suppresses autosave and overwriting saves
+   bool mbReadOnly{ false };
+
+   // How many tracks ShowTracksLoadedSoFar has already put on screen
+   // during the current parse
+   size_t mTracksShownDuringLoad{ 0 };
 };
 
 class wxTopLevelWindow;
@@ -253,8 +253,11 @@ void ProjectFileManager::EnqueueODTasks()
 
 bool ProjectFileManager::Save()
 {
-   // Prompt for file name?
-   bool bPromptingRequired = !ProjectFileIO::Get( mProject ).IsProjectSaved();
+   // Prompt for file name?  Projects open for review are never
+   // overwritten in place; Save As must choose a NEW home.
+   auto &projectFileIO = ProjectFileIO::Get( mProject );
+   bool bPromptingRequired =
+      !projectFileIO.IsProjectSaved() || projectFileIO.IsReadOnly();
 
    if (bPromptingRequired)
       return SaveAs();
@@ -523,6 +526,14 @@ bool ProjectFileManager::DoSave (const bool fromSaveAs,
          dirManager.RemoveOrphanBlockfiles();
       }
 
+      if ( projectFileIO.IsReadOnly() )
+      {
+         // Save As gave the project a home of its own, so it is no
+         // longer merely under review
+         projectFileIO.SetReadOnly( false );
+         projectFileIO.SetProjectTitle();
+      }
+
       if (mLastSavedTracks)
          mLastSavedTracks->Clear();
       mLastSavedTracks = TrackList::Create();
@@ -1199,7 +1210,8 @@ ProjectFileManager::sImportHandlerFactory{
 
 // FIXME:? TRAP_ERR This should return a result that is checked.
 //    See comment in AudacityApp::MRUOpen().
-void ProjectFileManager::OpenFile(const FilePath &fileNameArg, bool addtohistory)
+void ProjectFileManager::OpenFile(const FilePath &fileNameArg, bool addtohistory,
+   bool bReadOnly)
 {
    auto &project = mProject;
    auto &history = ProjectHistory::Get( project );
@@ -1319,6 +1331,9 @@ void ProjectFileManager::OpenFile(const FilePath &fileNameArg, bool addtohistory
       return;
    }
 
+   // Establish review mode before anything can autosave or write back
+   projectFileIO.SetReadOnly( bReadOnly );
+
    // The handlers may be created during ReadProjectFile and are not needed
    // after this function exits.
    auto cleanupHandlers = finally( [this]{
@@ -1370,9 +1385,11 @@ void ProjectFileManager::OpenFile(const FilePath &fileNameArg, bool addtohistory
       ODManager::UnmarkLoadedODFlag();
 
       if (! closed ) {
-         if ( bParseSuccess ) {
+         if ( bParseSuccess && !bReadOnly ) {
             // This is a no-fail:
             dirManager.FillBlockfilesCache();
+            // Not in review mode:  on-demand tasks write summary files
+            // into the project directory
             EnqueueODTasks();
          }
 
@@ -1385,7 +1402,13 @@ void ProjectFileManager::OpenFile(const FilePath &fileNameArg, bool addtohistory
    if (bParseSuccess) {
       bool saved = false;
 
-      if (projectFileIO.IsRecovered())
+      if (bReadOnly)
+      {
+         // Review mode:  run no filesystem check at all, since its
+         // repairs write into the project directory, and do not delete
+         // any auto-save file either
+      }
+      else if (projectFileIO.IsRecovered())
       {
          // This project has been recovered, so write a NEW auto-save file
          // now and then DELETE the old one in the auto-save folder. Note that
@@ -1445,7 +1468,7 @@ void ProjectFileManager::OpenFile(const FilePath &fileNameArg, bool addtohistory
          }
       }
 
-      if (mImportXMLTagHandler) {
+      if (mImportXMLTagHandler && !bReadOnly) {
          if (!saved)
             // We processed an <import> tag, so save it as a normal project,
             // with no <import> tags.
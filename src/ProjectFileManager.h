@@ -99,7 +99,12 @@ public:
 
    static bool IsAlreadyOpen(const FilePath &projPathName);
 
-   void OpenFile(const FilePath &fileName, bool addtohistory = true);
+   // When bReadOnly, the project is opened for review only:  the project
+   // checker makes no repairs on disk, autosave is suppressed, and Save
+   // is redirected to Save As, so several instances may safely share one
+   // project directory
+   void OpenFile(const FilePath &fileName, bool addtohistory = true,
+      bool bReadOnly = false);
 
    // If pNewTrackList is passed in non-NULL, it gets filled with the pointers to NEW tracks.
    bool Import(const FilePath &fileName, WaveTrackArray *pTrackArray = NULL);
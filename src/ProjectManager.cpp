@@ -60,6 +60,12 @@ Paul Licameli split from AudacityProject.cpp
 #endif
 
 const int AudacityProjectTimerID = 5200;
+const int AudacityProjectStatusTimerID = 5201;
+
+// Minimum milliseconds between status bar updates; about one display refresh.
+// During playback and dragging the status may be set hundreds of times a
+// second, and each push to the status bar is a layout pass.
+const int StatusUpdateInterval = 1000 / 60;
 
 static AudacityProject::AttachedObjects::RegisteredFactory sProjectManagerKey {
    []( AudacityProject &project ) {
@@ -80,6 +86,7 @@ const ProjectManager &ProjectManager::Get( const AudacityProject &project )
 ProjectManager::ProjectManager( AudacityProject &project )
    : mProject{ project }
    , mTimer{ std::make_unique<wxTimer>(this, AudacityProjectTimerID) }
+   , mStatusTimer{ std::make_unique<wxTimer>(this, AudacityProjectStatusTimerID) }
 {
    auto &window = ProjectWindow::Get( mProject );
    window.Bind( wxEVT_CLOSE_WINDOW, &ProjectManager::OnCloseWindow, this );
@@ -100,6 +107,7 @@ wxDEFINE_EVENT(EVT_OPEN_AUDIO_FILE, wxCommandEvent);
 BEGIN_EVENT_TABLE( ProjectManager, wxEvtHandler )
    EVT_COMMAND(wxID_ANY, EVT_OPEN_AUDIO_FILE, ProjectManager::OnOpenAudioFile)
    EVT_TIMER(AudacityProjectTimerID, ProjectManager::OnTimer)
+   EVT_TIMER(AudacityProjectStatusTimerID, ProjectManager::OnStatusTimer)
 END_EVENT_TABLE()
 
 bool ProjectManager::sbWindowRectAlreadySaved = false;
@@ -883,7 +891,8 @@ void ProjectManager::OpenFiles(AudacityProject *proj)
 }
 
 AudacityProject *ProjectManager::OpenProject(
-   AudacityProject *pProject, const FilePath &fileNameArg, bool addtohistory)
+   AudacityProject *pProject, const FilePath &fileNameArg, bool addtohistory,
+   bool bReadOnly)
 {
    AudacityProject *pNewProject = nullptr;
    if ( ! pProject )
@@ -892,7 +901,8 @@ AudacityProject *ProjectManager::OpenProject(
       if( pNewProject )
          GetProjectFrame( *pNewProject ).Close(true);
    } );
-   ProjectFileManager::Get( *pProject ).OpenFile( fileNameArg, addtohistory );
+   ProjectFileManager::Get( *pProject ).OpenFile(
+      fileNameArg, addtohistory, bReadOnly );
    pNewProject = nullptr;
    auto &projectFileIO = ProjectFileIO::Get( *pProject );
    if( projectFileIO.IsRecovered() ) {
@@ -1004,6 +1014,30 @@ void ProjectManager::OnStatusChange( wxCommandEvent &evt )
 {
    evt.Skip();
 
+   mPendingStatusFields |= (1u << evt.GetInt());
+
+   // ProjectStatus already filtered out no-change settings.  Here coalesce
+   // the bursts that remain, as during playback and dragging: the first
+   // message of a burst shows at once, the rest wait for the timer, so the
+   // status bar relayouts happen at most once per display refresh.
+   if ( !mStatusTimer->IsRunning() ) {
+      DoStatusUpdates();
+      mStatusTimer->StartOnce( StatusUpdateInterval );
+   }
+}
+
+void ProjectManager::OnStatusTimer(wxTimerEvent & WXUNUSED(event))
+{
+   DoStatusUpdates();
+}
+
+void ProjectManager::DoStatusUpdates()
+{
+   auto fields = mPendingStatusFields;
+   mPendingStatusFields = 0;
+   if ( !fields )
+      return;
+
    auto &project = mProject;
 
    // Be careful to null-check the window.  We might get to this function
@@ -1016,15 +1050,19 @@ void ProjectManager::OnStatusChange( wxCommandEvent &evt )
 
    window.UpdateStatusWidths();
 
-   auto field = static_cast<StatusBarField>( evt.GetInt() );
-   const auto &msg = ProjectStatus::Get( project ).Get( field );
-   window.GetStatusBar()->SetStatusText(msg, field);
-   
-   if ( field == mainStatusBarField )
-      // When recording, let the NEW status message stay at least as long as
-      // the timer interval (if it is not replaced again by this function),
-      // before replacing it with the message about remaining disk capacity.
-      RestartTimer();
+   for ( int ii = 1; ii <= nStatusBarFields; ++ii ) {
+      if ( !(fields & (1u << ii)) )
+         continue;
+      auto field = static_cast<StatusBarField>( ii );
+      const auto &msg = ProjectStatus::Get( project ).Get( field );
+      window.GetStatusBar()->SetStatusText(msg, field);
+
+      if ( field == mainStatusBarField )
+         // When recording, let the NEW status message stay at least as long
+         // as the timer interval (if it is not replaced again), before
+         // replacing it with the message about remaining disk capacity.
+         RestartTimer();
+   }
 }
 
 wxString ProjectManager::GetHoursMinsString(int iMinutes)
@@ -48,9 +48,12 @@ public:
    // Return the given project if that is not NULL, else create a project.
    // Then open the given project path.
    // But if an exception escapes this function, create no NEW project.
+   // bReadOnly opens the project for review only; see
+   // ProjectFileManager::OpenFile.
    static AudacityProject *OpenProject(
       AudacityProject *pProject,
-      const FilePath &fileNameArg, bool addtohistory = true);
+      const FilePath &fileNameArg, bool addtohistory = true,
+      bool bReadOnly = false);
 
    void ResetProjectToEmpty();
 
@@ -66,6 +69,10 @@ private:
    void OnTimer(wxTimerEvent & event);
    void OnOpenAudioFile(wxCommandEvent & event);
    void OnStatusChange( wxCommandEvent& );
+   void OnStatusTimer(wxTimerEvent & event);
+
+   // Push the pending status messages to the status bar
+   void DoStatusUpdates();
 
    void RestartTimer();
 
@@ -74,6 +81,10 @@ private:
 
    std::unique_ptr<wxTimer> mTimer;
 
+   // Rate limiting of status bar updates
+   std::unique_ptr<wxTimer> mStatusTimer;
+   unsigned mPendingStatusFields{ 0 };
+
    DECLARE_EVENT_TABLE()
 
    static bool sbWindowRectAlreadySaved;
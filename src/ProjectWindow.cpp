@@ -20,9 +20,11 @@ Paul Licameli split from AudacityProject.cpp
 #include "RefreshCode.h"
 #include "TrackPanelMouseEvent.h"
 #include "UndoManager.h"
+#include "Track.h"
 #include "ViewInfo.h"
 #include "WaveClip.h"
 #include "WaveTrack.h"
+#include "ondemand/ODManager.h"
 #include "prefs/ThemePrefs.h"
 #include "prefs/TracksPrefs.h"
 #include "toolbars/ToolManager.h"
@@ -1395,6 +1397,14 @@ void ProjectWindow::DoScroll()
    //SetActiveProject(this);
 
    if (!mAutoScrolling) {
+      // Hint the on-demand computation with the newly visible region,
+      // so summaries and decodes for what is on screen are scheduled
+      // first; they would otherwise complete in file order.
+      if (ODManager::IsInstanceCreated()) {
+         for (auto wt : TrackList::Get( project ).Any< WaveTrack >())
+            ODManager::Instance()->DemandTrackUpdate(wt, viewInfo.h);
+      }
+
       trackPanel.Refresh(false);
    }
 }
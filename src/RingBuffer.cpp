@@ -38,6 +38,16 @@ RingBuffer::~RingBuffer()
 {
 }
 
+// Empty the buffer.  This may be called only while no other thread is
+// reading or writing, as between a transport stop and the next start,
+// so plain stores suffice.
+void RingBuffer::Reset()
+{
+   mStart.store( 0, std::memory_order_relaxed );
+   mEnd.store( 0, std::memory_order_relaxed );
+   mWritten = 0;
+}
+
 // Calculations of free and filled space, given snapshots taken of the start
 // and end values
 
@@ -104,10 +114,56 @@ size_t RingBuffer::Put(samplePtr buffer, sampleFormat format,
    // Atomically update the end pointer with release, so the nonatomic writes
    // just done to the buffer don't get reordered after
    mEnd.store(pos, std::memory_order_release);
+   mWritten = pos;
 
    return copied;
 }
 
+size_t RingBuffer::Append(samplePtr buffer, sampleFormat format,
+                          size_t samplesToCopy, size_t padding)
+{
+   // As Put, but copy relative to the writer-private cursor and leave
+   // the publication to a later Publish call
+   auto start = mStart.load( std::memory_order_acquire );
+   const auto free = Free( start, mWritten );
+   samplesToCopy = std::min( samplesToCopy, free );
+   padding = std::min( padding, free - samplesToCopy );
+   auto src = buffer;
+   size_t copied = 0;
+   auto pos = mWritten;
+
+   while ( samplesToCopy ) {
+      auto block = std::min( samplesToCopy, mBufferSize - pos );
+
+      CopySamples(src, format,
+                  mBuffer.ptr() + pos * SAMPLE_SIZE(mFormat), mFormat,
+                  block);
+
+      src += block * SAMPLE_SIZE(format);
+      pos = (pos + block) % mBufferSize;
+      samplesToCopy -= block;
+      copied += block;
+   }
+
+   while ( padding ) {
+      const auto block = std::min( padding, mBufferSize - pos );
+      ClearSamples( mBuffer.ptr(), mFormat, pos, block );
+      pos = (pos + block) % mBufferSize;
+      padding -= block;
+      copied += block;
+   }
+
+   mWritten = pos;
+   return copied;
+}
+
+void RingBuffer::Publish()
+{
+   // One release-store makes all samples appended since the last
+   // publication visible to the reader together
+   mEnd.store(mWritten, std::memory_order_release);
+}
+
 size_t RingBuffer::Clear(sampleFormat format, size_t samplesToClear)
 {
    auto start = mStart.load( std::memory_order_acquire );
@@ -129,6 +185,7 @@ size_t RingBuffer::Clear(sampleFormat format, size_t samplesToClear)
    // Atomically update the end pointer with release, so the nonatomic writes
    // just done to the buffer don't get reordered after
    mEnd.store(pos, std::memory_order_release);
+   mWritten = pos;
 
    return cleared;
 }
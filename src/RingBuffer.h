@@ -29,6 +29,15 @@ class RingBuffer {
               size_t padding = 0);
    size_t Clear(sampleFormat format, size_t samples);
 
+   // Batched variants for the writer:  Append copies samples into the
+   // ring without making them visible to the reader; Publish stores the
+   // cursor once, making all appended samples visible together.  This
+   // saves one release-store (and the associated cache-line ping-pong)
+   // per call when the writer produces a block in several small pieces.
+   size_t Append(samplePtr buffer, sampleFormat format, size_t samples,
+                 size_t padding = 0);
+   void Publish();
+
    //
    // For the reader only:
    //
@@ -37,6 +46,17 @@ class RingBuffer {
    size_t Get(samplePtr buffer, sampleFormat format, size_t samples);
    size_t Discard(size_t samples);
 
+   //
+   // For either thread, but only while no other thread uses the buffer:
+   //
+
+   // Empty the buffer for reuse.  The transport keeps ring buffers alive
+   // across stops and resets them when the next start reuses them.
+   void Reset();
+
+   sampleFormat GetFormat() const { return mFormat; }
+   size_t GetSize() const { return mBufferSize; }
+
  private:
    size_t Filled( size_t start, size_t end );
    size_t Free( size_t start, size_t end );
@@ -52,6 +72,10 @@ class RingBuffer {
    alignas(CacheLine) std::atomic<size_t> mStart { 0 };
    alignas(CacheLine) std::atomic<size_t> mEnd{ 0 };
 
+   // Writer-private shadow of mEnd, ahead of it between Append and
+   // Publish; touched by the writing thread only
+   size_t        mWritten{ 0 };
+
    const size_t  mBufferSize;
 
    sampleFormat  mFormat;
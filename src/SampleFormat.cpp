@@ -41,11 +41,131 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#include <vector>
 
 #include "Prefs.h"
 #include "Dither.h"
 #include "Internat.h"
 
+namespace {
+
+// SampleBufferAllocate hands out 64-byte-aligned blocks, recycled through
+// small per-thread free lists.  Effects allocate and free temporaries of
+// the same few sizes for every processed block; recycling spares the heap
+// that churn, and per-thread lists need no locking -- a block freed on a
+// different thread from its allocation simply migrates.
+constexpr size_t sampleBufferAlignment = 64;
+
+// Each block is preceded by one aligned header giving the size class
+struct SampleBufferHeader {
+   size_t sizeClass;
+};
+
+// Size classes are powers of two, starting at alignment bytes; the
+// largest pooled class is 16 MB, enough for the biggest block-sized
+// temporaries, while bounding what an idle thread can retain
+constexpr size_t sampleBufferClasses = 19;
+
+// Retain at most this many free blocks of each class per thread
+constexpr size_t sampleBufferKeep = 4;
+
+struct SampleBufferFreeLists {
+   std::vector<char *> lists[sampleBufferClasses];
+
+   ~SampleBufferFreeLists()
+   {
+      for (auto &list : lists)
+         for (const auto p : list)
+#ifdef _WIN32
+            _aligned_free(p);
+#else
+            free(p);
+#endif
+   }
+};
+
+char *SystemAlignedAllocate(size_t bytes)
+{
+#ifdef _WIN32
+   return (char *)_aligned_malloc(bytes, sampleBufferAlignment);
+#else
+   void *p = nullptr;
+   if (posix_memalign(&p, sampleBufferAlignment, bytes))
+      return nullptr;
+   return (char *)p;
+#endif
+}
+
+SampleBufferFreeLists &GetSampleBufferFreeLists()
+{
+   static thread_local SampleBufferFreeLists lists;
+   return lists;
+}
+
+}
+
+samplePtr SampleBufferAllocate(size_t bytes)
+{
+   if (bytes == 0)
+      return nullptr;
+
+   size_t sizeClass = 0;
+   size_t rounded = sampleBufferAlignment;
+   while (rounded < bytes && sizeClass + 1 < sampleBufferClasses) {
+      rounded <<= 1;
+      ++sizeClass;
+   }
+   if (rounded < bytes) {
+      // Beyond the largest class; such giants do not recur often enough
+      // to pool.  The sentinel class makes Free return them to the system.
+      rounded = bytes;
+      sizeClass = sampleBufferClasses;
+   }
+
+   char *base = nullptr;
+   if (sizeClass < sampleBufferClasses) {
+      auto &list = GetSampleBufferFreeLists().lists[sizeClass];
+      if (!list.empty()) {
+         base = list.back();
+         list.pop_back();
+      }
+   }
+   if (!base)
+      base = SystemAlignedAllocate(sampleBufferAlignment + rounded);
+   if (!base)
+      return nullptr;
+
+   ((SampleBufferHeader *)base)->sizeClass = sizeClass;
+   return (samplePtr)(base + sampleBufferAlignment);
+}
+
+void SampleBufferFree(samplePtr ptr)
+{
+   if (!ptr)
+      return;
+
+   const auto base = (char *)ptr - sampleBufferAlignment;
+   const auto sizeClass = ((SampleBufferHeader *)base)->sizeClass;
+
+   if (sizeClass < sampleBufferClasses) {
+      auto &list = GetSampleBufferFreeLists().lists[sizeClass];
+      if (list.size() < sampleBufferKeep) {
+         list.push_back(base);
+         return;
+      }
+   }
+
+#ifdef _WIN32
+   _aligned_free(base);
+#else
+   free(base);
+#endif
+}
+
 static DitherType gLowQualityDither = DitherType::none;
 static DitherType gHighQualityDither = DitherType::none;
 static Dither gDitherAlgorithm;
@@ -85,6 +205,18 @@ void ReverseSamples(samplePtr dst, sampleFormat format,
                   int start, int len)
 {
    auto size = SAMPLE_SIZE(format);
+   if (size == sizeof(wxUint32)) {
+      // Whole-word swaps, which the compiler can vectorize, cover float
+      // and 24-bit (packed in 32 bits) samples alike
+      auto first = reinterpret_cast<wxUint32*>(dst) + start;
+      auto last = first + len - 1;
+      while (first < last) {
+         const auto temp = *first;
+         *first++ = *last;
+         *last-- = temp;
+      }
+      return;
+   }
    samplePtr first = dst + start * size;
    samplePtr last = dst + (start + len - 1) * size;
    enum : size_t { fixedSize = SAMPLE_SIZE(floatSample) };
@@ -50,6 +50,12 @@ const wxChar *GetSampleFormatStr(sampleFormat format);
 // Allocating/Freeing Samples
 //
 
+// 64-byte-aligned, pooled allocation of sample data, so that vectorized
+// loops may use aligned loads and repeated temporary buffers in effect
+// processing do not churn the heap.  See SampleFormat.cpp.
+samplePtr SampleBufferAllocate(size_t bytes);
+void SampleBufferFree(samplePtr ptr);
+
 class SampleBuffer {
 
 public:
@@ -57,7 +63,7 @@ public:
       : mPtr(0)
    {}
    SampleBuffer(size_t count, sampleFormat format)
-      : mPtr((samplePtr)malloc(count * SAMPLE_SIZE(format)))
+      : mPtr(SampleBufferAllocate(count * SAMPLE_SIZE(format)))
    {}
    ~SampleBuffer()
    {
@@ -68,14 +74,14 @@ public:
    SampleBuffer &Allocate(size_t count, sampleFormat format)
    {
       Free();
-      mPtr = (samplePtr)malloc(count * SAMPLE_SIZE(format));
+      mPtr = SampleBufferAllocate(count * SAMPLE_SIZE(format));
       return *this;
    }
 
 
    void Free()
    {
-      free(mPtr);
+      SampleBufferFree(mPtr);
       mPtr = 0;
    }
 
@@ -57,6 +57,7 @@ Sequence::Sequence(const std::shared_ptr<DirManager> &projDirManager, sampleForm
    , mSampleFormat(format)
    , mMinSamples(sMaxDiskBlockSize / SAMPLE_SIZE(mSampleFormat) / 2)
    , mMaxSamples(mMinSamples * 2)
+   , mBlockSizeReviewCount(256)
 {
 }
 
@@ -68,6 +69,7 @@ Sequence::Sequence(const Sequence &orig, const std::shared_ptr<DirManager> &proj
    , mSampleFormat(orig.mSampleFormat)
    , mMinSamples(orig.mMinSamples)
    , mMaxSamples(orig.mMaxSamples)
+   , mBlockSizeReviewCount(orig.mBlockSizeReviewCount)
 {
    Paste(0, &orig);
 }
@@ -171,6 +173,8 @@ bool Sequence::ConvertToSampleFormat(sampleFormat format)
    // These are the same calculations as in the constructor.
    mMinSamples = sMaxDiskBlockSize / SAMPLE_SIZE(mSampleFormat) / 2;
    mMaxSamples = mMinSamples * 2;
+   // Let Append() grow the limits again for the changed sample size
+   mBlockSizeReviewCount = 256;
 
    bool bSuccess = false;
    auto cleanup = finally( [&] {
@@ -383,6 +387,87 @@ float Sequence::GetRMS(sampleCount start, sampleCount len, bool mayThrow) const
    return sqrt(sumsq / length.as_double() );
 }
 
+wxUint64 Sequence::GetContentHash() const
+{
+   if (mContentHashValid)
+      return mContentHash;
+
+   // FNV-1a over the identities and placement of the block files.  The
+   // block files themselves are immutable (edits make NEW files), so
+   // their serial numbers stand in for their contents within a session.
+   // Not their addresses:  the arena recycles those promptly, and
+   // fingerprints that outlive the blocks they hashed (freeze, proxy)
+   // must not match a coincidental reallocation.
+   wxUint64 hash = wxULL(14695981039346336037);
+   auto mix = [&hash](wxUint64 value) {
+      for (unsigned i = 0; i < 8; i++) {
+         hash ^= (value >> (i * 8)) & 0xff;
+         hash *= wxULL(1099511628211);
+      }
+   };
+
+   mix((wxUint64)mSampleFormat);
+   mix((wxUint64)mNumSamples.as_long_long());
+   for (const auto &seqBlock : mBlock) {
+      mix(seqBlock.f->GetSerialNumber());
+      mix((wxUint64)seqBlock.start.as_long_long());
+   }
+
+   mContentHash = hash;
+   mContentHashValid = true;
+   return hash;
+}
+
+wxUint64 Sequence::GetPersistentHash() const
+{
+   wxUint64 hash = wxULL(14695981039346336037);
+   auto mix = [&hash](wxUint64 value) {
+      for (unsigned i = 0; i < 8; i++) {
+         hash ^= (value >> (i * 8)) & 0xff;
+         hash *= wxULL(1099511628211);
+      }
+   };
+
+   mix((wxUint64)mSampleFormat);
+   mix((wxUint64)mNumSamples.as_long_long());
+   for (const auto &seqBlock : mBlock) {
+      // The base name identifies the block file across sessions; edits
+      // always make files with NEW names
+      const wxScopedCharBuffer name =
+         seqBlock.f->GetFileName().name.GetFullName().utf8_str();
+      for (size_t i = 0, nn = name.length(); i < nn; i++) {
+         hash ^= (unsigned char)name[i];
+         hash *= wxULL(1099511628211);
+      }
+      mix((wxUint64)seqBlock.f->GetLength());
+      mix((wxUint64)seqBlock.start.as_long_long());
+   }
+
+   return hash;
+}
+
+sampleCount Sequence::GetSilentSpan(sampleCount start, sampleCount len) const
+{
+   if (start < 0 || start >= mNumSamples || len <= 0)
+      return 0;
+   len = std::min(len, mNumSamples - start);
+
+   sampleCount result = 0;
+   const int numBlocks = mBlock.size();
+   for (int b = FindBlock(start); b < numBlocks; ++b) {
+      const SeqBlock &block = mBlock[b];
+      if (!block.f->IsSilent())
+         break;
+      const auto advance =
+         std::min(len - result, block.start + block.f->GetLength()
+            - (start + result));
+      result += advance;
+      if (result >= len)
+         break;
+   }
+   return result;
+}
+
 std::unique_ptr<Sequence> Sequence::Copy(sampleCount s0, sampleCount s1) const
 {
    auto dest = std::make_unique<Sequence>(mDirManager, mSampleFormat);
@@ -463,10 +548,24 @@ namespace {
                                     sampleFormat format,
                                     bool allowDeferredWrite = false)
    {
-      return dm.NewBlockFile( [&]( wxFileNameWrapper filePath ) {
+      auto factory = [&]( wxFileNameWrapper filePath ) {
          return make_blockfile<SimpleBlockFile>(
             std::move(filePath), sampleData, sampleLen, format, allowDeferredWrite);
-      } );
+      };
+
+      if (!allowDeferredWrite)
+         // Content-addressed:  importing the same source file twice
+         // references the blocks the first import wrote instead of
+         // duplicating every one of them on disk
+         return dm.NewBlockFile( factory, sampleData, sampleLen, format );
+
+      // Recorded blocks are never duplicates; keep the digest off the
+      // capture path
+      auto result = dm.NewBlockFile( factory );
+      if (result->GetNeedWriteCacheToDisk())
+         // Hand the staged block to the write-behind thread
+         dm.EnqueueBlockWrite( result );
+      return result;
    }
 }
 
@@ -537,6 +636,40 @@ void Sequence::Paste(sampleCount s, const Sequence *src)
    SeqBlock *const pBlock = &mBlock[b];
    const auto length = pBlock->f->GetLength();
    const auto largerBlockLen = addedLen + length;
+
+   // Special case: the insertion point lies exactly on a block boundary,
+   // and all of the source's blocks could stand in the result unchanged.
+   // Then splice in references to the source block files, without reading
+   // or writing any sample data, just as the interior loops below share
+   // interior blocks.
+   if (s == pBlock->start) {
+      bool shareable = true;
+      for (unsigned int i = 0; shareable && i < srcNumBlocks; i++) {
+         const auto len = srcBlock[i].f->GetLength();
+         shareable = len >= mMinSamples && len <= mMaxSamples;
+      }
+      if (shareable) {
+         // Build and swap a copy so there is a strong exception safety
+         // guarantee
+         BlockArray newBlock;
+         newBlock.reserve(numBlocks + srcNumBlocks);
+         newBlock.insert(newBlock.end(), mBlock.begin(), mBlock.begin() + b);
+
+         sampleCount samples = s;
+         for (unsigned int i = 0; i < srcNumBlocks; i++)
+            // AppendBlock may throw for limited disk space, if pasting from
+            // one project into another.
+            AppendBlock(*mDirManager, newBlock, samples, srcBlock[i]);
+            // Increase ref count or duplicate file
+
+         for (unsigned int i = b; i < numBlocks; i++)
+            newBlock.push_back(mBlock[i].Plus(addedLen));
+
+         CommitChangesIfConsistent
+            (newBlock, mNumSamples + addedLen, wxT("Paste branch boundary"));
+         return;
+      }
+   }
    // PRL: when insertion point is the first sample of a block,
    // and the following test fails, perhaps we could test
    // whether coalescence with the previous block is possible.
@@ -574,6 +707,7 @@ void Sequence::Paste(sampleCount s, const Sequence *src)
          mBlock[i].start += addedLen;
 
       mNumSamples += addedLen;
+      mContentHashValid = false;
 
       // This consistency check won't throw, it asserts.
       // Proof that we kept consistency is not hard.
@@ -784,36 +918,30 @@ bool Sequence::HandleXMLTag(const wxChar *tag, const wxChar **attrs)
 
       // loop through attrs, which is a null-terminated list of
       // attribute-value pairs
-      while(*attrs) {
-         const wxChar *attr = *attrs++;
-         const wxChar *value = *attrs++;
-
+      XMLAttributeCursor cursor{ attrs };
+      while (cursor.Next()) {
          long long nValue = 0;
 
-         if (!value)
-            break;
-
          // Both these attributes have non-negative integer counts of samples, so
          // we can test & convert here, making sure that values > 2^31 are OK
          // because long clips will need them.
-         const wxString strValue = value;
-         if (!XMLValueChecker::IsGoodInt64(strValue) || !strValue.ToLongLong(&nValue) || (nValue < 0))
+         if (!cursor.ToLongLong(nValue) || (nValue < 0))
          {
             mErrorOpening = true;
             wxLogWarning(
                wxT("   Sequence has bad %s attribute value, %s, that should be a positive integer."),
-               attr, strValue);
+               cursor.Name(), cursor.Value());
             return false;
          }
 
-         if (!wxStrcmp(attr, wxT("start")))
+         if (cursor.Is(wxT("start")))
             wb.start = nValue;
 
          // Vaughan, 2011-10-10: I don't think we ever write a "len" attribute for "waveblock" tag,
          // so I think this is actually legacy code, or something intended, but not completed.
          // Anyway, might as well leave this code in, especially now that it has the check
          // against mMaxSamples.
-         if (!wxStrcmp(attr, wxT("len")))
+         if (cursor.Is(wxT("len")))
          {
             // mMaxSamples should already have been set by calls to the "sequence" clause below.
             // The check intended here was already done in DirManager::HandleXMLTag(), where
@@ -838,21 +966,14 @@ bool Sequence::HandleXMLTag(const wxChar *tag, const wxChar **attrs)
 
    /* handle sequence tag and its attributes */
    if (!wxStrcmp(tag, wxT("sequence"))) {
-      while(*attrs) {
-         const wxChar *attr = *attrs++;
-         const wxChar *value = *attrs++;
-
-         if (!value)
-            break;
-
+      XMLAttributeCursor cursor{ attrs };
+      while (cursor.Next()) {
          long long nValue = 0;
 
-         const wxString strValue = value;	// promote string, we need this for all
-
-         if (!wxStrcmp(attr, wxT("maxsamples")))
+         if (cursor.Is(wxT("maxsamples")))
          {
             // This attribute is a sample count, so can be 64bit
-            if (!XMLValueChecker::IsGoodInt64(strValue) || !strValue.ToLongLong(&nValue) || (nValue < 0))
+            if (!cursor.ToLongLong(nValue) || (nValue < 0))
             {
                mErrorOpening = true;
                return false;
@@ -873,21 +994,21 @@ bool Sequence::HandleXMLTag(const wxChar *tag, const wxChar **attrs)
             // PRL:  Yes, because it only affects DirManager's behavior in opening the project.
             mDirManager->SetLoadingMaxSamples(mMaxSamples);
          }
-         else if (!wxStrcmp(attr, wxT("sampleformat")))
+         else if (cursor.Is(wxT("sampleformat")))
          {
             // This attribute is a sample format, normal int
             long fValue;
-            if (!XMLValueChecker::IsGoodInt(strValue) || !strValue.ToLong(&fValue) || (fValue < 0) || !XMLValueChecker::IsValidSampleFormat(fValue))
+            if (!cursor.ToLong(fValue) || (fValue < 0) || !XMLValueChecker::IsValidSampleFormat(fValue))
             {
                mErrorOpening = true;
                return false;
             }
             mSampleFormat = (sampleFormat)fValue;
          }
-         else if (!wxStrcmp(attr, wxT("numsamples")))
+         else if (cursor.Is(wxT("numsamples")))
          {
             // This attribute is a sample count, so can be 64bit
-            if (!XMLValueChecker::IsGoodInt64(strValue) || !strValue.ToLongLong(&nValue) || (nValue < 0))
+            if (!cursor.ToLongLong(nValue) || (nValue < 0))
             {
                mErrorOpening = true;
                return false;
@@ -1522,6 +1643,39 @@ size_t Sequence::GetIdealAppendLen() const
       return max - lastBlockLen;
 }
 
+void Sequence::AdaptBlockSizeForAppend()
+{
+   // Sequences that keep growing at the end -- typically recordings --
+   // switch to progressively larger blocks, so that hours of audio do not
+   // cost tens of thousands of SeqBlocks, and as many seeks to read back.
+   // Heavily edited sequences, recognized by their share of fragmentary
+   // blocks, keep the preferred size, which keeps small edits cheap.
+
+   // Reconsider only at doublings of the block count, so that the scan
+   // below costs O(1) amortized per appended block
+   if (mBlock.size() < mBlockSizeReviewCount)
+      return;
+   mBlockSizeReviewCount = 2 * mBlock.size();
+
+   // Grow to at most four times the preferred maximum
+   const size_t preferred = sMaxDiskBlockSize / SAMPLE_SIZE(mSampleFormat);
+   if (mMaxSamples >= 4 * preferred)
+      return;
+
+   size_t fragments = 0;
+   for (const auto &block : mBlock)
+      if (block.f->GetLength() < mMinSamples)
+         ++fragments;
+   if (fragments * 100 > mBlock.size())
+      return;
+
+   // Growing the limits never invalidates existing blocks, because only
+   // the upper bound on block length is checked against them; and the NEW
+   // value of mMaxSamples is saved with the project
+   mMinSamples *= 2;
+   mMaxSamples *= 2;
+}
+
 void Sequence::Append(samplePtr buffer, sampleFormat format,
                       size_t len, XMLWriter* blockFileLog /*=NULL*/)
 // STRONG-GUARANTEE
@@ -1533,6 +1687,8 @@ void Sequence::Append(samplePtr buffer, sampleFormat format,
    if (Overflows(mNumSamples.as_double() + ((double)len)))
       THROW_INCONSISTENCY_EXCEPTION;
 
+   AdaptBlockSizeForAppend();
+
    BlockArray newBlock;
    sampleCount newNumSamples = mNumSamples;
 
@@ -1641,6 +1797,107 @@ void Sequence::Blockify
    }
 }
 
+void Sequence::ConsolidateFragments()
+// STRONG-GUARANTEE
+{
+   // On-demand threads iterate over mBlock; see the comment in Delete()
+   DeleteUpdateMutexLocker locker(*this);
+
+   const unsigned int numBlocks = mBlock.size();
+   if (numBlocks < 2)
+      return;
+
+   const auto sampleSize = SAMPLE_SIZE(mSampleFormat);
+   SampleBuffer scratch;
+
+   // Find runs of adjacent blocks that fit together into one block.
+   // Rewrite a run only if some member is fragmentary; well-formed
+   // sequences must not be rewritten again and again.
+   BlockArray newBlock;
+   newBlock.reserve(numBlocks);
+   bool changed = false;
+   unsigned int i = 0;
+   while (i < numBlocks) {
+      unsigned int j = i;
+      size_t sum = 0;
+      bool fragmentary = false;
+      while (j < numBlocks && !mBlock[j].f->IsAlias()) {
+         const auto length = mBlock[j].f->GetLength();
+         if (sum + length > mMaxSamples)
+            break;
+         sum += length;
+         fragmentary = fragmentary || length < mMinSamples;
+         ++j;
+      }
+      if (j - i > 1 && fragmentary) {
+         if (!scratch.ptr())
+            scratch.Allocate(mMaxSamples, mSampleFormat);
+         size_t pos = 0;
+         for (unsigned int k = i; k < j; k++) {
+            const SeqBlock &block = mBlock[k];
+            const auto length = block.f->GetLength();
+            Read(scratch.ptr() + pos * sampleSize, mSampleFormat,
+                 block, 0, length, true);
+            pos += length;
+         }
+         newBlock.push_back(SeqBlock(
+            NewSimpleBlockFile(*mDirManager, scratch.ptr(), sum, mSampleFormat),
+            mBlock[i].start));
+         changed = true;
+         i = j;
+      }
+      else {
+         newBlock.push_back(mBlock[i]);
+         ++i;
+      }
+   }
+
+   if (changed)
+      CommitChangesIfConsistent
+         (newBlock, mNumSamples, wxT("ConsolidateFragments"));
+}
+
+void Sequence::Reverse()
+// STRONG-GUARANTEE
+{
+   // On-demand threads iterate over mBlock; see the comment in Delete()
+   DeleteUpdateMutexLocker locker(*this);
+
+   if (mBlock.empty())
+      return;
+
+   // The order of the blocks reverses as metadata only.  Within each
+   // block the samples must reverse too; a silent block is its own
+   // reversal and stays shared, while every other block is read and
+   // rewritten exactly once.  This single pass replaces the
+   // read-modify-write that reversing through Set() would repeat at
+   // every block boundary.
+   BlockArray newBlock;
+   newBlock.reserve(mBlock.size());
+
+   size_t scratchSize = mMaxSamples;
+   SampleBuffer scratch(scratchSize, mSampleFormat);
+
+   sampleCount position = 0;
+   for (auto it = mBlock.rbegin(), end = mBlock.rend(); it != end; ++it) {
+      const SeqBlock &block = *it;
+      const auto length = block.f->GetLength();
+      BlockFilePtr file = block.f;
+      if (!file->IsSilent()) {
+         // Aliased blocks may exceed mMaxSamples
+         ensureSampleBufferSize(scratch, mSampleFormat, scratchSize, length);
+         Read(scratch.ptr(), mSampleFormat, block, 0, length, true);
+         ReverseSamples(scratch.ptr(), mSampleFormat, 0, length);
+         file = NewSimpleBlockFile(
+            *mDirManager, scratch.ptr(), length, mSampleFormat);
+      }
+      newBlock.push_back(SeqBlock(file, position));
+      position += length;
+   }
+
+   CommitChangesIfConsistent(newBlock, mNumSamples, wxT("Reverse"));
+}
+
 void Sequence::Delete(sampleCount start, sampleCount len)
 // STRONG-GUARANTEE
 {
@@ -1710,6 +1967,9 @@ void Sequence::Delete(sampleCount start, sampleCount len)
          mBlock[j].start -= len;
 
       mNumSamples -= len;
+      // This branch bypasses CommitChangesIfConsistent, which otherwise
+      // invalidates the digest
+      mContentHashValid = false;
 
       // This consistency check won't throw, it asserts.
       // Proof that we kept consistency is not hard.
@@ -1889,6 +2149,7 @@ void Sequence::CommitChangesIfConsistent
 
    mBlock.swap(newBlock);
    mNumSamples = numSamples;
+   mContentHashValid = false;
 }
 
 void Sequence::AppendBlocksIfConsistent
@@ -1931,6 +2192,7 @@ void Sequence::AppendBlocksIfConsistent
    // use NOFAIL-GUARANTEE
 
    mNumSamples = numSamples;
+   mContentHashValid = false;
    consistent = true;
 }
 
@@ -1993,6 +2255,7 @@ void Sequence::AppendBlockFile( const BlockFileFactory &factory, size_t len )
    );
    mBlock.push_back(newBlock);
    mNumSamples += len;
+   mContentHashValid = false;
 }
 
 void Sequence::AppendBlockFile(const BlockFilePtr &blockFile)
@@ -2001,6 +2264,7 @@ void Sequence::AppendBlockFile(const BlockFilePtr &blockFile)
 
    mBlock.push_back(SeqBlock(blockFile, mNumSamples));
    mNumSamples += blockFile->GetLength();
+   mContentHashValid = false;
 
    // PRL:  I hoisted the intended consistency check out of the inner loop
    // See RecordingRecoveryHandler::HandleXMLEndTag
@@ -109,6 +109,15 @@ class PROFILE_DLL_API Sequence final : public XMLTagHandler{
                XMLWriter* blockFileLog=NULL);
    void Delete(sampleCount start, sampleCount len);
 
+   // Rewrite runs of adjacent undersized blocks as fewer, fuller blocks.
+   // Call at quiescent moments; this may read and write much sample data.
+   void ConsolidateFragments();
+
+   // Reverse the order of all the samples.  Block order reverses as
+   // metadata; silent blocks are shared unchanged, and each other block
+   // is read and rewritten once with its samples reversed.
+   void Reverse();
+
    using BlockFileFactory =
       std::function< BlockFilePtr( wxFileNameWrapper, size_t /* len */ ) >;
    // An overload of AppendBlockFile that passes the factory to DirManager
@@ -169,6 +178,22 @@ class PROFILE_DLL_API Sequence final : public XMLTagHandler{
       sampleCount start, sampleCount len, bool mayThrow) const;
    float GetRMS(sampleCount start, sampleCount len, bool mayThrow) const;
 
+   // Cheap 64-bit digest of the sequence's content, built from the
+   // identities of the immutable block files; never reads sample data.
+   // Recomputed lazily after each edit.  Equal digests imply equal
+   // samples, because block files are copied on write and shared between
+   // equal sequences; unequal digests imply nothing.
+   wxUint64 GetContentHash() const;
+
+   // Like GetContentHash, but built from the block files' names instead
+   // of their addresses, so it survives saving and reopening the project.
+   // Costlier and not cached; meant for keying on-disk caches.
+   wxUint64 GetPersistentHash() const;
+
+   // How many samples, starting at start and not exceeding len, fall in
+   // blocks known to be silent?  Consumers may skip work across the span.
+   sampleCount GetSilentSpan(sampleCount start, sampleCount len) const;
+
    //
    // Getting block size and alignment information
    //
@@ -231,8 +256,16 @@ class PROFILE_DLL_API Sequence final : public XMLTagHandler{
    size_t   mMinSamples; // min samples per block
    size_t   mMaxSamples; // max samples per block
 
+   // Block count at which Append() next reconsiders the block size limits
+   size_t   mBlockSizeReviewCount;
+
    bool          mErrorOpening{ false };
 
+   // Cached result of GetContentHash(), maintained lazily; every method
+   // that commits a change of mBlock or mNumSamples clears the flag
+   mutable wxUint64 mContentHash{ 0 };
+   mutable bool  mContentHashValid{ false };
+
    ///To block the Delete() method against the ODCalcSummaryTask::Update() method
    ODLock   mDeleteUpdateMutex;
 
@@ -242,6 +275,8 @@ class PROFILE_DLL_API Sequence final : public XMLTagHandler{
 
    int FindBlock(sampleCount pos) const;
 
+   void AdaptBlockSizeForAppend();
+
    static void AppendBlock
       (DirManager &dirManager,
        BlockArray &blocks, sampleCount &numSamples, const SeqBlock &b);
@@ -16,6 +16,7 @@
 
 #include "Project.h"
 #include "ProjectSettings.h"
+#include "UndoManager.h"
 #include "LabelTrack.h"
 #include "NoteTrack.h"
 #include "WaveClip.h"
@@ -27,6 +28,121 @@ inline bool operator < (SnapPoint s1, SnapPoint s2)
    return s1.t < s2.t;
 }
 
+namespace {
+
+// A project-lifetime cache of every clip boundary and label edge, kept
+// in sorted order and shared by all SnapManagers, so that starting a
+// drag gesture need not walk every track and sort the result.  Every
+// completed, undone or redone edit invalidates it through the undo
+// events (all gestures that can move a boundary end in ProjectHistory);
+// it then rebuilds lazily once, on the next gesture.
+struct CachedSnapPoint
+{
+   double t;
+   const Track *track;
+   const WaveClip *clip; // non-null only for wave clip boundaries
+};
+
+class SnapPointCache final
+   : public ClientData::Base
+   , public wxEvtHandler
+{
+public:
+   static SnapPointCache &Get( AudacityProject &project );
+
+   explicit SnapPointCache( AudacityProject &project )
+      : mProject{ project }
+   {
+      mProject.Bind( EVT_UNDO_PUSHED, &SnapPointCache::OnChange, this );
+      mProject.Bind( EVT_UNDO_MODIFIED, &SnapPointCache::OnChange, this );
+      mProject.Bind( EVT_UNDO_OR_REDO, &SnapPointCache::OnChange, this );
+      mProject.Bind( EVT_UNDO_RESET, &SnapPointCache::OnChange, this );
+   }
+
+   ~SnapPointCache()
+   {
+      mProject.Unbind( EVT_UNDO_PUSHED, &SnapPointCache::OnChange, this );
+      mProject.Unbind( EVT_UNDO_MODIFIED, &SnapPointCache::OnChange, this );
+      mProject.Unbind( EVT_UNDO_OR_REDO, &SnapPointCache::OnChange, this );
+      mProject.Unbind( EVT_UNDO_RESET, &SnapPointCache::OnChange, this );
+   }
+
+   const std::vector< CachedSnapPoint > &GetPoints()
+   {
+      if (!mValid)
+         Rebuild();
+      return mPoints;
+   }
+
+private:
+   void OnChange( wxCommandEvent &evt )
+   {
+      evt.Skip();
+      mValid = false;
+   }
+
+   void Rebuild();
+
+   AudacityProject &mProject;
+   std::vector< CachedSnapPoint > mPoints;
+   bool mValid{ false };
+};
+
+static const AudacityProject::AttachedObjects::RegisteredFactory sCacheKey{
+   []( AudacityProject &project ){
+      return std::make_shared< SnapPointCache >( project );
+   }
+};
+
+SnapPointCache &SnapPointCache::Get( AudacityProject &project )
+{
+   return project.AttachedObjects::Get< SnapPointCache >( sCacheKey );
+}
+
+void SnapPointCache::Rebuild()
+{
+   mPoints.clear();
+
+   const TrackList &tracks = TrackList::Get( mProject );
+   tracks.Any().Visit(
+      [&](const LabelTrack *labelTrack) {
+         for (int i = 0, cnt = labelTrack->GetNumLabels(); i < cnt; ++i)
+         {
+            const LabelStruct *label = labelTrack->GetLabel(i);
+            const double t0 = label->getT0();
+            const double t1 = label->getT1();
+            mPoints.push_back({ t0, labelTrack, nullptr });
+            if (t1 != t0)
+            {
+               mPoints.push_back({ t1, labelTrack, nullptr });
+            }
+         }
+      },
+      [&](const WaveTrack *waveTrack) {
+         for (const auto &clip: waveTrack->GetClips())
+         {
+            mPoints.push_back({ clip->GetStartTime(), waveTrack, clip.get() });
+            mPoints.push_back({ clip->GetEndTime(), waveTrack, clip.get() });
+         }
+      }
+#ifdef USE_MIDI
+      ,
+      [&](const NoteTrack *track) {
+         mPoints.push_back({ track->GetStartTime(), track, nullptr });
+         mPoints.push_back({ track->GetEndTime(), track, nullptr });
+      }
+#endif
+   );
+
+   std::sort( mPoints.begin(), mPoints.end(),
+      []( const CachedSnapPoint &a, const CachedSnapPoint &b )
+         { return a.t < b.t; } );
+
+   mValid = true;
+}
+
+}
+
 TrackClip::TrackClip(Track *t, WaveClip *c)
 {
    track = origTrack = t;
@@ -102,6 +218,50 @@ void SnapManager::Reinit()
       mConverter.SetFormatName(mFormat);
    }
 
+   auto pProject = const_cast< AudacityProject* >( mProject );
+   if (pProject && mTracks == &TrackList::Get( *pProject ))
+   {
+      // The usual case: apply this gesture's exclusions and the time
+      // grid filter to the shared, presorted candidate list, instead of
+      // walking every track and sorting again
+      for (const auto &point : SnapPointCache::Get( *pProject ).GetPoints())
+      {
+         if (mTrackExclusions &&
+             make_iterator_range( *mTrackExclusions ).contains( point.track ))
+            continue;
+
+         if (point.clip && mClipExclusions)
+         {
+            bool skip = false;
+            for (size_t j = 0, cnt = mClipExclusions->size(); j < cnt; ++j)
+            {
+               if ((*mClipExclusions)[j].track == point.track &&
+                   (*mClipExclusions)[j].clip == point.clip)
+               {
+                  skip = true;
+                  break;
+               }
+            }
+
+            if (skip)
+               continue;
+         }
+
+         CondListAdd(point.t, point.track);
+      }
+
+      // Keep the sorted order while adding the SnapPoint at t=0
+      mSnapPoints.insert(
+         std::lower_bound( mSnapPoints.begin(), mSnapPoints.end(),
+            SnapPoint{} ),
+         SnapPoint{} );
+
+      return;
+   }
+
+   // Fall back to a direct walk when snapping within some other list of
+   // tracks than the project's
+
    // Add a SnapPoint at t=0
    mSnapPoints.push_back(SnapPoint{});
 
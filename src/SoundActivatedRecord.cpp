@@ -56,6 +56,8 @@ void SoundActivatedRecord::PopulateOrExchange(ShuttleGui & S)
          S.SetStretchyCol(1);
          dBRange = gPrefs->Read(ENV_DB_KEY, ENV_DB_RANGE);
          S.TieSlider(_("Activation level (dB):"), wxT("/AudioIO/SilenceLevel"), -50, 0, -dBRange);
+         S.TieNumericTextBox(_("Pre-roll before activation (seconds):"),
+            wxT("/AudioIO/SilencePreRoll"), 0.0, 9);
       S.EndMultiColumn();
    }
    S.EndVerticalLay();
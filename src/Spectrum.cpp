@@ -18,6 +18,7 @@
 #include <math.h>
 
 #include "SampleFormat.h"
+#include "SseMathFuncs.h"
 
 bool ComputeSpectrum(const float * data, size_t width,
                      size_t windowSize,
@@ -40,20 +41,23 @@ bool ComputeSpectrum(const float * data, size_t width,
    Floats out{ windowSize };
    Floats out2{ windowSize };
 
+   // Compute the window coefficients once, rather than reevaluating
+   // the window function for every hop
+   Floats window{ windowSize };
+   for (size_t i = 0; i < windowSize; i++)
+      window[i] = 1.0f;
+   WindowFunc(windowFunc, windowSize, window.get());
+
    size_t start = 0;
    unsigned windows = 0;
    while (start + windowSize <= width) {
-      for (size_t i = 0; i < windowSize; i++)
-         in[i] = data[start + i];
-
-      WindowFunc(windowFunc, windowSize, in.get());
+      ApplyWindowTo(in.get(), window.get(), data + start, windowSize);
 
       if (autocorrelation) {
          // Take FFT
          RealFFT(windowSize, in.get(), out.get(), out2.get());
          // Compute power
-         for (size_t i = 0; i < windowSize; i++)
-            in[i] = (out[i] * out[i]) + (out2[i] * out2[i]);
+         SquaredMagnitudes(in.get(), out.get(), out2.get(), windowSize);
 
          // Tolonen and Karjalainen recommend taking the cube root
          // of the power, instead of the square root
@@ -68,8 +72,7 @@ bool ComputeSpectrum(const float * data, size_t width,
          PowerSpectrum(windowSize, in.get(), out.get());
 
       // Take real part of result
-      for (size_t i = 0; i < half; i++)
-        processed[i] += out[i];
+      AccumulateSamples(processed.get(), out.get(), half);
 
       start += half;
       windows++;
@@ -106,15 +109,11 @@ bool ComputeSpectrum(const float * data, size_t width,
       for (size_t i = 0; i < half; i++)
          processed[half - 1 - i] = in[i];
    } else {
-      // Convert to decibels
+      // Convert to decibels, in one vectorized batch
       // But do it safely; -Inf is nobody's friend
-      for (size_t i = 0; i < half; i++){
-         float temp=(processed[i] / windowSize / windows);
-         if (temp > 0.0)
-            processed[i] = 10 * log10(temp);
-         else
-            processed[i] = 0;
-      }
+      for (size_t i = 0; i < half; i++)
+         processed[i] = processed[i] / windowSize / windows;
+      PowerToDBValues(processed.get(), processed.get(), half, 0);
    }
 
    for(size_t i = 0; i < half; i++)
@@ -61,6 +61,43 @@ misrepresented as being the original software.
 */
 #ifndef SSE_MATHFUN
 #define SSE_MATHFUN
+
+#include <stddef.h>
+
+/* Batched transcendental math for dB and gain paths.  Implemented in
+   SseMathFuncs.cpp with the SSE kernels below when the compiler targets
+   SSE2, and with scalar libm otherwise, so these may be called from any
+   file on any architecture.  Results match libm to within the accuracy
+   of the cephes approximations (about 1e-7 relative), ample for gain
+   computation and display. */
+
+/* out[i] = 10 * log10(in[i]); nonpositive inputs produce floorDB.
+   in and out may be the same array. */
+void PowerToDBValues(const float *in, float *out, size_t len, float floorDB);
+
+/* out[i] = 20 * log10(in[i]); nonpositive inputs produce floorDB. */
+void LinearToDBValues(const float *in, float *out, size_t len, float floorDB);
+
+/* out[i] = pow(10, in[i] / 20) */
+void DBToLinearValues(const float *in, float *out, size_t len);
+
+/* Ramped multiplies, the kernel of fades and crossfades:
+   out[i] = in[i] * (gain0 + i * gainStep).
+   in and out may be the same array. */
+void ApplyLinearRamp(const float *in, float *out, size_t len,
+                     float gain0, float gainStep);
+
+/* Constant-gain linear crossfade of two buffers, with the gain of the
+   incoming buffer ramping from gain0 by gainStep per sample and the
+   outgoing buffer taking the complementary gain:
+   out[i] = outgoing[i] * (1 - g) + incoming[i] * g, g = gain0 + i * gainStep.
+   out may alias either input. */
+void CrossFadeBuffers(const float *outgoing, const float *incoming,
+                      float *out, size_t len, float gain0, float gainStep);
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SSEMATH_USE_SSE2
 /* SIMD (SSE1+MMX or SSE2) implementation of sin, cos, exp and log
 
    Inspired by Intel Approximate Math library, and based on the
@@ -172,7 +209,7 @@ typedef union xmm_mm_union {
 /* natural logarithm computed for 4 simultaneous float 
    return NaN for x <= 0
 */
-v4sf log_ps(v4sf x) {
+inline v4sf log_ps(v4sf x) {
 #ifdef USE_SSE2
   v4si emm0;
 #else
@@ -274,7 +311,7 @@ _PS_CONST(cephes_exp_p3, 4.1665795894E-2);
 _PS_CONST(cephes_exp_p4, 1.6666665459E-1);
 _PS_CONST(cephes_exp_p5, 5.0000001201E-1);
 
-v4sf exp_ps(v4sf x) {
+inline v4sf exp_ps(v4sf x) {
   v4sf tmp = _mm_setzero_ps(), fx;
 #ifdef USE_SSE2
   v4si emm0;
@@ -392,7 +429,7 @@ _PS_CONST(cephes_FOPI, 1.27323954473516); // 4 / M_PI
    Since it is based on SSE intrinsics, it has to be compiled at -O2 to
    deliver full speed.
 */
-v4sf sin_ps(v4sf x) { // any x
+inline v4sf sin_ps(v4sf x) { // any x
   v4sf xmm1, xmm2 = _mm_setzero_ps(), xmm3, sign_bit, y;
 
 #ifdef USE_SSE2
@@ -509,7 +546,7 @@ v4sf sin_ps(v4sf x) { // any x
 }
 
 /* almost the same as sin_ps */
-v4sf cos_ps(v4sf x) { // any x
+inline v4sf cos_ps(v4sf x) { // any x
   v4sf xmm1, xmm2 = _mm_setzero_ps(), xmm3, y;
 #ifdef USE_SSE2
   v4si emm0, emm2;
@@ -628,7 +665,7 @@ v4sf cos_ps(v4sf x) { // any x
 
 /* since sin_ps and cos_ps are almost identical, sincos_ps could replace both of them..
    it is almost as fast, and gives you a free cosine with your sine */
-void sincos_ps(v4sf x, v4sf *s, v4sf *c) {
+inline void sincos_ps(v4sf x, v4sf *s, v4sf *c) {
   v4sf xmm1, xmm2, xmm3 = _mm_setzero_ps(), sign_bit_sin, y;
 #ifdef USE_SSE2
   v4si emm0, emm2, emm4;
@@ -772,4 +809,6 @@ void sincos_ps(v4sf x, v4sf *s, v4sf *c) {
   *c = _mm_xor_ps(xmm2, sign_bit_cos);
 }
 
-#endif
+#endif // SSEMATH_USE_SSE2
+
+#endif // SSE_MATHFUN
@@ -44,6 +44,7 @@
 #endif
 
 #include "FileNames.h"
+#include "MemoryX.h"
 #include "Prefs.h"
 #include "Project.h"
 #include "ProjectFileIORegistry.h"
@@ -56,6 +57,8 @@
 
 #include <wx/button.h>
 #include <wx/choice.h>
+#include <wx/ffile.h>
+#include <wx/file.h>
 #include <wx/filedlg.h>
 #include <wx/filename.h>
 #include <wx/intl.h>
@@ -71,6 +74,10 @@
 #include <wx/combobox.h>
 #include <wx/display.h>
 
+#ifdef USE_LIBID3TAG
+#include <id3tag.h>
+#endif
+
 static const wxChar *DefaultGenres[] =
 {
    wxT("Blues"),
@@ -608,6 +615,265 @@ void Tags::WriteXML(XMLWriter &xmlFile) const
    xmlFile.EndTag(wxT("tags"));
 }
 
+//
+// In-place metadata rewrite.  Metadata-correction passes used to re-encode
+// a whole file for a byte-sized change; these helpers patch the tag blocks
+// of an existing MP3 and leave the audio frames untouched.
+//
+
+#ifdef USE_LIBID3TAG
+
+struct id3_tag_deleter {
+   void operator () (id3_tag *p) const { if (p) id3_tag_delete(p); }
+};
+using id3_tag_holder = std::unique_ptr<id3_tag, id3_tag_deleter>;
+
+static const size_t ID3v2HeaderSize = 10;
+static const size_t ID3v1TagSize = 128;
+// Fresh padding left behind the tag when the audio has to be moved anyway,
+// so that the next few edits patch in place.
+static const unsigned long ID3v2Padding = 1024;
+
+// The four size bytes of an ID3v2 header carry seven bits each
+static unsigned long ParseSyncsafe(const unsigned char *p)
+{
+   return ((unsigned long) p[0] << 21) |
+          ((unsigned long) p[1] << 14) |
+          ((unsigned long) p[2] << 7) |
+          (unsigned long) p[3];
+}
+
+static void AddID3Frame(struct id3_tag *tp, const wxString & n, const wxString & v, const char *name)
+{
+   struct id3_frame *frame = id3_frame_new(name);
+
+   if (!n.IsAscii() || !v.IsAscii()) {
+      id3_field_settextencoding(id3_frame_field(frame, 0), ID3_FIELD_TEXTENCODING_UTF_16);
+   }
+   else {
+      id3_field_settextencoding(id3_frame_field(frame, 0), ID3_FIELD_TEXTENCODING_ISO_8859_1);
+   }
+
+   MallocString<id3_ucs4_t> ucs4{
+      id3_utf8_ucs4duplicate((id3_utf8_t *) (const char *) v.mb_str(wxConvUTF8)) };
+
+   if (strcmp(name, ID3_FRAME_COMMENT) == 0) {
+      // A hack to get around iTunes not recognizing the comment.  The
+      // language defaults to XXX and, since it's not a valid language,
+      // iTunes just ignores the tag.  So, either set it to a valid language
+      // (which one???) or just clear it.  Unfortunately, there's no supported
+      // way of clearing the field, so do it directly.
+      struct id3_frame *frame2 = id3_frame_new(name);
+      id3_field_setfullstring(id3_frame_field(frame2, 3), ucs4.get());
+      id3_field *f2 = id3_frame_field(frame2, 1);
+      memset(f2->immediate.value, 0, sizeof(f2->immediate.value));
+      id3_tag_attachframe(tp, frame2);
+      // Now install a second frame with the standard default language = "XXX"
+      id3_field_setfullstring(id3_frame_field(frame, 3), ucs4.get());
+   }
+   else if (strcmp(name, "TXXX") == 0) {
+      id3_field_setstring(id3_frame_field(frame, 2), ucs4.get());
+
+      ucs4.reset(id3_utf8_ucs4duplicate((id3_utf8_t *) (const char *) n.mb_str(wxConvUTF8)));
+
+      id3_field_setstring(id3_frame_field(frame, 1), ucs4.get());
+   }
+   else {
+      auto addr = ucs4.get();
+      id3_field_setstrings(id3_frame_field(frame, 1), 1, &addr);
+   }
+
+   id3_tag_attachframe(tp, frame);
+}
+
+// Renders a complete ID3v2 tag from the Tags into the buffer; when length
+// exceeds the minimal rendering, the tag is padded out to that many bytes.
+// Returns the rendered length.
+static unsigned long RenderID3v2(const Tags &tags, ArrayOf<char> &buffer, unsigned long length)
+{
+   id3_tag_holder tp { id3_tag_new() };
+
+   for (const auto &pair : tags.GetRange()) {
+      const auto &n = pair.first;
+      const auto &v = pair.second;
+      const char *name = "TXXX";
+
+      if (n.CmpNoCase(TAG_TITLE) == 0) {
+         name = ID3_FRAME_TITLE;
+      }
+      else if (n.CmpNoCase(TAG_ARTIST) == 0) {
+         name = ID3_FRAME_ARTIST;
+      }
+      else if (n.CmpNoCase(TAG_ALBUM) == 0) {
+         name = ID3_FRAME_ALBUM;
+      }
+      else if (n.CmpNoCase(TAG_YEAR) == 0) {
+         // LLL:  Some apps do not like the newer frame ID (ID3_FRAME_YEAR),
+         //       so we add old one as well.
+         AddID3Frame(tp.get(), n, v, "TYER");
+         name = ID3_FRAME_YEAR;
+      }
+      else if (n.CmpNoCase(TAG_GENRE) == 0) {
+         name = ID3_FRAME_GENRE;
+      }
+      else if (n.CmpNoCase(TAG_COMMENTS) == 0) {
+         name = ID3_FRAME_COMMENT;
+      }
+      else if (n.CmpNoCase(TAG_TRACK) == 0) {
+         name = ID3_FRAME_TRACK;
+      }
+
+      AddID3Frame(tp.get(), n, v, name);
+   }
+
+   tp->options &= (~ID3_TAG_OPTION_COMPRESSION); // No compression
+
+   // If this version of libid3tag supports it, use v2.3 ID3
+   // tags instead of the newer, but less well supported, v2.4
+   // that libid3tag uses by default.
+   #ifdef ID3_TAG_HAS_TAG_OPTION_ID3V2_3
+   tp->options |= ID3_TAG_OPTION_ID3V2_3;
+   #endif
+
+   unsigned long len = id3_tag_render(tp.get(), 0);
+   if (length > len) {
+      id3_tag_setlength(tp.get(), length);
+      len = id3_tag_render(tp.get(), 0);
+   }
+
+   buffer.reinit(len);
+   return id3_tag_render(tp.get(), (id3_byte_t *) buffer.get());
+}
+
+// ID3v1 fields are fixed width, space for space, unterminated when full
+static void StoreID3v1Field(unsigned char *dest, size_t len, const wxString &value)
+{
+   memset(dest, 0, len);
+   const wxCharBuffer buf = value.mb_str(wxConvISO8859_1);
+   if (buf) {
+      strncpy((char *) dest, buf, len);
+   }
+}
+
+static void MakeID3v1(Tags &tags, unsigned char tag[ID3v1TagSize])
+{
+   memset(tag, 0, ID3v1TagSize);
+   memcpy(tag, "TAG", 3);
+   StoreID3v1Field(&tag[3], 30, tags.GetTag(TAG_TITLE));
+   StoreID3v1Field(&tag[33], 30, tags.GetTag(TAG_ARTIST));
+   StoreID3v1Field(&tag[63], 30, tags.GetTag(TAG_ALBUM));
+   StoreID3v1Field(&tag[93], 4, tags.GetTag(TAG_YEAR));
+   StoreID3v1Field(&tag[97], 30, tags.GetTag(TAG_COMMENTS));
+
+   // v1.1 track number, with the zero byte before it as its marker
+   long track;
+   if (tags.GetTag(TAG_TRACK).ToLong(&track) && track > 0 && track < 256) {
+      tag[125] = 0;
+      tag[126] = (unsigned char) track;
+   }
+
+   tag[127] = (unsigned char) tags.GetGenre(tags.GetTag(TAG_GENRE));
+}
+
+#endif // USE_LIBID3TAG
+
+bool Tags::RewriteID3v2(const wxString &fileName)
+{
+#ifdef USE_LIBID3TAG
+   wxFFile file(fileName, wxT("r+b"));
+   if (!file.IsOpened()) {
+      return false;
+   }
+
+   const wxFileOffset fileLen = file.Length();
+
+   // Measure the existing tag, padding included, at the start of the file
+   unsigned long audioStart = 0;
+   unsigned char header[ID3v2HeaderSize];
+   if (file.Read(header, ID3v2HeaderSize) == ID3v2HeaderSize &&
+       memcmp(header, "ID3", 3) == 0) {
+      audioStart = ID3v2HeaderSize + ParseSyncsafe(&header[6]);
+      if (header[5] & 0x10) {
+         // The v2.4 footer is not counted in the size bytes
+         audioStart += ID3v2HeaderSize;
+      }
+   }
+   if ((wxFileOffset) audioStart > fileLen) {
+      // Truncated or lying header; don't touch the file
+      return false;
+   }
+
+   // An ID3v1 tag at the end of the file?
+   bool hasV1 = false;
+   unsigned char v1[ID3v1TagSize];
+   if (fileLen >= (wxFileOffset) (audioStart + ID3v1TagSize)) {
+      if (file.Seek(fileLen - ID3v1TagSize) &&
+          file.Read(v1, 3) == 3 &&
+          memcmp(v1, "TAG", 3) == 0) {
+         hasV1 = true;
+         MakeID3v1(*this, v1);
+      }
+   }
+
+   // Render the NEW v2 tag, asking for it to be padded out to exactly the
+   // space the old one occupied
+   ArrayOf<char> buffer;
+   unsigned long len = RenderID3v2(*this, buffer, audioStart);
+
+   if (audioStart > 0 && len == audioStart) {
+      // It fits; patch the tag bytes and leave the audio alone
+      if (!file.Seek(0) || file.Write(buffer.get(), len) != len) {
+         return false;
+      }
+      if (hasV1) {
+         if (!file.Seek(fileLen - ID3v1TagSize) ||
+             file.Write(v1, ID3v1TagSize) != ID3v1TagSize) {
+            return false;
+         }
+      }
+      return file.Flush();
+   }
+
+   // The tag outgrew its space (or the file had none); copy the audio once
+   // behind a NEW tag with fresh padding, then replace the file
+   len = RenderID3v2(*this, buffer, len + ID3v2Padding);
+
+   wxTempFile temp(fileName);
+   if (!temp.IsOpened()) {
+      return false;
+   }
+   if (!temp.Write(buffer.get(), len)) {
+      return false;
+   }
+
+   if (!file.Seek(audioStart)) {
+      return false;
+   }
+   wxFileOffset remaining =
+      fileLen - audioStart - (hasV1 ? ID3v1TagSize : 0);
+   ArrayOf<char> copyBuffer{ (size_t) 65536 };
+   while (remaining > 0) {
+      const size_t chunk =
+         (size_t) wxMin(remaining, (wxFileOffset) 65536);
+      if (file.Read(copyBuffer.get(), chunk) != chunk ||
+          !temp.Write(copyBuffer.get(), chunk)) {
+         return false;
+      }
+      remaining -= chunk;
+   }
+
+   if (hasV1 && !temp.Write(v1, ID3v1TagSize)) {
+      return false;
+   }
+
+   file.Close();
+   return temp.Commit();
+#else
+   wxUnusedVar(fileName);
+   return false;
+#endif
+}
+
 bool Tags::ShowEditDialog(wxWindow *parent, const wxString &title, bool force)
 {
    if (force) {
@@ -117,6 +117,15 @@ class AUDACITY_DLL_API Tags final
    void SetTag(const wxString & name, const wxString & value, const bool bSpecialTag=false);
    void SetTag(const wxString & name, const int & value);
 
+   ///Patches the metadata of an existing exported MP3 file in place, without
+   ///re-encoding any audio.  When the NEW ID3v2 tag fits in the space of the
+   ///old one (including its padding), only the tag bytes are overwritten;
+   ///otherwise the audio data is block-copied once behind a NEW tag that is
+   ///left with fresh padding for the next edit.  An ID3v1 tag at the end of
+   ///the file, being fixed size, is always patched in place.  Returns false
+   ///if the file could not be updated or libid3tag is not compiled in.
+   bool RewriteID3v2(const wxString &fileName);
+
    bool IsEmpty();
    void Clear();
 
@@ -456,18 +456,11 @@ void ThemeBase::RegisterImage( int &iIndex, const wxImage &Image, const wxString
    wxASSERT( iIndex == -1 ); // Don't initialise same bitmap twice!
    mImages.push_back( Image );
 
-#ifdef __APPLE__
-   // On Mac, bitmaps with alpha don't work.
-   // So we convert to a mask and use that.
-   // It isn't quite as good, as alpha gives smoother edges.
-   //[Does not affect the large control buttons, as for those we do
-   // the blending ourselves anyway.]
-   wxImage TempImage( Image );
-   TempImage.ConvertAlphaToMask();
-   mBitmaps.push_back( wxBitmap( TempImage ) );
-#else
-   mBitmaps.push_back( wxBitmap( Image ) );
-#endif
+   // The bitmap is not built yet.  Nearly all of these images are
+   // placeholders that ReadImageCache() replaces with slices of the theme's
+   // image cache before anything draws, so Bitmap() makes bitmaps from the
+   // final images on first use instead.
+   mBitmaps.push_back( wxBitmap{} );
 
    mBitmapNames.push_back( Name );
    mBitmapFlags.push_back( mFlow.mFlags );
@@ -1031,7 +1024,9 @@ bool ThemeBase::ReadImageCache( teThemeType type, bool bOkIfNotFound)
          wxRect R = mFlow.RectInner();
          //wxLogDebug( "[%i, %i, %i, %i, \"%s\"], ", R.x, R.y, R.width, R.height, mBitmapNames[i].c_str() );
          Image = GetSubImageWithAlpha( ImageCache, mFlow.RectInner() );
-         mBitmaps[i] = wxBitmap(Image);
+         // Discard any bitmap made from the old image; Bitmap() remakes
+         // it from the NEW image if and when it is actually wanted.
+         mBitmaps[i] = wxBitmap{};
       }
    }
    if( !ImageCache.HasAlpha() )
@@ -1104,7 +1099,7 @@ void ThemeBase::LoadComponents( bool bOkIfNotFound )
                // wxLogDebug( wxT("File %s lacked alpha"), mBitmapNames[i] );
                mImages[i].InitAlpha();
             }
-            mBitmaps[i] = wxBitmap( mImages[i] );
+            mBitmaps[i] = wxBitmap{}; // remade on demand by Bitmap()
             n++;
          }
       }
@@ -1231,7 +1226,14 @@ wxBitmap & ThemeBase::Bitmap( int iIndex )
 {
    wxASSERT( iIndex >= 0 );
    EnsureInitialised();
-   return mBitmaps[iIndex];
+   wxBitmap &Bmp = mBitmaps[iIndex];
+   // An invalid entry means the image was registered or replaced since the
+   // bitmap was last wanted.  Bitmaps are made from the images on demand,
+   // so that loading or switching a theme only pays for slicing the image
+   // cache, not for converting every slice to a bitmap up front.
+   if( !Bmp.IsOk() )
+      Bmp = wxBitmap( mImages[iIndex] );
+   return Bmp;
 }
 
 wxImage  & ThemeBase::Image( int iIndex )
@@ -1273,7 +1275,8 @@ wxFont   & ThemeBase::Font( int iIndex )
 void ThemeBase::ReplaceImage( int iIndex, wxImage * pImage )
 {
    Image( iIndex ) = *pImage;
-   Bitmap( iIndex ) = wxBitmap( *pImage );
+   // Invalidate rather than rebuild; Bitmap() remakes it on demand.
+   mBitmaps[ iIndex ] = wxBitmap{};
 }
 
 void ThemeBase::RotateImageInto( int iTo, int iFrom, bool bClockwise )
@@ -575,16 +575,14 @@ void TrackList::RecalcPositions(TrackNodePointer node)
 
 void TrackList::SelectionEvent( const std::shared_ptr<Track> &pTrack )
 {
-   // wxWidgets will own the event object
-   QueueEvent(
-      safenew TrackListEvent{ EVT_TRACKLIST_SELECTION_CHANGE, pTrack } );
+   QueueOrBatchEvent( std::make_unique<TrackListEvent>(
+      EVT_TRACKLIST_SELECTION_CHANGE, pTrack ) );
 }
 
 void TrackList::DataEvent( const std::shared_ptr<Track> &pTrack, int code )
 {
-   // wxWidgets will own the event object
-   QueueEvent(
-      safenew TrackListEvent{ EVT_TRACKLIST_TRACK_DATA_CHANGE, pTrack, code } );
+   QueueOrBatchEvent( std::make_unique<TrackListEvent>(
+      EVT_TRACKLIST_TRACK_DATA_CHANGE, pTrack, code ) );
 }
 
 void TrackList::EnsureVisibleEvent(
@@ -593,37 +591,75 @@ void TrackList::EnsureVisibleEvent(
    auto pEvent = std::make_unique<TrackListEvent>(
       EVT_TRACKLIST_TRACK_REQUEST_VISIBLE, pTrack, 0 );
    pEvent->SetInt( modifyState ? 1 : 0 );
-   // wxWidgets will own the event object
-   QueueEvent( pEvent.release() );
+   QueueOrBatchEvent( std::move( pEvent ) );
 }
 
 void TrackList::PermutationEvent(TrackNodePointer node)
 {
-   // wxWidgets will own the event object
-   QueueEvent( safenew TrackListEvent{ EVT_TRACKLIST_PERMUTED, *node.first } );
+   QueueOrBatchEvent( std::make_unique<TrackListEvent>(
+      EVT_TRACKLIST_PERMUTED, *node.first ) );
 }
 
 void TrackList::DeletionEvent(TrackNodePointer node)
 {
-   // wxWidgets will own the event object
-   QueueEvent( safenew TrackListEvent{
+   QueueOrBatchEvent( std::make_unique<TrackListEvent>(
       EVT_TRACKLIST_DELETION,
       node.second && node.first != node.second->end()
          ? *node.first
          : nullptr
-   } );
+   ) );
 }
 
 void TrackList::AdditionEvent(TrackNodePointer node)
 {
-   // wxWidgets will own the event object
-   QueueEvent( safenew TrackListEvent{ EVT_TRACKLIST_ADDITION, *node.first } );
+   QueueOrBatchEvent( std::make_unique<TrackListEvent>(
+      EVT_TRACKLIST_ADDITION, *node.first ) );
 }
 
 void TrackList::ResizingEvent(TrackNodePointer node)
 {
-   // wxWidgets will own the event object
-   QueueEvent( safenew TrackListEvent{ EVT_TRACKLIST_RESIZING, *node.first } );
+   QueueOrBatchEvent( std::make_unique<TrackListEvent>(
+      EVT_TRACKLIST_RESIZING, *node.first ) );
+}
+
+void TrackList::QueueOrBatchEvent( std::unique_ptr<TrackListEvent> pEvent )
+{
+   if (mBatchDepth == 0) {
+      // wxWidgets will own the event object
+      QueueEvent( pEvent.release() );
+      return;
+   }
+
+   // Drop the notification if an identical one is already held back; a
+   // bulk edit repeats the same few notifications once per mutation, and
+   // the listeners' reactions to them are idempotent
+   const auto end = mPendingEvents.end();
+   const auto iter = std::find_if( mPendingEvents.begin(), end,
+      [&]( const std::unique_ptr<TrackListEvent> &p ){
+         return p->GetEventType() == pEvent->GetEventType() &&
+            !p->mpTrack.owner_before( pEvent->mpTrack ) &&
+            !pEvent->mpTrack.owner_before( p->mpTrack ) &&
+            p->mCode == pEvent->mCode &&
+            p->GetInt() == pEvent->GetInt();
+      } );
+   if (iter == end)
+      mPendingEvents.push_back( std::move( pEvent ) );
+}
+
+void TrackList::BeginBatch()
+{
+   ++mBatchDepth;
+}
+
+void TrackList::EndBatch()
+{
+   wxASSERT( mBatchDepth > 0 );
+   if (--mBatchDepth == 0) {
+      for (auto &pEvent : mPendingEvents)
+         // wxWidgets will own the event object
+         QueueEvent( pEvent.release() );
+      mPendingEvents.clear();
+   }
 }
 
 auto TrackList::EmptyRange() const
@@ -1508,6 +1508,35 @@ private:
    void AdditionEvent(TrackNodePointer node);
    void ResizingEvent(TrackNodePointer node);
 
+   // All of the event methods above funnel through this.  Outside of a
+   // batch it queues the event at once; within one, it holds the event
+   // back, dropping it if an identical notification is already pending
+   void QueueOrBatchEvent( std::unique_ptr<TrackListEvent> pEvent );
+   void BeginBatch();
+   void EndBatch();
+
+public:
+   // While one of these is alive, notifications from this track list are
+   // coalesced:  an event identical to one already pending is dropped, and
+   // the rest are queued together when the last nested batch closes.  Bulk
+   // operations that mutate many tracks or clips should open one, so that
+   // listeners hear each distinct change once instead of once per mutation.
+   struct EventBatch {
+      explicit EventBatch( TrackList &list )
+         : mList{ list }
+      { mList.BeginBatch(); }
+      ~EventBatch()
+      { mList.EndBatch(); }
+      EventBatch( const EventBatch & ) PROHIBITED;
+      EventBatch &operator=( const EventBatch & ) PROHIBITED;
+   private:
+      TrackList &mList;
+   };
+
+private:
+   unsigned mBatchDepth{ 0 };
+   std::vector< std::unique_ptr<TrackListEvent> > mPendingEvents;
+
    void SwapNodes(TrackNodePointer s1, TrackNodePointer s2);
 
    // Nondecreasing during the session.
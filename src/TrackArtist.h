@@ -21,6 +21,8 @@
 #include "Audacity.h" // for USE_* macros
 #include "Experimental.h"
 
+#include <vector>
+
 #include <wx/brush.h> // member variable
 #include <wx/pen.h> // member variables
 
@@ -131,6 +133,11 @@ public:
    const SelectedRegion *pSelectedRegion{};
    ZoomInfo *pZoomInfo{};
 
+   // Scratch table of per-column times, refilled from
+   // ZoomInfo::FindColumnTimes by the drawing routines that need a time for
+   // every pixel column, and reused across clips and paints
+   std::vector<double> columnTimes;
+
    bool drawEnvelope{ false };
    bool bigPoints{ false };
    bool drawSliders{ false };
@@ -69,6 +69,7 @@ is time to refresh some aspect of the screen.
 #include "AudioIO.h"
 #include "float_cast.h"
 
+#include "PerfCounters.h"
 #include "Prefs.h"
 #include "RefreshCode.h"
 #include "TrackArtist.h"
@@ -283,6 +284,7 @@ TrackPanel::TrackPanel(wxWindow * parent, wxWindowID id,
    mTrackArtist = std::make_unique<TrackArtist>( this );
 
    mTimeCount = 0;
+   mAudioPressureTicks = 0;
    mTimer.parent = this;
    // Timer is started after the window is visible
    ProjectWindow::Get( *GetProject() ).Bind(wxEVT_IDLE,
@@ -444,8 +446,45 @@ void TrackPanel::OnTimer(wxTimerEvent& )
       p->ProcessEvent(e);
    }
 
-   DrawOverlays(false);
-   mRuler->DrawOverlays(false);
+   // Surface xrun alerts from the audio callback telemetry
+   if (IsAudioActive()) {
+      const auto alert = gAudioIO->GetTelemetryAlert();
+      if (!alert.empty())
+         ProjectStatus::Get( *p ).Set( alert );
+   }
+
+   // Adapt the refresh work to pressure on the audio thread.  When the
+   // callback telemetry reports xruns or low ring buffers, degrade the
+   // playhead refresh rate for a while so that painting stops competing
+   // with FillBuffers for the machine; unbroken audio matters more than
+   // a smooth cursor.
+   if (IsAudioActive()) {
+      switch (gAudioIO->GetCallbackPressure()) {
+      case 2:
+         // Five seconds of degraded refresh after an xrun
+         mAudioPressureTicks = 5000 / kTimerInterval;
+         break;
+      case 1:
+         // Two seconds after a ring buffer merely ran low
+         mAudioPressureTicks =
+            std::max(mAudioPressureTicks, 2000 / kTimerInterval);
+         break;
+      default:
+         break;
+      }
+   }
+   else
+      mAudioPressureTicks = 0;
+
+   bool degraded = mAudioPressureTicks > 0;
+   if (degraded)
+      --mAudioPressureTicks;
+
+   // Under pressure, draw overlays at a quarter of the usual rate
+   if (!degraded || (mTimeCount % 4) == 0) {
+      DrawOverlays(false);
+      mRuler->DrawOverlays(false);
+   }
 
    if(IsAudioActive() && gAudioIO->GetNumCaptureChannels()) {
 
@@ -458,7 +497,9 @@ void TrackPanel::OnTimer(wxTimerEvent& )
          Refresh( false );
       }
       else {
-         if ((mTimeCount % 5) == 0) {
+         // Under pressure, repaint the recorded waveform a quarter as
+         // often as well
+         if ((mTimeCount % (degraded ? 20 : 5)) == 0) {
             // Must tell OnPaint() to recreate the backing bitmap
             // since we've not done a full refresh.
             mRefreshBacking = true;
@@ -501,6 +542,8 @@ void TrackPanel::OnUndoReset( wxCommandEvent &event )
 ///  completing a repaint operation.
 void TrackPanel::OnPaint(wxPaintEvent & /* event */)
 {
+   PerfCounters::Scope scope{ PerfCounters::TrackPanelPaint };
+
    mLastDrawnSelectedRegion = mViewInfo->selectedRegion;
 
 #if DEBUG_DRAW_TIMING
@@ -519,6 +562,7 @@ void TrackPanel::OnPaint(wxPaintEvent & /* event */)
       {
          // Reset (should a mutex be used???)
          mRefreshBacking = false;
+         mBackingDamage.Clear();
 
          // Redraw the backing bitmap
          DrawTracks(&GetBackingDCForRepaint());
@@ -526,6 +570,20 @@ void TrackPanel::OnPaint(wxPaintEvent & /* event */)
          // Copy it to the display
          DisplayBitmap(dc);
       }
+      else if (!mBackingDamage.IsEmpty())
+      {
+         // Re-render only the damaged cells into the backing bitmap.
+         // The clipping region both confines the output and lets
+         // CellularPanel::Draw skip cells that lie wholly outside it.
+         auto &backingDC = GetBackingDCForRepaint();
+         backingDC.SetDeviceClippingRegion(mBackingDamage);
+         DrawTracks(&backingDC);
+         backingDC.DestroyClippingRegion();
+         mBackingDamage.Clear();
+
+         // Copy full, possibly clipped, damage rectangle
+         RepairBitmap(dc, box.x, box.y, box.width, box.height);
+      }
       else
       {
          // Copy full, possibly clipped, damage rectangle
@@ -798,7 +856,10 @@ void TrackPanel::RefreshTrack(Track *trk, bool refreshbacking)
 
    if( refreshbacking )
    {
-      mRefreshBacking = true;
+      // Mark only this track's rectangle of the backing bitmap damaged,
+      // rather than invalidating the whole bitmap; OnPaint() then redraws
+      // just the cells that intersect it.
+      mBackingDamage.Union( rect );
    }
 
    Refresh( false, &rect );
@@ -1356,6 +1417,31 @@ wxRect TrackPanel::FindTrackRect( const Track * target )
    } );
 }
 
+void TrackPanel::VisitVisibleChannels(
+   const std::function< void(Track &channel, int top, int bottom) > &visitor )
+{
+   // Mimics the vertical arithmetic of Subgroup, ResizingChannelGroup and
+   // ChannelGroup above, but without allocating any of those throwaway
+   // objects, and stopping at the bottom of the visible area
+   const auto height = GetClientRect().GetHeight();
+   auto &tracks = *GetTracks();
+   if ( !tracks.Any() )
+      return;
+
+   wxCoord yy = -mViewInfo->vpos + kTopMargin;
+   for ( auto leader : tracks.Leaders() ) {
+      for ( auto channel : TrackList::Channels( leader ) ) {
+         if ( yy >= height )
+            return;
+         const auto channelHeight = TrackView::Get( *channel ).GetHeight();
+         const auto bottom = yy + channelHeight - kSeparatorThickness - 1;
+         if ( bottom >= 0 )
+            visitor( *channel, yy, bottom );
+         yy += channelHeight;
+      }
+   }
+}
+
 TrackPanelCell *TrackPanel::GetFocusedCell()
 {
    auto pTrack = TrackFocus::Get( *GetProject() ).Get();
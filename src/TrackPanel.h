@@ -17,6 +17,7 @@
 #include <vector>
 
 #include <wx/setup.h> // for wxUSE_* macros
+#include <wx/region.h> // member variable
 #include <wx/timer.h> // to inherit
 
 #include "HitTestResult.h"
@@ -145,6 +146,15 @@ public:
    // the proper track area of all channels, and the separators between them.
    wxRect FindTrackRect( const Track * target );
 
+   // Visit the vertical extents of the visible channels, top to bottom,
+   // without building the recursive subdivision of cells.  This is cheap
+   // enough for overlays that redraw at timer rate, whose cost must not
+   // grow with the number of tracks in the project.  The extents passed to
+   // the visitor are those of the channel's cell, in window coordinates.
+   void VisitVisibleChannels(
+      const std::function< void(Track &channel, int top, int bottom) >
+         &visitor );
+
 protected:
    void MakeParentModifyState(bool bWantsAutoSave);    // if true, writes auto-save file. Should set only if you really want the state change restored after
                                                                // a crash, as it can take many seconds for large (eg. 10 track-hours) projects
@@ -201,8 +211,18 @@ protected:
 
    int mTimeCount;
 
+   // Remaining timer ticks of degraded refresh after the audio callback
+   // telemetry reported pressure; see OnTimer
+   int mAudioPressureTicks;
+
    bool mRefreshBacking;
 
+   // Parts of the backing bitmap that must be re-rendered before the next
+   // repaint.  Unlike the window's own update region this also covers
+   // damage that is scrolled off screen, and unlike mRefreshBacking it
+   // lets OnPaint() redraw just the damaged cells instead of all of them.
+   wxRegion mBackingDamage;
+
 #ifdef EXPERIMENTAL_SPECTRAL_EDITING
 
 protected:
@@ -0,0 +1,160 @@
+/**********************************************************************
+
+  Audacity: A Digital Audio Editor
+
+  TrackProxy.cpp
+
+*******************************************************************//**
+
+\class TrackProxy
+\brief Maintains half-rate, 16-bit stand-ins for wave tracks so that
+playback while editing reads a quarter of the data from disk.
+
+*//*******************************************************************/
+
+#include "Audacity.h"
+#include "TrackProxy.h"
+
+#include <wx/intl.h>
+
+#include "Envelope.h"
+#include "Mix.h"
+#include "Prefs.h"
+#include "WaveClip.h"
+#include "WaveTrack.h"
+#include "widgets/ProgressDialog.h"
+
+TrackProxy &TrackProxy::Get()
+{
+   static TrackProxy cache;
+   return cache;
+}
+
+bool TrackProxy::IsEnabled()
+{
+   bool enabled;
+   gPrefs->Read(wxT("/AudioIO/ProxyPlayback"), &enabled, false);
+   return enabled;
+}
+
+std::vector<double> TrackProxy::Fingerprint(const WaveTrack &track)
+{
+   // Unlike a frozen rendering (see TrackFreeze), a proxy bakes in the
+   // clip envelopes, so envelope points join the clip boundaries in the
+   // staleness test
+   std::vector<double> result;
+   result.push_back(track.GetRate());
+   const auto hash = track.GetContentHash();
+   result.push_back(double(hash & 0xffffffff));
+   result.push_back(double(hash >> 32));
+   for (const auto &clip : track.GetClips()) {
+      result.push_back(clip->GetStartTime());
+      result.push_back(clip->GetEndTime());
+
+      const auto env = clip->GetEnvelope();
+      const size_t numPoints = env->GetNumberOfPoints();
+      result.push_back(numPoints);
+      if (numPoints > 0) {
+         Doubles when{ numPoints }, value{ numPoints };
+         env->GetPoints(when.get(), value.get(), numPoints);
+         for (size_t i = 0; i < numPoints; i++) {
+            result.push_back(when[i]);
+            result.push_back(value[i]);
+         }
+      }
+   }
+   return result;
+}
+
+bool TrackProxy::Build(AudacityProject &project, WaveTrack &track)
+{
+   const double startTime = track.GetStartTime();
+   const double endTime = track.GetEndTime();
+   if (endTime <= startTime)
+      return false;
+
+   const double proxyRate = track.GetRate() / 2.0;
+   const auto maxBlockLen = track.GetIdealBlockSize();
+
+   // The mixer handles the rate conversion and applies the clip
+   // envelopes; gain and pan stay live in the audio callback, which
+   // keeps reading them from the source track
+   WaveTrackConstArray mixTracks;
+   mixTracks.push_back(track.SharedPointer< const WaveTrack >());
+   Mixer mixer(mixTracks,
+      // Don't throw for read errors, just render silence:
+      false,
+      Mixer::WarpOptions{ nullptr },
+      startTime, endTime, 1, maxBlockLen, false,
+      proxyRate, int16Sample);
+   mixer.ApplyTrackGains(false);
+
+   auto proxy =
+      TrackFactory::Get( project ).NewWaveTrack(int16Sample, proxyRate);
+   proxy->SetOffset(startTime);
+
+   while (true) {
+      auto blockLen = mixer.Process(maxBlockLen);
+      if (blockLen == 0)
+         break;
+      proxy->Append(mixer.GetBuffer(), int16Sample, blockLen);
+   }
+   proxy->Flush();
+
+   mEntries[&track] = Entry{ std::move(proxy), Fingerprint(track) };
+   return true;
+}
+
+bool TrackProxy::BuildAll(AudacityProject &project)
+{
+   const auto range = TrackList::Get( project ).Any< WaveTrack >();
+
+   const int total = range.size();
+   if (total == 0)
+      return true;
+
+   ProgressDialog progress(_("Proxy Playback"),
+      _("Building reduced-resolution playback copies"));
+
+   int done = 0;
+   for (auto track : range) {
+      auto it = mEntries.find(track);
+      if (it == mEntries.end() ||
+          it->second.fingerprint != Fingerprint(*track))
+         Build(project, *track);
+
+      auto updateResult = progress.Update(++done, total);
+      if (updateResult == ProgressResult::Cancelled ||
+          updateResult == ProgressResult::Failed)
+         return false;
+   }
+
+   return true;
+}
+
+void TrackProxy::Invalidate(const WaveTrack *pTrack)
+{
+   mEntries.erase(pTrack);
+}
+
+void TrackProxy::InvalidateAll()
+{
+   mEntries.clear();
+}
+
+std::shared_ptr<WaveTrack> TrackProxy::Proxy(const WaveTrack *pTrack)
+{
+   auto it = mEntries.find(pTrack);
+   if (it == mEntries.end())
+      return {};
+
+   auto &entry = it->second;
+   if (entry.fingerprint != Fingerprint(*pTrack)) {
+      // Stale; playback falls back to the full-quality original until
+      // the proxies are next rebuilt
+      mEntries.erase(it);
+      return {};
+   }
+
+   return entry.proxy;
+}
@@ -0,0 +1,74 @@
+/**********************************************************************
+
+  Audacity: A Digital Audio Editor
+
+  TrackProxy.h
+
+**********************************************************************/
+
+#ifndef __AUDACITY_TRACK_PROXY__
+#define __AUDACITY_TRACK_PROXY__
+
+#include <map>
+#include <memory>
+#include <vector>
+
+class AudacityProject;
+class WaveTrack;
+
+/**********************************************************************//**
+
+\class TrackProxy
+\brief Cache of reduced-resolution (half-rate, 16 bit) stand-ins for
+wave tracks, read by the playback mixers while proxy playback is on.
+
+A 96 kHz 32-bit-float session does not need full resolution while
+editing over laptop monitoring.  With the "Proxy Playback" transport
+option enabled, AudioIO substitutes these proxies into the playback
+mixers, quartering disk bandwidth during playback; export and mix-down
+always read the full-quality originals.  A proxy silently goes stale --
+and playback falls back to the original -- when the track's clips or
+envelopes are edited.
+
+**************************************************************************/
+class TrackProxy final
+{
+public:
+   /** Get the singleton instance of the TrackProxy cache. **/
+   static TrackProxy &Get();
+
+   //! The project-wide transport option, persisted among the other
+   //! AudioIO settings
+   static bool IsEnabled();
+
+   //! Build or refresh proxies for every wave track of the project;
+   //! returns false if cancelled
+   bool BuildAll(AudacityProject &project);
+
+   //! The reduced-resolution stand-in for the given track, or null if
+   //! there is none or the track was edited since it was built
+   std::shared_ptr<WaveTrack> Proxy(const WaveTrack *pTrack);
+
+   //! Discard the proxy of one track, or of every track
+   void Invalidate(const WaveTrack *pTrack);
+   void InvalidateAll();
+
+private:
+   TrackProxy() = default;
+
+   //! Render one track's reduced-resolution copy
+   bool Build(AudacityProject &project, WaveTrack &track);
+
+   // Rate, clip boundaries and envelope points at build time; a mismatch
+   // later means the proxy no longer matches the track
+   static std::vector<double> Fingerprint(const WaveTrack &track);
+
+   struct Entry {
+      std::shared_ptr<WaveTrack> proxy;
+      std::vector<double> fingerprint;
+   };
+
+   std::map< const WaveTrack*, Entry > mEntries;
+};
+
+#endif
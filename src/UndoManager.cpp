@@ -37,6 +37,7 @@ UndoManager
 #include "Tags.h"
 
 
+#include <unordered_map>
 #include <unordered_set>
 
 wxDEFINE_EVENT(EVT_UNDO_PUSHED, wxCommandEvent);
@@ -63,6 +64,12 @@ struct UndoStackElem {
    UndoState state;
    wxString description;
    wxString shortDescription;
+
+   // The distinct block files referenced by this state's tracks, gathered
+   // once when the state is pushed or modified.  The History window's
+   // space calculation replays these lists instead of walking every
+   // track, clip and sequence of every state on each refresh.
+   std::vector< std::shared_ptr<BlockFile> > blocks;
 };
 
 static const AudacityProject::AttachedObjects::RegisteredFactory key{
@@ -94,8 +101,57 @@ UndoManager::~UndoManager()
 }
 
 namespace {
+   // Block files are written once, so their disk usage may be remembered
+   // between recalculations instead of querying the filesystem again for
+   // every block of every saved state.  The weak pointer detects a
+   // recycled address, and zero results are not kept, because several
+   // GetSpaceUsage overrides return 0 to mean "not written yet".
+   using SizeCache = std::unordered_map< ConstBlockFilePtr,
+      std::pair< std::weak_ptr<BlockFile>, unsigned long long > >;
+
+   unsigned long long
+   LookUpUsage(const std::shared_ptr<BlockFile> &file,
+               const SizeCache &oldSizes, SizeCache &newSizes)
+   {
+      unsigned long long usage;
+      auto iter = oldSizes.find( &*file );
+      if (iter != oldSizes.end() &&
+          iter->second.first.lock() == file)
+         usage = iter->second.second;
+      else
+         usage = file->GetSpaceUsage();
+      if (usage != 0)
+         newSizes[ &*file ] = { file, usage };
+      return usage;
+   }
+
+   // List each block file of the state just once, however many places
+   // it occurs in the tracks
+   void GatherBlocks(const TrackList &tracks,
+                     std::vector< std::shared_ptr<BlockFile> > &result)
+   {
+      result.clear();
+      Set seen;
+      for (auto wt : tracks.Any< const WaveTrack >())
+      {
+         // Scan all clips within current track
+         for(const auto &clip : wt->GetAllClips())
+         {
+            // Scan all blockfiles within current clip
+            auto blocks = clip->GetSequenceBlockArray();
+            for (const auto &block : *blocks)
+            {
+               const auto &file = block.f;
+               if (seen.insert( &*file ).second)
+                  result.push_back( file );
+            }
+         }
+      }
+   }
+
    SpaceArray::value_type
-   CalculateUsage(const TrackList &tracks, Set *seen)
+   CalculateUsage(const TrackList &tracks, Set *seen,
+                  const SizeCache &oldSizes, SizeCache &newSizes)
    {
       SpaceArray::value_type result = 0;
 
@@ -114,10 +170,7 @@ namespace {
                // Accumulate space used by the file if the file was not
                // yet seen
                if ( !seen || (seen->count( &*file ) == 0 ) )
-               {
-                  unsigned long long usage{ file->GetSpaceUsage() };
-                  result += usage;
-               }
+                  result += LookUpUsage( file, oldSizes, newSizes );
 
                // Add file to current set
                if (seen)
@@ -151,15 +204,29 @@ void UndoManager::CalculateSpaceUsage()
    // DELETE all states containing the block file.  So the block file's
    // contribution to space usage should be counted only in that latest state.
 
+   // Sizes learned in previous recalculations; rebuilt on each pass so
+   // that entries for files no longer in any state are dropped
+   static SizeCache sizes;
+   SizeCache newSizes;
+   newSizes.reserve(sizes.size());
+
    for (size_t nn = stack.size(); nn--;)
    {
-      // Scan all tracks at current level
-      auto &tracks = *stack[nn]->state.tracks;
-      space[nn] = CalculateUsage(tracks, &seen);
+      // Replay the block list gathered when the state was pushed; no
+      // need to scan its tracks again
+      SpaceArray::value_type result = 0;
+      for (const auto &file : stack[nn]->blocks)
+      {
+         if (seen.insert( &*file ).second)
+            result += LookUpUsage( file, sizes, newSizes );
+      }
+      space[nn] = result;
    }
 
    mClipboardSpaceUsage = CalculateUsage(
-      Clipboard::Get().GetTracks(), nullptr);
+      Clipboard::Get().GetTracks(), nullptr, sizes, newSizes);
+
+   sizes.swap(newSizes);
 
    //TIMER_STOP( space_calc );
 }
@@ -251,6 +318,7 @@ void UndoManager::ModifyState(const TrackList * l,
    SonifyBeginModifyState();
    // Delete current -- not necessary, but let's reclaim space early
    stack[current]->state.tracks.reset();
+   stack[current]->blocks.clear();
 
    // Duplicate
    auto tracksCopy = TrackList::Create();
@@ -264,6 +332,7 @@ void UndoManager::ModifyState(const TrackList * l,
    // Replace
    stack[current]->state.tracks = std::move(tracksCopy);
    stack[current]->state.tags = tags;
+   GatherBlocks(*stack[current]->state.tracks, stack[current]->blocks);
 
    stack[current]->state.selectedRegion = selectedRegion;
    SonifyEndModifyState();
@@ -315,6 +384,7 @@ void UndoManager::PushState(const TrackList * l,
          (std::move(tracksCopy),
             longDescription, shortDescription, selectedRegion, tags)
    );
+   GatherBlocks(*stack.back()->state.tracks, stack.back()->blocks);
 
    current++;
 
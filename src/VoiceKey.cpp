@@ -34,6 +34,14 @@ or "OFF" point
 #include "widgets/AudacityMessageBox.h"
 #include "widgets/ErrorDialog.h"
 
+// Process blocks of samples four at a time where SSE2 is available.
+// SSE2 may be assumed on all x86_64 targets.
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VOICEKEY_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
 using std::cout;
 using std::endl;
 
@@ -657,6 +665,120 @@ sampleCount VoiceKey::OffBackward (
    }
 }
 
+//---------------------------------------------------------------------------
+//                Block statistics
+// These compute the raw sums behind the test statistics over a resident
+// buffer of samples, vectorized where possible.  Note that sgn() (see
+// VoiceKey.h) truncates its float argument to int, so it reports a
+// negative sign only for values at or below -1.0; the SSE2 paths below
+// reproduce that comparison exactly.
+
+#ifdef VOICEKEY_USE_SSE2
+//Number of bits set in a four-bit _mm_movemask_ps result
+static const unsigned char bitsSet[16] =
+   { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+#endif
+
+//Sum of squared samples
+static double SumOfSquares(const float *buffer, size_t len)
+{
+   double sum = 0;
+   size_t i = 0;
+#ifdef VOICEKEY_USE_SSE2
+   __m128d dsum = _mm_setzero_pd();
+   for (; i + 4 <= len; i += 4) {
+      const __m128 x = _mm_loadu_ps(buffer + i);
+      const __m128 sq = _mm_mul_ps(x, x);
+      //Accumulate in double so long blocks lose no precision
+      dsum = _mm_add_pd(dsum, _mm_cvtps_pd(sq));
+      dsum = _mm_add_pd(dsum, _mm_cvtps_pd(_mm_movehl_ps(sq, sq)));
+   }
+   double partial[2];
+   _mm_storeu_pd(partial, dsum);
+   sum = partial[0] + partial[1];
+#endif
+   for (; i < len; i++)
+      sum += buffer[i] * buffer[i];
+   return sum;
+}
+
+//Number of places where sgn() of a sample differs from sgn() of its
+//predecessor.  currentsign carries the last sign across buffers and is
+//left at sgn() of the final sample.
+static unsigned long CountSignChanges(
+   int &currentsign, const float *buffer, size_t len)
+{
+   unsigned long changes = 0;
+   size_t i = 0;
+   //Compare the first sample against the carried-in sign
+   if (len > 0) {
+      if (sgn(buffer[0]) != currentsign)
+         changes++;
+      i = 1;
+   }
+#ifdef VOICEKEY_USE_SSE2
+   //sgn() takes only the values -1 and 1, so comparing signs of
+   //neighboring samples reduces to comparing (x <= -1.0) lane masks
+   const __m128 negative = _mm_set1_ps(-1.0f);
+   for (; i + 4 <= len; i += 4) {
+      const int prev = _mm_movemask_ps(
+         _mm_cmple_ps(_mm_loadu_ps(buffer + i - 1), negative));
+      const int cur = _mm_movemask_ps(
+         _mm_cmple_ps(_mm_loadu_ps(buffer + i), negative));
+      changes += bitsSet[prev ^ cur];
+   }
+#endif
+   for (; i < len; i++)
+      if (sgn(buffer[i]) != sgn(buffer[i - 1]))
+         changes++;
+   if (len > 0)
+      currentsign = sgn(buffer[len - 1]);
+   return changes;
+}
+
+//Number of places where sgn() of the first difference changes.
+//lastval and lastdirection carry state across buffers.
+static unsigned long CountDirectionChanges(
+   int &lastdirection, float &lastval, const float *buffer, size_t len)
+{
+   unsigned long changes = 0;
+   size_t i = 0;
+   //The first two differences involve the carried-in lastval
+   for (; i < len && i < 2; i++) {
+      if (sgn(buffer[i] - lastval) != lastdirection) {
+         changes++;
+         lastdirection = sgn(buffer[i] - lastval);
+      }
+      lastval = buffer[i];
+   }
+#ifdef VOICEKEY_USE_SSE2
+   const __m128 negative = _mm_set1_ps(-1.0f);
+   for (; i + 4 <= len; i += 4) {
+      const __m128 a = _mm_loadu_ps(buffer + i - 2);
+      const __m128 b = _mm_loadu_ps(buffer + i - 1);
+      const __m128 c = _mm_loadu_ps(buffer + i);
+      const int prev =
+         _mm_movemask_ps(_mm_cmple_ps(_mm_sub_ps(b, a), negative));
+      const int cur =
+         _mm_movemask_ps(_mm_cmple_ps(_mm_sub_ps(c, b), negative));
+      changes += bitsSet[prev ^ cur];
+   }
+   if (i > 2) {
+      lastdirection = sgn(buffer[i - 1] - buffer[i - 2]);
+      lastval = buffer[i - 1];
+   }
+#endif
+   for (; i < len; i++) {
+      if (sgn(buffer[i] - lastval) != lastdirection) {
+         changes++;
+         lastdirection = sgn(buffer[i] - lastval);
+      }
+      lastval = buffer[i];
+   }
+   return changes;
+}
+
+
 //This tests whether a specified block region is above or below threshold.
 bool VoiceKey::AboveThreshold(
    const WaveTrack & t, sampleCount start, sampleCount len)
@@ -668,11 +790,64 @@ bool VoiceKey::AboveThreshold(
    int tests =0;   //Keeps track of how many statistics surpass the threshold.
    int testThreshold=0;  //Keeps track of the threshold.
 
-   //Calculate the test statistics
+   const bool useSignChanges = mUseSignChangesLow || mUseSignChangesHigh;
+   const bool useDirectionChanges =
+      mUseDirectionChangesLow || mUseDirectionChangesHigh;
+
+   //Fetch the window into a resident buffer a block at a time and compute
+   //all of the enabled statistics from it, rather than letting each of the
+   //TestXX() functions fetch the same samples from the track again.
+   {
+      auto s = start;
+      auto remaining = len;
+      const auto blockSize = limitSampleBufferSize(
+         t.GetMaxBlockSize(), len);
+      Floats buffer{ blockSize };
+
+      //Initial values as in TestEnergy() et al.
+      double sumerg = 1;
+      unsigned long signchanges = 1;
+      unsigned long directionchanges = 1;
+      int currentsign = 0;
+      int lastdirection = 1;
+      float lastval = float(0);
+      bool first = true;
+
+      while (remaining > 0)
+         {
+            auto block = limitSampleBufferSize(
+               t.GetBestBlockSize(s), remaining);
+            t.Get((samplePtr)buffer.get(), floatSample, s, block);
+
+            if (first)
+               {
+                  currentsign = sgn(buffer[0]);
+                  lastval = buffer[0];
+                  first = false;
+               }
+
+            if (mUseEnergy)
+               sumerg += SumOfSquares(buffer.get(), block);
+            if (useSignChanges)
+               signchanges += CountSignChanges(
+                  currentsign, buffer.get(), block);
+            if (useDirectionChanges)
+               directionchanges += CountDirectionChanges(
+                  lastdirection, lastval, buffer.get(), block);
+
+            remaining -= block;
+            s += block;
+         }
+
+      erg = sumerg / len.as_double();
+      sc = (double)signchanges / len.as_double();
+      dc = (double)directionchanges / len.as_double();
+   }
+
+   //Now test the statistics against the thresholds
    if(mUseEnergy)
       {
          testThreshold++;
-         erg = TestEnergy(t, start,len);
          tests +=(int)(erg > mThresholdEnergy);
 #if 0
          std::cout << "Energy: " << erg << " " <<mThresholdEnergy << std::endl;
@@ -682,7 +857,6 @@ bool VoiceKey::AboveThreshold(
    if(mUseSignChangesLow)
       {
          testThreshold++;
-         sc  = TestSignChanges(t,start,len);
          tests += (int)(sc < mThresholdSignChangesLower);
 #if 0
          std::cout << "SignChanges: " << sc << " " <<mThresholdSignChangesLower<< " < " << mThresholdSignChangesUpper << std::endl;
@@ -692,7 +866,6 @@ bool VoiceKey::AboveThreshold(
    if(mUseSignChangesHigh)
       {
          testThreshold++;
-         sc  = TestSignChanges(t,start,len);
          tests += (int)(sc > mThresholdSignChangesUpper);
 #if 0
          std::cout << "SignChanges: " << sc << " " <<mThresholdSignChangesLower<< " < " << mThresholdSignChangesUpper << std::endl;
@@ -704,7 +877,6 @@ bool VoiceKey::AboveThreshold(
    if(mUseDirectionChangesLow)
       {
          testThreshold++;
-         dc  = TestDirectionChanges(t,start,len);
          tests += (int)(dc < mThresholdDirectionChangesLower);
 #if 0
          std::cout << "DirectionChanges: " << dc << " " <<mThresholdDirectionChangesLower<< " < " << mThresholdDirectionChangesUpper << std::endl;
@@ -713,7 +885,6 @@ bool VoiceKey::AboveThreshold(
    if(mUseDirectionChangesHigh)
       {
          testThreshold++;
-         dc  = TestDirectionChanges(t,start,len);
          tests += (int)(dc > mThresholdDirectionChangesUpper);
 #if 0
          std::cout << "DirectionChanges: " << dc << " " <<mThresholdDirectionChangesLower<< " < " << mThresholdDirectionChangesUpper << std::endl;
@@ -865,10 +1036,7 @@ double VoiceKey::TestEnergy (
          t.Get((samplePtr)buffer.get(), floatSample, s,block);                      //grab the block;
 
          //Now, go through the block and calculate energy
-         for(decltype(block) i = 0; i< block; i++)
-            {
-               sum += buffer[i]*buffer[i];
-            }
+         sum += SumOfSquares(buffer.get(), block);
 
          len -= block;
          s += block;
@@ -914,16 +1082,8 @@ double VoiceKey::TestSignChanges(
          }
 
       //Now, go through the block and calculate zero crossings
+      signchanges += CountSignChanges(currentsign, buffer.get(), block);
 
-      for(decltype(block) i = 0; i< block; i++)
-         {
-            if( sgn(buffer[i]) != currentsign)
-               {
-                  currentsign = sgn(buffer[i]);
-                  signchanges++;
-               }
-
-         }
       len -= block;
       s += block;
    }
@@ -969,18 +1129,10 @@ double VoiceKey::TestDirectionChanges(
          lastval = buffer[0];
       }
 
-      //Now, go through the block and calculate zero crossings
-
-
-      for(decltype(block) i = 0; i< block; i++){
+      //Now, go through the block and calculate direction changes
+      directionchanges +=
+         CountDirectionChanges(lastdirection, lastval, buffer.get(), block);
 
-         if( sgn(buffer[i]-lastval) != lastdirection) {
-            directionchanges++;
-            lastdirection = sgn(buffer[i] - lastval);
-         }
-         lastval = buffer[i];
-
-      }
       len -= block;
       s += block;
    }
@@ -25,11 +25,17 @@
 
 #include <math.h>
 #include <functional>
+#include <future>
+#include <thread>
 #include <vector>
+#include <wx/ffile.h>
+#include <wx/filefn.h>
 #include <wx/log.h>
 
+#include "DirManager.h"
 #include "Sequence.h"
 #include "Spectrum.h"
+#include "SseMathFuncs.h"
 #include "Prefs.h"
 #include "Envelope.h"
 #include "Resample.h"
@@ -276,21 +282,16 @@ static void ComputeSpectrumUsingRealFFTf
    for( ; i < (hFFT->Points * 2); i++)
       buffer[i] = 0; // zero pad as needed
    RealFFTf(buffer, hFFT);
+   // Gather the powers contiguously, then convert them to decibels in
+   // one vectorized batch
    // Handle the (real-only) DC
-   float power = buffer[0] * buffer[0];
-   if(power <= 0)
-      out[0] = -160.0;
-   else
-      out[0] = 10.0 * log10f(power);
+   out[0] = buffer[0] * buffer[0];
    for(i = 1; i < hFFT->Points; i++) {
       const int index = hFFT->BitReversed[i];
       const float re = buffer[index], im = buffer[index + 1];
-      power = re * re + im * im;
-      if(power <= 0)
-         out[i] = -160.0;
-      else
-         out[i] = 10.0*log10f(power);
+      out[i] = re * re + im * im;
    }
+   PowerToDBValues(out, out, hFFT->Points, -160.0);
 }
 
 WaveClip::WaveClip(const std::shared_ptr<DirManager> &projDirManager,
@@ -302,9 +303,9 @@ WaveClip::WaveClip(const std::shared_ptr<DirManager> &projDirManager,
 
    mEnvelope = std::make_unique<Envelope>(true, 1e-7, 2.0, 1.0);
 
-   mWaveCache = std::make_unique<WaveCache>();
-   mSpecCache = std::make_unique<SpecCache>();
-   mSpecPxCache = std::make_unique<SpecPxCache>(1);
+   // The display caches are created on demand by the drawing routines; a
+   // null pointer means the same as an empty cache, and a session with
+   // thousands of clips does not pay for caches it never draws
 }
 
 WaveClip::WaveClip(const WaveClip& orig,
@@ -322,10 +323,6 @@ WaveClip::WaveClip(const WaveClip& orig,
 
    mEnvelope = std::make_unique<Envelope>(*orig.mEnvelope);
 
-   mWaveCache = std::make_unique<WaveCache>();
-   mSpecCache = std::make_unique<SpecCache>();
-   mSpecPxCache = std::make_unique<SpecPxCache>(1);
-
    if ( copyCutlines )
       for (const auto &clip: orig.mCutLines)
          mCutLines.push_back
@@ -345,10 +342,6 @@ WaveClip::WaveClip(const WaveClip& orig,
    mRate = orig.mRate;
    mColourIndex = orig.mColourIndex;
 
-   mWaveCache = std::make_unique<WaveCache>();
-   mSpecCache = std::make_unique<SpecCache>();
-   mSpecPxCache = std::make_unique<SpecPxCache>(1);
-
    mIsPlaceholder = orig.GetIsPlaceholder();
 
    sampleCount s0, s1;
@@ -473,7 +466,7 @@ bool WaveClip::AfterClip(double t) const
 void WaveClip::ClearWaveCache()
 {
    ODLocker locker(&mWaveCacheMutex);
-   mWaveCache = std::make_unique<WaveCache>();
+   mWaveCache.reset();
 }
 
 ///Adds an invalid region to the wavecache so it redraws that portion only.
@@ -685,44 +678,92 @@ bool WaveClip::GetWaveDisplay(WaveDisplay &display, double t0,
       if (a < p1) {
          sampleFormat seqFormat = mSequence->GetSampleFormat();
          bool didUpdate = false;
+
+         // Hold off the rare reallocation of the append buffer and its
+         // summary arrays (only when the sequence enlarges its block
+         // size) while this loop indexes them.  Concurrent element
+         // writes remain unserialized, as they always were; a torn
+         // float mars one redraw, not memory safety.
+         ODLocker locker{ &mAppendBufferMutex };
+
          for(auto i = a; i < p1; i++) {
             auto left = std::max(sampleCount{ 0 },
                                  where[i] - numSamples);
             auto right = std::min(sampleCount{ mAppendBufferLen },
                                   where[i + 1] - numSamples);
 
-            //wxCriticalSectionLocker locker(mAppendCriticalSection);
-
             if (right > left) {
-               Floats b;
-               float *pb{};
                // left is nonnegative and at most mAppendBufferLen:
                auto sLeft = left.as_size_t();
                // The difference is at most mAppendBufferLen:
                size_t len = ( right - left ).as_size_t();
 
-               if (seqFormat == floatSample)
-                  pb = &((float *)mAppendBuffer.ptr())[sLeft];
-               else {
-                  b.reinit(len);
-                  pb = b.get();
-                  CopySamples(mAppendBuffer.ptr() + sLeft * SAMPLE_SIZE(seqFormat),
-                              seqFormat,
-                              (samplePtr)pb, floatSample, len);
-               }
-
-               float theMax, theMin, sumsq;
-               {
-                  const float val = pb[0];
-                  theMax = theMin = val;
-                  sumsq = val * val;
-               }
-               for(decltype(len) j = 1; j < len; j++) {
-                  const float val = pb[j];
-                  theMax = std::max(theMax, val);
-                  theMin = std::min(theMin, val);
-                  sumsq += val * val;
+               float theMax = 0, theMin = 0, sumsq = 0;
+               bool started = false;
+
+               // Scan raw samples of the append buffer in [begin, end)
+               auto fold = [&](size_t begin, size_t end) {
+                  Floats b;
+                  const float *pb;
+                  const size_t n = end - begin;
+                  if (seqFormat == floatSample)
+                     pb = &((const float *)mAppendBuffer.ptr())[begin];
+                  else {
+                     b.reinit(n);
+                     CopySamples(
+                        mAppendBuffer.ptr() + begin * SAMPLE_SIZE(seqFormat),
+                        seqFormat, (samplePtr)b.get(), floatSample, n);
+                     pb = b.get();
+                  }
+                  size_t j = 0;
+                  if (!started) {
+                     const float val = pb[0];
+                     theMax = theMin = val;
+                     sumsq = val * val;
+                     started = true;
+                     j = 1;
+                  }
+                  for (; j < n; j++) {
+                     const float val = pb[j];
+                     theMax = std::max(theMax, val);
+                     theMin = std::min(theMin, val);
+                     sumsq += val * val;
+                  }
+               };
+
+               // Use the summary Append() maintained for the whole frames
+               // inside the range, and touch raw samples only at the edges
+               const size_t summarized =
+                  std::min(mAppendSummaryLen, mAppendBufferLen);
+               size_t pos = sLeft;
+               const size_t endPos = sLeft + len;
+               const size_t wholeBegin =
+                  ((pos + appendSummaryFrame - 1) / appendSummaryFrame)
+                     * appendSummaryFrame;
+               const size_t wholeEnd =
+                  (std::min(endPos, summarized) / appendSummaryFrame)
+                     * appendSummaryFrame;
+               if (wholeEnd > wholeBegin) {
+                  if (pos < wholeBegin)
+                     fold(pos, wholeBegin);
+                  for (size_t frame = wholeBegin / appendSummaryFrame;
+                       frame < wholeEnd / appendSummaryFrame; ++frame) {
+                     if (!started) {
+                        theMin = mAppendMin[frame];
+                        theMax = mAppendMax[frame];
+                        sumsq = mAppendSumSq[frame];
+                        started = true;
+                     }
+                     else {
+                        theMin = std::min(theMin, mAppendMin[frame]);
+                        theMax = std::max(theMax, mAppendMax[frame]);
+                        sumsq += mAppendSumSq[frame];
+                     }
+                  }
+                  pos = wholeEnd;
                }
+               if (pos < endPos)
+                  fold(pos, endPos);
 
                min[i] = theMin;
                max[i] = theMax;
@@ -741,12 +782,55 @@ bool WaveClip::GetWaveDisplay(WaveDisplay &display, double t0,
       // Done with append buffer, now fetch the rest of the cache miss
       // from the sequence
       if (p1 > p0) {
-         if (!mSequence->GetWaveDisplay(&min[p0],
-                                        &max[p0],
-                                        &rms[p0],
-                                        &bl[p0],
-                                        p1-p0,
-                                        &where[p0]))
+         // Pixel columns are independent and write disjoint ranges of the
+         // arrays, so slice them across the cores, as the spectrogram
+         // cache does.  Keep the slices coarse: columns are cheap compared
+         // with the block reads that feed them, and a block straddling a
+         // slice boundary is read once per slice that touches it.
+         const size_t numColumns = p1 - p0;
+         const unsigned numWorkers =
+            std::min<unsigned>(std::max(1u, std::thread::hardware_concurrency()),
+               1 + (numColumns - 1) / 512);
+         bool result;
+         if (numWorkers > 1) {
+            const size_t perWorker = 1 + (numColumns - 1) / numWorkers;
+            std::vector<std::future<bool>> futures;
+            for (unsigned ww = 1; ww < numWorkers; ++ww) {
+               const size_t from = p0 + ww * perWorker;
+               const size_t to = std::min(from + perWorker, p1);
+               if (from >= to)
+                  break;
+               futures.push_back(std::async(std::launch::async,
+                  [=, &where] {
+                     return mSequence->GetWaveDisplay(&min[from],
+                                                      &max[from],
+                                                      &rms[from],
+                                                      &bl[from],
+                                                      to - from,
+                                                      &where[from]);
+                  } ));
+            }
+            result = mSequence->GetWaveDisplay(&min[p0],
+                                               &max[p0],
+                                               &rms[p0],
+                                               &bl[p0],
+                                               std::min(perWorker, numColumns),
+                                               &where[p0]);
+            for (auto &future : futures)
+               // A later slice reports failure only when it lies wholly
+               // past the end of the sequence, where the serial code
+               // would also have left the columns untouched; that must
+               // not fail the whole request
+               future.get();
+         }
+         else
+            result = mSequence->GetWaveDisplay(&min[p0],
+                                               &max[p0],
+                                               &rms[p0],
+                                               &bl[p0],
+                                               numColumns,
+                                               &where[p0]);
+         if (!result)
          {
             isLoadingOD=false;
             return false;
@@ -1121,23 +1205,66 @@ void SpecCache::Populate
       } tls;
 
       #pragma omp parallel for private(tls)
-#endif
       for (auto xx = lowerBoundX; xx < upperBoundX; ++xx)
       {
-#ifdef _OPENMP
          tls.init(waveTrackCache, scratchSize);
          WaveTrackCache& cache = *tls.cache;
          float* buffer = &tls.scratch[0];
-#else
-         WaveTrackCache& cache = waveTrackCache;
-         float* buffer = &scratch[0];
-#endif
          CalculateOneSpectrum(
             settings, cache, xx, numSamples,
             offset, rate, pixelsPerSecond,
             lowerBoundX, upperBoundX,
             gainFactors, buffer, &freq[0]);
       }
+#else
+      // Without OpenMP, slice the columns across the cores ourselves.
+      // Each column writes a disjoint piece of freq, except under the
+      // reassignment algorithm, which scatters energy into neighboring
+      // columns and so stays serial.
+      const int numColumns = upperBoundX - lowerBoundX;
+      const unsigned numWorkers = reassignment ? 1 :
+         std::min<unsigned>(std::max(1u, std::thread::hardware_concurrency()),
+            numColumns > 0 ? 1 + (numColumns - 1) / 16 : 1);
+      if (numWorkers > 1) {
+         auto calcRange =
+            [&](WaveTrackCache &cache, float *buffer, int from, int to) {
+            for (int xx = from; xx < to; ++xx)
+               CalculateOneSpectrum(
+                  settings, cache, xx, numSamples,
+                  offset, rate, pixelsPerSecond,
+                  lowerBoundX, upperBoundX,
+                  gainFactors, buffer, &freq[0]);
+         };
+         const int perWorker = 1 + (numColumns - 1) / (int)numWorkers;
+         std::vector<std::future<void>> futures;
+         for (unsigned ww = 1; ww < numWorkers; ++ww) {
+            const int from = lowerBoundX + ww * perWorker;
+            const int to =
+               std::min<int>(from + perWorker, upperBoundX);
+            if (from >= to)
+               break;
+            futures.push_back(std::async(std::launch::async,
+               [&calcRange, &waveTrackCache, scratchSize, from, to] {
+                  // A private track cache and scratch per worker
+                  WaveTrackCache cache{ waveTrackCache.GetTrack() };
+                  std::vector<float> buffer(scratchSize);
+                  calcRange(cache, &buffer[0], from, to);
+               } ));
+         }
+         calcRange(waveTrackCache, &scratch[0], lowerBoundX,
+            std::min<int>(lowerBoundX + perWorker, upperBoundX));
+         for (auto &future : futures)
+            future.get();
+      }
+      else for (auto xx = lowerBoundX; xx < upperBoundX; ++xx)
+      {
+         CalculateOneSpectrum(
+            settings, waveTrackCache, xx, numSamples,
+            offset, rate, pixelsPerSecond,
+            lowerBoundX, upperBoundX,
+            gainFactors, &scratch[0], &freq[0]);
+      }
+#endif
 
       if (reassignment) {
          // Need to look beyond the edges of the range to accumulate more
@@ -1195,6 +1322,162 @@ void SpecCache::Populate
    }
 }
 
+namespace {
+
+// Header of a ".spc" spectrogram cache file in the project data
+// directory.  The body is where[] as 64-bit sample counts followed by
+// freq[] as floats, in native byte order -- the file never travels.
+struct SpecCacheFileHeader
+{
+   wxUint32 magic;      // 'A' 'S' 'P' 'C', little endian
+   wxUint32 version;
+   wxInt32  algorithm;
+   wxInt32  windowType;
+   wxUint32 windowSize;
+   wxUint32 zeroPaddingFactor;
+   wxInt32  frequencyGain;
+   wxUint32 reserved;
+   wxUint64 len;        // pixels
+   wxUint64 nBins;
+   wxUint64 whereCount; // len + 1 boundaries
+   double   pps;
+   double   start;
+};
+
+const wxUint32 specCacheMagic = 0x43505341;   // 'A' 'S' 'P' 'C'
+const wxUint32 specCacheVersion = 1;
+
+}
+
+wxString WaveClip::SpectrogramCacheFileName() const
+{
+   const auto &dirManager = mSequence->GetDirManager();
+   const wxString dataDir = dirManager->GetProjectDataDir();
+   if (dataDir.empty())
+      return {};
+
+   // Any edit of the sequence changes the hash and simply orphans the
+   // old cache file
+   return dataDir + wxFILE_SEP_PATH +
+      wxString::Format(wxT("%016llx.spc"),
+         (unsigned long long)mSequence->GetPersistentHash());
+}
+
+bool WaveClip::WriteSpectrogramCache() const
+{
+   if (!mSpecCache || mSpecCache->len == 0 || mSpecCache->freq.empty())
+      return false;
+
+   const wxString fileName = SpectrogramCacheFileName();
+   if (fileName.empty())
+      return false;
+
+   wxFFile file(fileName, wxT("wb"));
+   if (!file.IsOpened())
+      return false;
+
+   SpecCacheFileHeader header{};
+   header.magic = specCacheMagic;
+   header.version = specCacheVersion;
+   header.algorithm = mSpecCache->algorithm;
+   header.windowType = mSpecCache->windowType;
+   header.windowSize = mSpecCache->windowSize;
+   header.zeroPaddingFactor = mSpecCache->zeroPaddingFactor;
+   header.frequencyGain = mSpecCache->frequencyGain;
+   header.len = mSpecCache->len;
+   header.nBins = mSpecCache->freq.size() / mSpecCache->len;
+   header.whereCount = mSpecCache->where.size();
+   header.pps = mSpecCache->pps;
+   header.start = mSpecCache->start;
+
+   bool ok =
+      file.Write(&header, sizeof(header)) == sizeof(header);
+
+   if (ok) {
+      std::vector<wxInt64> where(mSpecCache->where.size());
+      for (size_t i = 0, nn = where.size(); i < nn; i++)
+         where[i] = mSpecCache->where[i].as_long_long();
+      const size_t bytes = where.size() * sizeof(wxInt64);
+      ok = file.Write(where.data(), bytes) == bytes;
+   }
+
+   if (ok) {
+      const size_t bytes = mSpecCache->freq.size() * sizeof(float);
+      ok = file.Write(mSpecCache->freq.data(), bytes) == bytes;
+   }
+
+   file.Close();
+   if (!ok)
+      wxRemoveFile(fileName);
+   return ok;
+}
+
+bool WaveClip::ReadSpectrogramCache(const SpectrogramSettings &settings,
+                                    double pixelsPerSecond) const
+{
+   const wxString fileName = SpectrogramCacheFileName();
+   if (fileName.empty() || !wxFileExists(fileName))
+      return false;
+
+   wxFFile file(fileName, wxT("rb"));
+   if (!file.IsOpened())
+      return false;
+
+   SpecCacheFileHeader header;
+   if (file.Read(&header, sizeof(header)) != sizeof(header) ||
+       header.magic != specCacheMagic ||
+       header.version != specCacheVersion)
+      return false;
+
+   // Accept the file only if it answers the present question; the
+   // pixels-per-second comparison is the same tolerant one as in
+   // SpecCache::Matches
+   const double tstep = 1.0 / pixelsPerSecond;
+   if (header.len == 0 ||
+       header.whereCount != header.len + 1 ||
+       header.algorithm != settings.algorithm ||
+       header.windowType != settings.windowType ||
+       header.windowSize != settings.WindowSize() ||
+       header.zeroPaddingFactor != settings.ZeroPaddingFactor() ||
+       header.frequencyGain != settings.frequencyGain ||
+       header.nBins != settings.NBins() ||
+       fabs(tstep - 1.0 / header.pps) * header.len >= (1.0 / mRate))
+      return false;
+
+   // Guard the allocations below against a corrupt header
+   const wxUint64 whereBytes = header.whereCount * sizeof(wxInt64);
+   const wxUint64 freqBytes = header.len * header.nBins * sizeof(float);
+   if ((wxUint64)file.Length() !=
+       sizeof(header) + whereBytes + freqBytes)
+      return false;
+
+   auto cache = std::make_unique<SpecCache>();
+   cache->len = header.len;
+   cache->algorithm = header.algorithm;
+   cache->pps = header.pps;
+   cache->start = header.start;
+   cache->windowType = header.windowType;
+   cache->windowSize = header.windowSize;
+   cache->zeroPaddingFactor = header.zeroPaddingFactor;
+   cache->frequencyGain = header.frequencyGain;
+
+   std::vector<wxInt64> where(header.whereCount);
+   if (file.Read(where.data(), whereBytes) != whereBytes)
+      return false;
+   cache->where.reserve(where.size());
+   for (auto w : where)
+      cache->where.push_back(sampleCount{ w });
+
+   cache->freq.resize(freqBytes / sizeof(float));
+   if (file.Read(cache->freq.data(), freqBytes) != freqBytes)
+      return false;
+
+   // As fresh as if it had just been computed
+   cache->dirty = mDirty;
+   mSpecCache = std::move(cache);
+   return true;
+}
+
 bool WaveClip::GetSpectrogram(WaveTrackCache &waveTrackCache,
                               const float *& spectrogram,
                               const sampleCount *& where,
@@ -1224,6 +1507,23 @@ bool WaveClip::GetSpectrogram(WaveTrackCache &waveTrackCache,
    if (settings.algorithm == SpectrogramSettings::algReassignment)
       match = false;
 
+   // Before recomputing, see whether a previous session (or an earlier
+   // zoom level) left this clip's spectrogram in the project data
+   // directory; a partial overlap is still copied below instead of
+   // recomputed
+   else if (!match && ReadSpectrogramCache(settings, pixelsPerSecond)) {
+      match = true;
+      if (mSpecCache->start == t0 && mSpecCache->len >= numPixels) {
+         spectrogram = &mSpecCache->freq[0];
+         where = &mSpecCache->where[0];
+         return false;  //hit the persisted cache completely
+      }
+   }
+
+   // The cache is created on demand
+   if (!mSpecCache)
+      mSpecCache = std::make_unique<SpecCache>();
+
    // Free the cache when it won't cause a major stutter.
    // If the window size changed, we know there is nothing to be copied
    // If we zoomed out, or resized, we can give up memory. But not too much -
@@ -1303,6 +1603,11 @@ bool WaveClip::GetSpectrogram(WaveTrackCache &waveTrackCache,
    spectrogram = &mSpecCache->freq[0];
    where = &mSpecCache->where[0];
 
+   // A full recompute just finished; remember it for the next session.
+   // Partial updates (scrolling) leave the file alone.
+   if (!match && settings.algorithm != SpectrogramSettings::algReassignment)
+      WriteSpectrogramCache();
+
    return true;
 }
 
@@ -1404,8 +1709,35 @@ void WaveClip::Append(samplePtr buffer, sampleFormat format,
    auto blockSize = mSequence->GetIdealAppendLen();
    sampleFormat seqFormat = mSequence->GetSampleFormat();
 
-   if (!mAppendBuffer.ptr())
+   // Size the summary arrays for the buffer's whole capacity up front;
+   // UpdateAppendSummary must not resize them, because the drawing
+   // thread indexes them without a lock
+   auto sizeAppendSummary = [this](size_t capacity) {
+      const size_t frames =
+         (capacity + appendSummaryFrame - 1) / appendSummaryFrame;
+      mAppendMin.resize(frames);
+      mAppendMax.resize(frames);
+      mAppendSumSq.resize(frames);
+   };
+
+   if (!mAppendBuffer.ptr()) {
+      mAppendBuffer.Allocate(maxBlockSize, seqFormat);
+      mAppendBufferCapacity = maxBlockSize;
+      sizeAppendSummary(maxBlockSize);
+   }
+   else if (mAppendBufferCapacity < maxBlockSize) {
+      // The sequence enlarged its ideal block size; carry the pending
+      // samples into a bigger buffer.  Hold the drawing thread off the
+      // storage being replaced.
+      ODLocker locker{ &mAppendBufferMutex };
+      const size_t bytes = mAppendBufferLen * SAMPLE_SIZE(seqFormat);
+      std::vector<char> pending( bytes );
+      memcpy(pending.data(), mAppendBuffer.ptr(), bytes);
       mAppendBuffer.Allocate(maxBlockSize, seqFormat);
+      memcpy(mAppendBuffer.ptr(), pending.data(), bytes);
+      mAppendBufferCapacity = maxBlockSize;
+      sizeAppendSummary(maxBlockSize);
+   }
 
    auto cleanup = finally( [&] {
       // use NOFAIL-GUARANTEE
@@ -1425,6 +1757,12 @@ void WaveClip::Append(samplePtr buffer, sampleFormat format,
                  mAppendBuffer.ptr() + blockSize * SAMPLE_SIZE(seqFormat),
                  (mAppendBufferLen - blockSize) * SAMPLE_SIZE(seqFormat));
          mAppendBufferLen -= blockSize;
+         // The buffer contents moved down, so the summary frames no
+         // longer describe them; have UpdateAppendSummary rebuild from
+         // what remains.  Realigning the frames is not worth the
+         // trouble, and this happens only once per ideal block, so the
+         // cost amortizes.
+         mAppendSummaryLen = 0;
          blockSize = mSequence->GetIdealAppendLen();
       }
 
@@ -1446,6 +1784,71 @@ void WaveClip::Append(samplePtr buffer, sampleFormat format,
       buffer += toCopy * SAMPLE_SIZE(format) * stride;
       len -= toCopy;
    }
+
+   // use NOFAIL-GUARANTEE
+   UpdateAppendSummary();
+}
+
+void WaveClip::UpdateAppendSummary()
+// NOFAIL-GUARANTEE
+{
+   // Append() resets mAppendSummaryLen whenever it flushes a prefix of
+   // the buffer into the sequence, so whatever the frames cover is
+   // still in place
+   if (mAppendSummaryLen >= mAppendBufferLen)
+      return;
+
+   // The arrays were sized for the buffer's whole capacity when it was
+   // allocated; do not resize them here, the drawing thread may be
+   // indexing them
+   const sampleFormat seqFormat = mSequence->GetSampleFormat();
+
+   // Fold the newly arrived samples into the frame they extend and any
+   // further frames they begin
+   while (mAppendSummaryLen < mAppendBufferLen) {
+      const size_t frame = mAppendSummaryLen / appendSummaryFrame;
+      const size_t frameBegin = frame * appendSummaryFrame;
+      const size_t end =
+         std::min(mAppendBufferLen, frameBegin + appendSummaryFrame);
+      const size_t len = end - mAppendSummaryLen;
+
+      float converted[appendSummaryFrame];
+      const float *pb;
+      if (seqFormat == floatSample)
+         pb = &((const float *)mAppendBuffer.ptr())[mAppendSummaryLen];
+      else {
+         CopySamples(
+            mAppendBuffer.ptr() + mAppendSummaryLen * SAMPLE_SIZE(seqFormat),
+            seqFormat, (samplePtr)converted, floatSample, len);
+         pb = converted;
+      }
+
+      float theMin, theMax, sumsq;
+      size_t jj = 0;
+      if (mAppendSummaryLen == frameBegin) {
+         const float val = pb[0];
+         theMin = theMax = val;
+         sumsq = val * val;
+         jj = 1;
+      }
+      else {
+         // Continue the partial frame where the last call left off
+         theMin = mAppendMin[frame];
+         theMax = mAppendMax[frame];
+         sumsq = mAppendSumSq[frame];
+      }
+      for (; jj < len; ++jj) {
+         const float val = pb[jj];
+         theMax = std::max(theMax, val);
+         theMin = std::min(theMin, val);
+         sumsq += val * val;
+      }
+
+      mAppendMin[frame] = theMin;
+      mAppendMax[frame] = theMax;
+      mAppendSumSq[frame] = sumsq;
+      mAppendSummaryLen = end;
+   }
 }
 
 void WaveClip::AppendBlockFile( const BlockFileFactory &factory, size_t len)
@@ -1477,6 +1880,7 @@ void WaveClip::Flush()
 
          // Use NOFAIL-GUARANTEE of these steps.
          mAppendBufferLen = 0;
+         mAppendSummaryLen = 0;
          UpdateEnvelopeTrackLen();
          MarkChanged();
       } );
@@ -1485,6 +1889,11 @@ void WaveClip::Flush()
          mAppendBufferLen);
    }
 
+   // A quiescent moment:  rewrite runs of fragmentary blocks, which
+   // accumulate when the sequence outgrows its original block size, as
+   // fewer full blocks.  This is a no-op for unfragmented sequences.
+   mSequence->ConsolidateFragments();
+
    //wxLogDebug(wxT("now sample count %lli"), (long long) mSequence->GetNumSamples());
 }
 
@@ -1494,26 +1903,18 @@ bool WaveClip::HandleXMLTag(const wxChar *tag, const wxChar **attrs)
    {
       double dblValue;
       long longValue;
-      while (*attrs)
+      XMLAttributeCursor cursor{ attrs };
+      while (cursor.Next())
       {
-         const wxChar *attr = *attrs++;
-         const wxChar *value = *attrs++;
-
-         if (!value)
-            break;
-
-         const wxString strValue = value;
-         if (!wxStrcmp(attr, wxT("offset")))
+         if (cursor.Is(wxT("offset")))
          {
-            if (!XMLValueChecker::IsGoodString(strValue) ||
-                  !Internat::CompatibleToDouble(strValue, &dblValue))
+            if (!cursor.ToDouble(dblValue))
                return false;
             SetOffset(dblValue);
          }
-         if (!wxStrcmp(attr, wxT("colorindex")))
+         if (cursor.Is(wxT("colorindex")))
          {
-            if (!XMLValueChecker::IsGoodString(strValue) ||
-                  !strValue.ToLong( &longValue))
+            if (!cursor.ToLong(longValue))
                return false;
             SetColourIndex(longValue);
          }
@@ -1959,9 +2360,9 @@ void WaveClip::Resample(int rate, ProgressDialog *progress)
       // Use NOFAIL-GUARANTEE in these steps
 
       // Invalidate wave display cache
-      mWaveCache = std::make_unique<WaveCache>();
+      mWaveCache.reset();
       // Invalidate the spectrum display cache
-      mSpecCache = std::make_unique<SpecCache>();
+      mSpecCache.reset();
 
       mSequence = std::move(newSequence);
       mRate = rate;
@@ -254,6 +254,9 @@ public:
    void MarkChanged() // NOFAIL-GUARANTEE
       { mDirty++; }
 
+   // Counter that MarkChanged bumps; lets display caches detect edits
+   int GetDirty() const { return mDirty; }
+
    /** Getting high-level data for screen display and clipping
     * calculations and Contrast */
    bool GetWaveDisplay(WaveDisplay &display,
@@ -267,6 +270,14 @@ public:
       double t0, double t1, bool mayThrow = true) const;
    float GetRMS(double t0, double t1, bool mayThrow = true) const;
 
+   // Persistent spectrogram cache in the project data directory, keyed
+   // by the sequence's persistent content hash so that any edit simply
+   // orphans the old file.  GetSpectrogram() reads it before recomputing
+   // and writes it after a full recompute.
+   bool WriteSpectrogramCache() const;
+   bool ReadSpectrogramCache(const SpectrogramSettings &settings,
+                             double pixelsPerSecond) const;
+
    // Set/clear/get rectangle that this WaveClip fills on screen. This is
    // called by TrackArtist while actually drawing the tracks and clips.
    void ClearDisplayRect() const;
@@ -366,6 +377,8 @@ public:
    mutable std::unique_ptr<SpecPxCache> mSpecPxCache;
 
 protected:
+   wxString SpectrogramCacheFileName() const;
+
    mutable wxRect mDisplayRect {};
 
    double mOffset { 0 };
@@ -381,6 +394,25 @@ protected:
    mutable std::unique_ptr<SpecCache> mSpecCache;
    SampleBuffer  mAppendBuffer {};
    size_t        mAppendBufferLen { 0 };
+   // Allocated size of mAppendBuffer; the sequence may enlarge its ideal
+   // block size as it grows, requiring reallocation
+   size_t        mAppendBufferCapacity { 0 };
+
+   // Incremental summary of the append buffer, folded in by Append() as
+   // samples arrive, so that drawing the recording waveform does not
+   // rescan the raw append buffer on every refresh
+   enum : size_t { appendSummaryFrame = 256 };
+   // Sized for the buffer's whole capacity when it is allocated, so
+   // that they never reallocate under the drawing thread's reads
+   std::vector<float> mAppendMin, mAppendMax, mAppendSumSq;
+   // Number of leading append buffer samples covered by the summary
+   size_t        mAppendSummaryLen { 0 };
+   // Guards the rare reallocation of the append buffer and its summary
+   // arrays against the drawing thread's concurrent reads; steady-state
+   // appends never take it
+   ODLock        mAppendBufferMutex {};
+
+   void UpdateAppendSummary();
 
    // Cut Lines are nothing more than ordinary wave clips, with the
    // offset relative to the start of the clip.
@@ -40,6 +40,9 @@ Track classes.
 #include <float.h>
 #include <math.h>
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include "float_cast.h"
 
@@ -1560,26 +1563,21 @@ bool WaveTrack::HandleXMLTag(const wxChar *tag, const wxChar **attrs)
    if (!wxStrcmp(tag, wxT("wavetrack"))) {
       double dblValue;
       long nValue;
-      while(*attrs) {
-         const wxChar *attr = *attrs++;
-         const wxChar *value = *attrs++;
+      XMLAttributeCursor cursor{ attrs };
+      while (cursor.Next()) {
+         const wxChar *attr = cursor.Name();
+         const wxChar *value = cursor.Value();
 
-         if (!value)
-            break;
-
-         const wxString strValue = value;
-         if (!wxStrcmp(attr, wxT("rate")))
+         if (cursor.Is(wxT("rate")))
          {
             // mRate is an int, but "rate" in the project file is a float.
-            if (!XMLValueChecker::IsGoodString(strValue) ||
-                  !Internat::CompatibleToDouble(strValue, &dblValue) ||
+            if (!cursor.ToDouble(dblValue) ||
                   (dblValue < 1.0) || (dblValue > 1000000.0)) // allow a large range to be read
                return false;
             mRate = lrint(dblValue);
          }
-         else if (!wxStrcmp(attr, wxT("offset")) &&
-                  XMLValueChecker::IsGoodString(strValue) &&
-                  Internat::CompatibleToDouble(strValue, &dblValue))
+         else if (cursor.Is(wxT("offset")) &&
+                  cursor.ToDouble(dblValue))
          {
             // Offset is only relevant for legacy project files. The value
             // is cached until the actual WaveClip containing the legacy
@@ -1588,33 +1586,30 @@ bool WaveTrack::HandleXMLTag(const wxChar *tag, const wxChar **attrs)
          }
          else if (this->PlayableTrack::HandleXMLAttribute(attr, value))
          {}
-         else if (this->Track::HandleCommonXMLAttribute(attr, strValue))
+         else if (this->Track::HandleCommonXMLAttribute(attr, value))
             ;
-         else if (!wxStrcmp(attr, wxT("gain")) &&
-                  XMLValueChecker::IsGoodString(strValue) &&
-                  Internat::CompatibleToDouble(strValue, &dblValue))
+         else if (cursor.Is(wxT("gain")) &&
+                  cursor.ToDouble(dblValue))
             mGain = dblValue;
-         else if (!wxStrcmp(attr, wxT("pan")) &&
-                  XMLValueChecker::IsGoodString(strValue) &&
-                  Internat::CompatibleToDouble(strValue, &dblValue) &&
+         else if (cursor.Is(wxT("pan")) &&
+                  cursor.ToDouble(dblValue) &&
                   (dblValue >= -1.0) && (dblValue <= 1.0))
             mPan = dblValue;
-         else if (!wxStrcmp(attr, wxT("channel")))
+         else if (cursor.Is(wxT("channel")))
          {
-            if (!XMLValueChecker::IsGoodInt(strValue) || !strValue.ToLong(&nValue) ||
+            if (!cursor.ToLong(nValue) ||
                   !XMLValueChecker::IsValidChannel(nValue))
                return false;
             mChannel = static_cast<Track::ChannelType>( nValue );
          }
-         else if (!wxStrcmp(attr, wxT("linked")) &&
-                  XMLValueChecker::IsGoodInt(strValue) && strValue.ToLong(&nValue))
+         else if (cursor.Is(wxT("linked")) &&
+                  cursor.ToLong(nValue))
             SetLinked(nValue != 0);
-         else if (!wxStrcmp(attr, wxT("autosaveid")) &&
-                  XMLValueChecker::IsGoodInt(strValue) && strValue.ToLong(&nValue))
+         else if (cursor.Is(wxT("autosaveid")) &&
+                  cursor.ToLong(nValue))
             mAutoSaveIdent = (int) nValue;
-         else if (!wxStrcmp(attr, wxT("colorindex")) &&
-                  XMLValueChecker::IsGoodString(strValue) &&
-                  strValue.ToLong(&nValue))
+         else if (cursor.Is(wxT("colorindex")) &&
+                  cursor.ToLong(nValue))
             // Don't use SetWaveColorIndex as it sets the clips too.
             mWaveColorIndex  = nValue;
       } // while
@@ -1854,6 +1849,29 @@ float WaveTrack::GetRMS(double t0, double t1, bool mayThrow) const
    return length > 0 ? sqrt(sumsq / length.as_double()) : 0.0;
 }
 
+wxUint64 WaveTrack::GetContentHash() const
+{
+   // Same mixing as Sequence::GetContentHash; each clip contributes its
+   // placement and its sequence's (cached) digest
+   wxUint64 hash = wxULL(14695981039346336037);
+   auto mix = [&hash](wxUint64 value) {
+      for (unsigned i = 0; i < 8; i++) {
+         hash ^= (value >> (i * 8)) & 0xff;
+         hash *= wxULL(1099511628211);
+      }
+   };
+
+   for (const auto &clip : mClips) {
+      wxUint64 bits;
+      const double offset = clip->GetOffset();
+      memcpy(&bits, &offset, sizeof(bits));
+      mix(bits);
+      mix(clip->GetSequence()->GetContentHash());
+   }
+
+   return hash;
+}
+
 bool WaveTrack::Get(samplePtr buffer, sampleFormat format,
                     sampleCount start, size_t len, fillFormat fill,
                     bool mayThrow, sampleCount * pNumCopied) const
@@ -1978,6 +1996,45 @@ void WaveTrack::Set(samplePtr buffer, sampleFormat format,
    }
 }
 
+bool WaveTrack::HasTrivialEnvelope() const
+{
+   for (const auto &clip : mClips)
+      if (!clip->GetEnvelope()->IsTrivial())
+         return false;
+   return true;
+}
+
+sampleCount WaveTrack::GetSilentSpan(sampleCount start, sampleCount len) const
+{
+   // Silent until some clip shows otherwise
+   auto result = len;
+
+   for (const auto &clip : mClips)
+   {
+      const auto clipStart = clip->GetStartSample();
+      const auto clipEnd = clip->GetEndSample();
+
+      if (clipEnd <= start)
+         continue;
+
+      if (clipStart > start) {
+         // A gap before this clip is silent, but another clip
+         // might begin sooner
+         result = std::min(result, clipStart - start);
+         continue;
+      }
+
+      // start falls within this clip; silent only as far as its
+      // sequence's silent blocks reach.  Do not look past the clip's end:
+      // the conservative answer is correct, and cheap, because callers
+      // re-query as they advance.
+      return clip->GetSequence()->GetSilentSpan(
+         start - clipStart, std::min(len, clipEnd - start));
+   }
+
+   return result;
+}
+
 void WaveTrack::GetEnvelopeValues(double *buffer, size_t bufferLen,
                                   double t0) const
 {
@@ -2075,23 +2132,36 @@ WaveClip* WaveTrack::GetClipAtSample(sampleCount sample)
 // latter clip is returned.
 WaveClip* WaveTrack::GetClipAtTime(double time)
 {
-   
-   const auto clips = SortedClipArray();
-   auto p = std::find_if(clips.rbegin(), clips.rend(), [&] (WaveClip* const& clip) {
-      return time >= clip->GetStartTime() && time <= clip->GetEndTime(); });
+   // This used to search a SortedClipArray, allocating and sorting all the
+   // clip pointers for every query; with thousands of clips that made each
+   // mouse click noticeably slow.  Scan the clips directly instead for the
+   // same answer:  of the clips whose spans contain the time, the one
+   // starting latest.
+   WaveClip *best = nullptr;
+   for (const auto &clip : mClips)
+      if (time >= clip->GetStartTime() && time <= clip->GetEndTime() &&
+          (!best || clip->GetStartTime() > best->GetStartTime()))
+         best = clip.get();
+   if (!best)
+      return nullptr;
 
    // When two clips are immediately next to each other, the GetEndTime() of the first clip
    // and the GetStartTime() of the second clip may not be exactly equal due to rounding errors.
    // If "time" is the end time of the first of two such clips, and the end time is slightly
    // less than the start time of the second clip, then the first rather than the
    // second clip is found by the above code. So correct this.
-   if (p != clips.rend() && p != clips.rbegin() &&
-      time == (*p)->GetEndTime() &&
-      (*p)->SharesBoundaryWithNextClip(*(p-1))) {
-      p--;
+   if (time == best->GetEndTime()) {
+      // Find the found clip's immediate successor in time order, if any
+      WaveClip *next = nullptr;
+      for (const auto &clip : mClips)
+         if (clip->GetStartTime() > best->GetStartTime() &&
+             (!next || clip->GetStartTime() < next->GetStartTime()))
+            next = clip.get();
+      if (next && best->SharesBoundaryWithNextClip(next))
+         best = next;
    }
 
-   return p != clips.rend() ? *p : nullptr;
+   return best;
 }
 
 Envelope* WaveTrack::GetEnvelopeAtX(int xcoord)
@@ -2289,6 +2359,42 @@ void WaveTrack::SplitAt(double t)
    }
 }
 
+void WaveTrack::MoveClips(const std::vector<std::pair<double, double>> &moves)
+// WEAK-GUARANTEE
+{
+   // Entries apply in order; a later lookup sees the earlier moves
+   for (const auto &move : moves)
+      if (WaveClip *clip = GetClipAtTime(move.first))
+         clip->SetOffset(move.second);
+}
+
+void WaveTrack::TrimClips(const std::vector<std::pair<double, double>> &trims)
+// WEAK-GUARANTEE
+{
+   for (const auto &trim : trims) {
+      const double t0 = trim.first, t1 = trim.second;
+      if (!(t0 < t1))
+         continue;
+      WaveClip *clip = GetClipAtTime((t0 + t1) / 2);
+      if (!clip)
+         continue;
+      // As in Trim, but for just this clip
+      if (t1 < clip->GetEndTime())
+         clip->Clear(t1, clip->GetEndTime());
+      if (t0 > clip->GetStartTime()) {
+         clip->Clear(clip->GetStartTime(), t0);
+         clip->SetOffset(t0);
+      }
+   }
+}
+
+void WaveTrack::SplitClips(const std::vector<double> &times)
+// WEAK-GUARANTEE
+{
+   for (double t : times)
+      SplitAt(t);
+}
+
 void WaveTrack::UpdateLocationsCache() const
 {
    auto clips = SortedClipArray();
@@ -2493,6 +2599,101 @@ void WaveTrack::SetAutoSaveIdent(int ident)
    mAutoSaveIdent = ident;
 }
 
+// Fetches one block ahead of the consumer on a worker thread.  This is safe
+// because WaveTrackCache requires that the track not change during its
+// lifetime, and block files are never rewritten once made; the only mutable
+// shared state is in this structure, guarded by its mutex.
+struct WaveTrackCache::Prefetcher {
+   Prefetcher(const std::shared_ptr<const WaveTrack> &pTrack,
+      size_t bufferSize)
+      : mPTrack{ pTrack }
+   {
+      mBuffer.data = Floats{ bufferSize };
+      mThread = std::thread{ [this]{ Run(); } };
+   }
+
+   ~Prefetcher()
+   {
+      {
+         std::lock_guard<std::mutex> guard{ mMutex };
+         mDone = true;
+      }
+      mCondition.notify_one();
+      mThread.join();
+   }
+
+   // Called by the consumer: if the block starting at start was already
+   // fetched, swap it into dest and report success.
+   bool Take(sampleCount start, Buffer &dest)
+   {
+      std::lock_guard<std::mutex> guard{ mMutex };
+      if (mReady && mBuffer.start == start) {
+         dest.swap(mBuffer);
+         mReady = false;
+         return true;
+      }
+      return false;
+   }
+
+   // Called by the consumer: begin fetching the block starting at start,
+   // if not already fetched or being fetched.
+   void Request(sampleCount start)
+   {
+      {
+         std::lock_guard<std::mutex> guard{ mMutex };
+         if (start == mLastRequest)
+            return;
+         mLastRequest = mRequest = start;
+         mReady = false;
+      }
+      mCondition.notify_one();
+   }
+
+private:
+   void Run()
+   {
+      std::unique_lock<std::mutex> lock{ mMutex };
+      for (;;) {
+         mCondition.wait(lock, [this]{ return mDone || mRequest >= 0; });
+         if (mDone)
+            return;
+         const auto start = mRequest;
+         mRequest = -1;
+         mReady = false;
+         lock.unlock();
+
+         // The consumer will not touch mBuffer until mReady again
+         bool ok = false;
+         if (mPTrack->GetBlockStart(start) == start) {
+            const auto len = mPTrack->GetBestBlockSize(start);
+            // Never throw on this thread; on failure the consumer simply
+            // falls back to a synchronous fetch, which may throw
+            ok = mPTrack->Get(samplePtr(mBuffer.data.get()), floatSample,
+               start, len, fillZero, false);
+            if (ok) {
+               mBuffer.start = start;
+               mBuffer.len = len;
+            }
+         }
+
+         lock.lock();
+         // A newer request may have arrived while reading
+         mReady = ok && mRequest < 0;
+      }
+   }
+
+   const std::shared_ptr<const WaveTrack> mPTrack;
+   Buffer mBuffer;
+   sampleCount mRequest{ -1 };
+   sampleCount mLastRequest{ -1 };
+   bool mReady{ false };
+   bool mDone{ false };
+   std::mutex mMutex;
+   std::condition_variable mCondition;
+   // Last, so the thread starts only when the rest is initialized
+   std::thread mThread;
+};
+
 WaveTrackCache::~WaveTrackCache()
 {
 }
@@ -2500,6 +2701,7 @@ WaveTrackCache::~WaveTrackCache()
 void WaveTrackCache::SetTrack(const std::shared_ptr<const WaveTrack> &pTrack)
 {
    if (mPTrack != pTrack) {
+      mPrefetcher.reset();
       if (pTrack) {
          mBufferSize = pTrack->GetMaxBlockSize();
          if (!mPTrack ||
@@ -2516,6 +2718,12 @@ void WaveTrackCache::SetTrack(const std::shared_ptr<const WaveTrack> &pTrack)
    }
 }
 
+void WaveTrackCache::StartReadahead()
+{
+   if (mPTrack && !mPrefetcher)
+      mPrefetcher = std::make_unique<Prefetcher>(mPTrack, mBufferSize);
+}
+
 constSamplePtr WaveTrackCache::Get(sampleFormat format,
    sampleCount start, size_t len, bool mayThrow)
 {
@@ -2593,18 +2801,27 @@ constSamplePtr WaveTrackCache::Get(sampleFormat format,
          if (end > end0) {
             const auto start1 = mPTrack->GetBlockStart(end0);
             if (start1 == end0) {
-               const auto len1 = mPTrack->GetBestBlockSize(start1);
-               wxASSERT(len1 <= mBufferSize);
-               if (!mPTrack->Get(samplePtr(mBuffers[1].data.get()), floatSample, start1, len1, fillZero, mayThrow))
-                  return 0;
-               mBuffers[1].start = start1;
-               mBuffers[1].len = len1;
-               mNValidBuffers = 2;
+               // Take the block from the readahead thread if it is done
+               if (mPrefetcher && mPrefetcher->Take(start1, mBuffers[1]))
+                  mNValidBuffers = 2;
+               else {
+                  const auto len1 = mPTrack->GetBestBlockSize(start1);
+                  wxASSERT(len1 <= mBufferSize);
+                  if (!mPTrack->Get(samplePtr(mBuffers[1].data.get()), floatSample, start1, len1, fillZero, mayThrow))
+                     return 0;
+                  mBuffers[1].start = start1;
+                  mBuffers[1].len = len1;
+                  mNValidBuffers = 2;
+               }
             }
          }
       }
       wxASSERT(mNValidBuffers < 2 || mBuffers[0].end() == mBuffers[1].start);
 
+      // Overlap the fetch of the next block with the consumption of these
+      if (mPrefetcher && mNValidBuffers == 2)
+         mPrefetcher->Request(mBuffers[1].end());
+
       samplePtr buffer = 0;
       auto remaining = len;
 
@@ -13,6 +13,7 @@
 
 #include "Track.h"
 
+#include <utility>
 #include <vector>
 #include <wx/longlong.h>
 
@@ -194,6 +195,20 @@ private:
    // May assume precondition: t0 <= t1
    void Trim(double t0, double t1) /* not override */;
 
+   // Batched clip operations, for scripted editing that touches many
+   // clips in one command.  Each runs its whole list in one pass over
+   // the clips, without per-operation consistency work; callers capture
+   // undo state once around the batch.
+
+   // Each entry pairs a time inside some clip with that clip's new
+   // start time.  Entries whose time hits no clip are ignored.
+   void MoveClips(const std::vector<std::pair<double, double>> &moves);
+   // Each entry trims the clip containing the midpoint of the interval
+   // down to that interval
+   void TrimClips(const std::vector<std::pair<double, double>> &trims);
+   // Split whatever clip contains each of the given times
+   void SplitClips(const std::vector<double> &times);
+
    // May assume precondition: t0 <= t1
    void HandleClear(double t0, double t1, bool addCutLines, bool split);
 
@@ -246,12 +261,27 @@ private:
    void GetEnvelopeValues(double *buffer, size_t bufferLen,
                          double t0) const;
 
+   // True if every clip's envelope is at unity gain everywhere, so that
+   // GetEnvelopeValues would only fill the buffer with 1.0
+   bool HasTrivialEnvelope() const;
+
+   // How many samples, starting at start and not exceeding len, would
+   // Get() certainly fill with zeroes, because they fall in gaps between
+   // clips or in silent blocks?  Mixing may skip work across the span.
+   sampleCount GetSilentSpan(sampleCount start, sampleCount len) const;
+
    // May assume precondition: t0 <= t1
    std::pair<float, float> GetMinMax(
       double t0, double t1, bool mayThrow = true) const;
    // May assume precondition: t0 <= t1
    float GetRMS(double t0, double t1, bool mayThrow = true) const;
 
+   // Cheap 64-bit digest of the track's audio, combining each clip's
+   // offset with its sequence's content hash (see Sequence.h); caches
+   // use it to detect edits without scanning sample data.  Equal digests
+   // imply equal audio within a session; unequal digests imply nothing.
+   wxUint64 GetContentHash() const;
+
    //
    // MM: We now have more than one sequence and envelope per track, so
    // instead of GetSequence() and GetEnvelope() we have the following
@@ -619,6 +649,12 @@ public:
    constSamplePtr Get(
       sampleFormat format, sampleCount start, size_t len, bool mayThrow);
 
+   // Start fetching blocks ahead of Get() on a worker thread.  Worthwhile
+   // only for consumers that sweep the track forward, such as mixing,
+   // effects, and export; Get() still answers other access patterns
+   // correctly, just without the readahead.
+   void StartReadahead();
+
 private:
    void Free();
 
@@ -639,11 +675,15 @@ private:
       }
    };
 
+   // Fetches blocks on a worker thread; defined in WaveTrack.cpp
+   struct Prefetcher;
+
    std::shared_ptr<const WaveTrack> mPTrack;
    size_t mBufferSize;
    Buffer mBuffers[2];
    GrowableSampleBuffer mOverlapBuffer;
    int mNValidBuffers;
+   std::unique_ptr<Prefetcher> mPrefetcher;
 };
 
 #endif // __AUDACITY_WAVETRACK__
@@ -64,6 +64,15 @@ wxInt64 ZoomInfo::TimeToPosition(double projectTime,
    return t;
 }
 
+/// Tabulates PositionToTime for a run of consecutive pixel positions,
+/// beginning with position zero.  Each entry agrees exactly with what
+/// PositionToTime returns for the same position.
+void ZoomInfo::FindColumnTimes(double *times, wxInt64 len, wxInt64 origin) const
+{
+   for (wxInt64 ii = 0; ii < len; ++ii)
+      times[ii] = h + (ii - origin) / zoom;
+}
+
 // This always ignores the fisheye.  Use with caution!
 // You should prefer to call TimeToPosition twice, for endpoints, and take the difference!
 double ZoomInfo::TimeRangeToPixelWidth(double timeRange) const
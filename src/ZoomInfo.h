@@ -83,6 +83,12 @@ public:
       , bool ignoreFisheye = false
    ) const;
 
+   // Fill the first len entries of times with the times at successive pixel
+   // positions origin, origin + 1, ... as PositionToTime would compute them.
+   // Drawing loops that need a conversion per pixel column should fill a
+   // table once with this and then index it, rather than convert per column.
+   void FindColumnTimes(double *times, wxInt64 len, wxInt64 origin = 0) const;
+
    // This always ignores the fisheye.  Use with caution!
    // You should prefer to call TimeToPosition twice, for endpoints, and take the difference!
    double TimeRangeToPixelWidth(double timeRange) const;
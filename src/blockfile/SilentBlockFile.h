@@ -36,6 +36,8 @@ class SilentBlockFile final : public BlockFile {
    size_t ReadData(samplePtr data, sampleFormat format,
                         size_t start, size_t len, bool mayThrow) const override;
 
+   bool IsSilent() const override { return true; }
+
    /// Create a NEW block file identical to this one
    BlockFilePtr Copy(wxFileNameWrapper &&newFileName) override;
    /// Write an XML representation of this file
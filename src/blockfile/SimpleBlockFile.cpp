@@ -21,6 +21,14 @@ libsndfile
 A block file that writes the audio data to an .au file and reads
 it back using libsndfile.
 
+When the preference "/FileFormats/CompressBlockFiles" is set, NEW
+int16 blocks are instead written with a private packed encoding
+(delta-coded, bit-packed frames; see AU_SAMPLE_FORMAT_PACKED16) that
+this class decodes itself, since libsndfile does not know the code.
+The packing is lossless and falls back to the raw encoding for any
+block it would not shrink, so a project may freely mix raw and packed
+blocks.
+
 There are two ways to construct a simple block file.  One is to
 supply data and have the constructor write the file.  The other
 is for when the file already exists and we simply want to create
@@ -67,12 +75,120 @@ to get its definition, rather than rolling our own.
 #include <wx/log.h>
 
 #include "../DirManager.h"
+#include "../PerfCounters.h"
 #include "../Prefs.h"
 
 #include "../FileFormats.h"
 
 #include "sndfile.h"
 
+#include <algorithm>
+#include <vector>
+
+#ifndef __WXMSW__
+#define MAPPED_BLOCK_READS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#endif
+
+#ifdef MAPPED_BLOCK_READS
+namespace {
+
+// An LRU of read-only memory mappings of block files.  A read served
+// from a mapping goes straight to page-cache memory, avoiding the
+// open/seek/read/copy sequence that otherwise happens every time a
+// block is touched for waveform drawing or export.
+class MappedFileCache {
+ public:
+   struct Mapping {
+      Mapping(const char *address_, size_t length_)
+         : address{ address_ }, length{ length_ } {}
+      Mapping(const Mapping&) = delete;
+      Mapping &operator=(const Mapping&) = delete;
+      ~Mapping()
+      {
+         if (address)
+            munmap(const_cast<char*>(address), length);
+      }
+      const char *address;
+      size_t length;
+   };
+   using MappingPtr = std::shared_ptr<const Mapping>;
+
+   static MappedFileCache &Get()
+   {
+      static MappedFileCache cache;
+      return cache;
+   }
+
+   // Map the whole file read-only, or find it already mapped.  The
+   // returned pointer keeps the mapping alive even if it is evicted
+   // concurrently.  Returns null on failure.
+   MappingPtr GetMapping(const wxString &path)
+   {
+      std::lock_guard<std::mutex> guard{ mMutex };
+
+      auto iter = mEntries.find(path);
+      if (iter != mEntries.end()) {
+         iter->second.lastUse = ++mUseCounter;
+         return iter->second.mapping;
+      }
+
+      int fd = open(path.mb_str(wxConvFile), O_RDONLY);
+      if (fd < 0)
+         return {};
+      struct stat status;
+      if (fstat(fd, &status) != 0 || status.st_size <= 0) {
+         close(fd);
+         return {};
+      }
+      const size_t length = status.st_size;
+      void *address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+      close(fd);
+      if (address == MAP_FAILED)
+         return {};
+
+      auto mapping = std::make_shared<const Mapping>(
+         static_cast<const char*>(address), length);
+
+      if (mEntries.size() >= MaxMappings) {
+         // Drop the least recently used mapping
+         auto oldest = mEntries.begin();
+         for (auto it = mEntries.begin(); it != mEntries.end(); ++it)
+            if (it->second.lastUse < oldest->second.lastUse)
+               oldest = it;
+         mEntries.erase(oldest);
+      }
+
+      mEntries[path] = { mapping, ++mUseCounter };
+      return mapping;
+   }
+
+   // Forget the mapping for a file that is going away
+   void Evict(const wxString &path)
+   {
+      std::lock_guard<std::mutex> guard{ mMutex };
+      mEntries.erase(path);
+   }
+
+ private:
+   enum : size_t { MaxMappings = 256 };
+   struct Entry {
+      MappingPtr mapping;
+      unsigned long lastUse;
+   };
+   std::map<wxString, Entry> mEntries;
+   unsigned long mUseCounter{ 0 };
+   std::mutex mMutex;
+};
+
+}
+#endif
 
 static wxUint32 SwapUintEndianess(wxUint32 in)
 {
@@ -86,6 +202,113 @@ static wxUint32 SwapUintEndianess(wxUint32 in)
   return out;
 }
 
+namespace {
+
+// Lossless codec for the private AU_SAMPLE_FORMAT_PACKED16 encoding:
+// first-order deltas (wrapping modulo 2^16, so a width of 16 bits
+// always suffices), zigzag-mapped to unsigned, stored in frames of 128
+// values that share one bit width.  The fixed width within a frame
+// keeps the decode loop free of per-sample branches, so compilers can
+// vectorize it; audio deltas are small, so typical frames need only a
+// few bits per sample.
+
+constexpr size_t packFrameSamples = 128;
+
+inline unsigned short ZigZagEncode(int delta)
+{
+   return (unsigned short) (((unsigned) delta << 1) ^ (unsigned) (delta >> 15));
+}
+
+inline int ZigZagDecode(unsigned coded)
+{
+   return (int) (coded >> 1) ^ -(int) (coded & 1);
+}
+
+// Append the packed representation of len samples to out
+void PackInt16(const short *in, size_t len, std::vector<char> &out)
+{
+   out.clear();
+   out.reserve(len); // hope for at least 2:1
+   short prev = 0;
+   for (size_t frame = 0; frame < len; frame += packFrameSamples) {
+      const size_t count = std::min(packFrameSamples, len - frame);
+      unsigned short coded[packFrameSamples];
+      unsigned accum = 0;
+      for (size_t i = 0; i < count; i++) {
+         const short sample = in[frame + i];
+         // Wrapping difference; two's complement cast keeps it in range
+         coded[i] = ZigZagEncode((short) ((int) sample - (int) prev));
+         accum |= coded[i];
+         prev = sample;
+      }
+      unsigned width = 0;
+      while (accum >> width)
+         width++;
+      out.push_back((char) width);
+      unsigned long long bits = 0;
+      unsigned nBits = 0;
+      for (size_t i = 0; i < count; i++) {
+         bits |= (unsigned long long) coded[i] << nBits;
+         nBits += width;
+         while (nBits >= 8) {
+            out.push_back((char) (bits & 0xff));
+            bits >>= 8;
+            nBits -= 8;
+         }
+      }
+      if (nBits > 0)
+         out.push_back((char) (bits & 0xff));
+   }
+}
+
+// Decode exactly outLen samples; false if the input is malformed
+bool UnpackInt16(const unsigned char *in, size_t inLen,
+                 short *out, size_t outLen)
+{
+   size_t pos = 0;
+   short prev = 0;
+   for (size_t frame = 0; frame < outLen; frame += packFrameSamples) {
+      const size_t count = std::min(packFrameSamples, outLen - frame);
+      if (pos >= inLen)
+         return false;
+      const unsigned width = in[pos++];
+      if (width > 16)
+         return false;
+      const size_t frameBytes = (count * width + 7) / 8;
+      if (pos + frameBytes > inLen)
+         return false;
+      const unsigned mask = (1u << width) - 1;
+      unsigned long long bits = 0;
+      unsigned nBits = 0;
+      size_t bytePos = pos;
+      for (size_t i = 0; i < count; i++) {
+         while (nBits < width) {
+            bits |= (unsigned long long) in[bytePos++] << nBits;
+            nBits += 8;
+         }
+         const unsigned coded = (unsigned) bits & mask;
+         bits >>= width;
+         nBits -= width;
+         prev = (short) ((int) prev + ZigZagDecode(coded));
+         out[frame + i] = prev;
+      }
+      pos += frameBytes;
+   }
+   return true;
+}
+
+// The write-time side of the negotiation that starts at
+// DirManager::NewSimpleBlockFile: whether NEW int16 blocks should be
+// packed
+bool GetCompressPref()
+{
+   bool compress = false;
+   gPrefs->Read(wxT("/FileFormats/CompressBlockFiles"), &compress);
+   return compress;
+}
+
+}
+
 /// Constructs a SimpleBlockFile based on sample data and writes
 /// it to disk.
 ///
@@ -112,7 +335,7 @@ SimpleBlockFile::SimpleBlockFile(wxFileNameWrapper &&baseFileName,
 
    bool useCache = GetCache() && (!bypassCache);
 
-   if (!(allowDeferredWrite && useCache) && !bypassCache)
+   if (!allowDeferredWrite && !bypassCache)
    {
       bool bSuccess = WriteSimpleBlockFile(sampleData, sampleLen, format, NULL);
       if (!bSuccess)
@@ -120,7 +343,10 @@ SimpleBlockFile::SimpleBlockFile(wxFileNameWrapper &&baseFileName,
             FileException::Cause::Write, GetFileName().name };
    }
 
-   if (useCache) {
+   // With deferred write the samples are staged in the cache even when
+   // the read-caching preference is off; DirManager's write-behind
+   // thread (see EnqueueBlockWrite) then writes the file
+   if (useCache || allowDeferredWrite) {
       //wxLogDebug("SimpleBlockFile::SimpleBlockFile(): Caching block file data.");
       mCache.active = true;
       mCache.needWrite = true;
@@ -157,6 +383,10 @@ SimpleBlockFile::SimpleBlockFile(wxFileNameWrapper &&existingFile, size_t len,
 
 SimpleBlockFile::~SimpleBlockFile()
 {
+#ifdef MAPPED_BLOCK_READS
+   // The disk file may be deleted after this; release its mapping
+   MappedFileCache::Get().Evict(mFileName.GetFullPath());
+#endif
 }
 
 bool SimpleBlockFile::WriteSimpleBlockFile(
@@ -165,12 +395,22 @@ bool SimpleBlockFile::WriteSimpleBlockFile(
     sampleFormat format,
     void* summaryData)
 {
+   PerfCounters::Scope scope{ PerfCounters::BlockFileIO };
+
    wxFFile file(mFileName.GetFullPath(), wxT("wb"));
    if( !file.IsOpened() ){
       // Can't do anything else.
       return false;
    }
 
+   // Calculate the summary first; it may adopt the half-precision
+   // encoding, which changes mSummaryInfo sizes used for the header
+   ArrayOf<char> cleanup;
+   if (!summaryData)
+      summaryData = /*BlockFile::*/CalcSummary(sampleData, sampleLen, format, cleanup);
+      //mchinen:allowing virtual override of calc summary for ODDecodeBlockFile.
+      // PRL: cleanup fixes a possible memory leak!
+
    auHeader header;
 
    // AU files can be either big or little endian.  Which it is is
@@ -201,6 +441,23 @@ bool SimpleBlockFile::WriteSimpleBlockFile(
          break;
    }
 
+   // Optionally pack int16 blocks; keep the raw encoding when packing
+   // would not shrink the payload (e.g. full-scale noise)
+   std::vector<char> packedData;
+   mPackedBytes = 0;
+   if (format == int16Sample && sampleLen > 0 && GetCompressPref())
+   {
+      PackInt16((const short*)sampleData, sampleLen, packedData);
+      if (packedData.size() < sampleLen * SAMPLE_SIZE(format))
+      {
+         header.encoding = AU_SAMPLE_FORMAT_PACKED16;
+         // For this private encoding dataSize is not optional; readers
+         // need the payload byte count
+         header.dataSize = packedData.size();
+         mPackedBytes = header.dataSize;
+      }
+   }
+
    // TODO: don't fabricate
    header.sampleRate = 44100;
 
@@ -208,12 +465,6 @@ bool SimpleBlockFile::WriteSimpleBlockFile(
    header.channels = 1;
 
    // Write the file
-   ArrayOf<char> cleanup;
-   if (!summaryData)
-      summaryData = /*BlockFile::*/CalcSummary(sampleData, sampleLen, format, cleanup);
-      //mchinen:allowing virtual override of calc summary for ODDecodeBlockFile.
-      // PRL: cleanup fixes a possible memory leak!
-
    size_t nBytesToWrite = sizeof(header);
    size_t nBytesWritten = file.Write(&header, nBytesToWrite);
    if (nBytesWritten != nBytesToWrite)
@@ -230,7 +481,17 @@ bool SimpleBlockFile::WriteSimpleBlockFile(
       return false;
    }
 
-   if( format == int24Sample )
+   if( mPackedBytes > 0 )
+   {
+      nBytesToWrite = packedData.size();
+      nBytesWritten = file.Write(packedData.data(), nBytesToWrite);
+      if (nBytesWritten != nBytesToWrite)
+      {
+         wxLogDebug(wxT("Wrote %lld bytes, expected %lld."), (long long) nBytesWritten, (long long) nBytesToWrite);
+         return false;
+      }
+   }
+   else if( format == int24Sample )
    {
       // we can't write the buffer directly to disk, because 24-bit samples
       // on disk need to be packed, not padded to 32 bits like they are in
@@ -302,6 +563,7 @@ void SimpleBlockFile::FillCache()
    switch (encoding)
    {
    case AU_SAMPLE_FORMAT_16:
+   case AU_SAMPLE_FORMAT_PACKED16: // ReadData below decodes to int16
       mCache.format = int16Sample;
       break;
    case AU_SAMPLE_FORMAT_24:
@@ -343,9 +605,9 @@ void SimpleBlockFile::FillCache()
 /// mSummaryinfo.totalSummaryBytes long.
 bool SimpleBlockFile::ReadSummary(ArrayOf<char> &data)
 {
-   data.reinit( mSummaryInfo.totalSummaryBytes );
    if (mCache.active) {
       //wxLogDebug("SimpleBlockFile::ReadSummary(): Summary is already in cache.");
+      data.reinit( mSummaryInfo.totalSummaryBytes );
       memcpy(data.get(), mCache.summaryData.get(), mSummaryInfo.totalSummaryBytes);
       return true;
    }
@@ -353,6 +615,28 @@ bool SimpleBlockFile::ReadSummary(ArrayOf<char> &data)
    {
       //wxLogDebug("SimpleBlockFile::ReadSummary(): Reading summary from disk.");
 
+#ifdef MAPPED_BLOCK_READS
+      // First paint of a freshly opened project touches every block's
+      // summary; serving these from the shared file mapping makes that a
+      // page-cache copy instead of an open/seek/read per block
+      if (auto map =
+          MappedFileCache::Get().GetMapping(mFileName.GetFullPath())) {
+         if (map->length >= sizeof(auHeader) + summaryTagLen) {
+            // The tag determines the summary format and so its size
+            AdoptSummaryTag(map->address + sizeof(auHeader));
+            if (map->length >=
+                sizeof(auHeader) + mSummaryInfo.totalSummaryBytes) {
+               data.reinit( mSummaryInfo.totalSummaryBytes );
+               memcpy(data.get(), map->address + sizeof(auHeader),
+                  mSummaryInfo.totalSummaryBytes);
+               mSilentLog = FALSE;
+               FixSummary(data.get());
+               return true;
+            }
+         }
+      }
+#endif
+
       wxFFile file(mFileName.GetFullPath(), wxT("rb"));
 
       {
@@ -362,6 +646,7 @@ bool SimpleBlockFile::ReadSummary(ArrayOf<char> &data)
          // FIXME: TRAP_ERR no report to user of absent summary files?
          // filled with zero instead.
          if (!file.IsOpened()){
+            data.reinit( mSummaryInfo.totalSummaryBytes );
             memset(data.get(), 0, mSummaryInfo.totalSummaryBytes);
             mSilentLog = TRUE;
             return false;
@@ -369,10 +654,22 @@ bool SimpleBlockFile::ReadSummary(ArrayOf<char> &data)
       }
       mSilentLog = FALSE;
 
-      // The offset is just past the au header
+      // The summary is just past the au header; its tag determines the
+      // summary format, and with it how many bytes follow
+      char tag[summaryTagLen];
       if( !file.Seek(sizeof(auHeader)) ||
-          file.Read(data.get(), mSummaryInfo.totalSummaryBytes) !=
-             mSummaryInfo.totalSummaryBytes ) {
+          file.Read(tag, summaryTagLen) != (size_t)summaryTagLen ) {
+         data.reinit( mSummaryInfo.totalSummaryBytes );
+         memset(data.get(), 0, mSummaryInfo.totalSummaryBytes);
+         return false;
+      }
+      AdoptSummaryTag(tag);
+
+      data.reinit( mSummaryInfo.totalSummaryBytes );
+      memcpy(data.get(), tag, summaryTagLen);
+
+      const auto remaining = mSummaryInfo.totalSummaryBytes - summaryTagLen;
+      if( file.Read(data.get() + summaryTagLen, remaining) != remaining ) {
          memset(data.get(), 0, mSummaryInfo.totalSummaryBytes);
          return false;
       }
@@ -412,9 +709,120 @@ size_t SimpleBlockFile::ReadData(samplePtr data, sampleFormat format,
 
       return framesRead;
    }
-   else
-      return CommonReadData( mayThrow,
-         mFileName, mSilentLog, nullptr, 0, 0, data, format, start, len);
+
+   // Only reads that go to disk count as block file I/O; cache hits
+   // above are plain memory copies
+   PerfCounters::Scope scope{ PerfCounters::BlockFileIO };
+
+#ifdef MAPPED_BLOCK_READS
+   // Serve the read from a memory mapping of the file when possible.
+   // Fall back to libsndfile for files this build did not write
+   // (foreign endianness) and for packed 24-bit data.
+   if (auto pMapping =
+          MappedFileCache::Get().GetMapping(mFileName.GetFullPath())) {
+      const char *map = pMapping->address;
+      auHeader header;
+      if (pMapping->length >= sizeof(header)) {
+         memcpy(&header, map, sizeof(header));
+         if (header.magic == 0x2e736e64 &&
+             header.encoding == AU_SAMPLE_FORMAT_PACKED16) {
+            const size_t dataOffset = header.dataOffset;
+            const size_t packedLen = header.dataSize;
+            if (dataOffset <= pMapping->length &&
+                packedLen <= pMapping->length - dataOffset) {
+               // Deltas decode sequentially, so reconstruct the whole
+               // block, then copy out the requested range
+               ArrayOf<short> decoded{ mLen };
+               if (UnpackInt16((const unsigned char*)(map + dataOffset),
+                     packedLen, decoded.get(), mLen)) {
+                  auto framesRead =
+                     std::min(len, std::max(start, mLen) - start);
+                  CopySamples((samplePtr)(decoded.get() + start),
+                     int16Sample, data, format, framesRead);
+                  if ( framesRead < len ) {
+                     if (mayThrow)
+                        throw FileException{
+                           FileException::Cause::Read, mFileName };
+                     ClearSamples(data, format, framesRead, len - framesRead);
+                  }
+                  return framesRead;
+               }
+            }
+            // Malformed packed file; the fallback below will report it
+         }
+         else if (header.magic == 0x2e736e64 &&
+             (header.encoding == AU_SAMPLE_FORMAT_16 ||
+              header.encoding == AU_SAMPLE_FORMAT_FLOAT)) {
+            const sampleFormat diskFormat =
+               header.encoding == AU_SAMPLE_FORMAT_16
+                  ? int16Sample : floatSample;
+            const size_t sampleSize = SAMPLE_SIZE(diskFormat);
+            const size_t dataOffset = header.dataOffset;
+            if (dataOffset <= pMapping->length) {
+               const size_t availFrames =
+                  (pMapping->length - dataOffset) / sampleSize;
+               const auto framesRead = std::min(len,
+                  std::max(start, availFrames) - start);
+               CopySamples(
+                  (samplePtr)(map + dataOffset + start * sampleSize),
+                  diskFormat, data, format, framesRead);
+               if ( framesRead < len ) {
+                  if (mayThrow)
+                     throw FileException{
+                        FileException::Cause::Read, mFileName };
+                  ClearSamples(data, format, framesRead, len - framesRead);
+               }
+               return framesRead;
+            }
+         }
+      }
+   }
+#endif
+
+   // libsndfile does not know the private packed encoding, so detect
+   // and decode it here before handing other files to CommonReadData
+   {
+      wxFFile file(mFileName.GetFullPath(), wxT("rb"));
+      auHeader header;
+      if (file.IsOpened() &&
+          file.Read(&header, sizeof(header)) == sizeof(header) &&
+          header.magic == 0x2e736e64 &&
+          header.encoding == AU_SAMPLE_FORMAT_PACKED16)
+      {
+         const size_t packedLen = header.dataSize;
+         ArrayOf<unsigned char> packedData{ packedLen };
+         ArrayOf<short> decoded{ mLen };
+         if (file.Seek(header.dataOffset) &&
+             file.Read(packedData.get(), packedLen) == packedLen &&
+             UnpackInt16(packedData.get(), packedLen, decoded.get(), mLen))
+         {
+            mSilentLog = FALSE;
+            auto framesRead = std::min(len, std::max(start, mLen) - start);
+            CopySamples((samplePtr)(decoded.get() + start),
+               int16Sample, data, format, framesRead);
+            if ( framesRead < len ) {
+               if (mayThrow)
+                  throw FileException{ FileException::Cause::Read, mFileName };
+               ClearSamples(data, format, framesRead, len - framesRead);
+            }
+            return framesRead;
+         }
+
+         // Truncated or corrupt packed file
+         if (!mSilentLog)
+            wxLogError(
+               wxT("Failed to decode packed block file %s."),
+               mFileName.GetFullPath());
+         mSilentLog = TRUE;
+         if (mayThrow)
+            throw FileException{ FileException::Cause::Read, mFileName };
+         ClearSamples(data, format, 0, len);
+         return 0;
+      }
+   }
+
+   return CommonReadData( mayThrow,
+      mFileName, mSilentLog, nullptr, 0, 0, data, format, start, len);
 }
 
 void SimpleBlockFile::SaveXML(XMLWriter &xmlFile)
@@ -498,6 +906,14 @@ auto SimpleBlockFile::GetSpaceUsage() const -> DiskByteCount
       return 0;
    }
 
+   // Packed blocks written this session know their payload size already
+   if (mPackedBytes > 0)
+      return (
+             sizeof(auHeader) +
+             mSummaryInfo.totalSummaryBytes +
+             mPackedBytes
+      );
+
    // Don't know the format, so it must be read from the file
    if (mFormat == (sampleFormat) 0)
    {
@@ -518,12 +934,12 @@ auto SimpleBlockFile::GetSpaceUsage() const -> DiskByteCount
       }
    
       wxUint32 encoding;
-   
+
       if (header.magic == 0x2e736e64)
          encoding = header.encoding; // correct endianness
       else
          encoding = SwapUintEndianess(header.encoding);
-   
+
       switch (encoding)
       {
       case AU_SAMPLE_FORMAT_16:
@@ -532,12 +948,24 @@ auto SimpleBlockFile::GetSpaceUsage() const -> DiskByteCount
       case AU_SAMPLE_FORMAT_24:
          mFormat = int24Sample;
          break;
+      case AU_SAMPLE_FORMAT_PACKED16:
+         mFormat = int16Sample;
+         // The raw-size estimate below would overstate a packed block;
+         // its header records the true payload size
+         mPackedBytes = header.magic == 0x2e736e64
+            ? header.dataSize : SwapUintEndianess(header.dataSize);
+         file.Close();
+         return (
+                sizeof(auHeader) +
+                mSummaryInfo.totalSummaryBytes +
+                mPackedBytes
+         );
       default:
          // floatSample is a safe default (we will never loose data)
          mFormat = floatSample;
          break;
       }
-   
+
       file.Close();
    }
 
@@ -29,6 +29,13 @@ enum {
    AU_SAMPLE_FORMAT_16 = 3,
    AU_SAMPLE_FORMAT_24 = 4,
    AU_SAMPLE_FORMAT_FLOAT = 6,
+
+   // Private encoding code, not part of the .au standard: identifies a
+   // delta-coded, bit-packed int16 payload written when the
+   // /FileFormats/CompressBlockFiles preference is on.  The header's
+   // dataSize field, unused for the standard encodings, holds the
+   // payload byte count.
+   AU_SAMPLE_FORMAT_PACKED16 = 100,
 };
 
 typedef struct {
@@ -93,6 +100,11 @@ class PROFILE_DLL_API SimpleBlockFile /* not final */ : public BlockFile {
 
  private:
    mutable sampleFormat mFormat; // may be found lazily
+
+   // Nonzero when this block was written with the packed encoding;
+   // holds the payload byte count so GetSpaceUsage() need not reopen
+   // the file
+   mutable wxUint32 mPackedBytes { 0 };
 };
 
 #endif
@@ -266,6 +266,45 @@ const std::vector<NormalizedKeyString> &CommandManager::ExcludedList()
    return list;
 }
 
+namespace {
+
+// Customized key bindings from the /NewKeys group of preferences.
+// Looking each command up in preferences individually made NewIdentifier a
+// visible part of the cost of building menus, which happens once for every
+// new project window and again after each change of language or keyboard
+// preferences.  The bindings are the same for all projects, so read the
+// group just once and share the table among all CommandManagers.
+using CustomKeyMap = std::unordered_map< CommandID, NormalizedKeyString >;
+CustomKeyMap sCustomKeys;
+bool sCustomKeysValid = false;
+
+const CustomKeyMap &GetCustomKeys()
+{
+   if (!sCustomKeysValid) {
+      sCustomKeys.clear();
+      gPrefs->SetPath(wxT("/NewKeys"));
+      wxString name;
+      long index;
+      bool cont = gPrefs->GetFirstEntry(name, index);
+      while (cont) {
+         sCustomKeys[ CommandID{ name } ] =
+            NormalizedKeyString{ gPrefs->Read(name, wxString{}) };
+         cont = gPrefs->GetNextEntry(name, index);
+      }
+      gPrefs->SetPath(wxT("/"));
+      sCustomKeysValid = true;
+   }
+   return sCustomKeys;
+}
+
+}
+
+void CommandManager::InvalidateCustomKeys()
+{
+   sCustomKeysValid = false;
+   sCustomKeys.clear();
+}
+
 // CommandManager needs to know which defaults are standard and which are in the
 // full (max) list.
 void CommandManager::SetMaxList()
@@ -770,14 +809,10 @@ CommandListEntry *CommandManager::NewIdentifier(const CommandID & nameIn,
          entry->key = {};
 
       // Key from preferences overrides the default key given
-      gPrefs->SetPath(wxT("/NewKeys"));
-      // using GET to interpret CommandID as a config path component
-      const auto &path = entry->name.GET();
-      if (gPrefs->HasEntry(path)) {
-         entry->key =
-            NormalizedKeyString{ gPrefs->ReadObject(path, entry->key) };
-      }
-      gPrefs->SetPath(wxT("/"));
+      const auto &customKeys = GetCustomKeys();
+      const auto iter = customKeys.find( entry->name );
+      if (iter != customKeys.end())
+         entry->key = iter->second;
 
       mCommandList.push_back(std::move(entry));
       // Don't use the variable entry eny more!
@@ -1001,19 +1036,32 @@ void CommandManager::Modify(const wxString &name, const wxString &newLabel)
    }
 }
 
+void CommandManager::SetKey(CommandListEntry *entry,
+                            const NormalizedKeyString &key)
+{
+   if (!entry->key.empty()) {
+      auto iter = mCommandKeyHash.find(entry->key);
+      if (iter != mCommandKeyHash.end() && iter->second == entry)
+         mCommandKeyHash.erase(iter);
+   }
+   entry->key = key;
+   if (!key.empty())
+      mCommandKeyHash[key] = entry;
+}
+
 void CommandManager::SetKeyFromName(const CommandID &name,
                                     const NormalizedKeyString &key)
 {
    CommandListEntry *entry = mCommandNameHash[name];
    if (entry) {
-      entry->key = key;
+      SetKey(entry, key);
    }
 }
 
 void CommandManager::SetKeyFromIndex(int i, const NormalizedKeyString &key)
 {
    const auto &entry = mCommandList[i];
-   entry->key = key;
+   SetKey(entry.get(), key);
 }
 
 wxString CommandManager::DescribeCommandsAndShortcuts
@@ -1108,8 +1156,6 @@ bool CommandManager::FilterKeyEvent(AudacityProject *project, const wxKeyEvent &
       return false;
    }
 
-   auto flags = MenuManager::Get(*project).GetUpdateFlags();
-
    wxKeyEvent temp = evt;
 
    // Possibly let wxWidgets do its normal key handling IF it is one of
@@ -1156,18 +1202,30 @@ bool CommandManager::FilterKeyEvent(AudacityProject *project, const wxKeyEvent &
       }
    }
 
+   // Evaluate the flags only when a command is really dispatched and really
+   // tests them; some of the registered predicates walk the track list,
+   // which is too much work for every keystroke that the code above hands
+   // back to wxWidgets or that matches a command with no flag requirements.
+   // HandleCommandEntry never examines individual bits of NoFlagsSpecified
+   // when the entry requires none.
+   auto getFlags = [&]{
+      return entry->flags.any()
+         ? MenuManager::Get(*project).GetUpdateFlags()
+         : NoFlagsSpecified;
+   };
+
    if (type == wxEVT_KEY_DOWN)
    {
       if (entry->skipKeydown)
       {
          return true;
       }
-      return HandleCommandEntry(entry, flags, false, &temp);
+      return HandleCommandEntry(entry, getFlags(), false, &temp);
    }
 
    if (type == wxEVT_KEY_UP && entry->wantKeyup)
    {
-      return HandleCommandEntry(entry, flags, false, &temp);
+      return HandleCommandEntry(entry, getFlags(), false, &temp);
    }
 
    return false;
@@ -1240,30 +1298,23 @@ CommandManager::HandleTextualCommand(const CommandID & Str,
 {
    if( Str.empty() )
       return CommandFailure;
-   // Linear search for now...
+   // The name hash covers ordinary and multi items alike
+   if (auto entry = mCommandNameHash[Str])
+   {
+      return HandleCommandEntry( entry, flags, alwaysEnabled)
+         ? CommandSuccess : CommandFailure;
+   }
+   // Testing against labelPrefix too allows us to call Nyquist functions by
+   // name, but there is no hash for that, so fall back to a linear search.
+   // PRL:  uh oh, mixing internal string (Str) with user-visible
+   // (labelPrefix, which was initialized from a user-visible
+   // sub-menu name)
    for (const auto &entry : mCommandList)
    {
-      if (!entry->multi)
-      {
-         // Testing against labelPrefix too allows us to call Nyquist functions by name.
-         if( Str == entry->name ||
-            // PRL:  uh oh, mixing internal string (Str) with user-visible
-            // (labelPrefix, which was initialized from a user-visible
-            // sub-menu name)
-            Str == entry->labelPrefix )
-         {
-            return HandleCommandEntry( entry.get(), flags, alwaysEnabled)
-               ? CommandSuccess : CommandFailure;
-         }
-      }
-      else
+      if (!entry->multi && Str == entry->labelPrefix)
       {
-         // Handle multis too...
-         if( Str == entry->name )
-         {
-            return HandleCommandEntry( entry.get(), flags, alwaysEnabled)
-               ? CommandSuccess : CommandFailure;
-         }
+         return HandleCommandEntry( entry.get(), flags, alwaysEnabled)
+            ? CommandSuccess : CommandFailure;
       }
    }
    return CommandNotFound;
@@ -1460,7 +1511,7 @@ bool CommandManager::HandleXMLTag(const wxChar *tag, const wxChar **attrs)
       }
 
       if (mCommandNameHash[name]) {
-         mCommandNameHash[name]->key = key;
+         SetKey(mCommandNameHash[name], key);
          mXMLKeysRead++;
       }
    }
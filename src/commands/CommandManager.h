@@ -308,6 +308,11 @@ class AUDACITY_DLL_API CommandManager final
    // Sorted list of the shortcut keys to be exluded from the standard defaults
    static const std::vector<NormalizedKeyString> &ExcludedList();
 
+   // Discard the cached copy of the customized key bindings from
+   // preferences, shared by all projects, so that the next rebuild of
+   // menus rereads them
+   static void InvalidateCustomKeys();
+
 private:
 
    //
@@ -347,6 +352,10 @@ private:
                          CommandFunctorPointer callback,
                          const wxChar *accel);
 
+   // Change one binding and keep mCommandKeyHash consistent with it, so the
+   // keystroke dispatch in FilterKeyEvent stays a single hash lookup
+   void SetKey(CommandListEntry *entry, const NormalizedKeyString &key);
+
    //
    // Executing commands
    //
@@ -26,8 +26,17 @@ threshold of difference in two selected tracks
 
 
 #include <float.h>
+#include <cstring>
 #include <wx/intl.h>
 
+// The hot loop counts above-threshold differences four samples at a time
+// where SSE2 is available.
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COMPAREAUDIO_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
 #include "../Shuttle.h"
 #include "../ShuttleGui.h"
 #include "../widgets/AudacityMessageBox.h"
@@ -115,6 +124,18 @@ bool CompareAudioCommand::Apply(const CommandContext & context)
    context.Status(msg);
 
    long errorCount = 0;
+
+   // Duplicated tracks share their immutable block files, and then the
+   // content hashes match; that proves the audio equal without reading
+   // a single sample.  (Unequal hashes prove nothing, so fall through.)
+   if (mTrack0->GetContentHash() == mTrack1->GetContentHash())
+   {
+      context.Status(wxString::Format(wxT("%li"), errorCount));
+      context.Status(wxString::Format(wxT("%.4f"), 0.0));
+      context.Status(wxString::Format(wxT("Finished comparison: %li samples (%.3f seconds) exceeded the error threshold of %f."), errorCount, 0.0, errorThreshold));
+      return true;
+   }
+
    // Initialize buffers for track data to be analyzed
    auto buffSize = std::min(mTrack0->GetMaxBlockSize(), mTrack1->GetMaxBlockSize());
 
@@ -135,11 +156,40 @@ bool CompareAudioCommand::Apply(const CommandContext & context)
       mTrack0->Get((samplePtr)buff0.get(), floatSample, position, block);
       mTrack1->Get((samplePtr)buff1.get(), floatSample, position, block);
 
-      for (decltype(block) buffPos = 0; buffPos < block; ++buffPos)
+      // In regression testing the tracks are usually bit-identical, and a
+      // library memcmp is far faster than comparing sample by sample.
+      // (Block summaries cannot prove equality, only bound differences, so
+      // they are no use for this skip.)
+      if (memcmp(buff0.get(), buff1.get(), block * sizeof(float)) != 0)
       {
-         if (CompareSample(buff0[buffPos], buff1[buffPos]) > errorThreshold)
+         decltype(block) buffPos = 0;
+#ifdef COMPAREAUDIO_USE_SSE2
+         // Four samples per step, with the differences taken in double
+         // precision so the counts agree exactly with CompareSample below
+         const __m128d signMask = _mm_set1_pd(-0.0);
+         const __m128d threshold = _mm_set1_pd(errorThreshold);
+         for (; buffPos + 4 <= block; buffPos += 4)
+         {
+            const __m128 v0 = _mm_loadu_ps(&buff0[buffPos]);
+            const __m128 v1 = _mm_loadu_ps(&buff1[buffPos]);
+            const __m128d lo = _mm_andnot_pd(signMask,
+               _mm_sub_pd(_mm_cvtps_pd(v0), _mm_cvtps_pd(v1)));
+            const __m128d hi = _mm_andnot_pd(signMask,
+               _mm_sub_pd(_mm_cvtps_pd(_mm_movehl_ps(v0, v0)),
+                          _mm_cvtps_pd(_mm_movehl_ps(v1, v1))));
+            int mask = _mm_movemask_pd(_mm_cmpgt_pd(lo, threshold)) |
+               (_mm_movemask_pd(_mm_cmpgt_pd(hi, threshold)) << 2);
+            // Add the population count of the four mask bits
+            mask = (mask & 5) + ((mask >> 1) & 5);
+            errorCount += (mask & 3) + (mask >> 2);
+         }
+#endif
+         for (; buffPos < block; ++buffPos)
          {
-            ++errorCount;
+            if (CompareSample(buff0[buffPos], buff1[buffPos]) > errorThreshold)
+            {
+               ++errorCount;
+            }
          }
       }
 
@@ -0,0 +1,93 @@
+/**********************************************************************
+
+   Audacity - A Digital Audio Editor
+   Copyright 1999-2018 Audacity Team
+   License: wxwidgets
+
+   James Crook
+
+******************************************************************//**
+
+\file EditClipsCommand.cpp
+\brief Definitions for EditClipsCommand
+
+\class EditClipsCommand
+\brief Command that applies many clip edits in one call.
+
+SetClipCommand edits one clip per invocation, so a scripted conform
+pass over thousands of clips pays command dispatch and an undo state
+for every one of them.  This command takes whole lists of moves, trims
+and splits and hands them to the batched WaveTrack operations, so the
+whole pass is one command and one undo state.
+
+*//*******************************************************************/
+
+#include "../Audacity.h"
+#include "EditClipsCommand.h"
+
+#include <wx/tokenzr.h>
+
+#include "../WaveTrack.h"
+#include "../Shuttle.h"
+#include "../ShuttleGui.h"
+
+EditClipsCommand::EditClipsCommand()
+{
+}
+
+// Numbers separated by spaces, commas or semicolons
+static std::vector<double> ParseTimes( const wxString &list )
+{
+   std::vector<double> times;
+   wxStringTokenizer tokenizer( list, wxT(" ,;") );
+   while (tokenizer.HasMoreTokens()) {
+      double value;
+      if (tokenizer.GetNextToken().ToDouble(&value))
+         times.push_back(value);
+   }
+   return times;
+}
+
+static std::vector<std::pair<double, double>> ParsePairs(
+   const wxString &list )
+{
+   const auto times = ParseTimes( list );
+   std::vector<std::pair<double, double>> pairs;
+   for (size_t i = 0; i + 1 < times.size(); i += 2)
+      pairs.push_back({ times[i], times[i + 1] });
+   return pairs;
+}
+
+bool EditClipsCommand::DefineParams( ShuttleParams & S ){
+   S.OptionalN( bHasMoves          ).Define(     mMoves,          wxT("Moves"),      wxT("") );
+   S.OptionalN( bHasTrims          ).Define(     mTrims,          wxT("Trims"),      wxT("") );
+   S.OptionalN( bHasSplits         ).Define(     mSplits,         wxT("Splits"),     wxT("") );
+   return true;
+};
+
+void EditClipsCommand::PopulateOrExchange(ShuttleGui & S)
+{
+   S.AddSpace(0, 5);
+
+   S.StartMultiColumn(3, wxALIGN_CENTER);
+   {
+      S.Optional( bHasMoves       ).TieTextBox(         _("Moves:"),         mMoves );
+      S.Optional( bHasTrims       ).TieTextBox(         _("Trims:"),         mTrims );
+      S.Optional( bHasSplits      ).TieTextBox(         _("Splits:"),        mSplits );
+   }
+   S.EndMultiColumn();
+}
+
+bool EditClipsCommand::ApplyInner( const CommandContext &, Track * t )
+{
+   t->TypeSwitch([&](WaveTrack *waveTrack) {
+      // Split first, so that moves and trims can address the pieces
+      if( bHasSplits )
+         waveTrack->SplitClips( ParseTimes( mSplits ) );
+      if( bHasTrims )
+         waveTrack->TrimClips( ParsePairs( mTrims ) );
+      if( bHasMoves )
+         waveTrack->MoveClips( ParsePairs( mMoves ) );
+   } );
+   return true;
+}
@@ -0,0 +1,51 @@
+/**********************************************************************
+
+   Audacity - A Digital Audio Editor
+   Copyright 1999-2018 Audacity Team
+   License: wxwidgets
+
+   James Crook
+
+******************************************************************//**
+
+\file EditClipsCommand.h
+\brief Declarations of EditClipsCommand and EditClipsCommandType classes
+
+*//*******************************************************************/
+
+#ifndef __EDIT_CLIPS_COMMAND__
+#define __EDIT_CLIPS_COMMAND__
+
+#include "SetTrackInfoCommand.h"
+
+#define EDIT_CLIPS_PLUGIN_SYMBOL ComponentInterfaceSymbol{ XO("Edit Clips") }
+
+class EditClipsCommand : public SetTrackBase
+{
+public:
+   EditClipsCommand();
+   // ComponentInterface overrides
+   ComponentInterfaceSymbol GetSymbol() override {return EDIT_CLIPS_PLUGIN_SYMBOL;};
+   wxString GetDescription() override {return _("Applies batched move, trim and split operations to clips.");};
+   bool DefineParams( ShuttleParams & S ) override;
+   void PopulateOrExchange(ShuttleGui & S) override;
+
+   // AudacityCommand overrides
+   wxString ManualPage() override {return wxT("Extra_Menu:_Scriptables_II#edit_clips");};
+   bool ApplyInner( const CommandContext & context, Track * t ) override;
+
+public:
+   // Lists of numbers, as in "1.0 2.5 3.0 4.5"; Moves and Trims pair
+   // them up, Splits takes them singly
+   wxString mMoves;
+   wxString mTrims;
+   wxString mSplits;
+
+// For tracking optional parameters.
+   bool bHasMoves;
+   bool bHasTrims;
+   bool bHasSplits;
+};
+
+
+#endif /* End of include guard: __EDIT_CLIPS_COMMAND__ */
@@ -41,6 +41,8 @@ This class now lists
 #include "../ShuttleGui.h"
 #include "CommandContext.h"
 
+#include "../AudioIO.h"
+#include "../PerfCounters.h"
 #include "../prefs/PrefsDialog.h"
 #include "../Shuttle.h"
 #include "../PluginManager.h"
@@ -60,6 +62,7 @@ enum {
    kEnvelopes,
    kLabels,
    kBoxes,
+   kPerfCounters,
    nTypes
 };
 
@@ -74,6 +77,7 @@ static const EnumValueSymbol kTypes[nTypes] =
    { XO("Envelopes") },
    { XO("Labels") },
    { XO("Boxes") },
+   { XO("PerfCounters") },
 };
 
 enum {
@@ -154,6 +158,7 @@ bool GetInfoCommand::ApplyInner(const CommandContext &context)
       case kEnvelopes    : return SendEnvelopes( context );
       case kLabels       : return SendLabels( context );
       case kBoxes        : return SendBoxes( context );
+      case kPerfCounters : return SendPerfCounters( context );
       default:
          context.Status( "Command options not recognised" );
    }
@@ -484,6 +489,49 @@ bool GetInfoCommand::SendBoxes(const CommandContext &context)
    return true;
 }
 
+bool GetInfoCommand::SendPerfCounters(const CommandContext &context)
+{
+   context.StartArray();
+   for (const auto &snapshot : PerfCounters::GetSnapshots())
+   {
+      context.StartStruct();
+      context.AddItem( wxString{ snapshot.name }, "id" );
+      context.AddItem( double(snapshot.count), "calls" );
+      context.AddItem( double(snapshot.totalMicros), "total_us" );
+      context.AddItem( double(snapshot.maxMicros), "max_us" );
+      context.EndStruct();
+   }
+   if (auto gAudioIO = AudioIO::Get())
+   {
+      using Telemetry = AudioIoCallback::CallbackTelemetry;
+      auto &telemetry = gAudioIO->mCallbackTelemetry;
+      context.StartStruct();
+      context.AddItem( "audioTelemetry", "id" );
+      context.AddItem(
+         double(telemetry.callbacks.load(std::memory_order_relaxed)),
+         "callbacks" );
+      context.AddItem(
+         double(telemetry.xruns.load(std::memory_order_relaxed)),
+         "xruns" );
+      context.AddItem(
+         double(telemetry.playbackFillMin.load(std::memory_order_relaxed)),
+         "playback_fill_min" );
+      context.AddItem(
+         double(telemetry.captureFillMax.load(std::memory_order_relaxed)),
+         "capture_fill_max" );
+      context.StartField( "duration_hist_us" );
+      context.StartArray();
+      for (unsigned bin = 0; bin < Telemetry::nDurationBins; bin++)
+         context.AddItem( double(
+            telemetry.durationBins[bin].load(std::memory_order_relaxed)) );
+      context.EndArray();
+      context.EndField();
+      context.EndStruct();
+   }
+   context.EndArray();
+   return true;
+}
+
 bool GetInfoCommand::SendTracks(const CommandContext & context)
 {
    auto &tracks = TrackList::Get( context.project );
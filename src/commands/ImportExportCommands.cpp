@@ -10,7 +10,8 @@
 ******************************************************************//**
 
 \file ImportExportCommands.cpp
-\brief Contains definitions for the ImportCommand and ExportCommand classes
+\brief Contains definitions for the ImportCommand, ExportCommand and
+ExportSharedAudioCommand classes
 
 *//*******************************************************************/
 
@@ -19,11 +20,21 @@
 
 #include "../ProjectFileManager.h"
 #include "../ViewInfo.h"
+#include "../WaveTrack.h"
 #include "../export/Export.h"
 #include "../Shuttle.h"
 #include "../ShuttleGui.h"
 #include "CommandContext.h"
 
+#ifdef __WXMSW__
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 bool ImportCommand::DefineParams( ShuttleParams & S ){
    S.Define( mFileName, wxT("Filename"),  "" );
    return true;
@@ -98,3 +109,193 @@ bool ExportCommand::Apply(const CommandContext & context)
    return false;
 }
 
+namespace {
+
+// Layout at the start of the shared region.  The samples follow
+// immediately, as non-interleaved 32 bit float planes, one plane per
+// channel, each numSamples long.
+struct SharedAudioHeader
+{
+   wxUint32 magic;        // 'A' 'U' 'D' 'S', little endian
+   wxUint32 version;      // layout version, currently 1
+   wxUint32 numChannels;
+   wxUint32 reserved;
+   wxUint64 numSamples;   // per channel
+   double sampleRate;     // of the first exported track
+   double startTime;      // project time of the first sample
+};
+
+const wxUint32 sharedAudioMagic = 0x53445541;   // 'A' 'U' 'D' 'S'
+const wxUint32 sharedAudioVersion = 1;
+
+// The one region this instance publishes; replaced on the next call and
+// torn down when the program exits
+struct SharedAudioRegion
+{
+   ~SharedAudioRegion() { Release(); }
+
+   void Release()
+   {
+      if (!mpData)
+         return;
+#ifdef __WXMSW__
+      UnmapViewOfFile(mpData);
+      CloseHandle(mhMapping);
+      mhMapping = NULL;
+#else
+      munmap(mpData, mSize);
+      shm_unlink(mName.ToUTF8());
+#endif
+      mpData = NULL;
+      mSize = 0;
+      mName.clear();
+   }
+
+   // Create (or replace) a region of the given name and size and map it
+   // for writing; companion processes open it by name and map read-only
+   bool Create(const wxString &name, size_t size)
+   {
+      Release();
+#ifdef __WXMSW__
+      mhMapping = CreateFileMapping(INVALID_HANDLE_VALUE, NULL,
+         PAGE_READWRITE,
+         (DWORD)((wxUint64)size >> 32), (DWORD)(size & 0xffffffffu),
+         name.t_str());
+      if (!mhMapping)
+         return false;
+      mpData = MapViewOfFile(mhMapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+      if (!mpData) {
+         CloseHandle(mhMapping);
+         mhMapping = NULL;
+         return false;
+      }
+      mName = name;
+#else
+      // POSIX wants a name of the form "/something"
+      wxString shmName = name.StartsWith(wxT("/")) ? name : wxT("/") + name;
+      shm_unlink(shmName.ToUTF8());
+      int fd = shm_open(shmName.ToUTF8(), O_CREAT | O_RDWR, 0600);
+      if (fd < 0)
+         return false;
+      if (ftruncate(fd, size) != 0) {
+         close(fd);
+         shm_unlink(shmName.ToUTF8());
+         return false;
+      }
+      mpData = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      // the mapping keeps the region alive; the descriptor need not
+      close(fd);
+      if (mpData == MAP_FAILED) {
+         mpData = NULL;
+         shm_unlink(shmName.ToUTF8());
+         return false;
+      }
+      mName = shmName;
+#endif
+      mSize = size;
+      return true;
+   }
+
+   wxString mName;
+   void *mpData{ NULL };
+   size_t mSize{ 0 };
+#ifdef __WXMSW__
+   HANDLE mhMapping{ NULL };
+#endif
+};
+
+SharedAudioRegion sSharedAudio;
+
+}
+
+bool ExportSharedAudioCommand::DefineParams( ShuttleParams & S ){
+   S.Define( mName, wxT("Name"),  "AudacityAudio" );
+   S.Define( mRelease, wxT("Release"), false );
+   return true;
+}
+
+void ExportSharedAudioCommand::PopulateOrExchange(ShuttleGui & S)
+{
+   S.AddSpace(0, 5);
+
+   S.StartMultiColumn(2, wxALIGN_CENTER);
+   {
+      S.TieTextBox(_("Memory Name:"),mName);
+      S.TieCheckBox(_("Release:"),mRelease);
+   }
+   S.EndMultiColumn();
+}
+
+bool ExportSharedAudioCommand::Apply(const CommandContext & context)
+{
+   if (mRelease)
+   {
+      sSharedAudio.Release();
+      context.Status(wxT("Released shared audio region"));
+      return true;
+   }
+
+   auto &selectedRegion = ViewInfo::Get( context.project ).selectedRegion;
+   const double t0 = selectedRegion.t0();
+   const double t1 = selectedRegion.t1();
+   if (t1 <= t0)
+   {
+      context.Error(wxT("There is no audio selected."));
+      return false;
+   }
+
+   auto trackRange =
+      TrackList::Get( context.project ).Selected< const WaveTrack >();
+   unsigned numChannels = 0;
+   size_t numSamples = 0;
+   for (auto track : trackRange)
+   {
+      numChannels++;
+      auto len =
+         track->TimeToLongSamples(t1) - track->TimeToLongSamples(t0);
+      numSamples = std::max(numSamples, len.as_size_t());
+   }
+   if (numChannels == 0)
+   {
+      context.Error(wxT("No wave tracks are selected."));
+      return false;
+   }
+
+   const size_t size = sizeof(SharedAudioHeader) +
+      sizeof(float) * numSamples * numChannels;
+   if (!sSharedAudio.Create(mName, size))
+   {
+      context.Error(
+         wxString::Format(wxT("Could not create shared memory '%s'!"), mName));
+      return false;
+   }
+
+   auto header = (SharedAudioHeader*)sSharedAudio.mpData;
+   header->magic = sharedAudioMagic;
+   header->version = sharedAudioVersion;
+   header->numChannels = numChannels;
+   header->reserved = 0;
+   header->numSamples = numSamples;
+   header->sampleRate = (*trackRange.begin())->GetRate();
+   header->startTime = t0;
+
+   // Fetch straight into the mapping, one plane per track; tracks
+   // shorter than the longest are padded with silence
+   float *plane = (float*)(header + 1);
+   for (auto track : trackRange)
+   {
+      auto start = track->TimeToLongSamples(t0);
+      auto len =
+         (track->TimeToLongSamples(t1) - start).as_size_t();
+      track->Get((samplePtr)plane, floatSample, start, len);
+      for (size_t i = len; i < numSamples; i++)
+         plane[i] = 0;
+      plane += numSamples;
+   }
+
+   context.Status(wxString::Format(
+      wxT("Shared %llu samples x %u channels as '%s'"),
+      (unsigned long long)numSamples, numChannels, sSharedAudio.mName));
+   return true;
+}
+
@@ -16,6 +16,9 @@
 \class ExportCommand
 \brief Command for exporting audio
 
+\class ExportSharedAudioCommand
+\brief Command for exposing selected audio in a shared-memory region
+
 *//*******************************************************************/
 
 #include "Command.h"
@@ -59,3 +62,25 @@ public:
    wxString mFileName;
    int mnChannels;
 };
+
+#define EXPORT_SHARED_AUDIO_PLUGIN_SYMBOL \
+   ComponentInterfaceSymbol{ XO("ExportSharedAudio") }
+
+class ExportSharedAudioCommand : public AudacityCommand
+{
+public:
+   // ComponentInterface overrides
+   ComponentInterfaceSymbol GetSymbol() override
+      {return EXPORT_SHARED_AUDIO_PLUGIN_SYMBOL;};
+   wxString GetDescription() override
+      {return _("Exposes selected audio in a named shared-memory region.");};
+   bool DefineParams( ShuttleParams & S ) override;
+   void PopulateOrExchange(ShuttleGui & S) override;
+   bool Apply(const CommandContext & context) override;
+
+   // AudacityCommand overrides
+   wxString ManualPage() override {return wxT("Extra_Menu:_Scriptables_II#export_shared_audio");};
+public:
+   wxString mName;
+   bool mRelease;
+};
@@ -34,6 +34,7 @@ modelled on BuiltinEffectsModule
 #include "../commands/SetClipCommand.h"
 #include "../commands/SetProjectCommand.h"
 #include "../commands/DragCommand.h"
+#include "../commands/EditClipsCommand.h"
 
 //
 // Define the list of COMMANDs that will be autoregistered and how to instantiate each
@@ -50,6 +51,7 @@ modelled on BuiltinEffectsModule
    COMMAND( SET_TRACK_VISUALS,   SetTrackVisualsCommand, () )  \
    COMMAND( SET_ENVELOPE,        SetEnvelopeCommand, () )      \
    COMMAND( SET_CLIP,            SetClipCommand, () )          \
+   COMMAND( EDIT_CLIPS,          EditClipsCommand, () )        \
    COMMAND( SET_LABEL,           SetLabelCommand, () )         \
    COMMAND( SET_PROJECT,         SetProjectCommand, () )       \
    COMMAND( SELECT,              SelectCommand, () )           \
@@ -62,6 +64,7 @@ modelled on BuiltinEffectsModule
    COMMAND( HELP,                HelpCommand, () )             \
    COMMAND( IMPORT,              ImportCommand, () )           \
    COMMAND( EXPORT,              ExportCommand, () )           \
+   COMMAND( EXPORT_SHARED_AUDIO, ExportSharedAudioCommand, () ) \
    COMMAND( OPEN_PROJECT,        OpenProjectCommand, () )      \
    COMMAND( SAVE_PROJECT,        SaveProjectCommand, () )      \
 
@@ -110,6 +110,7 @@ bool ScreenshotCommand::DefineParams( ShuttleParams & S ){
    S.DefineEnum(                           mWhat,        wxT("CaptureWhat"),  kwindow,kCaptureWhatStrings, nCaptureWhats );
    S.DefineEnum(                           mBack,        wxT("Background"),   kNone, kBackgroundStrings, nBackgrounds );
    S.Define(                               mbBringToTop, wxT("ToTop"), true );
+   S.Define(                               mbOffscreen,  wxT("Offscreen"), false );
    return true;
 };
 
@@ -125,6 +126,7 @@ void ScreenshotCommand::PopulateOrExchange(ShuttleGui & S)
       S.TieChoice(   _("Background:"),
          mBack, LocalizedStrings(kBackgroundStrings, nBackgrounds));
       S.TieCheckBox( _("Bring To Top:"), mbBringToTop);
+      S.TieCheckBox( _("Render Offscreen:"), mbOffscreen);
    }
    S.EndMultiColumn();
 }
@@ -224,8 +226,6 @@ bool ScreenshotCommand::Capture(
                           wxWindow *window, wxRect r,
                           bool bg)
 {
-   int width = r.width;
-   int height = r.height;
    if( r.width == 0 )
       return false;
    if (window ) {
@@ -276,25 +276,72 @@ bool ScreenshotCommand::Capture(
    // Extract the actual image
    wxBitmap part = full.GetSubBitmap(r);
 
+   ::wxBell();
+
+   return SaveImage(context, filename, part, bg);
+}
+
+// Render the track panel into a memory DC at its current size and cut
+// out the requested rectangle.  The display is never touched, so no
+// raising, yielding or screen blitting is needed, and the project
+// window may stay covered by other windows throughout a batch.
+bool ScreenshotCommand::CaptureOffscreen(
+   const CommandContext & context,
+   const wxString &filename,
+   TrackPanel *panel, wxRect r)
+{
+   int width, height;
+   panel->GetClientSize(&width, &height);
+   if (width <= 0 || height <= 0 || r.width == 0)
+      return false;
+
+   // 24 bit for the same reason as in Capture
+   wxBitmap full(width, height, 24);
+   wxMemoryDC dc;
+   dc.SelectObject(full);
+   dc.SetBackground(wxBrush(wxColour(255, 255, 255), wxBRUSHSTYLE_SOLID));
+   dc.Clear();
+   panel->DrawTracks(&dc);
+   dc.SelectObject(wxNullBitmap);
+
+   // The rectangles computed for screen capture are relative to the
+   // panel's parent; make r panel-relative before cutting it out
+   int px = 0, py = 0;
+   panel->ClientToScreen(&px, &py);
+   panel->GetParent()->ScreenToClient(&px, &py);
+   r.Offset(-px, -py);
+   r.Intersect(wxRect(0, 0, width, height));
+   if (r.IsEmpty())
+      return false;
+
+   return SaveImage(context, filename, full.GetSubBitmap(r), true);
+}
+
+// Common tail of the capture paths:  optionally add a background border
+// and write the image out.
+bool ScreenshotCommand::SaveImage(
+   const CommandContext & context,
+   const wxString &filename, wxBitmap part, bool bg)
+{
    // Add a background
    if (bg && mBackground) {
       wxRect b = GetBackgroundRect();
 
-      wxBitmap back(width + b.width, height + b.height);
-      fullDC.SelectObject(back);
+      wxBitmap back(part.GetWidth() + b.width, part.GetHeight() + b.height);
+      wxMemoryDC dc;
+      dc.SelectObject(back);
 
-      fullDC.SetBackground(wxBrush(mBackColor, wxBRUSHSTYLE_SOLID));
-      fullDC.Clear();
+      dc.SetBackground(wxBrush(mBackColor, wxBRUSHSTYLE_SOLID));
+      dc.Clear();
 
-      fullDC.DrawBitmap(part, b.x, b.y);
-      fullDC.SelectObject(wxNullBitmap);
+      dc.DrawBitmap(part, b.x, b.y);
+      dc.SelectObject(wxNullBitmap);
 
       part = back;
    }
 
    // Save the final image
    wxImage image = part.ConvertToImage();
-   ::wxBell();
 
    if (image.SaveFile(filename)) {
       // flush
@@ -833,6 +880,46 @@ bool ScreenshotCommand::Apply(const CommandContext & context)
 
    auto &toolManager = ToolManager::Get( context.project );
 
+   // Offscreen mode renders the track area into a memory DC instead of
+   // raising windows and blitting the screen, so a batch of captures can
+   // run without exclusive use of the display.  Only the track panel
+   // draws itself to an arbitrary DC; captures that include the ruler,
+   // toolbars or whole windows still go through the screen.
+   if (mbOffscreen) {
+      switch (mCaptureMode) {
+      case ktrackpanel:
+      case ktracks:
+         return CaptureOffscreen(context, mFileName, panel, GetTracksRect(panel));
+      case kfirsttrack:
+         return CaptureOffscreen(context, mFileName, panel, GetTrackRect( &context.project, panel, 0 ));
+      case ksecondtrack:
+         return CaptureOffscreen(context, mFileName, panel, GetTrackRect( &context.project, panel, 1 ));
+      case kfirsttwotracks:
+      {  wxRect r = GetTrackRect( &context.project, panel, 0 );
+         r = r.Union( GetTrackRect( &context.project, panel, 1 ));
+         return CaptureOffscreen(context, mFileName, panel, r);
+      }
+      case kfirstthreetracks:
+      {  wxRect r = GetTrackRect( &context.project, panel, 0 );
+         r = r.Union( GetTrackRect( &context.project, panel, 2 ));
+         return CaptureOffscreen(context, mFileName, panel, r);
+      }
+      case kfirstfourtracks:
+      {  wxRect r = GetTrackRect( &context.project, panel, 0 );
+         r = r.Union( GetTrackRect( &context.project, panel, 3 ));
+         return CaptureOffscreen(context, mFileName, panel, r);
+      }
+      case kalltracks:
+      {  wxRect r = GetTrackRect( &context.project, panel, 0 );
+         r = r.Union( GetTrackRect( &context.project, panel, nTracks-1 ));
+         return CaptureOffscreen(context, mFileName, panel, r);
+      }
+      default:
+         // Fall through to the screen capture paths
+         break;
+      }
+   }
+
    switch (mCaptureMode) {
    case kwindow:
       return Capture(context,  WindowFileName( &context.project, w ) , w, GetWindowRect(w));
@@ -93,6 +93,7 @@ private:
    int mBack;
    wxString mPath;
    bool mbBringToTop;
+   bool mbOffscreen;
    bool bHasBackground;
    bool bHasBringToTop;
    friend class ScreenFrame;
@@ -127,8 +128,14 @@ private:
    bool Capture(
       const CommandContext & Context,
       const wxString &basename,
-         wxWindow *window, wxRect rect, 
+         wxWindow *window, wxRect rect,
          bool bg = false);
+   bool CaptureOffscreen(
+      const CommandContext & Context,
+      const wxString &fileName, TrackPanel *panel, wxRect rect);
+   bool SaveImage(
+      const CommandContext & Context,
+      const wxString &fileName, wxBitmap bitmap, bool bg);
    wxRect GetWindowRect(wxTopLevelWindow *w);
    wxRect GetFullWindowRect(wxTopLevelWindow *w);
    wxRect GetScreenRect();
@@ -63,25 +63,23 @@ void ScriptCommandRelay::PostCommand(
    }
 }
 
-/// This is the function which actually obeys one command.  Rather than applying
-/// the command directly, an event containing a reference to the command is sent
-/// to the main (GUI) thread. This is because having more than one thread access
-/// the GUI at a time causes problems with wxwidgets.
-int ExecCommand(wxString *pIn, wxString *pOut)
+/// This obeys one command.  Rather than applying the command directly, an
+/// event containing a reference to the command is sent to the main (GUI)
+/// thread. This is because having more than one thread access the GUI at a
+/// time causes problems with wxwidgets.
+static void ExecOneCommand(const wxString &In, wxString &Out)
 {
    {
-      CommandBuilder builder(*pIn);
+      CommandBuilder builder(In);
       if (builder.WasValid())
       {
          OldStyleCommandPointer cmd = builder.GetCommand();
          ScriptCommandRelay::PostCommand(wxTheApp->GetTopWindow(), cmd);
-
-         *pOut = wxEmptyString;
       }
       else
       {
-         *pOut = wxT("Syntax error!\n");
-         *pOut += builder.GetErrorMessage() + wxT("\n");
+         Out += wxT("Syntax error!\n");
+         Out += builder.GetErrorMessage() + wxT("\n");
       }
    }
 
@@ -91,9 +89,36 @@ int ExecCommand(wxString *pIn, wxString *pOut)
    while (msg != wxT("\n"))
    {
       //wxLogDebug( "Msg: %s", msg );
-      *pOut += msg + wxT("\n");
+      Out += msg + wxT("\n");
       msg = ScriptCommandRelay::ReceiveResponse().GetMessage();
    }
+}
+
+/// This is the function called once per message from the scripting pipe.
+/// A message is usually a single command, but it may also be a batch frame:
+/// several commands joined by the ASCII record separator (0x1E), answered
+/// with one response blob whose sub-responses are delimited the same way.
+/// Batching lets a script pay the pipe round-trip latency once for many
+/// commands, which matters when issuing thousands of small edits.
+int ExecCommand(wxString *pIn, wxString *pOut)
+{
+   static const wxString separator{ wxT('\x1E') };
+
+   *pOut = wxEmptyString;
+   if (pIn->Find(separator) == wxNOT_FOUND)
+      ExecOneCommand(*pIn, *pOut);
+   else {
+      // The commands still run one at a time on the main thread, in order,
+      // so that each sub-response pairs with its command.
+      wxString remainder = *pIn;
+      while (!remainder.empty()) {
+         const auto subCommand = remainder.BeforeFirst(separator[0]);
+         remainder = remainder.AfterFirst(separator[0]);
+         if (!subCommand.empty())
+            ExecOneCommand(subCommand, *pOut);
+         *pOut += separator + wxT("\n");
+      }
+   }
 
    return 0;
 }
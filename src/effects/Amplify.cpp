@@ -178,6 +178,12 @@ bool EffectAmplify::LoadFactoryDefaults()
 
 // Effect implementation
 
+bool EffectAmplify::CanProcessConcurrently() const
+{
+   // ProcessBlock only scales samples by mRatio and keeps no per-call state
+   return true;
+}
+
 bool EffectAmplify::Init()
 {
    mPeak = 0.0;
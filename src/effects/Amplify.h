@@ -52,6 +52,7 @@ public:
 
    // Effect implementation
 
+   bool CanProcessConcurrently() const override;
    bool Init() override;
    void Preview(bool dryOnly) override;
    void PopulateOrExchange(ShuttleGui & S) override;
@@ -19,6 +19,7 @@
 #include "../Audacity.h"
 #include "AutoDuck.h"
 
+#include <algorithm>
 #include <math.h>
 #include <float.h>
 
@@ -33,6 +34,7 @@
 #include "../ShuttleGui.h"
 #include "../widgets/valnum.h"
 
+#include "../SseMathFuncs.h"
 #include "../WaveTrack.h"
 #include "../widgets/AudacityMessageBox.h"
 
@@ -52,7 +54,7 @@ Param( MaximumPause,       double,  wxT("MaximumPause"),     1.0,     0.0,     D
  */
 
 static const size_t kBufSize = 131072u;     // number of samples to process at once
-static const size_t kRMSWindowSize = 100u;  // samples in circular RMS window buffer
+static const double kControlRate = 100.0;   // resolution of the control signal, Hz
 
 /*
  * A auto duck region and an array of auto duck regions
@@ -287,18 +289,20 @@ bool EffectAutoDuck::Process()
 
    double threshold = DB_TO_LINEAR(mThresholdDb);
 
-   // adjust the threshold so we can compare it to the rmsSum value
-   threshold = threshold * threshold * kRMSWindowSize;
+   // adjust the threshold so we can compare it to a mean square
+   threshold = threshold * threshold;
+
+   // The control signal only needs about 100 Hz resolution, so decide
+   // threshold crossings once per cell of this many samples instead of
+   // sliding a window one sample at a time
+   const size_t cellLen = std::max(size_t{ 1 },
+      size_t(mControlTrack->GetRate() / kControlRate + 0.5));
 
-   int rmsPos = 0;
-   float rmsSum = 0;
    // to make the progress bar appear more natural, we first look for all
    // duck regions and apply them all at once afterwards
    std::vector<AutoDuckRegion> regions;
    bool inDuckRegion = false;
    {
-      Floats rmsWindow{ kRMSWindowSize, true };
-
       Floats buf{ kBufSize };
 
       // initialize the following two variables to prevent compiler warning
@@ -313,16 +317,18 @@ bool EffectAutoDuck::Process()
          
          mControlTrack->Get((samplePtr)buf.get(), floatSample, pos, len);
 
-         for (auto i = pos; i < pos + len; i++)
+         for (size_t cellStart = 0; cellStart < len; cellStart += cellLen)
          {
-            rmsSum -= rmsWindow[rmsPos];
-            // i - pos is bounded by len:
-            auto index = ( i - pos ).as_size_t();
-            rmsWindow[rmsPos] = buf[ index ] * buf[ index ];
-            rmsSum += rmsWindow[rmsPos];
-            rmsPos = (rmsPos + 1) % kRMSWindowSize;
+            const size_t n = std::min(cellLen, len - cellStart);
+
+            // A plain sum of squares over the cell, which the compiler
+            // can vectorize, unlike the old one-sample-at-a-time
+            // circular window update
+            float sumSq = 0;
+            for (size_t j = 0; j < n; j++)
+               sumSq += buf[cellStart + j] * buf[cellStart + j];
 
-            bool thresholdExceeded = rmsSum > threshold;
+            bool thresholdExceeded = sumSq > threshold * n;
 
             if (thresholdExceeded)
             {
@@ -335,7 +341,8 @@ bool EffectAutoDuck::Process()
                   // the threshold has been exceeded for the first time, so
                   // let the duck region begin here
                   inDuckRegion = true;
-                  duckRegionStart = mControlTrack->LongSamplesToTime(i);
+                  duckRegionStart =
+                     mControlTrack->LongSamplesToTime(pos + cellStart);
                }
             }
 
@@ -344,13 +351,14 @@ bool EffectAutoDuck::Process()
                // the threshold has not been exceeded and we are in a duck
                // region, but only fade in if the maximum pause has been
                // exceeded
-               curSamplesPause += 1;
+               curSamplesPause += n;
 
                if (curSamplesPause >= minSamplesPause)
                {
                   // do the actual duck fade and reset all values
                   double duckRegionEnd =
-                     mControlTrack->LongSamplesToTime(i - curSamplesPause);
+                     mControlTrack->LongSamplesToTime(
+                        pos + cellStart + n - curSamplesPause);
 
                   regions.push_back(AutoDuckRegion(
                      duckRegionStart - mOuterFadeDownLen,
@@ -537,8 +545,8 @@ bool EffectAutoDuck::ApplyDuckFade(int trackNum, WaveTrack* t,
 
       t->Get((samplePtr)buf.get(), floatSample, pos, len);
 
-      for (auto i = pos; i < pos + len; i++)
-      {
+      // gain of the duck curve, in dB, at sample i
+      auto gainDb = [&](sampleCount i) {
          float gainDown = fadeDownStep * (i - start).as_float();
          float gainUp = fadeUpStep * (end - i).as_float();
 
@@ -549,9 +557,23 @@ bool EffectAutoDuck::ApplyDuckFade(int trackNum, WaveTrack* t,
             gain = gainUp;
          if (gain < mDuckAmountDb)
             gain = mDuckAmountDb;
-
-         // i - pos is bounded by len:
-         buf[ ( i - pos ).as_size_t() ] *= DB_TO_LINEAR(gain);
+         return gain;
+      };
+
+      // The curve is linear in dB; rather than one dB-to-linear
+      // conversion per sample, convert only at sub-block boundaries and
+      // let the shared ramp kernel interpolate linearly between them.
+      // Over a sub-block the difference from the exponential curve is
+      // far below audibility, and in the flat middle of the region the
+      // ramp degenerates to a constant multiply
+      const size_t kSubBlock = 256;
+      for (size_t off = 0; off < len; off += kSubBlock)
+      {
+         const size_t n = std::min(kSubBlock, len - off);
+         const float g0 = DB_TO_LINEAR(gainDb(pos + off));
+         const float g1 = DB_TO_LINEAR(gainDb(pos + off + n));
+         ApplyLinearRamp(buf.get() + off, buf.get() + off, n,
+            g0, (g1 - g0) / (float)n);
       }
 
       t->Set((samplePtr)buf.get(), floatSample, pos, len);
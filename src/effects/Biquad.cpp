@@ -35,8 +35,100 @@ void Biquad::Reset()
 
 void Biquad::Process(int iNumSamples)
 {
+   // Keep the recurrence state in locals so the compiler can hold it in
+   // registers across the loop instead of reloading members every sample
+   const float b0 = fNumerCoeffs[B0];
+   const float b1 = fNumerCoeffs[B1];
+   const float b2 = fNumerCoeffs[B2];
+   const float a1 = fDenomCoeffs[A1];
+   const float a2 = fDenomCoeffs[A2];
+   float prevIn = fPrevIn;
+   float prevPrevIn = fPrevPrevIn;
+   float prevOut = fPrevOut;
+   float prevPrevOut = fPrevPrevOut;
+
    for (int i = 0; i < iNumSamples; i++)
-      *pfOut++ = ProcessOne(*pfIn++);
+   {
+      const float fIn = *pfIn++;
+      const float fOut = fIn * b0 + prevIn * b1 + prevPrevIn * b2 -
+            prevOut * a1 - prevPrevOut * a2;
+      *pfOut++ = fOut;
+      prevPrevIn = prevIn;
+      prevIn = fIn;
+      prevPrevOut = prevOut;
+      prevOut = fOut;
+   }
+
+   fPrevIn = prevIn;
+   fPrevPrevIn = prevPrevIn;
+   fPrevOut = prevOut;
+   fPrevPrevOut = prevPrevOut;
+}
+
+void Biquad::ProcessCascade(Biquad *pStages, int iNumStages,
+      const float *pfInBuf, float *pfOutBuf, int iNumSamples)
+{
+   // More stages than we have room to hoist; run the generic loop.
+   // ScienFilter tops out at MAX_Order 10, i.e. five stages
+   enum { kMaxStages = 8 };
+   if (iNumStages > kMaxStages)
+   {
+      for (int i = 0; i < iNumSamples; i++)
+      {
+         float f = pfInBuf[i];
+         for (int iStage = 0; iStage < iNumStages; iStage++)
+            f = pStages[iStage].ProcessOne(f);
+         pfOutBuf[i] = f;
+      }
+      return;
+   }
+
+   // Hoist the coefficients and recurrence state of every stage into
+   // locals for the whole block, as Process does for one stage; the
+   // fixed-bound arrays let the compiler keep them in registers, and the
+   // Biquad structures are touched only once per block
+   float b0[kMaxStages], b1[kMaxStages], b2[kMaxStages];
+   float a1[kMaxStages], a2[kMaxStages];
+   float x1[kMaxStages], x2[kMaxStages], y1[kMaxStages], y2[kMaxStages];
+   for (int iStage = 0; iStage < iNumStages; iStage++)
+   {
+      Biquad &stage = pStages[iStage];
+      b0[iStage] = stage.fNumerCoeffs[B0];
+      b1[iStage] = stage.fNumerCoeffs[B1];
+      b2[iStage] = stage.fNumerCoeffs[B2];
+      a1[iStage] = stage.fDenomCoeffs[A1];
+      a2[iStage] = stage.fDenomCoeffs[A2];
+      x1[iStage] = stage.fPrevIn;
+      x2[iStage] = stage.fPrevPrevIn;
+      y1[iStage] = stage.fPrevOut;
+      y2[iStage] = stage.fPrevPrevOut;
+   }
+
+   for (int i = 0; i < iNumSamples; i++)
+   {
+      float f = pfInBuf[i];
+      for (int iStage = 0; iStage < iNumStages; iStage++)
+      {
+         const float fIn = f;
+         f = fIn * b0[iStage] + x1[iStage] * b1[iStage] +
+               x2[iStage] * b2[iStage] -
+               y1[iStage] * a1[iStage] - y2[iStage] * a2[iStage];
+         x2[iStage] = x1[iStage];
+         x1[iStage] = fIn;
+         y2[iStage] = y1[iStage];
+         y1[iStage] = f;
+      }
+      pfOutBuf[i] = f;
+   }
+
+   for (int iStage = 0; iStage < iNumStages; iStage++)
+   {
+      Biquad &stage = pStages[iStage];
+      stage.fPrevIn = x1[iStage];
+      stage.fPrevPrevIn = x2[iStage];
+      stage.fPrevOut = y1[iStage];
+      stage.fPrevPrevOut = y2[iStage];
+   }
 }
 
 void ComplexDiv (float fNumerR, float fNumerI, float fDenomR, float fDenomI, float* pfQuotientR, float* pfQuotientI)
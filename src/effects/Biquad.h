@@ -20,6 +20,11 @@ struct Biquad
    void Reset();
    void Process(int iNumSamples);
 
+   /// Run several filters in series over one buffer in a single pass,
+   /// rather than one pass over the buffer per stage
+   static void ProcessCascade(Biquad *pStages, int iNumStages,
+         const float *pfInBuf, float *pfOutBuf, int iNumSamples);
+
    enum
    {
       /// Numerator coefficient indices
@@ -18,6 +18,11 @@
 
 #include <math.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include <wx/choice.h>
 #include <wx/intl.h>
 #include <wx/slider.h>
@@ -492,50 +497,126 @@ bool EffectChangeSpeed::ProcessOne(WaveTrack * track,
    // the length of the selection being processed.
    auto inBufferSize = track->GetMaxBlockSize();
 
-   Floats inBuffer{ inBufferSize };
-
    // mFactor is at most 100-fold so this shouldn't overflow size_t
    auto outBufferSize = size_t( mFactor * inBufferSize + 10 );
-   Floats outBuffer{ outBufferSize };
 
-   // Set up the resampling stuff for this track.
-   Resample resample(true, mFactor, mFactor); // constant rate resampling
+   // Read through a cache whose readahead thread fetches the next
+   // blocks from disk while the current ones are being resampled
+   WaveTrackCache cache(track->SharedPointer<const WaveTrack>());
+   cache.StartReadahead();
+
+   // Resample on a worker thread and append on this one, so the rate
+   // conversion overlaps writing the output block files and their
+   // summaries.  Appending must stay here: it creates block files
+   // through the project's shared DirManager.  Finished chunks cross
+   // over in a small bounded queue.
+   struct Chunk {
+      Floats data;
+      size_t len;
+      sampleCount inPos;   // input position after this chunk, for progress
+   };
+   std::mutex mutex;
+   std::condition_variable cv;
+   std::deque<Chunk> chunks;
+   enum : size_t { maxQueuedChunks = 4 };
+   bool done = false;
+   bool cancelled = false;
+   std::exception_ptr pException;
+
+   std::thread worker( [&]{
+      try {
+         Floats inBuffer{ inBufferSize };
+
+         // Set up the resampling stuff for this track.
+         Resample resample(true, mFactor, mFactor); // constant rate resampling
+
+         //Go through the track one buffer at a time. samplePos counts which
+         //sample the current buffer starts at.
+         auto samplePos = start;
+         while (samplePos < end) {
+            //Get a blockSize of samples (smaller than the size of the buffer)
+            auto blockSize = limitSampleBufferSize(
+               track->GetBestBlockSize(samplePos),
+               end - samplePos
+            );
+
+            //Get the samples from the track and put them in the buffer
+            const auto got =
+               cache.Get(floatSample, samplePos, blockSize, true);
+            if (got)
+               memcpy(inBuffer.get(), got, sizeof(float) * blockSize);
+            else
+               memset(inBuffer.get(), 0, sizeof(float) * blockSize);
+
+            Chunk chunk;
+            chunk.data.reinit(outBufferSize);
+            const auto results = resample.Process(mFactor,
+                                          inBuffer.get(),
+                                          blockSize,
+                                          ((samplePos + blockSize) >= end),
+                                          chunk.data.get(),
+                                          outBufferSize);
+            samplePos += results.first;
+            chunk.len = results.second;
+            chunk.inPos = samplePos;
+
+            {
+               std::unique_lock<std::mutex> lock{ mutex };
+               cv.wait(lock, [&]{
+                  return cancelled || chunks.size() < maxQueuedChunks; });
+               if (cancelled)
+                  return;
+               chunks.push_back(std::move(chunk));
+            }
+            cv.notify_all();
+         }
+      }
+      catch (...) {
+         std::lock_guard<std::mutex> lock{ mutex };
+         pException = std::current_exception();
+      }
+      {
+         std::lock_guard<std::mutex> lock{ mutex };
+         done = true;
+      }
+      cv.notify_all();
+   } );
 
-   //Go through the track one buffer at a time. samplePos counts which
-   //sample the current buffer starts at.
    bool bResult = true;
-   auto samplePos = start;
-   while (samplePos < end) {
-      //Get a blockSize of samples (smaller than the size of the buffer)
-      auto blockSize = limitSampleBufferSize(
-         track->GetBestBlockSize(samplePos),
-         end - samplePos
-      );
-
-      //Get the samples from the track and put them in the buffer
-      track->Get((samplePtr) inBuffer.get(), floatSample, samplePos, blockSize);
-
-      const auto results = resample.Process(mFactor,
-                                    inBuffer.get(),
-                                    blockSize,
-                                    ((samplePos + blockSize) >= end),
-                                    outBuffer.get(),
-                                    outBufferSize);
-      const auto outgen = results.second;
-
-      if (outgen > 0)
-         outputTrack->Append((samplePtr)outBuffer.get(), floatSample,
-                             outgen);
-
-      // Increment samplePos
-      samplePos += results.first;
+   for (;;) {
+      Chunk chunk;
+      {
+         std::unique_lock<std::mutex> lock{ mutex };
+         cv.wait(lock, [&]{ return !chunks.empty() || done; });
+         if (chunks.empty())
+            break;
+         chunk = std::move(chunks.front());
+         chunks.pop_front();
+      }
+      cv.notify_all();
+
+      if (chunk.len > 0)
+         outputTrack->Append((samplePtr)chunk.data.get(), floatSample,
+                             chunk.len);
 
       // Update the Progress meter
-      if (TrackProgress(mCurTrackNum, (samplePos - start).as_double() / len)) {
+      if (TrackProgress(mCurTrackNum,
+            (chunk.inPos - start).as_double() / len)) {
          bResult = false;
+         {
+            std::lock_guard<std::mutex> lock{ mutex };
+            cancelled = true;
+         }
+         cv.notify_all();
          break;
       }
    }
+   worker.join();
+
+   // Read errors on the worker propagate as they did when the read
+   // happened on this thread
+   if (pException)
+      std::rethrow_exception(pException);
 
    // Flush the output WaveTrack (since it's buffered, too)
    outputTrack->Flush();
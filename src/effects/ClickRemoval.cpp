@@ -28,6 +28,7 @@
 #include "ClickRemoval.h"
 
 #include <math.h>
+#include <string.h>
 
 #include <wx/intl.h>
 #include <wx/slider.h>
@@ -41,6 +42,14 @@
 
 #include "../WaveTrack.h"
 
+// Process blocks of samples four at a time where SSE2 is available.
+// SSE2 may be assumed on all x86_64 targets.
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLICKREMOVAL_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
 enum
 {
    ID_Thresh = 10000,
@@ -233,15 +242,13 @@ bool EffectClickRemoval::ProcessOne(int count, WaveTrack * track, sampleCount st
       {
          auto wcopy = std::min( windowSize, block - i );
 
-         for(decltype(wcopy) j = 0; j < wcopy; j++)
-            datawindow[j] = buffer[i+j];
+         memcpy(datawindow.get(), &buffer[i], wcopy * sizeof(float));
          for(auto j = wcopy; j < windowSize; j++)
             datawindow[j] = 0;
 
          mbDidSomething |= RemoveClicks(windowSize, datawindow.get());
 
-         for(decltype(wcopy) j = 0; j < wcopy; j++)
-           buffer[i+j] = datawindow[j];
+         memcpy(&buffer[i], datawindow.get(), wcopy * sizeof(float));
       }
 
       if (mbDidSomething) // RemoveClicks() actually did something.
@@ -269,27 +276,59 @@ bool EffectClickRemoval::RemoveClicks(size_t len, float *buffer)
    float msw;
    int ww;
    int s2 = sep/2;
-   Floats ms_seq{ len };
-   Floats b2{ len };
 
-   for( i=0; i<len; i++)
+   // This runs once per half-overlapped window; reuse the arenas
+   // between calls rather than allocating them every time
+   if (mWorkLen < len) {
+      mWorkLen = len;
+      mMsSeq.reinit(len);
+      mB2.reinit(len);
+   }
+   float *const ms_seq = mMsSeq.get();
+   float *const b2 = mB2.get();
+
+   i = 0;
+#ifdef CLICKREMOVAL_USE_SSE2
+   for (; i + 4 <= len; i += 4) {
+      const __m128 x = _mm_loadu_ps(buffer + i);
+      _mm_storeu_ps(b2 + i, _mm_mul_ps(x, x));
+   }
+#endif
+   for( ; i<len; i++)
       b2[i] = buffer[i]*buffer[i];
 
    /* Shortcut for rms - multiple passes through b2, accumulating
     * as we go.
     */
-   for(i=0;i<len;i++)
-      ms_seq[i]=b2[i];
+   memcpy(ms_seq, b2, len * sizeof(float));
 
    for(i=1; (int)i < sep; i *= 2) {
-      for(j=0;j<len-i; j++)
+      j = 0;
+#ifdef CLICKREMOVAL_USE_SSE2
+      // Each vector load completes before its store, so the overlap of
+      // the read and write ranges when i < 4 still sees the values from
+      // before this pass, as the scalar loop does
+      for (; j + 4 <= len - i; j += 4)
+         _mm_storeu_ps(ms_seq + j,
+            _mm_add_ps(_mm_loadu_ps(ms_seq + j), _mm_loadu_ps(ms_seq + j + i)));
+#endif
+      for( ;j<len-i; j++)
          ms_seq[j] += ms_seq[j+i];
    }
 
    /* Cheat by truncating sep to next-lower power of two... */
    sep = i;
 
-   for( i=0; i<len-sep; i++ ) {
+   i = 0;
+#ifdef CLICKREMOVAL_USE_SSE2
+   {
+      const __m128 sep4 = _mm_set1_ps((float)sep);
+      for (; i + 4 <= len - sep; i += 4)
+         _mm_storeu_ps(ms_seq + i,
+            _mm_div_ps(_mm_loadu_ps(ms_seq + i), sep4));
+   }
+#endif
+   for( ; i<len-sep; i++ ) {
       ms_seq[i] /= sep;
    }
    /* ww runs from about 4 to mClickWidth.  wrc is the reciprocal;
@@ -71,6 +71,9 @@ private:
    Envelope *mEnvelope;
 
    bool mbDidSomething; // This effect usually does nothing on real-world data.
+   // Working arenas for RemoveClicks(), reused across windows
+   Floats mMsSeq, mB2;
+   size_t mWorkLen{ 0 };
    size_t windowSize;
    int mThresholdLevel;
    int mClickWidth;
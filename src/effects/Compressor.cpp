@@ -27,6 +27,7 @@
 #include "../Audacity.h"
 #include "Compressor.h"
 
+#include <algorithm>
 #include <math.h>
 
 #include <wx/brush.h>
@@ -47,6 +48,14 @@
 #include "../WaveTrack.h"
 #include "../AllThemeResources.h"
 
+// Process blocks of samples four at a time where SSE2 is available.
+// SSE2 may be assumed on all x86_64 targets.
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COMPRESSOR_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
 enum
 {
    ID_Threshold = 10000,
@@ -404,7 +413,20 @@ bool EffectCompressor::TwoBufferProcessPass1
       // Initialize the mLastLevel to the peak level in the first buffer
       // This avoids problems with large spike events near the beginning of the track
       mLastLevel = mThreshold;
-      for(size_t i=0; i<len2; i++) {
+      size_t i = 0;
+#ifdef COMPRESSOR_USE_SSE2
+      __m128 peak4 = _mm_setzero_ps();
+      const __m128 signMask = _mm_set1_ps(-0.0f);
+      for (; i + 4 <= len2; i += 4)
+         peak4 = _mm_max_ps(peak4,
+            _mm_andnot_ps(signMask, _mm_loadu_ps(buffer2 + i)));
+      float lanes[4];
+      _mm_storeu_ps(lanes, peak4);
+      for (unsigned ii = 0; ii < 4; ii++)
+         if(mLastLevel < lanes[ii])
+            mLastLevel = lanes[ii];
+#endif
+      for(; i<len2; i++) {
          if(mLastLevel < fabs(buffer2[i]))
             mLastLevel = fabs(buffer2[i]);
       }
@@ -416,9 +438,7 @@ bool EffectCompressor::TwoBufferProcessPass1
    }
 
    if(buffer1 != NULL) {
-      for (size_t i = 0; i < len1; i++) {
-         buffer1[i] = DoCompression(buffer1[i], mFollow1[i]);
-      }
+      CompressBlock(buffer1, mFollow1.get(), len1);
    }
 
 
@@ -437,7 +457,20 @@ bool EffectCompressor::ProcessPass2(float *buffer, size_t len)
 {
    if (mMax != 0)
    {
-      for (size_t i = 0; i < len; i++)
+      size_t i = 0;
+#ifdef COMPRESSOR_USE_SSE2
+      // Divide in double precision, matching the scalar path exactly
+      const __m128d max2 = _mm_set1_pd(mMax);
+      for (; i + 4 <= len; i += 4) {
+         const __m128 x = _mm_loadu_ps(buffer + i);
+         const __m128d lo = _mm_div_pd(_mm_cvtps_pd(x), max2);
+         const __m128d hi =
+            _mm_div_pd(_mm_cvtps_pd(_mm_movehl_ps(x, x)), max2);
+         _mm_storeu_ps(buffer + i,
+            _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi)));
+      }
+#endif
+      for (; i < len; i++)
          buffer[i] /= mMax;
    }
 
@@ -581,22 +614,45 @@ void EffectCompressor::Follow(float *buffer, float *env, size_t len, float *prev
    }
 }
 
-float EffectCompressor::DoCompression(float value, double env)
+void EffectCompressor::CompressBlock(float *buffer, const float *env, size_t len)
 {
-   float out;
-   if(mUsePeak) {
-      // Peak values map 1.0 to 1.0 - 'upward' compression
-      out = value * pow(1.0/env, mCompression);
-   } else {
-      // With RMS-based compression don't change values below mThreshold - 'downward' compression
-      out = value * pow(mThreshold/env, mCompression);
+   // Peak values map 1.0 to 1.0 - 'upward' compression
+   // With RMS-based compression don't change values below mThreshold
+   // - 'downward' compression
+   const double numerator = mUsePeak ? 1.0 : mThreshold;
+
+   // The follower holds the envelope at exactly mThreshold (unity gain
+   // in the RMS case) through quiet passages and scales it by constant
+   // factors elsewhere, so a one-entry cache of the gain removes nearly
+   // all of the per-sample pow() calls
+   double lastEnv = -1.0;
+   double gain = 1.0;
+   for (size_t i = 0; i < len; i++) {
+      if (env[i] != lastEnv) {
+         lastEnv = env[i];
+         gain = pow(numerator / lastEnv, mCompression);
+      }
+      buffer[i] = buffer[i] * gain;
    }
 
    // Retain the maximum value for use in the normalization pass
-   if(mMax < fabs(out))
-      mMax = fabs(out);
-
-   return out;
+   float peak = 0.0;
+   size_t i = 0;
+#ifdef COMPRESSOR_USE_SSE2
+   __m128 peak4 = _mm_setzero_ps();
+   const __m128 signMask = _mm_set1_ps(-0.0f);
+   for (; i + 4 <= len; i += 4)
+      peak4 = _mm_max_ps(peak4,
+         _mm_andnot_ps(signMask, _mm_loadu_ps(buffer + i)));
+   float lanes[4];
+   _mm_storeu_ps(lanes, peak4);
+   for (unsigned ii = 0; ii < 4; ii++)
+      peak = std::max(peak, lanes[ii]);
+#endif
+   for (; i < len; i++)
+      peak = std::max<float>(peak, fabs(buffer[i]));
+   if (mMax < peak)
+      mMax = peak;
 }
 
 void EffectCompressor::OnSlider(wxCommandEvent & WXUNUSED(evt))
@@ -90,9 +90,6 @@ Param( Param1,          double,  wxT("Parameter 1"),    50.0,    0.0,   100.0,
 Param( Param2,          double,  wxT("Parameter 2"),    50.0,    0.0,   100.0,                1    );
 Param( Repeats,         int,     wxT("Repeats"),        1,       0,       5,                  1    );
 
-// How many samples are processed before recomputing the lookup table again
-#define skipsamples 1000
-
 const double MIN_Threshold_Linear DB_TO_LINEAR(MIN_Threshold_dB);
 
 static const struct
@@ -516,7 +513,6 @@ bool EffectDistortion::TransferDataFromWindow()
 void EffectDistortion::InstanceInit(EffectDistortionState & data, float sampleRate)
 {
    data.samplerate = sampleRate;
-   data.skipcount = 0;
    data.tablechoiceindx = mParams.mTableChoiceIndx;
    data.dcblock = mParams.mDCBlock;
    data.threshold = mParams.mThreshold_dB;
@@ -558,55 +554,53 @@ size_t EffectDistortion::InstanceProcess(EffectDistortionState& data, float** in
    data.param1 = mParams.mParam1;
    data.repeats = mParams.mRepeats;
 
-   for (decltype(blockLen) i = 0; i < blockLen; i++) {
-      if (update && ((data.skipcount++) % skipsamples == 0)) {
-         MakeTable();
-      }
+   if (update)
+      MakeTable();
 
-      switch (mParams.mTableChoiceIndx)
-      {
-      case kHardClip:
-         // Param2 = make-up gain.
-         obuf[i] = WaveShaper(ibuf[i]) * ((1 - p2) + (mMakeupGain * p2));
-         break;
-      case kSoftClip:
-         // Param2 = make-up gain.
-         obuf[i] = WaveShaper(ibuf[i]) * ((1 - p2) + (mMakeupGain * p2));
-         break;
-      case kHalfSinCurve:
-         obuf[i] = WaveShaper(ibuf[i]) * p2;
-         break;
-      case kExpCurve:
-         obuf[i] = WaveShaper(ibuf[i]) * p2;
-         break;
-      case kLogCurve:
-         obuf[i] = WaveShaper(ibuf[i]) * p2;
-         break;
-      case kCubic:
-         obuf[i] = WaveShaper(ibuf[i]) * p2;
-         break;
-      case kEvenHarmonics:
-         obuf[i] = WaveShaper(ibuf[i]);
-         break;
-      case kSinCurve:
-         obuf[i] = WaveShaper(ibuf[i]) * p2;
-         break;
-      case kLeveller:
-         obuf[i] = WaveShaper(ibuf[i]);
-         break;
-      case kRectifier:
-         obuf[i] = WaveShaper(ibuf[i]);
-         break;
-      case kHardLimiter:
-         // Mix equivalent to LADSPA effect's "Wet / Residual" mix
-         obuf[i] = (WaveShaper(ibuf[i]) * (p1 - p2)) + (ibuf[i] * p2);
-         break;
-      default:
-         obuf[i] = WaveShaper(ibuf[i]);
-      }
-      if (mParams.mDCBlock) {
+   // Fold the pre-gain, output gain and dry mix of each table choice
+   // into loop-invariant constants, leaving the per-sample work to the
+   // branch-free interpolated table lookup in ShaperBlock
+   float preGain = 1.0;
+   float gain = 1.0;
+   float dryMix = 0.0;
+   switch (mParams.mTableChoiceIndx)
+   {
+   case kHardClip:
+      // Param1 = pre-gain, Param2 = make-up gain.
+      preGain = 1 + p1;
+      gain = (1 - p2) + (mMakeupGain * p2);
+      break;
+   case kSoftClip:
+      // Param2 = make-up gain.
+      gain = (1 - p2) + (mMakeupGain * p2);
+      break;
+   case kHalfSinCurve:
+   case kExpCurve:
+   case kLogCurve:
+   case kCubic:
+   case kSinCurve:
+      gain = p2;
+      break;
+   case kHardLimiter:
+      // Mix equivalent to LADSPA effect's "Wet / Residual" mix
+      gain = p1 - p2;
+      dryMix = p2;
+      break;
+   case kEvenHarmonics:
+   case kLeveller:
+   case kRectifier:
+   default:
+      break;
+   }
+
+   ShaperBlock(ibuf, obuf, blockLen, preGain);
+
+   for (decltype(blockLen) i = 0; i < blockLen; i++)
+      obuf[i] = obuf[i] * gain + ibuf[i] * dryMix;
+
+   if (mParams.mDCBlock) {
+      for (decltype(blockLen) i = 0; i < blockLen; i++)
          obuf[i] = DCFilter(data, obuf[i]);
-      }
    }
 
    return blockLen;
@@ -1260,33 +1254,23 @@ void EffectDistortion::CopyHalfTable()
 }
 
 
-float EffectDistortion::WaveShaper(float sample)
+void EffectDistortion::ShaperBlock(
+   const float *in, float *out, size_t len, float preGain)
 {
-   float out;
-   int index;
-   double xOffset;
-   double amount = 1;
-
-   switch (mParams.mTableChoiceIndx)
+   // One interpolated table lookup per sample, with clamped index
+   // arithmetic and no branches, so the loop vectorizes; any table
+   // dependent pre-gain has been folded into the preGain argument
+   for (size_t i = 0; i < len; i++)
    {
-      // Do any pre-processing here
-      case kHardClip:
-         // Pre-gain
-         amount = mParams.mParam1 / 100.0;
-         sample *= 1+amount;
-         break;
-      default: break;
+      const double xx = (1.0 + in[i] * preGain) * STEPS;
+      int index =
+         wxMax<int>(wxMin<int>((int)std::floor(xx), 2 * STEPS - 1), 0);
+      double xOffset =
+         wxMin<double>(wxMax<double>(xx - index, 0.0), 1.0);   // Clip at 0dB
+
+      // linear interpolation: y = y0 + (y1-y0)*(x-x0)
+      out[i] = mTable[index] + (mTable[index + 1] - mTable[index]) * xOffset;
    }
-
-   index = std::floor(sample * STEPS) + STEPS;
-   index = wxMax<int>(wxMin<int>(index, 2 * STEPS - 1), 0);
-   xOffset = ((1 + sample) * STEPS) - index;
-   xOffset = wxMin<double>(wxMax<double>(xOffset, 0.0), 1.0);   // Clip at 0dB
-
-   // linear interpolation: y = y0 + (y1-y0)*(x-x0)
-   out = mTable[index] + (mTable[index + 1] - mTable[index]) * xOffset;
-
-   return out;
 }
 
 
@@ -22,14 +22,13 @@ class wxTextCtrl;
 class ShuttleGui;
 
 #define DISTORTION_PLUGIN_SYMBOL ComponentInterfaceSymbol{ XO("Distortion") }
-#define STEPS 1024      // number of +ve or -ve steps in lookup tabe
-#define TABLESIZE 2049  // size of lookup table (steps * 2 + 1)
+#define STEPS 2048      // number of +ve or -ve steps in lookup tabe
+#define TABLESIZE 4097  // size of lookup table (steps * 2 + 1)
 
 class EffectDistortionState
 {
 public:
    float       samplerate;
-   sampleCount skipcount;
    int         tablechoiceindx;
    bool        dcblock;
    double      threshold;
@@ -135,7 +134,7 @@ private:
    void UpdateControlText(wxTextCtrl *textCtrl, wxString &string, bool enabled);
 
    void MakeTable();
-   float WaveShaper(float sample);
+   void ShaperBlock(const float *in, float *out, size_t len, float preGain);
    float DCFilter(EffectDistortionState & data, float sample);
 
    // Preset tables for gain lookup
@@ -18,6 +18,9 @@
 
 #include "../Experimental.h"
 
+#include <algorithm>
+#include <math.h>
+
 #include <wx/intl.h>
 #include <wx/slider.h>
 #include <wx/valgen.h>
@@ -26,6 +29,7 @@
 
 #include "../Prefs.h"
 #include "../Shuttle.h"
+#include "../SseMathFuncs.h"
 #include "../ShuttleGui.h"
 #include "../widgets/NumericTextCtrl.h"
 #include "../widgets/valnum.h"
@@ -557,9 +561,9 @@ bool EffectDtmf::MakeDtmfTone(float *buffer, size_t len, float fs, wxChar tone,
    // generate a fade-in of duration 1/250th of second
    if (last == 0) {
       A = (fs / kFadeInOut);
-      for(size_t i = 0; i < A; i++) {
-         buffer[i] *= i/A;
-      }
+      const size_t fadeLen = (size_t)ceil(A);
+      ApplyLinearRamp(buffer, buffer, std::min(fadeLen, len),
+         0.0f, (float)(1.0 / A));
    }
 
    // generate a fade-out of duration 1/250th of second
@@ -571,9 +575,9 @@ bool EffectDtmf::MakeDtmfTone(float *buffer, size_t len, float fs, wxChar tone,
       // protect against negative offset, which can occur if too a
       // small selection is made
       if (offset >= 0) {
-         for(size_t i = 0; i < A; i++) {
-            buffer[i + offset] *= (1 - (i / A));
-         }
+         const size_t fadeLen = (size_t)ceil(A);
+         ApplyLinearRamp(buffer + offset, buffer + offset,
+            std::min(fadeLen, len - size_t(offset)), 1.0f, (float)(-1.0 / A));
       }
    }
    return true;
@@ -24,8 +24,16 @@
 
 #include <float.h>
 
+#include <algorithm>
+
 #include <wx/intl.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ECHO_USE_SSE2
+#include <emmintrin.h>
+#endif
+
 #include "../ShuttleGui.h"
 #include "../Shuttle.h"
 #include "../widgets/AudacityMessageBox.h"
@@ -123,13 +131,35 @@ size_t EffectEcho::ProcessBlock(float **inBlock, float **outBlock, size_t blockL
    float *ibuf = inBlock[0];
    float *obuf = outBlock[0];
 
-   for (decltype(blockLen) i = 0; i < blockLen; i++, histPos++)
+   // Work against the history ring in at most two contiguous runs per
+   // block, so the inner loop carries no wraparound check.  Within a
+   // run the delay line guarantees distinct indices, so the multiply-
+   // accumulate has no dependence between iterations.
+   for (size_t done = 0; done < blockLen;)
    {
       if (histPos == histLen)
-      {
          histPos = 0;
+      const auto len = std::min(blockLen - done, histLen - histPos);
+      float *hist = &history[histPos];
+      const float *in = &ibuf[done];
+      float *out = &obuf[done];
+
+      size_t i = 0;
+#ifdef ECHO_USE_SSE2
+      const __m128 vDecay = _mm_set1_ps(float(decay));
+      for (; i + 4 <= len; i += 4)
+      {
+         const __m128 result = _mm_add_ps(_mm_loadu_ps(in + i),
+            _mm_mul_ps(_mm_loadu_ps(hist + i), vDecay));
+         _mm_storeu_ps(hist + i, result);
+         _mm_storeu_ps(out + i, result);
       }
-      history[histPos] = obuf[i] = ibuf[i] + history[histPos] * decay;
+#endif
+      for (; i < len; i++)
+         hist[i] = out[i] = in[i] + hist[i] * decay;
+
+      histPos += len;
+      done += len;
    }
 
    return blockLen;
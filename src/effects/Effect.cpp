@@ -27,6 +27,12 @@ greater use in future.
 #include "../Experimental.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
 
 #include <wx/bmpbuttn.h>
 #include <wx/checkbox.h>
@@ -54,6 +60,7 @@ greater use in future.
 #include "../LabelTrack.h"
 #include "../Menus.h"
 #include "../Mix.h"
+#include "../PerfCounters.h"
 #include "../PluginManager.h"
 #include "../Prefs.h"
 #include "../Project.h"
@@ -1325,6 +1332,8 @@ bool Effect::InitPass2()
 
 bool Effect::Process()
 {
+   PerfCounters::Scope scope{ PerfCounters::EffectProcess };
+
    CopyInputTracks(true);
    bool bGoodResult = true;
 
@@ -1349,11 +1358,24 @@ bool Effect::Process()
    return bGoodResult;
 }
 
+bool Effect::CanProcessConcurrently() const
+{
+   return mClient && mClient->SupportsConcurrentProcessing();
+}
+
 bool Effect::ProcessPass()
 {
    bool bGoodResult = true;
    bool isGenerator = GetType() == EffectTypeGenerate;
 
+   // Stateless effects processing a simple mono stream per track can use
+   // all the cores
+   if (GetType() == EffectTypeProcess &&
+       CanProcessConcurrently() &&
+       mNumAudioIn == 1 && mNumAudioOut == 1 &&
+       std::thread::hardware_concurrency() > 1)
+      return ProcessPassConcurrent();
+
    FloatBuffers inBuffer, outBuffer;
    ArrayOf<float *> inBufPos, outBufPos;
 
@@ -1505,6 +1527,193 @@ bool Effect::ProcessPass()
    return bGoodResult;
 }
 
+bool Effect::ProcessPassConcurrent()
+{
+   // One work item per selected track; the effect declared itself
+   // stateless, so every channel is independent
+   struct Item {
+      WaveTrack *track;
+      sampleCount start;
+      sampleCount len;
+   };
+   std::vector<Item> items;
+   size_t maxBlock = 0;
+   double total = 0;
+   for (auto track : mOutputTracks->Any<WaveTrack>()) {
+      if (!track->GetSelected())
+         continue;
+      sampleCount start, len;
+      GetSamples(track, &start, &len);
+      if (len == 0)
+         continue;
+      items.push_back({ track, start, len });
+      maxBlock = std::max(maxBlock, track->GetMaxBlockSize() * 2);
+      total += len.as_double();
+   }
+
+   // Sync-locked but unselected tracks get the same adjustment as in the
+   // serial pass
+   for (auto t : mOutputTracks->Any()) {
+      if (!(track_cast<WaveTrack*>(t) && t->GetSelected()) &&
+          t->IsSyncLockSelected())
+         t->SyncLockAdjust(mT1, mT0 + mDuration);
+   }
+
+   if (items.empty())
+      return true;
+
+   SetSampleRate(items[0].track->GetRate());
+   mBlockSize = SetBlockSize(maxBlock);
+   mBufferSize = ((maxBlock + (mBlockSize - 1)) / mBlockSize) * mBlockSize;
+
+   // Hosted clients that opted in process through independent instances,
+   // one per track, created with the Realtime methods; built-in effects
+   // declared themselves stateless and share this object
+   const bool useClientGroups = (mClient != nullptr);
+
+   ChannelName map[2] = { ChannelNameMono, ChannelNameEOL };
+   if (useClientGroups) {
+      if (!mClient->RealtimeInitialize())
+         return false;
+      for (size_t ii = 0, cnt = items.size(); ii < cnt; ++ii) {
+         if (!mClient->RealtimeAddProcessor(1, items[ii].track->GetRate())) {
+            mClient->RealtimeFinalize();
+            return false;
+         }
+      }
+   }
+   else if (!ProcessInitialize(items[0].len, map))
+      return false;
+
+   bool rc = true;
+   { // Start scope for cleanup
+   auto cleanup = finally( [&] {
+      if (useClientGroups) {
+         if (!mClient->RealtimeFinalize())
+            rc = false;
+      }
+      else if (!ProcessFinalize())
+         rc = false;
+   } );
+
+   // Workers read samples and run ProcessBlock; this thread writes the
+   // results back and reports progress.  Writing must stay here because
+   // creating block files through DirManager is not thread-safe.
+   struct Chunk {
+      WaveTrack *track{};
+      sampleCount pos{ 0 };
+      size_t count{ 0 };
+      Floats buffer;
+   };
+
+   const unsigned numWorkers = std::min<size_t>(items.size(),
+      std::max(1u, std::thread::hardware_concurrency()));
+   const size_t maxQueued = 2 * numWorkers;
+
+   std::mutex mutex;
+   std::condition_variable notFull, notEmpty;
+   std::deque<Chunk> chunks;
+   std::atomic<bool> abort{ false };
+   std::atomic<bool> failed{ false };
+   std::atomic<size_t> nextItem{ 0 };
+   std::atomic<unsigned> running{ numWorkers };
+
+   auto worker = [&] {
+      Floats inBuf{ mBufferSize };
+      while (!abort.load() && !failed.load()) {
+         const auto ii = nextItem++;
+         if (ii >= items.size())
+            break;
+         auto &item = items[ii];
+         auto pos = item.start;
+         auto remaining = item.len;
+         while (remaining != 0 && !abort.load() && !failed.load()) {
+            const auto count = limitSampleBufferSize(mBufferSize, remaining);
+            Chunk chunk{ item.track, pos, count, Floats{ count } };
+            bool ok = true;
+            try {
+               item.track->Get(
+                  (samplePtr) inBuf.get(), floatSample, pos, count);
+               size_t done = 0;
+               while (ok && done < count) {
+                  const auto blockLen = std::min(mBlockSize, count - done);
+                  float *ib = inBuf.get() + done;
+                  float *ob = chunk.buffer.get() + done;
+                  ok = (useClientGroups
+                     ? mClient->RealtimeProcess((int) ii, &ib, &ob, blockLen)
+                     : ProcessBlock(&ib, &ob, blockLen)) == blockLen;
+                  done += blockLen;
+               }
+            }
+            catch (...) {
+               ok = false;
+            }
+            if (!ok) {
+               failed.store(true);
+               break;
+            }
+            {
+               std::unique_lock<std::mutex> lock{ mutex };
+               notFull.wait(lock, [&]{
+                  return chunks.size() < maxQueued || abort.load(); });
+               if (abort.load())
+                  break;
+               chunks.push_back(std::move(chunk));
+               notEmpty.notify_one();
+            }
+            pos += count;
+            remaining -= count;
+         }
+      }
+      --running;
+      std::lock_guard<std::mutex> lock{ mutex };
+      notEmpty.notify_one();
+   };
+
+   std::vector<std::thread> threads;
+   auto joiner = finally( [&] {
+      abort.store(true);
+      {
+         std::lock_guard<std::mutex> lock{ mutex };
+         notFull.notify_all();
+      }
+      for (auto &thread : threads)
+         thread.join();
+   } );
+   for (unsigned ii = 0; ii < numWorkers; ++ii)
+      threads.emplace_back(worker);
+
+   // Drain the queue; Set may throw for disk exhaustion, and then the
+   // joiner above stops and collects the workers
+   double processed = 0;
+   for (;;) {
+      Chunk chunk;
+      {
+         std::unique_lock<std::mutex> lock{ mutex };
+         notEmpty.wait(lock, [&]{
+            return !chunks.empty() || running.load() == 0; });
+         if (chunks.empty()) {
+            if (running.load() == 0)
+               break;
+            continue;
+         }
+         chunk = std::move(chunks.front());
+         chunks.pop_front();
+         notFull.notify_one();
+      }
+      chunk.track->Set(
+         (samplePtr) chunk.buffer.get(), floatSample, chunk.pos, chunk.count);
+      processed += chunk.count;
+      if (TotalProgress(processed / total))
+         abort.store(true);
+   }
+
+   if (failed.load() || abort.load())
+      rc = false;
+   } // End scope for cleanup
+   return rc;
+}
+
 bool Effect::ProcessTrack(int count,
                           ChannelNames map,
                           WaveTrack *left,
@@ -1590,6 +1799,43 @@ bool Effect::ProcessTrack(int count,
          genRight = mFactory->NewWaveTrack(right->GetSampleFormat(), right->GetRate());
    }
 
+   // Double-buffered input:  while the plugin chews on one buffer load, a
+   // worker reads the next one from the track.  Since Get and Set touch
+   // the same track, the worker is always joined before any write below.
+   // This overlaps the track reads with the plugin's own processing time,
+   // which dominates in effect-heavy (e.g. VST mastering) chains.
+   const bool usePrefetch =
+      isProcessor && inputRemaining > sampleCount( mBufferSize );
+   FloatBuffers prefetchBuffer;
+   std::future<size_t> prefetch;
+   if (usePrefetch)
+      prefetchBuffer.reinit(right ? 2u : 1u, mBufferSize);
+
+   auto startPrefetch = [&](sampleCount leftPos, sampleCount rightPos,
+      sampleCount remaining)
+   {
+      if (!usePrefetch || remaining == 0)
+         return;
+      prefetch = std::async(std::launch::async, [=, &prefetchBuffer]{
+         auto cnt = limitSampleBufferSize(mBufferSize, remaining);
+         left->Get(
+            (samplePtr) prefetchBuffer[0].get(), floatSample, leftPos, cnt);
+         if (right)
+            right->Get(
+               (samplePtr) prefetchBuffer[1].get(), floatSample, rightPos, cnt);
+         return cnt;
+      });
+   };
+
+   // Never leave a worker reading the track behind us, even on the
+   // exceptional paths
+   auto joinPrefetch = finally( [&]{
+      if (prefetch.valid()) {
+         try { prefetch.get(); }
+         catch (...) {}
+      }
+   } );
+
    // Call the effect until we run out of input or delayed samples
    while (inputRemaining != 0 || delayRemaining != 0)
    {
@@ -1599,16 +1845,33 @@ bool Effect::ProcessTrack(int count,
          // Need to refill the input buffers
          if (inputBufferCnt == 0)
          {
-            // Calculate the number of samples to get
-            inputBufferCnt =
-               limitSampleBufferSize( mBufferSize, inputRemaining );
-
-            // Fill the input buffers
-            left->Get((samplePtr) inBuffer[0].get(), floatSample, inLeftPos, inputBufferCnt);
-            if (right)
+            if (prefetch.valid())
             {
-               right->Get((samplePtr) inBuffer[1].get(), floatSample, inRightPos, inputBufferCnt);
+               // The worker already read this buffer load; just adopt its
+               // buffers (same sizes, so later reuse is unaffected)
+               inputBufferCnt = prefetch.get();
+               std::swap(inBuffer[0], prefetchBuffer[0]);
+               if (right)
+                  std::swap(inBuffer[1], prefetchBuffer[1]);
             }
+            else
+            {
+               // Calculate the number of samples to get
+               inputBufferCnt =
+                  limitSampleBufferSize( mBufferSize, inputRemaining );
+
+               // Fill the input buffers
+               left->Get((samplePtr) inBuffer[0].get(), floatSample, inLeftPos, inputBufferCnt);
+               if (right)
+               {
+                  right->Get((samplePtr) inBuffer[1].get(), floatSample, inRightPos, inputBufferCnt);
+               }
+            }
+
+            // Kick off the read of the buffer load after this one
+            startPrefetch(inLeftPos + inputBufferCnt,
+               inRightPos + inputBufferCnt,
+               inputRemaining - inputBufferCnt);
 
             // Reset the input buffer positions
             for (size_t i = 0; i < mNumChannels; i++)
@@ -1762,6 +2025,11 @@ bool Effect::ProcessTrack(int count,
       {
          if (isProcessor)
          {
+            // The worker must not be reading the track while we write it;
+            // its result is still adopted at the next refill
+            if (prefetch.valid())
+               prefetch.wait();
+
             // Write them out
             left->Set((samplePtr) outBuffer[0].get(), floatSample, outLeftPos, outputBufferCnt);
             if (right)
@@ -1824,6 +2092,9 @@ bool Effect::ProcessTrack(int count,
    {
       if (isProcessor)
       {
+         if (prefetch.valid())
+            prefetch.wait();
+
          left->Set((samplePtr) outBuffer[0].get(), floatSample, outLeftPos, outputBufferCnt);
          if (right)
          {
@@ -304,6 +304,12 @@ protected:
    // Actually do the effect here.
    virtual bool Process();
    virtual bool ProcessPass();
+
+   // An effect whose ProcessBlock keeps no state between blocks or
+   // tracks (and ignores per-track initialization) may return true, and
+   // ProcessPass will then spread the selected tracks over a pool of
+   // worker threads
+   virtual bool CanProcessConcurrently() const;
    virtual bool InitPass1();
    virtual bool InitPass2();
    virtual int GetPass();
@@ -487,6 +493,9 @@ protected:
    void CommonInit();
    void CountWaveTracks();
 
+   // Parallel driver used when CanProcessConcurrently() returns true
+   bool ProcessPassConcurrent();
+
    // Driver for client effects
    bool ProcessTrack(int count,
                      ChannelNames map,
@@ -24,6 +24,7 @@ effects.
 #include "../Experimental.h"
 
 #include "Effect.h"
+#include "RealtimeEffectManager.h"
 
 #include <algorithm>
 #include <wx/stopwatch.h>
@@ -498,6 +499,14 @@ bool EffectManager::SetEffectParameters(const PluginID & ID, const wxString & pa
          return effect->SetAutomationParameters(eap.Read(wxT("Use Preset")));
       }
 
+      // While the effect is processing live audio, post the change for the
+      // audio thread to adopt at the next buffer boundary, rather than
+      // rewriting parameters in the middle of a processing pass
+      if (effect->SupportsRealtime() &&
+          RealtimeEffectManager::Get().RealtimeSetEffectParameters(
+             effect, params))
+         return true;
+
       return effect->SetAutomationParameters(params);
    }
    AudacityCommand *command = GetAudacityCommand(ID);
@@ -57,6 +57,7 @@
 
 #include "../Experimental.h"
 
+#include <algorithm>
 #include <math.h>
 #include <vector>
 
@@ -285,7 +286,10 @@ EffectEqualization::EffectEqualization(int Options)
 
 #ifdef EXPERIMENTAL_EQ_SSE_THREADED
    bool useSSE;
-   GetPrivateConfig(GetCurrentSettingsGroup(), wxT("/SSE/GUI"), useSSE, false);
+   // Take the fast path by default whenever the processor supports it;
+   // the stored setting can still turn it off
+   GetPrivateConfig(GetCurrentSettingsGroup(), wxT("/SSE/GUI"), useSSE,
+      0 != EffectEqualization48x::GetMathCaps()->SSE);
    if(useSSE && !mEffectEqualization48x)
       mEffectEqualization48x = std::make_unique<EffectEqualization48x>();
    else if(!useSSE)
@@ -1384,6 +1388,39 @@ bool EffectEqualization::ProcessOne(int count, WaveTrack * t,
 
 bool EffectEqualization::CalcFilter()
 {
+   // Collect everything the design below reads, to key the kernel cache;
+   // a hit replays a recent design instead of redoing the FFTs
+   std::vector<double> signature;
+   {
+      Envelope *env = (IsLinear() ? mLinEnvelope : mLogEnvelope).get();
+      size_t numPoints = env->GetNumberOfPoints();
+      Doubles when{ numPoints }, value{ numPoints };
+      env->GetPoints(when.get(), value.get(), numPoints);
+      signature.reserve(2 * numPoints + 5);
+      signature.push_back(IsLinear() ? 1.0 : 0.0);
+      signature.push_back(mM);
+      signature.push_back(mWindowSize);
+      signature.push_back(mLoFreq);
+      signature.push_back(mHiFreq);
+      for (size_t i = 0; i < numPoints; i++) {
+         signature.push_back(when[i]);
+         signature.push_back(value[i]);
+      }
+   }
+   for (size_t i = 0; i < mKernelCache.size(); i++) {
+      if (mKernelCache[i].signature == signature) {
+         auto &entry = mKernelCache[i];
+         memcpy(mFilterFuncR.get(), entry.funcR.get(),
+            mWindowSize * sizeof(float));
+         memcpy(mFilterFuncI.get(), entry.funcI.get(),
+            mWindowSize * sizeof(float));
+         if (i > 0)   // keep most recently used first
+            std::rotate(mKernelCache.begin(),
+               mKernelCache.begin() + i, mKernelCache.begin() + i + 1);
+         return TRUE;
+      }
+   }
+
    double loLog = log10(mLoFreq);
    double hiLog = log10(mHiFreq);
    double denom = hiLog - loLog;
@@ -1492,6 +1529,21 @@ bool EffectEqualization::CalcFilter()
    //Back to the frequency domain so we can use it
    RealFFT(mWindowSize, outr.get(), mFilterFuncR.get(), mFilterFuncI.get());
 
+   {
+      KernelCacheEntry entry;
+      entry.signature.swap(signature);
+      entry.funcR = Floats{ mWindowSize };
+      entry.funcI = Floats{ mWindowSize };
+      memcpy(entry.funcR.get(), mFilterFuncR.get(),
+         mWindowSize * sizeof(float));
+      memcpy(entry.funcI.get(), mFilterFuncI.get(),
+         mWindowSize * sizeof(float));
+      mKernelCache.insert(mKernelCache.begin(), std::move(entry));
+      // A handful covers the states a drag or an A/B comparison revisits
+      if (mKernelCache.size() > 8)
+         mKernelCache.resize(8);
+   }
+
    return TRUE;
 }
 
@@ -2997,6 +3049,7 @@ BEGIN_EVENT_TABLE(EqualizationPanel, wxPanelWrapper)
    EVT_MOUSE_EVENTS(EqualizationPanel::OnMouseEvent)
    EVT_MOUSE_CAPTURE_LOST(EqualizationPanel::OnCaptureLost)
    EVT_SIZE(EqualizationPanel::OnSize)
+   EVT_TIMER(wxID_ANY, EqualizationPanel::OnRecalcTimer)
 END_EVENT_TABLE()
 
 EqualizationPanel::EqualizationPanel(
@@ -3009,6 +3062,7 @@ EqualizationPanel::EqualizationPanel(
    mBitmap = NULL;
    mWidth = 0;
    mHeight = 0;
+   mRecalcTimer.SetOwner(this);
 
    mLinEditor = std::make_unique<EnvelopeEditor>(*mEffect->mLinEnvelope, false);
    mLogEditor = std::make_unique<EnvelopeEditor>(*mEffect->mLogEnvelope, false);
@@ -3044,13 +3098,23 @@ void EqualizationPanel::OnSize(wxSizeEvent &  WXUNUSED(event))
    Refresh( false );
 }
 
+void EqualizationPanel::OnRecalcTimer(wxTimerEvent & WXUNUSED(event))
+{
+   if (mRecalcRequired)
+      Refresh(false);
+}
+
 #include "../TrackPanelDrawingContext.h"
 void EqualizationPanel::OnPaint(wxPaintEvent &  WXUNUSED(event))
 {
    wxPaintDC dc(this);
-   if(mRecalcRequired) {
+   // Recomputing the response involves FFTs; while the timer runs, keep
+   // painting the previous response so that dragging a control stays
+   // fluid, and catch up when it expires
+   if(mRecalcRequired && !mRecalcTimer.IsRunning()) {
       Recalc();
       mRecalcRequired = false;
+      mRecalcTimer.StartOnce(50);
    }
    int width, height;
    GetSize(&width, &height);
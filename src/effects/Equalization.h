@@ -18,6 +18,7 @@
 #define PANELBORDER 1   // only increase from '1' for testing purposes - MJS
 
 #include <wx/setup.h> // for wxUSE_* macros
+#include <wx/timer.h>
 
 #include "Effect.h"
 #include "../RealFFTf.h"
@@ -213,6 +214,16 @@ private:
    int mOptions;
    HFFT hFFT;
    Floats mFFTBuffer, mFilterFuncR, mFilterFuncI;
+
+   // Recently designed kernels, most recent first, each keyed by the
+   // envelope points and settings that determined it, so revisiting a
+   // recent state of the controls skips the FFT redesign
+   struct KernelCacheEntry {
+      std::vector<double> signature;
+      Floats funcR, funcI;
+   };
+   std::vector<KernelCacheEntry> mKernelCache;
+
    size_t mM;
    wxString mCurveName;
    bool mLin;
@@ -308,6 +319,7 @@ private:
    void OnCaptureLost(wxMouseCaptureLostEvent & event);
    void OnPaint(wxPaintEvent & event);
    void OnSize (wxSizeEvent & event);
+   void OnRecalcTimer(wxTimerEvent & event);
 
 public:
 //   int & mM;
@@ -321,6 +333,9 @@ private:
    std::unique_ptr<EnvelopeEditor> mLinEditor, mLogEditor;
 
    bool mRecalcRequired;
+   // Limits how often the response is recomputed while controls are
+   // being dragged; between expiries stale curves are painted
+   wxTimer mRecalcTimer;
 
    std::unique_ptr<wxBitmap> mBitmap;
    wxRect mEnvRect;
@@ -55,6 +55,14 @@
 #include <math.h>
 #include <emmintrin.h>
 
+// Use fused multiply-adds for the complex filter products when the build
+// already targets FMA-capable hardware.  The 8x (256-bit) kernels below
+// stay behind __AVX_ENABLED until 8x FFT primitives exist in RealFFTf48x.
+#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define EQ48X_USE_FMA 1
+#include <immintrin.h>
+#endif
+
 #ifdef _WIN32
 
 //  Windows
@@ -71,7 +79,7 @@ void cpuid(int CPUInfo[4],int InfoType){
       "=b" (CPUInfo[1]),
       "=c" (CPUInfo[2]),
       "=d" (CPUInfo[3]) :
-   "a" (InfoType)
+   "a" (InfoType), "c" (0) // leaf 7 reads the subleaf from ecx
       );
 }
 
@@ -107,6 +115,7 @@ MathCaps *EffectEqualization48x::GetMathCaps()
       sMathCaps.SSE42   = false;
       sMathCaps.SSE4a   = false;
       sMathCaps.AVX     = false;
+      sMathCaps.AVX2    = false;
       sMathCaps.XOP     = false;
       sMathCaps.FMA3    = false;
       sMathCaps.FMA4    = false;
@@ -134,6 +143,11 @@ MathCaps *EffectEqualization48x::GetMathCaps()
          sMathCaps.FMA3  = (info[2] & ((int)1 << 12)) != 0;
       }
 
+      if (nIds >= 7){
+         cpuid(info,0x00000007);
+         sMathCaps.AVX2  = (info[1] & ((int)1 <<  5)) != 0;
+      }
+
       if (nExIds >= 0x80000001){
          cpuid(info,0x80000001);
          sMathCaps.x64   = (info[3] & ((int)1 << 29)) != 0;
@@ -1006,8 +1020,13 @@ void EffectEqualization48x::Filter4x(size_t len,
       }
       filterFuncR=_mm_set1_ps(mEffectEqualization->mFilterFuncR[i]);
       filterFuncI=_mm_set1_ps(mEffectEqualization->mFilterFuncI[i]);
+#ifdef EQ48X_USE_FMA
+      localFFTBuffer[2*i  ] = _mm_fmsub_ps(real128, filterFuncR, _mm_mul_ps(imag128, filterFuncI));
+      localFFTBuffer[2*i+1] = _mm_fmadd_ps(real128, filterFuncI, _mm_mul_ps(imag128, filterFuncR));
+#else
       localFFTBuffer[2*i  ] = _mm_sub_ps( _mm_mul_ps(real128, filterFuncR), _mm_mul_ps(imag128, filterFuncI));
       localFFTBuffer[2*i+1] = _mm_add_ps( _mm_mul_ps(real128, filterFuncI), _mm_mul_ps(imag128, filterFuncR));
+#endif
    }
    // Fs/2 component is purely real
    filterFuncR=_mm_set1_ps(mEffectEqualization->mFilterFuncR[halfLength]);
@@ -1305,8 +1324,13 @@ void EffectEqualization48x::Filter8x(size_t len,
       }
       filterFuncR=_mm256_set1_ps(mEffectEqualization->mFilterFuncR[i]);
       filterFuncI=_mm256_set1_ps(mEffectEqualization->mFilterFuncI[i]);
+#ifdef EQ48X_USE_FMA
+      localFFTBuffer[2*i  ] = _mm256_fmsub_ps(real256, filterFuncR, _mm256_mul_ps(imag256, filterFuncI));
+      localFFTBuffer[2*i+1] = _mm256_fmadd_ps(real256, filterFuncI, _mm256_mul_ps(imag256, filterFuncR));
+#else
       localFFTBuffer[2*i  ] = _mm256_sub_ps( _mm256_mul_ps(real256, filterFuncR), _mm256_mul_ps(imag256, filterFuncI));
       localFFTBuffer[2*i+1] = _mm256_add_ps( _mm256_mul_ps(real256, filterFuncI), _mm256_mul_ps(imag256, filterFuncR));
+#endif
    }
    // Fs/2 component is purely real
    filterFuncR=_mm256_set1_ps(mEffectEqualization->mFilterFuncR[halfLength]);
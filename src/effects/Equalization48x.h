@@ -76,6 +76,7 @@ typedef struct {
    int SSE42;
    int SSE4a;
    int AVX;
+   int AVX2;
    int XOP;
    int FMA3;
    int FMA4;
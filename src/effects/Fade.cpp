@@ -18,6 +18,8 @@
 
 #include <wx/intl.h>
 
+#include "../SseMathFuncs.h"
+
 EffectFade::EffectFade(bool fadeIn)
 {
    mFadeIn = fadeIn;
@@ -79,24 +81,20 @@ size_t EffectFade::ProcessBlock(float **inBlock, float **outBlock, size_t blockL
    float *ibuf = inBlock[0];
    float *obuf = outBlock[0];
 
+   // One vectorized multiply by a linear ramp replaces the per-sample
+   // scalar arithmetic
+   const float denom = mSampleCnt.as_float();
    if (mFadeIn)
    {
-      for (decltype(blockLen) i = 0; i < blockLen; i++)
-      {
-         obuf[i] =
-            (ibuf[i] * ( mSample++ ).as_float()) /
-            mSampleCnt.as_float();
-      }
+      ApplyLinearRamp(ibuf, obuf, blockLen,
+         mSample.as_float() / denom, 1.0f / denom);
    }
    else
    {
-      for (decltype(blockLen) i = 0; i < blockLen; i++)
-      {
-         obuf[i] = (ibuf[i] *
-                    ( mSampleCnt - 1 - mSample++ ).as_float()) /
-            mSampleCnt.as_float();
-      }
+      ApplyLinearRamp(ibuf, obuf, blockLen,
+         ( mSampleCnt - 1 - mSample ).as_float() / denom, -1.0f / denom);
    }
+   mSample += blockLen;
 
    return blockLen;
 }
@@ -192,6 +192,21 @@ bool EffectFindClipping::ProcessOne(LabelTrack * lt,
 
          block = limitSampleBufferSize( blockSize, len - s );
 
+         // When no clipped run is in progress, ask the block summaries
+         // whether this stretch can contain clipping at all, and skip the
+         // sample scan when it cannot.  The query is padded by a sample at
+         // each end, so boundary rounding can only make it conservative.
+         if (startrun == 0) {
+            auto t0 = wt->LongSamplesToTime(start + s - (s > 0 ? 1 : 0));
+            auto t1 = wt->LongSamplesToTime(start + s + block + 1);
+            auto minmax = wt->GetMinMax(t0, t1, false);
+            if (minmax.first > -MAX_AUDIO && minmax.second < MAX_AUDIO) {
+               s += block;
+               block = 0;
+               continue;
+            }
+         }
+
          wt->Get((samplePtr)buffer.get(), floatSample, start + s, block);
          ptr = buffer.get();
       }
@@ -30,6 +30,9 @@ protected:
    // [ GenerateTrack() must be overridden by the actual generator class ]
    // Precondition:  mDuration > 0.0
    // Postcondition: <tmp> is filled with the data intended for <track>
+   // Overrides need not synthesize samples:  EffectSilence fills <tmp>
+   // with WaveTrack::InsertSilence, which costs only metadata because
+   // the sequence is built from SilentBlockFiles
    virtual bool GenerateTrack(WaveTrack *tmp,
                               const WaveTrack &track,
                               int ntrack) = 0;
@@ -75,3 +75,11 @@ size_t EffectInvert::ProcessBlock(float **inBlock, float **outBlock, size_t bloc
 
    return blockLen;
 }
+
+// Effect implementation
+
+bool EffectInvert::CanProcessConcurrently() const
+{
+   // Pure sign flip; safe to run on several blocks at once
+   return true;
+}
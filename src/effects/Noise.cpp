@@ -29,6 +29,14 @@
 #include "../widgets/valnum.h"
 #include "../widgets/NumericTextCtrl.h"
 
+// Generating white noise four samples at a time gives a useful speedup on
+// the most common desktop processors.
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NOISE_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
 enum kTypes
 {
    kWhite,
@@ -63,6 +71,10 @@ EffectNoise::EffectNoise()
    SetLinearEffectFlag(true);
 
    y = z = buf0 = buf1 = buf2 = buf3 = buf4 = buf5 = buf6 = 0;
+
+   // Seed the instance-local noise source; xorshift only needs nonzero state
+   for (unsigned int i = 0; i < WXSIZEOF(mRandState); i++)
+      mRandState[i] = (((uint32_t)rand() << 16) ^ (uint32_t)rand()) | 1;
 }
 
 EffectNoise::~EffectNoise()
@@ -106,16 +118,37 @@ size_t EffectNoise::ProcessBlock(float **WXUNUSED(inbuf), float **outbuf, size_t
 
    float white;
    float amplitude;
-   float div = ((float) RAND_MAX) / 2.0f;
 
    switch (mType)
    {
    default:
    case kWhite: // white
+#ifdef NOISE_USE_SSE2
+      {
+         // Four xorshift lanes at once; int32 to float gives [-1, 1)
+         __m128i state = _mm_loadu_si128((__m128i *)mRandState);
+         const __m128 scale = _mm_set1_ps((float)(mAmp / 2147483648.0));
+         decltype(size) i = 0;
+         for (; i + 4 <= size; i += 4)
+         {
+            state = _mm_xor_si128(state, _mm_slli_epi32(state, 13));
+            state = _mm_xor_si128(state, _mm_srli_epi32(state, 17));
+            state = _mm_xor_si128(state, _mm_slli_epi32(state, 5));
+            _mm_storeu_ps(buffer + i,
+               _mm_mul_ps(_mm_cvtepi32_ps(state), scale));
+         }
+         _mm_storeu_si128((__m128i *)mRandState, state);
+         for (; i < size; i++)
+         {
+            buffer[i] = mAmp * NextWhite();
+         }
+      }
+#else
        for (decltype(size) i = 0; i < size; i++)
        {
-          buffer[i] = mAmp * ((rand() / div) - 1.0f);
+          buffer[i] = mAmp * NextWhite();
        }
+#endif
        break;
 
    case kPink: // pink
@@ -125,7 +158,7 @@ size_t EffectNoise::ProcessBlock(float **WXUNUSED(inbuf), float **outbuf, size_t
       amplitude = mAmp * 0.129f;
       for (decltype(size) i = 0; i < size; i++)
       {
-         white = (rand() / div) - 1.0f;
+         white = NextWhite();
          buf0 = 0.99886f * buf0 + 0.0555179f * white;
          buf1 = 0.99332f * buf1 + 0.0750759f * white;
          buf2 = 0.96900f * buf2 + 0.1538520f * white;
@@ -152,7 +185,7 @@ size_t EffectNoise::ProcessBlock(float **WXUNUSED(inbuf), float **outbuf, size_t
  
       for (decltype(size) i = 0; i < size; i++)
       {
-         white = (rand() / div) - 1.0f;
+         white = NextWhite();
          z = leakage * y + white * scaling;
          y = fabs(z) > 1.0
             ? leakage * y - white * scaling
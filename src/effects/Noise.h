@@ -13,6 +13,8 @@
 #ifndef __AUDACITY_EFFECT_NOISE__
 #define __AUDACITY_EFFECT_NOISE__
 
+#include <cstdint>
+
 #include "Effect.h"
 
 class NumericTextCtrl;
@@ -54,12 +56,26 @@ public:
 private:
    // EffectNoise implementation
 
+   // One step of the instance-local white noise source, uniform in [-1, 1).
+   // The vector path in ProcessBlock runs the same xorshift on four lanes.
+   float NextWhite()
+   {
+      uint32_t x = mRandState[0];
+      x ^= x << 13;
+      x ^= x >> 17;
+      x ^= x << 5;
+      mRandState[0] = x;
+      return (int32_t)x / 2147483648.0f;
+   }
+
 private:
    int mType;
    double mAmp;
 
    float y, z, buf0, buf1, buf2, buf3, buf4, buf5, buf6;
 
+   uint32_t mRandState[4];
+
    NumericTextCtrl *mNoiseDurationT;
 };
 
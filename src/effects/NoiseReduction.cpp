@@ -53,6 +53,9 @@
 #include "../widgets/valnum.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <math.h>
 
@@ -276,10 +279,17 @@ private:
                    int count, WaveTrack *track,
                    sampleCount start, sampleCount len);
 
+   struct Record;
+
    void StartNewTrack();
    void ProcessSamples(Statistics &statistics,
       WaveTrack *outputTrack, size_t len, float *buffer);
    void FillFirstHistoryWindow();
+   void TransformWindow(
+      const float *waveBuffer, float *fftBuffer, Record &record) const;
+   void FinishPendingWindow(Statistics &statistics, WaveTrack *outputTrack);
+   void DiscardPendingWindow();
+   void FFTLoop();
    void ApplyFreqSmoothing(FloatVector &gains);
    void GatherStatistics(Statistics &statistics);
    inline bool Classify(const Statistics &statistics, int band);
@@ -347,6 +357,19 @@ private:
       FloatVector mImagFFTs;
    };
    std::vector<std::unique_ptr<Record>> mQueue;
+
+   // Pipeline state, used only for reduction, not profiling:  a helper
+   // thread transforms each complete window to the frequency domain while
+   // this thread applies gains to the window before it
+   enum PendingState { PendingNone, PendingBusy, PendingDone };
+   FloatVector mPendingWave;
+   FloatVector mThreadFFTBuffer;
+   std::unique_ptr<Record> mPendingRecord;
+   std::thread mFFTThread;
+   std::mutex mFFTMutex;
+   std::condition_variable mFFTCondition;
+   PendingState mPendingState{ PendingNone };
+   bool mExitFFTThread{ false };
 };
 
 /****************************************************************//**
@@ -649,6 +672,14 @@ bool EffectNoiseReduction::Process()
 
 EffectNoiseReduction::Worker::~Worker()
 {
+   if (mFFTThread.joinable()) {
+      {
+         std::lock_guard<std::mutex> guard{ mFFTMutex };
+         mExitFFTThread = true;
+      }
+      mFFTCondition.notify_one();
+      mFFTThread.join();
+   }
 }
 
 bool EffectNoiseReduction::Worker::Process
@@ -804,6 +835,16 @@ EffectNoiseReduction::Worker::Worker
    for (unsigned ii = 0; ii < mHistoryLen; ++ii)
       mQueue[ii] = std::make_unique<Record>(mSpectrumSize);
 
+   if (!mDoProfile) {
+      // Start the helper thread for the forward transforms.  It may use
+      // hFFT concurrently with the inverse transforms done on the main
+      // thread, because the plan's tables are read-only once built.
+      mPendingWave.resize(mWindowSize);
+      mThreadFFTBuffer.resize(mWindowSize);
+      mPendingRecord = std::make_unique<Record>(mSpectrumSize);
+      mFFTThread = std::thread{ [this]{ FFTLoop(); } };
+   }
+
    // Create windows
 
    const double constantTerm =
@@ -871,6 +912,9 @@ EffectNoiseReduction::Worker::Worker
 
 void EffectNoiseReduction::Worker::StartNewTrack()
 {
+   // The last window of the previous track may still be in flight
+   DiscardPendingWindow();
+
    float *pFill;
    for(unsigned ii = 0; ii < mHistoryLen; ++ii) {
       Record &record = *mQueue[ii];
@@ -928,13 +972,17 @@ void EffectNoiseReduction::Worker::ProcessSamples
       mInWavePos += avail;
 
       if (mInWavePos == (int)mWindowSize) {
-         FillFirstHistoryWindow();
-         if (mDoProfile)
+         if (mDoProfile) {
+            FillFirstHistoryWindow();
             GatherStatistics(statistics);
+            ++mOutStepCount;
+            RotateHistoryWindows();
+         }
          else
-            ReduceNoise(statistics, outputTrack);
-         ++mOutStepCount;
-         RotateHistoryWindows();
+            // Pipelined:  enter the previously transformed window into
+            // the history, hand this one to the helper thread, and apply
+            // gains while it works
+            FinishPendingWindow(statistics, outputTrack);
 
          // Rotate for overlap-add
          memmove(&mInWaveBuffer[0], &mInWaveBuffer[mStepSize],
@@ -945,16 +993,20 @@ void EffectNoiseReduction::Worker::ProcessSamples
 }
 
 void EffectNoiseReduction::Worker::FillFirstHistoryWindow()
+{
+   TransformWindow(&mInWaveBuffer[0], &mFFTBuffer[0], *mQueue[0]);
+}
+
+void EffectNoiseReduction::Worker::TransformWindow
+(const float *waveBuffer, float *fftBuffer, Record &record) const
 {
    // Transform samples to frequency domain, windowed as needed
    if (mInWindow.size() > 0)
       for (size_t ii = 0; ii < mWindowSize; ++ii)
-         mFFTBuffer[ii] = mInWaveBuffer[ii] * mInWindow[ii];
+         fftBuffer[ii] = waveBuffer[ii] * mInWindow[ii];
    else
-      memmove(&mFFTBuffer[0], &mInWaveBuffer[0], mWindowSize * sizeof(float));
-   RealFFTf(&mFFTBuffer[0], hFFT.get());
-
-   Record &record = *mQueue[0];
+      memmove(fftBuffer, waveBuffer, mWindowSize * sizeof(float));
+   RealFFTf(fftBuffer, hFFT.get());
 
    // Store real and imaginary parts for later inverse FFT, and compute
    // power
@@ -966,16 +1018,16 @@ void EffectNoiseReduction::Worker::FillFirstHistoryWindow()
       const auto last = mSpectrumSize - 1;
       for (unsigned int ii = 1; ii < last; ++ii) {
          const int kk = *pBitReversed++;
-         const float realPart = *pReal++ = mFFTBuffer[kk];
-         const float imagPart = *pImag++ = mFFTBuffer[kk + 1];
+         const float realPart = *pReal++ = fftBuffer[kk];
+         const float imagPart = *pImag++ = fftBuffer[kk + 1];
          *pPower++ = realPart * realPart + imagPart * imagPart;
       }
       // DC and Fs/2 bins need to be handled specially
-      const float dc = mFFTBuffer[0];
+      const float dc = fftBuffer[0];
       record.mRealFFTs[0] = dc;
       record.mSpectrums[0] = dc*dc;
 
-      const float nyquist = mFFTBuffer[1];
+      const float nyquist = fftBuffer[1];
       record.mImagFFTs[0] = nyquist; // For Fs/2, not really imaginary
       record.mSpectrums[last] = nyquist * nyquist;
    }
@@ -989,6 +1041,62 @@ void EffectNoiseReduction::Worker::FillFirstHistoryWindow()
    }
 }
 
+// Wait for the helper to finish the previous window, enter its record
+// into the history, queue the window now in mInWaveBuffer, and only then
+// do this step's gain estimation and synthesis, overlapped with the
+// helper's forward transform.  The one-window latency this introduces is
+// absorbed by FinishTrack, which keeps flushing until the sample counts
+// balance.
+void EffectNoiseReduction::Worker::FinishPendingWindow
+(Statistics &statistics, WaveTrack *outputTrack)
+{
+   bool havePrevious;
+   {
+      std::unique_lock<std::mutex> lock{ mFFTMutex };
+      mFFTCondition.wait(lock,
+         [this]{ return mPendingState != PendingBusy; });
+      havePrevious = (mPendingState == PendingDone);
+      if (havePrevious)
+         // Hand the oldest record's storage back to the helper for reuse
+         std::swap(mPendingRecord, mQueue[0]);
+      memmove(&mPendingWave[0], &mInWaveBuffer[0],
+         mWindowSize * sizeof(float));
+      mPendingState = PendingBusy;
+   }
+   mFFTCondition.notify_one();
+
+   if (havePrevious) {
+      ReduceNoise(statistics, outputTrack);
+      ++mOutStepCount;
+      RotateHistoryWindows();
+   }
+}
+
+void EffectNoiseReduction::Worker::DiscardPendingWindow()
+{
+   if (!mFFTThread.joinable())
+      return;
+   std::unique_lock<std::mutex> lock{ mFFTMutex };
+   mFFTCondition.wait(lock, [this]{ return mPendingState != PendingBusy; });
+   mPendingState = PendingNone;
+}
+
+void EffectNoiseReduction::Worker::FFTLoop()
+{
+   std::unique_lock<std::mutex> lock{ mFFTMutex };
+   for (;;) {
+      mFFTCondition.wait(lock,
+         [this]{ return mExitFFTThread || mPendingState == PendingBusy; });
+      if (mExitFFTThread)
+         return;
+      lock.unlock();
+      TransformWindow(&mPendingWave[0], &mThreadFFTBuffer[0], *mPendingRecord);
+      lock.lock();
+      mPendingState = PendingDone;
+      mFFTCondition.notify_one();
+   }
+}
+
 void EffectNoiseReduction::Worker::RotateHistoryWindows()
 {
    std::rotate(mQueue.begin(), mQueue.end() - 1, mQueue.end());
@@ -268,6 +268,7 @@ bool EffectNormalize::Process()
             // Will compute a maximum
             extent = std::numeric_limits<float>::lowest();
          std::vector<float> offsets;
+         std::vector<BlockIndex> indexes;
 
          wxString msg;
          if (range.size() == 1)
@@ -294,6 +295,7 @@ bool EffectNormalize::Process()
 #endif
                extent = std::max( extent, extent2 );
             offsets.push_back(offset);
+            indexes.push_back(std::move(mBlockIndex));
             // TODO: more-than-two-channels-message
             msg = topMsg +
                wxString::Format( _("Analyzing second track of stereo pair: %s"), trackName );
@@ -336,9 +338,11 @@ bool EffectNormalize::Process()
 
          // Use multiplier in the second, processing loop over channels
          auto pOffset = offsets.begin();
+         auto pIndex = indexes.begin();
          for (auto channel : range) {
             if (false ==
-                (bGoodResult = ProcessOne(channel, msg, progress, *pOffset++)) )
+                (bGoodResult =
+                   ProcessOne(channel, msg, progress, *pOffset++, *pIndex++)) )
                goto break2;
             // TODO: more-than-two-channels-message
             msg = topMsg +
@@ -449,6 +453,9 @@ bool EffectNormalize::AnalyseTrack(const WaveTrack * track, const wxString &msg,
    bool result = true;
    float min, max;
 
+   // Forget any index from an earlier track; AnalyseTrackData rebuilds it
+   mBlockIndex.clear();
+
    if(mGain)
    {
 #ifdef EXPERIMENTAL_R128_NORM
@@ -572,6 +579,19 @@ bool EffectNormalize::AnalyseTrackData(const WaveTrack * track, const wxString &
          AnalyseDataLoudnessDC(buffer.get(), block);
 #endif
 
+      //Record the block's extremes in the side index, so that the second,
+      //processing pass can skip blocks it would leave unchanged.  Blocks
+      //still awaiting on-demand computation are left out; they must not
+      //be skipped.
+      if (blockSamples == block) {
+         float bmin = buffer[0], bmax = buffer[0];
+         for (decltype(block) i = 1; i < block; i++) {
+            bmin = std::min(bmin, buffer[i]);
+            bmax = std::max(bmax, buffer[i]);
+         }
+         mBlockIndex.push_back({ s, block, bmin, bmax });
+      }
+
       //Increment s one blockfull of samples
       s += block;
 
@@ -596,8 +616,10 @@ bool EffectNormalize::AnalyseTrackData(const WaveTrack * track, const wxString &
 //and executes ProcessData, on it...
 // uses mMult and offset to normalize a track.
 // mMult must be set before this is called
-bool EffectNormalize::ProcessOne(
-   WaveTrack * track, const wxString &msg, double &progress, float offset)
+// index is the side index built by AnalyseTrackData (possibly empty);
+// blocks it proves unchanged are neither read nor rewritten
+bool EffectNormalize::ProcessOne(WaveTrack * track, const wxString &msg,
+   double &progress, float offset, const BlockIndex &index)
 {
    bool rc = true;
 
@@ -614,6 +636,11 @@ bool EffectNormalize::ProcessOne(
    //be shorter than the length of the track being processed.
    Floats buffer{ track->GetMaxBlockSize() };
 
+   //When both the offset and the multiplier are trivial every block is
+   //unchanged; a silent block stays silent under any pure gain
+   const bool identity = (offset == 0.0 && mMult == 1.0);
+   auto pEntry = index.begin();
+
    //Go through the track one buffer at a time. s counts which
    //sample the current buffer starts at.
    auto s = start;
@@ -625,14 +652,27 @@ bool EffectNormalize::ProcessOne(
          end - s
       );
 
-      //Get the samples from the track and put them in the buffer
-      track->Get((samplePtr) buffer.get(), floatSample, s, block);
+      //Consult the side index from the analysis pass, which stepped
+      //through the same block boundaries
+      bool skip = identity;
+      if (!skip && offset == 0.0) {
+         while (pEntry != index.end() && pEntry->start < s)
+            ++pEntry;
+         skip = (pEntry != index.end() && pEntry->start == s &&
+                 pEntry->len == block &&
+                 pEntry->min == 0.0 && pEntry->max == 0.0);
+      }
 
-      //Process the buffer.
-      ProcessData(buffer.get(), block, offset);
+      if (!skip) {
+         //Get the samples from the track and put them in the buffer
+         track->Get((samplePtr) buffer.get(), floatSample, s, block);
 
-      //Copy the newly-changed samples back onto the track.
-      track->Set((samplePtr) buffer.get(), floatSample, s, block);
+         //Process the buffer.
+         ProcessData(buffer.get(), block, offset);
+
+         //Copy the newly-changed samples back onto the track.
+         track->Set((samplePtr) buffer.get(), floatSample, s, block);
+      }
 
       //Increment s one blockfull of samples
       s += block;
@@ -15,6 +15,8 @@
 
 #include "../Experimental.h"
 
+#include <vector>
+
 #include "Effect.h"
 #include "Biquad.h"
 
@@ -64,8 +66,18 @@ private:
       ANALYSE_DC, ANALYSE_LOUDNESS, ANALYSE_LOUDNESS_DC
    };
 
-   bool ProcessOne(
-      WaveTrack * t, const wxString &msg, double& progress, float offset);
+   // Side index built during the analysis pass, one entry per buffer-block,
+   // so that the processing pass can skip blocks it would leave unchanged
+   struct BlockExtent
+   {
+      sampleCount start;
+      size_t len;
+      float min, max;
+   };
+   using BlockIndex = std::vector<BlockExtent>;
+
+   bool ProcessOne(WaveTrack * t, const wxString &msg, double& progress,
+                   float offset, const BlockIndex &index);
    bool AnalyseTrack(const WaveTrack * track, const wxString &msg,
                      double &progress, float &offset, float &extent);
    bool AnalyseTrackData(const WaveTrack * track, const wxString &msg, double &progress,
@@ -104,6 +116,7 @@ private:
    double mSqSum;
 #endif
    sampleCount    mCount;
+   BlockIndex mBlockIndex;
 
    wxCheckBox *mGainCheckBox;
    wxCheckBox *mDCCheckBox;
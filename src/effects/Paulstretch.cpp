@@ -18,9 +18,14 @@
 #include "Paulstretch.h"
 
 #include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
 
 #include <math.h>
 #include <float.h>
+#include <string.h>
 
 #include <wx/intl.h>
 #include <wx/valgen.h>
@@ -28,6 +33,7 @@
 #include "../Shuttle.h"
 #include "../ShuttleGui.h"
 #include "../FFT.h"
+#include "../RealFFTf.h"
 #include "../widgets/valnum.h"
 #include "../widgets/AudacityMessageBox.h"
 #include "../Prefs.h"
@@ -40,8 +46,9 @@
 Param( Amount, float,   wxT("Stretch Factor"),   10.0,    1.0,     FLT_MAX, 1   );
 Param( Time,   float,   wxT("Time Resolution"),  0.25f,   0.00099f,  FLT_MAX, 1   );
 
-/// \brief Class that helps EffectPaulStretch.  It does the FFTs and inner loop 
-/// of the effect.
+/// \brief Class that helps EffectPaulStretch.  It keeps the input pool and
+/// assembles the overlapped output windows of the effect, in order, on the
+/// main thread; the FFT work in between is done by PaulStretchWorker.
 class PaulStretch
 {
 public:
@@ -49,14 +56,17 @@ public:
    //in_bufsize is also a half of a FFT buffer (in samples)
    virtual ~PaulStretch();
 
-   void process(float *smps, size_t nsmps);
+   void add_samples(const float *smps, size_t nsmps);
+   const float *pool() const { return in_pool.get(); }
+
+   //blend one IFFT result (as computed by PaulStretchWorker from a snapshot
+   //of the pool) with the previous window and make the output buffer
+   void make_output(const float *ifft_smps);
 
    size_t get_nsamples();//how many samples are required to be added in the pool next time
    size_t get_nsamples_for_fill();//how many samples are required to be added for a complete buffer refill (at start of the song or after seek)
 
 private:
-   void process_spectrum(float *WXUNUSED(freq)) {};
-
    const float samplerate;
    const float rap;
    const size_t in_bufsize;
@@ -75,8 +85,25 @@ private:
    const Floats in_pool;//de marimea in_bufsize
 
    double remained_samples;//how many fraction of samples has remained (0..1)
+};
+
+/// \brief Scratch space and transform code for one worker thread of
+/// EffectPaulstretch.  Computes the windowed FFT, phase randomization and
+/// IFFT of one stretch column.  The FFT routines share only their sine and
+/// bit-reversal tables, which are built before the workers start, so several
+/// workers may transform concurrently.
+class PaulStretchWorker
+{
+public:
+   explicit PaulStretchWorker(size_t poolsize_);
+
+   void compute_window(const float *pool, unsigned seed, float *ifft_smps);
+
+private:
+   void process_spectrum(float *WXUNUSED(freq)) {};
 
-   const Floats fft_smps, fft_c, fft_s, fft_freq, fft_tmp;
+   const size_t poolsize;
+   Floats fft_smps, fft_c, fft_s, fft_freq, fft_tmp;
 };
 
 //
@@ -343,48 +370,131 @@ bool EffectPaulstretch::ProcessOne(WaveTrack *track,double t0,double t1,int coun
       const auto fade_len = std::min<size_t>(100, bufsize / 2 - 1);
       bool cancelled = false;
 
+      // One unit of worker work:  a snapshot of the input pool going in, the
+      // IFFT of the phase-randomized spectrum coming out
+      struct Job {
+         Floats pool;
+         Floats ifft;
+         unsigned seed;
+         bool discard;//primes the overlap history only; not appended
+         bool fadeOut;
+         double frac;//progress after this window, for TrackProgress
+      };
+
+      // Bound the number of windows in flight, so that memory use stays
+      // proportional to the worker count and not to the selection length
+      const size_t numWorkers =
+         std::max(1u, std::thread::hardware_concurrency());
+      const size_t maxJobs = numWorkers * 8;
+
+      std::vector<Job> jobs(maxJobs);
+      for (auto &job : jobs) {
+         job.pool.reinit(stretch.poolsize);
+         job.ifft.reinit(stretch.poolsize);
+      }
+
+      std::vector<PaulStretchWorker> workers;
+      workers.reserve(numWorkers);
+      for (size_t ii = 0; ii < numWorkers; ii++)
+         workers.emplace_back(stretch.poolsize);
+
+      // Build the shared FFT tables on this thread, before the workers start;
+      // they then only read them, and allocation failures surface here where
+      // the enclosing try can handle them.  The handle also pins the table in
+      // GetFFT's pool for the duration.
+      InitFFT();
+      const auto hFFT = GetFFT(stretch.poolsize);
+
       {
          Floats fade_track_smps{ fade_len };
          decltype(len) s=0;
+         bool firstOut = true;
+
+         while (s < len && !cancelled) {
+            // Advance the pool sequentially on this thread, snapshotting it
+            // into a batch of jobs
+            size_t numJobs = 0;
+            while (numJobs < maxJobs && s < len) {
+               track->Get((samplePtr)bufferptr0, floatSample, start + s, nget);
+
+               auto &job = jobs[numJobs++];
+               stretch.add_samples(bufferptr0, nget);
+               memcpy(job.pool.get(), stretch.pool(),
+                  stretch.poolsize * sizeof(float));
+               job.seed = (unsigned)rand();
+               job.discard = false;
+               job.fadeOut = false;
+
+               if (first_time) {
+                  // The first window only primes the overlap history and is
+                  // not appended; the second, from the same pool contents,
+                  // becomes the first output window
+                  first_time = false;
+                  job.discard = true;
+                  auto &job2 = jobs[numJobs++];
+                  memcpy(job2.pool.get(), stretch.pool(),
+                     stretch.poolsize * sizeof(float));
+                  job2.seed = (unsigned)rand();
+                  job2.discard = false;
+                  job2.fadeOut = false;
+               }
 
-         while (s < len) {
-            track->Get((samplePtr)bufferptr0, floatSample, start + s, nget);
-            stretch.process(buffer0.get(), nget);
-
-            if (first_time) {
-               stretch.process(buffer0.get(), 0);
-            };
+               s += nget;
+               if (s >= len)
+                  jobs[numJobs - 1].fadeOut = true;
+               jobs[numJobs - 1].frac = s.as_double() / len.as_double();
 
-            s += nget;
+               nget = stretch.get_nsamples();
+            }
 
-            if (first_time){//blend the the start of the selection
-               track->Get((samplePtr)fade_track_smps.get(), floatSample, start, fade_len);
-               first_time = false;
-               for (size_t i = 0; i < fade_len; i++){
-                  float fi = (float)i / (float)fade_len;
-                  stretch.out_buf[i] =
-                     stretch.out_buf[i] * fi + (1.0 - fi) * fade_track_smps[i];
-               }
+            // Let the workers transform the batch, in any order
+            std::atomic<size_t> nextJob{ 0 };
+            std::vector<std::thread> threads;
+            const auto useWorkers = std::min(numWorkers, numJobs);
+            for (size_t ww = 0; ww < useWorkers; ww++) {
+               threads.emplace_back([&, ww]{
+                  size_t jj;
+                  while ((jj = nextJob++) < numJobs) {
+                     auto &job = jobs[jj];
+                     workers[ww].compute_window(
+                        job.pool.get(), job.seed, job.ifft.get());
+                  }
+               });
             }
-            if (s >= len){//blend the end of the selection
-               track->Get((samplePtr)fade_track_smps.get(), floatSample, end - fade_len, fade_len);
-               for (size_t i = 0; i < fade_len; i++){
-                  float fi = (float)i / (float)fade_len;
-                  auto i2 = bufsize / 2 - 1 - i;
-                  stretch.out_buf[i2] =
-                     stretch.out_buf[i2] * fi + (1.0 - fi) *
-                     fade_track_smps[fade_len - 1 - i];
+            for (auto &thread : threads)
+               thread.join();
+
+            // Overlap-add the finished windows in order and append them
+            for (size_t jj = 0; jj < numJobs && !cancelled; jj++) {
+               auto &job = jobs[jj];
+               stretch.make_output(job.ifft.get());
+               if (job.discard)
+                  continue;
+
+               if (firstOut){//blend the the start of the selection
+                  track->Get((samplePtr)fade_track_smps.get(), floatSample, start, fade_len);
+                  firstOut = false;
+                  for (size_t i = 0; i < fade_len; i++){
+                     float fi = (float)i / (float)fade_len;
+                     stretch.out_buf[i] =
+                        stretch.out_buf[i] * fi + (1.0 - fi) * fade_track_smps[i];
+                  }
+               }
+               if (job.fadeOut){//blend the end of the selection
+                  track->Get((samplePtr)fade_track_smps.get(), floatSample, end - fade_len, fade_len);
+                  for (size_t i = 0; i < fade_len; i++){
+                     float fi = (float)i / (float)fade_len;
+                     auto i2 = bufsize / 2 - 1 - i;
+                     stretch.out_buf[i2] =
+                        stretch.out_buf[i2] * fi + (1.0 - fi) *
+                        fade_track_smps[fade_len - 1 - i];
+                  }
                }
-            }
 
-            outputTrack->Append((samplePtr)stretch.out_buf.get(), floatSample, stretch.out_bufsize);
+               outputTrack->Append((samplePtr)stretch.out_buf.get(), floatSample, stretch.out_bufsize);
 
-            nget = stretch.get_nsamples();
-            if (TrackProgress(count,
-               s.as_double() / len.as_double()
-            )) {
-               cancelled = true;
-               break;
+               if (TrackProgress(count, job.frac))
+                  cancelled = true;
             }
          }
       }
@@ -418,11 +528,6 @@ PaulStretch::PaulStretch(float rap_, size_t in_bufsize_, float samplerate_ )
    , poolsize { in_bufsize_ * 2 }
    , in_pool { poolsize, true }
    , remained_samples { 0.0 }
-   , fft_smps { poolsize, true }
-   , fft_c { poolsize, true }
-   , fft_s { poolsize, true }
-   , fft_freq { poolsize, true }
-   , fft_tmp { poolsize }
 {
 }
 
@@ -430,7 +535,7 @@ PaulStretch::~PaulStretch()
 {
 }
 
-void PaulStretch::process(float *smps, size_t nsmps)
+void PaulStretch::add_samples(const float *smps, size_t nsmps)
 {
    //add NEW samples to the pool
    if ((smps != NULL) && (nsmps != 0)) {
@@ -447,43 +552,10 @@ void PaulStretch::process(float *smps, size_t nsmps)
       for (size_t i = 0; i < nsmps; i++)
          in_pool[i + nleft] = smps[i];
    }
+}
 
-   //get the samples from the pool
-   for (size_t i = 0; i < poolsize; i++)
-      fft_smps[i] = in_pool[i];
-   WindowFunc(eWinFuncHanning, poolsize, fft_smps.get());
-
-   RealFFT(poolsize, fft_smps.get(), fft_c.get(), fft_s.get());
-
-   for (size_t i = 0; i < poolsize / 2; i++)
-      fft_freq[i] = sqrt(fft_c[i] * fft_c[i] + fft_s[i] * fft_s[i]);
-   process_spectrum(fft_freq.get());
-
-
-   //put randomize phases to frequencies and do a IFFT
-   float inv_2p15_2pi = 1.0 / 16384.0 * (float)M_PI;
-   for (size_t i = 1; i < poolsize / 2; i++) {
-      unsigned int random = (rand()) & 0x7fff;
-      float phase = random * inv_2p15_2pi;
-      float s = fft_freq[i] * sin(phase);
-      float c = fft_freq[i] * cos(phase);
-
-      fft_c[i] = fft_c[poolsize - i] = c;
-
-      fft_s[i] = s; fft_s[poolsize - i] = -s;
-   }
-   fft_c[0] = fft_s[0] = 0.0;
-   fft_c[poolsize / 2] = fft_s[poolsize / 2] = 0.0;
-
-   FFT(poolsize, true, fft_c.get(), fft_s.get(), fft_smps.get(), fft_tmp.get());
-
-   float max = 0.0, max2 = 0.0;
-   for (size_t i = 0; i < poolsize; i++) {
-      max = std::max(max, fabsf(fft_tmp[i]));
-      max2 = std::max(max2, fabsf(fft_smps[i]));
-   }
-
-
+void PaulStretch::make_output(const float *ifft_smps)
+{
    //make the output buffer
    float tmp = 1.0 / (float) out_bufsize * M_PI;
    float hinv_sqrt2 = 0.853553390593f;//(1.0+1.0/sqrt(2))*0.5;
@@ -496,15 +568,14 @@ void PaulStretch::process(float *smps, size_t nsmps)
 
    for (size_t i = 0; i < out_bufsize; i++) {
       float a = (0.5 + 0.5 * cos(i * tmp));
-      float out = fft_smps[i + out_bufsize] * (1.0 - a) + old_out_smp_buf[i] * a;
+      float out = ifft_smps[i + out_bufsize] * (1.0 - a) + old_out_smp_buf[i] * a;
       out_buf[i] =
          out * (hinv_sqrt2 - (1.0 - hinv_sqrt2) * cos(i * 2.0 * tmp)) *
          ampfactor;
    }
 
    //copy the current output buffer to old buffer
-   for (size_t i = 0; i < out_bufsize * 2; i++)
-      old_out_smp_buf[i] = fft_smps[i];
+   memcpy(old_out_smp_buf.get(), ifft_smps, out_bufsize * 2 * sizeof(float));
 }
 
 size_t PaulStretch::get_nsamples()
@@ -530,3 +601,54 @@ size_t PaulStretch::get_nsamples_for_fill()
 {
    return poolsize;
 }
+
+/*************************************************************/
+
+
+PaulStretchWorker::PaulStretchWorker(size_t poolsize_)
+   : poolsize { poolsize_ }
+   , fft_smps { poolsize, true }
+   , fft_c { poolsize, true }
+   , fft_s { poolsize, true }
+   , fft_freq { poolsize, true }
+   , fft_tmp { poolsize }
+{
+}
+
+void PaulStretchWorker::compute_window(
+   const float *pool, unsigned seed, float *ifft_smps)
+{
+   //get the samples from the pool
+   for (size_t i = 0; i < poolsize; i++)
+      fft_smps[i] = pool[i];
+   WindowFunc(eWinFuncHanning, poolsize, fft_smps.get());
+
+   RealFFT(poolsize, fft_smps.get(), fft_c.get(), fft_s.get());
+
+   for (size_t i = 0; i < poolsize / 2; i++)
+      fft_freq[i] = sqrt(fft_c[i] * fft_c[i] + fft_s[i] * fft_s[i]);
+   process_spectrum(fft_freq.get());
+
+
+   //put randomize phases to frequencies and do a IFFT
+   //each window draws its phases from its own generator, seeded on the main
+   //thread, so the result does not depend on how the windows are interleaved
+   //over the workers (rand(), used here before, keeps global state and is
+   //not safe to call concurrently)
+   std::minstd_rand rng{ seed };
+   float inv_2p15_2pi = 1.0 / 16384.0 * (float)M_PI;
+   for (size_t i = 1; i < poolsize / 2; i++) {
+      unsigned int random = rng() & 0x7fff;
+      float phase = random * inv_2p15_2pi;
+      float s = fft_freq[i] * sin(phase);
+      float c = fft_freq[i] * cos(phase);
+
+      fft_c[i] = fft_c[poolsize - i] = c;
+
+      fft_s[i] = s; fft_s[poolsize - i] = -s;
+   }
+   fft_c[0] = fft_s[0] = 0.0;
+   fft_c[poolsize / 2] = fft_s[poolsize / 2] = 0.0;
+
+   FFT(poolsize, true, fft_c.get(), fft_s.get(), ifft_smps, fft_tmp.get());
+}
@@ -24,6 +24,7 @@
 
 #include "../Experimental.h"
 
+#include <algorithm>
 #include <math.h>
 
 #include <wx/intl.h>
@@ -401,39 +402,86 @@ size_t EffectPhaser::InstanceProcess(EffectPhaserState & data, float **inBlock,
    data.phase = mPhase * M_PI / 180;
    data.outgain = DB_TO_LINEAR(mOutGain);
 
-   for (decltype(blockLen) i = 0; i < blockLen; i++)
+   // Hoist the per-sample state into locals for the whole block, so the
+   // allpass chain runs on registers instead of the state structure
+   const int stages = mStages;
+   double old[NUM_STAGES];
+   for (int j = 0; j < stages; j++)
+      old[j] = data.old[j];
+   double gain = data.gain;
+   double fbout = data.fbout;
+   auto skipcount = data.skipcount;
+   const double feedback = mFeedback / 101.0;  // Feedback must be less than 100% to avoid infinite gain.
+   const double wet = data.outgain * mDryWet / 255.0;
+   const double dry = data.outgain * (255 - mDryWet) / 255.0;
+
+   // Successive LFO updates are a fixed angle apart, so after one pair
+   // of trig calls per block the cosine is advanced by complex rotation
+   const double delta = lfoskipsamples * data.lfoskip;
+   const double rotCos = cos(delta), rotSin = sin(delta);
+   bool haveTrig = false;
+   double lfoCos = 0, lfoSin = 0;
+
+   decltype(blockLen) i = 0;
+   while (i < blockLen)
    {
-      double in = ibuf[i];
-
-      double m = in + data.fbout * mFeedback / 101;  // Feedback must be less than 100% to avoid infinite gain.
-
-      if (((data.skipcount++) % lfoskipsamples) == 0)
+      const auto rem = (skipcount % lfoskipsamples).as_size_t();
+      if (rem == 0)
       {
+         if (!haveTrig)
+         {
+            // as before, the angle is taken after the increment
+            const double angle =
+               (skipcount + 1).as_double() * data.lfoskip + data.phase;
+            lfoCos = cos(angle);
+            lfoSin = sin(angle);
+            haveTrig = true;
+         }
+         else
+         {
+            const double newCos = lfoCos * rotCos - lfoSin * rotSin;
+            lfoSin = lfoSin * rotCos + lfoCos * rotSin;
+            lfoCos = newCos;
+         }
+
          //compute sine between 0 and 1
-         data.gain =
-            (1.0 +
-             cos(data.skipcount.as_double() * data.lfoskip
-                 + data.phase)) / 2.0;
+         gain = (1.0 + lfoCos) / 2.0;
 
          // change lfo shape
-         data.gain = expm1(data.gain * phaserlfoshape) / expm1(phaserlfoshape);
+         gain = expm1(gain * phaserlfoshape) / expm1(phaserlfoshape);
 
          // attenuate the lfo
-         data.gain = 1.0 - data.gain / 255.0 * mDepth;
+         gain = 1.0 - gain / 255.0 * mDepth;
       }
 
-      // phasing routine
-      for (int j = 0; j < mStages; j++)
+      // the gain holds until the next control-rate boundary
+      const auto seg =
+         std::min<decltype(blockLen)>(blockLen - i, lfoskipsamples - rem);
+      for (decltype(blockLen) n = 0; n < seg; n++, i++)
       {
-         double tmp = data.old[j];
-         data.old[j] = data.gain * tmp + m;
-         m = tmp - data.gain * data.old[j];
+         const double in = ibuf[i];
+         double m = in + fbout * feedback;
+
+         // phasing routine
+         for (int j = 0; j < stages; j++)
+         {
+            double tmp = old[j];
+            old[j] = gain * tmp + m;
+            m = tmp - gain * old[j];
+         }
+         fbout = m;
+
+         obuf[i] = (float) (m * wet + in * dry);
       }
-      data.fbout = m;
-
-      obuf[i] = (float) (data.outgain * (m * mDryWet + in * (255 - mDryWet)) / 255);
+      skipcount += seg;
    }
 
+   for (int j = 0; j < stages; j++)
+      data.old[j] = old[j];
+   data.gain = gain;
+   data.fbout = fbout;
+   data.skipcount = skipcount;
+
    return blockLen;
 }
 
@@ -15,14 +15,17 @@
 
 #include "audacity/EffectInterface.h"
 #include "MemoryX.h"
+#include "../Shuttle.h"
 
 #include <atomic>
+#include <thread>
 #include <wx/time.h>
 
 class RealtimeEffectState
 {
 public:
    explicit RealtimeEffectState( EffectClientInterface &effect );
+   ~RealtimeEffectState();
 
    EffectClientInterface &GetEffect() const { return mEffect; }
 
@@ -33,6 +36,9 @@ public:
       unsigned chans, float **inbuf, float **outbuf, size_t numSamples);
    bool IsRealtimeActive();
 
+   bool PostParameters(const wxString &parms);
+   void AdoptParameters();
+
 private:
    EffectClientInterface &mEffect;
 
@@ -40,6 +46,15 @@ private:
    int mCurrentProcessor;
 
    std::atomic<int> mRealtimeSuspendCount{ 1 };    // Effects are initially suspended
+
+   // Single-slot mailbox for parameter snapshots.  The main thread
+   // exchanges a NEW snapshot in, reclaiming any stale one it gets back;
+   // the audio thread exchanges it out at a pass boundary.  Neither side
+   // ever waits for the other.
+   std::atomic<CommandParameters *> mPendingParameters{ nullptr };
+   // The snapshot the audio thread last consumed, parked here for the
+   // main thread to delete
+   std::atomic<CommandParameters *> mRetiredParameters{ nullptr };
 };
 
 RealtimeEffectManager & RealtimeEffectManager::Get()
@@ -96,6 +111,7 @@ void RealtimeEffectManager::RealtimeSetEffects(const EffectArray & effects)
    // Get rid of the old chain
    // And install the NEW one
    mStates.swap( newStates );
+   mStatesVersion++;
 
    // Allow RealtimeProcess() to, well, process 
    RealtimeResume();
@@ -119,6 +135,7 @@ void RealtimeEffectManager::RealtimeAddEffect(EffectClientInterface *effect)
 
    // Add to list of active effects
    mStates.emplace_back( std::make_unique< RealtimeEffectState >( *effect ) );
+   mStatesVersion++;
    auto &state = mStates.back();
 
    // Initialize effect if realtime is already active
@@ -158,7 +175,10 @@ void RealtimeEffectManager::RealtimeRemoveEffect(EffectClientInterface *effect)
       }
    );
    if (found != end)
+   {
       mStates.erase(found);
+      mStatesVersion++;
+   }
 
    // Allow RealtimeProcess() to, well, process 
    RealtimeResume();
@@ -187,6 +207,28 @@ void RealtimeEffectManager::RealtimeInitialize(double rate)
    RealtimeResume();
 }
 
+bool RealtimeEffectManager::RealtimeSetEffectParameters(
+   EffectClientInterface *effect, const wxString &parms)
+{
+   // Serialize with the other main-thread mutators, which may be
+   // erasing states; the audio thread is not made to wait
+   mRealtimeLock.Enter();
+
+   bool posted = false;
+   for (auto &state : mStates)
+   {
+      if (&state->GetEffect() == effect)
+      {
+         posted = state->PostParameters(parms);
+         break;
+      }
+   }
+
+   mRealtimeLock.Leave();
+
+   return posted;
+}
+
 void RealtimeEffectManager::RealtimeAddProcessor(int group, unsigned chans, float rate)
 {
    for (auto &state : mStates)
@@ -230,6 +272,13 @@ void RealtimeEffectManager::RealtimeSuspend()
    // Show that we aren't going to be doing anything
    mRealtimeSuspended = true;
 
+   // Wait for any processing pass underway in the audio thread to drain;
+   // after that the audio thread will not touch the states until resumed,
+   // so callers may safely modify them.  This thread never makes the audio
+   // thread wait, only the other way around.
+   while (mRealtimeProcessCount.load() > 0)
+      std::this_thread::yield();
+
    // And make sure the effects don't either
    for (auto &state : mStates)
       state->RealtimeSuspend();
@@ -263,21 +312,31 @@ void RealtimeEffectManager::RealtimeResume()
 //
 void RealtimeEffectManager::RealtimeProcessStart()
 {
-   // Protect ourselves from the main thread
-   mRealtimeLock.Enter();
+   // No lock is taken on this realtime thread.  Announce the pass first,
+   // then test the suspension flag:  RealtimeSuspend on another thread
+   // sets the flag first and then waits for the count to drain, so a pass
+   // can never overlap a modification of the states.
+   ++mRealtimeProcessCount;
 
    // Can be suspended because of the audio stream being paused or because effects
    // have been suspended.
-   if (!mRealtimeSuspended)
+   if (mRealtimeSuspended)
    {
-      for (auto &state : mStates)
-      {
-         if (state->IsRealtimeActive())
-            state->GetEffect().RealtimeProcessStart();
-      }
+      --mRealtimeProcessCount;
+      mProcessingPass = false;
+      return;
    }
+   mProcessingPass = true;
 
-   mRealtimeLock.Leave();
+   for (auto &state : mStates)
+   {
+      // Adopt any parameter snapshot posted since the last pass, here at
+      // a buffer boundary, so a change never lands in the middle of a
+      // block
+      state->AdoptParameters();
+      if (state->IsRealtimeActive())
+         state->GetEffect().RealtimeProcessStart();
+   }
 }
 
 //
@@ -285,16 +344,11 @@ void RealtimeEffectManager::RealtimeProcessStart()
 //
 size_t RealtimeEffectManager::RealtimeProcess(int group, unsigned chans, float **buffers, size_t numSamples)
 {
-   // Protect ourselves from the main thread
-   mRealtimeLock.Enter();
-
-   // Can be suspended because of the audio stream being paused or because effects
-   // have been suspended, so allow the samples to pass as-is.
-   if (mRealtimeSuspended || mStates.empty())
-   {
-      mRealtimeLock.Leave();
+   // The bracketing RealtimeProcessStart decided whether this pass runs;
+   // if it does, the states cannot change underneath us, so no lock and
+   // no chance of blocking behind the main thread.
+   if (!mProcessingPass || mStates.empty())
       return numSamples;
-   }
 
    // Remember when we started so we can calculate the amount of latency we
    // are introducing
@@ -347,8 +401,6 @@ size_t RealtimeEffectManager::RealtimeProcess(int group, unsigned chans, float *
    // Remember the latency
    mRealtimeLatency = (int) (wxGetUTCTimeMillis() - start).GetValue();
 
-   mRealtimeLock.Leave();
-
    //
    // This is wrong...needs to handle tails
    //
@@ -360,21 +412,18 @@ size_t RealtimeEffectManager::RealtimeProcess(int group, unsigned chans, float *
 //
 void RealtimeEffectManager::RealtimeProcessEnd()
 {
-   // Protect ourselves from the main thread
-   mRealtimeLock.Enter();
+   if (!mProcessingPass)
+      return;
 
-   // Can be suspended because of the audio stream being paused or because effects
-   // have been suspended.
-   if (!mRealtimeSuspended)
+   for (auto &state : mStates)
    {
-      for (auto &state : mStates)
-      {
-         if (state->IsRealtimeActive())
-            state->GetEffect().RealtimeProcessEnd();
-      }
+      if (state->IsRealtimeActive())
+         state->GetEffect().RealtimeProcessEnd();
    }
 
-   mRealtimeLock.Leave();
+   // Close the pass; a waiting RealtimeSuspend may now proceed
+   mProcessingPass = false;
+   --mRealtimeProcessCount;
 }
 
 int RealtimeEffectManager::GetRealtimeLatency()
@@ -387,6 +436,54 @@ RealtimeEffectState::RealtimeEffectState( EffectClientInterface &effect )
 {
 }
 
+RealtimeEffectState::~RealtimeEffectState()
+{
+   // No other thread touches the mailbox once the state is being destroyed
+   delete mPendingParameters.exchange(nullptr);
+   delete mRetiredParameters.exchange(nullptr);
+}
+
+// Called on the main thread
+bool RealtimeEffectState::PostParameters(const wxString &parms)
+{
+   // Parse and validate on this thread; the audio thread only adopts the
+   // finished snapshot
+   auto snapshot = std::make_unique<CommandParameters>(parms);
+   ShuttleSetAutomation S;
+   S.SetForValidating( snapshot.get() );
+   // DefineParams returns false if not defined for this effect.
+   if (mEffect.DefineParams( S ) && !S.bOK)
+      return false;
+
+   // The newest snapshot wins; reclaim any predecessor that the audio
+   // thread never got to
+   delete mPendingParameters.exchange(snapshot.release());
+
+   // And reclaim whatever the audio thread has finished with
+   delete mRetiredParameters.exchange(nullptr);
+
+   return true;
+}
+
+// Called on the audio thread, between processing passes
+void RealtimeEffectState::AdoptParameters()
+{
+   auto parms = mPendingParameters.exchange(nullptr);
+   if (parms)
+   {
+      // Apply the same way Effect::SetAutomationParameters would
+      ShuttleSetAutomation S;
+      S.SetForWriting( parms );
+      if (!mEffect.DefineParams( S ))
+         // the old method...
+         mEffect.SetAutomationParameters( *parms );
+
+      // Park the consumed snapshot for the main thread to delete.  Only
+      // if the parking spot was still full must this thread free one.
+      delete mRetiredParameters.exchange(parms);
+   }
+}
+
 bool RealtimeEffectState::RealtimeSuspend()
 {
    auto result = mEffect.RealtimeSuspend();
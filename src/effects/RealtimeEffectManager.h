@@ -11,12 +11,14 @@
 #ifndef __AUDACITY_REALTIME_EFFECT_MANAGER__
 #define __AUDACITY_REALTIME_EFFECT_MANAGER__
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <wx/thread.h>
 
 class EffectClientInterface;
 class RealtimeEffectState;
+class wxString;
 
 class AUDACITY_DLL_API RealtimeEffectManager final
 {
@@ -37,19 +39,36 @@ public:
    void RealtimeFinalize();
    void RealtimeSuspend();
    void RealtimeResume();
+   //! Post a parameter snapshot for an effect in the active chain; the
+   //! audio thread adopts it at the next buffer boundary, so the chain
+   //! need not be suspended.  Returns false if the effect is not in the
+   //! chain or the parameters do not validate, and nothing was posted.
+   bool RealtimeSetEffectParameters(
+      EffectClientInterface *effect, const wxString &parms);
    void RealtimeProcessStart();
    size_t RealtimeProcess(int group, unsigned chans, float **buffers, size_t numSamples);
    void RealtimeProcessEnd();
    int GetRealtimeLatency();
 
+   //! Incremented whenever the membership of the chain changes; lets
+   //! caches of rendered audio (see TrackFreeze) notice staleness
+   int GetStatesVersion() const { return mStatesVersion; }
+
 private:
    RealtimeEffectManager();
    ~RealtimeEffectManager();
 
+   // Serializes the main-thread mutators among themselves; the audio
+   // thread never takes it.  See RealtimeSuspend and RealtimeProcessStart.
    wxCriticalSection mRealtimeLock;
    std::vector< std::unique_ptr<RealtimeEffectState> > mStates;
+   int mStatesVersion{ 0 };
    int mRealtimeLatency;
-   bool mRealtimeSuspended;
+   std::atomic<bool> mRealtimeSuspended;
+   // Nonzero while the audio thread is inside a processing pass
+   std::atomic<int> mRealtimeProcessCount{ 0 };
+   // Used by the audio thread only, between ProcessStart and ProcessEnd
+   bool mProcessingPass{ false };
    bool mRealtimeActive;
    std::vector<unsigned> mRealtimeChans;
    std::vector<double> mRealtimeRates;
@@ -137,15 +137,36 @@ bool EffectRepeat::Process()
             return;
 
          auto dest = track->Copy(mT0, mT1);
-         for(int j=0; j<repeatCount; j++)
+
+         // Rather than paste the selection repeatCount times over, paste
+         // pieces in binary progression, doubling the piece between the
+         // pastes.  Sequence::Paste shares references to whole interior
+         // blocks and rewrites only the seams, so the number of pastes,
+         // not the amount of audio, dictates how much is written to disk;
+         // this way the disk cost grows with the logarithm of the count.
+         int bits = 0;
+         for (int n = repeatCount; n > 0; n >>= 1)
+            ++bits;
+         int step = 0;
+         double destLen = tLen;
+         for (int remaining = repeatCount; remaining > 0; remaining >>= 1)
          {
-            if (TrackProgress(nTrack, j / repeatCount)) // TrackProgress returns true on Cancel.
+            if (TrackProgress(nTrack, step++ / (double)bits)) // TrackProgress returns true on Cancel.
             {
                bGoodResult = false;
                return;
             }
-            track->Paste(tc, dest.get());
-            tc += tLen;
+            if (remaining & 1)
+            {
+               track->Paste(tc, dest.get());
+               tc += destLen;
+            }
+            if (remaining > 1)
+            {
+               auto twice = dest->Copy(0.0, destLen);
+               dest->Paste(destLen, twice.get());
+               destLen *= 2.0;
+            }
          }
          if (tc > maxDestLen)
             maxDestLen = tc;
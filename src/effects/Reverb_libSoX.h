@@ -23,6 +23,14 @@
 using std::min;
 using std::max;
 
+// Running the parallel comb lines four at a time gives a useful speedup on
+// the most common desktop processors.
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define REVERB_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
 #define array_length(a) (sizeof(a)/sizeof(a[0]))
 #define dB_to_linear(x) exp((x) * M_LN10 * 0.05)
 #define midi_to_freq(n) (440 * pow(2,((n)-69)/12.))
@@ -182,6 +190,60 @@ static void filter_array_process(filter_array_t * p,
       size_t length, float const * input, float * output,
       float const * feedback, float const * hf_damping, float const * gain)
 {
+#ifdef REVERB_USE_SSE2
+   /* The eight parallel comb lines run four at a time in SSE lanes.  Each
+      lane performs the same operation sequence as comb_process, so results
+      stay bit-identical; only the delay-line loads and stores stay scalar,
+      because the lines have unequal lengths.  The allpass filters are
+      chained, not parallel, and remain scalar below. */
+   float stores[array_length(comb_lengths)];
+   float outs[array_length(comb_lengths)], news[array_length(comb_lengths)];
+   size_t i;
+
+   for (i = 0; i < array_length(comb_lengths); ++i)
+      stores[i] = p->comb[i].store;
+   __m128 store0 = _mm_loadu_ps(stores);
+   __m128 store4 = _mm_loadu_ps(stores + 4);
+   const __m128 damp = _mm_set1_ps(*hf_damping);
+   const __m128 fb = _mm_set1_ps(*feedback);
+
+   while (length--) {
+      float out = 0, in = *input++;
+
+      for (i = 0; i < array_length(comb_lengths); ++i)
+         outs[i] = *p->comb[i].ptr;
+      const __m128 out0 = _mm_loadu_ps(outs);
+      const __m128 out4 = _mm_loadu_ps(outs + 4);
+      store0 = _mm_add_ps(out0, _mm_mul_ps(_mm_sub_ps(store0, out0), damp));
+      store4 = _mm_add_ps(out4, _mm_mul_ps(_mm_sub_ps(store4, out4), damp));
+      const __m128 in4 = _mm_set1_ps(in);
+      _mm_storeu_ps(news, _mm_add_ps(in4, _mm_mul_ps(store0, fb)));
+      _mm_storeu_ps(news + 4, _mm_add_ps(in4, _mm_mul_ps(store4, fb)));
+      for (i = 0; i < array_length(comb_lengths); ++i) {
+         filter_t * pcomb = &p->comb[i];
+         *pcomb->ptr = news[i];
+         filter_advance(pcomb);
+      }
+
+      /* Sum the comb outputs in the same descending order as before */
+      i = array_length(comb_lengths) - 1;
+      do out += outs[i];
+      while (i--);
+
+      i = array_length(allpass_lengths) - 1;
+      do out = allpass_process(p->allpass + i, &out);
+      while (i--);
+
+      out = one_pole_process(&p->one_pole[0], out);
+      out = one_pole_process(&p->one_pole[1], out);
+      *output++ = out * *gain;
+   }
+
+   _mm_storeu_ps(stores, store0);
+   _mm_storeu_ps(stores + 4, store4);
+   for (i = 0; i < array_length(comb_lengths); ++i)
+      p->comb[i].store = stores[i];
+#else
    while (length--) {
       float out = 0, in = *input++;
 
@@ -197,6 +259,7 @@ static void filter_array_process(filter_array_t * p,
       out = one_pole_process(&p->one_pole[1], out);
       *output++ = out * *gain;
    }
+#endif
 }
 
 static void filter_array_delete(filter_array_t * p)
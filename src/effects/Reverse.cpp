@@ -22,6 +22,7 @@
 #include <wx/intl.h>
 
 #include "../LabelTrack.h"
+#include "../Sequence.h"
 #include "../WaveClip.h"
 #include "../WaveTrack.h"
 
@@ -166,7 +167,21 @@ bool EffectReverse::ProcessOneWave(int count, WaveTrack * track, sampleCount sta
          auto revEnd = (clipEnd >= end)? end: clipEnd;
          auto revLen = revEnd - revStart;
          if (revEnd >= revStart) {
-            if(!ProcessOneClip(count, track, revStart, revLen, start, end)) // reverse the clip
+            if (revStart == clipStart && revEnd == clipEnd) {
+               // The splits of step 1 left the clip wholly inside the
+               // selection, so its sequence can reverse in one
+               // block-level pass, sharing silent blocks and writing
+               // each other block just once
+               clip->GetSequence()->Reverse();
+               clip->MarkChanged();
+               if (TrackProgress(count,
+                  (revEnd - start).as_double() / (end - start).as_double()))
+               {
+                  rValue = false;
+                  break;
+               }
+            }
+            else if(!ProcessOneClip(count, track, revStart, revLen, start, end)) // reverse the clip
             {
                rValue = false;
                break;
@@ -16,8 +16,15 @@ effect that uses SBSMS to do its processing (TimeScale)
 #if USE_SBSMS
 #include "SBSMSEffect.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include <math.h>
 
+#include <wx/utils.h>
+
 #include "../LabelTrack.h"
 #include "../WaveTrack.h"
 #include "TimeWarper.h"
@@ -63,6 +70,39 @@ public:
    std::exception_ptr mpException {};
 };
 
+// One per-track rendering task for the worker threads of
+// EffectSBSMS::Process.  A worker runs the whole stateful SBSMS pipeline of
+// its track and deposits the dis-interleaved result chunks into a small
+// ring, which the main thread alone drains into the output tracks.
+struct RenderJob
+{
+   enum : size_t { RingSize = 32 };
+
+   struct Chunk
+   {
+      float left[2 * SBSMSOutBlockSize];
+      float right[2 * SBSMSOutBlockSize];
+      size_t count;
+   };
+
+   WaveTrack *leftTrack{};
+   WaveTrack *rightTrack{};
+   sampleCount start, end;
+   double curT0, curT1;
+   double warperDuration;
+   double outSamplesEstimate;
+
+   // Created and appended to on the main thread only
+   std::shared_ptr<WaveTrack> outputLeftTrack, outputRightTrack;
+
+   ArrayOf<Chunk> ring{ RingSize };
+   std::atomic<size_t> head{ 0 }, tail{ 0 };
+   std::atomic<bool> done{ false };
+   long pos = 0;
+
+   std::exception_ptr mpException {};
+};
+
 class SBSMSEffectInterface final : public SBSMSInterfaceSliding {
 public:
    SBSMSEffectInterface(Resampler *resampler,
@@ -225,6 +265,10 @@ bool EffectSBSMS::Process()
    Slide pitchSlide(pitchSlideType,pitchStart,pitchEnd);
    mTotalStretch = rateSlide.getTotalStretch();
 
+   // Per-track rendering tasks, collected during the visit below and then
+   // run concurrently
+   std::vector<std::unique_ptr<RenderJob>> jobs;
+
    mOutputTracks->Leaders().VisitWhile( bGoodResult,
       [&](LabelTrack *lt, const Track::Fallthrough &fallthrough) {
          if (!(lt->GetSelected() || (mustSync && lt->IsSyncLockSelected())))
@@ -272,6 +316,64 @@ bool EffectSBSMS::Process()
 
                mCurTrackNum++; // Increment for rightTrack, too.
             }
+
+            // Collect a job for the worker threads below; output tracks are
+            // created (and later appended to) on this thread only
+            auto job = std::make_unique<RenderJob>();
+            job->leftTrack = leftTrack;
+            job->rightTrack = rightTrack;
+            job->start = start;
+            job->end = end;
+            job->curT0 = mCurT0;
+            job->curT1 = mCurT1;
+
+            // Duration in track time
+            double duration =  (mCurT1-mCurT0) * mTotalStretch;
+
+            if(duration > maxDuration)
+               maxDuration = duration;
+            job->warperDuration = maxDuration;
+
+            // Only for the progress meter; the exact output length is not
+            // known until the SBSMS interface for the track exists
+            job->outSamplesEstimate =
+               std::max(1.0, duration * leftTrack->GetRate());
+
+            job->outputLeftTrack = mFactory->NewWaveTrack(leftTrack->GetSampleFormat(),
+                                                          leftTrack->GetRate());
+            if(rightTrack)
+               job->outputRightTrack = mFactory->NewWaveTrack(rightTrack->GetSampleFormat(),
+                                                              rightTrack->GetRate());
+
+            jobs.push_back(std::move(job));
+         }
+         mCurTrackNum++;
+      },
+      [&](Track *t) {
+         if (mustSync && t->IsSyncLockSelected())
+         {
+            t->SyncLockAdjust(mCurT1, mCurT0 + (mCurT1 - mCurT0) * mTotalStretch);
+         }
+      }
+   );
+
+   if (bGoodResult && !jobs.empty()) {
+      std::atomic<bool> abort{ false };
+
+      // The whole stateful pipeline of one track -- resampler, SBSMS,
+      // resampler -- runs on one worker; result chunks go into the job's
+      // ring for the main thread to append
+      auto renderJob = [&](RenderJob &job) {
+         try {
+            WaveTrack *const leftTrack = job.leftTrack;
+            WaveTrack *const rightTrack = job.rightTrack;
+            const auto start = job.start;
+            const auto end = job.end;
+
+            // The slides hold per-pipeline state, so make this worker its own
+            Slide rateSlide(rateSlideType,rateStart,rateEnd);
+            Slide pitchSlide(pitchSlideType,pitchStart,pitchEnd);
+
             const auto trackStart =
                leftTrack->TimeToLongSamples(leftTrack->GetStartTime());
             const auto trackEnd =
@@ -315,7 +417,7 @@ bool EffectSBSMS::Process()
                    static_cast<_sbsms_::SampleCountType>
                       ( samplesToProcess.as_long_long() ),
                    0, nullptr);
-               
+
             }
             else {
               rb.bPitch = false;
@@ -353,12 +455,10 @@ bool EffectSBSMS::Process()
                    static_cast<long> ( processPresamples.as_long_long() ),
                    rb.quality.get());
             }
-            
+
             Resampler resampler(outResampleCB,&rb,outSlideType);
 
             audio outBuf[SBSMSOutBlockSize];
-            float outBufLeft[2*SBSMSOutBlockSize];
-            float outBufRight[2*SBSMSOutBlockSize];
 
             // Samples in output after SBSMS
             sampleCount samplesToOutput = rb.iface->getSamplesToOutput();
@@ -366,83 +466,123 @@ bool EffectSBSMS::Process()
             // Samples in output after resampling back
             auto samplesOut = (sampleCount) (samplesToOutput.as_float() * (srTrack/srProcess));
 
-            // Duration in track time
-            double duration =  (mCurT1-mCurT0) * mTotalStretch;
-
-            if(duration > maxDuration)
-               maxDuration = duration;
-
-            auto warper = createTimeWarper(mCurT0,mCurT1,maxDuration,rateStart,rateEnd,rateSlideType);
-
-            rb.outputLeftTrack = mFactory->NewWaveTrack(leftTrack->GetSampleFormat(),
-                                                        leftTrack->GetRate());
-            if(rightTrack)
-               rb.outputRightTrack = mFactory->NewWaveTrack(rightTrack->GetSampleFormat(),
-                                                            rightTrack->GetRate());
             long pos = 0;
             long outputCount = -1;
 
             // process
-            while(pos<samplesOut && outputCount) {
+            while(pos<samplesOut && outputCount && !abort.load()) {
                const auto frames =
                   limitSampleBufferSize( SBSMSOutBlockSize, samplesOut - pos );
 
+               // Wait for a free slot in the ring; the main thread drains it
+               while (job.head.load() - job.tail.load() >= RenderJob::RingSize
+                      && !abort.load())
+                  wxMilliSleep(10);
+               if (abort.load())
+                  break;
+               auto &chunk = job.ring[job.head.load() % RenderJob::RingSize];
+
                outputCount = resampler.read(outBuf,frames);
                for(int i = 0; i < outputCount; i++) {
-                  outBufLeft[i] = outBuf[i][0];
+                  chunk.left[i] = outBuf[i][0];
                   if(rightTrack)
-                     outBufRight[i] = outBuf[i][1];
+                     chunk.right[i] = outBuf[i][1];
                }
+               chunk.count = outputCount;
                pos += outputCount;
-               rb.outputLeftTrack->Append((samplePtr)outBufLeft, floatSample, outputCount);
-               if(rightTrack)
-                  rb.outputRightTrack->Append((samplePtr)outBufRight, floatSample, outputCount);
-
-               double frac = (double)pos / samplesOut.as_double();
-               int nWhichTrack = mCurTrackNum;
-               if(rightTrack) {
-                  nWhichTrack = 2*(mCurTrackNum/2);
-                  if (frac < 0.5)
-                     frac *= 2.0; // Show twice as far for each track, because we're doing 2 at once.
-                  else {
-                     nWhichTrack++;
-                     frac -= 0.5;
-                     frac *= 2.0; // Show twice as far for each track, because we're doing 2 at once.
-                  }
-               }
-               if (TrackProgress(nWhichTrack, frac)) {
-                  bGoodResult = false;
-                  return;
-               }
+               ++job.head;
             }
 
-            {
-               auto pException = rb.mpException;
+            if (rb.mpException) {
+               job.mpException = rb.mpException;
                rb.mpException = {};
-               if (pException)
-                  std::rethrow_exception(pException);
+               abort.store(true);
             }
+         }
+         catch ( ... ) {
+            // Save the exception object for re-throw on the main thread
+            job.mpException = std::current_exception();
+            abort.store(true);
+         }
+         job.done.store(true);
+      };
+
+      std::atomic<size_t> nextJob{ 0 };
+      const auto numWorkers = std::min<size_t>(jobs.size(),
+         std::max(1u, std::thread::hardware_concurrency()));
+      std::vector<std::thread> threads;
+      for (size_t ww = 0; ww < numWorkers; ww++)
+         threads.emplace_back([&]{
+            size_t jj;
+            while ((jj = nextJob++) < jobs.size() && !abort.load())
+               renderJob(*jobs[jj]);
+         });
+
+      // Drain the rings on this thread, which alone may append to the
+      // output tracks and poll the progress dialog
+      double totalOutEstimate = 0.0;
+      for (auto &pJob : jobs)
+         totalOutEstimate += pJob->outSamplesEstimate;
+
+      bool pending = true;
+      while (pending && bGoodResult) {
+         pending = false;
+         double donePos = 0.0;
+         for (auto &pJob : jobs) {
+            auto &job = *pJob;
+            const bool done = job.done.load();
+            while (job.tail.load() < job.head.load()) {
+               auto &chunk = job.ring[job.tail.load() % RenderJob::RingSize];
+               job.outputLeftTrack->Append((samplePtr)chunk.left, floatSample, chunk.count);
+               if(job.rightTrack)
+                  job.outputRightTrack->Append((samplePtr)chunk.right, floatSample, chunk.count);
+               job.pos += chunk.count;
+               ++job.tail;
+            }
+            donePos += job.pos;
+            if (!(done && job.tail.load() == job.head.load()))
+               pending = true;
+         }
+         if (TotalProgress(std::min(1.0, donePos / totalOutEstimate))) {
+            bGoodResult = false;
+            abort.store(true);
+         }
+         if (pending && bGoodResult)
+            wxMilliSleep(50);
+      }
 
-            rb.outputLeftTrack->Flush();
-            if(rightTrack)
-               rb.outputRightTrack->Flush();
+      for (auto &thread : threads)
+         thread.join();
 
-            leftTrack->ClearAndPaste(mCurT0, mCurT1, rb.outputLeftTrack.get(),
-                                     true, false, warper.get());
+      // Now that all workers have finished, re-throw any exception that
+      // stopped one of them
+      for (auto &pJob : jobs) {
+         auto pException = pJob->mpException;
+         pJob->mpException = {};
+         if (pException)
+            std::rethrow_exception(pException);
+      }
 
-            if(rightTrack)
-               rightTrack->ClearAndPaste(mCurT0, mCurT1, rb.outputRightTrack.get(),
+      if (bGoodResult) {
+         for (auto &pJob : jobs) {
+            auto &job = *pJob;
+
+            auto warper = createTimeWarper(job.curT0,job.curT1,job.warperDuration,
+                                           rateStart,rateEnd,rateSlideType);
+
+            job.outputLeftTrack->Flush();
+            if(job.rightTrack)
+               job.outputRightTrack->Flush();
+
+            job.leftTrack->ClearAndPaste(job.curT0, job.curT1, job.outputLeftTrack.get(),
                                          true, false, warper.get());
-         }
-         mCurTrackNum++;
-      },
-      [&](Track *t) {
-         if (mustSync && t->IsSyncLockSelected())
-         {
-            t->SyncLockAdjust(mCurT1, mCurT0 + (mCurT1 - mCurT0) * mTotalStretch);
+
+            if(job.rightTrack)
+               job.rightTrack->ClearAndPaste(job.curT0, job.curT1, job.outputRightTrack.get(),
+                                             true, false, warper.get());
          }
       }
-   );
+   }
 
    if (bGoodResult) {
       ReplaceProcessedTracks(bGoodResult);
@@ -232,14 +232,8 @@ bool EffectScienFilter::ProcessInitialize(sampleCount WXUNUSED(totalLen), Channe
 
 size_t EffectScienFilter::ProcessBlock(float **inBlock, float **outBlock, size_t blockLen)
 {
-   float *ibuf = inBlock[0];
-   for (int iPair = 0; iPair < (mOrder + 1) / 2; iPair++)
-   {
-      mpBiquad[iPair].pfIn = ibuf;
-      mpBiquad[iPair].pfOut = outBlock[0];
-      mpBiquad[iPair].Process(blockLen);
-      ibuf = outBlock[0];
-   }
+   Biquad::ProcessCascade(mpBiquad.get(), (mOrder + 1) / 2,
+      inBlock[0], outBlock[0], blockLen);
 
    return blockLen;
 }
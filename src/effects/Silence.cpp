@@ -101,6 +101,9 @@ bool EffectSilence::GenerateTrack(WaveTrack *tmp,
                                   const WaveTrack & WXUNUSED(track),
                                   int WXUNUSED(ntrack))
 {
+   // Metadata only:  InsertSilence builds the sequence from
+   // SilentBlockFiles, which store no samples on disk, so generating
+   // even hours of silence is immediate
    tmp->InsertSilence(0.0, GetDuration());
    return true;
 }
@@ -25,6 +25,7 @@
 #include "../WaveTrack.h"
 
 #include <math.h>
+#include <future>
 
 bool EffectSimpleMono::Process()
 {
@@ -82,33 +83,50 @@ bool EffectSimpleMono::ProcessOne(WaveTrack * track,
    //to make it a double now than it is to do it later
    auto len = (end - start).as_double();
 
-   //Initiate a processing buffer.  This buffer will (most likely)
-   //be shorter than the length of the track being processed.
-   Floats buffer{ track->GetMaxBlockSize() };
+   //Initiate two processing buffers, so that the read of the next
+   //block can overlap the processing of the current one.  Each buffer
+   //will (most likely) be shorter than the length of the track being
+   //processed.
+   Floats buffer1{ track->GetMaxBlockSize() };
+   Floats buffer2{ track->GetMaxBlockSize() };
 
    //Go through the track one buffer at a time. s counts which
    //sample the current buffer starts at.
    auto s = start;
-   while (s < end) {
-      //Get a block of samples (smaller than the size of the buffer)
-      //Adjust the block size if it is the final block in the track
-      const auto block =
-         limitSampleBufferSize( track->GetBestBlockSize(s), end - s );
-
-      //Get the samples from the track and put them in the buffer
-      track->Get((samplePtr) buffer.get(), floatSample, s, block);
+   auto block = limitSampleBufferSize( track->GetBestBlockSize(s), end - s );
+   track->Get((samplePtr) buffer1.get(), floatSample, s, block);
 
-      //Process the buffer.  If it fails, clean up and exit.
-      if (!ProcessSimpleMono(buffer.get(), block))
+   while (s < end) {
+      //Start reading the next block on a worker while this one is
+      //processed.  The worker only reads the track, and is joined
+      //below, before Set modifies it.
+      const auto nextS = s + block;
+      const auto nextBlock = nextS < end
+         ? limitSampleBufferSize( track->GetBestBlockSize(nextS), end - nextS )
+         : 0;
+      std::future<void> pending;
+      if (nextBlock > 0)
+         pending = std::async(std::launch::async, [=, &buffer2] {
+            track->Get((samplePtr) buffer2.get(), floatSample, nextS, nextBlock);
+         });
+
+      //Process the buffer.
+      const bool good = ProcessSimpleMono(buffer1.get(), block);
+
+      if (pending.valid())
+         pending.get();
+      if (!good)
          //Return false because the effect failed.
          return false;
 
       //Processing succeeded. copy the newly-changed samples back
       //onto the track.
-      track->Set((samplePtr) buffer.get(), floatSample, s, block);
+      track->Set((samplePtr) buffer1.get(), floatSample, s, block);
 
       //Increment s one blockfull of samples
-      s += block;
+      s = nextS;
+      block = nextBlock;
+      buffer1.swap(buffer2);
 
       //Update the Progress meter
       if (TrackProgress(mCurTrackNum,
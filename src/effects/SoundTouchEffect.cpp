@@ -179,6 +179,22 @@ bool EffectSoundTouch::ProcessWithTimeWarper(const TimeWarper &warper)
 void EffectSoundTouch::End()
 {
    mSoundTouch.reset();
+
+   mReceiveBuffer.reset();
+   mLeftBuffer.reset();
+   mRightBuffer.reset();
+   mReceiveLen = 0;
+}
+
+void EffectSoundTouch::ResizeReceiveBuffers(size_t outputCount)
+{
+   if (mReceiveLen < outputCount) {
+      mReceiveLen = outputCount;
+      // Room for an interleaved stereo pair per sample; mono uses only half
+      mReceiveBuffer.reinit(mReceiveLen * 2);
+      mLeftBuffer.reinit(mReceiveLen);
+      mRightBuffer.reinit(mReceiveLen);
+   }
 }
 
 //ProcessOne() takes a track, transforms it to bunch of buffer-blocks,
@@ -216,11 +232,13 @@ bool EffectSoundTouch::ProcessOne(WaveTrack *track,
          mSoundTouch->putSamples(buffer.get(), block);
 
          //Get back samples from SoundTouch
+         //Mono samples come back as plain floats, so they pass through the
+         //reused receive buffer with no interleaving step
          unsigned int outputCount = mSoundTouch->numSamples();
          if (outputCount > 0) {
-            Floats buffer2{ outputCount };
-            mSoundTouch->receiveSamples(buffer2.get(), outputCount);
-            outputTrack->Append((samplePtr)buffer2.get(), floatSample, outputCount);
+            ResizeReceiveBuffers(outputCount);
+            mSoundTouch->receiveSamples(mReceiveBuffer.get(), outputCount);
+            outputTrack->Append((samplePtr)mReceiveBuffer.get(), floatSample, outputCount);
          }
 
          //Increment s one blockfull of samples
@@ -236,9 +254,9 @@ bool EffectSoundTouch::ProcessOne(WaveTrack *track,
 
       unsigned int outputCount = mSoundTouch->numSamples();
       if (outputCount > 0) {
-         Floats buffer2{ outputCount };
-         mSoundTouch->receiveSamples(buffer2.get(), outputCount);
-         outputTrack->Append((samplePtr)buffer2.get(), floatSample, outputCount);
+         ResizeReceiveBuffers(outputCount);
+         mSoundTouch->receiveSamples(mReceiveBuffer.get(), outputCount);
+         outputTrack->Append((samplePtr)mReceiveBuffer.get(), floatSample, outputCount);
       }
 
       // Flush the output WaveTrack (since it's buffered, too)
@@ -363,20 +381,18 @@ bool EffectSoundTouch::ProcessStereoResults(const size_t outputCount,
                                             WaveTrack* outputLeftTrack,
                                             WaveTrack* outputRightTrack)
 {
-   Floats outputSoundTouchBuffer{ outputCount * 2 };
-   mSoundTouch->receiveSamples(outputSoundTouchBuffer.get(), outputCount);
+   ResizeReceiveBuffers(outputCount);
+   mSoundTouch->receiveSamples(mReceiveBuffer.get(), outputCount);
 
-   // Dis-interleave outputSoundTouchBuffer into separate track buffers.
-   Floats outputLeftBuffer{ outputCount };
-   Floats outputRightBuffer{ outputCount };
+   // Dis-interleave the receive buffer into the separate track buffers.
    for (unsigned int index = 0; index < outputCount; index++)
    {
-      outputLeftBuffer[index] = outputSoundTouchBuffer[index*2];
-      outputRightBuffer[index] = outputSoundTouchBuffer[(index*2)+1];
+      mLeftBuffer[index] = mReceiveBuffer[index*2];
+      mRightBuffer[index] = mReceiveBuffer[(index*2)+1];
    }
 
-   outputLeftTrack->Append((samplePtr)outputLeftBuffer.get(), floatSample, outputCount);
-   outputRightTrack->Append((samplePtr)outputRightBuffer.get(), floatSample, outputCount);
+   outputLeftTrack->Append((samplePtr)mLeftBuffer.get(), floatSample, outputCount);
+   outputRightTrack->Append((samplePtr)mRightBuffer.get(), floatSample, outputCount);
 
    return true;
 }
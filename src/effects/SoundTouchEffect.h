@@ -68,10 +68,17 @@ private:
    bool ProcessStereoResults(const size_t outputCount,
                               WaveTrack* outputLeftTrack,
                               WaveTrack* outputRightTrack);
+   //grow the conversion buffers below to hold outputCount samples per channel
+   void ResizeReceiveBuffers(size_t outputCount);
 
    int    mCurTrackNum;
 
    double m_maxNewLength;
+
+   // Conversion buffers for samples received back from SoundTouch, reused
+   // across chunks and tracks rather than reallocated for every chunk
+   Floats mReceiveBuffer, mLeftBuffer, mRightBuffer;
+   size_t mReceiveLen{ 0 };
 };
 
 #endif
@@ -123,6 +123,21 @@ bool EffectStereoToMono::Process()
 
 bool EffectStereoToMono::ProcessOne(int count)
 {
+   // Fast path: when the two channels are duplicates -- as after a mono
+   // track was made stereo, or a dual-mono file was imported -- their
+   // average equals either channel, so keep the left channel's blocks
+   // unchanged instead of rendering.  Equal content hashes identify
+   // channels that share block files; see WaveTrack::GetContentHash.
+   // The hash says nothing about envelopes, and the rendering path
+   // discards them, so take this path only when both are trivial.
+   if (mLeftTrack->GetContentHash() == mRightTrack->GetContentHash() &&
+       mLeftTrack->HasTrivialEnvelope() &&
+       mRightTrack->HasTrivialEnvelope()) {
+      mOutputTracks->GroupChannels( *mLeftTrack, 1 );
+      mOutputTracks->Remove(mRightTrack);
+      return true;
+   }
+
    float  curLeftFrame;
    float  curRightFrame;
    float  curMonoFrame;
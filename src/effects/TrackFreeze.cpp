@@ -0,0 +1,193 @@
+/**********************************************************************
+
+ Audacity: A Digital Audio Editor
+
+ TrackFreeze.cpp
+
+ *******************************************************************//**
+
+\class TrackFreeze
+\brief Pre-renders tracks through the realtime effect chain so playback
+can read the rendered audio instead of recomputing heavy chains live.
+
+*//*******************************************************************/
+
+#include "../Audacity.h"
+#include "TrackFreeze.h"
+
+#include <cstring>
+#include <wx/intl.h>
+
+#include "RealtimeEffectManager.h"
+#include "../Mix.h"
+#include "../WaveClip.h"
+#include "../WaveTrack.h"
+#include "../widgets/ProgressDialog.h"
+
+TrackFreeze &TrackFreeze::Get()
+{
+   static TrackFreeze cache;
+   return cache;
+}
+
+std::vector<double> TrackFreeze::Fingerprint(const WaveTrack &track)
+{
+   // The content hash catches any edit of the samples, including
+   // destructive effects that leave the clip boundaries alone; the
+   // boundaries and rate are listed besides to catch moves and trims
+   std::vector<double> result;
+   result.push_back(track.GetRate());
+   const auto hash = track.GetContentHash();
+   result.push_back(double(hash & 0xffffffff));
+   result.push_back(double(hash >> 32));
+   for (const auto &clip : track.GetClips()) {
+      result.push_back(clip->GetStartTime());
+      result.push_back(clip->GetEndTime());
+   }
+   return result;
+}
+
+bool TrackFreeze::Freeze(AudacityProject &project, WaveTrack &leader)
+{
+   auto &em = RealtimeEffectManager::Get();
+
+   // An empty chain would render a mere copy; nothing worth caching
+   if (!em.RealtimeIsActive())
+      return false;
+
+   const auto channels = TrackList::Channels(&leader);
+   const unsigned nChans = channels.size();
+   const double rate = leader.GetRate();
+
+   // One common span for all channels so they stay sample aligned
+   double startTime = 0.0, endTime = 0.0;
+   bool first = true;
+   for (auto channel : channels) {
+      if (first) {
+         startTime = channel->GetStartTime();
+         endTime = channel->GetEndTime();
+         first = false;
+      }
+      else {
+         startTime = std::min(startTime, channel->GetStartTime());
+         endTime = std::max(endTime, channel->GetEndTime());
+      }
+   }
+   if (endTime <= startTime)
+      return false;
+
+   const auto maxBlockLen = leader.GetIdealBlockSize();
+
+   // One mono mixer per channel, as in playback, so that the chain sees
+   // the channels of a group together in a single processor group.
+   // The mixers apply clip envelopes only; gain and pan stay live in the
+   // audio callback, which keeps reading them from the source track.
+   std::vector< std::unique_ptr<Mixer> > mixers;
+   std::vector< std::shared_ptr<WaveTrack> > shadows;
+   auto &trackFactory = TrackFactory::Get( project );
+   for (auto channel : channels) {
+      WaveTrackConstArray mixTracks;
+      mixTracks.push_back(channel->SharedPointer< const WaveTrack >());
+      mixers.push_back(std::make_unique<Mixer>(mixTracks,
+         // Don't throw for read errors, just render silence:
+         false,
+         // Unwarped; the playback mixer warps the shadow as it would
+         // have warped the source
+         Mixer::WarpOptions{ nullptr },
+         startTime, endTime, 1, maxBlockLen, false,
+         rate, floatSample));
+      mixers.back()->ApplyTrackGains(false);
+
+      auto shadow = trackFactory.NewWaveTrack(floatSample, rate);
+      shadow->SetOffset(startTime);
+      shadows.push_back(std::move(shadow));
+   }
+
+   Floats temps{ nChans * maxBlockLen };
+   std::vector<float*> bufs(nChans);
+   for (unsigned c = 0; c < nChans; c++)
+      bufs[c] = temps.get() + c * maxBlockLen;
+
+   // Drive the chain offline the same way the audio callback does:
+   // initialize, one processor group of nChans channels, then bracketed
+   // processing passes
+   em.RealtimeInitialize(rate);
+   em.RealtimeAddProcessor(0, nChans, rate);
+
+   auto updateResult = ProgressResult::Success;
+   {
+      ProgressDialog progress(_("Freeze Track"),
+         _("Rendering the track through the effect chain"));
+
+      while (updateResult == ProgressResult::Success) {
+         size_t maxLen = 0;
+         for (unsigned c = 0; c < nChans; c++) {
+            auto blockLen = mixers[c]->Process(maxBlockLen);
+            memcpy(bufs[c], mixers[c]->GetBuffer(),
+               blockLen * sizeof(float));
+            // Pad to the longest channel, as the playback path does
+            for (size_t i = blockLen; i < maxBlockLen; i++)
+               bufs[c][i] = 0;
+            maxLen = std::max(maxLen, blockLen);
+         }
+         if (maxLen == 0)
+            break;
+
+         em.RealtimeProcessStart();
+         em.RealtimeProcess(0, nChans, bufs.data(), maxLen);
+         em.RealtimeProcessEnd();
+
+         for (unsigned c = 0; c < nChans; c++)
+            shadows[c]->Append(
+               (samplePtr)bufs[c], floatSample, maxLen);
+
+         updateResult = progress.Update(
+            mixers[0]->MixGetCurrentTime() - startTime,
+            endTime - startTime);
+      }
+   }
+
+   em.RealtimeFinalize();
+
+   if (updateResult == ProgressResult::Cancelled ||
+       updateResult == ProgressResult::Failed)
+      return false;
+
+   for (auto &shadow : shadows)
+      shadow->Flush();
+
+   const int version = em.GetStatesVersion();
+   unsigned c = 0;
+   for (auto channel : channels)
+      mEntries[channel] =
+         Entry{ shadows[c++], version, Fingerprint(*channel) };
+
+   return true;
+}
+
+void TrackFreeze::Thaw(const WaveTrack *pTrack)
+{
+   mEntries.erase(pTrack);
+}
+
+void TrackFreeze::ThawAll()
+{
+   mEntries.clear();
+}
+
+std::shared_ptr<WaveTrack> TrackFreeze::Frozen(const WaveTrack *pTrack)
+{
+   auto it = mEntries.find(pTrack);
+   if (it == mEntries.end())
+      return {};
+
+   auto &entry = it->second;
+   if (entry.chainVersion != RealtimeEffectManager::Get().GetStatesVersion()
+       || entry.fingerprint != Fingerprint(*pTrack)) {
+      // Stale; drop it now so its storage can be reclaimed
+      mEntries.erase(it);
+      return {};
+   }
+
+   return entry.frozen;
+}
@@ -0,0 +1,68 @@
+/**********************************************************************
+
+ Audacity: A Digital Audio Editor
+
+ TrackFreeze.h
+
+ **********************************************************************/
+
+#ifndef __AUDACITY_TRACK_FREEZE__
+#define __AUDACITY_TRACK_FREEZE__
+
+#include <map>
+#include <memory>
+#include <vector>
+
+class AudacityProject;
+class WaveTrack;
+
+/**********************************************************************//**
+
+\class TrackFreeze
+\brief Cache of tracks pre-rendered ("frozen") through the active
+realtime effect chain.
+
+Heavy realtime chains can cost more than one audio callback budget per
+track.  Freezing renders a track's channels through the chain once,
+offline, into shadow tracks; AudioIO then feeds the shadow audio to the
+playback mixers and skips RealtimeProcess() for that track.  A frozen
+rendering silently goes stale -- and is discarded on the next lookup --
+when the chain membership changes or the track's clips are edited.
+
+**************************************************************************/
+class TrackFreeze final
+{
+public:
+   /** Get the singleton instance of the TrackFreeze cache. **/
+   static TrackFreeze &Get();
+
+   //! Render all channels of the leader track's group through the active
+   //! realtime effect chain; returns false if cancelled or nothing to do.
+   //! Must not be called while an audio stream is active.
+   bool Freeze(AudacityProject &project, WaveTrack &leader);
+
+   //! Discard the frozen rendering of one channel track, or of every track
+   void Thaw(const WaveTrack *pTrack);
+   void ThawAll();
+
+   //! The pre-rendered substitute for the given channel track, or null if
+   //! there is none or it went stale since it was rendered
+   std::shared_ptr<WaveTrack> Frozen(const WaveTrack *pTrack);
+
+private:
+   TrackFreeze() = default;
+
+   // Clip boundaries and rate at render time; a mismatch later means the
+   // track was edited and the rendering must be discarded
+   static std::vector<double> Fingerprint(const WaveTrack &track);
+
+   struct Entry {
+      std::shared_ptr<WaveTrack> frozen;
+      int chainVersion;
+      std::vector<double> fingerprint;
+   };
+
+   std::map< const WaveTrack*, Entry > mEntries;
+};
+
+#endif
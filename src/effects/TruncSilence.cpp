@@ -22,11 +22,15 @@
 #include <list>
 #include <limits>
 #include <math.h>
+#include <thread>
+#include <vector>
 
 #include <wx/checkbox.h>
 #include <wx/choice.h>
+#include <wx/utils.h>
 #include <wx/valgen.h>
 
+#include "../AudacityException.h"
 #include "../Prefs.h"
 #include "../Project.h"
 #include "../ProjectSettings.h"
@@ -245,17 +249,13 @@ double EffectTruncSilence::CalcPreviewInputLength(double /* previewLength */)
    // Start with the whole selection silent
    silences.push_back(Region(mT0, mT1));
 
-   int whichTrack = 0;
-
    for (auto wt : inputTracks()->Selected< const WaveTrack >()) {
       RegionList trackSilences;
 
       auto index = wt->TimeToLongSamples(mT0);
       sampleCount silentFrame = 0; // length of the current silence
 
-      Analyze(silences, trackSilences, wt, &silentFrame, &index, whichTrack, &inputLength, &minInputLength);
-
-      whichTrack++;
+      Analyze(silences, trackSilences, wt, &silentFrame, &index, &inputLength, &minInputLength);
    }
    return inputLength;
 }
@@ -427,48 +427,105 @@ bool EffectTruncSilence::FindSilences
    // Start with the whole selection silent
    silences.push_back(Region(mT0, mT1));
 
-   // Remove non-silent regions in each track
-   int whichTrack = 0;
+   // The scan is read-only, so the tracks can be analyzed concurrently,
+   // each producing its own list of silences; the per-track lists are
+   // intersected in track order on this thread afterwards.  (Each track
+   // is therefore scanned in full, rather than skipping regions other
+   // tracks have already proved non-silent.)
+   std::vector<const WaveTrack *> tracks;
    for (auto wt :
            list->Selected< const WaveTrack >()
                .StartingWith( firstTrack ).EndingAfter( lastTrack ) )
-   {
-      // Smallest silent region to detect in frames
-      auto minSilenceFrames =
-         sampleCount(std::max(mInitialAllowedSilence, DEF_MinTruncMs) * wt->GetRate());
+      tracks.push_back(wt);
 
-      //
-      // Scan the track for silences
-      //
-      RegionList trackSilences;
-
-      auto index = wt->TimeToLongSamples(mT0);
-      sampleCount silentFrame = 0;
-
-      // Detect silences
-      bool cancelled = !(Analyze(silences, trackSilences, wt, &silentFrame, &index, whichTrack));
+   if (tracks.empty())
+      return true;
 
-      // Buffer has been freed, so we're OK to return if cancelled
-      if (cancelled)
-      {
-         ReplaceProcessedTracks(false);
-         return false;
+   // Total for the progress dialog
+   double totalSamples = 0;
+   for (auto wt : tracks)
+      totalSamples +=
+         (wt->TimeToLongSamples(mT1) - wt->TimeToLongSamples(mT0))
+            .as_double();
+   totalSamples = std::max(1.0, totalSamples);
+
+   mScannedSamples.store(0);
+   mAbortAnalysis.store(false);
+
+   std::vector<RegionList> trackSilences(tracks.size());
+   std::atomic<size_t> nextTrack{ 0 };
+   std::atomic<size_t> tracksDone{ 0 };
+   std::atomic<bool> failed{ false };
+
+   auto worker = [&]{
+      size_t ii;
+      while ((ii = nextTrack++) < tracks.size()) {
+         const auto wt = tracks[ii];
+
+         // Smallest silent region to detect in frames
+         auto minSilenceFrames =
+            sampleCount(std::max(mInitialAllowedSilence, DEF_MinTruncMs) * wt->GetRate());
+
+         // Scan against the whole selection; the running intersection
+         // belongs to the main thread and cannot be consulted here
+         RegionList silenceList;
+         silenceList.push_back(Region(mT0, mT1));
+
+         auto index = wt->TimeToLongSamples(mT0);
+         sampleCount silentFrame = 0;
+
+         // Detect silences.  Don't let exceptions escape the thread;
+         // treat errors like cancellation and clean up below.
+         const bool ok = GuardedCall<bool>( [&]{
+            return Analyze(
+               silenceList, trackSilences[ii], wt, &silentFrame, &index);
+         }, MakeSimpleGuard(false) );
+
+         if (!ok) {
+            failed.store(true);
+            mAbortAnalysis.store(true);
+         }
+         else if (silentFrame >= minSilenceFrames)
+         {
+            // Track ended in silence -- record region
+            trackSilences[ii].push_back(Region(
+               wt->LongSamplesToTime(index - silentFrame),
+               wt->LongSamplesToTime(index)
+            ));
+         }
+         ++tracksDone;
       }
+   };
+
+   const unsigned concurrency = std::thread::hardware_concurrency();
+   const size_t nThreads =
+      std::min<size_t>(tracks.size(), std::max(1u, concurrency));
+   std::vector<std::thread> threads;
+   for (size_t ii = 0; ii < nThreads; ++ii)
+      threads.emplace_back(worker);
+
+   // Drive the progress dialog from this thread while the workers scan,
+   // and pass any cancellation on to them
+   while (tracksDone.load() < tracks.size()) {
+      if (TotalProgress(detectFrac * mScannedSamples.load() / totalSamples))
+         mAbortAnalysis.store(true);
+      wxMilliSleep(50);
+   }
 
-      if (silentFrame >= minSilenceFrames)
-      {
-         // Track ended in silence -- record region
-         trackSilences.push_back(Region(
-            wt->LongSamplesToTime(index - silentFrame),
-            wt->LongSamplesToTime(index)
-         ));
-      }
+   for (auto &thread : threads)
+      thread.join();
 
-      // Intersect with the overall silent region list
-      Intersect(silences, trackSilences);
-      whichTrack++;
+   // Buffers have been freed, so we're OK to return if cancelled
+   if (failed.load() || mAbortAnalysis.load())
+   {
+      ReplaceProcessedTracks(false);
+      return false;
    }
 
+   // Intersect each track's silences with the overall silent region list
+   for (auto &trackSilence : trackSilences)
+      Intersect(silences, trackSilence);
+
    return true;
 }
 
@@ -591,7 +648,6 @@ bool EffectTruncSilence::Analyze(RegionList& silenceList,
                                  const WaveTrack *wt,
                                  sampleCount* silentFrame,
                                  sampleCount* index,
-                                 int whichTrack,
                                  double* inputLength /*= NULL*/,
                                  double* minInputLength /*= NULL*/)
 {
@@ -604,8 +660,11 @@ bool EffectTruncSilence::Analyze(RegionList& silenceList,
    auto end = wt->TimeToLongSamples(mT1);
    sampleCount outLength = 0;
 
-   double previewLength;
-   gPrefs->Read(wxT("/AudioIO/EffectsPreviewLen"), &previewLength, 6.0);
+   // Only the previewing case needs this, and only the main thread may
+   // consult the preferences
+   double previewLength = 0.0;
+   if (inputLength)
+      gPrefs->Read(wxT("/AudioIO/EffectsPreviewLen"), &previewLength, 6.0);
    // Minimum required length in samples.
    const sampleCount previewLen( previewLength * wt->GetRate() );
 
@@ -626,13 +685,10 @@ bool EffectTruncSilence::Analyze(RegionList& silenceList,
       }
 
       if (!inputLength) {
-         // Show progress dialog, test for cancellation
-         bool cancelled = TotalProgress(
-               detectFrac * (whichTrack +
-                             (*index - start).as_double() /
-                             (end - start).as_double()) /
-                             (double)GetNumWaveTracks());
-         if (cancelled)
+         // We may be on a worker thread, which must not touch the
+         // progress dialog; the main thread drives it from the counter
+         // of scanned samples and posts cancellation through this flag
+         if (mAbortAnalysis.load())
             return false;
       }
 
@@ -730,6 +786,8 @@ bool EffectTruncSilence::Analyze(RegionList& silenceList,
       }
       // Next block
       *index += count;
+      if (!inputLength)
+         mScannedSamples.fetch_add(count);
    }
 
    if (inputLength) {
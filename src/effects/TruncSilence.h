@@ -17,6 +17,8 @@
 #ifndef __AUDACITY_EFFECT_TRUNC_SILENCE__
 #define __AUDACITY_EFFECT_TRUNC_SILENCE__
 
+#include <atomic>
+
 #include "Effect.h"
 
 class ShuttleGui;
@@ -58,12 +60,13 @@ public:
    // Analyze a single track to find silences
    // If inputLength is not NULL we are calculating the minimum
    // amount of input for previewing.
+   // May be called concurrently for different tracks; progress and
+   // cancellation then go through mScannedSamples and mAbortAnalysis.
    bool Analyze(RegionList &silenceList,
                         RegionList &trackSilences,
                         const WaveTrack *wt,
                         sampleCount* silentFrame,
                         sampleCount* index,
-                        int whichTrack,
                         double* inputLength = NULL,
                         double* minInputLength = NULL);
 
@@ -102,6 +105,10 @@ private:
 
    size_t mBlendFrameCount;
 
+   // Communication with the analysis worker threads
+   std::atomic<long long> mScannedSamples{ 0 };
+   std::atomic<bool> mAbortAnalysis{ false };
+
    wxTextCtrl *mThresholdText;
    wxChoice *mActionChoice;
    wxTextCtrl *mInitialAllowedSilenceT;
@@ -23,6 +23,8 @@ doing the second pass over all selected tracks.
 
 #include "../WaveTrack.h"
 
+#include <future>
+
 bool EffectTwoPassSimpleMono::Process()
 {
     mPass = 0;
@@ -102,10 +104,13 @@ bool EffectTwoPassSimpleMono::ProcessOne(WaveTrack * track,
    auto len = (end - start).as_double();
    auto maxblock = track->GetMaxBlockSize();
 
-   //Initiate a processing buffer.  This buffer will (most likely)
-   //be shorter than the length of the track being processed.
+   //Initiate three processing buffers, so that the read of the next
+   //block can overlap the processing of the current pair.  Each buffer
+   //will (most likely) be shorter than the length of the track being
+   //processed.
    Floats buffer1{ maxblock };
    Floats buffer2{ maxblock };
+   Floats buffer3{ maxblock };
    auto samples1 =  limitSampleBufferSize(
       std::min( maxblock, track->GetBestBlockSize(start) ), end - start );
 
@@ -124,21 +129,37 @@ bool EffectTwoPassSimpleMono::ProcessOne(WaveTrack * track,
    //Go through the track one buffer at a time. s counts which
    //sample the current buffer starts at.
    auto s = start + samples1;
-   while (s < end) {
-      //Get a block of samples (smaller than the size of the buffer)
-      //Adjust the block size if it is the final block in the track
-      auto samples2 = limitSampleBufferSize(
+   size_t samples2 = 0;
+   if (s < end) {
+      samples2 = limitSampleBufferSize(
          std::min( track->GetBestBlockSize(s), maxblock ), end - s
       );
-
-      //Get the samples from the track and put them in the buffer
       track->Get((samplePtr)buffer2.get(), floatSample, s, samples2);
+   }
+
+   while (s < end) {
+      //Start reading the block after this one on a worker while the
+      //current pair is processed.  The worker only reads the track,
+      //and is joined below, before Set modifies it.
+      const auto nextS = s + samples2;
+      const size_t samples3 = nextS < end
+         ? limitSampleBufferSize(
+            std::min( track->GetBestBlockSize(nextS), maxblock ), end - nextS )
+         : 0;
+      std::future<void> pending;
+      if (samples3 > 0)
+         pending = std::async(std::launch::async, [=, &buffer3] {
+            track->Get((samplePtr)buffer3.get(), floatSample, nextS, samples3);
+         });
 
       //Process the buffer.  If it fails, clean up and exit.
       if (mPass == 0)
          ret = TwoBufferProcessPass1(buffer1.get(), samples1, buffer2.get(), samples2);
       else
          ret = TwoBufferProcessPass2(buffer1.get(), samples1, buffer2.get(), samples2);
+
+      if (pending.valid())
+         pending.get();
       if (!ret)
          //Return false because the effect failed.
          return false;
@@ -148,7 +169,7 @@ bool EffectTwoPassSimpleMono::ProcessOne(WaveTrack * track,
       track->Set((samplePtr)buffer1.get(), floatSample, s - samples1, samples1);
 
       //Increment s one blockfull of samples
-      s += samples2;
+      s = nextS;
 
       //Update the Progress meter
       if (mSecondPassDisabled)
@@ -165,8 +186,9 @@ bool EffectTwoPassSimpleMono::ProcessOne(WaveTrack * track,
 
       // Rotate the buffers
       buffer1.swap(buffer2);
-
-      std::swap(samples1, samples2);
+      buffer2.swap(buffer3);
+      samples1 = samples2;
+      samples2 = samples3;
    }
 
    // Send the last buffer with a NULL pointer for the current buffer
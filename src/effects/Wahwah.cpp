@@ -23,6 +23,7 @@
 
 #include "../Experimental.h"
 
+#include <algorithm>
 #include <math.h>
 
 #include <wx/intl.h>
@@ -360,7 +361,6 @@ size_t EffectWahwah::InstanceProcess(EffectWahwahState & data, float **inBlock,
    float *ibuf = inBlock[0];
    float *obuf = outBlock[0];
    double frequency, omega, sn, cs, alpha;
-   double in, out;
 
    data.lfoskip = mFreq * 2 * M_PI / data.samplerate;
    data.depth = mDepth / 100.0;
@@ -369,13 +369,48 @@ size_t EffectWahwah::InstanceProcess(EffectWahwahState & data, float **inBlock,
    data.phase = mPhase * M_PI / 180.0;
    data.outgain = DB_TO_LINEAR(mOutGain);
 
-   for (decltype(blockLen) i = 0; i < blockLen; i++)
+   // Hoist the filter state and the coefficients, pre-divided by a0,
+   // into locals for the whole block, the same register-local treatment
+   // the block Biquad engine gives fixed filters
+   double xn1 = data.xn1, xn2 = data.xn2;
+   double yn1 = data.yn1, yn2 = data.yn2;
+   // a0 is still zero before the very first update, which comes before
+   // the first sample is filtered
+   const double a0inv = data.a0 != 0 ? 1.0 / data.a0 : 0.0;
+   double b0 = data.b0 * a0inv, b1 = data.b1 * a0inv, b2 = data.b2 * a0inv;
+   double a1 = data.a1 * a0inv, a2 = data.a2 * a0inv;
+   unsigned long skipcount = data.skipcount;
+   const double outgain = data.outgain;
+
+   // Successive LFO updates are a fixed angle apart, so after one pair
+   // of trig calls per block the cosine is advanced by complex rotation
+   const double delta = lfoskipsamples * data.lfoskip;
+   const double rotCos = cos(delta), rotSin = sin(delta);
+   bool haveTrig = false;
+   double lfoCos = 0, lfoSin = 0;
+
+   decltype(blockLen) i = 0;
+   while (i < blockLen)
    {
-      in = (double) ibuf[i];
-
-      if ((data.skipcount++) % lfoskipsamples == 0)
+      const unsigned long rem = skipcount % lfoskipsamples;
+      if (rem == 0)
       {
-         frequency = (1 + cos(data.skipcount * data.lfoskip + data.phase)) / 2;
+         if (!haveTrig)
+         {
+            // as before, the angle is taken after the increment
+            const double angle = (skipcount + 1) * data.lfoskip + data.phase;
+            lfoCos = cos(angle);
+            lfoSin = sin(angle);
+            haveTrig = true;
+         }
+         else
+         {
+            const double newCos = lfoCos * rotCos - lfoSin * rotSin;
+            lfoSin = lfoSin * rotCos + lfoCos * rotSin;
+            lfoCos = newCos;
+         }
+
+         frequency = (1 + lfoCos) / 2;
          frequency = frequency * data.depth * (1 - data.freqofs) + data.freqofs;
          frequency = exp((frequency - 1) * 6);
          omega = M_PI * frequency;
@@ -388,17 +423,36 @@ size_t EffectWahwah::InstanceProcess(EffectWahwahState & data, float **inBlock,
          data.a0 = 1 + alpha;
          data.a1 = -2 * cs;
          data.a2 = 1 - alpha;
-      };
-      out = (data.b0 * in + data.b1 * data.xn1 + data.b2 * data.xn2 - data.a1 * data.yn1 - data.a2 * data.yn2) / data.a0;
-      data.xn2 = data.xn1;
-      data.xn1 = in;
-      data.yn2 = data.yn1;
-      data.yn1 = out;
-      out *= data.outgain;
-
-      obuf[i] = (float) out;
+         b0 = data.b0 / data.a0;
+         b1 = data.b1 / data.a0;
+         b2 = data.b2 / data.a0;
+         a1 = data.a1 / data.a0;
+         a2 = data.a2 / data.a0;
+      }
+
+      // the coefficients hold until the next control-rate boundary
+      const auto seg =
+         std::min<decltype(blockLen)>(blockLen - i, lfoskipsamples - rem);
+      for (decltype(blockLen) n = 0; n < seg; n++, i++)
+      {
+         const double in = (double) ibuf[i];
+         const double out = b0 * in + b1 * xn1 + b2 * xn2 - a1 * yn1 - a2 * yn2;
+         xn2 = xn1;
+         xn1 = in;
+         yn2 = yn1;
+         yn1 = out;
+
+         obuf[i] = (float) (out * outgain);
+      }
+      skipcount += seg;
    }
 
+   data.xn1 = xn1;
+   data.xn2 = xn2;
+   data.yn1 = yn1;
+   data.yn2 = yn2;
+   data.skipcount = skipcount;
+
    return blockLen;
 }
 
@@ -991,6 +991,15 @@ size_t LadspaEffect::ProcessBlock(float **inBlock, float **outBlock, size_t bloc
    return blockLen;
 }
 
+bool LadspaEffect::SupportsConcurrentProcessing()
+{
+   // Independent mono instances may safely run on worker threads.  Plugins
+   // that report latency stay on the serial path, which compensates for it.
+   return mData != NULL &&
+          mAudioIns == 1 && mAudioOuts == 1 &&
+          mLatencyPort < 0;
+}
+
 bool LadspaEffect::RealtimeInitialize()
 {
    return true;
@@ -998,13 +1007,18 @@ bool LadspaEffect::RealtimeInitialize()
 
 bool LadspaEffect::RealtimeAddProcessor(unsigned WXUNUSED(numChannels), float sampleRate)
 {
-   LADSPA_Handle slave = InitInstance(sampleRate);
+   // Private output control storage, so that slaves running on concurrent
+   // threads never write to the same floats
+   Floats outputControls{ mData->PortCount, true };
+
+   LADSPA_Handle slave = InitInstance(sampleRate, outputControls.get());
    if (!slave)
    {
       return false;
    }
 
    mSlaves.push_back(slave);
+   mSlaveOutputControls.push_back(std::move(outputControls));
 
    return true;
 }
@@ -1016,6 +1030,7 @@ bool LadspaEffect::RealtimeFinalize()
       FreeInstance(mSlaves[i]);
    }
    mSlaves.clear();
+   mSlaveOutputControls.clear();
 
    return true;
 }
@@ -1653,7 +1668,7 @@ bool LadspaEffect::SaveParameters(const RegistryPath & group)
    return mHost->SetPrivateConfig(group, wxT("Parameters"), parms);
 }
 
-LADSPA_Handle LadspaEffect::InitInstance(float sampleRate)
+LADSPA_Handle LadspaEffect::InitInstance(float sampleRate, float *outputControls)
 {
    /* Instantiate the plugin */
    LADSPA_Handle handle = mData->instantiate(mData, sampleRate);
@@ -1673,7 +1688,8 @@ LADSPA_Handle LadspaEffect::InitInstance(float sampleRate)
          }
          else
          {
-            mData->connect_port(handle, p, &mOutputControls[p]);
+            mData->connect_port(handle, p,
+               outputControls ? &outputControls[p] : &mOutputControls[p]);
          }
       }
    }
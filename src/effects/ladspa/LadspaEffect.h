@@ -87,6 +87,8 @@ public:
    bool ProcessFinalize() override;
    size_t ProcessBlock(float **inBlock, float **outBlock, size_t blockLen) override;
 
+   bool SupportsConcurrentProcessing() override;
+
    bool RealtimeInitialize() override;
    bool RealtimeAddProcessor(unsigned numChannels, float sampleRate) override;
    bool RealtimeFinalize() override;
@@ -136,7 +138,7 @@ private:
    bool LoadParameters(const RegistryPath & group);
    bool SaveParameters(const RegistryPath & group);
 
-   LADSPA_Handle InitInstance(float sampleRate);
+   LADSPA_Handle InitInstance(float sampleRate, float *outputControls = NULL);
    void FreeInstance(LADSPA_Handle handle);
 
    void OnCheckBox(wxCommandEvent & evt);
@@ -181,6 +183,9 @@ private:
 
    // Realtime processing
    std::vector<LADSPA_Handle> mSlaves;
+   // Each slave writes its output controls here, not to mOutputControls,
+   // so that slaves running on concurrent threads do not share storage
+   std::vector<Floats> mSlaveOutputControls;
 
    EffectUIHostInterface *mUIHost;
 
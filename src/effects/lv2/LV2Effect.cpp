@@ -46,6 +46,12 @@
 #include "lv2/lv2plug.in/ns/ext/port-groups/port-groups.h"
 #include "lv2/lv2plug.in/ns/ext/buf-size/buf-size.h"
 #include "lv2/lv2plug.in/ns/ext/parameters/parameters.h"
+
+// Added to the buf-size extension after the version bundled here;  plugins
+// that choose FFT partition sizes look for it
+#if !defined(LV2_BUF_SIZE__nominalBlockLength)
+#define LV2_BUF_SIZE__nominalBlockLength LV2_BUF_SIZE_PREFIX "nominalBlockLength"
+#endif
 #include "lv2/lv2plug.in/ns/extensions/ui/ui.h"
 
 #if defined(__WXGTK__)
@@ -317,11 +323,17 @@ LV2Effect::LV2Effect(const LilvPlugin *plug)
    mIdleFeature = NULL;
    mOptionsInterface = NULL;
 
+   mWorkerInterface = NULL;
+   mWorkTarget = NULL;
+   mFreewheeling = true;
+   mWorkerStop = false;
+
    mFactoryPresetsLoaded = false;
 }
 
 LV2Effect::~LV2Effect()
 {
+   StopWorker();
 }
 
 // ============================================================================
@@ -629,6 +641,10 @@ bool LV2Effect::SetHost(EffectHostInterface *host)
                                 sizeof(mBlockSize),
                                 LV2_ATOM__Int,
                                 &mBlockSize);
+   mNominalBlockSizeOption = AddOption(LV2_BUF_SIZE__nominalBlockLength,
+                                       sizeof(mBlockSize),
+                                       LV2_ATOM__Int,
+                                       &mBlockSize);
    mSampleRateOption = AddOption(LV2_CORE__sampleRate,
                                  sizeof(mSampleRate),
                                  LV2_ATOM__Double,
@@ -647,9 +663,13 @@ bool LV2Effect::SetHost(EffectHostInterface *host)
    mUIResizeFeature.handle = this;
    mUIResizeFeature.ui_resize = LV2Effect::ui_resize;
 
+   mWorkerScheduleFeature.handle = this;
+   mWorkerScheduleFeature.schedule_work = LV2Effect::worker_schedule;
+
    AddFeature(LV2_UI_PREFIX "makeResident", NULL);
    AddFeature(LV2_UI__noUserResize, NULL);
    AddFeature(LV2_BUF_SIZE__boundedBlockLength, NULL);
+   AddFeature(LV2_WORKER__schedule, &mWorkerScheduleFeature);
    AddFeature(LV2_OPTIONS__options, mOptions.data());
    AddFeature(LV2_URI_MAP_URI, &mUriMapFeature);
    AddFeature(LV2_URID__map, &mURIDMapFeature);
@@ -711,9 +731,10 @@ size_t LV2Effect::SetBlockSize(size_t maxBlockSize)
 
    if (mOptionsInterface && mOptionsInterface->set)
    {
-      LV2_Options_Option options[2];         // 2 for empty terminating option
+      LV2_Options_Option options[3];         // 3 for empty terminating option
       memset(&options, 0, sizeof(options));
-      memcpy(&options, &mOptions[mBlockSizeOption], sizeof(mOptions[0]));
+      memcpy(&options[0], &mOptions[mBlockSizeOption], sizeof(mOptions[0]));
+      memcpy(&options[1], &mOptions[mNominalBlockSizeOption], sizeof(mOptions[0]));
 
       if (mMaster)
       {
@@ -757,6 +778,9 @@ bool LV2Effect::IsReady()
 
 bool LV2Effect::ProcessInitialize(sampleCount WXUNUSED(totalLen), ChannelNames WXUNUSED(chanMap))
 {
+   // Offline apply free-wheels, so scheduled work is done synchronously
+   mFreewheeling = true;
+
    mProcess = InitInstance(mSampleRate);
    if (!mProcess)
    {
@@ -795,13 +819,17 @@ size_t LV2Effect::ProcessBlock(float **inbuf, float **outbuf, size_t size)
       lilv_instance_connect_port(mProcess, mAudioOutputs[p], outbuf[p]);
    }
 
-   lilv_instance_run(mProcess, size);
+   RunInstance(mProcess, size);
 
    return size;
 }
 
 bool LV2Effect::RealtimeInitialize()
 {
+   // Scheduled work must not run in the audio thread while playing
+   mFreewheeling = false;
+   StartWorker();
+
    mMasterIn.reinit( mAudioInputs.size(), mBlockSize );
    for (size_t p = 0, cnt = mAudioInputs.size(); p < cnt; p++)
       lilv_instance_connect_port(mMaster, mAudioInputs[p], mMasterIn[p].get());
@@ -817,6 +845,10 @@ bool LV2Effect::RealtimeInitialize()
 
 bool LV2Effect::RealtimeFinalize()
 {
+   // Finish any work still in flight before freeing the instances it
+   // belongs to
+   StopWorker();
+
    for (size_t i = 0, cnt = mSlaves.size(); i < cnt; i++)
    {
       lilv_instance_deactivate(mSlaves[i]);
@@ -888,7 +920,7 @@ size_t LV2Effect::RealtimeProcess(int group,
       lilv_instance_connect_port(slave, mAudioOutputs[p], outbuf[p]);
    }
 
-   lilv_instance_run(slave, numSamples);
+   RunInstance(slave, numSamples);
 
    return numSamples;
 }
@@ -910,7 +942,7 @@ bool LV2Effect::RealtimeAddProcessor(unsigned WXUNUSED(numChannels), float sampl
 
 bool LV2Effect::RealtimeProcessEnd()
 {
-   lilv_instance_run(mMaster, mNumSamples);
+   RunInstance(mMaster, mNumSamples);
 
    return true;
 }
@@ -1333,6 +1365,9 @@ LilvInstance *LV2Effect::InitInstance(float sampleRate)
    mOptionsInterface = (LV2_Options_Interface *)
       lilv_instance_get_extension_data(handle, LV2_OPTIONS__interface);
 
+   mWorkerInterface = (const LV2_Worker_Interface *)
+      lilv_instance_get_extension_data(handle, LV2_WORKER__interface);
+
    SetBlockSize(mBlockSize);
    SetSampleRate(sampleRate);
 
@@ -2061,6 +2096,188 @@ int LV2Effect::UIResize(int WXUNUSED(width), int WXUNUSED(height))
    return 1;
 }
 
+// static callback
+LV2_Worker_Status LV2Effect::worker_schedule(LV2_Worker_Schedule_Handle handle,
+                                             uint32_t size,
+                                             const void *data)
+{
+   return ((LV2Effect *) handle)->ScheduleWork(size, data);
+}
+
+LV2_Worker_Status LV2Effect::ScheduleWork(uint32_t size, const void *data)
+{
+   // Only ever called from within run(), so mWorkTarget identifies the
+   // instance making the request
+   LilvInstance *instance = mWorkTarget;
+   if (!instance || !mWorkerInterface || !mWorkerInterface->work)
+   {
+      return LV2_WORKER_ERR_UNKNOWN;
+   }
+
+   if (mFreewheeling || !mWorkerThread.joinable())
+   {
+      // Free-wheeling (offline apply):  do the work right away, so that
+      // its effect lands with sample accuracy and the pass runs as fast
+      // as the plugin can go
+      WorkerRespondTarget target = { this, instance };
+      return mWorkerInterface->work(lilv_instance_get_handle(instance),
+                                    LV2Effect::worker_respond,
+                                    &target,
+                                    size,
+                                    data);
+   }
+
+   WorkerMessage msg;
+   msg.mInstance = instance;
+   msg.mData.assign((const char *) data, (const char *) data + size);
+
+   {
+      std::lock_guard<std::mutex> locker(mWorkerMutex);
+      mWorkerQueue.push_back(std::move(msg));
+   }
+   mWorkerCondition.notify_one();
+
+   return LV2_WORKER_SUCCESS;
+}
+
+// static callback
+LV2_Worker_Status LV2Effect::worker_respond(LV2_Worker_Respond_Handle handle,
+                                            uint32_t size,
+                                            const void *data)
+{
+   WorkerRespondTarget *target = (WorkerRespondTarget *) handle;
+   LV2Effect *effect = target->mEffect;
+
+   WorkerMessage msg;
+   msg.mInstance = target->mInstance;
+   msg.mData.assign((const char *) data, (const char *) data + size);
+
+   {
+      std::lock_guard<std::mutex> locker(effect->mWorkerMutex);
+      effect->mResponses.push_back(std::move(msg));
+   }
+
+   return LV2_WORKER_SUCCESS;
+}
+
+void LV2Effect::StartWorker()
+{
+   if (!mWorkerInterface || !mWorkerInterface->work || mWorkerThread.joinable())
+   {
+      return;
+   }
+
+   mWorkerStop = false;
+   mWorkerThread = std::thread([this]{ WorkerThread(); });
+}
+
+void LV2Effect::StopWorker()
+{
+   if (!mWorkerThread.joinable())
+   {
+      return;
+   }
+
+   {
+      std::lock_guard<std::mutex> locker(mWorkerMutex);
+      mWorkerStop = true;
+   }
+   mWorkerCondition.notify_one();
+   mWorkerThread.join();
+
+   // Undelivered responses are for instances about to be freed
+   mResponses.clear();
+}
+
+void LV2Effect::WorkerThread()
+{
+   for (;;)
+   {
+      WorkerMessage msg;
+
+      {
+         std::unique_lock<std::mutex> locker(mWorkerMutex);
+         mWorkerCondition.wait(locker, [this]
+         {
+            return mWorkerStop || !mWorkerQueue.empty();
+         });
+
+         if (mWorkerQueue.empty())
+         {
+            // Stopping, and every scheduled piece of work has been done
+            return;
+         }
+
+         msg = std::move(mWorkerQueue.front());
+         mWorkerQueue.pop_front();
+      }
+
+      WorkerRespondTarget target = { this, msg.mInstance };
+      mWorkerInterface->work(lilv_instance_get_handle(msg.mInstance),
+                             LV2Effect::worker_respond,
+                             &target,
+                             msg.mData.size(),
+                             msg.mData.empty() ? NULL : msg.mData.data());
+   }
+}
+
+void LV2Effect::DeliverResponses(LilvInstance *instance)
+{
+   if (!mWorkerInterface || !mWorkerInterface->work_response)
+   {
+      return;
+   }
+
+   for (;;)
+   {
+      WorkerMessage msg;
+
+      {
+         std::lock_guard<std::mutex> locker(mWorkerMutex);
+
+         auto iter = mResponses.begin();
+         while (iter != mResponses.end() && iter->mInstance != instance)
+         {
+            ++iter;
+         }
+
+         if (iter == mResponses.end())
+         {
+            return;
+         }
+
+         msg = std::move(*iter);
+         mResponses.erase(iter);
+      }
+
+      mWorkerInterface->work_response(lilv_instance_get_handle(instance),
+                                      msg.mData.size(),
+                                      msg.mData.empty() ? NULL : msg.mData.data());
+   }
+}
+
+void LV2Effect::RunInstance(LilvInstance *instance, size_t numSamples)
+{
+   // Remember who is inside run() so that scheduled work can be routed
+   // back to the right instance
+   mWorkTarget = instance;
+
+   // Hand over whatever the worker finished since the last cycle
+   DeliverResponses(instance);
+
+   lilv_instance_run(instance, numSamples);
+
+   // And anything (such as free-wheeled work) completed during this one
+   DeliverResponses(instance);
+
+   if (mWorkerInterface && mWorkerInterface->end_run)
+   {
+      mWorkerInterface->end_run(lilv_instance_get_handle(instance));
+   }
+
+   mWorkTarget = NULL;
+}
+
 // static callback
 void LV2Effect::suil_write_func(SuilController controller,
                                 uint32_t       port_index,
@@ -15,6 +15,10 @@
 
 class wxArrayString;
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include <wx/event.h> // to inherit
@@ -24,6 +28,7 @@ class wxArrayString;
 #include "lv2/lv2plug.in/ns/ext/options/options.h"
 #include "lv2/lv2plug.in/ns/ext/uri-map/uri-map.h"
 #include "lv2/lv2plug.in/ns/ext/urid/urid.h"
+#include "lv2/lv2plug.in/ns/ext/worker/worker.h"
 #include "lv2/lv2plug.in/ns/extensions/ui/ui.h"
 
 #include <lilv/lilv.h>
@@ -212,6 +217,21 @@ private:
    static int ui_resize(LV2UI_Feature_Handle handle, int width, int height);
    int UIResize(int width, int height);
 
+   static LV2_Worker_Status worker_schedule(LV2_Worker_Schedule_Handle handle,
+                                            uint32_t size,
+                                            const void *data);
+   LV2_Worker_Status ScheduleWork(uint32_t size, const void *data);
+
+   static LV2_Worker_Status worker_respond(LV2_Worker_Respond_Handle handle,
+                                           uint32_t size,
+                                           const void *data);
+
+   void StartWorker();
+   void StopWorker();
+   void WorkerThread();
+   void DeliverResponses(LilvInstance *instance);
+   void RunInstance(LilvInstance *instance, size_t numSamples);
+
    size_t AddOption(const char *key, uint32_t size, const char *type, void *value);
    LV2_Feature *AddFeature(const char *uri, void *data);
 
@@ -302,11 +322,40 @@ private:
    LV2_Extension_Data_Feature mExtDataFeature;
    
    size_t mBlockSizeOption;
+   size_t mNominalBlockSizeOption;
    size_t mSampleRateOption;
 
    LV2_Options_Interface *mOptionsInterface;
    std::vector<LV2_Options_Option> mOptions;
 
+   // Worker extension (work:schedule) support
+   LV2_Worker_Schedule mWorkerScheduleFeature;
+   const LV2_Worker_Interface *mWorkerInterface;
+
+   /// A piece of work scheduled by, or a response destined for, one
+   /// particular plugin instance
+   struct WorkerMessage
+   {
+      LilvInstance *mInstance;
+      std::vector<char> mData;
+   };
+
+   /// Identifies the effect and instance a worker response belongs to
+   struct WorkerRespondTarget
+   {
+      LV2Effect *mEffect;
+      LilvInstance *mInstance;
+   };
+
+   LilvInstance *mWorkTarget;    // the instance currently inside run()
+   bool mFreewheeling;           // offline apply:  do work synchronously
+   bool mWorkerStop;
+   std::deque<WorkerMessage> mWorkerQueue;
+   std::deque<WorkerMessage> mResponses;
+   std::mutex mWorkerMutex;
+   std::condition_variable mWorkerCondition;
+   std::thread mWorkerThread;
+
    std::vector<std::unique_ptr<LV2_Feature>> mFeatures;
 
    LV2_Feature *mInstanceAccessFeature;
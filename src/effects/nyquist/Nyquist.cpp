@@ -149,6 +149,8 @@ NyquistEffect::NyquistEffect(const wxString &fName)
    mDebug = false;
    mIsSal = false;
    mOK = false;
+   mParsedCommandOk = false;
+   mParsedCommandEntryVersion = 0;
    mAuthor = XO("n/a");
    mReleaseVersion = XO("n/a");
    mCopyright = XO("n/a");
@@ -1309,14 +1311,15 @@ bool NyquistEffect::ProcessOne()
       cmd += mCmd;
    }
 
-   // Put the fetch buffers in a clean initial state
+   // Put the fetch caches in a clean initial state
    for (size_t i = 0; i < mCurNumChannels; i++)
-      mCurBuffer[i].Free();
+      mCurBufferCache[i].SetTrack(
+         mCurTrack[i]->SharedPointer<const WaveTrack>());
 
    // Guarantee release of memory when done
    auto cleanup = finally( [&] {
       for (size_t i = 0; i < mCurNumChannels; i++)
-         mCurBuffer[i].Free();
+         mCurBufferCache[i].SetTrack(nullptr);
    } );
 
    // Evaluate the expression, which may invoke the get callback, but often does
@@ -1455,7 +1458,8 @@ bool NyquistEffect::ProcessOne()
 
       // Clean the initial buffer states again for the get callbacks
       // -- is this really needed?
-      mCurBuffer[i].Free();
+      mCurBufferCache[i].SetTrack(
+         mCurTrack[i]->SharedPointer<const WaveTrack>());
    }
 
    // Now fully evaluate the sound
@@ -2208,9 +2212,43 @@ void NyquistEffect::ParseFile()
 
 bool NyquistEffect::ParseCommand(const wxString & cmd)
 {
+   // Tokenizing the same program again produces the same results, so when a
+   // macro applies the prompt across many files we skip straight to the
+   // cached outcome.  The entry value of mVersion is part of the key because
+   // a program without a ";version" header keeps the caller's value.  Fields
+   // that callers may overwrite between identical parses (the prompt's
+   // Init(), the version checkbox, control values) are restored from the
+   // cache; everything else still holds its value from the last parse.
+   if (mParsedCommandOk &&
+       cmd == mParsedCommand && mVersion == mParsedCommandEntryVersion)
+   {
+      mVersion = mParsedCommandResults.version;
+      mType = mParsedCommandResults.type;
+      mName = mParsedCommandResults.name;
+      mIsSpectral = mParsedCommandResults.isSpectral;
+      mDebugButton = mParsedCommandResults.debugButton;
+      mEnablePreview = mParsedCommandResults.enablePreview;
+      mDebug = mParsedCommandResults.debug;
+      mTrace = mParsedCommandResults.trace;
+      mControls = mParsedCommandResults.controls;
+
+      return true;
+   }
+
+   const int entryVersion = mVersion;
+
    wxStringInputStream stream(cmd + wxT(" "));
 
-   return ParseProgram(stream);
+   mParsedCommandOk = ParseProgram(stream);
+   if (mParsedCommandOk)
+   {
+      mParsedCommand = cmd;
+      mParsedCommandEntryVersion = entryVersion;
+      mParsedCommandResults = { mVersion, mType, mName, mIsSpectral,
+         mDebugButton, mEnablePreview, mDebug, mTrace, mControls };
+   }
+
+   return mParsedCommandOk;
 }
 
 int NyquistEffect::StaticGetCallback(float *buffer, int channel,
@@ -2224,45 +2262,24 @@ int NyquistEffect::StaticGetCallback(float *buffer, int channel,
 int NyquistEffect::GetCallback(float *buffer, int ch,
                                long start, long len, long WXUNUSED(totlen))
 {
-   if (mCurBuffer[ch].ptr()) {
-      if ((mCurStart[ch] + start) < mCurBufferStart[ch] ||
-          (mCurStart[ch] + start)+len >
-          mCurBufferStart[ch]+mCurBufferLen[ch]) {
-         mCurBuffer[ch].Free();
-      }
+   // The cache holds the most recently fetched blocks, so the many small,
+   // mostly sequential requests that lazy sound evaluation makes are
+   // served without re-reading or re-assembling whole blocks, and the
+   // memory held per channel stays bounded by a couple of blocks
+   constSamplePtr data;
+   try {
+      data = mCurBufferCache[ch].Get(
+         floatSample, mCurStart[ch] + start, len, true);
    }
-
-   if (!mCurBuffer[ch].ptr()) {
-      mCurBufferStart[ch] = (mCurStart[ch] + start);
-      mCurBufferLen[ch] = mCurTrack[ch]->GetBestBlockSize(mCurBufferStart[ch]);
-
-      if (mCurBufferLen[ch] < (size_t) len) {
-         mCurBufferLen[ch] = mCurTrack[ch]->GetIdealBlockSize();
-      }
-
-      mCurBufferLen[ch] =
-         limitSampleBufferSize( mCurBufferLen[ch],
-                                mCurStart[ch] + mCurLen - mCurBufferStart[ch] );
-
-      mCurBuffer[ch].Allocate(mCurBufferLen[ch], floatSample);
-      try {
-         mCurTrack[ch]->Get(
-            mCurBuffer[ch].ptr(), floatSample,
-            mCurBufferStart[ch], mCurBufferLen[ch]);
-      }
-      catch ( ... ) {
-         // Save the exception object for re-throw when out of the library
-         mpException = std::current_exception();
-         return -1;
-      }
+   catch ( ... ) {
+      // Save the exception object for re-throw when out of the library
+      mpException = std::current_exception();
+      return -1;
    }
+   if (!data)
+      return -1;
 
-   // We have guaranteed above that this is nonnegative and bounded by
-   // mCurBufferLen[ch]:
-   auto offset = ( mCurStart[ch] + start - mCurBufferStart[ch] ).as_size_t();
-   CopySamples(mCurBuffer[ch].ptr() + offset*SAMPLE_SIZE(floatSample), floatSample,
-               (samplePtr)buffer, floatSample,
-               len);
+   memcpy(buffer, data, len * sizeof(float));
 
    if (ch == 0) {
       double progress = mScale *
@@ -12,6 +12,7 @@
 #define __AUDACITY_EFFECT_NYQUIST__
 
 #include "../Effect.h"
+#include "../../WaveTrack.h" // for WaveTrackCache
 
 #include "nyx.h"
 
@@ -240,6 +241,24 @@ private:
    int               mVersion;   // Syntactic version of Nyquist plug-in (not to be confused with mReleaseVersion)
    std::vector<NyqControl>   mControls;
 
+   // Results of the last successful ParseCommand, reused when the same
+   // program text comes around again (see ParseCommand)
+   bool              mParsedCommandOk;
+   wxString          mParsedCommand;
+   int               mParsedCommandEntryVersion;
+   struct ParsedCommandResults
+   {
+      int version;
+      EffectType type;
+      wxString name;
+      bool isSpectral;
+      bool debugButton;
+      bool enablePreview;
+      bool debug;
+      bool trace;
+      std::vector<NyqControl> controls;
+   }                 mParsedCommandResults;
+
    unsigned          mCurNumChannels;
    WaveTrack         *mCurTrack[2];
    sampleCount       mCurStart[2];
@@ -255,9 +274,7 @@ private:
    double            mProgressTot;
    double            mScale;
 
-   SampleBuffer      mCurBuffer[2];
-   sampleCount       mCurBufferStart[2];
-   size_t            mCurBufferLen[2];
+   WaveTrackCache    mCurBufferCache[2];
 
    WaveTrack        *mOutputTrack[2];
 
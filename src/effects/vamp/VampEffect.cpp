@@ -20,6 +20,8 @@
 #include <vamp-hostsdk/PluginChannelAdapter.h>
 #include <vamp-hostsdk/PluginInputDomainAdapter.h>
 
+#include <future>
+
 #include <wx/wxprec.h>
 #include <wx/button.h>
 #include <wx/checkbox.h>
@@ -441,23 +443,56 @@ bool VampEffect::Process()
       LabelTrack *ltrack = addedTracks.back()->get();
 
       FloatBuffers data{ channels, block };
+      FloatBuffers prefetch{ channels, block };
 
       auto originalLen = len;
       auto ls = lstart;
       auto rs = rstart;
 
+      // Read ahead of the plugin:  a worker fills the next block from disk
+      // while the plugin analyses the current one.  The tracks are only
+      // read here, so the overlap is safe.
+      std::future<size_t> pending;
+      auto fetch = [&](sampleCount lpos, sampleCount rpos,
+                       sampleCount remaining)
+      {
+         pending = std::async(std::launch::async, [=, &prefetch]{
+            const auto request = limitSampleBufferSize( block, remaining );
+            left->Get((samplePtr)prefetch[0].get(), floatSample, lpos, request);
+            if (right)
+            {
+               right->Get(
+                  (samplePtr)prefetch[1].get(), floatSample, rpos, request);
+            }
+            return request;
+         });
+      };
+
+      // Never leave the worker reading behind us on the early returns below
+      auto joinFetch = finally([&]{
+         if (pending.valid())
+         {
+            try { pending.get(); } catch (...) {}
+         }
+      });
+
+      fetch(ls, rs, len);
+
       while (len != 0)
       {
-         const auto request = limitSampleBufferSize( block, len );
+         const auto request = pending.get();
 
-         if (left)
+         for (unsigned int c = 0; c < channels; ++c)
          {
-            left->Get((samplePtr)data[0].get(), floatSample, ls, request);
+            data[c].swap(prefetch[c]);
          }
 
-         if (right)
+         // Start on the following block before the plugin goes to work on
+         // this one
+         auto nextLen = len > (int)step ? len - step : sampleCount( 0 );
+         if (nextLen != 0)
          {
-            right->Get((samplePtr)data[1].get(), floatSample, rs, request);
+            fetch(ls + step, rs + step, nextLen);
          }
 
          if (request < block)
@@ -482,14 +517,7 @@ bool VampEffect::Process()
             reinterpret_cast< float** >( data.get() ), timestamp);
          AddFeatures(ltrack, features);
 
-         if (len > (int)step)
-         {
-            len -= step;
-         }
-         else
-         {
-            len = 0;
-         }
+         len = nextLen;
 
          ls += step;
          rs += step;
@@ -31,6 +31,13 @@
 #include "../Audacity.h" // for USE_* macros
 #include "Export.h"
 
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <wx/ffile.h>
+
 #include <wx/dcclient.h>
 #include <wx/file.h>
 #include <wx/filectrl.h>
@@ -60,6 +67,7 @@
 #include "FileDialog.h"
 
 #include "../DirManager.h"
+#include "../FileException.h"
 #include "../FileFormats.h"
 #include "../Mix.h"
 #include "../Prefs.h"
@@ -73,6 +81,7 @@
 #include "../WaveTrack.h"
 #include "../widgets/AudacityMessageBox.h"
 #include "../widgets/Warning.h"
+#include "../xml/XMLWriter.h"
 #include "../widgets/HelpSystem.h"
 #include "../AColor.h"
 #include "../Dependencies.h"
@@ -241,6 +250,266 @@ wxWindow *ExportPlugin::OptionsCreate(wxWindow *parent, int WXUNUSED(format))
    return p;
 }
 
+//----------------------------------------------------------------------------
+// Mixdown cache
+//----------------------------------------------------------------------------
+
+// Exporting the same master to several formats re-renders the full mix once
+// per format.  The classes below cache the most recent mixdown as interleaved
+// float samples in a temporary file, keyed by a hash of the input tracks'
+// serialized state and the mix parameters; a consecutive export of an
+// unchanged selection then replays the capture and skips straight to
+// encoding.
+
+namespace {
+
+///One cached mixdown.  The capture file holds interleaved float samples at
+///the rate and channel count of the export that produced it; complete is set
+///only after the producing export mixed all the way to the end.
+struct MixdownCacheEntry
+{
+   wxString key;
+   wxString fileName;
+   sampleCount frames{ 0 };
+   unsigned channels{ 0 };
+   double t0{ 0.0 };
+   double t1{ 0.0 };
+   bool complete{ false };
+
+   ~MixdownCacheEntry()
+   {
+      if (!fileName.empty())
+         wxRemoveFile(fileName);
+   }
+};
+
+///The single cache slot, holding the most recent capture.  Exports run one
+///at a time on the main thread, so no locking is needed.
+std::unique_ptr<MixdownCacheEntry> &MixdownCacheSlot()
+{
+   static std::unique_ptr<MixdownCacheEntry> sEntry;
+   return sEntry;
+}
+
+///Computes the cache key:  a hash over the XML serialization of the input
+///tracks (which reflects every edit, envelope point, and gain change) and
+///the time track, with the mix parameters appended.
+wxString MixdownCacheKey(const WaveTrackConstArray &inputTracks,
+   const Track *timeTrack,
+   double startTime, double stopTime,
+   unsigned numOutChannels, double outRate, bool highQuality)
+{
+   XMLStringWriter xml;
+   for (const auto &pTrack : inputTracks)
+      pTrack->WriteXML(xml);
+   if (timeTrack)
+      timeTrack->WriteXML(xml);
+   xml += wxString::Format(
+      wxT("<mix t0=\"%.15g\" t1=\"%.15g\" channels=\"%u\" rate=\"%.15g\" hq=\"%d\"/>"),
+      startTime, stopTime, numOutChannels, outRate, highQuality ? 1 : 0);
+   // The length guards against the unlikely hash collision
+   return wxString::Format(wxT("%llx:%llx"),
+      (unsigned long long) std::hash<std::wstring>{}(xml.ToStdWstring()),
+      (unsigned long long) xml.length());
+}
+
+///Output buffers in the format and interleaving the export plug-in asked
+///for, filled from interleaved float samples the same way Mixer::Process
+///converts its accumulators.
+struct MixdownConvertBuffers
+{
+   MixdownConvertBuffers(unsigned channels, size_t bufferSize,
+      bool interleaved, sampleFormat format, bool highQuality)
+      : mChannels(channels)
+      , mInterleaved(interleaved)
+      , mFormat(format)
+      , mHighQuality(highQuality)
+   {
+      const unsigned numBuffers = interleaved ? 1 : channels;
+      const size_t len = interleaved ? bufferSize * channels : bufferSize;
+      mBuffers.reinit(numBuffers);
+      for (unsigned c = 0; c < numBuffers; c++)
+         mBuffers[c].Allocate(len, format);
+   }
+
+   void Convert(samplePtr mix, size_t frames)
+   {
+      if (mInterleaved) {
+         for (unsigned c = 0; c < mChannels; c++)
+            CopySamples(mix + (c * SAMPLE_SIZE(floatSample)),
+               floatSample,
+               mBuffers[0].ptr() + (c * SAMPLE_SIZE(mFormat)),
+               mFormat,
+               frames,
+               mHighQuality,
+               mChannels,
+               mChannels);
+      }
+      else {
+         for (unsigned c = 0; c < mChannels; c++)
+            CopySamples(mix + (c * SAMPLE_SIZE(floatSample)),
+               floatSample,
+               mBuffers[c].ptr(),
+               mFormat,
+               frames,
+               mHighQuality,
+               mChannels,
+               1);
+      }
+   }
+
+   unsigned mChannels;
+   bool mInterleaved;
+   sampleFormat mFormat;
+   bool mHighQuality;
+   ArrayOf<SampleBuffer> mBuffers;
+};
+
+///A real Mixer that renders in interleaved float regardless of what the
+///plug-in asked for, teeing the float master into the cache file while
+///serving the plug-in converted buffers.  A failed write just stops the
+///capture; the export itself is unaffected.
+class MixdownCaptureMixer final : public Mixer
+{
+public:
+   MixdownCaptureMixer(MixdownCacheEntry *entry,
+      const WaveTrackConstArray &inputTracks,
+      const WarpOptions &warpOptions,
+      double startTime, double stopTime,
+      unsigned numOutChannels, size_t outBufferSize, bool outInterleaved,
+      double outRate, sampleFormat outFormat, bool highQuality)
+      : Mixer(inputTracks,
+            // Throw, to stop exporting, if read fails:
+            true,
+            warpOptions, startTime, stopTime,
+            numOutChannels, outBufferSize,
+            // The master is always mixed interleaved float; conversion to
+            // the requested format happens below, as Mixer itself would
+            true, outRate, floatSample,
+            highQuality, NULL)
+      , mEntry(entry)
+      , mOut(numOutChannels, outBufferSize, outInterleaved, outFormat,
+             highQuality)
+   {
+      mCapturing = mFile.Open(entry->fileName, wxT("wb"));
+   }
+
+   bool IsOpen() const { return mFile.IsOpened(); }
+
+   size_t Process(size_t maxSamples) override
+   {
+      auto result = Mixer::Process(maxSamples);
+      if (result > 0) {
+         samplePtr mix = Mixer::GetBuffer();
+         mOut.Convert(mix, result);
+         if (mCapturing) {
+            const size_t bytes =
+               result * mOut.mChannels * SAMPLE_SIZE(floatSample);
+            if (mFile.Write(mix, bytes) != bytes)
+               // Disk trouble; continue the export uncached
+               mCapturing = false;
+            else
+               mFrames += result;
+         }
+      }
+      else if (mCapturing) {
+         // Mixed all the way to the end; the capture is good
+         mCapturing = false;
+         if (mFile.Close()) {
+            mEntry->frames = mFrames;
+            mEntry->complete = true;
+         }
+      }
+      return result;
+   }
+
+   samplePtr GetBuffer() override
+   {
+      return mOut.mBuffers[0].ptr();
+   }
+
+   samplePtr GetBuffer(int channel) override
+   {
+      return mOut.mBuffers[channel].ptr();
+   }
+
+private:
+   MixdownCacheEntry *mEntry;
+   MixdownConvertBuffers mOut;
+   wxFFile mFile;
+   sampleCount mFrames{ 0 };
+   bool mCapturing;
+};
+
+///Serves a previous capture back to an export plug-in without touching the
+///tracks at all.  Reads the float master from the cache file and converts
+///to the requested format; a short read means the file was disturbed, and
+///throws to stop the export, as a track read failure would.
+class MixdownReplayMixer final : public Mixer
+{
+public:
+   MixdownReplayMixer(const MixdownCacheEntry &entry,
+      size_t outBufferSize, bool outInterleaved,
+      double outRate, sampleFormat outFormat, bool highQuality)
+      : Mixer(entry.channels, outBufferSize, outInterleaved,
+            outRate, outFormat, entry.t0, entry.t1)
+      , mOut(entry.channels, outBufferSize, outInterleaved, outFormat,
+             highQuality)
+      , mFileName(entry.fileName)
+      , mRemaining(entry.frames)
+      , mT0(entry.t0)
+      , mT1(entry.t1)
+      , mRate(outRate)
+   {
+      mFloatBuffer.reinit(outBufferSize * entry.channels);
+      mFile.Open(mFileName, wxT("rb"));
+   }
+
+   bool IsOpen() const { return mFile.IsOpened(); }
+
+   size_t Process(size_t maxSamples) override
+   {
+      const auto frames = limitSampleBufferSize(maxSamples, mRemaining);
+      if (frames == 0)
+         return 0;
+      const size_t bytes =
+         frames * mOut.mChannels * SAMPLE_SIZE(floatSample);
+      if (mFile.Read(mFloatBuffer.get(), bytes) != bytes)
+         throw FileException{ FileException::Cause::Read,
+            wxFileName{ mFileName } };
+      mOut.Convert((samplePtr) mFloatBuffer.get(), frames);
+      mRemaining -= frames;
+      mDone += frames;
+      return frames;
+   }
+
+   samplePtr GetBuffer() override
+   {
+      return mOut.mBuffers[0].ptr();
+   }
+
+   samplePtr GetBuffer(int channel) override
+   {
+      return mOut.mBuffers[channel].ptr();
+   }
+
+   double MixGetCurrentTime() override
+   {
+      return std::min(mT1, mT0 + mDone.as_double() / mRate);
+   }
+
+private:
+   MixdownConvertBuffers mOut;
+   Floats mFloatBuffer;
+   wxFFile mFile;
+   wxString mFileName;
+   sampleCount mRemaining;
+   sampleCount mDone{ 0 };
+   double mT0, mT1, mRate;
+};
+
+} // namespace
+
 //Create a mixer by computing the time warp factor
 std::unique_ptr<Mixer> ExportPlugin::CreateMixer(const TrackList &tracks,
          bool selectionOnly,
@@ -261,8 +530,47 @@ std::unique_ptr<Mixer> ExportPlugin::CreateMixer(const TrackList &tracks,
          pTrack->SharedPointer< const WaveTrack >() );
    const auto timeTrack = *tracks.Any<const TimeTrack>().begin();
    auto envelope = timeTrack ? timeTrack->GetEnvelope() : nullptr;
+
+   // A custom channel mapping bypasses the mixdown cache
+   if (!mixerSpec) {
+      const auto key = MixdownCacheKey(inputTracks, timeTrack,
+         startTime, stopTime, numOutChannels, outRate, highQuality);
+      auto &slot = MixdownCacheSlot();
+
+      if (slot && slot->complete && slot->key == key) {
+         // Unchanged since the last export; skip straight to encoding
+         auto replay = std::make_unique<MixdownReplayMixer>(*slot,
+            outBufferSize, outInterleaved, outRate, outFormat, highQuality);
+         if (replay->IsOpen())
+            return replay;
+      }
+
+      // Mix for real and capture the result for the next export
+      slot = std::make_unique<MixdownCacheEntry>();
+      slot->key = key;
+      slot->fileName = wxFileName::CreateTempFileName(
+         FileNames::TempDir() + wxFILE_SEP_PATH + wxT("mixdown"));
+      slot->channels = numOutChannels;
+      slot->t0 = startTime;
+      slot->t1 = stopTime;
+      // MB: the stop time should not be warped, this was a bug.
+      auto capture = std::make_unique<MixdownCaptureMixer>(slot.get(),
+         inputTracks,
+         Mixer::WarpOptions(envelope),
+         startTime, stopTime,
+         numOutChannels, outBufferSize, outInterleaved,
+         outRate, outFormat, highQuality);
+      if (capture->IsOpen()) {
+         // Offline rendering: spread the tracks across the machine's cores
+         capture->SetNumWorkers(std::thread::hardware_concurrency());
+         return capture;
+      }
+      // No usable temp file; fall through and mix uncached
+      slot.reset();
+   }
+
    // MB: the stop time should not be warped, this was a bug.
-   return std::make_unique<Mixer>(inputTracks,
+   auto mixer = std::make_unique<Mixer>(inputTracks,
                   // Throw, to stop exporting, if read fails:
                   true,
                   Mixer::WarpOptions(envelope),
@@ -270,6 +578,9 @@ std::unique_ptr<Mixer> ExportPlugin::CreateMixer(const TrackList &tracks,
                   numOutChannels, outBufferSize, outInterleaved,
                   outRate, outFormat,
                   highQuality, mixerSpec);
+   // Offline rendering: spread the tracks across the machine's cores
+   mixer->SetNumWorkers(std::thread::hardware_concurrency());
+   return mixer;
 }
 
 void ExportPlugin::InitProgress(std::unique_ptr<ProgressDialog> &pDialog,
@@ -284,6 +595,80 @@ void ExportPlugin::InitProgress(std::unique_ptr<ProgressDialog> &pDialog,
    }
 }
 
+//----------------------------------------------------------------------------
+// ExportWriteAhead
+//----------------------------------------------------------------------------
+
+ExportWriteAhead::ExportWriteAhead(size_t bufferBytes, size_t depth)
+   : mSlots( std::max<size_t>(depth, 1) )
+{
+   for (auto &slot : mSlots)
+      slot.buffer.reinit(bufferBytes);
+   mWorker = std::thread( [this]{ Consume(); } );
+}
+
+ExportWriteAhead::~ExportWriteAhead()
+{
+   // Don't let a writer outlive the objects it captured
+   {
+      std::lock_guard<std::mutex> guard{ mMutex };
+      mDone = true;
+   }
+   mNotEmpty.notify_one();
+   mWorker.join();
+}
+
+void ExportWriteAhead::Consume()
+{
+   std::unique_lock<std::mutex> lock{ mMutex };
+   while (true) {
+      mNotEmpty.wait(lock, [this]{ return mQueued > 0 || mDone; });
+      if (mQueued == 0)
+         // mDone, and nothing left to do
+         return;
+      Slot &slot = mSlots[mTakeIndex];
+      if (!mFailed) {
+         // Run the writer without the lock, so Put can fill other slots
+         // meanwhile; mQueued still counts this slot, keeping it ours
+         lock.unlock();
+         const bool ok = slot.writer(slot.buffer.get(), slot.frames);
+         lock.lock();
+         if (!ok)
+            mFailed = true;
+      }
+      // else drop the block; the caller is about to learn of the failure
+      slot.writer = {};
+      mTakeIndex = (mTakeIndex + 1) % mSlots.size();
+      --mQueued;
+      mNotFull.notify_one();
+   }
+}
+
+bool ExportWriteAhead::Put(
+   const char *data, size_t bytes, size_t frames, Writer writer)
+{
+   std::unique_lock<std::mutex> lock{ mMutex };
+   mNotFull.wait(lock, [this]{ return mQueued < mSlots.size() || mFailed; });
+   if (mFailed)
+      return false;
+   Slot &slot = mSlots[mPutIndex];
+   memcpy(slot.buffer.get(), data, bytes);
+   slot.frames = frames;
+   slot.writer = std::move(writer);
+   mPutIndex = (mPutIndex + 1) % mSlots.size();
+   ++mQueued;
+   lock.unlock();
+   mNotEmpty.notify_one();
+   return true;
+}
+
+bool ExportWriteAhead::Finish()
+{
+   std::unique_lock<std::mutex> lock{ mMutex };
+   mNotFull.wait(lock, [this]{ return mQueued == 0 || mFailed; });
+   return !mFailed;
+}
+
 //----------------------------------------------------------------------------
 // Export
 //----------------------------------------------------------------------------
@@ -11,6 +11,10 @@
 #ifndef __AUDACITY_EXPORT__
 #define __AUDACITY_EXPORT__
 
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <wx/filename.h> // member variable
 #include "../SampleFormat.h"
@@ -146,6 +150,61 @@ private:
 
 using ExportPluginArray = std::vector < std::unique_ptr< ExportPlugin > > ;
 
+//----------------------------------------------------------------------------
+// ExportWriteAhead
+//----------------------------------------------------------------------------
+
+/** \brief Ring-buffered handoff of mixed blocks to a worker thread.
+ *
+ * An export loop copies each mixed block in with Put, and the given writer
+ * (the encode and file-write part of the loop) runs on a worker thread while
+ * the mixer produces the next blocks.  The blocks wait in a small ring of
+ * buffers that the worker drains strictly in order, so file writes stay
+ * sequential; Put blocks only when all slots are full, letting the mixer run
+ * several blocks ahead when encoding momentarily falls behind.  Put and
+ * Finish return false as soon as any writer has returned false; the caller
+ * then reports the error on the main thread, as the serial loops did.
+ */
+class AUDACITY_DLL_API ExportWriteAhead
+{
+public:
+   // Consumes one handed-off block of the given number of frames.
+   // Runs on the worker thread; must not touch the GUI.
+   using Writer = std::function< bool(char *data, size_t frames) >;
+
+   explicit ExportWriteAhead(size_t bufferBytes, size_t depth = 4);
+   ~ExportWriteAhead();  // waits out any outstanding writes
+
+   // Hand off one block of the given size, first waiting for a free slot
+   // in the ring; false if any previous writer failed
+   bool Put(const char *data, size_t bytes, size_t frames, Writer writer);
+
+   // Wait for all handoffs to be consumed; false if any writer failed
+   bool Finish();
+
+private:
+   struct Slot
+   {
+      ArrayOf<char> buffer;
+      size_t frames{ 0 };
+      Writer writer;
+   };
+
+   // The worker thread's loop
+   void Consume();
+
+   std::vector<Slot> mSlots;
+   size_t mPutIndex{ 0 };   // next slot Put fills
+   size_t mTakeIndex{ 0 };  // next slot the worker consumes
+   size_t mQueued{ 0 };     // filled, not yet consumed slots
+   bool mFailed{ false };
+   bool mDone{ false };     // tells the worker to exit when drained
+   std::mutex mMutex;
+   std::condition_variable mNotEmpty;  // a slot was filled, or mDone was set
+   std::condition_variable mNotFull;   // a slot was consumed
+   std::thread mWorker;
+};
+
 //----------------------------------------------------------------------------
 // Exporter
 //----------------------------------------------------------------------------
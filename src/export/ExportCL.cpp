@@ -14,6 +14,9 @@
 #include "../Audacity.h"
 #include "ExportCL.h"
 
+#include <atomic>
+#include <thread>
+
 #include "../ProjectSettings.h"
 
 #include <wx/app.h>
@@ -33,6 +36,7 @@
 
 #include "../Mix.h"
 #include "../Prefs.h"
+#include "../RingBuffer.h"
 #include "../ShuttleGui.h"
 #include "../Track.h"
 #include "../float_cast.h"
@@ -255,6 +259,116 @@ private:
    int mStatus;
 };
 
+//----------------------------------------------------------------------------
+// PipeFeeder
+//----------------------------------------------------------------------------
+
+// Capacity of the ring between the mixing loop and the writer thread.  At
+// 44100 Hz stereo this holds roughly 24 seconds of audio, enough to absorb
+// the stalls of a slow encoder without blocking the UI.
+#define PIPE_FEEDER_RING_BYTES (4 * 1024 * 1024)
+// The writer thread gathers up to this much from the ring per pipe write,
+// much larger than the 4096 byte writes the UI thread used to make.
+#define PIPE_FEEDER_CHUNK_BYTES 65536
+
+///\brief Feeds the child process's standard input from a ring buffer on a
+///dedicated thread.  The UI thread deposits mixed samples with Feed() and
+///never blocks on the pipe itself; when the ring is full, Feed() just comes
+///back short, so the caller keeps draining the child's output and updating
+///the progress dialog while the encoder catches up.
+class PipeFeeder final
+{
+public:
+   explicit PipeFeeder(wxOutputStream &stream)
+   :  mStream(stream),
+      mRing{ int16Sample, PIPE_FEEDER_RING_BYTES / SAMPLE_SIZE(int16Sample) }
+   {
+      mThread = std::thread([this]{ WriteLoop(); });
+   }
+
+   ~PipeFeeder()
+   {
+      mDone.store(true);
+      mThread.join();
+   }
+
+   ///Deposits as much of the block as fits in the ring right now and
+   ///returns the number of bytes taken.  UI thread only.
+   size_t Feed(samplePtr data, size_t len)
+   {
+      auto samples = wxMin(len / SAMPLE_SIZE(int16Sample), mRing.AvailForPut());
+      if (samples == 0) {
+         return 0;
+      }
+      return mRing.Put(data, int16Sample, samples) * SAMPLE_SIZE(int16Sample);
+   }
+
+   ///True once everything deposited so far has been written to the pipe.
+   bool Drained()
+   {
+      return mRing.AvailForGet() == 0;
+   }
+
+   ///True after a pipe write fails; the command has probably died.
+   bool Failed() const
+   {
+      return mFailed.load();
+   }
+
+   ///Stop writing and discard whatever remains in the ring, after a cancel.
+   void Abandon()
+   {
+      mFailed.store(true);
+   }
+
+private:
+   void WriteLoop()
+   {
+      ArrayOf<char> buffer{ (size_t) PIPE_FEEDER_CHUNK_BYTES };
+
+      while (true) {
+         auto avail = mRing.AvailForGet();
+         if (avail == 0) {
+            if (mDone.load()) {
+               break;
+            }
+            wxMilliSleep(10);
+            continue;
+         }
+
+         if (mFailed.load()) {
+            // Nobody wants these written; just empty the ring so the UI
+            // thread can finish up.
+            mRing.Discard(avail);
+            continue;
+         }
+
+         auto count = mRing.Get(buffer.get(),
+                                int16Sample,
+                                wxMin(avail,
+                                      (size_t) (PIPE_FEEDER_CHUNK_BYTES /
+                                                SAMPLE_SIZE(int16Sample))));
+         char *p = buffer.get();
+         size_t bytes = count * SAMPLE_SIZE(int16Sample);
+         while (bytes > 0) {
+            mStream.Write(p, bytes);
+            if (!mStream.IsOk()) {
+               mFailed.store(true);
+               break;
+            }
+            bytes -= mStream.LastWrite();
+            p += mStream.LastWrite();
+         }
+      }
+   }
+
+   wxOutputStream &mStream;
+   RingBuffer mRing;
+   std::atomic<bool> mDone{ false };
+   std::atomic<bool> mFailed{ false };
+   std::thread mThread;
+};
+
 //----------------------------------------------------------------------------
 // ExportCL
 //----------------------------------------------------------------------------
@@ -464,8 +578,13 @@ ProgressResult ExportCL::Export(AudacityProject *project,
             : _("Exporting the audio using command-line encoder") );
       auto &progress = *pDialog;
 
+      // All pipe writes from here on happen on the feeder's thread, so a
+      // full pipe stalls only the feeder
+      PipeFeeder feeder{ *os };
+
       // Start piping the mixed data to the command
-      while (updateResult == ProgressResult::Success && process.IsActive() && os->IsOk()) {
+      while (updateResult == ProgressResult::Success && process.IsActive() &&
+             !feeder.Failed()) {
          // Capture any stdout and stderr from the command
          Drain(process.GetInputStream(), &output);
          Drain(process.GetErrorStream(), &output);
@@ -491,24 +610,39 @@ ProgressResult ExportCL::Export(AudacityProject *project,
             numBytes *= SAMPLE_SIZE(int16Sample);
          }
 
-         // Don't write too much at once...pipes may not be able to handle it
-         size_t bytes = wxMin(numBytes, 4096);
-         numBytes -= bytes;
-
-         while (bytes > 0) {
-            os->Write(mixed, bytes);
-            if (!os->IsOk()) {
-               updateResult = ProgressResult::Cancelled;
-               break;
-            }
-            bytes -= os->LastWrite();
-            mixed += os->LastWrite();
+         // Deposit whatever fits in the ring; when the ring is full, keep
+         // the loop turning anyway, so the child's output stays drained and
+         // the progress dialog stays live
+         size_t taken = feeder.Feed(mixed, numBytes);
+         numBytes -= taken;
+         mixed += taken;
+         if (taken == 0) {
+            wxMilliSleep(10);
          }
 
          // Update the progress display
          updateResult = progress.Update(mixer->MixGetCurrentTime() - t0, t1 - t0);
       }
-      // Done with the progress display
+
+      // Let the feeder finish writing what was deposited before the pipe
+      // is closed, still watching the child and the cancel button
+      while (updateResult == ProgressResult::Success && process.IsActive() &&
+             !feeder.Failed() && !feeder.Drained()) {
+         Drain(process.GetInputStream(), &output);
+         Drain(process.GetErrorStream(), &output);
+         wxMilliSleep(10);
+         updateResult = progress.Update(mixer->MixGetCurrentTime() - t0, t1 - t0);
+      }
+
+      if (feeder.Failed() && updateResult == ProgressResult::Success) {
+         updateResult = ProgressResult::Cancelled;
+      }
+      else if (updateResult != ProgressResult::Success) {
+         feeder.Abandon();
+      }
+
+      // Done with the progress display.  The feeder's destructor joins its
+      // thread here, and only then does closeIt close the pipe.
    }
 
    // Wait for process to terminate
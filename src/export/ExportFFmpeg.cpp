@@ -482,6 +482,14 @@ bool ExportFFmpeg::InitCodecs(AudacityProject *project)
    mEncAudioCodecCtx->sample_fmt = AV_SAMPLE_FMT_S16;
    mEncAudioCodecCtx->strict_std_compliance = FF_COMPLIANCE_EXPERIMENTAL;
 
+   // Spread encoding over the machine's cores for codecs that support frame
+   // or slice threading.  0 lets libavcodec pick one thread per processor;
+   // codecs without threading support just ignore the setting.
+   long threads = gPrefs->Read(wxT("/FileFormats/FFmpegThreads"), (long)0);
+   if (threads < 0)
+      threads = 0;
+   mEncAudioCodecCtx->thread_count = threads;
+
    if (mEncAudioCodecCtx->codec_id == AV_CODEC_ID_AC3)
    {
       // As of Jan 4, 2011, the default AC3 encoder only accept SAMPLE_FMT_FLT samples.
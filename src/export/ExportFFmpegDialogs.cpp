@@ -98,6 +98,7 @@ extern FFmpegLibs *FFmpegLibsInst();
    FFMPEG_EXPORT_CTRL_ID_ENTRY(FEPacketSizeID), \
    FFMPEG_EXPORT_CTRL_ID_ENTRY(FEBitReservoirID), \
    FFMPEG_EXPORT_CTRL_ID_ENTRY(FEVariableBlockLenID), \
+   FFMPEG_EXPORT_CTRL_ID_ENTRY(FEThreadsID), \
    FFMPEG_EXPORT_CTRL_ID_ENTRY(FELastID), \
  \
    FFMPEG_EXPORT_CTRL_ID_ENTRY(FEFormatLabelID), \
@@ -648,6 +649,7 @@ bool FFmpegPresets::SavePreset(ExportFFmpegOptions *parent, wxString &name)
          case FEMaxPartOrderID:
          case FEMuxRateID:
          case FEPacketSizeID:
+         case FEThreadsID:
             sc = dynamic_cast<wxSpinCtrl*>(wnd);
             preset->mControlState[id - FEFirstID] = wxString::Format(wxT("%d"),sc->GetValue());
             break;
@@ -724,6 +726,7 @@ void FFmpegPresets::LoadPreset(ExportFFmpegOptions *parent, wxString &name)
          case FEMaxPartOrderID:
          case FEMuxRateID:
          case FEPacketSizeID:
+         case FEThreadsID:
             sc = dynamic_cast<wxSpinCtrl*>(wnd);
             preset->mControlState[id - FEFirstID].ToLong(&readlong);
             sc->SetValue(readlong);
@@ -1554,6 +1557,9 @@ void ExportFFmpegOptions::PopulateOrExchange(ShuttleGui & S)
                   mProfileChoice->SetSizeHints( 100,-1);
                   mProfileChoice->SetToolTip(_("AAC Profile\nLow Complexity - default\nMost players won't play anything other than LC"));
 
+                  mThreadsSpin = S.Id(FEThreadsID).TieSpinCtrl(_("Threads:"), wxT("/FileFormats/FFmpegThreads"), 0, 64, 0);
+                  mThreadsSpin->SetToolTip(_("Number of encoder threads, for codecs that support threading\n0 - automatic (one per processor)\n1 - single threaded"));
+
                }
                S.EndMultiColumn();
             }
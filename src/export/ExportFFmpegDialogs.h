@@ -263,6 +263,7 @@ private:
    wxSpinCtrl *mMaxPartitionOrderSpin;
    wxSpinCtrl *mMuxRate;
    wxSpinCtrl *mPacketSize;
+   wxSpinCtrl *mThreadsSpin;
 
    wxButton *mOk;
    wxButton *mSavePreset;
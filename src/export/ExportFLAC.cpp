@@ -371,7 +371,9 @@ ProgressResult ExportFLAC::Export(AudacityProject *project,
                             numChannels, SAMPLES_PER_RUN, false,
                             rate, format, true, mixerSpec);
 
-   ArraysOf<FLAC__int32> tmpsmplbuf{ numChannels, SAMPLES_PER_RUN, true };
+   // One contiguous widening buffer, channels in consecutive spans, so a
+   // whole mixed block can be handed to the encode thread in one piece
+   ArrayOf<FLAC__int32> tmpsmplbuf{ numChannels * SAMPLES_PER_RUN, true };
 
    InitProgress( pDialog, wxFileName(fName).GetName(),
       selectionOnly
@@ -379,6 +381,24 @@ ProgressResult ExportFLAC::Export(AudacityProject *project,
          : _("Exporting the audio as FLAC") );
    auto &progress = *pDialog;
 
+   // While the encode thread compresses one block, the mixer produces the
+   // next.  Only the worker touches the encoder until the loop is done.
+   //
+   // This single encode thread is as much concurrency as libFLAC 1.3.1
+   // permits.  FLAC frames are independent in principle, but the public API
+   // numbers frames and accumulates the STREAMINFO MD5 signature per stream,
+   // so segments compressed by separate encoder instances cannot be stitched
+   // into one valid file.  Revisit if lib-src ever picks up a libFLAC with
+   // native multi-threaded encoding.
+   ExportWriteAhead writeAhead{
+      numChannels * SAMPLES_PER_RUN * sizeof(FLAC__int32) };
+   auto writer = [&encoder, numChannels](char *data, size_t frames) {
+      FLAC__int32 *chanPtrs[ FLAC__MAX_CHANNELS ];
+      for (size_t i = 0; i < numChannels; i++)
+         chanPtrs[i] = (FLAC__int32 *)data + i * SAMPLES_PER_RUN;
+      return (bool) encoder.process(chanPtrs, frames);
+   };
+
    while (updateResult == ProgressResult::Success) {
       auto samplesThisRun = mixer->Process(SAMPLES_PER_RUN);
       if (samplesThisRun == 0) { //stop encoding
@@ -387,20 +407,21 @@ ProgressResult ExportFLAC::Export(AudacityProject *project,
       else {
          for (size_t i = 0; i < numChannels; i++) {
             samplePtr mixed = mixer->GetBuffer(i);
+            FLAC__int32 *dst = tmpsmplbuf.get() + i * SAMPLES_PER_RUN;
             if (format == int24Sample) {
                for (decltype(samplesThisRun) j = 0; j < samplesThisRun; j++) {
-                  tmpsmplbuf[i][j] = ((int *)mixed)[j];
+                  dst[j] = ((int *)mixed)[j];
                }
             }
             else {
                for (decltype(samplesThisRun) j = 0; j < samplesThisRun; j++) {
-                  tmpsmplbuf[i][j] = ((short *)mixed)[j];
+                  dst[j] = ((short *)mixed)[j];
                }
             }
          }
-         if (! encoder.process(
-               reinterpret_cast<FLAC__int32**>( tmpsmplbuf.get() ),
-               samplesThisRun) ) {
+         if (!writeAhead.Put((const char *)tmpsmplbuf.get(),
+               numChannels * SAMPLES_PER_RUN * sizeof(FLAC__int32),
+               samplesThisRun, writer)) {
             // TODO: more precise message
             AudacityMessageBox(_("Unable to export"));
             updateResult = ProgressResult::Cancelled;
@@ -412,6 +433,13 @@ ProgressResult ExportFLAC::Export(AudacityProject *project,
       }
    }
 
+   // Drain the last block before the encoder is finished below
+   if (!writeAhead.Finish() && updateResult == ProgressResult::Success) {
+      // TODO: more precise message
+      AudacityMessageBox(_("Unable to export"));
+      updateResult = ProgressResult::Cancelled;
+   }
+
    if (updateResult == ProgressResult::Success ||
        updateResult == ProgressResult::Stopped) {
 #ifndef LEGACY_FLAC
@@ -1126,6 +1126,11 @@ bool MP3Exporter::InitLibraryInternal()
    beVersion = NULL;
 #endif
 
+   //the exporter may be reused (see CachedMP3Exporter), in which case a
+   //closed-over encoder from the last stream may still be here
+   if (mGF) {
+      lame_close(mGF);
+   }
    mGF = lame_init();
    if (mGF == NULL) {
       return false;
@@ -1291,6 +1296,17 @@ int MP3Exporter::InitializeStream(unsigned channels, int sampleRate)
       return -1;
    }
 
+   //encode each stream with a fresh encoder instance, so that a reused
+   //exporter (see CachedMP3Exporter) carries no state between files.  All
+   //of the configuration below is replayed onto the NEW instance.
+   if (mGF) {
+      lame_close(mGF);
+   }
+   mGF = lame_init();
+   if (mGF == NULL) {
+      return -1;
+   }
+
    lame_set_error_protection(mGF, false);
    lame_set_num_channels(mGF, channels);
    lame_set_in_samplerate(mGF, sampleRate);
@@ -1742,6 +1758,29 @@ int ExportMP3::SetNumExportChannels()
 }
 
 
+///Returns an exporter that persists across calls.  ExportMultiple runs one
+///Export per label range; keeping the exporter alive keeps the LAME library
+///loaded and its symbols resolved, instead of repeating that per file.  The
+///encoder instance itself is renewed per stream in InitializeStream.
+static MP3Exporter &CachedMP3Exporter()
+{
+   static std::unique_ptr<MP3Exporter> sExporter;
+   static wxString sLibPath;
+
+   wxString libPath;
+   if (gPrefs) {
+      libPath = gPrefs->Read(wxT("/MP3/MP3LibPath"), wxT(""));
+   }
+
+   //the user may have pointed the prefs at a different library; start over.
+   if (!sExporter || libPath != sLibPath) {
+      sExporter = std::make_unique<MP3Exporter>();
+      sLibPath = libPath;
+   }
+
+   return *sExporter;
+}
+
 ProgressResult ExportMP3::Export(AudacityProject *project,
                        std::unique_ptr<ProgressDialog> &pDialog,
                        unsigned channels,
@@ -1758,7 +1797,7 @@ ProgressResult ExportMP3::Export(AudacityProject *project,
    wxWindow *parent = ProjectWindow::Find( project );
 #endif // DISABLE_DYNAMIC_LOADING_LAME
    const auto &tracks = TrackList::Get( *project );
-   MP3Exporter exporter;
+   MP3Exporter &exporter = CachedMP3Exporter();
 
 #ifdef DISABLE_DYNAMIC_LOADING_LAME
    if (!exporter.InitLibrary(wxT(""))) {
@@ -1769,20 +1808,22 @@ ProgressResult ExportMP3::Export(AudacityProject *project,
       return ProgressResult::Cancelled;
    }
 #else
-   if (!exporter.LoadLibrary(parent, MP3Exporter::Maybe)) {
-      AudacityMessageBox(_("Could not open MP3 encoding library!"));
-      gPrefs->Write(wxT("/MP3/MP3LibPath"), wxString(wxT("")));
-      gPrefs->Flush();
+   if (!exporter.ValidLibraryLoaded()) {
+      if (!exporter.LoadLibrary(parent, MP3Exporter::Maybe)) {
+         AudacityMessageBox(_("Could not open MP3 encoding library!"));
+         gPrefs->Write(wxT("/MP3/MP3LibPath"), wxString(wxT("")));
+         gPrefs->Flush();
 
-      return ProgressResult::Cancelled;
-   }
+         return ProgressResult::Cancelled;
+      }
 
-   if (!exporter.ValidLibraryLoaded()) {
-      AudacityMessageBox(_("Not a valid or supported MP3 encoding library!"));
-      gPrefs->Write(wxT("/MP3/MP3LibPath"), wxString(wxT("")));
-      gPrefs->Flush();
+      if (!exporter.ValidLibraryLoaded()) {
+         AudacityMessageBox(_("Not a valid or supported MP3 encoding library!"));
+         gPrefs->Write(wxT("/MP3/MP3LibPath"), wxString(wxT("")));
+         gPrefs->Flush();
 
-      return ProgressResult::Cancelled;
+         return ProgressResult::Cancelled;
+      }
    }
 #endif // DISABLE_DYNAMIC_LOADING_LAME
 
@@ -1931,49 +1972,77 @@ ProgressResult ExportMP3::Export(AudacityProject *project,
       InitProgress( pDialog, wxFileName(fName).GetName(), title );
       auto &progress = *pDialog;
 
-      while (updateResult == ProgressResult::Success) {
-         auto blockLen = mixer->Process(inSamples);
-
-         if (blockLen == 0) {
-            break;
-         }
-
-         short *mixed = (short *)mixer->GetBuffer();
-
-         if ((int)blockLen < inSamples) {
+      // While the worker thread runs LAME on the queued mixed blocks and
+      // writes the results, the mixer produces the next blocks.  Only the
+      // worker touches the encoder, the output buffer and outFile until the
+      // loop is done.
+      ExportWriteAhead writeAhead{ inSamples * channels * sizeof(short) };
+      int encoderError = 0;  // negative LAME status, set on the worker
+      auto writer = [&](char *data, size_t frames) {
+         short *mixed = (short *)data;
+         int bytesOut;
+         if ((int)frames < inSamples) {
             if (channels > 1) {
-               bytes = exporter.EncodeRemainder(mixed, blockLen, buffer.get());
+               bytesOut = exporter.EncodeRemainder(mixed, frames, buffer.get());
             }
             else {
-               bytes = exporter.EncodeRemainderMono(mixed, blockLen, buffer.get());
+               bytesOut = exporter.EncodeRemainderMono(mixed, frames, buffer.get());
             }
          }
          else {
             if (channels > 1) {
-               bytes = exporter.EncodeBuffer(mixed, buffer.get());
+               bytesOut = exporter.EncodeBuffer(mixed, buffer.get());
             }
             else {
-               bytes = exporter.EncodeBufferMono(mixed, buffer.get());
+               bytesOut = exporter.EncodeBufferMono(mixed, buffer.get());
             }
          }
 
-         if (bytes < 0) {
+         if (bytesOut < 0) {
+            encoderError = bytesOut;
+            return false;
+         }
+
+         return bytesOut <= (int)outFile.Write(buffer.get(), bytesOut);
+      };
+
+      // Report a failed handoff; called on the main thread
+      auto reportWriteError = [&] {
+         if (encoderError < 0) {
             wxString msg;
-            msg.Printf(_("Error %ld returned from MP3 encoder"), bytes);
+            msg.Printf(_("Error %ld returned from MP3 encoder"), encoderError);
             AudacityMessageBox(msg);
-            updateResult = ProgressResult::Cancelled;
-            break;
          }
-
-         if (bytes > (int)outFile.Write(buffer.get(), bytes)) {
+         else {
             // TODO: more precise message
             AudacityMessageBox(_("Unable to export"));
+         }
+      };
+
+      while (updateResult == ProgressResult::Success) {
+         auto blockLen = mixer->Process(inSamples);
+
+         if (blockLen == 0) {
+            break;
+         }
+
+         short *mixed = (short *)mixer->GetBuffer();
+
+         if (!writeAhead.Put((const char *)mixed,
+               blockLen * channels * sizeof(short), blockLen, writer)) {
+            reportWriteError();
             updateResult = ProgressResult::Cancelled;
             break;
          }
 
          updateResult = progress.Update(mixer->MixGetCurrentTime() - t0, t1 - t0);
       }
+
+      // Drain the last block before the stream is finished below
+      if (!writeAhead.Finish() && updateResult == ProgressResult::Success) {
+         reportWriteError();
+         updateResult = ProgressResult::Cancelled;
+      }
    }
 
    if ( updateResult == ProgressResult::Success ||
@@ -286,24 +286,44 @@ ProgressResult ExportOGG::Export(AudacityProject *project,
             : _("Exporting the audio as Ogg Vorbis") );
       auto &progress = *pDialog;
 
-      while (updateResult == ProgressResult::Success && !eos) {
-         float **vorbis_buffer = vorbis_analysis_buffer(&dsp, SAMPLES_PER_RUN);
-         auto samplesThisRun = mixer->Process(SAMPLES_PER_RUN);
-
+      // Mix on this thread, and run analysis, packets and pages on the
+      // write-ahead worker, so the mixer produces the next blocks while
+      // the encoder is busy.  Completed pages collect in a large output
+      // buffer and reach the file in batches, not one write per page.
+      // An Ogg page is at most about 64 KB, so after a flush any single
+      // page fits in the buffer.
+      constexpr size_t pageBufferSize = 256 * 1024;
+      ArrayOf<char> pageBuffer{ pageBufferSize };
+      size_t pageBufferUsed = 0;
+
+      auto flushPages = [&]() {
+         if (pageBufferUsed == 0)
+            return true;
+         bool ok =
+            !outFile.Write(pageBuffer.get(), pageBufferUsed).GetLastError();
+         pageBufferUsed = 0;
+         return ok;
+      };
+
+      ArrayOf<float> mixbuf{ numChannels * SAMPLES_PER_RUN };
+      ExportWriteAhead writeAhead{
+         numChannels * SAMPLES_PER_RUN * sizeof(float) };
+      auto writer = [&](char *data, size_t frames) {
          int err;
-         if (samplesThisRun == 0) {
+         if (frames == 0) {
             // Tell the library that we wrote 0 bytes - signalling the end.
             err = vorbis_analysis_wrote(&dsp, 0);
          }
          else {
+            float **vorbis_buffer = vorbis_analysis_buffer(&dsp, SAMPLES_PER_RUN);
 
             for (size_t i = 0; i < numChannels; i++) {
-               float *temp = (float *)mixer->GetBuffer(i);
+               float *temp = (float *)data + i * SAMPLES_PER_RUN;
                memcpy(vorbis_buffer[i], temp, sizeof(float)*SAMPLES_PER_RUN);
             }
 
             // tell the encoder how many samples we have
-            err = vorbis_analysis_wrote(&dsp, samplesThisRun);
+            err = vorbis_analysis_wrote(&dsp, frames);
          }
 
          // I don't understand what this call does, so here is the comment
@@ -334,12 +354,15 @@ ProgressResult ExportOGG::Export(AudacityProject *project,
                      break;
                   }
 
-                  if ( outFile.Write(page.header, page.header_len).GetLastError() ||
-                       outFile.Write(page.body, page.body_len).GetLastError()) {
-                     // TODO: more precise message
-                     AudacityMessageBox(_("Unable to export"));
-                     return ProgressResult::Cancelled;
-                  }
+                  if ((size_t)page.header_len + (size_t)page.body_len >
+                        pageBufferSize - pageBufferUsed && !flushPages())
+                     return false;
+                  memcpy(pageBuffer.get() + pageBufferUsed,
+                     page.header, page.header_len);
+                  pageBufferUsed += page.header_len;
+                  memcpy(pageBuffer.get() + pageBufferUsed,
+                     page.body, page.body_len);
+                  pageBufferUsed += page.body_len;
 
                   if (ogg_page_eos(&page)) {
                      eos = 1;
@@ -348,15 +371,48 @@ ProgressResult ExportOGG::Export(AudacityProject *project,
             }
          }
 
-         if (err) {
-            updateResult = ProgressResult::Cancelled;
-            // TODO: more precise message
-            AudacityMessageBox(_("Unable to export"));
+         return !err;
+      };
+
+      bool writeFailed = false;
+      while (updateResult == ProgressResult::Success) {
+         auto samplesThisRun = mixer->Process(SAMPLES_PER_RUN);
+
+         if (samplesThisRun == 0) {
+            // Hand off a zero-length block - the worker signals the end
+            // to the library and pages out the encoder's tail
+            writeFailed = !writeAhead.Put((const char *)mixbuf.get(), 0,
+               0, writer);
             break;
          }
 
+         for (size_t i = 0; i < numChannels; i++) {
+            float *temp = (float *)mixer->GetBuffer(i);
+            memcpy(mixbuf.get() + i * SAMPLES_PER_RUN, temp,
+               sizeof(float)*SAMPLES_PER_RUN);
+         }
+
+         writeFailed = !writeAhead.Put((const char *)mixbuf.get(),
+            numChannels * SAMPLES_PER_RUN * sizeof(float),
+            samplesThisRun, writer);
+         if (writeFailed)
+            break;
+
          updateResult = progress.Update(mixer->MixGetCurrentTime() - t0, t1 - t0);
       }
+
+      // Drain the ring, then write out whatever pages still wait in the
+      // output buffer
+      if (!writeAhead.Finish())
+         writeFailed = true;
+      if (!writeFailed && !flushPages())
+         writeFailed = true;
+
+      if (writeFailed && updateResult == ProgressResult::Success) {
+         updateResult = ProgressResult::Cancelled;
+         // TODO: more precise message
+         AudacityMessageBox(_("Unable to export"));
+      }
    }
 
    if ( !outFile.Close() ) {
@@ -557,8 +557,37 @@ ProgressResult ExportPCM::Export(AudacityProject *project,
                   formatStr) );
          auto &progress = *pDialog;
 
-         while (updateResult == ProgressResult::Success) {
+         // Pipeline the export:  while a worker thread writes one mixed
+         // block to disk, the mixer produces the next one here.  SFCall
+         // serializes all libsndfile access, so the worker's writes cannot
+         // race with anything else using the library.
+         const size_t bytesPerFrame = SAMPLE_SIZE(format) * info.channels;
+         ExportWriteAhead writeAhead{ maxBlockLen * bytesPerFrame };
+         auto writer = [&sf, format](char *data, size_t frames) {
             sf_count_t samplesWritten;
+            if (format == int16Sample)
+               samplesWritten = SFCall<sf_count_t>(sf_writef_short, sf.get(),
+                  (short *)data, frames);
+            else
+               samplesWritten = SFCall<sf_count_t>(sf_writef_float, sf.get(),
+                  (float *)data, frames);
+            return static_cast<size_t>(samplesWritten) == frames;
+         };
+
+         // Report a short write; called on the main thread
+         auto reportWriteError = [&] {
+            char buffer2[1000];
+            sf_error_str(sf.get(), buffer2, 1000);
+            AudacityMessageBox(wxString::Format(
+                                          /* i18n-hint: %s will be the error message from libsndfile, which
+                                           * is usually something unhelpful (and untranslated) like "system
+                                           * error" */
+                                          _("Error while writing %s file (disk full?).\nLibsndfile says \"%s\""),
+                                          formatStr,
+                                          wxString::FromAscii(buffer2)));
+         };
+
+         while (updateResult == ProgressResult::Success) {
             size_t numSamples = mixer->Process(maxBlockLen);
 
             if (numSamples == 0)
@@ -566,27 +595,22 @@ ProgressResult ExportPCM::Export(AudacityProject *project,
 
             samplePtr mixed = mixer->GetBuffer();
 
-            if (format == int16Sample)
-               samplesWritten = SFCall<sf_count_t>(sf_writef_short, sf.get(), (short *)mixed, numSamples);
-            else
-               samplesWritten = SFCall<sf_count_t>(sf_writef_float, sf.get(), (float *)mixed, numSamples);
-
-            if (static_cast<size_t>(samplesWritten) != numSamples) {
-               char buffer2[1000];
-               sf_error_str(sf.get(), buffer2, 1000);
-               AudacityMessageBox(wxString::Format(
-                                             /* i18n-hint: %s will be the error message from libsndfile, which
-                                              * is usually something unhelpful (and untranslated) like "system
-                                              * error" */
-                                             _("Error while writing %s file (disk full?).\nLibsndfile says \"%s\""),
-                                             formatStr,
-                                             wxString::FromAscii(buffer2)));
+            if (!writeAhead.Put(mixed, numSamples * bytesPerFrame,
+                                numSamples, writer)) {
+               reportWriteError();
                updateResult = ProgressResult::Cancelled;
                break;
             }
-            
+
             updateResult = progress.Update(mixer->MixGetCurrentTime() - t0, t1 - t0);
          }
+
+         // Drain the last write before the file is finalized below
+         if (!writeAhead.Finish() &&
+             updateResult == ProgressResult::Success) {
+            reportWriteError();
+            updateResult = ProgressResult::Cancelled;
+         }
       }
       
       // Install the WAV metata in a "LIST" chunk at the end of the file
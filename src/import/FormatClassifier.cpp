@@ -293,30 +293,40 @@ void FormatClassifier::Div(float* in, float div, size_t len)
 
 void FormatClassifier::Abs(float* in, float* out, size_t len)
 {
+   // Branch-free, so the compiler can vectorize the loop
    for (unsigned int n = 0; n < len; n++)
    {
-      if (in[n] < 0.0f)
-      {
-         out[n] = -in[n];
-      }
-      else
-      {
-         out[n] = in[n];
-      }
+      out[n] = fabs(in[n]);
    }
 }
 
 float FormatClassifier::Mean(float* in, size_t len)
 {
-   float mean = 0.0f;
+   // Stripe the sum over independent accumulators so the compiler can
+   // carry the reduction in vector registers
+   float sum0 = 0.0f;
+   float sum1 = 0.0f;
+   float sum2 = 0.0f;
+   float sum3 = 0.0f;
+
+   size_t n = 0;
+   for (; n + 4 <= len; n += 4)
+   {
+      sum0 += in[n];
+      sum1 += in[n + 1];
+      sum2 += in[n + 2];
+      sum3 += in[n + 3];
+   }
 
-   for (unsigned int n = 0; n < len; n++)
+   float mean = (sum0 + sum1) + (sum2 + sum3);
+
+   for (; n < len; n++)
    {
       mean += in[n];
    }
 
    mean /= len;
-   
+
    return mean;
 }
 
@@ -328,15 +338,23 @@ float FormatClassifier::Max(float* in, size_t len)
 
 float FormatClassifier::Max(float* in, size_t len, size_t* maxidx)
 {
+   // The first pass is a plain maximum reduction, which vectorizes;
+   // the index of the first occurrence is recovered in a second pass
    float max = -FLT_MAX;
+
+   for (unsigned int n = 0; n < len; n++)
+   {
+      max = (in[n] > max) ? in[n] : max;
+   }
+
    *maxidx = 0;
-   
+
    for (unsigned int n = 0; n < len; n++)
    {
-      if (in[n] > max)
+      if (in[n] == max)
       {
-         max = in[n];
          *maxidx = n;
+         break;
       }
    }
 
@@ -121,6 +121,7 @@ inline void GstMessageParse(ParseFn fn, GstMessage *msg, GErrorHandle &err, GstS
 // Context used for private stream data
 struct GStreamContext
 {
+   GstElement    *mQueue{};        // Decoupling queue
    GstElement    *mConv{};         // Audio converter
    GstElement    *mSink{};         // Application sink
    bool           mUse{};          // True if this stream should be imported
@@ -147,6 +148,12 @@ struct GStreamContext
       {
          gst_bin_remove(GST_BIN(mPipeline), mConv);
       }
+
+      // Remove the queue element
+      if (mQueue)
+      {
+         gst_bin_remove(GST_BIN(mPipeline), mQueue);
+      }
    }
 };
 
@@ -621,6 +628,17 @@ GStreamerImportFileHandle::OnPadAdded(GstPad *pad)
       // Done with capabilities
    }
 
+   // Create queue element.  It decouples the decoder from the rest of the
+   // chain: the decoder's streaming thread only hands buffers over and keeps
+   // decoding, while this stream's samples are converted and appended to the
+   // tracks on the queue's own thread.
+   c->mQueue = gst_element_factory_make("queue", NULL);
+   if (!c->mQueue)
+   {
+      WARN(mPipeline.get(), ("OnPadAdded: failed to create queue element"));
+      return;
+   }
+
    // Create audioconvert element
    c->mConv = gst_element_factory_make("audioconvert", NULL);
    if (!c->mConv)
@@ -659,29 +677,36 @@ GStreamerImportFileHandle::OnPadAdded(GstPad *pad)
    // Don't drop buffers...allow queue to build unfettered
    gst_app_sink_set_drop(GST_APP_SINK(c->mSink), FALSE);
 
-   // Add both elements to the pipeline
-   gst_bin_add_many(GST_BIN(mPipeline.get()), c->mConv, c->mSink, NULL);
+   // Add the elements to the pipeline
+   gst_bin_add_many(GST_BIN(mPipeline.get()), c->mQueue, c->mConv, c->mSink, NULL);
 
    // Link them together
-   if (!gst_element_link(c->mConv, c->mSink))
+   if (!gst_element_link_many(c->mQueue, c->mConv, c->mSink, NULL))
    {
-      WARN(mPipeline.get(), ("OnPadAdded: failed to link autioconvert and appsink"));
+      WARN(mPipeline.get(), ("OnPadAdded: failed to link queue, audioconvert and appsink"));
       return;
    }
 
-   // Link the audiconvert sink pad to the src pad
+   // Link the queue sink pad to the src pad
    GstPadLinkReturn ret = GST_PAD_LINK_OK;
    {
-      GstObjHandle<GstPad> convsink{ gst_element_get_static_pad(c->mConv, "sink") };
-      if (convsink)
-         ret = gst_pad_link(pad, convsink.get());
-      if (!convsink || ret != GST_PAD_LINK_OK)
+      GstObjHandle<GstPad> queuesink{ gst_element_get_static_pad(c->mQueue, "sink") };
+      if (queuesink)
+         ret = gst_pad_link(pad, queuesink.get());
+      if (!queuesink || ret != GST_PAD_LINK_OK)
       {
-         WARN(mPipeline.get(), ("OnPadAdded: failed to link uridecodebin to audioconvert - %d", ret));
+         WARN(mPipeline.get(), ("OnPadAdded: failed to link uridecodebin to queue - %d", ret));
          return;
       }
    }
 
+   // Synchronize queue state with parent
+   if (!gst_element_sync_state_with_parent(c->mQueue))
+   {
+      WARN(mPipeline.get(), ("OnPadAdded: unable to sync queue state"));
+      return;
+   }
+
    // Synchronize audioconvert state with parent
    if (!gst_element_sync_state_with_parent(c->mConv))
    {
@@ -706,17 +731,20 @@ GStreamerImportFileHandle::OnPadRemoved(GstPad *pad)
 {
    GStreamContext *c = GETCTX(pad);
 
-   // Set audioconvert and appsink states to NULL
+   // Set queue, audioconvert and appsink states to NULL
    gst_element_set_state(c->mSink, GST_STATE_NULL);
    gst_element_set_state(c->mConv, GST_STATE_NULL);
+   gst_element_set_state(c->mQueue, GST_STATE_NULL);
 
-   // Unlink audioconvert -> appsink
+   // Unlink queue -> audioconvert -> appsink
    gst_element_unlink(c->mConv, c->mSink);
+   gst_element_unlink(c->mQueue, c->mConv);
 
    // Remove the pads from the pipeilne
-   gst_bin_remove_many(GST_BIN(mPipeline.get()), c->mConv, c->mSink, NULL);
+   gst_bin_remove_many(GST_BIN(mPipeline.get()), c->mQueue, c->mConv, c->mSink, NULL);
 
    // And reset context
+   c->mQueue = NULL;
    c->mConv = NULL;
    c->mSink = NULL;
 
@@ -1034,7 +1062,7 @@ GStreamerImportFileHandle::Import(TrackFactory *trackFactory,
          // Did the user choose to skip this stream?
          if (!c->mUse)
          {
-            // Get the audioconvert sink pad and unlink
+            // Get the audioconvert sink pad and unlink it from the queue
             {
                GstObjHandle<GstPad> convsink{ gst_element_get_static_pad(c->mConv, "sink") };
 
@@ -1061,6 +1089,23 @@ GStreamerImportFileHandle::Import(TrackFactory *trackFactory,
                // Done with the pad
             }
 
+            // Unlink the queue from the decoder and take it out as well
+            if (c->mQueue)
+            {
+               {
+                  GstObjHandle<GstPad> queuesink{ gst_element_get_static_pad(c->mQueue, "sink") };
+                  GstObjHandle<GstPad> queuepeer{ gst_pad_get_peer(queuesink.get()) };
+                  if (queuepeer)
+                  {
+                     gst_pad_unlink(queuepeer.get(), queuesink.get());
+                  }
+               }
+
+               gst_element_set_state(c->mQueue, GST_STATE_NULL);
+               gst_bin_remove(GST_BIN(mPipeline.get()), c->mQueue);
+               c->mQueue = NULL;
+            }
+
             // Unlink audioconvert and appsink
             gst_element_unlink(c->mConv, c->mSink);
 
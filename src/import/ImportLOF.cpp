@@ -91,6 +91,7 @@
 #include "../ProjectWindow.h"
 #include "../FileFormats.h"
 #include "../Prefs.h"
+#include "../ondemand/ODManager.h"
 #include "../widgets/AudacityMessageBox.h"
 #include "../widgets/ProgressDialog.h"
 
@@ -247,6 +248,11 @@ ProgressResult LOFImportFileHandle::Import(
       return ProgressResult::Failed;
    }
 
+   // As with the other multiple-file import paths, hold back the on-demand
+   // waveform calculations until the whole list has been imported, so they
+   // do not compete with the remaining file imports for the disk
+   ODManager::Pauser pauser;
+
    wxString line = mTextFile->GetFirstLine();
 
    while (!mTextFile->Eof())
@@ -11,6 +11,8 @@
 #include "../Audacity.h" // for USE_* macros
 #include "ImportMIDI.h"
 
+#include <sstream>
+
 #include <wx/defs.h>
 #include <wx/ffile.h>
 #include <wx/frame.h>
@@ -84,17 +86,37 @@ bool ImportMIDI(const FilePath &fName, NoteTrack * dest)
       return false;
    }
 
+   // The Allegro parser consumes its input one istream::get() at a time,
+   // which is very slow against a file stream.  Pull the whole file into
+   // memory in a single read and parse from there instead; even large
+   // orchestral MIDI files are only a few megabytes.
+   std::string contents;
+   {
+      auto length = mf.Length();
+      if (length == wxInvalidOffset) {
+         AudacityMessageBox( wxString::Format(
+            _("Could not open file %s."), fName
+         ) );
+         mf.Close();
+         return false;
+      }
+      contents.resize(length);
+      if (mf.Read(&contents[0], length) != (size_t)length) {
+         AudacityMessageBox( wxString::Format(
+            _("Could not open file %s."), fName
+         ) );
+         mf.Close();
+         return false;
+      }
+   }
+   std::istringstream inf{ std::move(contents) };
+
    double offset = 0.0;
-   auto new_seq = std::make_unique<Alg_seq>(fName.mb_str(), is_midi, &offset);
+   auto new_seq = std::make_unique<Alg_seq>(inf, is_midi, &offset);
 
+   // Failure to open was detected above; as before, a sequence with
+   // syntax errors still imports whatever was parsed.
    //Should we also check if(seq->tracks() == 0) ?
-   if(new_seq->get_read_error() == alg_error_open){
-      AudacityMessageBox( wxString::Format(
-         _("Could not open file %s."), fName
-      ) );
-      mf.Close();
-      return false;
-   }
 
    dest->SetSequence(std::move(new_seq));
    dest->SetOffset(offset);
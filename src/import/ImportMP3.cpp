@@ -62,6 +62,10 @@ static Importer::RegisteredUnusableImportPlugin registered{
 
 #else /* USE_LIBMAD */
 
+#include <future>
+
+#include "../MemoryX.h"
+
 #include <wx/textctrl.h>
 #include <wx/file.h>
 #include <wx/thread.h>
@@ -87,6 +91,11 @@ extern "C" {
 #define INPUT_BUFFER_SIZE 65535
 #define PROGRESS_SCALING_FACTOR 100000
 
+/* how many decoded samples per channel to gather before handing them to the
+ * append worker; many libmad frames (1152 samples each) per handoff keeps the
+ * thread synchronization cost negligible */
+enum : size_t { APPEND_BATCH_SIZE = 1 << 16 };
+
 /* this is a private structure we can use for whatever we like, and it will get
  * passed to each of the callback routines, allowing us to keep track of
  * things. */
@@ -101,6 +110,9 @@ struct private_data {
    ProgressResult updateResult;
    bool id3checked;
    bool eof;      /* having supplied both underlying file and guard pad data */
+   FloatBuffers stagingBuffers;  /* decoded samples awaiting the append worker */
+   size_t stagingFill;
+   std::future<void> pendingAppend;
 };
 
 class MP3ImportPlugin final : public ImportPlugin
@@ -163,6 +175,8 @@ enum mad_flow output_cb(void *_data,
 enum mad_flow error_cb(void *_data, struct mad_stream *stream,
                        struct mad_frame *frame);
 
+void flush_staged_samples(private_data *data);
+
 /* convert libmad's fixed point representation to 16 bit signed integers. This
  * code is taken verbatim from minimad.c. */
 
@@ -220,6 +234,13 @@ ProgressResult MP3ImportFileHandle::Import(
    privateData.numChannels = 0;
    privateData.trackFactory= trackFactory;
    privateData.eof         = false;
+   privateData.stagingFill = 0;
+
+   /* don't let a deferred Append outlive the tracks if we leave early */
+   auto drainAppend = finally( [&] {
+      if (privateData.pendingAppend.valid())
+         privateData.pendingAppend.wait();
+   } );
 
    mad_decoder_init(&mDecoder, &privateData, input_cb, 0, 0, output_cb, error_cb, 0);
 
@@ -241,6 +262,12 @@ ProgressResult MP3ImportFileHandle::Import(
    /* success */
    /* wxPrintf("success\n"); */
 
+   /* append whatever is still staged and wait for the worker; exceptions
+    * from the deferred Appends propagate here, as the in-line ones did */
+   flush_staged_samples(&privateData);
+   if (privateData.pendingAppend.valid())
+      privateData.pendingAppend.get();
+
       /* copy the WaveTrack pointers into the Track pointer list that
        * we are expected to fill */
    for(const auto &channel : privateData.channels) {
@@ -517,24 +544,51 @@ enum mad_flow output_cb(void *_data,
       }
 
       /* TODO: get rid of this by adding fixed-point support to SampleFormat.
-       * For now, we allocate temporary float buffers to convert the fixed
-       * point samples into something we can feed to the WaveTrack.  Allocating
-       * big blocks of data like this isn't a great idea, but it's temporary.
-       */
-      FloatBuffers channelBuffers{ channels, samples };
+       * For now, we convert the fixed point samples into float staging
+       * buffers, and batches of many frames go to a worker thread which
+       * appends them to the tracks while we keep decoding. */
+      if (!data->stagingBuffers)
+         data->stagingBuffers.reinit(size_t(channels), size_t(APPEND_BATCH_SIZE));
+
+      if (data->stagingFill + samples > size_t(APPEND_BATCH_SIZE))
+         flush_staged_samples(data);
+
       for(size_t smpl = 0; smpl < samples; smpl++)
          for(int chn = 0; chn < channels; chn++)
-            channelBuffers[chn][smpl] = scale(pcm->samples[chn][smpl]);
-
-      for(int chn = 0; chn < channels; chn++)
-         data->channels[chn]->Append((samplePtr)channelBuffers[chn].get(),
-                                     floatSample,
-                                     samples);
+            data->stagingBuffers[chn][data->stagingFill + smpl] =
+               scale(pcm->samples[chn][smpl]);
+      data->stagingFill += samples;
 
       return MAD_FLOW_CONTINUE;
    }, MakeSimpleGuard(MAD_FLOW_BREAK) );
 }
 
+/* Hand the staged samples to a worker thread to append, so the sample format
+ * conversion, summary computation and block file writes inside Append overlap
+ * the next stretch of decoding.  At most one batch is in flight, and each
+ * waits for the previous one, which keeps the appends in stream order. */
+void flush_staged_samples(private_data *data)
+{
+   if (data->pendingAppend.valid())
+      data->pendingAppend.get();
+
+   if (data->stagingFill == 0)
+      return;
+
+   data->pendingAppend = std::async(std::launch::async,
+      [data, buffers = std::move(data->stagingBuffers),
+       samples = data->stagingFill] {
+         for (unsigned chn = 0; chn < data->numChannels; chn++)
+            data->channels[chn]->Append((samplePtr)buffers[chn].get(),
+                                        floatSample,
+                                        samples);
+      });
+
+   data->stagingBuffers.reinit(size_t(data->numChannels),
+                               size_t(APPEND_BATCH_SIZE));
+   data->stagingFill = 0;
+}
+
 enum mad_flow error_cb(void * WXUNUSED(_data), struct mad_stream * WXUNUSED(stream),
                        struct mad_frame * WXUNUSED(frame))
 {
@@ -62,6 +62,11 @@ static Importer::RegisteredUnusableImportPlugin registered{
 
 #else /* USE_LIBVORBIS */
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include <wx/log.h>
 #include <wx/string.h>
 #include <wx/utils.h>
@@ -225,8 +230,20 @@ wxString OggImportFileHandle::GetFileDescription()
 
 auto OggImportFileHandle::GetFileUncompressedBytes() -> ByteCount
 {
-   // TODO:
-   return 0;
+   // Requires a seekable stream:  libvorbisfile finds the lengths of the
+   // logical bitstreams with its bisection seek machinery, which this
+   // call also primes for later ov_pcm_seek use
+   if (!mVorbisFile || !ov_seekable(mVorbisFile.get()))
+      return 0;
+
+   ByteCount total = 0;
+   for (int i = 0; i < mVorbisFile->links; i++) {
+      auto samples = ov_pcm_total(mVorbisFile.get(), i);
+      if (samples > 0)
+         total += (ByteCount) samples *
+            mVorbisFile->vi[i].channels * SAMPLE_SIZE(mFormat);
+   }
+   return total;
 }
 
 ProgressResult OggImportFileHandle::Import(
@@ -267,15 +284,18 @@ ProgressResult OggImportFileHandle::Import(
    /* The number of bytes to get from the codec in each run */
 #define CODEC_TRANSFER_SIZE 4096u
 
+   /* The number of decoded bytes to accumulate before each handoff to the
+    * appending thread; many codec transfers make one Append */
+#define CHUNK_TRANSFER_SIZE (256 * 1024u)
+
    /* The number of samples to read between calls to the callback.
     * Balance between responsiveness of the GUI and throughput of import. */
 #define SAMPLES_PER_CALLBACK 100000
 
    auto updateResult = ProgressResult::Success;
    long bytesRead = 0;
+   int holes = 0;
    {
-      ArrayOf<short> mainBuffer{ CODEC_TRANSFER_SIZE };
-
       /* determine endianness (clever trick courtesy of Nicholas Devillard,
        * (http://www.eso.org/~ndevilla/endian/) */
       int testvar = 1, endian;
@@ -284,72 +304,189 @@ ProgressResult OggImportFileHandle::Import(
       else
          endian = 1;  // big endian
 
-      /* number of samples currently in each channel's buffer */
-      long samplesRead = 0;
-      int bitstream = 0;
-      int samplesSinceLastCallback = 0;
-
-      // You would think that the stream would already be seeked to 0, and
-      // indeed it is if the file is legit.  But I had several ogg files on
-      // my hard drive that have malformed headers, and this added call
-      // causes them to be read correctly.  Otherwise they have lots of
-      // zeros inserted at the beginning
-      ov_pcm_seek(mVorbisFile.get(), 0);
-
-      do {
-         /* get data from the decoder */
-         bytesRead = ov_read(mVorbisFile.get(), (char *)mainBuffer.get(),
-            CODEC_TRANSFER_SIZE,
-            endian,
-            2,    // word length (2 for 16 bit samples)
-            1,    // signed
-            &bitstream);
-
-         if (bytesRead == OV_HOLE) {
-            wxFileName ff(mFilename);
-            wxLogError(wxT("Ogg Vorbis importer: file %s is malformed, ov_read() reported a hole"),
-               ff.GetFullName());
-            /* http://lists.xiph.org/pipermail/vorbis-dev/2001-February/003223.html
-             * is the justification for doing this - best effort for malformed file,
-             * hence the message.
-             */
-            continue;
+      // A decode thread runs ov_read ahead of this thread, which stays
+      // the sole caller of WaveTrack::Append.  Each handoff accumulates
+      // many codec transfers of one logical bitstream, so the tracks
+      // grow by large appends instead of one per ov_read, and double
+      // buffering lets the decoder fill the next chunk while this
+      // thread files the previous one.
+      struct Chunk {
+         ArrayOf<short> data;
+         size_t frames{ 0 };
+         int bitstream{ 0 };
+         double time{ 0.0 };
+         double total{ 0.0 };
+      };
+      constexpr size_t transferShorts = CODEC_TRANSFER_SIZE / sizeof(short);
+      constexpr size_t chunkShorts = CHUNK_TRANSFER_SIZE / sizeof(short);
+      constexpr size_t maxQueuedChunks = 2;
+
+      std::mutex mutex;
+      std::condition_variable cv;
+      std::deque<Chunk> chunks;
+      bool done = false;
+      bool cancelled = false;
+      std::exception_ptr pException;
+
+      std::thread decoder( [&] {
+         auto vf = mVorbisFile.get();
+
+         // You would think that the stream would already be seeked to 0, and
+         // indeed it is if the file is legit.  But I had several ogg files on
+         // my hard drive that have malformed headers, and this added call
+         // causes them to be read correctly.  Otherwise they have lots of
+         // zeros inserted at the beginning
+         ov_pcm_seek(vf, 0);
+
+         try {
+            ArrayOf<short> transfer{ transferShorts };
+            size_t pending = 0;     // decoded shorts awaiting the next chunk
+            int pendingBitstream = 0;
+            int bitstream = 0;
+            bool eof = false;
+
+            while (!eof || pending > 0) {
+               Chunk chunk;
+               chunk.data.reinit(chunkShorts);
+               chunk.bitstream = pending > 0 ? pendingBitstream : bitstream;
+               size_t used = 0;
+               if (pending > 0) {
+                  memcpy(chunk.data.get(), transfer.get(),
+                     pending * sizeof(short));
+                  used = pending;
+                  pending = 0;
+               }
+
+               while (!eof && chunkShorts - used >= transferShorts) {
+                  /* get data from the decoder */
+                  bytesRead = ov_read(vf, (char *)transfer.get(),
+                     CODEC_TRANSFER_SIZE,
+                     endian,
+                     2,    // word length (2 for 16 bit samples)
+                     1,    // signed
+                     &bitstream);
+
+                  if (bytesRead == OV_HOLE) {
+                     /* http://lists.xiph.org/pipermail/vorbis-dev/2001-February/003223.html
+                      * is the justification for doing this - best effort for malformed file,
+                      * hence the message.
+                      */
+                     ++holes;
+                     continue;
+                  }
+                  else if (bytesRead <= 0) {
+                     /* Malformed Ogg Vorbis file, or the end of it. */
+                     eof = true;
+                     break;
+                  }
+
+                  if (bitstream != chunk.bitstream) {
+                     if (used == 0)
+                        chunk.bitstream = bitstream;
+                     else {
+                        /* the next logical bitstream starts a NEW chunk */
+                        pending = bytesRead / sizeof(short);
+                        pendingBitstream = bitstream;
+                        break;
+                     }
+                  }
+
+                  memcpy(chunk.data.get() + used, transfer.get(), bytesRead);
+                  used += bytesRead / sizeof(short);
+               }
+
+               if (used == 0)
+                  continue;
+
+               chunk.frames =
+                  used / mVorbisFile->vi[chunk.bitstream].channels;
+               chunk.time = ov_time_tell(vf);
+               chunk.total = ov_time_total(vf, chunk.bitstream);
+
+               {
+                  std::unique_lock<std::mutex> lock{ mutex };
+                  cv.wait(lock, [&]{
+                     return cancelled || chunks.size() < maxQueuedChunks; });
+                  if (cancelled)
+                     return;
+                  chunks.push_back(std::move(chunk));
+               }
+               cv.notify_all();
+            }
          }
-         else if (bytesRead < 0) {
-            /* Malformed Ogg Vorbis file. */
-            /* TODO: Return some sort of meaningful error. */
-            wxLogError(wxT("Ogg Vorbis importer: ov_read() returned error %i"),
-               bytesRead);
-            break;
+         catch ( ... ) {
+            pException = std::current_exception();
          }
 
-         samplesRead = bytesRead / mVorbisFile->vi[bitstream].channels / sizeof(short);
+         {
+            std::lock_guard<std::mutex> lock{ mutex };
+            done = true;
+         }
+         cv.notify_all();
+      } );
+
+      int samplesSinceLastCallback = 0;
+
+      for (;;) {
+         Chunk chunk;
+         {
+            std::unique_lock<std::mutex> lock{ mutex };
+            cv.wait(lock, [&]{ return done || !chunks.empty(); });
+            if (chunks.empty())
+               break;
+            chunk = std::move(chunks.front());
+            chunks.pop_front();
+         }
+         cv.notify_all();
 
          /* give the data to the wavetracks */
+         const int channels = mVorbisFile->vi[chunk.bitstream].channels;
          auto iter = mChannels.begin();
-         std::advance(iter, bitstream);
-         if (mStreamUsage[bitstream] != 0)
+         std::advance(iter, chunk.bitstream);
+         if (mStreamUsage[chunk.bitstream] != 0)
          {
             auto iter2 = iter->begin();
-            for (int c = 0; c < mVorbisFile->vi[bitstream].channels; ++iter2, ++c)
-               iter2->get()->Append((char *)(mainBuffer.get() + c),
+            for (int c = 0; c < channels; ++iter2, ++c)
+               iter2->get()->Append((char *)(chunk.data.get() + c),
                int16Sample,
-               samplesRead,
-               mVorbisFile->vi[bitstream].channels);
+               chunk.frames,
+               channels);
          }
 
-         samplesSinceLastCallback += samplesRead;
+         samplesSinceLastCallback += chunk.frames;
          if (samplesSinceLastCallback > SAMPLES_PER_CALLBACK) {
-            updateResult = mProgress->Update(ov_time_tell(mVorbisFile.get()),
-               ov_time_total(mVorbisFile.get(), bitstream));
+            updateResult = mProgress->Update(chunk.time, chunk.total);
             samplesSinceLastCallback -= SAMPLES_PER_CALLBACK;
+            if (updateResult != ProgressResult::Success) {
+               {
+                  std::lock_guard<std::mutex> lock{ mutex };
+                  cancelled = true;
+               }
+               cv.notify_all();
+               break;
+            }
          }
-      } while (updateResult == ProgressResult::Success && bytesRead != 0);
+      }
+
+      decoder.join();
+      if (pException)
+         std::rethrow_exception(pException);
+   }
+
+   if (holes > 0) {
+      wxFileName ff(mFilename);
+      wxLogError(wxT("Ogg Vorbis importer: file %s is malformed, ov_read() reported %d holes"),
+         ff.GetFullName(), holes);
    }
 
    auto res = updateResult;
-   if (bytesRead < 0)
+   if (bytesRead < 0) {
+     /* Malformed Ogg Vorbis file. */
+     /* TODO: Return some sort of meaningful error. */
+     wxLogError(wxT("Ogg Vorbis importer: ov_read() returned error %i"),
+        bytesRead);
      res = ProgressResult::Failed;
+   }
 
    if (res == ProgressResult::Failed || res == ProgressResult::Cancelled) {
       return res;
@@ -58,6 +58,9 @@
 #include "ImportPlugin.h"
 
 #include <algorithm>
+#include <future>
+
+#include "../MemoryX.h"
 
 #ifdef USE_LIBID3TAG
    #include <id3tag.h>
@@ -484,9 +487,14 @@ ProgressResult PCMImportFileHandle::Import(TrackFactory *trackFactory,
       if (maxBlock < 1)
          return ProgressResult::Failed;
 
-      SampleBuffer srcbuffer, buffer;
+      // Two source buffers:  a worker thread reads (and for compressed
+      // subtypes, decodes) the next chunk through libsndfile into one while
+      // this thread deinterleaves the previous chunk from the other and
+      // appends it, with its summary computation and block file writes
+      SampleBuffer srcbuffer[2], buffer;
       wxASSERT(mInfo.channels >= 0);
-      while (NULL == srcbuffer.Allocate(maxBlock * mInfo.channels, mFormat).ptr() ||
+      while (NULL == srcbuffer[0].Allocate(maxBlock * mInfo.channels, mFormat).ptr() ||
+             NULL == srcbuffer[1].Allocate(maxBlock * mInfo.channels, mFormat).ptr() ||
              NULL == buffer.Allocate(maxBlock, mFormat).ptr())
       {
          maxBlock /= 2;
@@ -494,42 +502,67 @@ ProgressResult PCMImportFileHandle::Import(TrackFactory *trackFactory,
             return ProgressResult::Failed;
       }
 
+      auto readBlock = [this, maxBlock](samplePtr dst) -> long {
+         if (mFormat == int16Sample)
+            return SFCall<sf_count_t>(sf_readf_short, mFile.get(), (short *)dst, maxBlock);
+         //import 24 bit int as float and have the append function convert it.  This is how PCMAliasBlockFile works too.
+         else
+            return SFCall<sf_count_t>(sf_readf_float, mFile.get(), (float *)dst, maxBlock);
+      };
+
       decltype(fileTotalFrames) framescompleted = 0;
 
+      int cur = 0;
+      std::future<long> pendingRead = std::async(
+         std::launch::async, readBlock, srcbuffer[cur].ptr());
+
+      // Don't let a read outlive the buffers if we leave early
+      auto drainRead = finally( [&] {
+         if (pendingRead.valid())
+            pendingRead.wait();
+      } );
+
       long block;
       do {
-         block = maxBlock;
-
-         if (mFormat == int16Sample)
-            block = SFCall<sf_count_t>(sf_readf_short, mFile.get(), (short *)srcbuffer.ptr(), block);
-         //import 24 bit int as float and have the append function convert it.  This is how PCMAliasBlockFile works too.
-         else
-            block = SFCall<sf_count_t>(sf_readf_float, mFile.get(), (float *)srcbuffer.ptr(), block);
+         block = pendingRead.get();
 
          if(block < 0 || block > (long)maxBlock) {
             wxASSERT(false);
             block = maxBlock;
          }
 
+         if (block > 0)
+            // Start fetching the next chunk before consuming this one
+            pendingRead = std::async(
+               std::launch::async, readBlock, srcbuffer[1 - cur].ptr());
+
          if (block) {
             auto iter = channels.begin();
             for(int c=0; c<mInfo.channels; ++iter, ++c) {
-               if (mFormat==int16Sample) {
+               samplePtr bufptr;
+               if (mInfo.channels == 1)
+                  // No deinterleaving needed; append in place
+                  bufptr = srcbuffer[cur].ptr();
+               else if (mFormat==int16Sample) {
                   for(int j=0; j<block; j++)
                      ((short *)buffer.ptr())[j] =
-                        ((short *)srcbuffer.ptr())[mInfo.channels*j+c];
+                        ((short *)srcbuffer[cur].ptr())[mInfo.channels*j+c];
+                  bufptr = buffer.ptr();
                }
                else {
                   for(int j=0; j<block; j++)
                      ((float *)buffer.ptr())[j] =
-                        ((float *)srcbuffer.ptr())[mInfo.channels*j+c];
+                        ((float *)srcbuffer[cur].ptr())[mInfo.channels*j+c];
+                  bufptr = buffer.ptr();
                }
 
-               iter->get()->Append(buffer.ptr(), (mFormat == int16Sample)?int16Sample:floatSample, block);
+               iter->get()->Append(bufptr, (mFormat == int16Sample)?int16Sample:floatSample, block);
             }
             framescompleted += block;
          }
 
+         cur = 1 - cur;
+
          updateResult = mProgress->Update(
             framescompleted.as_long_long(),
             fileTotalFrames.as_long_long()
@@ -41,11 +41,16 @@ MultiFormatReader::MultiFormatReader(const char* filename)
    : mpFid(NULL)
 {
    mpFid = fopen(filename, "rb");
-      
+
    if (mpFid == NULL)
    {
       throw std::runtime_error("Error opening file");
    }
+
+   // Give stdio a sizable buffer.  The format classifier rewinds and
+   // re-reads the head of the file once per candidate format, so most of
+   // these reads then come from the buffer instead of the disk.
+   setvbuf(mpFid, NULL, _IOFBF, 1 << 20);
 }
 
 MultiFormatReader::~MultiFormatReader()
@@ -114,13 +119,26 @@ size_t MultiFormatReader::Read(void* buffer, size_t size, size_t len, size_t str
    
    if (stride > 1)
    {
-      // There are gaps between consecutive samples,
-      // so do a scattered read
+      // There are gaps between consecutive samples.  Read the whole run in
+      // one call and pick the samples out of it, rather than alternating a
+      // tiny fread with an fseek per sample, which costs two libc calls
+      // for every sample read.
+      size_t total = size * stride * len;
+      if (mScatterBuffer.size() < total)
+      {
+         mScatterBuffer.resize(total);
+      }
+
+      size_t bytes = fread(mScatterBuffer.data(), 1, total, mpFid);
       for (size_t n = 0; n < len; n++)
       {
-         actRead += fread(&(pWork[n*size]), size, 1, mpFid);
-         // FIXME: TRAP_ERR fseek return in MultiFormatReader unchecked.
-         fseek(mpFid, (stride - 1) * size, SEEK_CUR);
+         if ((n * stride + 1) * size > bytes)
+         {
+            // The run ended inside this sample
+            break;
+         }
+         memcpy(&(pWork[n * size]), &(mScatterBuffer[n * stride * size]), size);
+         actRead++;
       }
    }
    else
@@ -136,21 +154,56 @@ size_t MultiFormatReader::Read(void* buffer, size_t size, size_t len, size_t str
 void MultiFormatReader::SwapBytes(void* buffer, size_t size, size_t len)
 {
    uint8_t* pResBuffer = (uint8_t*) buffer;
-   uint8_t* pCurBuffer;
-   
+
    if (size > 8)
    {
       throw std::runtime_error("SwapBytes Exception: Format width exceeding 8 bytes.");
    }
-   
-   for (size_t i = 0; i < len; i++)
+
+   // Word-wide kernels for the common widths; simple enough for the
+   // compiler to vectorize.  The samples start at the head of a heap
+   // allocation, so the casts are aligned.
+   if (size == 2)
+   {
+      uint16_t* p = (uint16_t*) buffer;
+      for (size_t i = 0; i < len; i++)
+      {
+         uint16_t v = p[i];
+         p[i] = (uint16_t)((v << 8) | (v >> 8));
+      }
+   }
+   else if (size == 4)
+   {
+      uint32_t* p = (uint32_t*) buffer;
+      for (size_t i = 0; i < len; i++)
+      {
+         uint32_t v = p[i];
+         p[i] = (v << 24) | ((v & 0xff00) << 8) | ((v >> 8) & 0xff00) | (v >> 24);
+      }
+   }
+   else if (size == 8)
+   {
+      uint64_t* p = (uint64_t*) buffer;
+      for (size_t i = 0; i < len; i++)
+      {
+         uint64_t v = p[i];
+         v = ((v & 0x00ff00ff00ff00ffULL) << 8) | ((v >> 8) & 0x00ff00ff00ff00ffULL);
+         v = ((v & 0x0000ffff0000ffffULL) << 16) | ((v >> 16) & 0x0000ffff0000ffffULL);
+         p[i] = (v << 32) | (v >> 32);
+      }
+   }
+   else
    {
-      pCurBuffer = &(pResBuffer[i*size]);
-      memcpy(mSwapBuffer, &(pCurBuffer[0]), size);
-      
-      for (size_t n = 0; n < size; n++)
+      // Odd widths, reverse in place
+      for (size_t i = 0; i < len; i++)
       {
-         pCurBuffer[n] = mSwapBuffer[size - n - 1];   
+         uint8_t* pCurBuffer = &(pResBuffer[i * size]);
+         for (size_t n = 0; n < size / 2; n++)
+         {
+            uint8_t tmp = pCurBuffer[n];
+            pCurBuffer[n] = pCurBuffer[size - n - 1];
+            pCurBuffer[size - n - 1] = tmp;
+         }
       }
    }
 }
@@ -13,6 +13,7 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <vector>
 
 class MachineEndianness
 {
@@ -48,9 +49,10 @@ private:
 
 class MultiFormatReader
 {
-   FILE* mpFid;   
+   FILE* mpFid;
    MachineEndianness mEnd;
-   uint8_t mSwapBuffer[8];
+   // Scratch space for strided reads, which fetch the whole run in one call
+   std::vector<uint8_t> mScatterBuffer;
 
 public:
    typedef enum
@@ -23,6 +23,10 @@
 #include <string.h>
 #include <math.h>
 
+#include <future>
+#include <thread>
+#include <vector>
+
 #include <wx/defs.h>
 #include <wx/ffile.h>
 
@@ -41,10 +45,32 @@ static float AmpStat(float *data, size_t len)
 
    /* Calculate standard deviation of the amplitudes */
 
-   sum = 0.0;
-   sumofsquares = 0.0;
+   /* Stripe the sums over four independent accumulators so the compiler
+    * can carry the reductions in vector registers */
+
+   float sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+   float sqr0 = 0.0, sqr1 = 0.0, sqr2 = 0.0, sqr3 = 0.0;
+
+   size_t i = 0;
+   for (; i + 4 <= len; i += 4) {
+      float x0 = fabs(data[i]);
+      float x1 = fabs(data[i + 1]);
+      float x2 = fabs(data[i + 2]);
+      float x3 = fabs(data[i + 3]);
+      sum0 += x0;
+      sum1 += x1;
+      sum2 += x2;
+      sum3 += x3;
+      sqr0 += x0 * x0;
+      sqr1 += x1 * x1;
+      sqr2 += x2 * x2;
+      sqr3 += x3 * x3;
+   }
+
+   sum = (sum0 + sum1) + (sum2 + sum3);
+   sumofsquares = (sqr0 + sqr1) + (sqr2 + sqr3);
 
-   for (size_t i = 0; i < len; i++) {
+   for (; i < len; i++) {
       float x = fabs(data[i]);
       sum += x;
       sumofsquares += x * x;
@@ -66,28 +92,68 @@ static float JumpStat(float *data, size_t len)
     * A score near 1.0 means avg jump is pretty small
     */
 
-   avg = 0.0;
-   for (size_t i = 0; i + 1 < len; i++)
+   /* Striped accumulators, as in AmpStat, so the loop vectorizes */
+
+   float sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+
+   size_t i = 0;
+   for (; i + 5 <= len; i += 4) {
+      sum0 += fabs(data[i + 1] - data[i]);
+      sum1 += fabs(data[i + 2] - data[i + 1]);
+      sum2 += fabs(data[i + 3] - data[i + 2]);
+      sum3 += fabs(data[i + 4] - data[i + 3]);
+   }
+
+   avg = (sum0 + sum1) + (sum2 + sum3);
+   for (; i + 1 < len; i++)
       avg += fabs(data[i + 1] - data[i]);
    avg = 1.0 - (avg / (len - 1) / 2.0);
 
    return avg;
 }
 
+/* The change of the second difference at position i, with the same
+ * differencing and rounding steps as the recurrence it replaced */
+static inline float ThirdDiff(const float *data, size_t i)
+{
+   float v1 = data[i] - data[i - 1];
+   float v2 = data[i - 1] - data[i - 2];
+   float v3 = data[i - 2] - data[i - 3];
+   return fabs((v1 - v2) - (v2 - v3));
+}
+
 static float SecondDStat(float *data, size_t len)
 {
-   float v1=0, v2=0;
-   float a1=0, a2=0;
-   float sum=0;
-
-   for (size_t i = 1; i < len; i++) {
-      a2 = a1;
-      v2 = v1;
-      v1 = data[i]-data[i-1];
-      a1 = v1 - v2;
-      sum += fabs(a1-a2);
+   float sum = 0;
+
+   /* The velocities and accelerations used to be carried from one
+    * iteration to the next; expressing each term from the data alone
+    * removes the loop dependencies so the compiler can vectorize.
+    * The first two terms see the zero-initialized state instead of
+    * earlier samples and are handled separately. */
+
+   if (len >= 2)
+      sum += fabs(data[1] - data[0]);
+   if (len >= 3) {
+      float v1 = data[2] - data[1];
+      float v2 = data[1] - data[0];
+      sum += fabs((v1 - v2) - v2);
    }
 
+   float sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+
+   size_t i = 3;
+   for (; i + 4 <= len; i += 4) {
+      sum0 += ThirdDiff(data, i);
+      sum1 += ThirdDiff(data, i + 1);
+      sum2 += ThirdDiff(data, i + 2);
+      sum3 += ThirdDiff(data, i + 3);
+   }
+
+   sum += (sum0 + sum1) + (sum2 + sum3);
+   for (; i < len; i++)
+      sum += ThirdDiff(data, i);
+
    return sum/len;
 }
 
@@ -95,10 +161,13 @@ static float RedundantStereo(float *data, size_t len)
 {
    int c = 0;
 
-   for (size_t i = 1; i + 1 < len; i += 2)
-      if (fabs(data[i + 1] - data[i]) > 2*fabs(data[i] - data[i - 1]) ||
-          2*fabs(data[i + 1] - data[i]) < fabs(data[i] - data[i - 1]))
-         c++;
+   /* Count, rather than branch on, the per-frame test so that the
+    * loop vectorizes */
+   for (size_t i = 1; i + 1 < len; i += 2) {
+      float within = fabs(data[i] - data[i - 1]);
+      float across = fabs(data[i + 1] - data[i]);
+      c += (across > 2*within) | (2*across < within);
+   }
 
    return ((c * 2.0) / (len - 2));
 }
@@ -286,6 +355,75 @@ static void Extract(bool bits16,
    *len2 = dataCount2;
 }
 
+/* One (precision, endianness, offset) interpretation of the raw bytes,
+ * and the votes it collects over the test buffers */
+struct FloatCandidate {
+   unsigned prec;
+   int endian;
+   size_t offset;
+   unsigned finiteVotes;
+   unsigned maxminVotes;
+   float smoothAvg;
+};
+
+static void EvaluateFloatCandidate(FloatCandidate &cand,
+                                   unsigned numTests,
+                                   const ArrayOf<char> rawData[],
+                                   size_t dataSize,
+                                   float *data1, float *data2)
+{
+   size_t len1;
+   size_t len2;
+
+   cand.finiteVotes = 0;
+   cand.maxminVotes = 0;
+   cand.smoothAvg = 0;
+
+   for(unsigned test = 0; test < numTests; test++) {
+      float min, max;
+
+      ExtractFloats(cand.prec == 1, cand.endian == 1,
+                    true, /* stereo */
+                    cand.offset,
+                    rawData[test].get(), dataSize,
+                    data1, data2, &len1, &len2);
+
+      size_t i = 0;
+      for(; i < len1; i++)
+         // This code is testing for NaNs.
+         // We'd like to know if all data is finite.
+         if (!(data1[i]>=0 || data1[i]<=0) ||
+             !(data2[i]>=0 || data2[i]<=0))
+            break;
+      if (i == len1)
+         // all data is finite.
+         cand.finiteVotes++;
+
+      min = data1[0];
+      max = data1[0];
+      for(i = 1; i < len1; i++) {
+         if (data1[i]<min)
+            min = data1[i];
+         if (data1[i]>max)
+            max = data1[i];
+      }
+      for(i = 1; i < len2; i++) {
+         if (data2[i]<min)
+            min = data2[i];
+         if (data2[i]>max)
+            max = data2[i];
+      }
+
+      if (min < -0.01 && min >= -100000 &&
+          max > 0.01 && max <= 100000)
+         cand.maxminVotes++;
+
+      cand.smoothAvg += SecondDStat(data1, len1) / max;
+   }
+
+   cand.smoothAvg /= numTests;
+}
+
 static int GuessFloatFormats(unsigned numTests, const ArrayOf<char> rawData[], size_t dataSize,
                              size_t *out_offset, unsigned *out_channels)
 {
@@ -326,79 +464,53 @@ static int GuessFloatFormats(unsigned numTests, const ArrayOf<char> rawData[], s
     * floats with a 1-byte offset.
     */
 
-   for(unsigned int prec = 0; prec < 2; prec++) {
-      for(int endian = 0; endian < 2; endian++) {
-         for(size_t offset = 0; offset < (4 * prec + 4); offset++) {
-            unsigned finiteVotes = 0;
-            unsigned maxminVotes = 0;
-            float smoothAvg = 0;
-
-           #if RAW_GUESS_DEBUG
-            wxFprintf(af, "prec=%d endian=%d offset=%d\n",
-                    prec, endian, (int)offset);
-           #endif
-
-            for(unsigned test = 0; test < numTests; test++) {
-               float min, max;
-
-               ExtractFloats(prec == 1, endian == 1,
-                             true, /* stereo */
-                             offset,
-                             rawData[test].get(), dataSize,
-                             data1.get(), data2.get(), &len1, &len2);
-
-               size_t i = 0;
-               for(; i < len1; i++)
-                  // This code is testing for NaNs.
-                  // We'd like to know if all data is finite.
-                  if (!(data1[i]>=0 || data1[i]<=0) ||
-                      !(data2[i]>=0 || data2[i]<=0))
-                     break;
-               if (i == len1)
-                  // all data is finite.
-                  finiteVotes++;
-
-               min = data1[0];
-               max = data1[0];
-               for(i = 1; i < len1; i++) {
-                  if (data1[i]<min)
-                     min = data1[i];
-                  if (data1[i]>max)
-                     max = data1[i];
-               }
-               for(i = 1; i < len2; i++) {
-                  if (data2[i]<min)
-                     min = data2[i];
-                  if (data2[i]>max)
-                     max = data2[i];
-               }
-
-               if (min < -0.01 && min >= -100000 &&
-                   max > 0.01 && max <= 100000)
-                  maxminVotes++;
-
-               smoothAvg += SecondDStat(data1.get(), len1) / max;
-            }
-
-            smoothAvg /= numTests;
-
-           #if RAW_GUESS_DEBUG
-            wxFprintf(af, "finite: %ud/%ud maxmin: %ud/%ud smooth: %f\n",
-                    finiteVotes, numTests, maxminVotes, numTests,
-                    smoothAvg);
-           #endif
-
-            if (finiteVotes > numTests/2 &&
-                finiteVotes > numTests-2 &&
-                maxminVotes > numTests/2 &&
-                smoothAvg < bestSmoothAvg) {
-
-               bestSmoothAvg = smoothAvg;
-               bestOffset = offset;
-               bestPrec = prec;
-               bestEndian = endian;
-            }
-         }
+   /* Enumerate the candidate interpretations up front, then score them
+    * concurrently.  The raw test buffers are only read; each worker owns
+    * its extraction buffers, so the candidates are independent.  The
+    * reduction below stays sequential and deterministic. */
+
+   std::vector<FloatCandidate> candidates;
+   for(unsigned int prec = 0; prec < 2; prec++)
+      for(int endian = 0; endian < 2; endian++)
+         for(size_t offset = 0; offset < (4 * prec + 4); offset++)
+            candidates.push_back({ prec, endian, offset, 0, 0, 0 });
+
+   const unsigned nWorkers = (unsigned) std::min<size_t>(
+      std::max(1u, std::thread::hardware_concurrency()),
+      candidates.size());
+   std::vector<std::future<void>> workers;
+   workers.reserve(nWorkers);
+   for (unsigned w = 0; w < nWorkers; w++)
+      workers.push_back(std::async(std::launch::async,
+         [&candidates, nWorkers, w, numTests, rawData, dataSize]{
+            ArrayOf<float> buf1{ dataSize + 4 };
+            ArrayOf<float> buf2{ dataSize + 4 };
+            for (size_t c = w; c < candidates.size(); c += nWorkers)
+               EvaluateFloatCandidate(candidates[c], numTests,
+                  rawData, dataSize, buf1.get(), buf2.get());
+         }));
+   for (auto &worker : workers)
+      worker.get();
+
+   for (const auto &cand : candidates) {
+
+     #if RAW_GUESS_DEBUG
+      wxFprintf(af, "prec=%d endian=%d offset=%d\n",
+              cand.prec, cand.endian, (int)cand.offset);
+      wxFprintf(af, "finite: %ud/%ud maxmin: %ud/%ud smooth: %f\n",
+              cand.finiteVotes, numTests, cand.maxminVotes, numTests,
+              cand.smoothAvg);
+     #endif
+
+      if (cand.finiteVotes > numTests/2 &&
+          cand.finiteVotes > numTests-2 &&
+          cand.maxminVotes > numTests/2 &&
+          cand.smoothAvg < bestSmoothAvg) {
+
+         bestSmoothAvg = cand.smoothAvg;
+         bestOffset = cand.offset;
+         bestPrec = cand.prec;
+         bestEndian = cand.endian;
       }
    }
 
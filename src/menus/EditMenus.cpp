@@ -319,6 +319,9 @@ void OnDelete(const CommandContext &context)
    auto &selectedRegion = ViewInfo::Get( project ).selectedRegion;
    auto &window = ProjectWindow::Get( project );
 
+   // Coalesce the notifications of the many mutations below
+   TrackList::EventBatch batch{ tracks };
+
    for (auto n : tracks.Any()) {
       if (n->GetSelected() || n->IsSyncLockSelected()) {
          n->Clear(selectedRegion.t0(), selectedRegion.t1());
@@ -642,6 +645,9 @@ void OnDuplicate(const CommandContext &context)
    auto &selectedRegion = ViewInfo::Get( project ).selectedRegion;
    auto &window = ProjectWindow::Get( project );
 
+   // Coalesce the notifications of the many mutations below
+   TrackList::EventBatch batch{ tracks };
+
    // This iteration is unusual because we add to the list inside the loop
    auto range = tracks.Selected();
    auto last = *range.rbegin();
@@ -676,6 +682,9 @@ void OnSplitCut(const CommandContext &context)
 
    Track::Holder dest;
 
+   // Coalesce the notifications of the many mutations below
+   TrackList::EventBatch batch{ tracks };
+
    tracks.Selected().Visit(
       [&](WaveTrack *n) {
          dest = n->SplitCut(
@@ -708,6 +717,9 @@ void OnSplitDelete(const CommandContext &context)
    auto &selectedRegion = ViewInfo::Get( project ).selectedRegion;
    auto &window = ProjectWindow::Get( project );
 
+   // Coalesce the notifications of the many mutations below
+   TrackList::EventBatch batch{ tracks };
+
    tracks.Selected().Visit(
       [&](WaveTrack *wt) {
          wt->SplitDelete(selectedRegion.t0(),
@@ -732,6 +744,9 @@ void OnSilence(const CommandContext &context)
    auto &tracks = TrackList::Get( project );
    auto &selectedRegion = ViewInfo::Get( project ).selectedRegion;
 
+   // Coalesce the notifications of the many mutations below
+   TrackList::EventBatch batch{ tracks };
+
    for ( auto n : tracks.Selected< WaveTrack >() )
       n->Silence(selectedRegion.t0(), selectedRegion.t1());
 
@@ -752,6 +767,9 @@ void OnTrim(const CommandContext &context)
    if (selectedRegion.isPoint())
       return;
 
+   // Coalesce the notifications of the many mutations below
+   TrackList::EventBatch batch{ tracks };
+
    tracks.Selected().Visit(
       [&](WaveTrack *wt) {
          //Delete the section before the left selector
@@ -31,6 +31,7 @@
 
 #include "../ondemand/ODManager.h"
 
+#include <wx/ffile.h>
 #include <wx/menu.h>
 
 // private helper classes and functions
@@ -428,21 +429,28 @@ void OnImportLabels(const CommandContext &context)
                     &window);    // Parent
 
    if (!fileName.empty()) {
-      wxTextFile f;
-
-      f.Open(fileName);
+      wxFFile f( fileName );
       if (!f.IsOpened()) {
          AudacityMessageBox(
             wxString::Format( _("Could not open file: %s"), fileName ) );
          return;
       }
 
+      // Read the whole file at once; LabelTrack's streaming parser is
+      // much faster on large label files than going through wxTextFile
+      wxString text;
+      if (!f.ReadAll( &text )) {
+         AudacityMessageBox(
+            wxString::Format( _("Could not read file: %s"), fileName ) );
+         return;
+      }
+
       auto newTrack = trackFactory.NewLabelTrack();
       wxString sTrackName;
       wxFileName::SplitPath(fileName, NULL, NULL, &sTrackName, NULL);
       newTrack->SetName(sTrackName);
 
-      newTrack->Import(f);
+      newTrack->Import(text);
 
       SelectUtilities::SelectNone( project );
       newTrack->SetSelected(true);
@@ -8,12 +8,14 @@
 #include "../AboutDialog.h"
 #include "../AllThemeResources.h"
 #include "../AudacityLogger.h"
+#include "../AudioIO.h"
 #include "../AudioIOBase.h"
 #include "../CommonCommandFlags.h"
 #include "../CrashReport.h"
 #include "../Dependencies.h"
 #include "../FileNames.h"
 #include "../HelpText.h"
+#include "../PerfCounters.h"
 #include "../Prefs.h"
 #include "../Project.h"
 #include "../ProjectSelectionManager.h"
@@ -328,6 +330,18 @@ void OnMidiDeviceInfo(const CommandContext &context)
 }
 #endif
 
+void OnPerfCounters(const CommandContext &context)
+{
+   auto &project = context.project;
+   wxString info = PerfCounters::Report();
+   if (auto gAudioIO = AudioIO::Get()) {
+      info += wxT("\n");
+      info += gAudioIO->GetTelemetryReport();
+   }
+   ShowDiagnostics( project, info,
+      _("Performance Counters"), wxT("perfcounters.txt") );
+}
+
 void OnShowLog( const CommandContext &context )
 {
    auto logger = AudacityLogger::Get();
@@ -448,6 +462,9 @@ MenuTable::BaseItemPtr HelpMenu( AudacityProject & )
             FN(OnMidiDeviceInfo),
             AudioIONotBusyFlag ),
    #endif
+         Command( wxT("PerfCounters"), XXO("&Performance Counters..."),
+            FN(OnPerfCounters),
+            AlwaysEnabledFlag ),
          Command( wxT("Log"), XXO("Show &Log..."), FN(OnShowLog),
             AlwaysEnabledFlag ),
    #if defined(EXPERIMENTAL_CRASH_REPORT)
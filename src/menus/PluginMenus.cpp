@@ -968,6 +968,9 @@ MenuTable::BaseItemPtr ExtraScriptablesIIMenu( AudacityProject & )
          AudioIONotBusyFlag ),
       Command( wxT("Export2"), XXO("Export..."), FN(OnAudacityCommand),
          AudioIONotBusyFlag ),
+      Command( wxT("ExportSharedAudio"), XXO("Export Shared Audio..."),
+         FN(OnAudacityCommand),
+         AudioIONotBusyFlag ),
       Command( wxT("OpenProject2"), XXO("Open Project..."),
          FN(OnAudacityCommand),
          AudioIONotBusyFlag ),
@@ -28,6 +28,7 @@
 #include "../commands/CommandContext.h"
 #include "../commands/CommandManager.h"
 #include "../effects/EffectManager.h"
+#include "../effects/TrackFreeze.h"
 #include "../tracks/playabletrack/wavetrack/ui/WaveTrackView.h"
 #include "../tracks/playabletrack/wavetrack/ui/WaveTrackControls.h"
 #include "../tracks/playabletrack/wavetrack/ui/WaveTrackViewConstants.h"
@@ -685,6 +686,30 @@ void OnMixAndRenderToNewTrack(const CommandContext &context)
    DoMixAndRender(project, true);
 }
 
+void OnFreezeTracks(const CommandContext &context)
+{
+   auto &project = context.project;
+   auto &tracks = TrackList::Get( project );
+
+   int count = 0;
+   for (auto track : tracks.SelectedLeaders< WaveTrack >())
+      if (TrackFreeze::Get().Freeze(project, *track))
+         count++;
+
+   if (count == 0)
+      AudacityMessageBox(
+         _("No tracks were frozen.  Freezing pre-renders the realtime effect chain, so add effects to the chain first."));
+}
+
+void OnUnfreezeTracks(const CommandContext &context)
+{
+   auto &project = context.project;
+   auto &tracks = TrackList::Get( project );
+
+   for (auto track : tracks.Selected< WaveTrack >())
+      TrackFreeze::Get().Thaw(track);
+}
+
 void OnResample(const CommandContext &context)
 {
    auto &project = context.project;
@@ -1359,6 +1384,13 @@ MenuTable::BaseItemPtr TracksMenu( AudacityProject & )
             AudioIONotBusyFlag | WaveTracksSelectedFlag, wxT("Ctrl+Shift+M") )
       ),
 
+      Command( wxT("FreezeTracks"), XXO("Free&ze Tracks"),
+         FN(OnFreezeTracks),
+         AudioIONotBusyFlag | WaveTracksSelectedFlag ),
+      Command( wxT("UnfreezeTracks"), XXO("Unfreeze Trac&ks"),
+         FN(OnUnfreezeTracks),
+         AudioIONotBusyFlag | WaveTracksSelectedFlag ),
+
       Command( wxT("Resample"), XXO("&Resample..."), FN(OnResample),
          AudioIONotBusyFlag | WaveTracksSelectedFlag ),
 
@@ -17,6 +17,7 @@
 #include "../ProjectWindow.h"
 #include "../SoundActivatedRecord.h"
 #include "../TimerRecordDialog.h"
+#include "../TrackProxy.h"
 #include "../TrackPanelAx.h"
 #include "../TrackPanel.h"
 #include "../UndoManager.h"
@@ -527,6 +528,22 @@ void OnToggleSWPlaythrough(const CommandContext &WXUNUSED(context) )
    MenuManager::ModifyAllProjectToolbarMenus();
 }
 
+void OnToggleProxyPlayback(const CommandContext &context)
+{
+   bool proxy;
+   gPrefs->Read(wxT("/AudioIO/ProxyPlayback"), &proxy, false);
+   proxy = !proxy;
+   gPrefs->Write(wxT("/AudioIO/ProxyPlayback"), proxy);
+   gPrefs->Flush();
+
+   if (proxy)
+      // Build or refresh the reduced-resolution copies now, so that
+      // pressing play does not stall on the first use
+      TrackProxy::Get().BuildAll(context.project);
+
+   MenuManager::ModifyAllProjectToolbarMenus();
+}
+
 #ifdef EXPERIMENTAL_AUTOMATED_INPUT_LEVEL_ADJUSTMENT
 void OnToggleAutomatedInputLevelAdjustment(
    const CommandContext &WXUNUSED(context) )
@@ -996,6 +1013,11 @@ MenuTable::BaseItemPtr TransportMenu( AudacityProject &project )
             AudioIONotBusyFlag | CanStopAudioStreamFlag, checkOn ),
          Command( wxT("SWPlaythrough"), XXO("So&ftware Playthrough (on/off)"),
             FN(OnToggleSWPlaythrough),
+            AudioIONotBusyFlag | CanStopAudioStreamFlag, checkOff ),
+
+         Command( wxT("ProxyPlayback"),
+            XXO("Pro&xy Playback (on/off)"),
+            FN(OnToggleProxyPlayback),
             AudioIONotBusyFlag | CanStopAudioStreamFlag, checkOff )
 
 
@@ -82,6 +82,18 @@ public:
    bool SeekingAllowed() override;
 
 private:
+   ///One entry per packet of the imported stream: the first sample the
+   ///packet decodes to, and the timestamp to hand to av_seek_frame.
+   struct PacketIndexEntry
+   {
+      sampleCount start;
+      int64_t     timestamp;
+   };
+
+   ///Demuxes (without decoding) the file once with a private format context
+   ///and fills mPacketIndex; decides mSeekingAllowedStatus.
+   void BuildPacketIndex();
+
    void InsertCache(std::unique_ptr<FFMpegDecodeCache> &&cache);
 
    //puts the actual audio samples into the blockfile's data array
@@ -105,7 +117,11 @@ private:
    sampleCount                  mCurrentPos;     //the index of the next sample to be decoded
    size_t                       mCurrentLen;     //length of the last packet decoded
 
-   bool                 mSeekingAllowedStatus;
+   ///Sorted by sample position; empty unless mSeekingAllowedStatus is
+   ///ODFFMPEG_SEEKING_TEST_SUCCESS.
+   std::vector<PacketIndexEntry> mPacketIndex;
+
+   int                  mSeekingAllowedStatus;
    int                  mStreamIndex;
 };
 
@@ -162,69 +178,72 @@ ODFileDecoder* ODDecodeFFmpegTask::CreateFileDecoder(const wxString & fileName)
 /// seeking will be enabled once this is true.
 bool ODFFmpegDecoder::SeekingAllowed()
 {
-   return false;
-   /*
-   if(ODFFMPEG_SEEKING_TEST_UNKNOWN != mSeekingAllowedStatus)
-      return mSeekingAllowedStatus == ODFFMPEG_SEEKING_TEST_SUCCESS;
-
-   //we can seek if the following checks pass:
-   //-sample rate is less than the reciprocal of the time_base of the seeking stream.
-   //-a seek test has been made and dts updates as expected.
-   //we want to clone this to run a seek test.
-   AVFormatContext* ic = (AVFormatContext*)mFormatContext;
-   bool  audioStreamExists = false;
-   AVStream* st;
-
-   //test the audio stream(s)
-   for (unsigned int i = 0; i < ic->nb_streams; i++)
-   {
-      if (ic->streams[i]->codec->codec_type == AVMEDIA_TYPE_AUDIO)
-      {
-         audioStreamExists = true;
-         st = ic->streams[i];
-         if(st->duration <= 0 || st->codec->sample_rate <= 0)
-            goto test_failed;
+   //BuildPacketIndex() decided this when the decoder was constructed.
+   return mSeekingAllowedStatus == ODFFMPEG_SEEKING_TEST_SUCCESS;
+}
 
-         //if the time base reciprocal is less than the sample rate it means we can't accurately represent a sample with the timestamp in av.
-         float time_base_inv = ((float)st->time_base.den/st->time_base.num);
-         if(time_base_inv < st->codec->sample_rate)
-            goto test_failed;
+///Demuxes (but does not decode) the file once, recording the timestamp and
+///the sample position of every packet of our stream, so that Decode() can
+///jump straight to the packet containing a requested sample instead of
+///decoding linearly from the current position.
+///A private format context is used so the decode position of mContext is
+///untouched; reading packet headers only is cheap even for long files.
+void ODFFmpegDecoder::BuildPacketIndex()
+{
+   mSeekingAllowedStatus = ODFFMPEG_SEEKING_TEST_FAILED;
+   mPacketIndex.clear();
 
-      }
-   }
+   const auto sc = mScs->get()[mStreamIndex].get();
+   AVStream* st = sc->m_stream;
 
-   if(!audioStreamExists)
-      goto test_failed;
-   //TODO: now try a seek and see if dts/pts (decode/presentation timestamp) is updated as we expected it to be.
-   //This should be done using a NEW AVFormatContext clone so that we don't ruin the file pointer if we fail.
-//   url_fseek(mFormatContext->pb,0,SEEK_SET);
+   if(st->duration <= 0 || st->codec->sample_rate <= 0)
+      return;
 
+   //if the time base reciprocal is less than the sample rate it means we
+   //can't accurately represent a sample with the timestamp in av.
+   float time_base_inv = ((float)st->time_base.den/st->time_base.num);
+   if(time_base_inv < st->codec->sample_rate)
+      return;
 
    std::unique_ptr<FFmpegContext> tempMpegContext;
-   AVFormatContext* tempContext;
-   int err;
-   err = ufile_fopen_input(tempMpegContext, mFName);
-   if (err < 0)
+   FilePath fileName = mFName;
+   if (ufile_fopen_input(tempMpegContext, fileName) < 0)
+      return;
+   AVFormatContext* tempContext = tempMpegContext->ic_ptr;
+   if (avformat_find_stream_info(tempContext, NULL) < 0)
+      return;
+   if ((unsigned int)st->index >= tempContext->nb_streams)
+      return;
+
+   const double tsToSamples =
+      ((double)st->time_base.num / st->time_base.den) * st->codec->sample_rate;
+   int64_t lastTimestamp = 0;
+   bool first = true;
+   while (true)
    {
-      goto test_failed;
-   }
-   tempContext = tempMpegContext->ic_ptr;
-
-   err = avformat_find_stream_info(tempContext, NULL);
-   if (err < 0)
-   {
-      goto test_failed;
-   }
-
-   if(av_seek_frame(tempContext, st->index, 0, 0) >= 0) {
-      mSeekingAllowedStatus = ODFFMPEG_SEEKING_TEST_SUCCESS;
-      return SeekingAllowed();
+      AVPacketEx pkt;
+      if (av_read_frame(tempContext, &pkt) < 0)
+         break;
+      if (pkt.stream_index != st->index)
+         continue;
+      int64_t timestamp =
+         pkt.dts != int64_t(AV_NOPTS_VALUE) ? pkt.dts : pkt.pts;
+      if (timestamp == int64_t(AV_NOPTS_VALUE) ||
+          (!first && timestamp < lastTimestamp))
+      {
+         //without increasing timestamps the index (and a seek) would lie.
+         mPacketIndex.clear();
+         return;
+      }
+      first = false;
+      lastTimestamp = timestamp;
+      mPacketIndex.push_back(
+         { sampleCount{ 0.5 + timestamp * tsToSamples }, timestamp });
    }
 
-test_failed:
-   mSeekingAllowedStatus = ODFFMPEG_SEEKING_TEST_FAILED;
-   return SeekingAllowed();
-   */
+   if (mPacketIndex.empty())
+      return;
+   mSeekingAllowedStatus = ODFFMPEG_SEEKING_TEST_SUCCESS;
 }
 
 
@@ -257,6 +276,9 @@ mStreamIndex(streamIndex)
    }
    mCurrentPos = sampleCount{ double(stream_delay) / AV_TIME_BASE };
 
+   //this runs on the task thread, before any blockfile asks to decode.
+   BuildPacketIndex();
+
    //TODO: add a ref counter to scs?  This will be necessary if we want to allow copy and paste of not-yet decoded
    //ODDecodeBlockFiles that point to FFmpeg files.
 }
@@ -277,8 +299,6 @@ ODFFmpegDecoder::~ODFFmpegDecoder()
 //we read the file from left to right, so in some cases it makes more sense not to seek and just carry on the decode if the gap is small enough.
 //this value controls this amount.  this should be a value that is much larger than the payload for a single packet, and around block file size around 1-10 secs.
 #define kDecodeSampleAllowance 400000
-//number of jump backwards seeks
-#define kMaxSeekRewindAttempts 8
 int ODFFmpegDecoder::Decode(SampleBuffer & data, sampleFormat & format, sampleCount start, size_t len, unsigned int channel)
 {
    auto mFormatContext = mContext->ic_ptr;
@@ -303,9 +323,7 @@ int ODFFmpegDecoder::Decode(SampleBuffer & data, sampleFormat & format, sampleCo
    //look at the decoding timestamp and see if the next sample that will be decoded is not the next sample we need.
    if(len && (mCurrentPos > start + len  || mCurrentPos + kDecodeSampleAllowance < start ) && SeekingAllowed()) {
       sc = sci;
-      AVStream* st = sc->m_stream;
       int stindex = -1;
-      uint64_t targetts;
 
       //wxPrintf("attempting seek to %llu\n", start);
       //we have to find the index for this stream.
@@ -315,34 +333,24 @@ int ODFFmpegDecoder::Decode(SampleBuffer & data, sampleFormat & format, sampleCo
       }
 
       if(stindex >=0) {
-         int numAttempts = 0;
-         //reset mCurrentPos to a bogus value
-         mCurrentPos = start+len +1;
-         while(numAttempts++ < kMaxSeekRewindAttempts && mCurrentPos > start) {
-            //we want to move slightly before the start of the block file, but not too far ahead
-            targetts = std::max( 0.0,
-               (start - kDecodeSampleAllowance * numAttempts / kMaxSeekRewindAttempts)
-                  .as_long_long() *
-               ((double)st->time_base.den/(st->time_base.num * st->codec->sample_rate ))
-            );
-
-            //wxPrintf("attempting seek to %llu, attempts %d\n", targetts, numAttempts);
-            if(av_seek_frame(mFormatContext,stindex,targetts,0) >= 0){
-               //find out the dts we've seekd to.
-               sampleCount actualDecodeStart { 0.5 + st->codec->sample_rate * st->cur_dts  * ((double)st->time_base.num/st->time_base.den) };      //this is mostly safe because den is usually 1 or low number but check for high values.
-
-               mCurrentPos = actualDecodeStart;
-               seeking = true;
-
-               //if the seek was past our desired position, rewind a bit.
-               //wxPrintf("seek ok to %llu samps, float: %f\n",actualDecodeStart,actualDecodeStartDouble);
-            } else {
-               wxPrintf("seek failed");
-               break;
-            }
+         //find the last packet that starts at or before our desired sample,
+         //then back up one more packet because the timestamp rounding may
+         //place the boundary a few samples late.
+         auto it = std::upper_bound(mPacketIndex.begin(), mPacketIndex.end(),
+            start,
+            [](sampleCount value, const PacketIndexEntry &entry)
+               { return value < entry.start; });
+         size_t entryIndex = it - mPacketIndex.begin();
+         entryIndex = entryIndex > 2 ? entryIndex - 2 : 0;
+         const PacketIndexEntry &entry = mPacketIndex[entryIndex];
+
+         //wxPrintf("attempting seek to %llu\n", entry.timestamp);
+         if(av_seek_frame(mFormatContext, stindex, entry.timestamp, 0) >= 0){
+            mCurrentPos = entry.start;
+            seeking = true;
          }
-         if(mCurrentPos>start){
-            mSeekingAllowedStatus = (bool)ODFFMPEG_SEEKING_TEST_FAILED;
+         if(!seeking || mCurrentPos>start){
+            mSeekingAllowedStatus = ODFFMPEG_SEEKING_TEST_FAILED;
             //               url_fseek(mFormatContext->pb,sc->m_pkt.pos,SEEK_SET);
             wxPrintf("seek fail, reverting to previous pos\n");
             return -1;
@@ -11,12 +11,16 @@
 #include "ODDecodeFlacTask.h"
 
 #include "../Prefs.h"
+#include <algorithm>
+#include <thread>
 #include <wx/string.h>
 #include <wx/utils.h>
 #include <wx/file.h>
 #include <wx/ffile.h>
 #include <wx/wx.h>
 
+#include "../WaveTrack.h"
+
 #ifdef USE_LIBID3TAG
 extern "C" {
 #include <id3tag.h>
@@ -29,6 +33,13 @@ extern "C" {
 
 #define DESC _("FLAC files")
 
+///the number of worker threads decoding one file at once, which is also
+///the limit on the number of libFLAC streams opened over that file.
+static unsigned int FlacDecodeWorkerCount()
+{
+   return std::max(1u, std::thread::hardware_concurrency());
+}
+
 ODDecodeFlacTask::~ODDecodeFlacTask()
 {
 }
@@ -44,6 +55,106 @@ std::unique_ptr<ODTask> ODDecodeFlacTask::Clone() const
    return std::move(clone);
 }
 
+///Computes and writes the data for several BlockFiles at once, splitting the
+///batch across worker threads.  FLAC frames decode independently after a
+///seek, so each worker decodes its own range of the file on its own libFLAC
+///stream; the serial loop in the base class kept one core busy for minutes
+///on a long file while the rest idled.
+void ODDecodeFlacTask::DoSomeInternal()
+{
+   if(mBlockFiles.size()<=0)
+   {
+      mPercentCompleteMutex.Lock();
+      mPercentComplete = 1.0;
+      mPercentCompleteMutex.Unlock();
+      return;
+   }
+
+   //claim a batch of blockfiles off the front of the queue.
+   struct Job
+   {
+      std::shared_ptr<ODDecodeBlockFile> blockFile;
+      int ret;
+   };
+   std::vector<Job> jobs;
+   const size_t batch = FlacDecodeWorkerCount();
+
+   while(jobs.size() < batch && jobs.size() < mBlockFiles.size())
+   {
+      const auto bf = mBlockFiles[jobs.size()].lock();
+      if(bf)
+         jobs.push_back({ bf, 1 });
+      else
+      {
+         // The block file disappeared.
+         //the waveform in the wavetrack now is shorter, so we need to update mMaxBlockFiles
+         //because now there is less work to do.
+         mMaxBlockFiles--;
+         mBlockFiles.erase(mBlockFiles.begin()+jobs.size());
+      }
+   }
+
+   if(jobs.size())
+   {
+      //get and init the decoders serially; GetOrCreateMatchingFileDecoder
+      //is not thread safe.  We hold the read lock so the file can't move.
+      //(see ODDecodeTask::DoSomeInternal for why LockForRead.)
+      for(size_t i=0;i<jobs.size();i++)
+      {
+         auto locker = jobs[i].blockFile->LockForRead();
+         ODFileDecoder* decoder =
+            GetOrCreateMatchingFileDecoder( &*jobs[i].blockFile );
+         if(!decoder->IsInitialized())
+            decoder->Init();
+         jobs[i].blockFile->SetODFileDecoder(decoder);
+      }
+
+      //decode and write the batch concurrently.  Each DoWriteBlockFile
+      //takes its own stream of the file from the decoder's pool, and each
+      //blockfile writes only its own .au file and summary.
+      std::vector<std::thread> workers;
+      for(size_t i=1;i<jobs.size();i++)
+         workers.emplace_back([](Job *job){
+            auto locker = job->blockFile->LockForRead();
+            // Does not throw:
+            job->ret = job->blockFile->DoWriteBlockFile();
+         }, &jobs[i]);
+      {
+         auto locker = jobs[0].blockFile->LockForRead();
+         // Does not throw:
+         jobs[0].ret = jobs[0].blockFile->DoWriteBlockFile();
+      }
+      for(size_t i=0;i<workers.size();i++)
+         workers[i].join();
+   }
+
+   //take the finished ones out of the queue (failures stay at the front and
+   //the task does not make progress on them) and invalidate the displays.
+   for(auto i = jobs.size(); i--; )
+   {
+      if(jobs[i].ret >= 0)
+      {
+         const auto blockStartSample = jobs[i].blockFile->GetStart();
+         const auto blockEndSample =
+            blockStartSample + jobs[i].blockFile->GetLength();
+         mBlockFiles.erase(mBlockFiles.begin()+i);
+
+         //update the gui for all associated blocks.
+         mWaveTrackMutex.Lock();
+         for(size_t j=0;j<mWaveTracks.size();j++)
+         {
+            auto waveTrack = mWaveTracks[j].lock();
+            if(waveTrack)
+               waveTrack->AddInvalidRegion(blockStartSample,blockEndSample);
+         }
+         mWaveTrackMutex.Unlock();
+      }
+   }
+
+   //update percentage complete.
+   CalculatePercentComplete();
+}
+
 
 void ODFLACFile::metadata_callback(const FLAC__StreamMetadata *metadata)
 {
@@ -118,13 +229,13 @@ FLAC__StreamDecoderWriteStatus ODFLACFile::write_callback(const FLAC__Frame *fra
 {
 
    unsigned int bytesToCopy = frame->header.blocksize;
-   if(bytesToCopy>mDecoder->mDecodeBufferLen-mDecoder->mDecodeBufferWritePosition)
-      bytesToCopy=mDecoder->mDecodeBufferLen-mDecoder->mDecodeBufferWritePosition;
+   if(bytesToCopy>mDecodeBufferLen-mDecodeBufferWritePosition)
+      bytesToCopy=mDecodeBufferLen-mDecodeBufferWritePosition;
 
    //the decodeBuffer was allocated to be the same format as the flac buffer, so we can do a straight up memcpy.
-   memcpy(mDecoder->mDecodeBuffer+SAMPLE_SIZE(mDecoder->mFormat)*mDecoder->mDecodeBufferWritePosition,buffer[mDecoder->mTargetChannel],SAMPLE_SIZE(mDecoder->mFormat) * bytesToCopy);
+   memcpy(mDecodeBuffer+SAMPLE_SIZE(mDecoder->mFormat)*mDecodeBufferWritePosition,buffer[mTargetChannel],SAMPLE_SIZE(mDecoder->mFormat) * bytesToCopy);
 
-   mDecoder->mDecodeBufferWritePosition+=bytesToCopy;
+   mDecodeBufferWritePosition+=bytesToCopy;
 /*
    ArrayOf<short> tmp{ frame->header.blocksize };
 
@@ -146,7 +257,7 @@ FLAC__StreamDecoderWriteStatus ODFLACFile::write_callback(const FLAC__Frame *fra
    }
 */
 
-   mDecoder->mSamplesDone += frame->header.blocksize;
+   mSamplesDone += frame->header.blocksize;
 
    return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
 //   return FLAC__STREAM_DECODER_WRITE_STATUS_ABORT;
@@ -174,43 +285,35 @@ FLAC__StreamDecoderWriteStatus ODFLACFile::write_callback(const FLAC__Frame *fra
 int ODFlacDecoder::Decode(SampleBuffer & data, sampleFormat & format, sampleCount start, size_t len, unsigned int channel)
 {
 
-   //we need to lock this so the target stays fixed over the seek/write callback.
-   mFlacFileLock.Lock();
-
-   bool usingCache=mLastDecodeStartSample==start;
-   if(usingCache)
-   {
-      //we've just decoded this, so lets use a cache.  (often so for
-   }
-
+   //take a free stream; the locker keeps it ours over the seek/write
+   //callback, while other threads decode other ranges on other streams.
+   ODLocker locker;
+   FlacStream* stream = AcquireStream(locker);
+   if(!stream)
+      return -1;
+   ODFLACFile* file = stream->file.get();
 
-   mDecodeBufferWritePosition=0;
-   mDecodeBufferLen = len;
+   file->mDecodeBufferWritePosition=0;
+   file->mDecodeBufferLen = len;
 
    data.Allocate(len, mFormat);
-   mDecodeBuffer = data.ptr();
+   file->mDecodeBuffer = data.ptr();
    format = mFormat;
 
-   mTargetChannel=channel;
+   file->mTargetChannel=channel;
 
    // Third party library has its own type alias, check it
    static_assert(sizeof(sampleCount::type) <=
                  sizeof(FLAC__int64),
                  "Type FLAC__int64 is too narrow to hold a sampleCount");
-   if(!mFile->seek_absolute(static_cast<FLAC__int64>( start.as_long_long() )))
+   if(!file->seek_absolute(static_cast<FLAC__int64>( start.as_long_long() )))
    {
-      mFlacFileLock.Unlock();
       return -1;
    }
 
-   while(mDecodeBufferWritePosition<mDecodeBufferLen)
-      mFile->process_single();
+   while(file->mDecodeBufferWritePosition<file->mDecodeBufferLen)
+      file->process_single();
 
-   mFlacFileLock.Unlock();
-   if(!usingCache)
-   {
-      mLastDecodeStartSample=start;
-   }
    //insert into blockfile and
    //calculate summary happen in ODDecodeBlockFile::WriteODDecodeBlockFile, where this method is also called.
    return 1;
@@ -227,11 +330,27 @@ bool ODFlacDecoder::ReadHeader()
    mFormat = int16Sample;//start with the smallest and move up in the metadata_callback.
                          //we want to use the native flac type for quick conversion.
       /* QualityPrefs::SampleFormatChoice(); */
-   mFile = std::make_unique<ODFLACFile>(this);
 
-
-   if (!mHandle.Open(mFName, wxT("rb"))) {
+   ODLocker locker{ &mStreamsLock };
+   //the first stream reads the metadata and fills in the header fields.
+   if(!OpenFlacStream(true))
       return false;
+
+   MarkInitialized();
+   return true;
+
+}
+
+///Opens one more libFLAC stream over the file and advances it past the
+///metadata, so it is ready to seek and decode.
+ODFlacDecoder::FlacStream* ODFlacDecoder::OpenFlacStream(bool respondMetadata)
+{
+   auto stream = std::make_unique<FlacStream>();
+   stream->file = std::make_unique<ODFLACFile>(this, respondMetadata);
+
+   wxFFile handle;
+   if (!handle.Open(mFName, wxT("rb"))) {
+      return NULL;
    }
 
    // Even though there is an init() method that takes a filename, use the one that
@@ -239,39 +358,77 @@ bool ODFlacDecoder::ReadHeader()
    // libflac can't (under Windows).
    //
    // Responsibility for closing the file is passed to libflac.
-   // (it happens when mFile->finish() is called)
-   bool result = mFile->init(mHandle.fp())?true:false;
-   mHandle.Detach();
+   // (it happens when the file's finish() is called)
+   bool result = stream->file->init(handle.fp())?true:false;
+   handle.Detach();
 
    if (result != FLAC__STREAM_DECODER_INIT_STATUS_OK) {
-      return false;
+      return NULL;
    }
 
    //this will call the metadata_callback when it is done
-   mFile->process_until_end_of_metadata();
+   stream->file->process_until_end_of_metadata();
    // not necessary to check state, error callback will catch errors, but here's how:
-   if (mFile->get_state() > FLAC__STREAM_DECODER_READ_FRAME) {
-      return false;
+   if (stream->file->get_state() > FLAC__STREAM_DECODER_READ_FRAME) {
+      return NULL;
    }
 
-   if (!mFile->is_valid() || mFile->get_was_error()) {
+   if (!stream->file->is_valid() || stream->file->get_was_error()) {
       // This probably is not a FLAC file at all
-      return false;
+      return NULL;
    }
 
-   MarkInitialized();
-   return true;
+   mStreams.push_back(std::move(stream));
+   return mStreams.back().get();
+}
+
+///Returns a free stream with its lock transferred to the locker argument.
+ODFlacDecoder::FlacStream* ODFlacDecoder::AcquireStream(ODLocker &locker)
+{
+   ODLocker poolLocker{ &mStreamsLock };
+   if(mStreams.empty())
+      return NULL;//ReadHeader was never successfully called.
+
+   for(unsigned int i=0;i<mStreams.size();i++)
+   {
+      ODLocker trial{ &mStreams[i]->lock, true };
+      if(trial)
+      {
+         locker = std::move(trial);
+         return mStreams[i].get();
+      }
+   }
+
+   //everything is busy - open another stream, up to the worker limit.
+   if(mStreams.size() < FlacDecodeWorkerCount())
+   {
+      FlacStream* stream = OpenFlacStream(false);
+      if(stream)
+      {
+         locker.reset(&stream->lock);
+         return stream;
+      }
+   }
 
+   //as a last resort wait for the first stream.  Streams are never removed
+   //until the decoder is destroyed, so the pointer stays valid after we
+   //give up the pool lock to avoid holding it while blocking.
+   FlacStream* fallback = mStreams[0].get();
+   poolLocker.reset();
+   locker.reset(&fallback->lock);
+   return fallback;
 }
 
 ODFLACFile* ODFlacDecoder::GetFlacFile()
 {
-   return mFile.get();
+   ODLocker locker{ &mStreamsLock };
+   return mStreams.empty() ? NULL : mStreams[0]->file.get();
 }
 
 ODFlacDecoder::~ODFlacDecoder(){
-   if(mFile)
-      mFile->finish();
+   for(unsigned int i=0;i<mStreams.size();i++)
+      if(mStreams[i]->file)
+         mStreams[i]->file->finish();
 }
 
 ///Creates an ODFileDecoder that decodes a file of filetype the subclass handles.
@@ -29,7 +29,6 @@ robust enough to allow all the user changes such as copy/paste, DELETE, and so o
 #define __AUDACITY_ODDecodeFLACTask__
 
 #include <vector>
-#include <wx/ffile.h> // data member
 #include "ODDecodeTask.h"
 
 #include "FLAC++/decoder.h"
@@ -59,18 +58,33 @@ class ODDecodeFlacTask final : public ODDecodeTask
    ///Lets other classes know that this class handles flac
    ///Subclasses should override to return respective type.
    unsigned int GetODType() override { return eODFLAC; }
+
+ protected:
+   ///Computes and writes the data for several BlockFiles at once on worker
+   ///threads, each decoding its range of the file with its own libFLAC stream.
+   void DoSomeInternal() override;
 };
 
 
 class ODFLACFile final : public FLAC::Decoder::File
 {
  public:
-   ODFLACFile(ODFlacDecoder *decoder) : mDecoder(decoder)
+   ODFLACFile(ODFlacDecoder *decoder, bool respondMetadata = true)
+      : mDecoder(decoder)
    {
       mWasError = false;
+      mTargetChannel = 0;
+      mDecodeBufferWritePosition = 0;
+      mDecodeBufferLen = 0;
+      mDecodeBuffer = NULL;
+      mSamplesDone = 0;
       set_metadata_ignore_all();
-      set_metadata_respond(FLAC__METADATA_TYPE_VORBIS_COMMENT);
-      set_metadata_respond(FLAC__METADATA_TYPE_STREAMINFO);
+      //only the first stream over a file fills in the decoder's header
+      //fields; further streams just decode samples and skip the metadata.
+      if (respondMetadata) {
+         set_metadata_respond(FLAC__METADATA_TYPE_VORBIS_COMMENT);
+         set_metadata_respond(FLAC__METADATA_TYPE_STREAMINFO);
+      }
    }
 
    bool get_was_error() const
@@ -83,6 +97,14 @@ class ODFLACFile final : public FLAC::Decoder::File
    bool                  mWasError;
    wxArrayString         mComments;
 
+   //transfer state for write_callback.  Each stream carries its own so
+   //several streams of one file can decode different ranges concurrently.
+   unsigned int          mTargetChannel;
+   unsigned int          mDecodeBufferWritePosition;
+   unsigned int          mDecodeBufferLen;
+   samplePtr             mDecodeBuffer;
+   FLAC__uint64          mSamplesDone;
+
  protected:
    FLAC__StreamDecoderWriteStatus write_callback(const FLAC__Frame *frame,
                                                          const FLAC__int32 * const buffer[]) override;
@@ -98,7 +120,7 @@ class ODFlacDecoder final : public ODFileDecoder
    friend class ODFLACFile;
 public:
    ///This should handle unicode converted to UTF-8 on mac/linux, but OD TODO:check on windows
-   ODFlacDecoder(const wxString & fileName):ODFileDecoder(fileName),mSamplesDone(0){mFile=NULL;}
+   ODFlacDecoder(const wxString & fileName):ODFileDecoder(fileName){}
    virtual ~ODFlacDecoder();
 
    ///Decodes the samples for this blockfile from the real file into a float buffer.
@@ -119,24 +141,35 @@ public:
    ODFLACFile* GetFlacFile();
 
 private:
+   ///One independently seekable libFLAC stream over the file.  Decode()
+   ///takes whichever stream is free, so several block files of the same
+   ///file can be decoded in parallel.
+   struct FlacStream
+   {
+      std::unique_ptr<ODFLACFile> file;
+      ODLock lock;//held for the duration of a Decode() on this stream.
+   };
+
+   ///Opens one more stream over the file and advances it past the metadata.
+   ///Returns NULL on failure.  The caller must hold mStreamsLock.
+   FlacStream* OpenFlacStream(bool respondMetadata);
+
+   ///Returns a free stream, transferring its held lock to the locker
+   ///argument; opens a NEW stream if all are busy and the pool is not
+   ///full yet.  Returns NULL if the header was never read.
+   FlacStream* AcquireStream(ODLocker &locker);
+
    friend class FLACImportFileHandle;
    sampleFormat          mFormat;
-   std::unique_ptr<ODFLACFile> mFile;
-   ODLock         mFlacFileLock;//for mFile;
-   wxFFile               mHandle;
+   std::vector<std::unique_ptr<FlacStream>> mStreams;
+   ODLock         mStreamsLock;//for mStreams;
    unsigned long         mSampleRate;
    unsigned long         mNumChannels;
    unsigned long         mBitsPerSample;
    FLAC__uint64          mNumSamples;
-   FLAC__uint64          mSamplesDone;
-   sampleCount          mLastDecodeStartSample;
    bool                  mStreamInfoDone;
    int                   mUpdateResult;
    WaveTrack           **mChannels;
-   unsigned int          mTargetChannel;
-   unsigned int         mDecodeBufferWritePosition;
-   unsigned int         mDecodeBufferLen;
-   samplePtr            mDecodeBuffer;
 };
 
 #endif
@@ -21,6 +21,8 @@ ODTask requests and internals.
 #include "ODWaveTrackTaskQueue.h"
 #include "../Project.h"
 #include <NonGuiThread.h>
+#include <algorithm>
+#include <thread>
 #include <wx/utils.h>
 #include <wx/wx.h>
 #include <wx/thread.h>
@@ -118,11 +120,23 @@ void *ODTaskThread::Entry()
 {
    //TODO: Figure out why this has no effect at all.
    //wxThread::This()->SetPriority( 40);
-   //Do at least 5 percent of the task
-   mTask->DoSome(0.05f);
+
+   //Work loop:  do a chunk of the given task, then take whatever task
+   //is next available from the manager and continue, so the worker
+   //stays alive and busy as long as any task has work queued.  DoSome
+   //re-adds unfinished tasks to the manager's list, where this or
+   //another worker picks them up again; previously a fresh thread was
+   //created and destroyed for every five-percent chunk.
+   ODTask *task = mTask;
+   auto man = ODManager::Instance();
+   do {
+      //Do at least 5 percent of the task
+      task->DoSome(0.05f);
+      task = man->TakeNextTask();
+   } while (task);
 
    //release the thread count so that the ODManager knows how many active threads are alive.
-   ODManager::Instance()->DecrementCurrentThreads();
+   man->DecrementCurrentThreads();
 
 
 #ifndef __WXMAC__
@@ -213,6 +227,34 @@ void ODManager::AddTask(ODTask* task)
       mQueueNotEmptyCond->Signal();
 }
 
+ODTask *ODManager::TakeNextTask()
+{
+   bool paused, terminating;
+
+   mPauseLock.Lock();
+   paused = mPause;
+   mPauseLock.Unlock();
+
+   mTerminateMutex.Lock();
+   terminating = mTerminate;
+   mTerminateMutex.Unlock();
+
+   //while paused or shutting down the workers should wind down instead
+   //of picking up more work
+   if(paused || terminating)
+      return NULL;
+
+   ODTask* task = NULL;
+   mTasksMutex.Lock();
+   if(!mTasks.empty())
+   {
+      task = mTasks[0];
+      mTasks.erase(mTasks.begin());
+   }
+   mTasksMutex.Unlock();
+   return task;
+}
+
 void ODManager::SignalTaskQueueLoop()
 {
    bool paused;
@@ -319,7 +361,9 @@ bool ODManager::IsInstanceCreated()
 void ODManager::Init()
 {
    mCurrentThreads = 0;
-   mMaxThreads = 5;
+   //scale the worker pool to the machine; sessions with many files to
+   //decode or summarize can use every core
+   mMaxThreads = std::max(5u, std::thread::hardware_concurrency());
 
    //   wxLogDebug(wxT("Initializing ODManager...Creating manager thread"));
    // This is a detached thread, so it deletes itself when it finishes
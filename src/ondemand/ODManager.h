@@ -85,6 +85,11 @@ class ODManager final
    ///Adds a task to the running queue.  Threas-safe.
    void AddTask(ODTask* task);
 
+   ///Takes the next runnable task off the running queue for a worker
+   ///thread, or returns NULL if there is none (or we are paused or
+   ///terminating).  Thread-safe.
+   ODTask *TakeNextTask();
+
    void RemoveTaskIfInQueue(ODTask* task);
 
    ///sets a flag that is set if we have loaded some OD blockfiles from PCM.
@@ -675,6 +675,9 @@ bool KeyConfigPrefs::Commit()
       }
    }
 
+   // The shared cache of these bindings is now stale
+   CommandManager::InvalidateCustomKeys();
+
    return gPrefs->Flush();
 }
 
@@ -391,7 +391,12 @@ void LabelTrackView::ComputeLayout(const wxRect & r, const ZoomInfo &zoomInfo) c
    const auto pTrack = FindLabelTrack();
    const auto &mLabels = pTrack->GetLabels();
 
-   { int i = -1; for (const auto &labelStruct : mLabels) { ++i;
+   // Draw already confined mVisibleBegin, mVisibleEnd to the labels
+   // that can appear in r; lay out only those.  (Clamp, in case this
+   // track and the pending-changes track Draw consulted disagree.)
+   mVisibleEnd = std::min<int>( mVisibleEnd, mLabels.size() );
+   { for (int i = mVisibleBegin; i < mVisibleEnd; ++i) {
+      const auto &labelStruct = mLabels[i];
       const int x = zoomInfo.TimeToPosition(labelStruct.getT0(), r.x);
       const int x1 = zoomInfo.TimeToPosition(labelStruct.getT1(), r.x);
       int y = r.y;
@@ -723,10 +728,25 @@ void LabelTrackView::Draw
 
    wxCoord textWidth, textHeight;
 
+   // Find the labels that can appear in r, so that all the per-label
+   // work below is confined to them; on label-dense tracks the rest of
+   // the labels vastly outnumber these.  Allow a screen width of slack
+   // on the left, because text bleeds rightwards out of a label that
+   // does not fit it, so a label lying off-screen left can still show
+   // text in the viewport.
+   {
+      const auto visible = pTrack->FindIntersectingLabels(
+         zoomInfo.PositionToTime(r.x - r.width, r.x),
+         zoomInfo.PositionToTime(r.x + r.width, r.x));
+      mVisibleBegin = visible.first;
+      mVisibleEnd = visible.second;
+   }
+
    // Get the text widths.
    // TODO: Make more efficient by only re-computing when a
    // text label title changes.
-   for (const auto &labelStruct : mLabels) {
+   for (int i = mVisibleBegin; i < mVisibleEnd; ++i) {
+      const auto &labelStruct = mLabels[i];
       dc.GetTextExtent(labelStruct.title, &textWidth, &textHeight);
       labelStruct.width = textWidth;
    }
@@ -750,11 +770,12 @@ void LabelTrackView::Draw
    // so that the correct things overpaint each other.
 
    // Draw vertical lines that show where the end positions are.
-   for (const auto &labelStruct : mLabels)
-      DrawLines( dc, labelStruct, r );
+   for (int i = mVisibleBegin; i < mVisibleEnd; ++i)
+      DrawLines( dc, mLabels[i], r );
 
    // Draw the end glyphs.
-   { int i = -1; for (const auto &labelStruct : mLabels) { ++i;
+   { for (int i = mVisibleBegin; i < mVisibleEnd; ++i) {
+      const auto &labelStruct = mLabels[i];
       GlyphLeft=0;
       GlyphRight=1;
       if( pHit && i == pHit->mMouseOverLabelLeft )
@@ -773,7 +794,8 @@ void LabelTrackView::Draw
       auto target = dynamic_cast<LabelTextHandle*>(context.target.get());
       highlightTrack = target && target->GetTrack().get() == this;
 #endif
-      int i = -1; for (const auto &labelStruct : mLabels) { ++i;
+      for (int i = mVisibleBegin; i < mVisibleEnd; ++i) {
+         const auto &labelStruct = mLabels[i];
          bool highlight = false;
 #ifdef EXPERIMENTAL_TRACK_PANEL_HIGHLIGHTING
          highlight = highlightTrack && target->GetLabelNum() == i;
@@ -792,7 +814,10 @@ void LabelTrackView::Draw
    }
 
    // Draw highlights
-   if ( (mInitialCursorPos != mCurrentCursorPos) && HasSelection( project ) )
+   // (only if the selected label was laid out; otherwise it is off
+   // screen and its coordinates are stale)
+   if ( (mInitialCursorPos != mCurrentCursorPos) && HasSelection( project ) &&
+      mSelIndex >= mVisibleBegin && mSelIndex < mVisibleEnd )
    {
       int xpos1, xpos2;
       CalcHighlightXs(&xpos1, &xpos2);
@@ -801,7 +826,8 @@ void LabelTrackView::Draw
    }
 
    // Draw the text and the label boxes.
-   { int i = -1; for (const auto &labelStruct : mLabels) { ++i;
+   { for (int i = mVisibleBegin; i < mVisibleEnd; ++i) {
+      const auto &labelStruct = mLabels[i];
       if( GetSelectedIndex( project ) == i )
          dc.SetBrush(AColor::labelTextEditBrush);
       DrawText( dc, labelStruct, r );
@@ -810,7 +836,8 @@ void LabelTrackView::Draw
    }}
 
    // Draw the cursor, if there is one.
-   if( mDrawCursor && HasSelection( project ) )
+   if( mDrawCursor && HasSelection( project ) &&
+      mSelIndex >= mVisibleBegin && mSelIndex < mVisibleEnd )
    {
       const auto &labelStruct = mLabels[mSelIndex];
       int xPos = labelStruct.xText;
@@ -1092,9 +1119,6 @@ int LabelTrackView::GetSelectedIndex( AudacityProject &project ) const
       return mSelIndex = -1;
 }
 
-/// TODO: Investigate what happens with large
-/// numbers of labels, might need a binary search
-/// rather than a linear one.
 void LabelTrackView::OverGlyph(
    const LabelTrack &track, LabelTrackHit &hit, int x, int y)
 {
@@ -1110,7 +1134,12 @@ void LabelTrackView::OverGlyph(
 
    const auto pTrack = &track;
    const auto &mLabels = pTrack->GetLabels();
-   { int i = -1; for (const auto &labelStruct : mLabels) { ++i;
+   // Only the labels the last draw laid out can be on screen, and only
+   // those have current coordinates, so confine the scan to them
+   const auto &view = Get( track );
+   const int end = std::min<int>( view.mVisibleEnd, mLabels.size() );
+   { for (int i = view.mVisibleBegin; i < end; ++i) {
+      const auto &labelStruct = mLabels[i];
       //over left or right selection bound
       //Check right bound first, since it is drawn after left bound,
       //so give it precedence for matching/highlighting.
@@ -1156,7 +1185,11 @@ int LabelTrackView::OverATextBox( const LabelTrack &track, int xx, int yy )
 {
    const auto pTrack = &track;
    const auto &mLabels = pTrack->GetLabels();
-   for (int nn = (int)mLabels.size(); nn--;) {
+   // As in OverGlyph, only the labels of the last layout can match
+   const auto &view = Get( track );
+   const int begin = view.mVisibleBegin;
+   for (int nn = std::min<int>( view.mVisibleEnd, mLabels.size() );
+        nn-- > begin;) {
       const auto &labelStruct = mLabels[nn];
       if ( OverTextBox( &labelStruct, xx, yy ) )
          return nn;
@@ -183,6 +183,12 @@ private:
 
    bool mDrawCursor;                           /// flag to tell if drawing the
                                                   /// cursor or not
+
+   // Range of labels last laid out by ComputeLayout.  Only these have
+   // valid on-screen coordinates, so drawing and hit-testing confine
+   // themselves to it; labels outside it cannot be on screen.
+   mutable int mVisibleBegin { 0 };
+   mutable int mVisibleEnd { 0 };
    int mRestoreFocus{-2};                          /// Restore focus to this track
                                                   /// when done editing
 
@@ -29,6 +29,35 @@ Paul Licameli split from TrackPanel.cpp
 
 #include <wx/dc.h>
 
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+// One note of the sequence, captured with the few fields drawing needs,
+// so a repaint does not repeat the merge-iteration over every Allegro
+// track nor re-scan each note's attribute list for a shape
+struct NoteCacheEntry {
+   double time;
+   double dur;
+   Alg_note_ptr note;
+   const char *shape; // atom if the note denotes a graphic, else NULL
+};
+
+struct NoteTrackDrawCache {
+   // Identifies the sequence contents the snapshot was built from; the
+   // snapshot is stale when any of these changes
+   Alg_seq *pSeq{ nullptr };
+   long nEvents{ -1 };
+   double realDur{ -1.0 };
+
+   // Notes sorted by start time
+   std::vector<NoteCacheEntry> notes;
+   // maxEnd[ii] is the greatest end time among notes[0..ii]; it is
+   // nondecreasing, so the first note that can overlap a window is
+   // found by binary search
+   std::vector<double> maxEnd;
+};
+
 NoteTrackView::NoteTrackView( const std::shared_ptr<Track> &pTrack )
    : CommonTrackView{ pTrack }
 {
@@ -211,6 +240,50 @@ const char *LookupAtomAttribute(Alg_note_ptr note, Alg_attribute attr, char *def
   return def;
 }
 
+// Rebuild the snapshot of notes if the sequence no longer matches it.
+// The sequence must already be converted to seconds.
+void UpdateCache(NoteTrackDrawCache &cache, Alg_seq &seq)
+{
+   long count = 0;
+   for (int ii = 0; ii < seq.tracks(); ii++)
+      count += seq.track(ii)->length();
+   double dur = seq.get_real_dur();
+   if (cache.pSeq == &seq && cache.nEvents == count && cache.realDur == dur)
+      return;
+
+   cache.pSeq = &seq;
+   cache.nEvents = count;
+   cache.realDur = dur;
+   cache.notes.clear();
+   cache.maxEnd.clear();
+   cache.notes.reserve(count);
+
+   Alg_iterator iterator(&seq, false);
+   iterator.begin();
+   Alg_event_ptr evt;
+   while (0 != (evt = iterator.next())) {
+      if (evt->get_type() == 'n') { // 'n' means a note
+         Alg_note_ptr note = (Alg_note_ptr) evt;
+         // Notes with zero loudness may denote graphics instead
+         const char *shape = note->loud > 0.0 ? NULL : IsShape(note);
+         cache.notes.push_back({ note->time, note->dur, note, shape });
+      }
+   }
+   iterator.end();
+
+   // The iterator merges the tracks in time order, but do not rely on it
+   std::stable_sort(cache.notes.begin(), cache.notes.end(),
+      [](const NoteCacheEntry &first, const NoteCacheEntry &second)
+         { return first.time < second.time; });
+
+   cache.maxEnd.reserve(cache.notes.size());
+   double maxSoFar = 0.0;
+   for (auto &entry : cache.notes) {
+      maxSoFar = std::max(maxSoFar, entry.time + entry.dur);
+      cache.maxEnd.push_back(maxSoFar);
+   }
+}
+
 // CLIP(x) changes x to lie between +/- CLIP_MAX due to graphics display problems
 //  with very large coordinate values (this happens when you zoom in very far)
 //  This will cause incorrect things to be displayed, but at these levels of zoom
@@ -351,7 +424,8 @@ window and draw out-of-bounds notes here instead.
 void DrawNoteTrack(TrackPanelDrawingContext &context,
                                 const NoteTrack *track,
                                 const wxRect & rect,
-                                bool muted)
+                                bool muted,
+                                NoteTrackDrawCache &cache)
 {
    auto &dc = context.dc;
    const auto artist = TrackArtist::Get( context );
@@ -462,20 +536,45 @@ void DrawNoteTrack(TrackPanelDrawingContext &context,
    // We want to draw in seconds, so we need to convert to seconds
    seq->convert_to_seconds();
 
-   Alg_iterator iterator(seq, false);
-   iterator.begin();
-   //for every event
-   Alg_event_ptr evt;
-   while (0 != (evt = iterator.next())) {
-      if (evt->get_type() == 'n') { // 'n' means a note
-         Alg_note_ptr note = (Alg_note_ptr) evt;
+   UpdateCache(cache, *seq);
+
+   // When zoomed far out, many notes map onto the same pixel or two;
+   // remember the cells already painted this pass and skip exact repeats,
+   // so drawing cost is bounded by visible pixels rather than by notes
+   std::unordered_set<uint64_t> painted;
+   auto alreadyPainted = [&painted](const wxRect &nr, int chan) {
+      if (nr.width > 0xfff || nr.height > 0xfff)
+         return false;
+      // Channels outside 1..16 all take the same gray
+      if (chan < 0 || chan >= 16)
+         chan = 16;
+      uint64_t key = (uint64_t(uint16_t(nr.x)) << 48) |
+                     (uint64_t(uint16_t(nr.y)) << 32) |
+                     (uint64_t(nr.width) << 20) |
+                     (uint64_t(nr.height) << 8) |
+                     uint64_t(chan);
+      return !painted.insert(key).second;
+   };
+
+   // Only the notes whose [time, time + dur] can overlap the window
+   const double ht0 = h - track->GetOffset();
+   const double ht1 = h1 - track->GetOffset();
+   auto first = std::upper_bound(cache.maxEnd.begin(), cache.maxEnd.end(), ht0)
+      - cache.maxEnd.begin();
+   //for every note
+   for (size_t ndx = first, cnt = cache.notes.size(); ndx < cnt; ndx++) {
+      auto &entry = cache.notes[ndx];
+      if (entry.time >= ht1)
+         break;
+      {
+         Alg_note_ptr note = entry.note;
          // if the note's channel is visible
-         if (track->IsVisibleChan(evt->chan)) {
-            double xx = note->time + track->GetOffset();
-            double x1 = xx + note->dur;
+         if (track->IsVisibleChan(note->chan)) {
+            double xx = entry.time + track->GetOffset();
+            double x1 = xx + entry.dur;
             if (xx < h1 && x1 > h) { // omit if outside box
-               const char *shape = NULL;
-               if (note->loud > 0.0 || 0 == (shape = IsShape(note))) {
+               const char *shape = entry.shape;
+               if (!shape) {
                   wxRect nr; // "note rectangle"
                   nr.y = data.PitchToY(note->pitch);
                   nr.height = data.GetPitchHeight(1);
@@ -495,6 +594,8 @@ void DrawNoteTrack(TrackPanelDrawingContext &context,
                          // too high for window
                          nr.y = rect.y;
                          nr.height = marg;
+                         if (alreadyPainted(nr, -1))
+                            continue;
                          dc.SetBrush(*wxBLACK_BRUSH);
                          dc.SetPen(*wxBLACK_PEN);
                          dc.DrawRectangle(nr);
@@ -502,6 +603,8 @@ void DrawNoteTrack(TrackPanelDrawingContext &context,
                          // too low for window
                          nr.y = rect.y + rect.height - marg;
                          nr.height = marg;
+                         if (alreadyPainted(nr, -1))
+                            continue;
                          dc.SetBrush(*wxBLACK_BRUSH);
                          dc.SetPen(*wxBLACK_PEN);
                          dc.DrawRectangle(nr);
@@ -514,6 +617,8 @@ void DrawNoteTrack(TrackPanelDrawingContext &context,
                            nr.y += offset;
                         }
                         // nr.y += rect.y;
+                        if (alreadyPainted(nr, note->chan))
+                           continue;
                         if (muted)
                            AColor::LightMIDIChannel(&dc, note->chan + 1);
                         else
@@ -692,7 +797,6 @@ void DrawNoteTrack(TrackPanelDrawingContext &context,
          }
       }
    }
-   iterator.end();
    // draw black line between top/bottom margins and the track
    dc.SetPen(*wxBLACK_PEN);
    AColor::Line(dc, rect.x, rect.y + marg, rect.x + rect.width, rect.y + marg);
@@ -722,7 +826,9 @@ void NoteTrackView::Draw(
       const auto hasSolo = artist->hasSolo;
       muted = (hasSolo || nt->GetMute()) && !nt->GetSolo();
 #endif
-      DrawNoteTrack( context, nt.get(), rect, muted );
+      if (!mpDrawCache)
+         mpDrawCache = std::make_unique<NoteTrackDrawCache>();
+      DrawNoteTrack( context, nt.get(), rect, muted, *mpDrawCache );
    }
    CommonTrackView::Draw( context, rect, iPass );
 }
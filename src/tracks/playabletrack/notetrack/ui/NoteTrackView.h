@@ -11,8 +11,12 @@ Paul Licameli split from class NoteTrack
 #ifndef __AUDACITY_NOTE_TRACK_VIEW__
 #define __AUDACITY_NOTE_TRACK_VIEW__
 
+#include <memory>
+
 #include "../../../ui/CommonTrackView.h"
 
+struct NoteTrackDrawCache;
+
 class NoteTrackView final : public CommonTrackView
 {
    NoteTrackView( const NoteTrackView& ) = delete;
@@ -35,5 +39,9 @@ private:
    void Draw(
       TrackPanelDrawingContext &context,
       const wxRect &rect, unsigned iPass ) override;
+
+   // Time-sorted snapshot of the notes of the sequence, rebuilt lazily
+   // when the sequence changes, so repaints need not visit every event
+   std::unique_ptr<NoteTrackDrawCache> mpDrawCache;
 };
 #endif
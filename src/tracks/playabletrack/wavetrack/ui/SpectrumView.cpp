@@ -301,7 +301,8 @@ void DrawClipSpectrum(TrackPanelDrawingContext &context,
    }
 #endif //EXPERIMENTAL_FFT_Y_GRID
 
-   if (!updated && clip->mSpecPxCache->valid &&
+   // The pixel cache is created on demand, below; null means invalid
+   if (!updated && clip->mSpecPxCache && clip->mSpecPxCache->valid &&
       ((int)clip->mSpecPxCache->len == hiddenMid.height * hiddenMid.width)
       && scaleType == clip->mSpecPxCache->scaleType
       && gain == clip->mSpecPxCache->gain
@@ -521,12 +522,23 @@ void DrawClipSpectrum(TrackPanelDrawingContext &context,
    // left pixel column of the fisheye
    int fisheyeLeft = zoomInfo.GetFisheyeLeftBoundary(-leftOffset);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-   for (int xx = 0; xx < mid.width; ++xx) {
+   // Per-column quantities don't depend on the row, so compute them once;
+   // then emit pixels row by row, so that the image buffer is written
+   // sequentially.  The old column-major order revisited every scan line
+   // of the image once per column, which thrashed the cache.
+   ArrayOf<int> correctedXs{ size_t(mid.width) };
+   ArrayOf<float *> uncachedCols{ size_t(mid.width) };
+   ArrayOf<bool> selectedCols{ size_t(mid.width) };
+   bool anySelected = false;
+
+   // Tabulate the time at each column boundary once, rather than converting
+   // twice per column below
+   auto &columnTimes = artist->columnTimes;
+   columnTimes.resize(mid.width + 1);
+   zoomInfo.FindColumnTimes(columnTimes.data(), mid.width + 1, -leftOffset);
 
-      int correctedX = xx + leftOffset - hiddenLeftOffset;
+   for (int xx = 0; xx < mid.width; ++xx) {
+      correctedXs[xx] = xx + leftOffset - hiddenLeftOffset;
 
       // in fisheye mode the time scale has changed, so the row values aren't cached
       // in the loop above, and must be fetched from fft cache
@@ -539,59 +551,82 @@ void DrawClipSpectrum(TrackPanelDrawingContext &context,
           wxASSERT(specIndex >= 0 && specIndex < (int)specCache.freq.size());
           uncached = &specCache.freq[specIndex];
       }
+      uncachedCols[xx] = uncached;
 
-      // zoomInfo must be queried for each column since with fisheye enabled
-      // time between columns is variable
-      auto w0 = sampleCount(0.5 + rate *
-                   (zoomInfo.PositionToTime(xx, -leftOffset) - tOffset));
+      auto w0 = sampleCount(0.5 + rate * (columnTimes[xx] - tOffset));
 
-      auto w1 = sampleCount(0.5 + rate *
-                    (zoomInfo.PositionToTime(xx+1, -leftOffset) - tOffset));
+      auto w1 = sampleCount(0.5 + rate * (columnTimes[xx + 1] - tOffset));
 
-      bool maybeSelected = ssel0 <= w0 && w1 < ssel1;
+      selectedCols[xx] = ssel0 <= w0 && w1 < ssel1;
+      anySelected = anySelected || selectedCols[xx];
+   }
 
-      for (int yy = 0; yy < hiddenMid.height; ++yy) {
-         const float bin     = bins[yy];
-         const float nextBin = bins[yy+1];
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+   for (int yy = 0; yy < hiddenMid.height; ++yy) {
+      const float bin     = bins[yy];
+      const float nextBin = bins[yy+1];
+
+      // For spectral selection, determine what colour
+      // set to use.  We use a darker selection if
+      // in both spectral range and time range.
+      // The choice depends on the column only through the dash parity,
+      // so resolve it here for both parities rather than per pixel.
+      AColor::ColorGradientChoice selectedOf[2] {
+         AColor::ColorGradientUnselected, AColor::ColorGradientUnselected };
+      if (anySelected)
+         for (int parity = 0; parity < 2; ++parity)
+            selectedOf[parity] =
+               ChooseColorSet(bin, nextBin, selBinLo, selBinCenter, selBinHi,
+                  parity, isSpectral);
+
+#ifdef EXPERIMENTAL_FFT_Y_GRID
+      const bool dimRow = fftYGrid && yGrid[yy];
+#endif //EXPERIMENTAL_FFT_Y_GRID
 
-         // For spectral selection, determine what colour
-         // set to use.  We use a darker selection if
-         // in both spectral range and time range.
+      unsigned char *row = data + (mid.height - 1 - yy) * mid.width * 3;
+#ifdef EXPERIMENTAL_SPECTROGRAM_OVERLAY
+      unsigned char *alphaRow = alpha + (mid.height - 1 - yy) * mid.width;
+#endif
 
+      for (int xx = 0; xx < mid.width; ++xx) {
          AColor::ColorGradientChoice selected = AColor::ColorGradientUnselected;
 
          // If we are in the time selected range, then we may use a different color set.
-         if (maybeSelected)
-            selected =
-               ChooseColorSet(bin, nextBin, selBinLo, selBinCenter, selBinHi,
-                  (xx + leftOffset - hiddenLeftOffset) / DASH_LENGTH, isSpectral);
+         if (selectedCols[xx])
+            selected = selectedOf[(correctedXs[xx] / DASH_LENGTH) % 2];
 
+         const float *uncached = uncachedCols[xx];
          const float value = uncached
             ? findValue(uncached, bin, nextBin, nBins, autocorrelation, gain, range)
-            : clip->mSpecPxCache->values[correctedX * hiddenMid.height + yy];
+            : clip->mSpecPxCache->values[correctedXs[xx] * hiddenMid.height + yy];
 
-         unsigned char rv, gv, bv;
-         GetColorGradient(value, selected, isGrayscale, &rv, &gv, &bv);
+         // Look the colour up directly in the precomputed gradient table
+         const unsigned char *entry =
+            AColor::gradient_pre[selected][isGrayscale]
+               [int(value * (AColor::gradientSteps - 1))];
+         unsigned char rv = entry[0];
+         unsigned char gv = entry[1];
+         unsigned char bv = entry[2];
 
 #ifdef EXPERIMENTAL_FFT_Y_GRID
-         if (fftYGrid && yGrid[yy]) {
+         if (dimRow) {
             rv /= 1.1f;
             gv /= 1.1f;
             bv /= 1.1f;
          }
 #endif //EXPERIMENTAL_FFT_Y_GRID
 
-         int px = ((mid.height - 1 - yy) * mid.width + xx);
 #ifdef EXPERIMENTAL_SPECTROGRAM_OVERLAY
          // More transparent the closer to zero intensity.
-         alpha[px]= wxMin( 200, (value+0.3) * 500) ;
+         alphaRow[xx] = wxMin( 200, (value+0.3) * 500) ;
 #endif
-         px *=3;
-         data[px++] = rv;
-         data[px++] = gv;
-         data[px] = bv;
-      } // each yy
-   } // each xx
+         *row++ = rv;
+         *row++ = gv;
+         *row++ = bv;
+      } // each xx
+   } // each yy
 
    wxBitmap converted = wxBitmap(image);
 
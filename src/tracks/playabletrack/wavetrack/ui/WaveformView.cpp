@@ -32,12 +32,16 @@ Paul Licameli split from WaveTrackView.cpp
 #include "../../../../ViewInfo.h"
 #include "../../../../WaveClip.h"
 #include "../../../../WaveTrack.h"
+#include "../../../../ondemand/ODManager.h"
 #include "../../../../prefs/WaveformSettings.h"
 
 #include <wx/graphics.h>
 #include <wx/dc.h>
+#include <wx/dcmemory.h>
 
-WaveformView::~WaveformView() = default;
+#include <algorithm>
+#include <cmath>
+#include <functional>
 
 std::vector<UIHandlePtr> WaveformView::DetailedHitTest(
    const TrackPanelMouseState &st,
@@ -181,9 +185,14 @@ void DrawWaveformBackground(TrackPanelDrawingContext &context,
    dc.SetBrush(blankBrush);
    dc.DrawRectangle(rect);
 
-   double time = zoomInfo.PositionToTime(0, -leftOffset), nextTime;
-   for (xx = 0; xx < rect.width; ++xx, time = nextTime) {
-      nextTime = zoomInfo.PositionToTime(xx + 1, -leftOffset);
+   // Precompute the time at each column boundary once per clip, rather than
+   // converting again for every column
+   auto &columnTimes = artist->columnTimes;
+   columnTimes.resize(rect.width + 1);
+   zoomInfo.FindColumnTimes(columnTimes.data(), rect.width + 1, -leftOffset);
+
+   for (xx = 0; xx < rect.width; ++xx) {
+      const double time = columnTimes[xx], nextTime = columnTimes[xx + 1];
       // First we compute the truncated shape of the waveform background.
       // If drawEnvelope is true, then we compute the lower border of the
       // envelope.
@@ -978,6 +987,280 @@ void DrawTimeSlider( TrackPanelDrawingContext &context,
 
 }
 
+// Cache of rendered waveform strips ("tiles").  Each tile is a bitmap
+// tileWidth pixel columns wide, anchored to the time scale rather than to
+// the window, so horizontal scrolling blits tiles that are still visible
+// back to the screen and rasterizes only the newly exposed ones.
+class WaveformTileCache
+{
+public:
+   enum : int { tileWidth = 256 };
+
+   // Draw the waveform for rect entirely from tiles, rendering any that
+   // are missing or stale.  Returns false, drawing nothing, when cached
+   // bitmaps could not faithfully reproduce a direct drawing; the caller
+   // then falls back to DrawClipWaveform.
+   bool Draw(TrackPanelDrawingContext &context,
+      const WaveTrack *track, const wxRect &rect, bool muted, bool dB);
+
+private:
+   struct Tile {
+      wxBitmap bitmap;
+      wxInt64 index;       // left edge, in units of tileWidth, on the
+                           // absolute (unscrolled) pixel scale
+      double selT0, selT1; // selection interval baked into the pixels
+   };
+
+   Tile *FindTile(wxInt64 index);
+   bool RenderTile(Tile &tile, TrackPanelDrawingContext &context,
+      const WaveTrack *track, const wxRect &rect,
+      double tileT0, bool muted, bool dB);
+   static size_t Fingerprint(const WaveTrack *track);
+
+   // Values that invalidate every tile when they change
+   double mZoom{ 0 };
+   double mFrac{ -1 };     // fractional pixel part of the scroll position
+   int mHeight{ 0 };
+   float mZoomMin{ 0 }, mZoomMax{ 0 };
+   float mDBRange{ 0 };
+   bool mDB{ false };
+   bool mMuted{ false };
+   bool mSelected{ false };
+   bool mShowClipping{ false };
+   int mSampleDisplay{ 0 };
+   size_t mFingerprint{ 0 };
+
+   // Lent to the drawing routines so that the tile's left edge plays the
+   // part of the left edge of the visible area
+   std::unique_ptr<ZoomInfo> mZoomInfo;
+
+   std::vector<Tile> mTiles;
+};
+
+WaveformTileCache::Tile *WaveformTileCache::FindTile(wxInt64 index)
+{
+   for (auto &tile : mTiles)
+      if (tile.index == index)
+         return &tile;
+   return nullptr;
+}
+
+namespace {
+
+inline void CombineHash(size_t &seed, size_t value)
+{
+   seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+}
+
+// Hash of everything about the track's contents that the drawing depends
+// on; a changed hash throws all tiles away.  Edits bump each clip's dirty
+// counter, so that and the envelope control points cover invalidation.
+size_t WaveformTileCache::Fingerprint(const WaveTrack *track)
+{
+   size_t seed = std::hash<size_t>{}(track->GetClips().size());
+   for (const auto &clip : track->GetClips()) {
+      CombineHash(seed, std::hash<int>{}(clip->GetDirty()));
+      CombineHash(seed, std::hash<double>{}(clip->GetOffset()));
+      CombineHash(seed, std::hash<int>{}(clip->GetColourIndex()));
+      const auto &env = *clip->GetEnvelope();
+      const auto nPoints = env.GetNumberOfPoints();
+      CombineHash(seed, std::hash<size_t>{}(nPoints));
+      for (size_t ii = 0; ii < nPoints; ++ii) {
+         const auto &point = env[(int)ii];
+         CombineHash(seed, std::hash<double>{}(point.GetT()));
+         CombineHash(seed, std::hash<double>{}(point.GetVal()));
+      }
+   }
+   return seed;
+}
+
+bool WaveformTileCache::RenderTile(Tile &tile,
+   TrackPanelDrawingContext &context,
+   const WaveTrack *track, const wxRect &rect,
+   double tileT0, bool muted, bool dB)
+{
+   if (!tile.bitmap.IsOk() ||
+       tile.bitmap.GetWidth() != tileWidth ||
+       tile.bitmap.GetHeight() != rect.height)
+      tile.bitmap.Create(tileWidth, rect.height);
+   if (!tile.bitmap.IsOk())
+      return false;
+
+   wxMemoryDC memDC{ tile.bitmap };
+   if (!memDC.IsOk())
+      return false;
+   // Map the rectangle's corner to the bitmap's origin, so the drawing
+   // routines can work in the usual window coordinates
+   memDC.SetDeviceOrigin(-rect.x, -rect.y);
+
+   const auto artist = TrackArtist::Get( context );
+
+   if (!mZoomInfo)
+      mZoomInfo = std::make_unique<ZoomInfo>(tileT0, mZoom);
+   else {
+      mZoomInfo->SetZoom(mZoom);
+      mZoomInfo->h = tileT0;
+   }
+
+   // Let the artist see the time scale through the tile's eyes while we
+   // re-enter the ordinary drawing routines
+   const auto pPrevZoomInfo = artist->pZoomInfo;
+   artist->pZoomInfo = mZoomInfo.get();
+   auto cleanup = finally( [&]{ artist->pZoomInfo = pPrevZoomInfo; } );
+
+   TrackPanelDrawingContext tileContext{ memDC, {}, {}, context.pUserData };
+   const wxRect tileRect{ rect.x, rect.y, tileWidth, rect.height };
+
+   TrackArt::DrawBackgroundWithSelection(
+      tileContext, tileRect, track,
+      artist->blankSelectedBrush, artist->blankBrush );
+
+   for (const auto &clip : track->GetClips())
+      DrawClipWaveform(tileContext, track, clip.get(), tileRect, dB, muted);
+
+   memDC.SelectObject(wxNullBitmap);
+   return true;
+}
+
+bool WaveformTileCache::Draw(TrackPanelDrawingContext &context,
+   const WaveTrack *track, const wxRect &rect, bool muted, bool dB)
+{
+   auto &dc = context.dc;
+   const auto artist = TrackArtist::Get( context );
+   const auto &zoomInfo = *artist->pZoomInfo;
+   const auto &selectedRegion = *artist->pSelectedRegion;
+
+   if (rect.width <= 0 || rect.height <= 0)
+      return false;
+   // A drag target may ask for highlighted drawing of its object
+   if (context.target)
+      return false;
+   // Envelope bands and big sample points change with the active tool
+   if (artist->drawEnvelope || artist->bigPoints)
+      return false;
+   // The sync-lock watermark is anchored to the window, not the time scale
+   if (track->IsSyncLockSelected())
+      return false;
+   // While on-demand loading runs, the placeholder drawing animates
+   if (ODManager::IsInstanceCreated())
+      return false;
+   if (zoomInfo.GetFisheyeState() != ZoomInfo::HIDDEN)
+      return false;
+
+   const double zoom = zoomInfo.GetZoom();
+   // Scroll position in pixels; normally integral, because scrolling is
+   // done in whole pixels.  Its fractional part is baked into the tiles.
+   const double before = zoomInfo.h * zoom;
+   const double whole = floor(before);
+   const double frac = before - whole;
+
+   float zoomMin, zoomMax;
+   track->GetDisplayBounds(&zoomMin, &zoomMax);
+   const float dBRange = track->GetWaveformSettings().dBRange;
+   const bool selected = track->GetSelected();
+   const size_t fingerprint = Fingerprint(track);
+
+   if (zoom != mZoom || frac != mFrac || rect.height != mHeight ||
+       zoomMin != mZoomMin || zoomMax != mZoomMax ||
+       dB != mDB || dBRange != mDBRange ||
+       muted != mMuted || selected != mSelected ||
+       artist->mShowClipping != mShowClipping ||
+       artist->mSampleDisplay != mSampleDisplay ||
+       fingerprint != mFingerprint) {
+      mTiles.clear();
+      mZoom = zoom;
+      mFrac = frac;
+      mHeight = rect.height;
+      mZoomMin = zoomMin;
+      mZoomMax = zoomMax;
+      mDB = dB;
+      mDBRange = dBRange;
+      mMuted = muted;
+      mSelected = selected;
+      mShowClipping = artist->mShowClipping;
+      mSampleDisplay = artist->mSampleDisplay;
+      mFingerprint = fingerprint;
+   }
+
+   // Tiles overlapping the visible columns
+   const wxInt64 whole64 = wxInt64(whole);
+   const wxInt64 first = (whole64 >= 0 ? whole64 : whole64 - tileWidth + 1)
+      / tileWidth;
+   const wxInt64 last = (whole64 + rect.width - 1 >= 0
+      ? whole64 + rect.width - 1
+      : whole64 + rect.width - tileWidth) / tileWidth;
+
+   const double sel0 = selected ? selectedRegion.t0() : 0.0;
+   const double sel1 = selected ? selectedRegion.t1() : 0.0;
+
+   // First make sure every needed tile is rendered, so that nothing has
+   // been drawn yet if we must give up and fall back
+   for (wxInt64 index = first; index <= last; ++index) {
+      const double tileT0 = (index * (double)tileWidth + frac) / zoom;
+      const double tileT1 = tileT0 + tileWidth / zoom;
+
+      // Selection interval as it affects this tile only, so a selection
+      // change re-renders just the tiles it touches
+      double tileSel0 = std::max(sel0, tileT0);
+      double tileSel1 = std::min(sel1, tileT1);
+      if (tileSel0 >= tileSel1)
+         tileSel0 = tileSel1 = 0.0;
+
+      auto pTile = FindTile(index);
+      if (pTile && pTile->selT0 == tileSel0 && pTile->selT1 == tileSel1)
+         continue;
+      if (!pTile) {
+         mTiles.push_back({});
+         pTile = &mTiles.back();
+         pTile->index = index;
+      }
+      pTile->selT0 = tileSel0;
+      pTile->selT1 = tileSel1;
+      if (!RenderTile(*pTile, context, track, rect, tileT0, muted, dB))
+         return false;
+   }
+
+   // Blit the visible slice of each tile
+   wxMemoryDC srcDC;
+   for (wxInt64 index = first; index <= last; ++index) {
+      auto pTile = FindTile(index);
+      wxASSERT(pTile);
+      const int destX = rect.x + int(index * tileWidth - whole64);
+      const int x0 = std::max(destX, rect.x);
+      const int x1 = std::min<int>(destX + tileWidth, rect.x + rect.width);
+      if (x1 <= x0)
+         continue;
+      srcDC.SelectObjectAsSource(pTile->bitmap);
+      dc.Blit(x0, rect.y, x1 - x0, rect.height, &srcDC, x0 - destX, 0);
+      srcDC.SelectObject(wxNullBitmap);
+   }
+
+   // Keep up to about one screenful of off-screen tiles each side
+   const wxInt64 keep = last - first + 1;
+   mTiles.erase(
+      std::remove_if(mTiles.begin(), mTiles.end(),
+         [&](const Tile &tile){
+            return tile.index < first - keep || tile.index > last + keep;
+         }),
+      mTiles.end());
+
+   // DrawClipWaveform would have remembered each clip's screen rectangle,
+   // which hit tests use; do the same for the cached path
+   for (const auto &clip : track->GetClips()) {
+      const ClipParameters params{
+         false, track, clip.get(), rect, selectedRegion, zoomInfo };
+      if (params.hiddenMid.width > 0)
+         clip->SetDisplayRect(params.hiddenMid);
+   }
+
+   return true;
+}
+
+// Defined here, where WaveformTileCache is complete
+WaveformView::~WaveformView() = default;
+
 // Headers needed only for experimental drawing below
 //#include "tracks/ui/TimeShiftHandle.h"
 //#include "tracks/playabletrack/wavetrack/ui/CutlineHandle.h"
@@ -1004,9 +1287,12 @@ void WaveformView::DoDraw(TrackPanelDrawingContext &context,
    TrackArt::DrawBackgroundWithSelection(
       context, rect, track, blankSelectedBrush, blankBrush );
 
-   for (const auto &clip: track->GetClips())
-      DrawClipWaveform(context, track, clip.get(), rect,
-                       dB, muted);
+   if (!mTileCache)
+      mTileCache = std::make_unique<WaveformTileCache>();
+   if (!mTileCache->Draw(context, track, rect, muted, dB))
+      for (const auto &clip: track->GetClips())
+         DrawClipWaveform(context, track, clip.get(), rect,
+                          dB, muted);
 
    // Update cache for locations, e.g. cutlines and merge points
    track->UpdateLocationsCache();
@@ -13,10 +13,13 @@ Paul Licameli split from WaveTrackView.h
 
 #include "WaveTrackView.h" // to inherit
 
+#include <memory>
+
 class WaveTrack;
 class CutlineHandle;
 class SampleHandle;
 class EnvelopeHandle;
+class WaveformTileCache;
 
 class WaveformView final : public WaveTrackSubView
 {
@@ -37,7 +40,7 @@ private:
    void Draw(
       TrackPanelDrawingContext &context,
       const wxRect &rect, unsigned iPass ) override;
-   static void DoDraw(TrackPanelDrawingContext &context,
+   void DoDraw(TrackPanelDrawingContext &context,
                                const WaveTrack *track,
                                const wxRect & rect,
                                bool muted);
@@ -53,6 +56,9 @@ protected:
    std::weak_ptr<CutlineHandle> mCutlineHandle;
    std::weak_ptr<SampleHandle> mSampleHandle;
    std::weak_ptr<EnvelopeHandle> mEnvelopeHandle;
+
+   // Cache of pre-rendered waveform strips, reused while scrolling
+   std::unique_ptr<WaveformTileCache> mTileCache;
 };
 
 #endif
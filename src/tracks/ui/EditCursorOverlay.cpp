@@ -11,7 +11,6 @@ Paul Licameli split from TrackPanel.cpp
 #include "../../Audacity.h"
 #include "EditCursorOverlay.h"
 
-#include "TrackView.h"
 #include "../../AColor.h"
 #include "../../AdornedRulerPanel.h"
 #include "../../Project.h"
@@ -103,17 +102,15 @@ void EditCursorOverlay::Draw(OverlayPanel &panel, wxDC &dc)
       wxASSERT(mIsMaster);
       AColor::CursorColor(&dc);
 
-      // Draw cursor in all selected tracks
-      tp->VisitCells( [&]( const wxRect &rect, TrackPanelCell &cell ) {
-         const auto pTrackView = dynamic_cast<TrackView*>(&cell);
-         if (!pTrackView)
-            return;
-         const auto pTrack = pTrackView->FindTrack();
-         if (pTrack->GetSelected() ||
-             TrackFocus::Get( *mProject ).IsFocused( pTrack.get() ))
+      // Draw cursor in all selected tracks.  As in PlayIndicatorOverlay,
+      // visit the visible spans directly instead of rebuilding the whole
+      // subdivision of cells for each redraw.
+      tp->VisitVisibleChannels( [&]( Track &channel, int top, int bottom ) {
+         if (channel.GetSelected() ||
+             TrackFocus::Get( *mProject ).IsFocused( &channel ))
          {
-            // AColor::Line includes both endpoints so use GetBottom()
-            AColor::Line(dc, mLastCursorX, rect.GetTop(), mLastCursorX, rect.GetBottom());
+            // AColor::Line includes both endpoints
+            AColor::Line(dc, mLastCursorX, top, mLastCursorX, bottom);
             // ^^^ The whole point of this routine.
 
          }
@@ -22,7 +22,6 @@ Paul Licameli split from TrackPanel.cpp
 #include "../../TrackPanel.h"
 #include "../../ViewInfo.h"
 #include "Scrubbing.h"
-#include "TrackView.h"
 
 #include <wx/dc.h>
 
@@ -100,21 +99,22 @@ void PlayIndicatorOverlayBase::Draw(OverlayPanel &panel, wxDC &dc)
    if(auto tp = dynamic_cast<TrackPanel*>(&panel)) {
       wxASSERT(mIsMaster);
 
-      // Draw indicator in all visible tracks
-      tp->VisitCells( [&]( const wxRect &rect, TrackPanelCell &cell ) {
-         const auto pTrackView = dynamic_cast<TrackView*>(&cell);
-         if (pTrackView) pTrackView->FindTrack()->TypeSwitch(
+      // Draw indicator in all visible tracks.  The spans are visited
+      // directly, rather than through VisitCells, so that this 20 Hz
+      // redraw does not rebuild the whole subdivision of cells.
+      tp->VisitVisibleChannels( [&]( Track &channel, int top, int bottom ) {
+         channel.TypeSwitch(
             [](LabelTrack *) {
                // Don't draw the indicator in label tracks
             },
             [&](Track *) {
                // Draw the NEW indicator in its NEW location
-               // AColor::Line includes both endpoints so use GetBottom()
+               // AColor::Line includes both endpoints
                AColor::Line(dc,
                             mLastIndicatorX,
-                            rect.GetTop(),
+                            top,
                             mLastIndicatorX,
-                            rect.GetBottom());
+                            bottom);
             }
          );
       } );
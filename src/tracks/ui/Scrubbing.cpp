@@ -241,6 +241,8 @@ Scrubber::~Scrubber()
       mpThread->Delete();
 #endif
 
+   StopPrefetch();
+
    if ( mWindow )
       mWindow->PopEventHandler();
 }
@@ -630,6 +632,18 @@ void Scrubber::ContinueScrubbingPoll()
             xx = origin + delta;
          }
          const double time = viewInfo.PositionToTime(xx, origin);
+
+         // Leave a motion prediction for the prefetch thread:  estimate
+         // velocity from the change of target time over one poll interval.
+         {
+            const double interval = ScrubPollInterval_ms / 1000.0;
+            mPrefetchSpeed.store( mLastTargetTime < 0
+               ? 0.0
+               : (time - mLastTargetTime) / interval );
+            mPrefetchTime.store( time );
+            mLastTargetTime = time;
+         }
+
          mOptions.adjustStart = seek;
          mOptions.minSpeed = seek ? 1.0 : 0.0;
          mOptions.maxSpeed = seek ? 1.0 : mMaxSpeed;
@@ -706,7 +720,9 @@ void Scrubber::StartPolling()
    mpThread->Create(4096);
    mpThread->Run();
 #endif
-   
+
+   StartPrefetch();
+
    mPoller->Start(ScrubPollInterval_ms * 0.9);
 }
 
@@ -720,10 +736,94 @@ void Scrubber::StopPolling()
       mpThread = nullptr;
    }
 #endif
-   
+
+   StopPrefetch();
+
    mPoller->Stop();
 }
 
+void Scrubber::StartPrefetch()
+{
+   StopPrefetch();
+
+   // Snapshot the wave tracks on the main thread; the shared pointers keep
+   // them alive for the prefetch thread even if the track list changes.
+   for ( auto track : TrackList::Get( *mProject ).Any< const WaveTrack >() )
+      mPrefetchTracks.push_back(
+         track->SharedPointer< const WaveTrack >() );
+
+   if (mPrefetchTracks.empty())
+      return;
+
+   mLastTargetTime = -1.0;
+   mPrefetchTime.store( -1.0 );
+   mPrefetchSpeed.store( 0.0 );
+   mPrefetchStop.store( false );
+   mPrefetchThread = std::thread( [this]{ PrefetchLoop(); } );
+}
+
+void Scrubber::StopPrefetch()
+{
+   mPrefetchStop.store( true );
+   if (mPrefetchThread.joinable())
+      mPrefetchThread.join();
+   mPrefetchTracks.clear();
+}
+
+void Scrubber::PrefetchLoop()
+{
+   // Read a window of samples around the predicted scrub position, leading
+   // it in the direction of recent motion.  The reads are advisory only --
+   // they populate the operating system's caches and the tracks' block
+   // summaries -- so errors are ignored (mayThrow false); playback will
+   // report any that matter.
+   constexpr double lookahead = 1.0; // seconds of predicted travel
+   constexpr double margin = 0.25;   // seconds behind, for reversals
+   constexpr double maxWindow = 5.0; // bound the work for fast scrubs
+
+   size_t bufferSize = 0;
+   for (auto &track : mPrefetchTracks)
+      bufferSize = std::max( bufferSize, track->GetMaxBlockSize() );
+   Floats buffer{ bufferSize };
+
+   // The interval already warmed; successive polls mostly land inside it
+   double warmed0 = 0.0, warmed1 = -1.0;
+
+   while (!mPrefetchStop.load()) {
+      const double time = mPrefetchTime.load();
+      const double speed = mPrefetchSpeed.load();
+      if (time >= 0) {
+         const double lead =
+            std::max( -maxWindow, std::min( maxWindow, speed * lookahead ) );
+         const double t0 = std::min( time, time + lead ) - margin;
+         const double t1 = std::max( time, time + lead ) + margin;
+         if (t0 < warmed0 || t1 > warmed1) {
+            for (auto &track : mPrefetchTracks) {
+               if (mPrefetchStop.load())
+                  break;
+               const double tt0 = std::max( t0, track->GetStartTime() );
+               const double tt1 = std::min( t1, track->GetEndTime() );
+               if (tt1 <= tt0)
+                  continue;
+               auto s = track->TimeToLongSamples(tt0);
+               const auto end = track->TimeToLongSamples(tt1);
+               while (s < end && !mPrefetchStop.load()) {
+                  const auto block = limitSampleBufferSize(
+                     std::min( bufferSize, track->GetBestBlockSize(s) ),
+                     end - s );
+                  track->Get( (samplePtr)buffer.get(), floatSample,
+                     s, block, fillZero, false );
+                  s += block;
+               }
+            }
+            warmed0 = t0;
+            warmed1 = t1;
+         }
+      }
+      ::wxMilliSleep(ScrubPollInterval_ms);
+   }
+}
+
 void Scrubber::StopScrubbing()
 {
    auto gAudioIO = AudioIO::Get();
@@ -14,6 +14,9 @@ Paul Licameli split from TrackPanel.cpp
 #include "../../Audacity.h"
 #include "../../Experimental.h"
 
+#include <atomic>
+#include <memory>
+#include <thread>
 #include <vector>
 #include <wx/longlong.h>
 
@@ -26,6 +29,7 @@ Paul Licameli split from TrackPanel.cpp
 #include "../../../include/audacity/Types.h"
 
 class AudacityProject;
+class WaveTrack;
 extern AudacityProject *GetActiveProject();
 
 // Conditionally compile either a separate thead, or else use a timer in the main
@@ -140,6 +144,9 @@ private:
 
    void StartPolling();
    void StopPolling();
+   void StartPrefetch();
+   void StopPrefetch();
+   void PrefetchLoop();
    void DoScrub(bool seek);
    void OnActivateOrDeactivateApp(wxActivateEvent & event);
 
@@ -179,6 +186,18 @@ private:
    class ScrubPoller;
    std::unique_ptr<ScrubPoller> mPoller;
 
+   // A helper thread that reads ahead of the predicted scrub position, so
+   // the playback thread's own fetches find the track blocks already warm.
+   // The polling routine leaves its latest target time and an estimated
+   // velocity in the atomics; the snapshotted track pointers are taken on
+   // the main thread and keep the tracks alive while the thread runs.
+   std::thread mPrefetchThread;
+   std::atomic<bool> mPrefetchStop { false };
+   std::atomic<double> mPrefetchTime { -1.0 };
+   std::atomic<double> mPrefetchSpeed { 0.0 };
+   double mLastTargetTime { -1.0 }; // used by the polling routine only
+   std::vector< std::shared_ptr< const WaveTrack > > mPrefetchTracks;
+
    ScrubbingOptions mOptions;
    double mMaxSpeed { 1.0 };
 
@@ -649,6 +649,34 @@ void Grid::OnKeyDown(wxKeyEvent &event)
    }
 }
 
+bool Grid::RefreshRowCount()
+{
+   wxGridTableBase *table = GetTable();
+   if (!table)
+      return false;
+
+   // A virtual table reports the row count of its underlying store, but
+   // the grid works from a cached count, so tell it about the difference
+   int cached = GetNumberRows();
+   int actual = table->GetNumberRows();
+   if (actual > cached) {
+      wxGridTableMessage msg(table, wxGRIDTABLE_NOTIFY_ROWS_APPENDED,
+                             actual - cached);
+      ProcessTableMessage(msg);
+   }
+   else if (actual < cached) {
+      wxGridTableMessage msg(table, wxGRIDTABLE_NOTIFY_ROWS_DELETED,
+                             actual, cached - actual);
+      ProcessTableMessage(msg);
+   }
+
+#if wxUSE_ACCESSIBILITY
+   mAx->TableUpdated();
+#endif
+
+   return true;
+}
+
 #if wxUSE_ACCESSIBILITY
 void Grid::ClearGrid()
 {
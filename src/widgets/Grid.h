@@ -194,6 +194,11 @@ class Grid final : public wxGrid
 
    ~Grid();
 
+   // Bring the grid's cached row count up to date with an attached table
+   // that computes its count from an external store, as a virtual table
+   // model does, and let accessibility know about the change
+   bool RefreshRowCount();
+
 #if wxUSE_ACCESSIBILITY
    void ClearGrid();
    bool InsertRows(int pos = 0, int numRows = 1, bool updateLabels = true);
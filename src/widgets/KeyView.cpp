@@ -169,6 +169,7 @@ KeyView::KeyView(wxWindow *parent,
 
    // The default view
    mViewType = ViewByTree;
+   mLastFilterView = ViewByTree;
 
    // Calculate measurements used for columns and scrolling
    RecalcExtents();
@@ -372,10 +373,11 @@ KeyView::SetKey(int index, const NormalizedKeyString & key)
 
    // Set the NEW key
    node.key = key;
+   node.keyLower = key.Display().Lower();
 
    // Check to see if the key column needs to be expanded
    int x, y;
-   GetTextExtent(node.key.Display(), &x, &y);
+   CachedTextExtent(node.key.Display(), &x, &y);
    if (x > mKeyWidth || y > mLineHeight)
    {
       // New key is wider than column so recalc extents (will refresh view)
@@ -540,6 +542,28 @@ KeyView::CollapseAll()
    RefreshLines();
 }
 
+//
+// Measure a string through the extent cache.  Bindings are refreshed after
+// every reassignment in the shortcuts editor, and all but one of the strings
+// are the same as before, so this saves nearly all of the native text
+// measurement calls.  The cache need never be invalidated since the font
+// does not change within the life of the view.
+//
+void
+KeyView::CachedTextExtent(const wxString & text, int *x, int *y)
+{
+   auto iter = mExtentCache.find(text);
+   if (iter == mExtentCache.end())
+   {
+      wxSize size;
+      GetTextExtent(text, &size.x, &size.y);
+      iter = mExtentCache.insert({ text, size }).first;
+   }
+
+   *x = iter->second.x;
+   *y = iter->second.y;
+}
+
 //
 // Recalculate the measurements used for columns and scrolling
 //
@@ -561,17 +585,17 @@ KeyView::RecalcExtents()
       if (node.iscat)
       {
          // Measure the category
-         GetTextExtent(node.category, &x, &y);
+         CachedTextExtent(node.category, &x, &y);
       }
       else if (node.ispfx)
       {
          // Measure the prefix
-         GetTextExtent(node.prefix, &x, &y);
+         CachedTextExtent(node.prefix, &x, &y);
       }
       else
       {
          // Measure the key
-         GetTextExtent(node.key.Display(), &x, &y);
+         CachedTextExtent(node.key.Display(), &x, &y);
          mLineHeight = wxMax(mLineHeight, y);
          mKeyWidth = wxMax(mKeyWidth, x);
 
@@ -583,7 +607,7 @@ KeyView::RecalcExtents()
          }
 
          // Measure the label
-         GetTextExtent(label, &x, &y);
+         CachedTextExtent(label, &x, &y);
       }
 
       // Finish calc for command column
@@ -641,8 +665,11 @@ KeyView::RefreshBindings(const CommandIDs & names,
                          bool bSort
                          )
 {
-   // Start clean
+   // Start clean.  The lines point into mNodes, so they are stale now, and
+   // the incremental filtering in RefreshLines must not rescan them.
    mNodes.clear();
+   mLines.clear();
+   mLastFilter.clear();
 
    // Same as in RecalcExtents() but do it inline
    mLineHeight = 0;
@@ -706,6 +733,7 @@ KeyView::RefreshBindings(const CommandIDs & names,
             node.category = cat;
             node.prefix = pfx;
             node.label = cat;
+            node.labelLower = cat.Lower();
             node.index = nodecnt++;
             node.iscat = true;
             node.isparent = true;
@@ -717,7 +745,7 @@ KeyView::RefreshBindings(const CommandIDs & names,
             incat = true;
 
             // Measure category
-            GetTextExtent(cat, &x, &y);
+            CachedTextExtent(cat, &x, &y);
             mLineHeight = wxMax(mLineHeight, y);
             mCommandWidth = wxMax(mCommandWidth, x);
          }
@@ -746,6 +774,7 @@ KeyView::RefreshBindings(const CommandIDs & names,
             node.category = cat;
             node.prefix = pfx;
             node.label = pfx;
+            node.labelLower = pfx.Lower();
             node.index = nodecnt++;
             node.ispfx = true;
             node.isparent = true;
@@ -783,6 +812,8 @@ KeyView::RefreshBindings(const CommandIDs & names,
       // Fill in remaining info
       node.name = name;
       node.key = keys[i];
+      node.labelLower = node.label.Lower();
+      node.keyLower = node.key.Display().Lower();
       node.index = nodecnt++;
       node.depth = depth;
 
@@ -790,7 +821,7 @@ KeyView::RefreshBindings(const CommandIDs & names,
       mNodes.push_back(node);
 
       // Measure key
-      GetTextExtent(node.key.Display(), &x, &y);
+      CachedTextExtent(node.key.Display(), &x, &y);
       mLineHeight = wxMax(mLineHeight, y);
       mKeyWidth = wxMax(mKeyWidth, x);
 
@@ -803,7 +834,7 @@ KeyView::RefreshBindings(const CommandIDs & names,
       }
 
       // Measure label
-      GetTextExtent(label, &x, &y);
+      CachedTextExtent(label, &x, &y);
       mLineHeight = wxMax(mLineHeight, y);
       mCommandWidth = wxMax(mCommandWidth, x);
    }
@@ -849,55 +880,73 @@ KeyView::RefreshLines(bool bSort)
 {
    int cnt = (int) mNodes.size();
    int linecnt = 0;
-   mLines.clear();
 
    // Process a filter if one is set
    if (!mFilter.empty())
    {
-      // Examine all nodes
-      for (int i = 0; i < cnt; i++)
+      // A filter that merely extends the previous one can only shrink the
+      // matches, so it is enough to rescan the lines that survived the last
+      // pass instead of every node.  This is the common case as each
+      // keystroke in the search box appends a character.
+      std::vector<KeyNode*> candidates;
+      if (!mLastFilter.empty() &&
+          mFilter.StartsWith(mLastFilter) &&
+          mViewType == mLastFilterView)
       {
-         KeyNode & node = mNodes[i];
+         candidates.swap(mLines);
+      }
+      else
+      {
+         candidates.reserve(cnt);
+         for (int i = 0; i < cnt; i++)
+         {
+            candidates.push_back(&mNodes[i]);
+         }
+      }
+      mLines.clear();
+
+      // Examine the candidate nodes
+      for (auto candidate : candidates)
+      {
+         KeyNode & node = *candidate;
 
          // Reset line number
          node.line = wxNOT_FOUND;
 
-         // Search columns based on view type
-         wxString searchit;
+         // Search columns based on view type, using the lowercased strings
+         // prepared in RefreshBindings rather than building them here for
+         // every node again
+         bool match = false;
          switch (mViewType)
          {
-            // The x"01" separator is used to prevent finding a
-            // match comprising the end of the label and beginning
-            // of the key.  It was chosen since it's not very likely
-            // to appear in the filter itself.
             case ViewByTree:
-               searchit = node.label.Lower() +
-                          wxT("\01x") +
-                          node.key.Display().Lower();
+               match = node.labelLower.Find(mFilter) != wxNOT_FOUND ||
+                       node.keyLower.Find(mFilter) != wxNOT_FOUND;
             break;
 
             case ViewByName:
-               searchit = node.label.Lower();
+               match = node.labelLower.Find(mFilter) != wxNOT_FOUND;
             break;
 
             case ViewByKey:
-               searchit = node.key.Display().Lower();
+               match = node.keyLower.Find(mFilter) != wxNOT_FOUND;
             break;
          }
-         if (searchit.Find(mFilter) == wxNOT_FOUND)
+         if (!match)
          {
             // Not found so continue to next node
             continue;
          }
 
          // For the Key View, if the filter is a single character,
-         // then it has to be the last character in the searchit string,
+         // then it has to be the last character in the key,
          // and be preceded by nothing or +.
+         const wxString & keyLower = node.keyLower;
          if ((mViewType == ViewByKey) &&
                (mFilter.length() == 1) &&
-               (mFilter != searchit.Last() ||
-                  ((searchit.length() > 1) &&
-                     ((wxString)(searchit.GetChar(searchit.length() - 2)) != wxT("+")))))
+               (mFilter != keyLower.Last() ||
+                  ((keyLower.length() > 1) &&
+                     ((wxString)(keyLower.GetChar(keyLower.length() - 2)) != wxT("+")))))
          {
             // Not suitable so continue to next node
             continue;
@@ -971,6 +1020,8 @@ KeyView::RefreshLines(bool bSort)
    }
    else
    {
+      mLines.clear();
+
       // Examine all nodes - non-filtered
       for (int i = 0; i < cnt; i++)
       {
@@ -1027,6 +1078,10 @@ KeyView::RefreshLines(bool bSort)
       }
    }
 
+   // Remember what produced these lines for the incremental rescan above
+   mLastFilter = mFilter;
+   mLastFilterView = mViewType;
+
    // Sorting is costly.  If bSort is false, we do not have to sort.
    // bSort false means we know that the list will be updated again before
    // the user needs to see it.
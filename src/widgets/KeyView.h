@@ -12,6 +12,7 @@
 #include "../Audacity.h"
 #include "audacity/Types.h"
 
+#include <unordered_map>
 #include <vector>
 #include <wx/setup.h> // for wxUSE_* macros
 #include <wx/defs.h>
@@ -47,6 +48,10 @@ public:
    wxString prefix;
    wxString label;
    NormalizedKeyString key;
+   // Lowercased label and key display, prepared once so that filtering does
+   // not rebuild them for every node on every keystroke in the search box
+   wxString labelLower;
+   wxString keyLower;
    int index;
    int line;
    int depth;
@@ -114,6 +119,7 @@ public:
 
 private:
    void RecalcExtents();
+   void CachedTextExtent(const wxString & text, int *x, int *y);
    void UpdateHScroll();
    void RefreshLines(bool bSort = true);
 
@@ -155,6 +161,15 @@ private:
    ViewByType mViewType;
    wxString mFilter;
 
+   // Filter and view type of the last RefreshLines, allowing a filter that
+   // merely extends the previous one to rescan only the surviving lines
+   wxString mLastFilter;
+   ViewByType mLastFilterView;
+
+   // Extents of strings measured so far, so repeated refreshes of mostly
+   // unchanged bindings skip the native text measurement calls
+   std::unordered_map<wxString, wxSize> mExtentCache;
+
    wxCoord mScrollX;
    wxCoord mWidth;
 
@@ -43,6 +43,14 @@
 
 #include "../Experimental.h"
 
+// The level scan in UpdateDisplay runs inside the audio callback; it
+// has an SSE2 form, and SSE2 may be assumed on all x86_64 targets.
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define METER_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
 #include <algorithm>
 #include <wx/setup.h> // for wxUSE_* macros
 #include <wx/wxcrtvararg.h>
@@ -973,84 +981,91 @@ static float ToDB(float v, float range)
 
 void MeterPanel::UpdateDisplay(unsigned numChannels, int numFrames, float *sampleData)
 {
-   float *sptr = sampleData;
    auto num = std::min(numChannels, mNumBars);
    MeterUpdateMsg msg;
 
    memset(&msg, 0, sizeof(msg));
    msg.numFrames = numFrames;
 
-   for(int i=0; i<numFrames; i++) {
-      for(unsigned int j=0; j<num; j++) {
-         msg.peak[j] = floatMax(msg.peak[j], fabs(sptr[j]));
-         msg.rms[j] += sptr[j]*sptr[j];
-
-         // In addition to looking for mNumPeakSamplesToClip peaked
-         // samples in a row, also send the number of peaked samples
-         // at the head and tail, in case there's a run of peaked samples
-         // that crosses block boundaries
-         if (fabs(sptr[j])>=MAX_AUDIO) {
-            if (msg.headPeakCount[j]==i)
-               msg.headPeakCount[j]++;
-            msg.tailPeakCount[j]++;
-            if (msg.tailPeakCount[j] > mNumPeakSamplesToClip)
-               msg.clipping[j] = true;
+   // Find per-channel peak and summed square first.  Consecutive floats
+   // are consecutive channels of one frame, so with four or more
+   // channels the vector lanes line up with channels, and it is
+   // many-channel capture where this scan starts to cost.
+   unsigned int j = 0;
+#ifdef METER_USE_SSE2
+   const __m128 signMask = _mm_set1_ps(-0.0f);
+   for (; j + 4 <= num; j += 4) {
+      __m128 peak = _mm_setzero_ps();
+      __m128 sumsq = _mm_setzero_ps();
+      const float *p = sampleData + j;
+      for (int i = 0; i < numFrames; i++, p += numChannels) {
+         const __m128 x = _mm_loadu_ps(p);
+         peak = _mm_max_ps(peak, _mm_andnot_ps(signMask, x));
+         sumsq = _mm_add_ps(sumsq, _mm_mul_ps(x, x));
+      }
+      _mm_storeu_ps(&msg.peak[j], peak);
+      _mm_storeu_ps(&msg.rms[j], sumsq);
+   }
+#endif
+   for (; j < num; j++) {
+      const float *p = sampleData + j;
+      float peak = 0.0f, sumsq = 0.0f;
+      for (int i = 0; i < numFrames; i++, p += numChannels) {
+         peak = floatMax(peak, fabs(*p));
+         sumsq += *p * *p;
+      }
+      msg.peak[j] = peak;
+      msg.rms[j] = sumsq;
+   }
+
+   // Full-scale runs are rare; do the serial bookkeeping that detects
+   // clipping only for channels whose peak actually reached full scale.
+   // In addition to looking for mNumPeakSamplesToClip peaked samples in
+   // a row, also send the number of peaked samples at the head and
+   // tail, in case there's a run of peaked samples that crosses block
+   // boundaries
+   for (j = 0; j < num; j++) {
+      if (msg.peak[j] >= MAX_AUDIO) {
+         const float *p = sampleData + j;
+         for (int i = 0; i < numFrames; i++, p += numChannels) {
+            if (fabs(*p) >= MAX_AUDIO) {
+               if (msg.headPeakCount[j] == i)
+                  msg.headPeakCount[j]++;
+               msg.tailPeakCount[j]++;
+               if (msg.tailPeakCount[j] > mNumPeakSamplesToClip)
+                  msg.clipping[j] = true;
+            }
+            else
+               msg.tailPeakCount[j] = 0;
          }
-         else
-            msg.tailPeakCount[j] = 0;
       }
-      sptr += numChannels;
    }
-   for(unsigned int j=0; j<mNumBars; j++)
+
+   for(j = 0; j < mNumBars; j++)
       msg.rms[j] = sqrt(msg.rms[j]/numFrames);
 
    mQueue.Put(msg);
 }
 
-// Vaughan, 2010-11-29: This not currently used. See comments in MixerTrackCluster::UpdateMeter().
-//void MeterPanel::UpdateDisplay(int numChannels, int numFrames,
-//                           // Need to make these double-indexed arrays if we handle more than 2 channels.
-//                           float* maxLeft, float* rmsLeft,
-//                           float* maxRight, float* rmsRight,
-//                           const size_t kSampleCount)
-//{
-//   int i, j;
-//   int num = intmin(numChannels, mNumBars);
-//   MeterUpdateMsg msg;
-//
-//   msg.numFrames = kSampleCount;
-//   for(j=0; j<mNumBars; j++) {
-//      msg.peak[j] = 0.0;
-//      msg.rms[j] = 0.0;
-//      msg.clipping[j] = false;
-//      msg.headPeakCount[j] = 0;
-//      msg.tailPeakCount[j] = 0;
-//   }
-//
-//   for(i=0; i<numFrames; i++) {
-//      for(j=0; j<num; j++) {
-//         msg.peak[j] = floatMax(msg.peak[j], ((j == 0) ? maxLeft[i] : maxRight[i]));
-//         msg.rms[j] = floatMax(msg.rms[j], ((j == 0) ? rmsLeft[i] : rmsRight[i]));
-//
-//         // In addition to looking for mNumPeakSamplesToClip peaked
-//         // samples in a row, also send the number of peaked samples
-//         // at the head and tail, in case there's a run
-//         // of peaked samples that crosses block boundaries.
-//         if (fabs((j == 0) ? maxLeft[i] : maxRight[i]) >= MAX_AUDIO)
-//         {
-//            if (msg.headPeakCount[j]==i)
-//               msg.headPeakCount[j]++;
-//            msg.tailPeakCount[j]++;
-//            if (msg.tailPeakCount[j] > mNumPeakSamplesToClip)
-//               msg.clipping[j] = true;
-//         }
-//         else
-//            msg.tailPeakCount[j] = 0;
-//      }
-//   }
-//
-//   mQueue.Put(msg);
-//}
+void MeterPanel::UpdateDisplay(unsigned numChannels, int numFrames,
+                               const float *peak, const float *rms)
+{
+   auto num = std::min(numChannels, mNumBars);
+   MeterUpdateMsg msg;
+
+   memset(&msg, 0, sizeof(msg));
+   msg.numFrames = numFrames;
+
+   for (unsigned int j = 0; j < num; j++) {
+      msg.peak[j] = peak[j];
+      msg.rms[j] = rms[j];
+      // Callers of this variant never see the individual samples, so
+      // treat any full-scale peak as clipping
+      msg.clipping[j] = peak[j] >= MAX_AUDIO;
+   }
+
+   mQueue.Put(msg);
+}
 
 void MeterPanel::OnMeterUpdate(wxTimerEvent & WXUNUSED(event))
 {
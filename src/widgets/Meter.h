@@ -157,12 +157,11 @@ class MeterPanel final : public MeterPanelBase, private PrefsListener
    void UpdateDisplay(unsigned numChannels,
                       int numFrames, float *sampleData) override;
 
-   // Vaughan, 2010-11-29: This not currently used. See comments in MixerTrackCluster::UpdateMeter().
-   //void UpdateDisplay(int numChannels, int numFrames,
-   //                     // Need to make these double-indexed max and min arrays if we handle more than 2 channels.
-   //                     float* maxLeft, float* rmsLeft,
-   //                     float* maxRight, float* rmsRight,
-   //                     const size_t kSampleCount);
+   // Variant for levels already reduced to one peak and rms per
+   // channel, as from track block summaries; no sample scan is done.
+   // Used by MixerBoard.
+   void UpdateDisplay(unsigned numChannels, int numFrames,
+                      const float *peak, const float *rms);
 
    /** \brief Find out if the level meter is disabled or not.
     *
@@ -699,6 +699,9 @@ NumericConverter::NumericConverter(Type type,
 
    mFocusedDigit = 0;
 
+   mLastSetValue = value;
+   mValueFormatted = false;
+
    mValue = value; // used in SetSampleRate, reassigned later
 
    SetSampleRate(sampleRate);
@@ -1002,6 +1005,10 @@ void NumericConverter::ValueToControls(double rawValue, bool nearest /* = true *
 
 void NumericConverter::ControlsToValue()
 {
+   // The string may have been edited directly, as by typing in the control,
+   // so the next SetValue must not assume it still shows the last value set
+   mValueFormatted = false;
+
    unsigned int i;
    double t = 0.0;
 
@@ -1080,9 +1087,28 @@ void NumericConverter::SetSampleRate(double sampleRate)
 
 void NumericConverter::SetValue(double newValue)
 {
+   // This is called much faster than the display changes during playback and
+   // drags.  Values that land on the same sample produce the same string, so
+   // when the last value set is still shown and the NEW one would read the
+   // same, skip the reformatting.
+   if (mValueFormatted) {
+      if (newValue == mLastSetValue)
+         return;
+      if (mType == TIME &&
+          floor(newValue * mSampleRate + 0.5f) ==
+             floor(mLastSetValue * mSampleRate + 0.5f)) {
+         mLastSetValue = newValue;
+         return;
+      }
+   }
+
    mValue = newValue;
    ValueToControls();
    ControlsToValue();
+
+   // ControlsToValue resets the flag, so state it last
+   mLastSetValue = newValue;
+   mValueFormatted = true;
 }
 
 void NumericConverter::SetMinValue(double minValue)
@@ -1403,9 +1429,10 @@ void NumericTextCtrl::SetSampleRate(double sampleRate)
 
 void NumericTextCtrl::SetValue(double newValue)
 {
+   // The base class calls the virtual ValueToControls and ControlsToValue,
+   // so the overrides below are reached and nothing more is needed here;
+   // repeating the calls would just format the string a second time
    NumericConverter::SetValue(newValue);
-   ValueToControls();
-   ControlsToValue();
 }
 
 void NumericTextCtrl::SetDigitSize(int width, int height)
@@ -133,6 +133,12 @@ protected:
    // Formatted mValue, by ValueToControls().
    wxString       mValueString;
 
+   // Last value passed to SetValue, and whether mValueString still reflects
+   // it; lets SetValue skip the reformatting when called repeatedly, as from
+   // the selection toolbar during playback, with values that read the same
+   double         mLastSetValue;
+   bool           mValueFormatted;
+
    double         mScalingFactor;
    double         mSampleRate;
    bool           mNtscDrop;
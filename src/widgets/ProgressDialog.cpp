@@ -47,6 +47,7 @@
 #include <wx/sizer.h>
 #include <wx/sound.h>
 #include <wx/stopwatch.h>
+#include <wx/thread.h>
 #include <wx/window.h>
 #include <wx/stattext.h>
 
@@ -988,6 +989,7 @@ BEGIN_EVENT_TABLE(ProgressDialog, wxDialogWrapper)
    EVT_BUTTON(wxID_CANCEL, ProgressDialog::OnCancel)
    EVT_BUTTON(wxID_OK, ProgressDialog::OnStop)
    EVT_CLOSE(ProgressDialog::OnCloseWindow)
+   EVT_TIMER(wxID_ANY, ProgressDialog::OnPollTimer)
 END_EVENT_TABLE()
 
 //
@@ -1079,6 +1081,9 @@ void ProgressDialog::Reinit()
    mYieldTimer = mStartTime;
    mCancel = false;
    mStop = false;
+   mCancelFlag.store(false, std::memory_order_relaxed);
+   mStopFlag.store(false, std::memory_order_relaxed);
+   mPolledValue.store(-1, std::memory_order_relaxed);
 
    // Because wxGTK is very sensitive about maintaining focus when
    // this window is not shown, we always show it.  But, since we
@@ -1307,6 +1312,11 @@ bool ProgressDialog::Create(const wxString & title,
    // no editing in any project until Timer Record finishes.
    mDisable = std::make_unique<wxWindowDisabler>(this);
 
+   // Poll for values published by the lock-free path of Update; worker
+   // threads then never touch the widgets or the event loop
+   mPollTimer.SetOwner(this);
+   mPollTimer.Start(100);
+
    return true;
 }
 
@@ -1315,6 +1325,21 @@ bool ProgressDialog::Create(const wxString & title,
 //
 ProgressResult ProgressDialog::Update(int value, const wxString & message)
 {
+   // Lock-free path for worker threads:  publish the value for the poll
+   // timer, which applies it to the widgets on the UI thread, and check
+   // the cancellation flags.  No widget access, no yield - the worker's
+   // inner loop never re-enters the event loop.  (A changed message is
+   // not carried over this path.)
+   if (!wxThread::IsMain())
+   {
+      if (mCancelFlag.load(std::memory_order_relaxed))
+         return ProgressResult::Cancelled;
+      if (mStopFlag.load(std::memory_order_relaxed))
+         return ProgressResult::Stopped;
+      mPolledValue.store(value, std::memory_order_relaxed);
+      return ProgressResult::Success;
+   }
+
    if (mCancel)
    {
       // for compatibility with old Update, that returned false on cancel
@@ -1395,7 +1420,9 @@ ProgressResult ProgressDialog::Update(int value, const wxString & message)
 
    // Nyquist effects call Update on every callback, but YieldFor is
    // quite slow on Linux / Mac, so don't call too frequently. (bug 1575)
-   if ((now - mYieldTimer > 50) || (value == 1000)) {
+   // No yield either when the poll timer applies a worker thread's
+   // value:  the event loop is already live then.
+   if (!mPolling && ((now - mYieldTimer > 50) || (value == 1000))) {
       wxEventLoopBase::GetActive()->YieldFor(wxEVT_CATEGORY_UI | wxEVT_CATEGORY_USER_INPUT | wxEVT_CATEGORY_TIMER);
       mYieldTimer = now;
    }
@@ -1555,6 +1582,7 @@ void ProgressDialog::OnCancel(wxCommandEvent & WXUNUSED(event))
    }
    FindWindowById(wxID_CANCEL, this)->Disable();
    mCancel = true;
+   mCancelFlag.store(true, std::memory_order_relaxed);
 }
 
 void ProgressDialog::OnStop(wxCommandEvent & WXUNUSED(event))
@@ -1565,6 +1593,8 @@ void ProgressDialog::OnStop(wxCommandEvent & WXUNUSED(event))
    FindWindowById(wxID_OK, this)->Disable();
    mCancel = false;
    mStop = true;
+   mCancelFlag.store(false, std::memory_order_relaxed);
+   mStopFlag.store(true, std::memory_order_relaxed);
 }
 
 void ProgressDialog::OnCloseWindow(wxCloseEvent & WXUNUSED(event))
@@ -1573,6 +1603,20 @@ void ProgressDialog::OnCloseWindow(wxCloseEvent & WXUNUSED(event))
       return;
    }
    mCancel = true;
+   mCancelFlag.store(true, std::memory_order_relaxed);
+}
+
+// Apply, on the UI thread, the latest value a worker thread published
+// through the lock-free path of Update.  The ordinary event loop
+// services the buttons meanwhile.
+void ProgressDialog::OnPollTimer(wxTimerEvent & WXUNUSED(event))
+{
+   const int value = mPolledValue.exchange(-1, std::memory_order_relaxed);
+   if (value < 0)
+      return;
+   mPolling = true;
+   Update(value);
+   mPolling = false;
 }
 
 void ProgressDialog::Beep() const
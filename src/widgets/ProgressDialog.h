@@ -20,9 +20,11 @@
 
 #include "../Audacity.h"
 
+#include <atomic>
 #include <vector>
 #include <wx/defs.h>
 #include <wx/evtloop.h> // member variable
+#include <wx/timer.h> // member variable
 
 #include "wxPanelWrapper.h" // to inherit
 
@@ -118,6 +120,15 @@ protected:
    bool mCancel;
    bool mStop;
 
+   // Lock-free progress publication for worker threads:  Update called
+   // off the main thread only stores the value here and reads the
+   // cancellation flags; the poll timer applies the value to the
+   // widgets on the UI thread.  The worker never yields to the event
+   // loop.
+   std::atomic<int> mPolledValue{ -1 };
+   std::atomic<bool> mCancelFlag{ false };
+   std::atomic<bool> mStopFlag{ false };
+
    bool mIsTransparent;
 
    // MY: Booleans to hold the flag values
@@ -130,6 +141,7 @@ private:
    void OnCancel(wxCommandEvent & e);
    void OnStop(wxCommandEvent & e);
    void OnCloseWindow(wxCloseEvent & e);
+   void OnPollTimer(wxTimerEvent & e);
    void Beep() const;
    
    bool ConfirmAction(const wxString & sPrompt,
@@ -143,6 +155,11 @@ private:
    // This guarantees we have an active event loop...possible during OnInit()
    wxEventLoopGuarantor mLoop;
 
+   wxTimer mPollTimer;
+   // True while the poll timer's handler applies a published value, so
+   // that path does not also yield to the event loop
+   bool mPolling{ false };
+
    std::unique_ptr<wxWindowDisabler> mDisable;
 
    wxStaticText *mMessage{} ;
@@ -59,6 +59,8 @@ array of Ruler::Label.
 
 #include "../Experimental.h"
 
+#include <tuple>
+
 #include <wx/dcclient.h>
 #include <wx/dcscreen.h>
 
@@ -122,6 +124,8 @@ Ruler::Ruler()
 
    mValid = false;
 
+   mLastDesiredPixelHeight = -1;
+
    mCustom = false;
    mbMinor = true;
 
@@ -270,9 +274,74 @@ void Ruler::SetFonts(const wxFont &minorFont, const wxFont &majorFont, const wxF
    // Won't override these fonts
    mUserFonts = true;
 
+   for (auto &cache : mTextExtentCaches)
+      cache.clear();
+   mLayoutCache.clear();
+
    Invalidate();
 }
 
+bool Ruler::LayoutKey::operator < (const LayoutKey &other) const
+{
+   return
+      std::tie(orientation, format, log, flip, labelEdges, spacing,
+         length, min, max, hiddenMin, hiddenMax, dbMirror, units) <
+      std::tie(other.orientation, other.format, other.log, other.flip,
+         other.labelEdges, other.spacing, other.length, other.min,
+         other.max, other.hiddenMin, other.hiddenMax, other.dbMirror,
+         other.units);
+}
+
+void Ruler::SaveLayout(CachedLayout &layout) const
+{
+   auto save = [this](const ArrayOf<Label> &from, int count,
+                      std::vector<Label> &to) {
+      to.assign(from.get(), from.get() + count);
+      for (auto &label : to) {
+         label.lx -= mLeft;
+         label.ly -= mTop;
+      }
+   };
+   save(mMajorLabels, mNumMajor, layout.majorLabels);
+   save(mMinorLabels, mNumMinor, layout.minorLabels);
+   save(mMinorMinorLabels, mNumMinorMinor, layout.minorMinorLabels);
+
+   layout.rect = mRect;
+   layout.rect.Offset(-mLeft, -mTop);
+   layout.maxWidth = mMaxWidth;
+   layout.maxHeight = mMaxHeight;
+}
+
+void Ruler::RestoreLayout(const CachedLayout &layout)
+{
+   // Size the arrays as a fresh computation would
+   if (mLength != mLengthOld) {
+      auto size = static_cast<size_t>(mLength + 1);
+      mMajorLabels.reinit(size);
+      mMinorLabels.reinit(size);
+      mMinorMinorLabels.reinit(size);
+      mLengthOld = mLength;
+   }
+
+   auto restore = [this](const std::vector<Label> &from,
+                         ArrayOf<Label> &to, int &count) {
+      count = from.size();
+      for (int i = 0; i < count; i++) {
+         to[i] = from[i];
+         to[i].lx += mLeft;
+         to[i].ly += mTop;
+      }
+   };
+   restore(layout.majorLabels, mMajorLabels, mNumMajor);
+   restore(layout.minorLabels, mMinorLabels, mNumMinor);
+   restore(layout.minorMinorLabels, mMinorMinorLabels, mNumMinorMinor);
+
+   mRect = layout.rect;
+   mRect.Offset(mLeft, mTop);
+   mMaxWidth = layout.maxWidth;
+   mMaxHeight = layout.maxHeight;
+}
+
 void Ruler::SetNumberScale(const NumberScale *pScale)
 {
    if (!pScale) {
@@ -724,10 +793,24 @@ wxString Ruler::LabelString(double d, bool major)
    return s;
 }
 
+wxSize Ruler::TickTextExtent(const wxString &text, int fontIndex,
+   const wxFont &font)
+{
+   auto &cache = mTextExtentCaches[fontIndex];
+   auto iter = cache.find(text);
+   if (iter == cache.end()) {
+      wxCoord strW, strH, strD, strL;
+      mDC->SetFont(font);
+      mDC->GetTextExtent(text, &strW, &strH, &strD, &strL);
+      iter = cache.emplace(text, wxSize{ strW, strH }).first;
+   }
+   return iter->second;
+}
+
 void Ruler::Tick(int pos, double d, bool major, bool minor)
 {
    wxString l;
-   wxCoord strW, strH, strD, strL;
+   wxCoord strW, strH;
    int strPos, strLen, strLeft, strTop;
 
    // FIXME: We don't draw a tick if off end of our label arrays
@@ -753,12 +836,15 @@ void Ruler::Tick(int pos, double d, bool major, bool minor)
    label->ly = mTop - 1000;  // don't display
    label->text = wxT("");
 
-   mDC->SetFont(major? *mMajorFont: minor? *mMinorFont : *mMinorMinorFont);
    // Bug 521.  dB view for waveforms needs a 2-sided scale.
    if(( mDbMirrorValue > 1.0 ) && ( -d > mDbMirrorValue ))
       d = -2*mDbMirrorValue - d;
    l = LabelString(d, major);
-   mDC->GetTextExtent(l, &strW, &strH, &strD, &strL);
+   const wxSize extent = TickTextExtent(l,
+      major ? 0 : minor ? 1 : 2,
+      major ? *mMajorFont : minor ? *mMinorFont : *mMinorMinorFont);
+   strW = extent.x;
+   strH = extent.y;
 
    if (mOrientation == wxHORIZONTAL) {
       strLen = strW;
@@ -843,7 +929,7 @@ void Ruler::TickCustom(int labelIdx, bool major, bool minor)
 
    int pos;
    wxString l;
-   wxCoord strW, strH, strD, strL;
+   wxCoord strW, strH;
    int strPos, strLen, strLeft, strTop;
 
    // FIXME: We don't draw a tick if of end of our label arrays
@@ -867,9 +953,11 @@ void Ruler::TickCustom(int labelIdx, bool major, bool minor)
    label->lx = mLeft - 1000; // don't display
    label->ly = mTop - 1000;  // don't display
 
-   mDC->SetFont(major? *mMajorFont: minor? *mMinorFont : *mMinorMinorFont);
-
-   mDC->GetTextExtent(l, &strW, &strH, &strD, &strL);
+   const wxSize extent = TickTextExtent(l,
+      major ? 0 : minor ? 1 : 2,
+      major ? *mMajorFont : minor ? *mMinorFont : *mMinorMinorFont);
+   strW = extent.x;
+   strH = extent.y;
 
    if (mOrientation == wxHORIZONTAL) {
       strLen = strW;
@@ -1004,24 +1092,35 @@ void Ruler::Update(const Envelope* envelope)// Envelope *speedEnv, long minSpeed
          std::max(MinPixelHeight, std::min(MaxPixelHeight,
             desiredPixelHeight));
 
-      // Keep making the font bigger until it's too big, then subtract one.
-      mDC->SetFont(wxFont(fontSize, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD));
-      mDC->GetTextExtent(exampleText, &strW, &strH, &strD, &strL);
-      while ((strH - strD - strL) <= desiredPixelHeight && fontSize < 40) {
-         fontSize++;
+      // The sizing loop measures text repeatedly, so run it only when the
+      // desired height has actually changed, not on every invalidation
+      if (desiredPixelHeight != mLastDesiredPixelHeight) {
+         mLastDesiredPixelHeight = desiredPixelHeight;
+
+         // Keep making the font bigger until it's too big, then subtract one.
          mDC->SetFont(wxFont(fontSize, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD));
          mDC->GetTextExtent(exampleText, &strW, &strH, &strD, &strL);
-      }
-      fontSize--;
-      mDC->SetFont(wxFont(fontSize, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
-      mDC->GetTextExtent(exampleText, &strW, &strH, &strD, &strL);
-      mLead = strL;
+         while ((strH - strD - strL) <= desiredPixelHeight && fontSize < 40) {
+            fontSize++;
+            mDC->SetFont(wxFont(fontSize, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD));
+            mDC->GetTextExtent(exampleText, &strW, &strH, &strD, &strL);
+         }
+         fontSize--;
+         mDC->SetFont(wxFont(fontSize, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
+         mDC->GetTextExtent(exampleText, &strW, &strH, &strD, &strL);
+         mLead = strL;
+
+         mMajorFont = std::make_unique<wxFont>(fontSize, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD);
 
-      mMajorFont = std::make_unique<wxFont>(fontSize, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD);
+         mMinorFont = std::make_unique<wxFont>(fontSize, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL);
 
-      mMinorFont = std::make_unique<wxFont>(fontSize, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL);
+         mMinorMinorFont = std::make_unique<wxFont>(fontSize - 1, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL);
 
-      mMinorMinorFont = std::make_unique<wxFont>(fontSize - 1, wxFONTFAMILY_SWISS, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL);
+         for (auto &cache : mTextExtentCaches)
+            cache.clear();
+         // Layouts remembered with the old fonts are stale too
+         mLayoutCache.clear();
+      }
    }
 
    // If ruler is being resized, we could end up with it being too small.
@@ -1031,6 +1130,24 @@ void Ruler::Update(const Envelope* envelope)// Envelope *speedEnv, long minSpeed
    if( mLength <= 0 )
       return;
 
+   // Replay a remembered layout if there is one for these settings.
+   // The cases excluded below either depend on more state than the key
+   // describes, or supply the tick positions from outside.
+   const bool cacheable = !mCustom && !envelope && !zoomInfo &&
+      !mUserBits && !mpNumberScale;
+   LayoutKey key{};
+   if (cacheable) {
+      key = { mOrientation, mFormat, mLog, mFlip, mLabelEdges, mSpacing,
+         mLength, mMin, mMax, mHiddenMin, mHiddenMax, mDbMirrorValue,
+         mUnits };
+      auto iter = mLayoutCache.find(key);
+      if (iter != mLayoutCache.end()) {
+         RestoreLayout(iter->second);
+         mValid = true;
+         return;
+      }
+   }
+
    if (mOrientation == wxHORIZONTAL) {
       mMaxWidth = mLength;
       mMaxHeight = 0;
@@ -1104,7 +1221,11 @@ void Ruler::Update(const Envelope* envelope)// Envelope *speedEnv, long minSpeed
             mid = (int)(zoomInfo->TimeToPosition(0.0, mLeftOffset));
          else
             mid = (int)(mLength*(mMin / (mMin - mMax)) + 0.5);
-         const int iMaxPos = (mOrientation == wxHORIZONTAL) ? mRight : mBottom - 5;
+         // Compare in ruler-relative coordinates, as Draw() suppresses
+         // extreme ticks, so that the layout does not depend on where
+         // the ruler sits in the window
+         const int iMaxPos =
+            (mOrientation == wxHORIZONTAL) ? mLength : mLength - 5;
          if (mid >= 0 && mid < iMaxPos)
             Tick(mid, 0.0, true, false);
       }
@@ -1294,6 +1415,16 @@ void Ruler::Update(const Envelope* envelope)// Envelope *speedEnv, long minSpeed
    }
    mMaxWidth = mRect.GetWidth ();
    mMaxHeight= mRect.GetHeight();
+
+   if (cacheable) {
+      // A handful of distinct layouts covers a whole project's rulers.
+      // If the set ever grows much larger, settings must be churning,
+      // and remembering them all would only hoard memory.
+      if (mLayoutCache.size() >= 100)
+         mLayoutCache.clear();
+      SaveLayout(mLayoutCache[key]);
+   }
+
    mValid = true;
 }
 
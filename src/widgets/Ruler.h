@@ -13,6 +13,9 @@
 
 #include "wxPanelWrapper.h" // to inherit
 
+#include <map>
+#include <vector>
+
 #include <wx/colour.h> // member variable
 #include <wx/pen.h> // member variable
 
@@ -161,6 +164,12 @@ class AUDACITY_DLL_API Ruler {
    // Another tick generator for custom ruler case (noauto) .
    void TickCustom(int labelIdx, bool major, bool minor);
 
+   // Measure a tick label in the given font, consulting the cache first.
+   // fontIndex chooses among the per-font caches: 0 for the major font,
+   // 1 minor, 2 minor-minor.
+   wxSize TickTextExtent(const wxString &text, int fontIndex,
+      const wxFont &font);
+
 public:
    bool mbTicksOnly; // true => no line the length of the ruler
    bool mbTicksAtExtremes;
@@ -179,6 +188,15 @@ private:
    std::unique_ptr<wxFont> mMinorFont, mMajorFont, mMinorMinorFont;
    bool         mUserFonts;
 
+   // Measuring text is costly, and most tick labels recur from one Update
+   // to the next while the ruler scrolls or zooms, so extents are
+   // remembered per label string, separately per font, and dropped when
+   // the fonts change
+   std::map<wxString, wxSize> mTextExtentCaches[3];
+   // The height that the automatic font sizing last aimed at; while it is
+   // unchanged the sizing loop in Update() can be skipped
+   int          mLastDesiredPixelHeight;
+
    double       mMin, mMax;
    double       mHiddenMin, mHiddenMax;
 
@@ -210,6 +228,43 @@ private:
    int          mNumMinorMinor;
    ArrayOf<Label> mMinorMinorLabels;
 
+   // Everything that determines the tick layout, other than where the
+   // ruler sits in the window.  Many rulers share few distinct layouts:
+   // all vertical rulers of like-sized tracks with the same scale and
+   // zoom, for instance.
+   struct LayoutKey {
+      int          orientation;
+      RulerFormat  format;
+      bool         log;
+      bool         flip;
+      bool         labelEdges;
+      int          spacing;
+      int          length;
+      double       min, max;
+      double       hiddenMin, hiddenMax;
+      double       dbMirror;
+      wxString     units;
+
+      bool operator < (const LayoutKey &other) const;
+   };
+
+   // A computed layout, stored with positions relative to the ruler's
+   // top left corner so that it can be replayed at any position
+   struct CachedLayout {
+      std::vector<Label> majorLabels, minorLabels, minorMinorLabels;
+      wxRect rect;
+      int maxWidth, maxHeight;
+   };
+
+   // Update() consults this before recomputing ticks, so that the many
+   // rulers sharing one Ruler object (as the track panel's vertical
+   // rulers do) pay for each distinct layout once, not once per ruler.
+   // Cleared whenever the fonts change, which the key does not capture.
+   std::map<LayoutKey, CachedLayout> mLayoutCache;
+
+   void SaveLayout(CachedLayout &layout) const;
+   void RestoreLayout(const CachedLayout &layout);
+
    // Returns 'zero' label coordinate (for grid drawing)
    int FindZero(Label * label, int len);
 
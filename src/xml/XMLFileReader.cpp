@@ -19,6 +19,11 @@
 #include <wx/ffile.h>
 #include <wx/intl.h>
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <string.h>
 
 XMLFileReader::XMLFileReader()
@@ -47,23 +52,85 @@ bool XMLFileReader::Parse(XMLTagHandler *baseHandler,
 
    mBaseHandler = baseHandler;
 
-   const size_t bufferSize = 16384;
-   char buffer[16384];
+   // A worker thread reads ahead into one buffer while expat decodes the
+   // other on this thread, overlapping disk I/O with parsing.  The tag
+   // handlers still run on the caller's thread, as they always did.
+   const size_t bufferSize = 1024 * 1024;
+   std::unique_ptr<char[]> buffers[2] {
+      std::unique_ptr<char[]>{ safenew char[bufferSize] },
+      std::unique_ptr<char[]>{ safenew char[bufferSize] }
+   };
+
+   struct {
+      std::mutex mutex;
+      std::condition_variable cond;
+      size_t len[2] { 0, 0 };
+      bool full[2] { false, false };
+      bool abort { false };
+   } state;
+
+   std::thread reader( [&]
+   {
+      FILE *fp = theXMLFile.fp();
+      int which = 0;
+      for (;;) {
+         std::unique_lock<std::mutex> lock{ state.mutex };
+         state.cond.wait( lock,
+            [&]{ return !state.full[which] || state.abort; } );
+         if (state.abort)
+            return;
+         lock.unlock();
+
+         size_t len = fread(buffers[which].get(), 1, bufferSize, fp);
+
+         lock.lock();
+         state.len[which] = len;
+         state.full[which] = true;
+         state.cond.notify_one();
+         if (len < bufferSize)
+            return;
+         which = 1 - which;
+      }
+   } );
+
+   bool success = true;
+   int which = 0;
    int done = 0;
    do {
-      size_t len = fread(buffer, 1, bufferSize, theXMLFile.fp());
+      size_t len;
+      {
+         std::unique_lock<std::mutex> lock{ state.mutex };
+         state.cond.wait( lock, [&]{ return state.full[which]; } );
+         len = state.len[which];
+      }
       done = (len < bufferSize);
-      if (!XML_Parse(mParser, buffer, len, done)) {
+      if (!XML_Parse(mParser, buffers[which].get(), len, done)) {
          mErrorStr.Printf(_("Error: %hs at line %lu"),
                           XML_ErrorString(XML_GetErrorCode(mParser)),
                           (long unsigned int)XML_GetCurrentLineNumber(mParser));
-         theXMLFile.Close();
-         return false;
+         success = false;
+         break;
+      }
+      {
+         std::lock_guard<std::mutex> lock{ state.mutex };
+         state.full[which] = false;
+         state.cond.notify_one();
       }
+      which = 1 - which;
    } while (!done);
 
+   {
+      std::lock_guard<std::mutex> lock{ state.mutex };
+      state.abort = true;
+      state.cond.notify_one();
+   }
+   reader.join();
+
    theXMLFile.Close();
 
+   if (!success)
+      return false;
+
    // Even though there were no parse errors, we only succeed if
    // the first-level handler actually got called, and didn't
    // return false.
@@ -33,6 +33,8 @@
 #include <wx/arrstr.h>
 #include <wx/filename.h>
 
+#include "../Internat.h"
+
 // Length check.  Is in part about not supplying malicious strings to file functions.
 bool XMLValueChecker::IsGoodString(const wxString & str)
 {
@@ -181,6 +183,131 @@ bool XMLValueChecker::IsValidSampleFormat(const int nValue)
    return (nValue == int16Sample) || (nValue == int24Sample) || (nValue == floatSample);
 }
 
+namespace {
+   // Powers of ten that are exactly representable in double precision,
+   // so scaling an exact integer mantissa by one of them is a single
+   // correctly rounded operation
+   const double exactPowersOfTen[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+      1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+      1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+   };
+}
+
+bool XMLAttributeCursor::ToDouble(double &result) const
+{
+   const wxChar *p = mValue;
+   if (!p)
+      return false;
+
+   while (*p == wxT(' '))
+      ++p;
+
+   bool negative = false;
+   if (*p == wxT('-') || *p == wxT('+'))
+      negative = (*p++ == wxT('-'));
+
+   // Accumulate up to 19 significant digits exactly in a 64-bit integer,
+   // tracking the decimal exponent of the accumulated value
+   unsigned long long mantissa = 0;
+   int digits = 0;
+   int exponent = 0;
+   bool any = false;
+   for (; *p >= wxT('0') && *p <= wxT('9'); ++p) {
+      any = true;
+      if (digits < 19) {
+         mantissa = mantissa * 10 + (*p - wxT('0'));
+         ++digits;
+      }
+      else
+         ++exponent;
+   }
+   if (*p == wxT('.') || *p == wxT(',')) {
+      ++p;
+      for (; *p >= wxT('0') && *p <= wxT('9'); ++p) {
+         any = true;
+         if (digits < 19) {
+            mantissa = mantissa * 10 + (*p - wxT('0'));
+            ++digits;
+            --exponent;
+         }
+      }
+   }
+   if (!any)
+      return false;
+   if (*p == wxT('e') || *p == wxT('E')) {
+      ++p;
+      bool expNegative = false;
+      if (*p == wxT('-') || *p == wxT('+'))
+         expNegative = (*p++ == wxT('-'));
+      if (*p < wxT('0') || *p > wxT('9'))
+         return false;
+      int e = 0;
+      for (; *p >= wxT('0') && *p <= wxT('9'); ++p)
+         if (e < 10000)
+            e = e * 10 + (*p - wxT('0'));
+      exponent += expNegative ? -e : e;
+   }
+   if (*p != wxT('\0'))
+      return false;
+
+   // One scale by an exact power of ten keeps the result correctly
+   // rounded; anything beyond that range goes to the old slow path
+   if (exponent >= -22 && exponent <= 22 &&
+       mantissa < (1ull << 53)) {
+      double d = (double)mantissa;
+      d = exponent < 0
+         ? d / exactPowersOfTen[-exponent]
+         : d * exactPowersOfTen[exponent];
+      result = negative ? -d : d;
+      return true;
+   }
+   return Internat::CompatibleToDouble(wxString{ mValue }, &result);
+}
+
+bool XMLAttributeCursor::ToLongLong(long long &result) const
+{
+   const wxChar *p = mValue;
+   if (!p)
+      return false;
+
+   bool negative = false;
+   if (*p == wxT('-')) {
+      negative = true;
+      ++p;
+   }
+   if (*p < wxT('0') || *p > wxT('9'))
+      return false;
+
+   const unsigned long long limit =
+      negative ? 9223372036854775808ull : 9223372036854775807ull;
+   unsigned long long magnitude = 0;
+   for (; *p >= wxT('0') && *p <= wxT('9'); ++p) {
+      const unsigned digit = *p - wxT('0');
+      if (magnitude > (limit - digit) / 10)
+         return false; // would overflow
+      magnitude = magnitude * 10 + digit;
+   }
+   if (*p != wxT('\0'))
+      return false;
+
+   result = negative
+      ? (long long)(0ull - magnitude)
+      : (long long)magnitude;
+   return true;
+}
+
+bool XMLAttributeCursor::ToLong(long &result) const
+{
+   // Keep IsGoodInt's 32-bit range even where long is wider
+   long long wide;
+   if (!ToLongLong(wide) ||
+       wide < -2147483648ll || wide > 2147483647ll)
+      return false;
+   result = (long)wide;
+   return true;
+}
+
 bool XMLTagHandler::ReadXMLTag(const char *tag, const char **attrs)
 {
    wxArrayString tmp_attrs;
@@ -76,6 +76,49 @@ public:
    static bool IsValidSampleFormat(const int nValue); // true if nValue is one sampleFormat enum values
 };
 
+// Cursor over the null-terminated attribute array passed to HandleXMLTag.
+// Hot loaders (Sequence, WaveClip, the envelope control points) see millions
+// of attributes when a clip-heavy project opens; this walks the pairs and
+// parses numeric values in place from the wxChar buffer, without allocating
+// a wxString per attribute and independently of the C locale.
+class AUDACITY_DLL_API XMLAttributeCursor
+{
+public:
+   explicit XMLAttributeCursor(const wxChar **attrs)
+      : mAttrs{ attrs } {}
+
+   // Advance to the next attribute-value pair; false at the end of the
+   // array, or on a malformed final pair that has no value
+   bool Next()
+   {
+      if (!mAttrs || !*mAttrs)
+         return false;
+      mName = *mAttrs++;
+      mValue = *mAttrs++;
+      return mValue != nullptr;
+   }
+
+   const wxChar *Name() const { return mName; }
+   const wxChar *Value() const { return mValue; }
+
+   bool Is(const wxChar *name) const { return wxStrcmp(mName, name) == 0; }
+
+   // Parse the current value in place.  The integer parses accept what the
+   // IsGoodInt checks accept -- an optional leading minus and decimal digits
+   // only -- and fail rather than overflow.  ToDouble also accepts ',' as
+   // the decimal separator, which files written under comma-decimal locales
+   // contain, like Internat::CompatibleToDouble.  On failure the result is
+   // left unchanged.
+   bool ToDouble(double &result) const;
+   bool ToLong(long &result) const;
+   bool ToLongLong(long long &result) const;
+
+private:
+   const wxChar **mAttrs;
+   const wxChar *mName{};
+   const wxChar *mValue{};
+};
+
 
 class AUDACITY_DLL_API XMLTagHandler /* not final */ {
  public:
@@ -31,8 +31,11 @@ the general functionality for creating XML in UTF8 encoding.
 #include <wx/ffile.h>
 #include <wx/intl.h>
 
+#include <stdio.h>
 #include <string.h>
 
+#include "../Internat.h"
+
 //table for xml encoding compatibility with expat decoding
 //see wxWidgets-2.8.12/src/expat/lib/xmltok_impl.h
 //and wxWidgets-2.8.12/src/expat/lib/asciitab.h
@@ -49,6 +52,59 @@ static int charXMLCompatiblity[] =
 /* 0x1C */ 0, 0, 0, 0,
   };
 
+//table of the 7-bit characters that XMLEsc passes through unchanged;
+//when a string consists only of these (the overwhelmingly common case
+//for attribute values) the escaping loop is skipped entirely
+static const char charNeedsNoEscaping[128] =
+  {
+/* 0x00 */ 0, 0, 0, 0, 0, 0, 0, 0,
+/* 0x08 */ 0, 0, 0, 0, 0, 0, 0, 0,
+/* 0x10 */ 0, 0, 0, 0, 0, 0, 0, 0,
+/* 0x18 */ 0, 0, 0, 0, 0, 0, 0, 0,
+/*  !"# */ 1, 1, 0, 1,
+/* $%&' */ 1, 1, 0, 0,
+/* ()*+ */ 1, 1, 1, 1,
+/* ,-./ */ 1, 1, 1, 1,
+/* 0x30 */ 1, 1, 1, 1, 1, 1, 1, 1,
+/* 89:; */ 1, 1, 1, 1,
+/* <=>? */ 0, 1, 0, 1,
+/* 0x40 */ 1, 1, 1, 1, 1, 1, 1, 1,
+/* 0x48 */ 1, 1, 1, 1, 1, 1, 1, 1,
+/* 0x50 */ 1, 1, 1, 1, 1, 1, 1, 1,
+/* 0x58 */ 1, 1, 1, 1, 1, 1, 1, 1,
+/* 0x60 */ 1, 1, 1, 1, 1, 1, 1, 1,
+/* 0x68 */ 1, 1, 1, 1, 1, 1, 1, 1,
+/* 0x70 */ 1, 1, 1, 1, 1, 1, 1, 1,
+/* 0x78 */ 1, 1, 1, 1, 1, 1, 1, 0,
+  };
+
+// Formats a number just as Internat::ToString does, but into a
+// caller-supplied buffer, avoiding wxString allocations.  Returns the
+// length of the formatted string.
+static size_t FormatNumber(char *buf, size_t size, double value, int digits)
+{
+   size_t len;
+   if (digits == -1) {
+      len = (size_t)snprintf(buf, size, "%f", value);
+      // Strip trailing zeros, but leave one, and the decimal separator
+      while (len > 2 && buf[len - 1] == '0' &&
+             buf[len - 2] >= '0' && buf[len - 2] <= '9')
+         buf[--len] = 0;
+   }
+   else
+      len = (size_t)snprintf(buf, size, "%.*f", digits, value);
+
+   // Not all libcs respect the C locale, so always normalize the decimal
+   // separator to a dot, as Internat::ToString does
+   const char decSep = (char)Internat::GetDecimalSeparator();
+   if (decSep != '.')
+      for (size_t ii = 0; ii < len; ii++)
+         if (buf[ii] == decSep)
+            buf[ii] = '.';
+
+   return len;
+}
+
 // These are used by XMLEsc to handle surrogate pairs and filter invalid characters outside the ASCII range.
 #define MIN_HIGH_SURROGATE static_cast<wxUChar>(0xD800)
 #define MAX_HIGH_SURROGATE static_cast<wxUChar>(0xDBFF)
@@ -144,57 +200,73 @@ void XMLWriter::WriteAttr(const wxString &name, const wxChar *value)
 void XMLWriter::WriteAttr(const wxString &name, int value)
 // may throw from Write()
 {
-   Write(wxString::Format(wxT(" %s=\"%d\""),
-      name,
-      value));
+   char buf[32];
+   WriteScalarAttr(name, buf, (size_t)snprintf(buf, sizeof(buf), "%d", value));
 }
 
 void XMLWriter::WriteAttr(const wxString &name, bool value)
 // may throw from Write()
 {
-   Write(wxString::Format(wxT(" %s=\"%d\""),
-      name,
-      value));
+   char buf[32];
+   WriteScalarAttr(name, buf,
+      (size_t)snprintf(buf, sizeof(buf), "%d", (int)value));
 }
 
 void XMLWriter::WriteAttr(const wxString &name, long value)
 // may throw from Write()
 {
-   Write(wxString::Format(wxT(" %s=\"%ld\""),
-      name,
-      value));
+   char buf[32];
+   WriteScalarAttr(name, buf, (size_t)snprintf(buf, sizeof(buf), "%ld", value));
 }
 
 void XMLWriter::WriteAttr(const wxString &name, long long value)
 // may throw from Write()
 {
-   Write(wxString::Format(wxT(" %s=\"%lld\""),
-      name,
-      value));
+   char buf[32];
+   WriteScalarAttr(name, buf,
+      (size_t)snprintf(buf, sizeof(buf), "%lld", value));
 }
 
 void XMLWriter::WriteAttr(const wxString &name, size_t value)
 // may throw from Write()
 {
-   Write(wxString::Format(wxT(" %s=\"%lld\""),
-      name,
-      (long long) value));
+   char buf[32];
+   WriteScalarAttr(name, buf,
+      (size_t)snprintf(buf, sizeof(buf), "%lld", (long long) value));
 }
 
 void XMLWriter::WriteAttr(const wxString &name, float value, int digits)
 // may throw from Write()
 {
-   Write(wxString::Format(wxT(" %s=\"%s\""),
-      name,
-      Internat::ToString(value, digits)));
+   // Large enough for %f of the largest doubles, which print all of their
+   // integer digits
+   char buf[400];
+   WriteScalarAttr(name, buf, FormatNumber(buf, sizeof(buf), value, digits));
 }
 
 void XMLWriter::WriteAttr(const wxString &name, double value, int digits)
 // may throw from Write()
 {
-   Write(wxString::Format(wxT(" %s=\"%s\""),
-      name,
-      Internat::ToString(value, digits)));
+   char buf[400];
+   WriteScalarAttr(name, buf, FormatNumber(buf, sizeof(buf), value, digits));
+}
+
+void XMLWriter::WriteScalarAttr(const wxString &name, const char *value,
+   size_t len)
+// may throw from WriteBytes()
+{
+   const wxScopedCharBuffer nameUTF8 = name.utf8_str();
+   WriteBytes(" ", 1);
+   WriteBytes(nameUTF8.data(), nameUTF8.length());
+   WriteBytes("=\"", 2);
+   WriteBytes(value, len);
+   WriteBytes("\"", 1);
+}
+
+void XMLWriter::WriteBytes(const char *buf, size_t len)
+// may throw from Write()
+{
+   Write(wxString::FromUTF8(buf, len));
 }
 
 void XMLWriter::WriteData(const wxString &value)
@@ -227,7 +299,21 @@ wxString XMLWriter::XMLEsc(const wxString & s)
    wxString result;
    int len = s.length();
 
-   for(int i=0; i<len; i++) {
+   // Fast path: scan with the table first, and return the input unchanged
+   // if nothing needs escaping
+   int start = 0;
+   while (start < len) {
+      wxUChar c = s.GetChar(start);
+      if (c >= 128 || !charNeedsNoEscaping[c])
+         break;
+      start++;
+   }
+   if (start == len)
+      return s;
+
+   result = s.Left(start);
+
+   for(int i=start; i<len; i++) {
       wxUChar c = s.GetChar(i);
 
       switch (c) {
@@ -292,6 +378,11 @@ wxString XMLWriter::XMLEsc(const wxString & s)
 ///
 /// XMLFileWriter class
 ///
+
+// Writes are accumulated in memory and issued to the file in chunks of
+// this size, rather than attribute-by-attribute
+static const size_t BufferSize = 1024 * 1024;
+
 XMLFileWriter::XMLFileWriter
    ( const FilePath &outputPath, const wxString &caption, bool keepBackup )
    : mOutputPath{ outputPath }
@@ -303,6 +394,8 @@ XMLFileWriter::XMLFileWriter
    if (!wxFFile::Open(tempPath, wxT("wb")) || !IsOpened())
       ThrowException( tempPath, mCaption );
 
+   mBuffer.reserve(BufferSize);
+
    if (mKeepBackup) {
       int index = 0;
       wxString backupName;
@@ -385,6 +478,8 @@ void XMLFileWriter::PostCommit()
 void XMLFileWriter::CloseWithoutEndingTags()
 // may throw
 {
+   FlushBuffer();
+
    // Before closing, we first flush it, because if Flush() fails because of a
    // "disk full" condition, we can still at least try to close the file.
    if (!wxFFile::Flush())
@@ -401,13 +496,34 @@ void XMLFileWriter::CloseWithoutEndingTags()
 void XMLFileWriter::Write(const wxString &data)
 // may throw
 {
-   if (!wxFFile::Write(data, wxConvUTF8) || Error())
+   const wxScopedCharBuffer utf8 = data.utf8_str();
+   WriteBytes(utf8.data(), utf8.length());
+}
+
+void XMLFileWriter::WriteBytes(const char *buf, size_t len)
+// may throw
+{
+   mBuffer.append(buf, len);
+   if (mBuffer.size() >= BufferSize)
+      FlushBuffer();
+}
+
+void XMLFileWriter::FlushBuffer()
+// may throw
+{
+   if (mBuffer.empty())
+      return;
+
+   auto written = wxFFile::Write(mBuffer.data(), mBuffer.size());
+   if (written != mBuffer.size() || Error())
    {
       // When writing fails, we try to close the file before throwing the
       // exception, so it can at least be deleted.
       wxFFile::Close();
       ThrowException( GetName(), mCaption );
    }
+
+   mBuffer.clear();
 }
 
 ///
@@ -10,6 +10,7 @@
 #ifndef __AUDACITY_XML_XML_FILE_WRITER__
 #define __AUDACITY_XML_XML_FILE_WRITER__
 
+#include <string>
 #include <vector>
 #include <wx/ffile.h> // to inherit
 
@@ -59,6 +60,14 @@ class AUDACITY_DLL_API XMLWriter /* not final */ {
 
  protected:
 
+   // Raw UTF-8 sink used by the numeric WriteAttr overloads; the default
+   // just forwards to Write(), but file writers can append to a buffer
+   // without constructing a wxString
+   virtual void WriteBytes(const char *buf, size_t len);
+
+   // Write an attribute whose value is already known to need no escaping
+   void WriteScalarAttr(const wxString &name, const char *value, size_t len);
+
    bool mInTag;
    int mDepth;
    wxArrayString mTagstack;
@@ -108,8 +117,17 @@ class AUDACITY_DLL_API XMLFileWriter final : private wxFFile, public XMLWriter {
 
    FilePath GetBackupName() const { return mBackupName; }
 
+ protected:
+
+   /// Appends to an in-memory buffer that is written out in large chunks;
+   /// the underlying file is flushed only once, when closing
+   void WriteBytes(const char *buf, size_t len) override;
+
  private:
 
+   /// Write the accumulated buffer to the file.  Might throw.
+   void FlushBuffer();
+
    void ThrowException(
       const wxFileName &fileName, const wxString &caption)
    {
@@ -127,6 +145,8 @@ class AUDACITY_DLL_API XMLFileWriter final : private wxFFile, public XMLWriter {
 
    wxFFile mBackupFile;
 
+   std::string mBuffer;
+
    bool mCommitted{ false };
 };
 